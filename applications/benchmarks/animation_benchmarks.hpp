@@ -0,0 +1,109 @@
+#pragma once
+#include "benchmark.hpp"
+#include <core/defaults/animationsystem.hpp>
+
+#include <memory>
+#include <random>
+
+namespace legion::benchmarks
+{
+    /**@brief Registers the skeletal animation benchmarks, an op is a single character so ops per second / 1000 gives characters per millisecond.
+     * @param characterCount Amount of characters evaluated per sample.
+     * @param jointCount Amount of joints in the skeleton of every character.
+     */
+    inline void register_animation_benchmarks(BenchmarkSuite& suite, scheduling::Scheduler* scheduler, size_type characterCount, size_type jointCount)
+    {
+        struct animation_state
+        {
+            skeleton rig;
+            animation_clip walk;
+            animation_clip run;
+            std::vector<const skeleton*> skeletons;
+            std::vector<animation::layer> layers;
+            std::vector<size_type> layerCounts;
+            std::vector<joint_palette> palettes;
+        };
+
+        auto state = std::make_shared<animation_state>();
+
+        // Branching skeleton with 4 children per joint and a clip that rotates and moves every joint.
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> angle(-1.f, 1.f);
+        for (size_type i = 0; i < jointCount; i++)
+        {
+            state->rig.jointNames.push_back("joint" + std::to_string(i));
+            state->rig.parents.push_back(i ? static_cast<int32>((i - 1) / 4) : -1);
+            state->rig.restPose.push_back(joint_pose{ math::vec3(0.f, 0.1f, 0.f), math::quat(1.f, 0.f, 0.f, 0.f), math::vec3(1.f) });
+            state->rig.inverseBindMatrices.push_back(math::mat4(1.f));
+        }
+
+        for (auto* clip : { &state->walk, &state->run })
+        {
+            clip->duration = 1.f;
+            for (uint32 joint = 0; joint < jointCount; joint++)
+            {
+                animation_track rotationTrack;
+                rotationTrack.joint = joint;
+                rotationTrack.path = animation_path::rotation;
+
+                animation_track translationTrack;
+                translationTrack.joint = joint;
+                translationTrack.path = animation_path::translation;
+
+                const math::vec3 axis = math::normalize(math::vec3(angle(rng), angle(rng), angle(rng)) + math::vec3(0.f, 0.f, 2.f));
+                for (int key = 0; key <= 10; key++)
+                {
+                    const float time = key * 0.1f;
+                    const math::quat rotation = math::angleAxis(angle(rng), axis);
+                    rotationTrack.times.push_back(time);
+                    rotationTrack.values.push_back(math::vec4(rotation.x, rotation.y, rotation.z, rotation.w));
+                    translationTrack.times.push_back(time);
+                    translationTrack.values.push_back(math::vec4(0.f, 0.1f + angle(rng) * 0.01f, 0.f, 0.f));
+                }
+
+                clip->tracks.push_back(std::move(rotationTrack));
+                clip->tracks.push_back(std::move(translationTrack));
+            }
+            clip->bake(state->rig);
+        }
+
+        auto setup = [=](size_type layerCount)
+        {
+            std::uniform_real_distribution<float> time(0.f, 1.f);
+            state->skeletons.assign(characterCount, &state->rig);
+            state->layers.assign(characterCount * animator::max_layers, animation::layer{});
+            state->layerCounts.assign(characterCount, layerCount);
+            state->palettes.assign(characterCount, joint_palette{});
+
+            std::mt19937 layerRng(7);
+            for (size_type i = 0; i < characterCount; i++)
+            {
+                state->layers[i * animator::max_layers] = animation::layer{ &state->walk, time(layerRng), 0.7f };
+                state->layers[i * animator::max_layers + 1] = animation::layer{ &state->run, time(layerRng), 0.3f };
+            }
+        };
+
+        auto teardown = [=]()
+        {
+            state->skeletons.clear();
+            state->layers.clear();
+            state->layerCounts.clear();
+            state->palettes.clear();
+            state->palettes.shrink_to_fit();
+        };
+
+        auto run = [=]()
+        {
+            AnimationSystem::evaluate(scheduler, characterCount, state->skeletons.data(), state->layers.data(), state->layerCounts.data(), state->palettes.data());
+            do_not_optimize(state->palettes.back().matrices.back());
+        };
+
+        auto& single = suite.add("animation/evaluate/single_clip", characterCount, run);
+        single.setup = [=]() { setup(1); };
+        single.teardown = teardown;
+
+        auto& blended = suite.add("animation/evaluate/two_clip_blend", characterCount, run);
+        blended.setup = [=]() { setup(2); };
+        blended.teardown = teardown;
+    }
+}
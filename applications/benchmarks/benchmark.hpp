@@ -0,0 +1,271 @@
+#pragma once
+#include <core/core.hpp>
+#include <tinygltf/json.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @file benchmark.hpp
+ * @brief Minimal benchmark harness. Every benchmark case gets sampled repeatedly, each sample times a fixed amount of
+ *        operations. Results are reported as nanoseconds per operation with percentiles over all samples and can be
+ *        written to and compared against a JSON baseline.
+ */
+
+namespace legion::benchmarks
+{
+    /**@brief Keeps the compiler from optimizing away the computation of a value.
+     */
+    template<typename T>
+    inline void do_not_optimize(const T& value)
+    {
+        static volatile const void* sink;
+        sink = &value;
+    }
+
+    struct benchmark_options
+    {
+        std::string filter;
+        std::string output = "benchmark_results.json";
+        std::string baseline;
+        float regressionThreshold = 0.1f;
+        size_type warmupSamples = 3;
+        size_type minSamples = 20;
+        size_type maxSamples = 10000;
+        float minTime = 0.25f;
+    };
+
+    /**@class benchmark_case
+     * @brief Single benchmark, setup and teardown run once per case, prepare and cleanup run untimed around every sample.
+     */
+    struct benchmark_case
+    {
+        std::string name;
+        size_type opsPerSample = 1;
+        std::function<void()> sample;
+        std::function<void()> setup;
+        std::function<void()> teardown;
+        std::function<void()> prepare;
+        std::function<void()> cleanup;
+    };
+
+    struct benchmark_result
+    {
+        std::string name;
+        size_type samples = 0;
+        size_type opsPerSample = 0;
+        double meanNs = 0.0;
+        double minNs = 0.0;
+        double p50Ns = 0.0;
+        double p90Ns = 0.0;
+        double p99Ns = 0.0;
+        double maxNs = 0.0;
+        double opsPerSecond = 0.0;
+    };
+
+    /**@class BenchmarkSuite
+     * @brief Collection of benchmark cases that can be run, reported and compared against a baseline.
+     */
+    class BenchmarkSuite
+    {
+    private:
+        std::vector<benchmark_case> m_cases;
+
+        /**@brief Nearest rank percentile of a sorted list of samples.
+         */
+        static double percentile(const std::vector<double>& sorted, double p)
+        {
+            if (sorted.empty())
+                return 0.0;
+            size_type rank = static_cast<size_type>(math::ceil(p * sorted.size()));
+            return sorted[std::clamp<size_type>(rank, 1, sorted.size()) - 1];
+        }
+
+        static benchmark_result run_case(benchmark_case& bench, const benchmark_options& options)
+        {
+            using clock = std::chrono::steady_clock;
+
+            if (bench.setup)
+                bench.setup();
+
+            auto runSample = [&]()
+            {
+                if (bench.prepare)
+                    bench.prepare();
+
+                auto start = clock::now();
+                bench.sample();
+                auto end = clock::now();
+
+                if (bench.cleanup)
+                    bench.cleanup();
+
+                // Samples run outside of any process chain, so release their per frame temporaries here.
+                memory::FrameArena::local().reset();
+
+                return std::chrono::duration<double, std::nano>(end - start).count();
+            };
+
+            for (size_type i = 0; i < options.warmupSamples; i++)
+                runSample();
+
+            std::vector<double> samples;
+            double totalNs = 0.0;
+            const double minTimeNs = options.minTime * 1e9;
+
+            while (samples.size() < options.maxSamples && (samples.size() < options.minSamples || totalNs < minTimeNs))
+            {
+                double ns = runSample();
+                totalNs += ns;
+                samples.push_back(ns / bench.opsPerSample);
+            }
+
+            if (bench.teardown)
+                bench.teardown();
+
+            std::sort(samples.begin(), samples.end());
+
+            benchmark_result result;
+            result.name = bench.name;
+            result.samples = samples.size();
+            result.opsPerSample = bench.opsPerSample;
+            result.meanNs = totalNs / (samples.size() * bench.opsPerSample);
+            result.minNs = samples.front();
+            result.p50Ns = percentile(samples, 0.5);
+            result.p90Ns = percentile(samples, 0.9);
+            result.p99Ns = percentile(samples, 0.99);
+            result.maxNs = samples.back();
+            result.opsPerSecond = result.meanNs > 0.0 ? 1e9 / result.meanNs : 0.0;
+            return result;
+        }
+
+    public:
+        /**@brief Adds a benchmark case to the suite.
+         * @param name Unique name, used to match results against the baseline.
+         * @param opsPerSample Amount of operations a single sample performs.
+         * @param sample Timed function.
+         */
+        benchmark_case& add(const std::string& name, size_type opsPerSample, std::function<void()> sample)
+        {
+            benchmark_case bench;
+            bench.name = name;
+            bench.opsPerSample = opsPerSample ? opsPerSample : 1;
+            bench.sample = std::move(sample);
+            return m_cases.emplace_back(std::move(bench));
+        }
+
+        /**@brief Runs all cases whose name contains the filter.
+         */
+        std::vector<benchmark_result> run(const benchmark_options& options)
+        {
+            std::vector<benchmark_result> results;
+            for (auto& bench : m_cases)
+            {
+                if (!options.filter.empty() && bench.name.find(options.filter) == std::string::npos)
+                    continue;
+
+                log::info("Running {}", bench.name);
+                auto& result = results.emplace_back(run_case(bench, options));
+                log::info("  {:>12.1f} ns/op  p50 {:>12.1f}  p99 {:>12.1f}  {:>14.0f} ops/s  ({} samples)",
+                    result.meanNs, result.p50Ns, result.p99Ns, result.opsPerSecond, result.samples);
+            }
+            return results;
+        }
+
+        static nlohmann::json to_json(const std::vector<benchmark_result>& results)
+        {
+            nlohmann::json json;
+            json["version"] = 1;
+            json["configuration"] = LEGION_CONFIGURATION == LEGION_DEBUG_VALUE ? "debug" : "release";
+            json["threads"] = std::thread::hardware_concurrency();
+
+            auto& list = json["benchmarks"] = nlohmann::json::array();
+            for (auto& result : results)
+            {
+                list.push_back({
+                    { "name", result.name },
+                    { "samples", result.samples },
+                    { "ops_per_sample", result.opsPerSample },
+                    { "mean_ns", result.meanNs },
+                    { "min_ns", result.minNs },
+                    { "p50_ns", result.p50Ns },
+                    { "p90_ns", result.p90Ns },
+                    { "p99_ns", result.p99Ns },
+                    { "max_ns", result.maxNs },
+                    { "ops_per_second", result.opsPerSecond }
+                    });
+            }
+            return json;
+        }
+
+        static bool write_results(const std::vector<benchmark_result>& results, const std::string& path)
+        {
+            std::ofstream file(path);
+            if (!file.is_open())
+            {
+                log::error("Failed to write benchmark results to {}", path);
+                return false;
+            }
+
+            file << to_json(results).dump(4);
+            log::info("Wrote benchmark results to {}", path);
+            return true;
+        }
+
+        /**@brief Compares the median of every result against a baseline file written by write_results.
+         * @returns std::optional<size_type> Amount of benchmarks whose median regressed by more than the threshold,
+         *          std::nullopt if the baseline couldn't be read.
+         */
+        static std::optional<size_type> compare_baseline(const std::vector<benchmark_result>& results, const std::string& path, float threshold)
+        {
+            std::ifstream file(path);
+            if (!file.is_open())
+            {
+                log::error("Failed to open benchmark baseline {}", path);
+                return std::nullopt;
+            }
+
+            nlohmann::json baseline = nlohmann::json::parse(file, nullptr, false);
+            if (baseline.is_discarded() || !baseline.count("benchmarks") || !baseline["benchmarks"].is_array())
+            {
+                log::error("Benchmark baseline {} is not a valid results file", path);
+                return std::nullopt;
+            }
+
+            size_type regressions = 0;
+            for (auto& result : results)
+            {
+                auto it = std::find_if(baseline["benchmarks"].begin(), baseline["benchmarks"].end(),
+                    [&](const nlohmann::json& entry) { return entry.value("name", std::string()) == result.name; });
+
+                if (it == baseline["benchmarks"].end())
+                {
+                    log::info("{:<40} new", result.name);
+                    continue;
+                }
+
+                double baselineNs = it->value("p50_ns", 0.0);
+                if (baselineNs <= 0.0)
+                    continue;
+
+                double change = (result.p50Ns - baselineNs) / baselineNs;
+                if (change > threshold)
+                {
+                    regressions++;
+                    log::warn("{:<40} {:+.1f}% REGRESSION ({:.1f} -> {:.1f} ns/op)", result.name, change * 100.0, baselineNs, result.p50Ns);
+                }
+                else
+                {
+                    log::info("{:<40} {:+.1f}%", result.name, change * 100.0);
+                }
+            }
+
+            return regressions;
+        }
+    };
+}
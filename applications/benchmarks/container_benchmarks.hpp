@@ -0,0 +1,113 @@
+#pragma once
+#include "benchmark.hpp"
+
+#include <memory>
+#include <random>
+
+namespace legion::benchmarks
+{
+    /**@brief Registers the sparse container and temporary container benchmarks.
+     * @param elementCount Amount of elements each sample operates on.
+     */
+    inline void register_container_benchmarks(BenchmarkSuite& suite, size_type elementCount)
+    {
+        struct container_state
+        {
+            sparse_map<id_type, math::vec3> map;
+            std::vector<id_type> keys;
+        };
+
+        auto state = std::make_shared<container_state>();
+
+        auto generateKeys = [=]()
+        {
+            std::mt19937_64 rng(1337);
+            state->keys.resize(elementCount);
+            for (auto& key : state->keys)
+                key = rng() % (elementCount * 16);
+        };
+
+        auto fillMap = [=]()
+        {
+            state->map.clear();
+            for (id_type key : state->keys)
+                state->map.insert(key, math::vec3(1.f));
+        };
+
+        {
+            auto& bench = suite.add("containers/sparse_map/insert", elementCount, [=]()
+                {
+                    for (id_type key : state->keys)
+                        state->map.insert(key, math::vec3(1.f));
+                });
+            bench.setup = generateKeys;
+            bench.prepare = [=]() { state->map.clear(); };
+        }
+
+        {
+            auto& bench = suite.add("containers/sparse_map/lookup", elementCount, [=]()
+                {
+                    math::vec3 sum;
+                    for (id_type key : state->keys)
+                        sum += state->map.at(key);
+                    do_not_optimize(sum);
+                });
+            bench.setup = [=]() { generateKeys(); fillMap(); };
+        }
+
+        {
+            auto& bench = suite.add("containers/sparse_map/contains", elementCount, [=]()
+                {
+                    size_type count = 0;
+                    for (id_type key : state->keys)
+                        count += state->map.contains(key + 1);
+                    do_not_optimize(count);
+                });
+            bench.setup = [=]() { generateKeys(); fillMap(); };
+        }
+
+        {
+            auto& bench = suite.add("containers/sparse_map/erase", elementCount, [=]()
+                {
+                    for (id_type key : state->keys)
+                        state->map.erase(key);
+                });
+            bench.setup = generateKeys;
+            bench.prepare = fillMap;
+        }
+
+        {
+            auto& bench = suite.add("containers/sparse_map/iterate", elementCount, [=]()
+                {
+                    math::vec3 sum;
+                    for (auto [key, value] : state->map)
+                        sum += value;
+                    do_not_optimize(sum);
+                });
+            bench.setup = [=]() { generateKeys(); fillMap(); };
+        }
+
+        // Per frame temporaries, a fresh container gets filled every sample like the physics and hierarchy systems do every frame.
+        {
+            auto& bench = suite.add("containers/temporary/std_vector", elementCount, [=]()
+                {
+                    std::vector<id_type> temporary;
+                    for (id_type key : state->keys)
+                        temporary.push_back(key);
+                    do_not_optimize(temporary.data());
+                });
+            bench.setup = generateKeys;
+        }
+
+        {
+            auto& bench = suite.add("containers/temporary/frame_vector", elementCount, [=]()
+                {
+                    memory::frame_vector<id_type> temporary;
+                    for (id_type key : state->keys)
+                        temporary.push_back(key);
+                    do_not_optimize(temporary.data());
+                });
+            bench.setup = generateKeys;
+        }
+    }
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include "benchmark.hpp"
+
+#include <memory>
+#include <random>
+
+namespace legion::benchmarks
+{
+    /**@brief Registers the entity, component pool and query benchmarks.
+     * @param entityCount Amount of entities each sample operates on.
+     */
+    inline void register_ecs_benchmarks(BenchmarkSuite& suite, ecs::EcsRegistry* registry, size_type entityCount)
+    {
+        struct ecs_state
+        {
+            ecs::entity_container entities;
+            std::vector<id_type> shuffled;
+            ecs::EntityQuery query;
+        };
+
+        auto state = std::make_shared<ecs_state>();
+
+        auto destroyEntities = [=]()
+        {
+            for (auto& entity : state->entities)
+                registry->destroyEntity(entity, false);
+            state->entities.clear();
+        };
+
+        auto createEntities = [=]()
+        {
+            state->entities = registry->createEntities(entityCount);
+        };
+
+        auto createPopulatedEntities = [=]()
+        {
+            state->entities = registry->createEntities(entityCount);
+            for (auto& entity : state->entities)
+                entity.add_components(position(), velocity(1.f, 0.f, 0.f));
+        };
+
+        {
+            auto& bench = suite.add("ecs/create_entities", entityCount, [=]()
+                {
+                    state->entities = registry->createEntities(entityCount);
+                });
+            bench.cleanup = destroyEntities;
+        }
+
+        {
+            auto& bench = suite.add("ecs/destroy_entities", entityCount, [=]()
+                {
+                    for (auto& entity : state->entities)
+                        registry->destroyEntity(entity, false);
+                    state->entities.clear();
+                });
+            bench.prepare = createEntities;
+        }
+
+        {
+            auto& bench = suite.add("ecs/component_pool/create_component", entityCount, [=]()
+                {
+                    auto* pool = registry->getFamily<position>();
+                    for (auto& entity : state->entities)
+                        pool->create_component(entity);
+                });
+            bench.prepare = createEntities;
+            bench.cleanup = [=]()
+            {
+                // The components bypass the entity data, so destroying the entities wouldn't remove them from the pool.
+                auto* pool = registry->getFamily<position>();
+                for (auto& entity : state->entities)
+                    pool->destroy_component(entity);
+                destroyEntities();
+            };
+        }
+
+        {
+            auto& bench = suite.add("ecs/component_pool/random_read", entityCount, [=]()
+                {
+                    const auto* pool = registry->getFamily<position>();
+                    float sum = 0.f;
+                    for (id_type id : state->shuffled)
+                        sum += pool->get_component(id).x;
+                    do_not_optimize(sum);
+                });
+            bench.setup = [=]()
+            {
+                createPopulatedEntities();
+                state->shuffled.clear();
+                for (auto& entity : state->entities)
+                    state->shuffled.push_back(entity);
+                std::shuffle(state->shuffled.begin(), state->shuffled.end(), std::mt19937(1337));
+            };
+            bench.teardown = destroyEntities;
+        }
+
+        {
+            auto& bench = suite.add("ecs/query/fetch_and_submit", entityCount, [=]()
+                {
+                    state->query.queryEntities();
+                    auto& positions = state->query.get<position>();
+                    auto& velocities = state->query.get<velocity>();
+
+                    for (size_type i = 0; i < positions.size(); i++)
+                        positions[i] += velocities[i] * 0.016f;
+
+                    state->query.submit<position>();
+                });
+            bench.setup = [=]()
+            {
+                createPopulatedEntities();
+                state->query = registry->createQuery<position, velocity>();
+            };
+            bench.teardown = [=]()
+            {
+                destroyEntities();
+                state->query = ecs::EntityQuery();
+            };
+        }
+
+        {
+            auto& bench = suite.add("ecs/query/structural_update", entityCount, [=]()
+                {
+                    for (auto& entity : state->entities)
+                        entity.add_component<velocity>();
+                    for (auto& entity : state->entities)
+                        entity.remove_component<velocity>();
+                });
+            bench.setup = [=]()
+            {
+                createEntities();
+                for (auto& entity : state->entities)
+                    entity.add_component<position>();
+                state->query = registry->createQuery<position, velocity>();
+            };
+            bench.teardown = [=]()
+            {
+                destroyEntities();
+                state->query = ecs::EntityQuery();
+            };
+        }
+    }
+}
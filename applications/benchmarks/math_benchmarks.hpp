@@ -0,0 +1,147 @@
+#pragma once
+#include "benchmark.hpp"
+#include <core/math/math.hpp>
+
+#include <memory>
+#include <random>
+#include <string>
+
+namespace legion::benchmarks
+{
+    /**@brief Registers the batch math benchmarks, every routine runs once per instruction set and once as a plain glm loop for reference.
+     * @param count Amount of transforms, points or bounding volumes processed per sample.
+     */
+    inline void register_math_benchmarks(BenchmarkSuite& suite, size_type count)
+    {
+        namespace batch = math::batch;
+
+        struct math_state
+        {
+            std::vector<math::vec3> positions;
+            std::vector<math::quat> rotations;
+            std::vector<math::vec3> scales;
+            std::vector<float> trs; // 10 arrays of count floats.
+            std::vector<math::mat4> matrices;
+
+            std::vector<float> x, y, z, radius;
+            std::vector<float> outX, outY, outZ;
+            std::vector<math::vec3> localMin, localMax, worldMin, worldMax;
+            std::vector<uint8> visible;
+            batch::frustum frustum;
+        };
+
+        auto state = std::make_shared<math_state>();
+
+        std::mt19937 rng(42);
+        std::uniform_real_distribution<float> coord(-50.f, 50.f);
+        std::uniform_real_distribution<float> unit(-1.f, 1.f);
+        std::uniform_real_distribution<float> size(0.5f, 2.f);
+
+        state->trs.resize(count * 10);
+        for (size_type i = 0; i < count; i++)
+        {
+            const math::vec3 position(coord(rng), coord(rng), coord(rng));
+            const math::quat rotation = math::normalize(math::quat(unit(rng), unit(rng), unit(rng), unit(rng)));
+            const math::vec3 scale(size(rng), size(rng), size(rng));
+            state->positions.push_back(position);
+            state->rotations.push_back(rotation);
+            state->scales.push_back(scale);
+
+            const float values[10] = { position.x, position.y, position.z, rotation.x, rotation.y, rotation.z, rotation.w, scale.x, scale.y, scale.z };
+            for (size_type j = 0; j < 10; j++)
+                state->trs[j * count + i] = values[j];
+
+            state->x.push_back(position.x);
+            state->y.push_back(position.y);
+            state->z.push_back(position.z);
+            state->radius.push_back(size(rng));
+            state->localMin.push_back(-scale);
+            state->localMax.push_back(scale);
+        }
+
+        state->matrices.resize(count);
+        state->outX.resize(count);
+        state->outY.resize(count);
+        state->outZ.resize(count);
+        state->worldMin.resize(count);
+        state->worldMax.resize(count);
+        state->visible.resize(count);
+        state->frustum = batch::frustum::from_matrix(math::perspective(math::deg2rad(60.f), 16.f / 9.f, 0.1f, 100.f) * math::lookAt(math::vec3(0.f, 0.f, -60.f), math::vec3(0.f), math::vec3(0.f, 1.f, 0.f)));
+
+        auto arrays = [=]()
+        {
+            const float* data = state->trs.data();
+            return batch::trs_arrays{ data, data + count, data + count * 2, data + count * 3, data + count * 4, data + count * 5, data + count * 6, data + count * 7, data + count * 8, data + count * 9 };
+        };
+
+        suite.add("math/compose/glm", count, [=]()
+            {
+                for (size_type i = 0; i < count; i++)
+                    state->matrices[i] = math::compose(state->scales[i], state->rotations[i], state->positions[i]);
+                do_not_optimize(state->matrices.back());
+            });
+
+        suite.add("math/transform_points/glm", count, [=]()
+            {
+                const math::mat4& transform = state->matrices[0];
+                for (size_type i = 0; i < count; i++)
+                {
+                    const math::vec3 point = transform * math::vec4(state->x[i], state->y[i], state->z[i], 1.f);
+                    state->outX[i] = point.x;
+                    state->outY[i] = point.y;
+                    state->outZ[i] = point.z;
+                }
+                do_not_optimize(state->outZ.back());
+            });
+
+        for (auto level : { batch::simd_level::scalar, batch::simd_level::sse, batch::simd_level::avx2 })
+        {
+            if (static_cast<uint8>(level) > static_cast<uint8>(batch::supported_simd_level()))
+                continue;
+
+            const std::string suffix = batch::to_string(level);
+            auto setup = [=]() { batch::set_simd_level(level); };
+            auto teardown = []() { batch::set_simd_level(batch::supported_simd_level()); };
+
+            auto& compose = suite.add("math/compose/" + suffix, count, [=]()
+                {
+                    batch::compose(count, arrays(), state->matrices.data());
+                    do_not_optimize(state->matrices.back());
+                });
+            compose.setup = setup;
+            compose.teardown = teardown;
+
+            auto& points = suite.add("math/transform_points/" + suffix, count, [=]()
+                {
+                    batch::transform_points(state->matrices[0], count, state->x.data(), state->y.data(), state->z.data(), state->outX.data(), state->outY.data(), state->outZ.data());
+                    do_not_optimize(state->outZ.back());
+                });
+            points.setup = setup;
+            points.teardown = teardown;
+
+            auto& aabbs = suite.add("math/world_aabbs/" + suffix, count, [=]()
+                {
+                    batch::world_aabbs(count, state->matrices.data(), state->localMin.data(), state->localMax.data(), state->worldMin.data(), state->worldMax.data());
+                    do_not_optimize(state->worldMax.back());
+                });
+            aabbs.setup = setup;
+            aabbs.teardown = teardown;
+
+            auto& spheres = suite.add("math/cull_spheres/" + suffix, count, [=]()
+                {
+                    batch::cull_spheres(state->frustum, count, state->x.data(), state->y.data(), state->z.data(), state->radius.data(), state->visible.data());
+                    do_not_optimize(state->visible.back());
+                });
+            spheres.setup = setup;
+            spheres.teardown = teardown;
+
+            auto& boxes = suite.add("math/cull_aabbs/" + suffix, count, [=]()
+                {
+                    batch::cull_aabbs(state->frustum, count, state->worldMin.data(), state->worldMax.data(), state->visible.data());
+                    do_not_optimize(state->visible.back());
+                });
+            boxes.setup = setup;
+            boxes.teardown = teardown;
+        }
+    }
+}
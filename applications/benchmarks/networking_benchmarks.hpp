@@ -0,0 +1,175 @@
+#pragma once
+#include "benchmark.hpp"
+#include <networking/networking.hpp>
+
+#include <memory>
+#include <random>
+
+namespace legion::benchmarks
+{
+    /**@brief Registers the replication benchmarks, a server replicating the registry to a number of clients over a loopback network.
+     *        One sample is a single server tick including the clients decoding and acknowledging it.
+     * @param entityCount Amount of replicated entities.
+     * @param clientCount Amount of connected clients, these only decode the state and don't apply it to a registry.
+     */
+    inline void register_networking_benchmarks(BenchmarkSuite& suite, ecs::EcsRegistry* registry, size_type entityCount, size_type clientCount)
+    {
+        using namespace legion::networking;
+
+        struct replication_state
+        {
+            std::shared_ptr<loopback_network> network;
+            std::unique_ptr<ReplicationServer> server;
+            std::vector<std::unique_ptr<ReplicationClient>> clients;
+            replication_settings settings;
+            float area = 100.f;
+            ecs::entity_container entities;
+            ecs::entity_container moved;
+            ecs::component_container<position> positions;
+            std::mt19937 rng{ 1337 };
+            double now = 0.0;
+            uint64 startBytes = 0;
+            uint64 startTicks = 0;
+        };
+
+        auto tick = [=](replication_state& state)
+        {
+            state.now += 1.0 / 30.0;
+            state.server->update(*registry, state.now);
+            for (auto& client : state.clients)
+                client->update(state.now);
+        };
+
+        auto setup = [=](replication_state& state)
+        {
+            ReplicationRegistry::reportType<position_codec>();
+            ReplicationRegistry::reportType<rotation_codec>();
+            ReplicationRegistry::reportType<scale_codec>();
+
+            std::uniform_real_distribution<float> distribution(-state.area, state.area);
+            state.entities = registry->createEntities(entityCount);
+            for (auto& entity : state.entities)
+            {
+                auto [positionH, rotationH, scaleH] = registry->createComponents<transform>(entity);
+                positionH.write(position(distribution(state.rng), distribution(state.rng), distribution(state.rng)));
+            }
+
+            state.network = std::make_shared<loopback_network>();
+            state.server = std::make_unique<ReplicationServer>(std::make_shared<loopback_transport>(state.network), state.settings);
+            state.server->start(0);
+
+            for (size_type i = 0; i < clientCount; i++)
+            {
+                auto& client = state.clients.emplace_back(std::make_unique<ReplicationClient>(std::make_shared<loopback_transport>(state.network)));
+                client->connect(state.server->local_address(), state.now);
+            }
+
+            // Let the clients connect and receive the full initial state before measuring.
+            bool placed = false;
+            for (size_type i = 0; i < 100000; i++)
+            {
+                const uint64 written = state.server->stats().updatesWritten;
+                tick(state);
+
+                bool connected = true;
+                for (auto& client : state.clients)
+                    connected &= client->connected();
+
+                if (connected && state.settings.relevancy.enabled && !placed)
+                {
+                    // Observers spread out over the world, each seeing a small part of it.
+                    for (auto& client : state.clients)
+                        state.server->set_observer(client->client_index(), position(distribution(state.rng), 0.f, distribution(state.rng)));
+                    placed = true;
+                    continue;
+                }
+
+                if (connected && written == state.server->stats().updatesWritten)
+                    break;
+            }
+
+            for (size_type i = 0; i < 30; i++)
+                tick(state);
+
+            state.startBytes = state.network->bytes_sent();
+            state.startTicks = state.server->tick();
+        };
+
+        auto teardown = [=](replication_state& state)
+        {
+            const uint64 ticks = state.server->tick() - state.startTicks;
+            if (ticks && clientCount)
+                log::info("  {} bytes per client per tick over {} ticks", (state.network->bytes_sent() - state.startBytes) / (ticks * clientCount), ticks);
+
+            state.clients.clear();
+            state.server.reset();
+            state.network.reset();
+            for (auto& entity : state.entities)
+                registry->destroyEntity(entity);
+            state.entities.clear();
+        };
+
+        // Nothing changes, the cost of a tick should not depend on the amount of entities.
+        {
+            auto state = std::make_shared<replication_state>();
+            auto& bench = suite.add("networking/replication_idle", 1, [=]() { tick(*state); });
+            bench.setup = [=]() { setup(*state); };
+            bench.teardown = [=]() { teardown(*state); };
+        }
+
+        // 5% of the entities move every tick, bandwidth per client is capped by the packet budget.
+        {
+            auto state = std::make_shared<replication_state>();
+            auto& bench = suite.add("networking/replication_moving", 1, [=]() { tick(*state); });
+            bench.setup = [=]() { setup(*state); };
+            bench.teardown = [=]() { teardown(*state); };
+
+            bench.prepare = [=]()
+            {
+                std::uniform_int_distribution<size_type> pick(0, entityCount - 1);
+                std::uniform_real_distribution<float> distribution(-state->area, state->area);
+
+                state->moved.clear();
+                state->positions.clear();
+                for (size_type i = 0; i < entityCount / 20; i++)
+                {
+                    state->moved.push_back(state->entities[pick(state->rng)]);
+                    state->positions.emplace_back(distribution(state->rng), distribution(state->rng), distribution(state->rng));
+                }
+
+                registry->getFamily<position>()->set_components(state->moved, state->positions);
+            };
+        }
+
+        // Entities spread over a large world and 5% of them walk around every tick, clients only receive the entities around their observer.
+        // Server cost should follow the amount of movement and the size of the relevant sets, not entities times clients.
+        {
+            auto state = std::make_shared<replication_state>();
+            state->settings.relevancy.enabled = true;
+            state->area = 1000.f;
+
+            auto& bench = suite.add("networking/replication_relevancy", 1, [=]() { tick(*state); });
+            bench.setup = [=]() { setup(*state); };
+            bench.teardown = [=]() { teardown(*state); };
+
+            bench.prepare = [=]()
+            {
+                std::uniform_int_distribution<size_type> pick(0, entityCount - 1);
+                std::uniform_real_distribution<float> step(-2.f, 2.f);
+
+                state->moved.clear();
+                state->positions.clear();
+                for (size_type i = 0; i < entityCount / 20; i++)
+                    state->moved.push_back(state->entities[pick(state->rng)]);
+
+                auto* family = registry->getFamily<position>();
+                ecs::component_container<position> current;
+                family->get_components(state->moved, current);
+                for (auto& pos : current)
+                    state->positions.emplace_back(pos.x + step(state->rng), pos.y, pos.z + step(state->rng));
+
+                family->set_components(state->moved, state->positions);
+            };
+        }
+    }
+}
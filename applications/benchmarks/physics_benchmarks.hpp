@@ -0,0 +1,122 @@
+#pragma once
+#include "benchmark.hpp"
+#include <physics/physics.hpp>
+#include <physics/broadphasecollisionalgorithms/broadphaseuniformgridnocaching.hpp>
+
+#include <memory>
+#include <random>
+
+namespace legion::benchmarks
+{
+    /**@brief Registers the narrow-phase and broad-phase benchmarks.
+     * @param bodyCount Amount of bodies the broad-phase benchmarks sort.
+     */
+    inline void register_physics_benchmarks(BenchmarkSuite& suite, size_type bodyCount)
+    {
+        using namespace legion::physics;
+
+        struct sat_state
+        {
+            ConvexCollider boxA;
+            ConvexCollider boxB;
+            math::mat4 transformA;
+            math::mat4 transformB;
+        };
+
+        auto sat = std::make_shared<sat_state>();
+        sat->boxA.CreateBox(cube_collider_params(1.f, 1.f, 1.f));
+        sat->boxB.CreateBox(cube_collider_params(1.f, 1.f, 1.f));
+        sat->transformA = math::compose(math::vec3(1.f), math::quat(1, 0, 0, 0), math::vec3(0.f));
+        sat->transformB = math::compose(math::vec3(1.f), math::angleAxis(math::deg2rad(30.f), math::normalize(math::vec3(1.f, 1.f, 0.f))), math::vec3(0.2f, 0.9f, 0.1f));
+
+        constexpr size_type satQueries = 1000;
+
+        suite.add("physics/sat/face_query", satQueries, [=]()
+            {
+                PointerEncapsulator<HalfEdgeFace> refFace;
+                float separation = 0.f;
+                bool found = false;
+                for (size_type i = 0; i < satQueries; i++)
+                    found ^= PhysicsStatics::FindSeperatingAxisByExtremePointProjection(&sat->boxA, &sat->boxB, sat->transformA, sat->transformB, refFace, separation);
+                do_not_optimize(found);
+            });
+
+        suite.add("physics/sat/edge_query", satQueries, [=]()
+            {
+                PointerEncapsulator<HalfEdgeEdge> refEdge;
+                PointerEncapsulator<HalfEdgeEdge> incEdge;
+                math::vec3 axis;
+                float separation = 0.f;
+                bool found = false;
+                for (size_type i = 0; i < satQueries; i++)
+                    found ^= PhysicsStatics::FindSeperatingAxisByGaussMapEdgeCheck(&sat->boxA, &sat->boxB, sat->transformA, sat->transformB, refEdge, incEdge, axis, separation);
+                do_not_optimize(found);
+            });
+
+        struct broadphase_state
+        {
+            std::vector<physicsComponent> components;
+            std::vector<physics_manifold_precursor> source;
+            std::vector<physics_manifold_precursor> precursors;
+            std::unique_ptr<BroadphaseUniformGrid> grid;
+            std::unique_ptr<BroadphaseUniformGridNoCaching> gridNoCaching;
+        };
+
+        auto broadphase = std::make_shared<broadphase_state>();
+
+        auto setupBodies = [=]()
+        {
+            std::mt19937 rng(1337);
+            float extent = math::pow(static_cast<float>(bodyCount), 1.f / 3.f) * 2.f;
+            std::uniform_real_distribution<float> distribution(-extent, extent);
+
+            broadphase->components.resize(bodyCount);
+            broadphase->source.clear();
+            for (size_type i = 0; i < bodyCount; i++)
+            {
+                auto& comp = broadphase->components[i];
+                comp.AddBox(cube_collider_params(1.f, 1.f, 1.f));
+
+                math::mat4 transform = math::compose(math::vec3(1.f), math::quat(1, 0, 0, 0), math::vec3(distribution(rng), distribution(rng), distribution(rng)));
+                for (auto& collider : comp.colliders)
+                    collider->UpdateTransformedTightBoundingVolume(transform);
+
+                broadphase->source.emplace_back(transform, &comp, i, ecs::entity_handle(i + 1));
+            }
+
+            broadphase->grid = std::make_unique<BroadphaseUniformGrid>(math::ivec3(2, 2, 2));
+            broadphase->gridNoCaching = std::make_unique<BroadphaseUniformGridNoCaching>(math::vec3(2, 2, 2));
+        };
+
+        auto teardownBodies = [=]()
+        {
+            broadphase->source.clear();
+            broadphase->precursors.clear();
+            broadphase->components.clear();
+            broadphase->grid.reset();
+            broadphase->gridNoCaching.reset();
+        };
+
+        auto copyPrecursors = [=]() { broadphase->precursors = broadphase->source; };
+
+        {
+            auto& bench = suite.add("physics/broadphase/uniform_grid_rebuild", bodyCount, [=]()
+                {
+                    do_not_optimize(broadphase->grid->reConstruct(std::move(broadphase->precursors)));
+                });
+            bench.setup = setupBodies;
+            bench.teardown = teardownBodies;
+            bench.prepare = copyPrecursors;
+        }
+
+        {
+            auto& bench = suite.add("physics/broadphase/uniform_grid_no_caching", bodyCount, [=]()
+                {
+                    do_not_optimize(broadphase->gridNoCaching->collectPairs(std::move(broadphase->precursors)));
+                });
+            bench.setup = setupBodies;
+            bench.teardown = teardownBodies;
+            bench.prepare = copyPrecursors;
+        }
+    }
+}
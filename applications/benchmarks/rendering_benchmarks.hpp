@@ -0,0 +1,66 @@
+#pragma once
+#include "benchmark.hpp"
+#include <rendering/data/indirect_draw.hpp>
+
+#include <memory>
+#include <random>
+#include <string>
+
+namespace legion::benchmarks
+{
+    /**@brief Registers the rendering benchmarks, these only cover the CPU side and don't need a rendering context.
+     * @param count Amount of instances drawn per sample.
+     * @param materials Amount of materials the instances are spread over, every four materials share a draw group.
+     */
+    inline void register_rendering_benchmarks(BenchmarkSuite& suite, size_type count, size_type materials)
+    {
+        namespace gfx = rendering;
+
+        static constexpr size_type model_count = 16;
+
+        struct rendering_state
+        {
+            std::vector<std::vector<sub_mesh>> submeshes;
+            std::vector<const std::vector<sub_mesh>*> models;
+            std::vector<std::vector<math::mat4>> instances;
+            std::vector<gfx::indirect_draw_input> inputs;
+            gfx::indirect_draw_list drawList;
+        };
+
+        auto state = std::make_shared<rendering_state>();
+        materials = materials ? materials : 1;
+
+        std::mt19937 rng(42);
+        std::uniform_int_distribution<size_type> submeshCount(1, 4);
+        std::uniform_int_distribution<size_type> pick(0, materials * model_count - 1);
+        std::uniform_real_distribution<float> coord(-50.f, 50.f);
+
+        state->submeshes.resize(model_count);
+        for (auto& submeshes : state->submeshes)
+        {
+            size_type offset = 0;
+            const size_type submeshesPerModel = submeshCount(rng);
+            for (size_type i = 0; i < submeshesPerModel; i++)
+            {
+                submeshes.push_back({ std::to_string(i), 36, offset });
+                offset += 36;
+            }
+            state->models.push_back(&submeshes);
+        }
+
+        // One list of instances per material and model combination, same as the batches the mesh batching stage produces.
+        state->instances.resize(materials * model_count);
+        for (size_type i = 0; i < count; i++)
+            state->instances[pick(rng)].push_back(math::translate(math::mat4(1.f), math::vec3(coord(rng), coord(rng), coord(rng))));
+
+        for (size_type material = 0; material < materials; material++)
+            for (size_type model = 0; model < model_count; model++)
+                state->inputs.push_back({ material / 4, static_cast<uint32>(material % 4), model, &state->instances[material * model_count + model] });
+
+        suite.add("rendering/indirect_draw_build", count, [=]()
+            {
+                state->drawList.build(state->inputs, state->models);
+                do_not_optimize(state->drawList.commands.back());
+            });
+    }
+}
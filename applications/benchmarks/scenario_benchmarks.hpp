@@ -0,0 +1,183 @@
+#pragma once
+#include "benchmark.hpp"
+#include <physics/physics.hpp>
+
+#include <memory>
+#include <random>
+
+namespace legion::benchmarks
+{
+    /**@brief Registers the scenario benchmarks, each scenario simulates a small world for a number of ticks.
+     * @param entityCount Amount of entities in the movement scenario.
+     * @param stackHeight Amount of stacked bodies in the physics scenario.
+     */
+    inline void register_scenario_benchmarks(BenchmarkSuite& suite, ecs::EcsRegistry* registry, scheduling::Scheduler* scheduler, size_type entityCount, size_type stackHeight)
+    {
+        using namespace legion::physics;
+
+        // N entities moving in parallel on the job pool.
+        {
+            struct movement_state
+            {
+                ecs::entity_container entities;
+                ecs::EntityQuery query;
+            };
+
+            auto state = std::make_shared<movement_state>();
+
+            auto& bench = suite.add("scenario/entity_movement", entityCount, [=]()
+                {
+                    state->query.queryEntities();
+                    auto& positions = state->query.get<position>();
+                    auto& velocities = state->query.get<velocity>();
+
+                    scheduler->queueJobs(positions.size(), [&]()
+                        {
+                            id_type index = async::this_job::get_id();
+                            positions[index] += velocities[index] * 0.016f;
+                        }).wait();
+
+                    state->query.submit<position>();
+                });
+
+            bench.setup = [=]()
+            {
+                std::mt19937 rng(1337);
+                std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+
+                state->entities = registry->createEntities(entityCount);
+                for (auto& entity : state->entities)
+                {
+                    registry->createComponents<transform>(entity);
+                    entity.add_component(velocity(distribution(rng), distribution(rng), distribution(rng)));
+                }
+
+                state->query = registry->createQuery<position, velocity>();
+            };
+
+            bench.teardown = [=]()
+            {
+                for (auto& entity : state->entities)
+                    registry->destroyEntity(entity);
+                state->entities.clear();
+                state->query = ecs::EntityQuery();
+            };
+        }
+
+        // M rigidbodies stacked on a static floor, every sample steps a freshly restored stack a fixed amount of times
+        // so that later samples don't measure a pile that has already settled.
+        {
+            constexpr size_type stepsPerSample = 8;
+
+            struct body_state
+            {
+                ecs::entity_handle entity;
+                position pos;
+                rotation rot;
+                bool dynamic;
+                rigidbody body;
+            };
+
+            struct stack_state
+            {
+                std::unique_ptr<PhysicsSystem> system;
+                std::vector<body_state> bodies;
+            };
+
+            auto state = std::make_shared<stack_state>();
+
+            auto& bench = suite.add("scenario/physics_stack", stepsPerSample, [=]()
+                {
+                    for (size_type i = 0; i < stepsPerSample; i++)
+                        state->system->fixedUpdate(0.02f);
+                });
+
+            bench.setup = [=]()
+            {
+                state->system = std::make_unique<PhysicsSystem>();
+                state->system->setup();
+
+                auto createBox = [&](const math::vec3& pos, const cube_collider_params& params, bool dynamic)
+                {
+                    auto ent = registry->createEntity();
+
+                    physicsComponent physComp;
+                    physComp.AddBox(params);
+                    ent.add_component(std::move(physComp));
+
+                    if (dynamic)
+                        ent.add_component<rigidbody>();
+
+                    auto [positionH, rotationH, scaleH] = registry->createComponents<transform>(ent);
+                    positionH.write(pos);
+
+                    body_state body{ ent, position(pos), rotationH.read(), dynamic, rigidbody() };
+                    if (dynamic)
+                        body.body = ent.read_component<rigidbody>();
+                    state->bodies.push_back(body);
+                };
+
+                createBox(math::vec3(0.f, -0.5f, 0.f), cube_collider_params(50.f, 50.f, 1.f), false);
+
+                for (size_type i = 0; i < stackHeight; i++)
+                    createBox(math::vec3(0.f, 0.5f + i * 1.01f, 0.f), cube_collider_params(1.f, 1.f, 1.f), true);
+            };
+
+            bench.prepare = [=]()
+            {
+                for (auto& body : state->bodies)
+                {
+                    body.entity.write_component(body.pos);
+                    body.entity.write_component(body.rot);
+                    if (body.dynamic)
+                        body.entity.write_component(body.body);
+                }
+            };
+
+            bench.teardown = [=]()
+            {
+                for (auto& body : state->bodies)
+                    registry->destroyEntity(body.entity);
+                state->bodies.clear();
+                state->system.reset();
+            };
+        }
+
+        // Fracture fragment generation, builds the convex hulls of a set of Voronoi fragments.
+        {
+            constexpr size_type fragmentCount = 16;
+            constexpr size_type pointsPerFragment = 32;
+
+            auto fragments = std::make_shared<std::vector<std::vector<math::vec3>>>();
+
+            auto& bench = suite.add("scenario/fracture_fragments", fragmentCount, [=]()
+                {
+                    for (auto& points : *fragments)
+                    {
+                        std::vector<math::vec3> vertices = points;
+                        ConvexCollider collider;
+                        collider.ConstructConvexHullWithVertices(vertices);
+                        do_not_optimize(collider.GetHalfEdgeFaces().size());
+                    }
+                });
+
+            bench.setup = [=]()
+            {
+                std::mt19937 rng(1337);
+                std::uniform_real_distribution<float> distribution(-0.5f, 0.5f);
+
+                fragments->resize(fragmentCount);
+                for (size_type i = 0; i < fragmentCount; i++)
+                {
+                    math::vec3 center(static_cast<float>(i % 4), static_cast<float>(i / 4), 0.f);
+                    auto& points = (*fragments)[i];
+                    points.resize(pointsPerFragment);
+                    for (auto& point : points)
+                        point = center + math::vec3(distribution(rng), distribution(rng), distribution(rng));
+                }
+            };
+
+            bench.teardown = [=]() { fragments->clear(); };
+        }
+    }
+}
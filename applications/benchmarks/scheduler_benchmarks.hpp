@@ -0,0 +1,45 @@
+#pragma once
+#include "benchmark.hpp"
+
+#include <atomic>
+#include <memory>
+
+namespace legion::benchmarks
+{
+    /**@brief Registers the job system benchmarks.
+     * @param jobCount Amount of jobs each sample queues.
+     */
+    inline void register_scheduler_benchmarks(BenchmarkSuite& suite, scheduling::Scheduler* scheduler, size_type jobCount)
+    {
+        suite.add("scheduler/queue_jobs/empty", jobCount, [=]()
+            {
+                scheduler->queueJobs(jobCount, []() {}).wait();
+            });
+
+        suite.add("scheduler/queue_jobs/single", 1, [=]()
+            {
+                scheduler->queueJobs(1, []() {}).wait();
+            });
+
+        auto values = std::make_shared<std::vector<float>>();
+
+        auto& bench = suite.add("scheduler/queue_jobs/parallel_sum", jobCount, [=]()
+            {
+                constexpr size_type valuesPerJob = 256;
+                std::atomic<float> total{ 0.f };
+                scheduler->queueJobs(jobCount, [&]()
+                    {
+                        id_type index = async::this_job::get_id();
+                        float sum = 0.f;
+                        for (size_type i = index * valuesPerJob; i < (index + 1) * valuesPerJob; i++)
+                            sum += (*values)[i];
+
+                        float expected = total.load(std::memory_order_relaxed);
+                        while (!total.compare_exchange_weak(expected, expected + sum, std::memory_order_relaxed));
+                    }).wait();
+                do_not_optimize(total);
+            });
+        bench.setup = [=]() { values->assign(jobCount * 256, 1.f); };
+        bench.teardown = [=]() { values->clear(); values->shrink_to_fit(); };
+    }
+}
@@ -0,0 +1,108 @@
+#define LEGION_MIN_THREADS 2
+
+#include <core/core.hpp>
+#include <physics/physics.hpp>
+
+#include "benchmark.hpp"
+#include "ecs_benchmarks.hpp"
+#include "scheduler_benchmarks.hpp"
+#include "container_benchmarks.hpp"
+#include "physics_benchmarks.hpp"
+#include "scenario_benchmarks.hpp"
+#include "networking_benchmarks.hpp"
+#include "animation_benchmarks.hpp"
+#include "math_benchmarks.hpp"
+#include "rendering_benchmarks.hpp"
+
+using namespace legion;
+using namespace legion::benchmarks;
+
+/**@class BenchmarkModule
+ * @brief Registers all benchmark cases into the suite once the engine is set up.
+ */
+class BenchmarkModule : public Module
+{
+private:
+    BenchmarkSuite& m_suite;
+    size_type m_scale;
+
+public:
+    BenchmarkModule(BenchmarkSuite& suite, size_type scale) : m_suite(suite), m_scale(scale) {}
+
+    virtual void setup() override
+    {
+        register_ecs_benchmarks(m_suite, m_ecs, 1000 * m_scale);
+        register_scheduler_benchmarks(m_suite, m_scheduler, 1024);
+        register_container_benchmarks(m_suite, 10000 * m_scale);
+        register_physics_benchmarks(m_suite, 500 * m_scale);
+        register_scenario_benchmarks(m_suite, m_ecs, m_scheduler, 10000 * m_scale, 10 * m_scale);
+        register_networking_benchmarks(m_suite, m_ecs, 10000 * m_scale, 4);
+        register_animation_benchmarks(m_suite, m_scheduler, 1000 * m_scale, 64);
+        register_math_benchmarks(m_suite, 10000 * m_scale);
+        register_rendering_benchmarks(m_suite, 10000 * m_scale, 32);
+    }
+
+    virtual priority_type priority() override
+    {
+        return PRIORITY_MIN;
+    }
+};
+
+/**@brief Runs the benchmark suite headless and exits with a non zero code if any benchmark regressed.
+ *        --filter=<text>       Only run benchmarks whose name contains the text.
+ *        --output=<file>       Results file, defaults to benchmark_results.json.
+ *        --baseline=<file>     Results file to compare against, a missing or invalid baseline fails the run.
+ *        --threshold=<percent> Allowed median regression before failing, defaults to 10.
+ *        --samples=<n>         Minimum amount of samples per benchmark.
+ *        --min-time=<seconds>  Minimum amount of time spent sampling per benchmark.
+ *        --scale=<n>           Multiplier for the amount of entities and bodies.
+ */
+int main(int argc, char** argv)
+{
+    Engine engine(argc, argv);
+    log::filter(log::severity::info);
+
+    benchmark_options options;
+    if (auto filter = engine.getCliOption("--filter"))
+        options.filter = std::string(*filter);
+    if (auto output = engine.getCliOption("--output"))
+        options.output = std::string(*output);
+    if (auto baseline = engine.getCliOption("--baseline"))
+        options.baseline = std::string(*baseline);
+    if (auto threshold = engine.getCliNumber<float>("--threshold"))
+        options.regressionThreshold = threshold * 0.01f;
+    if (auto samples = engine.getCliNumber<size_type>("--samples"))
+        options.minSamples = samples;
+    if (auto minTime = engine.getCliNumber<float>("--min-time"))
+        options.minTime = minTime;
+
+    size_type scale = engine.getCliNumber<size_type>("--scale");
+
+    BenchmarkSuite suite;
+    engine.reportModule<physics::PhysicsModule>();
+    engine.reportModule<BenchmarkModule>(suite, scale ? scale : 1);
+    engine.init();
+
+    auto results = suite.run(options);
+
+    if (!options.output.empty())
+        BenchmarkSuite::write_results(results, options.output);
+
+    if (!options.baseline.empty())
+    {
+        auto regressions = BenchmarkSuite::compare_baseline(results, options.baseline, options.regressionThreshold);
+        if (!regressions)
+        {
+            log::error("Couldn't compare against the benchmark baseline, failing the run.");
+            return 2;
+        }
+
+        if (*regressions)
+        {
+            log::error("{} benchmark(s) regressed by more than {}%", *regressions, options.regressionThreshold * 100.f);
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <core/filesystem/pack.hpp>
+#include <core/filesystem/filemanip.hpp>
+
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+using namespace legion::core;
+
+/**@brief Packs all files in a directory into a single pack, which can be accessed through the pack_resolver.
+ *        packer <input directory> <output file> [options]
+ *        --align=<bytes> Alignment of the data of every entry, needs to be a power of 2, defaults to 16.
+ *        --store         Store all entries uncompressed.
+ */
+int main(int argc, char** argv)
+{
+    std::string input;
+    std::string output;
+    uint32 alignment = filesystem::pack_writer::default_alignment;
+    bool compress = true;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string_view arg = argv[i];
+        if (arg.rfind("--align=", 0) == 0)
+            alignment = static_cast<uint32>(std::stoul(std::string(arg.substr(8))));
+        else if (arg == "--store")
+            compress = false;
+        else if (input.empty())
+            input = arg;
+        else if (output.empty())
+            output = arg;
+    }
+
+    if (input.empty() || output.empty())
+    {
+        std::cerr << "usage: packer <input directory> <output file> [--align=<bytes>] [--store]\n";
+        return 1;
+    }
+
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+    {
+        std::cerr << "alignment needs to be a power of 2\n";
+        return 1;
+    }
+
+    std::error_code error;
+    if (!std::filesystem::is_directory(input, error))
+    {
+        std::cerr << input << " is not a directory\n";
+        return 1;
+    }
+
+    filesystem::pack_writer writer(alignment, compress);
+    size_type totalSize = 0;
+
+    for (auto& entry : std::filesystem::recursive_directory_iterator(input))
+    {
+        if (!entry.is_regular_file())
+            continue;
+
+        // Don't pack the output into itself when it's written inside of the input directory.
+        if (std::filesystem::equivalent(entry.path(), output, error))
+            continue;
+
+        byte_vec data = filesystem::read_file(entry.path().string());
+        totalSize += data.size();
+        writer.add(std::filesystem::relative(entry.path(), input).generic_string(), std::move(data));
+    }
+
+    const byte_vec pack = writer.build();
+    filesystem::write_file(output, pack);
+
+    std::cout << "packed " << writer.size() << " files, " << totalSize << " bytes into " << pack.size() << " bytes\n";
+    return 0;
+}
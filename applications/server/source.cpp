@@ -0,0 +1,49 @@
+#define LEGION_ENTRY
+#define LEGION_LOW_POWER
+#define LEGION_MIN_THREADS 2 // Update, Physics
+
+#include <core/core.hpp>
+#include <physics/physics.hpp>
+#include <networking/networking.hpp>
+
+using namespace legion;
+
+/**@class ServerModule
+ * @brief Sets up the defaults of the headless server runtime.
+ * @note Run with --tickrate=<hz> to override the default tick rate and --ticks=<n> to exit after n ticks.
+ *       Run with --port=<port> to replicate the simulation to clients connecting on that port.
+ */
+class ServerModule : public Module
+{
+public:
+    static constexpr float default_tick_rate = 60.f;
+
+    virtual void setup() override
+    {
+        if (m_scheduler->getTickRate() <= 0.f)
+            m_scheduler->setTickRate(default_tick_rate);
+
+        log::info("Server running at {} ticks per second.", m_scheduler->getTickRate());
+    }
+
+    virtual priority_type priority() override
+    {
+        return PRIORITY_MAX;
+    }
+};
+
+void LEGION_CCONV reportModules(Engine* engine)
+{
+    log::filter(log::severity::info);
+
+    engine->reportModule<ServerModule>();
+    engine->reportModule<physics::PhysicsModule>();
+
+    if (auto port = engine->getCliNumber<uint16>("--port"))
+    {
+        networking::replication_config config;
+        config.role = networking::replication_role::server;
+        config.address = networking::net_address(0, port);
+        engine->reportModule<networking::NetworkingModule>(config);
+    }
+}
@@ -14,6 +14,10 @@
 
 #include "doctest.h"
 #include "test_filesystem.hpp"
+#include "test_indirect_draw.hpp"
+#include "test_component_snapshot.hpp"
+#include "test_networking.hpp"
+#include "test_batch_math.hpp"
 
 using namespace legion;
 
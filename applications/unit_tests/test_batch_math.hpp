@@ -0,0 +1,177 @@
+#pragma once
+#include <core/math/math.hpp>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "doctest.h"
+
+namespace
+{
+    // Lengths around the SSE and AVX2 widths, so that every implementation has to process a tail.
+    constexpr legion::core::size_type batch_test_lengths[] = { 0, 1, 3, 4, 5, 7, 8, 9, 15, 16, 17, 33 };
+
+    bool batch_close(float a, float b)
+    {
+        return std::abs(a - b) <= 1e-4f * std::max(1.f, std::max(std::abs(a), std::abs(b)));
+    }
+
+    bool batch_close(const legion::core::math::vec3& a, const legion::core::math::vec3& b)
+    {
+        return batch_close(a.x, b.x) && batch_close(a.y, b.y) && batch_close(a.z, b.z);
+    }
+
+    bool batch_close(const legion::core::math::mat4& a, const legion::core::math::mat4& b)
+    {
+        for (int column = 0; column < 4; column++)
+            for (int row = 0; row < 4; row++)
+                if (!batch_close(a[column][row], b[column][row]))
+                    return false;
+        return true;
+    }
+}
+
+TEST_CASE("[core:math] batch routines match glm on every instruction set")
+{
+    using namespace ::legion::core;
+    namespace batch = math::batch;
+
+    constexpr size_type max_count = 33;
+
+    std::mt19937 rng(1337);
+    std::uniform_real_distribution<float> coord(-50.f, 50.f);
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+    std::uniform_real_distribution<float> size(0.25f, 4.f);
+
+    std::vector<math::vec3> positions, scales, points, localMin, localMax, boxMin, boxMax;
+    std::vector<math::quat> rotations;
+    std::vector<math::mat4> transforms;
+    std::vector<float> trs(max_count * 10), x, y, z, radius;
+
+    for (size_type i = 0; i < max_count; i++)
+    {
+        positions.emplace_back(coord(rng), coord(rng), coord(rng));
+        rotations.push_back(math::normalize(math::quat(unit(rng), unit(rng), unit(rng), unit(rng))));
+        scales.emplace_back(size(rng), size(rng), size(rng));
+        transforms.push_back(math::compose(scales[i], rotations[i], positions[i]));
+
+        const float values[10] = { positions[i].x, positions[i].y, positions[i].z, rotations[i].x, rotations[i].y, rotations[i].z, rotations[i].w, scales[i].x, scales[i].y, scales[i].z };
+        for (size_type j = 0; j < 10; j++)
+            trs[j * max_count + i] = values[j];
+
+        points.emplace_back(coord(rng), coord(rng), coord(rng));
+        x.push_back(points[i].x);
+        y.push_back(points[i].y);
+        z.push_back(points[i].z);
+        radius.push_back(size(rng));
+
+        const math::vec3 extents(size(rng), size(rng), size(rng));
+        localMin.push_back(-extents);
+        localMax.push_back(extents * 0.5f);
+        boxMin.push_back(points[i] - extents);
+        boxMax.push_back(points[i] + extents);
+    }
+
+    const float* data = trs.data();
+    const batch::trs_arrays arrays{ data, data + max_count, data + max_count * 2, data + max_count * 3, data + max_count * 4,
+        data + max_count * 5, data + max_count * 6, data + max_count * 7, data + max_count * 8, data + max_count * 9 };
+
+    const math::mat4 transform = transforms[0];
+    const batch::frustum frustum = batch::frustum::from_matrix(math::perspective(math::deg2rad(60.f), 16.f / 9.f, 0.1f, 60.f) * math::lookAt(math::vec3(0.f, 0.f, -40.f), math::vec3(0.f), math::vec3(0.f, 1.f, 0.f)));
+
+    std::vector<uint8> referenceSpheres(max_count), referenceAabbs(max_count);
+    for (size_type i = 0; i < max_count; i++)
+    {
+        referenceSpheres[i] = 1;
+        referenceAabbs[i] = 1;
+        for (auto& plane : frustum.planes)
+        {
+            if (math::dot(math::vec3(plane), points[i]) + plane.w < -radius[i])
+                referenceSpheres[i] = 0;
+
+            const math::vec3 corner(plane.x >= 0.f ? boxMax[i].x : boxMin[i].x, plane.y >= 0.f ? boxMax[i].y : boxMin[i].y, plane.z >= 0.f ? boxMax[i].z : boxMin[i].z);
+            if (math::dot(math::vec3(plane), corner) + plane.w < 0.f)
+                referenceAabbs[i] = 0;
+        }
+    }
+
+    for (auto level : { batch::simd_level::scalar, batch::simd_level::sse, batch::simd_level::avx2 })
+    {
+        if (static_cast<uint8>(level) > static_cast<uint8>(batch::supported_simd_level()))
+            continue;
+
+        batch::set_simd_level(level);
+        REQUIRE_EQ(batch::active_simd_level(), level);
+
+        for (size_type count : batch_test_lengths)
+        {
+            CAPTURE(batch::to_string(level));
+            CAPTURE(count);
+
+            // Outputs are one larger than count to catch implementations writing past the end.
+            const math::mat4 canary(-7.f);
+            std::vector<math::mat4> matrices(count + 1, canary);
+            batch::compose(count, arrays, matrices.data());
+            for (size_type i = 0; i < count; i++)
+                CHECK(batch_close(matrices[i], transforms[i]));
+            CHECK(matrices[count] == canary);
+
+            std::vector<float> outX(count + 1, -7.f), outY(count + 1, -7.f), outZ(count + 1, -7.f);
+            batch::transform_points(transform, count, x.data(), y.data(), z.data(), outX.data(), outY.data(), outZ.data());
+            for (size_type i = 0; i < count; i++)
+                CHECK(batch_close(math::vec3(outX[i], outY[i], outZ[i]), math::vec3(transform * math::vec4(points[i], 1.f))));
+            CHECK_EQ(outZ[count], -7.f);
+
+            math::vec3 min(-7.f), max(-7.f);
+            batch::transformed_bounds(transform, count, points.data(), min, max);
+            if (count)
+            {
+                math::vec3 expectedMin(std::numeric_limits<float>::max()), expectedMax(-std::numeric_limits<float>::max());
+                for (size_type i = 0; i < count; i++)
+                {
+                    const math::vec3 point = transform * math::vec4(points[i], 1.f);
+                    expectedMin = math::min(expectedMin, point);
+                    expectedMax = math::max(expectedMax, point);
+                }
+                CHECK(batch_close(min, expectedMin));
+                CHECK(batch_close(max, expectedMax));
+            }
+            else
+            {
+                CHECK(min == math::vec3(-7.f));
+                CHECK(max == math::vec3(-7.f));
+            }
+
+            std::vector<math::vec3> worldMin(count + 1, math::vec3(-7.f)), worldMax(count + 1, math::vec3(-7.f));
+            batch::world_aabbs(count, transforms.data(), localMin.data(), localMax.data(), worldMin.data(), worldMax.data());
+            for (size_type i = 0; i < count; i++)
+            {
+                math::vec3 expectedMin(std::numeric_limits<float>::max()), expectedMax(-std::numeric_limits<float>::max());
+                for (int corner = 0; corner < 8; corner++)
+                {
+                    const math::vec3 local((corner & 1) ? localMax[i].x : localMin[i].x, (corner & 2) ? localMax[i].y : localMin[i].y, (corner & 4) ? localMax[i].z : localMin[i].z);
+                    const math::vec3 world = transforms[i] * math::vec4(local, 1.f);
+                    expectedMin = math::min(expectedMin, world);
+                    expectedMax = math::max(expectedMax, world);
+                }
+                CHECK(batch_close(worldMin[i], expectedMin));
+                CHECK(batch_close(worldMax[i], expectedMax));
+            }
+            CHECK(worldMax[count] == math::vec3(-7.f));
+
+            std::vector<uint8> spheres(count + 1, 7), aabbs(count + 1, 7);
+            batch::cull_spheres(frustum, count, x.data(), y.data(), z.data(), radius.data(), spheres.data());
+            batch::cull_aabbs(frustum, count, boxMin.data(), boxMax.data(), aabbs.data());
+            for (size_type i = 0; i < count; i++)
+            {
+                CHECK_EQ(spheres[i], referenceSpheres[i]);
+                CHECK_EQ(aabbs[i], referenceAabbs[i]);
+            }
+            CHECK_EQ(spheres[count], 7);
+            CHECK_EQ(aabbs[count], 7);
+        }
+    }
+
+    batch::set_simd_level(batch::supported_simd_level());
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <core/ecs/component_pool.hpp>
+
+#include "doctest.h"
+
+namespace
+{
+    struct snapshot_value
+    {
+        int value = 0;
+    };
+}
+
+TEST_CASE("[core:ecs] component pool snapshots")
+{
+    using namespace ::legion::core;
+
+    events::EventBus eventBus;
+    ecs::component_pool<snapshot_value> pool(nullptr, &eventBus);
+    const ecs::entity_container entities{ ecs::entity_handle(1), ecs::entity_handle(2), ecs::entity_handle(3) };
+    pool.insert_components(entities, ecs::component_container<snapshot_value>{ { 10 }, { 20 }, { 30 } });
+
+    auto read = [&](id_type entity)
+    {
+        async::readonly_guard guard(pool.get_lock());
+        return static_cast<const ecs::component_pool<snapshot_value>&>(pool).get_component(entity).value;
+    };
+
+    auto write = [&](id_type entity, int value)
+    {
+        async::readonly_guard guard(pool.get_lock());
+        pool.get_component(entity).value = value;
+    };
+
+    auto first = pool.take_snapshot(nullptr);
+    REQUIRE(first);
+    CHECK_EQ(first->entities.size(), 3);
+    CHECK_EQ(pool.take_snapshot(first), first);
+
+    write(2, 25);
+
+    auto second = pool.take_snapshot(first);
+    REQUIRE(second);
+    CHECK_NE(second, first);
+    CHECK_NE(second->version, first->version);
+    CHECK_EQ(pool.take_snapshot(second), second);
+
+    SUBCASE("restoring an older snapshot")
+    {
+        write(3, 35);
+        REQUIRE(pool.restore_snapshot(*first));
+        CHECK_EQ(read(1), 10);
+        CHECK_EQ(read(2), 20);
+        CHECK_EQ(read(3), 30);
+        CHECK_EQ(pool.take_snapshot(second)->version, first->version);
+    }
+
+    SUBCASE("restoring the latest snapshot")
+    {
+        write(1, 15);
+        REQUIRE(pool.restore_snapshot(*second));
+        CHECK_EQ(read(1), 10);
+        CHECK_EQ(read(2), 25);
+        CHECK_EQ(read(3), 30);
+        CHECK_EQ(pool.take_snapshot(second), second);
+    }
+
+    SUBCASE("bulk modifications are part of the next snapshot")
+    {
+        pool.set_components(entities, ecs::component_container<snapshot_value>{ { 11 }, { 21 }, { 31 } });
+        auto third = pool.take_snapshot(second);
+        REQUIRE(third);
+        CHECK_NE(third, second);
+
+        pool.clear_components();
+        CHECK_EQ(pool.take_snapshot(third)->entities.size(), 0);
+        REQUIRE(pool.restore_snapshot(*third));
+        CHECK_EQ(read(1), 11);
+        CHECK_EQ(read(2), 21);
+        CHECK_EQ(read(3), 31);
+    }
+}
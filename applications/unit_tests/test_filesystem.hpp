@@ -1,6 +1,8 @@
 #pragma once
 #include <core/filesystem/filesystem.hpp>
 
+#include <filesystem>
+#include <fstream>
 #include <iostream>
 
 #include "doctest.h"
@@ -138,3 +140,79 @@ TEST_CASE("[fs] testing the filesystem")
 
 }
 
+
+TEST_CASE("[fs] testing packed archives")
+{
+    namespace fs = ::legion::core::filesystem;
+
+    std::string compressible(4096, 'a');
+    std::string small = "always has been!";
+
+    fs::pack_writer writer;
+    writer.add("config/compressible.txt", byte_vec(compressible.begin(), compressible.end()));
+    writer.add("config\\small.txt", byte_vec(small.begin(), small.end()));
+    const byte_vec data = writer.build();
+
+    auto pack = fs::pack_archive::from_memory(data.data(), data.size());
+    REQUIRE(pack);
+    CHECK_EQ(pack->entry_count(), 2);
+
+    auto* entry = pack->find("config/compressible.txt");
+    REQUIRE(entry);
+    CHECK_EQ(entry->codec, fs::pack_codec::lz4);
+    CHECK_LT(entry->storedSize, entry->size);
+    CHECK_EQ(entry->offset % fs::pack_writer::default_alignment, 0);
+
+    auto contents = pack->read(*entry);
+    REQUIRE(!contents.has_err());
+    CHECK_EQ(contents.get().to_string(), compressible);
+
+    auto* smallEntry = pack->find("/config/small.txt");
+    REQUIRE(smallEntry);
+    CHECK_EQ(pack->read(*smallEntry).get().to_string(), small);
+
+    CHECK(pack->is_directory("config"));
+    CHECK_EQ(pack->list("config").size(), 2);
+    CHECK_EQ(pack->find("config/missing.txt"), nullptr);
+}
+
+TEST_CASE("[fs] testing path caching")
+{
+    namespace fs = ::legion::core::filesystem;
+
+    fs::provider_registry::domain_create_resolver<fs::basic_resolver>("cache_test://", "./assets");
+
+    const std::string absolutePath = std::filesystem::absolute("./assets/config/cache_test.txt").string();
+    std::filesystem::remove(absolutePath);
+    fs::path_cache::flush();
+
+    const std::string path = fs::strpath_manip::localize("cache_test://config/cache_test.txt");
+    auto first = fs::path_cache::resolve(path, nameHash(path));
+    auto second = fs::path_cache::resolve(path, nameHash(path));
+    REQUIRE(!first.has_err());
+    REQUIRE(!second.has_err());
+    CHECK_EQ(first.get(), second.get());
+
+    fs::view view("cache_test://config/cache_test.txt");
+    CHECK(!view.file_info().exists);
+
+    //files written outside of the filesystem stay unknown until invalidated
+    std::ofstream(absolutePath) << "always has been!";
+    CHECK(!view.file_info().exists);
+
+    fs::path_cache::invalidate(absolutePath);
+    CHECK(view.file_info().exists);
+
+    //files written through the filesystem invalidate themselves
+    std::filesystem::remove(absolutePath);
+    fs::path_cache::flush_disk();
+    CHECK(!view.file_info().exists);
+
+    std::string x = "always has been!";
+    auto result = view.set(fs::basic_resource(byte_vec(x.begin(), x.end())));
+    CHECK(!result.has_err());
+    CHECK(view.file_info().exists);
+
+    std::filesystem::remove(absolutePath);
+    fs::path_cache::invalidate(absolutePath);
+}
@@ -0,0 +1,57 @@
+#pragma once
+#include <rendering/data/indirect_draw.hpp>
+
+#include <vector>
+
+#include "doctest.h"
+
+TEST_CASE("[rendering] building indirect draw lists")
+{
+    using namespace ::legion::core;
+    namespace gfx = ::legion::rendering;
+
+    const std::vector<sub_mesh> twoSubmeshes{ { "a", 6, 0 }, { "b", 3, 6 } };
+    const std::vector<sub_mesh> oneSubmesh{ { "c", 12, 0 } };
+    const std::vector<sub_mesh> noSubmeshes;
+    const std::vector<const std::vector<sub_mesh>*> models{ &twoSubmeshes, &oneSubmesh, &noSubmeshes };
+
+    const std::vector<math::mat4> two(2, math::mat4(1.f));
+    const std::vector<math::mat4> three(3, math::mat4(2.f));
+    const std::vector<math::mat4> none;
+
+    const std::vector<gfx::indirect_draw_input> inputs{
+        { 1, 0, 0, &two },
+        { 0, 0, 1, &three },
+        { 1, 1, 0, &three },
+        { 1, 2, 1, &none },
+        { 0, 1, 2, &two }
+    };
+
+    gfx::indirect_draw_list list;
+    list.build(inputs, models);
+
+    REQUIRE_EQ(list.draws.size(), 2);
+    CHECK_EQ(list.draws[0].group, 0);
+    CHECK_EQ(list.draws[0].model, 1);
+    CHECK_EQ(list.draws[0].commandCount, 1);
+    CHECK_EQ(list.draws[1].group, 1);
+    CHECK_EQ(list.draws[1].model, 0);
+    CHECK_EQ(list.draws[1].firstCommand, 1);
+    CHECK_EQ(list.draws[1].commandCount, 4);
+
+    REQUIRE_EQ(list.commands.size(), 5);
+    CHECK_EQ(list.commands[0].count, 12);
+    CHECK_EQ(list.commands[0].instanceCount, 3);
+    CHECK_EQ(list.commands[0].baseInstance, 0);
+    CHECK_EQ(list.commands[2].firstIndex, 6);
+    CHECK_EQ(list.commands[2].baseInstance, 3);
+    CHECK_EQ(list.commands[4].instanceCount, 3);
+    CHECK_EQ(list.commands[4].baseInstance, 5);
+
+    CHECK_EQ(list.matrices.size(), 8);
+    CHECK_EQ(list.instanceMaterials, std::vector<uint32>{ 0, 0, 0, 0, 0, 1, 1, 1 });
+
+    list.build({}, models);
+    CHECK(list.draws.empty());
+    CHECK(list.matrices.empty());
+}
@@ -0,0 +1,268 @@
+#pragma once
+#include <networking/data/bitstream.hpp>
+#include <networking/data/quantization.hpp>
+#include <networking/transport/sequence_buffer.hpp>
+#include <networking/transport/connection.hpp>
+
+#include <iterator>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "doctest.h"
+
+TEST_CASE("[networking] bit stream round trips")
+{
+    using namespace ::legion::core;
+    namespace net = ::legion::networking;
+
+    SUBCASE("every bit width")
+    {
+        byte_vec buffer;
+        net::bit_writer writer(buffer);
+
+        // Odd widths make every value straddle byte and scratch word boundaries at some point.
+        std::vector<uint32> values;
+        for (uint32 bits = 1; bits <= 32; bits++)
+        {
+            const uint32 value = 0xA5C3F09Bu & net::detail::bit_mask(bits);
+            values.push_back(value);
+            writer.write_bits(value, bits);
+        }
+        writer.flush();
+
+        CHECK_EQ(writer.bits_written(), 528); // 1 + 2 + ... + 32
+        CHECK_EQ(buffer.size(), 66);
+
+        net::bit_reader reader(buffer.data(), buffer.size());
+        for (uint32 bits = 1; bits <= 32; bits++)
+            CHECK_EQ(reader.read_bits(bits), values[bits - 1]);
+        CHECK_FALSE(reader.overflowed());
+
+        CHECK_EQ(reader.read_bits(32), 0);
+        CHECK(reader.overflowed());
+    }
+
+    SUBCASE("mixed values and raw bytes")
+    {
+        const byte raw[5] = { 1, 2, 3, 4, 5 };
+
+        byte_vec buffer;
+        net::bit_writer writer(buffer);
+        writer.write_bits(5, 3);
+        writer.write_uint64(0x0123456789ABCDEFull);
+        writer.write_bool(true);
+        writer.write_float(-3.25f);
+        writer.write_bits(0x1FFFFFFF, 29);
+        writer.write_bytes(raw, sizeof(raw));
+        writer.write_bits(3, 2);
+        writer.flush();
+
+        net::bit_reader reader(buffer.data(), buffer.size());
+        CHECK_EQ(reader.read_bits(3), 5);
+        CHECK_EQ(reader.read_uint64(), 0x0123456789ABCDEFull);
+        CHECK(reader.read_bool());
+        CHECK_EQ(reader.read_float(), -3.25f);
+        CHECK_EQ(reader.read_bits(29), 0x1FFFFFFF);
+
+        byte read[5] = {};
+        REQUIRE(reader.read_bytes(read, sizeof(read)));
+        for (size_type i = 0; i < sizeof(raw); i++)
+            CHECK_EQ(read[i], raw[i]);
+
+        CHECK_EQ(reader.read_bits(2), 3);
+        CHECK_FALSE(reader.overflowed());
+
+        byte tooMany[2];
+        CHECK_FALSE(reader.read_bytes(tooMany, sizeof(tooMany)));
+        CHECK(reader.overflowed());
+    }
+}
+
+TEST_CASE("[networking] varints")
+{
+    using namespace ::legion::core;
+    namespace net = ::legion::networking;
+
+    SUBCASE("unsigned limits")
+    {
+        const uint64 values[] = { 0ull, 127ull, 128ull, 16383ull, 16384ull, std::numeric_limits<uint64>::max() };
+        const size_type sizes[] = { 1, 1, 2, 2, 3, 10 };
+
+        for (size_type i = 0; i < std::size(values); i++)
+        {
+            byte_vec buffer;
+            net::bit_writer writer(buffer);
+            writer.write_varint(values[i]);
+            writer.flush();
+            CHECK_EQ(buffer.size(), sizes[i]);
+
+            net::bit_reader reader(buffer.data(), buffer.size());
+            CHECK_EQ(reader.read_varint(), values[i]);
+            CHECK_FALSE(reader.overflowed());
+        }
+    }
+
+    SUBCASE("zigzag limits")
+    {
+        const int64 values[] = { 0, -1, 1, -64, 63, -65, 64, std::numeric_limits<int64>::min(), std::numeric_limits<int64>::max() };
+
+        byte_vec buffer;
+        net::bit_writer writer(buffer);
+        for (int64 value : values)
+            writer.write_signed(value);
+        writer.flush();
+
+        net::bit_reader reader(buffer.data(), buffer.size());
+        for (int64 value : values)
+            CHECK_EQ(reader.read_signed(), value);
+        CHECK_FALSE(reader.overflowed());
+
+        // Values close to 0 stay small regardless of their sign.
+        byte_vec small;
+        net::bit_writer smallWriter(small);
+        smallWriter.write_signed(-64);
+        smallWriter.write_signed(63);
+        smallWriter.flush();
+        CHECK_EQ(small.size(), 2);
+    }
+
+    SUBCASE("malformed")
+    {
+        const byte_vec buffer(11, 0xFF);
+        net::bit_reader reader(buffer.data(), buffer.size());
+        CHECK_EQ(reader.read_varint(), 0);
+        CHECK(reader.overflowed());
+
+        const byte_vec truncated(3, 0x80);
+        net::bit_reader truncatedReader(truncated.data(), truncated.size());
+        (void)truncatedReader.read_varint();
+        CHECK(truncatedReader.overflowed());
+    }
+}
+
+TEST_CASE("[networking] quantization")
+{
+    using namespace ::legion::core;
+    namespace net = ::legion::networking;
+
+    SUBCASE("floats")
+    {
+        constexpr float precision = 1.f / 512.f;
+        for (float value : { 0.f, 0.001f, -0.001f, 1.f / 3.f, -123.456f, 4096.7f })
+            CHECK(std::abs(net::dequantize_float(net::quantize_float(value, precision), precision) - value) <= precision * 0.5f);
+
+        CHECK_EQ(net::quantize_float(1e30f, precision), 2147483520);
+        CHECK_EQ(net::quantize_float(-1e30f, precision), -2147483520);
+
+        const math::vec3 vec(1.5f, -2.25f, 1000.001f);
+        const math::vec3 result = net::dequantize_vec3(net::quantize_vec3(vec, precision), precision);
+        CHECK(math::length(result - vec) <= precision);
+    }
+
+    SUBCASE("smallest three rotations")
+    {
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<float> unit(-1.f, 1.f);
+
+        std::vector<math::quat> rotations{ math::quat(1.f, 0.f, 0.f, 0.f), math::quat(0.f, 0.f, 0.f, -1.f), math::angleAxis(math::pi<float>() * 0.5f, math::vec3(0.f, 1.f, 0.f)) };
+        for (size_type i = 0; i < 1000; i++)
+            rotations.push_back(math::normalize(math::quat(unit(rng), unit(rng), unit(rng), unit(rng))));
+
+        for (auto& rotation : rotations)
+        {
+            const uint32 quantized = net::quantize_rotation(rotation);
+            const math::quat result = net::dequantize_rotation(quantized);
+
+            // q and -q are the same rotation, so compare the absolute dot product.
+            CHECK(std::abs(math::dot(result, math::normalize(rotation))) >= 0.9995f);
+            CHECK_EQ(net::quantize_rotation(-rotation), quantized);
+        }
+    }
+}
+
+TEST_CASE("[networking] sequence numbers")
+{
+    using namespace ::legion::core;
+    namespace net = ::legion::networking;
+
+    SUBCASE("comparison across the wrap")
+    {
+        CHECK(net::sequence_greater_than(1, 0));
+        CHECK(net::sequence_greater_than(0, 65535));
+        CHECK(net::sequence_greater_than(5, 65530));
+        CHECK_FALSE(net::sequence_greater_than(65535, 0));
+        CHECK_FALSE(net::sequence_greater_than(7, 7));
+        CHECK(net::sequence_less_than(65535, 0));
+        CHECK(net::sequence_greater_than(32768, 0));
+        CHECK_FALSE(net::sequence_greater_than(32769, 0));
+    }
+
+    SUBCASE("buffer across the wrap")
+    {
+        net::sequence_buffer<int, 256> buffer;
+        buffer.insert(65535) = 1;
+        buffer.insert(0) = 2;
+        CHECK_EQ(*buffer.find(65535), 1);
+        CHECK_EQ(*buffer.find(0), 2);
+
+        buffer.insert(255) = 3; // Same slot as 65535.
+        CHECK_FALSE(buffer.contains(65535));
+        CHECK_EQ(*buffer.find(255), 3);
+
+        buffer.remove(65535);
+        CHECK(buffer.contains(255));
+    }
+
+    SUBCASE("acknowledgements across the wrap")
+    {
+        net::connection sender(net::net_address(net::localhost, 1), 0.0);
+        net::connection receiver(net::net_address(net::localhost, 2), 0.0);
+
+        byte_vec buffer;
+        while (sender.next_sequence() != 65530)
+        {
+            buffer.clear();
+            net::bit_writer writer(buffer);
+            (void)sender.write_header(writer, 0.0);
+        }
+
+        // Send 65530 up to and including 5, dropping 65534 and 2.
+        std::vector<uint16> delivered;
+        for (size_type i = 0; i < 12; i++)
+        {
+            buffer.clear();
+            net::bit_writer writer(buffer);
+            const uint16 sequence = sender.write_header(writer, 0.0);
+            writer.flush();
+
+            if (sequence == 65534 || sequence == 2)
+                continue;
+
+            net::bit_reader reader(buffer.data(), buffer.size());
+            uint16 received;
+            REQUIRE(receiver.read_header(reader, 0.0, received));
+            CHECK_EQ(received, sequence);
+            receiver.acknowledge(received);
+            delivered.push_back(sequence);
+        }
+
+        buffer.clear();
+        net::bit_writer writer(buffer);
+        (void)receiver.write_header(writer, 0.1);
+        writer.flush();
+
+        net::bit_reader reader(buffer.data(), buffer.size());
+        uint16 received;
+        REQUIRE(sender.read_header(reader, 0.1, received));
+
+        for (uint16 sequence : delivered)
+            CHECK(sender.is_acked(sequence));
+        CHECK_FALSE(sender.is_acked(65534));
+        CHECK_FALSE(sender.is_acked(2));
+
+        std::vector<uint16> acked;
+        sender.take_acked_packets(acked);
+        CHECK_EQ(acked.size(), delivered.size());
+    }
+}
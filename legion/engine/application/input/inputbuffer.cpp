@@ -0,0 +1,117 @@
+#include <application/input/inputbuffer.hpp>
+
+namespace legion::application
+{
+    std::array<raw_input, InputBuffer::m_capacity> InputBuffer::m_events;
+    std::atomic<size_type> InputBuffer::m_head{ 0 };
+    std::atomic<size_type> InputBuffer::m_tail{ 0 };
+    std::atomic<uint64> InputBuffer::m_dropped{ 0 };
+
+    std::atomic<uint64> InputBuffer::m_sequence{ 0 };
+    std::atomic<id_type> InputBuffer::m_pointerWindow{ invalid_id };
+    std::atomic<double> InputBuffer::m_positionX{ 0.0 };
+    std::atomic<double> InputBuffer::m_positionY{ 0.0 };
+    std::atomic<double> InputBuffer::m_scrollX{ 0.0 };
+    std::atomic<double> InputBuffer::m_scrollY{ 0.0 };
+    std::atomic<uint64> InputBuffer::m_moveCount{ 0 };
+    std::atomic<uint64> InputBuffer::m_scrollCount{ 0 };
+
+    void InputBuffer::push(const raw_input& event)
+    {
+        const size_type head = m_head.load(std::memory_order_relaxed);
+        if (head - m_tail.load(std::memory_order_acquire) >= m_capacity)
+        {
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        m_events[head & (m_capacity - 1)] = event;
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    template<typename Func>
+    void InputBuffer::writePointer(ecs::component_handle<window> windowHandle, Func&& func)
+    {
+        const uint64 sequence = m_sequence.load(std::memory_order_relaxed);
+        m_sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        m_pointerWindow.store(windowHandle.entity.get_id(), std::memory_order_relaxed);
+        func();
+
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    void InputBuffer::pushKey(ecs::component_handle<window> windowHandle, int key, int scancode, int action, int mods)
+    {
+        push(raw_input{ input_record_type::key, windowHandle, key, scancode, action, mods });
+    }
+
+    void InputBuffer::pushMouseButton(ecs::component_handle<window> windowHandle, int button, int action, int mods)
+    {
+        push(raw_input{ input_record_type::mouse_button, windowHandle, button, 0, action, mods });
+    }
+
+    void InputBuffer::moveMouse(ecs::component_handle<window> windowHandle, const math::dvec2& position)
+    {
+        writePointer(windowHandle, [&]()
+            {
+                m_positionX.store(position.x, std::memory_order_relaxed);
+                m_positionY.store(position.y, std::memory_order_relaxed);
+                m_moveCount.store(m_moveCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            });
+    }
+
+    void InputBuffer::scrollMouse(ecs::component_handle<window> windowHandle, const math::dvec2& offset)
+    {
+        writePointer(windowHandle, [&]()
+            {
+                m_scrollX.store(m_scrollX.load(std::memory_order_relaxed) + offset.x, std::memory_order_relaxed);
+                m_scrollY.store(m_scrollY.load(std::memory_order_relaxed) + offset.y, std::memory_order_relaxed);
+                m_scrollCount.store(m_scrollCount.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            });
+    }
+
+    bool InputBuffer::pop(raw_input& event)
+    {
+        const size_type tail = m_tail.load(std::memory_order_relaxed);
+        if (tail == m_head.load(std::memory_order_acquire))
+            return false;
+
+        event = m_events[tail & (m_capacity - 1)];
+        m_tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    pointer_state InputBuffer::readPointer()
+    {
+        pointer_state state;
+        uint64 before;
+        uint64 after;
+        do
+        {
+            before = m_sequence.load(std::memory_order_acquire);
+            if (before & 1)
+            {
+                L_PAUSE_INSTRUCTION();
+                continue;
+            }
+
+            state.windowHandle = ecs::component_handle<window>(m_pointerWindow.load(std::memory_order_relaxed));
+            state.position = math::dvec2(m_positionX.load(std::memory_order_relaxed), m_positionY.load(std::memory_order_relaxed));
+            state.scrollTotal = math::dvec2(m_scrollX.load(std::memory_order_relaxed), m_scrollY.load(std::memory_order_relaxed));
+            state.moveCount = m_moveCount.load(std::memory_order_relaxed);
+            state.scrollCount = m_scrollCount.load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = m_sequence.load(std::memory_order_relaxed);
+        } while ((before & 1) || before != after);
+
+        return state;
+    }
+
+    uint64 InputBuffer::droppedEvents()
+    {
+        return m_dropped.load(std::memory_order_relaxed);
+    }
+}
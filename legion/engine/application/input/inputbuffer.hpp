@@ -0,0 +1,100 @@
+#pragma once
+#include <application/window/window.hpp>
+#include <application/input/inputrecording.hpp>
+
+#include <array>
+#include <atomic>
+
+/**
+ * @file inputbuffer.hpp
+ * @brief Hand-off of raw input from the GLFW callbacks to the InputSystem without going through the event bus.
+ *        Discrete input (keys and mouse buttons) goes through a lock-free single producer single consumer ring buffer so no press or release is lost.
+ *        Continuous input (mouse movement and scrolling) gets coalesced on the spot, so a high polling rate mouse costs a few stores per event
+ *        and the InputSystem only sees the accumulated result once per update.
+ */
+
+namespace legion::application
+{
+    /**@class raw_input
+     * @brief Discrete raw input event, type is either input_record_type::key or input_record_type::mouse_button.
+     */
+    struct raw_input
+    {
+        input_record_type type;
+        ecs::component_handle<window> windowHandle;
+        int code; // Key or mouse button.
+        int scancode;
+        int action;
+        int mods;
+    };
+
+    /**@class pointer_state
+     * @brief Coalesced mouse state, counters only ever go up so the reader can tell whether anything changed since it's last read.
+     */
+    struct pointer_state
+    {
+        ecs::component_handle<window> windowHandle;
+        math::dvec2 position;
+        math::dvec2 scrollTotal; // Sum of all scroll offsets since startup.
+        uint64 moveCount = 0;
+        uint64 scrollCount = 0;
+    };
+
+    /**@class InputBuffer
+     * @brief Static buffer between the thread polling the window events and the InputSystem.
+     * @note Only a single thread may push input, which GLFW guarantees by calling all callbacks from the thread that polls the events.
+     */
+    class InputBuffer
+    {
+    private:
+        static constexpr size_type m_capacity = 1024; // Needs to be a power of 2.
+
+        static std::array<raw_input, m_capacity> m_events;
+        static std::atomic<size_type> m_head; // Next slot to write.
+        static std::atomic<size_type> m_tail; // Next slot to read.
+        static std::atomic<uint64> m_dropped;
+
+        // Pointer state is published with a sequence lock, odd sequence numbers mean a write is in progress.
+        static std::atomic<uint64> m_sequence;
+        static std::atomic<id_type> m_pointerWindow; // Entity of the window the mouse was last moved or scrolled in.
+        static std::atomic<double> m_positionX;
+        static std::atomic<double> m_positionY;
+        static std::atomic<double> m_scrollX;
+        static std::atomic<double> m_scrollY;
+        static std::atomic<uint64> m_moveCount;
+        static std::atomic<uint64> m_scrollCount;
+
+        static void push(const raw_input& event);
+
+        template<typename Func>
+        static void writePointer(ecs::component_handle<window> windowHandle, Func&& func);
+
+    public:
+        InputBuffer() = delete;
+        ~InputBuffer() = delete;
+
+        static void pushKey(ecs::component_handle<window> windowHandle, int key, int scancode, int action, int mods);
+        static void pushMouseButton(ecs::component_handle<window> windowHandle, int button, int action, int mods);
+
+        /**@brief Overwrites the mouse position, only the last position before the next update gets seen.
+         */
+        static void moveMouse(ecs::component_handle<window> windowHandle, const math::dvec2& position);
+
+        /**@brief Adds to the scroll offset, all offsets until the next update get summed.
+         */
+        static void scrollMouse(ecs::component_handle<window> windowHandle, const math::dvec2& offset);
+
+        /**@brief Takes the oldest discrete event out of the buffer.
+         * @return bool False if the buffer is empty.
+         */
+        static bool pop(raw_input& event);
+
+        /**@brief Reads a consistent copy of the coalesced mouse state.
+         */
+        L_NODISCARD static pointer_state readPointer();
+
+        /**@brief Amount of discrete events that got dropped because the buffer was full.
+         */
+        L_NODISCARD static uint64 droppedEvents();
+    };
+}
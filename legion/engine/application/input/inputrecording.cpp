@@ -0,0 +1,213 @@
+#include <application/input/inputrecording.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace legion::application
+{
+    void InputRecording::writeVarint(uint64 value)
+    {
+        while (value >= 0x80)
+        {
+            m_data.push_back(static_cast<byte>(value | 0x80));
+            value >>= 7;
+        }
+        m_data.push_back(static_cast<byte>(value));
+    }
+
+    void InputRecording::writeInt(int value)
+    {
+        // Zigzag encoding keeps small negative values like GLFW_KEY_UNKNOWN small.
+        const int64 wide = value;
+        writeVarint(static_cast<uint64>((wide << 1) ^ (wide >> 63)));
+    }
+
+    void InputRecording::writeRaw(const void* src, size_type size)
+    {
+        const byte* bytes = static_cast<const byte*>(src);
+        m_data.insert(m_data.end(), bytes, bytes + size);
+    }
+
+    bool InputRecording::readVarint(uint64& value)
+    {
+        value = 0;
+        for (uint shift = 0; shift < 64; shift += 7)
+        {
+            if (m_readPos >= m_data.size())
+                return false;
+
+            const byte part = m_data[m_readPos++];
+            value |= static_cast<uint64>(part & 0x7F) << shift;
+            if (!(part & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    bool InputRecording::readInt(int& value)
+    {
+        uint64 encoded;
+        if (!readVarint(encoded))
+            return false;
+
+        value = static_cast<int>(static_cast<int64>(encoded >> 1) ^ -static_cast<int64>(encoded & 1));
+        return true;
+    }
+
+    bool InputRecording::readRaw(void* dst, size_type size)
+    {
+        if (m_readPos + size > m_data.size())
+            return false;
+
+        std::memcpy(dst, m_data.data() + m_readPos, size);
+        m_readPos += size;
+        return true;
+    }
+
+    void InputRecording::clear()
+    {
+        m_data.clear();
+        m_writeTick = 0;
+        m_recordCount = 0;
+        rewind();
+    }
+
+    void InputRecording::write(const input_record& record)
+    {
+        writeVarint(record.tick - m_writeTick);
+        m_writeTick = record.tick;
+        m_data.push_back(static_cast<byte>(record.type));
+
+        switch (record.type)
+        {
+        case input_record_type::key:
+        case input_record_type::mouse_button:
+            writeInt(record.code);
+            m_data.push_back(static_cast<byte>(record.action));
+            m_data.push_back(static_cast<byte>(record.mods));
+            break;
+        case input_record_type::mouse_move:
+        case input_record_type::mouse_scroll:
+            writeRaw(&record.vector.x, sizeof(double));
+            writeRaw(&record.vector.y, sizeof(double));
+            break;
+        case input_record_type::gamepad:
+        {
+            m_data.push_back(static_cast<byte>(record.code));
+            uint16 buttons = 0;
+            for (uint i = 0; i <= GLFW_GAMEPAD_BUTTON_LAST; i++)
+                if (record.gamepad.buttons[i] == GLFW_PRESS)
+                    buttons |= static_cast<uint16>(1u << i);
+            writeRaw(&buttons, sizeof(buttons));
+            writeRaw(record.gamepad.axes, sizeof(record.gamepad.axes));
+            break;
+        }
+        case input_record_type::gamepad_disconnected:
+            m_data.push_back(static_cast<byte>(record.code));
+            break;
+        }
+
+        m_recordCount++;
+    }
+
+    bool InputRecording::read(input_record& record)
+    {
+        uint64 delta;
+        byte type;
+        if (!readVarint(delta) || !readRaw(&type, sizeof(type)))
+            return false;
+
+        m_readTick += delta;
+        record.tick = m_readTick;
+        record.type = static_cast<input_record_type>(type);
+
+        switch (record.type)
+        {
+        case input_record_type::key:
+        case input_record_type::mouse_button:
+        {
+            byte action, mods;
+            if (!readInt(record.code) || !readRaw(&action, sizeof(action)) || !readRaw(&mods, sizeof(mods)))
+                return false;
+            record.action = action;
+            record.mods = mods;
+            return true;
+        }
+        case input_record_type::mouse_move:
+        case input_record_type::mouse_scroll:
+            return readRaw(&record.vector.x, sizeof(double)) && readRaw(&record.vector.y, sizeof(double));
+        case input_record_type::gamepad:
+        {
+            byte joystick;
+            uint16 buttons;
+            if (!readRaw(&joystick, sizeof(joystick)) || !readRaw(&buttons, sizeof(buttons)) || !readRaw(record.gamepad.axes, sizeof(record.gamepad.axes)))
+                return false;
+            record.code = joystick;
+            for (uint i = 0; i <= GLFW_GAMEPAD_BUTTON_LAST; i++)
+                record.gamepad.buttons[i] = (buttons & (1u << i)) ? GLFW_PRESS : GLFW_RELEASE;
+            return true;
+        }
+        case input_record_type::gamepad_disconnected:
+        {
+            byte joystick;
+            if (!readRaw(&joystick, sizeof(joystick)))
+                return false;
+            record.code = joystick;
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    void InputRecording::rewind()
+    {
+        m_readPos = 0;
+        m_readTick = 0;
+    }
+
+    bool InputRecording::save(const std::string& path) const
+    {
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            log::error("Could not open {} to save the input recording.", path);
+            return false;
+        }
+
+        const uint64 recordCount = m_recordCount;
+        file.write(reinterpret_cast<const char*>(&m_magic), sizeof(m_magic));
+        file.write(reinterpret_cast<const char*>(&m_version), sizeof(m_version));
+        file.write(reinterpret_cast<const char*>(&recordCount), sizeof(recordCount));
+        file.write(reinterpret_cast<const char*>(m_data.data()), static_cast<std::streamsize>(m_data.size()));
+        return file.good();
+    }
+
+    bool InputRecording::load(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            log::error("Could not open input recording {}.", path);
+            return false;
+        }
+
+        uint32 magic = 0;
+        uint8 version = 0;
+        uint64 recordCount = 0;
+        file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+        file.read(reinterpret_cast<char*>(&version), sizeof(version));
+        file.read(reinterpret_cast<char*>(&recordCount), sizeof(recordCount));
+        if (!file || magic != m_magic || version != m_version)
+        {
+            log::error("{} is not a valid input recording.", path);
+            return false;
+        }
+
+        clear();
+        m_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        m_recordCount = static_cast<size_type>(recordCount);
+        return true;
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <application/context/contexthelper.hpp>
+
+#include <string>
+#include <vector>
+
+/**
+ * @file inputrecording.hpp
+ * @brief Compact binary stream of raw input, used by the InputSystem to record gameplay sessions and replay them.
+ *        Every record starts with the amount of input updates since the previous record as a varint followed by a type byte and a small payload.
+ *        Mouse positions and gamepad axes are stored bit exact so that a replay reproduces the recorded session exactly in deterministic mode.
+ */
+
+namespace legion::application
+{
+    enum struct input_record_type : uint8
+    {
+        key = 0,
+        mouse_move = 1,
+        mouse_button = 2,
+        mouse_scroll = 3,
+        gamepad = 4,
+        gamepad_disconnected = 5
+    };
+
+    /**@class input_record
+     * @brief Single raw input event, only the members used by the type of the record are valid.
+     */
+    struct input_record
+    {
+        uint64 tick = 0; // Input update the event was applied in, relative to the start of the recording.
+        input_record_type type = input_record_type::key;
+        int code = 0; // Key, mouse button or joystick id.
+        int action = 0;
+        int mods = 0;
+        math::dvec2 vector; // Mouse position or scroll offset.
+        GLFWgamepadstate gamepad;
+    };
+
+    /**@class InputRecording
+     * @brief Append only buffer of input records with a sequential reader.
+     */
+    class InputRecording
+    {
+    private:
+        static constexpr uint32 m_magic = 0x5249474C; // "LGIR"
+        static constexpr uint8 m_version = 1;
+
+        std::vector<byte> m_data;
+        uint64 m_writeTick = 0;
+        size_type m_readPos = 0;
+        uint64 m_readTick = 0;
+        size_type m_recordCount = 0;
+
+        void writeVarint(uint64 value);
+        void writeInt(int value);
+        void writeRaw(const void* src, size_type size);
+
+        bool readVarint(uint64& value);
+        bool readInt(int& value);
+        bool readRaw(void* dst, size_type size);
+
+    public:
+        /**@brief Removes all records and rewinds the reader.
+         */
+        void clear();
+
+        /**@brief Appends a record, records need to be written in order of their tick.
+         */
+        void write(const input_record& record);
+
+        /**@brief Reads the next record.
+         * @return bool False if there are no more records or the stream is corrupt.
+         */
+        bool read(input_record& record);
+
+        /**@brief Moves the reader back to the first record.
+         */
+        void rewind();
+
+        /**@brief Writes the recording to a file.
+         * @return bool True if the file could be written.
+         */
+        bool save(const std::string& path) const;
+
+        /**@brief Replaces the recording with the contents of a file written by save.
+         * @return bool True if the file could be read and is a valid recording.
+         */
+        bool load(const std::string& path);
+
+        L_NODISCARD size_type recordCount() const noexcept { return m_recordCount; }
+        L_NODISCARD size_type byteSize() const noexcept { return m_data.size(); }
+        L_NODISCARD bool empty() const noexcept { return m_data.empty(); }
+    };
+}
@@ -1,5 +1,7 @@
 #include <application/input/inputsystem.hpp>
 
+#include <cstring>
+
 namespace legion::application
 {
     math::dvec2 InputSystem::m_mousePos;
@@ -10,4 +12,252 @@ namespace legion::application
 
     sparse_map<inputmap::method, sparse_map<id_type, InputSystem::axis_data>> InputSystem::m_axes;
     sparse_map<id_type,InputSystem::axis_command_queue> InputSystem::m_axes_command_queues;
+
+    async::spinlock InputSystem::m_recordingLock;
+    InputRecording InputSystem::m_recording;
+    std::atomic_bool InputSystem::m_recordingActive{ false };
+    std::atomic_bool InputSystem::m_replayActive{ false };
+    uint64 InputSystem::m_lastMoveCount = 0;
+    uint64 InputSystem::m_lastScrollCount = 0;
+    math::dvec2 InputSystem::m_lastScrollTotal;
+    std::map<int, GLFWgamepadstate> InputSystem::m_recordedGamepads;
+    input_record InputSystem::m_nextRecord;
+    bool InputSystem::m_hasNextRecord = false;
+    uint64 InputSystem::m_updateCount = 0;
+    uint64 InputSystem::m_recordingStart = 0;
+
+    void InputSystem::startRecording()
+    {
+        std::lock_guard guard(m_recordingLock);
+        m_replayActive.store(false, std::memory_order_relaxed);
+        m_recording.clear();
+        m_recordedGamepads.clear();
+        m_recordingStart = m_updateCount;
+        m_recordingActive.store(true, std::memory_order_release);
+        log::info("Started recording input.");
+    }
+
+    void InputSystem::stopRecording()
+    {
+        std::lock_guard guard(m_recordingLock);
+        if (!m_recordingActive.exchange(false, std::memory_order_acq_rel))
+            return;
+
+        log::info("Stopped recording input, recorded {} events in {} bytes.", m_recording.recordCount(), m_recording.byteSize());
+    }
+
+    bool InputSystem::saveRecording(const std::string& path)
+    {
+        std::lock_guard guard(m_recordingLock);
+        return m_recording.save(path);
+    }
+
+    void InputSystem::startReplay()
+    {
+        std::lock_guard guard(m_recordingLock);
+        m_recordingActive.store(false, std::memory_order_relaxed);
+        m_recordedGamepads.clear();
+        m_recording.rewind();
+        m_hasNextRecord = m_recording.read(m_nextRecord);
+        m_recordingStart = m_updateCount;
+        m_replayActive.store(true, std::memory_order_release);
+        log::info("Started replaying {} input events.", m_recording.recordCount());
+    }
+
+    bool InputSystem::startReplay(const std::string& path)
+    {
+        {
+            std::lock_guard guard(m_recordingLock);
+            m_replayActive.store(false, std::memory_order_relaxed);
+            if (!m_recording.load(path))
+                return false;
+        }
+
+        startReplay();
+        return true;
+    }
+
+    void InputSystem::stopReplay()
+    {
+        std::lock_guard guard(m_recordingLock);
+        m_replayActive.store(false, std::memory_order_release);
+        m_recordedGamepads.clear();
+    }
+
+    bool InputSystem::isRecording()
+    {
+        return m_recordingActive.load(std::memory_order_acquire);
+    }
+
+    bool InputSystem::isReplaying()
+    {
+        return m_replayActive.load(std::memory_order_acquire);
+    }
+
+    void InputSystem::submitRecord(const input_record& record)
+    {
+        if (isReplaying())
+            return; // Live input would make the replay diverge.
+
+        if (isRecording())
+        {
+            std::lock_guard guard(m_recordingLock);
+            if (m_recordingActive.load(std::memory_order_relaxed))
+            {
+                input_record recorded = record;
+                recorded.tick = m_updateCount - m_recordingStart;
+                m_recording.write(recorded);
+            }
+        }
+
+        applyRecord(record);
+    }
+
+    void InputSystem::pollRawInput()
+    {
+        OPTICK_EVENT();
+
+        raw_input event;
+        while (InputBuffer::pop(event))
+        {
+            input_record record;
+            record.type = event.type;
+            record.code = event.code;
+            record.action = event.action;
+            record.mods = event.mods;
+
+            if (event.type == input_record_type::key)
+                raiseEvent<key_input>(event.windowHandle, event.code, event.scancode, event.action, event.mods);
+            else
+                raiseEvent<mouse_button>(event.windowHandle, event.code, event.action, event.mods);
+
+            submitRecord(record);
+        }
+
+        const pointer_state pointer = InputBuffer::readPointer();
+        if (pointer.moveCount != m_lastMoveCount)
+        {
+            m_lastMoveCount = pointer.moveCount;
+            raiseEvent<mouse_moved>(pointer.windowHandle, pointer.position);
+
+            input_record record;
+            record.type = input_record_type::mouse_move;
+            record.vector = pointer.position;
+            submitRecord(record);
+        }
+
+        if (pointer.scrollCount != m_lastScrollCount)
+        {
+            const math::dvec2 offset = pointer.scrollTotal - m_lastScrollTotal;
+            m_lastScrollCount = pointer.scrollCount;
+            m_lastScrollTotal = pointer.scrollTotal;
+            raiseEvent<mouse_scrolled>(pointer.windowHandle, offset);
+
+            input_record record;
+            record.type = input_record_type::mouse_scroll;
+            record.vector = offset;
+            submitRecord(record);
+        }
+    }
+
+    void InputSystem::processRecords()
+    {
+        if (!isReplaying())
+            return;
+
+        OPTICK_EVENT();
+        memory::frame_vector<input_record> records;
+
+        {
+            std::lock_guard guard(m_recordingLock);
+            if (!m_replayActive.load(std::memory_order_relaxed))
+                return;
+
+            const uint64 tick = m_updateCount - m_recordingStart;
+            while (m_hasNextRecord && m_nextRecord.tick <= tick)
+            {
+                records.push_back(m_nextRecord);
+                m_hasNextRecord = m_recording.read(m_nextRecord);
+            }
+
+            if (!m_hasNextRecord)
+            {
+                m_replayActive.store(false, std::memory_order_release);
+                log::info("Finished replaying input.");
+            }
+        }
+
+        for (auto& record : records)
+            applyRecord(record);
+    }
+
+    void InputSystem::applyRecord(const input_record& record)
+    {
+        switch (record.type)
+        {
+        case input_record_type::key:
+            applyKey(record.code, record.action, record.mods);
+            break;
+        case input_record_type::mouse_move:
+            applyMouseMove(record.vector);
+            break;
+        case input_record_type::mouse_button:
+            applyMouseButton(record.code, record.action, record.mods);
+            break;
+        case input_record_type::mouse_scroll:
+            applyMouseScroll(record.vector);
+            break;
+        case input_record_type::gamepad:
+            m_recordedGamepads[record.code] = record.gamepad;
+            break;
+        case input_record_type::gamepad_disconnected:
+            m_recordedGamepads.erase(record.code);
+            break;
+        }
+    }
+
+    void InputSystem::recordGamepad(int glfw_joystick_id, const GLFWgamepadstate& state)
+    {
+        auto it = m_recordedGamepads.find(glfw_joystick_id);
+        if (it != m_recordedGamepads.end() &&
+            std::memcmp(it->second.buttons, state.buttons, sizeof(state.buttons)) == 0 &&
+            std::memcmp(it->second.axes, state.axes, sizeof(state.axes)) == 0)
+            return; // Only changes are recorded.
+
+        input_record record;
+        record.type = input_record_type::gamepad;
+        record.code = glfw_joystick_id;
+        record.gamepad = state;
+
+        std::lock_guard guard(m_recordingLock);
+        if (!m_recordingActive.load(std::memory_order_relaxed))
+            return;
+
+        record.tick = m_updateCount - m_recordingStart;
+        m_recording.write(record);
+        m_recordedGamepads[glfw_joystick_id] = state;
+    }
+
+    void InputSystem::recordGamepadDisconnects()
+    {
+        std::lock_guard guard(m_recordingLock);
+        if (!m_recordingActive.load(std::memory_order_relaxed))
+            return;
+
+        for (auto it = m_recordedGamepads.begin(); it != m_recordedGamepads.end();)
+        {
+            if (m_presentGamepads.count(it->first))
+            {
+                ++it;
+                continue;
+            }
+
+            input_record record;
+            record.tick = m_updateCount - m_recordingStart;
+            record.type = input_record_type::gamepad_disconnected;
+            record.code = it->first;
+            m_recording.write(record);
+            it = m_recordedGamepads.erase(it);
+        }
+    }
 }
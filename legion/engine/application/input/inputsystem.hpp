@@ -1,7 +1,10 @@
 #pragma once
 #include <application/events/inputevents.hpp>
 #include <application/events/windowinputevents.hpp>
+#include <application/input/inputrecording.hpp>
+#include <application/input/inputbuffer.hpp>
 #include <numeric>
+#include <map>
 
 namespace legion::application
 {
@@ -47,11 +50,7 @@ namespace legion::application
     public:
         void setup() override
         {
-            //subscribe to the raw events emitted from the window system
-            bindToEvent<key_input, &InputSystem::onKey>();
-            bindToEvent<mouse_moved, &InputSystem::onMouseMove>();
-            bindToEvent<mouse_button, &InputSystem::onMouseButton>();
-            bindToEvent<mouse_scrolled, &InputSystem::onMouseScrolled>();
+            //raw input from the window system arrives through the InputBuffer, see pollRawInput
 
             //create Update Process
             createProcess<&InputSystem::onUpdate>("Input", 1.f/300.f);
@@ -88,6 +87,39 @@ namespace legion::application
             return m_mouseDelta;
         }
 
+        /**@brief Starts recording all raw input into a new recording, replaces the previous recording.
+         * @note Raw input is always applied at the start of an input update, so a replay applies it at the exact same moment as it was recorded.
+         *       For a replay to reproduce the session exactly the engine needs to run in deterministic mode. (--deterministic)
+         */
+        static void startRecording();
+
+        /**@brief Stops recording, the recording stays available through getRecording() and saveRecording().
+         */
+        static void stopRecording();
+
+        /**@brief Writes the last recording to a file.
+         */
+        static bool saveRecording(const std::string& path);
+
+        /**@brief Replays the last recording from the start. Live input is ignored until the replay finishes or gets stopped.
+         */
+        static void startReplay();
+
+        /**@brief Loads a recording from a file and replays it.
+         * @return bool False if the file couldn't be loaded.
+         */
+        static bool startReplay(const std::string& path);
+
+        static void stopReplay();
+
+        static bool isRecording();
+        static bool isReplaying();
+
+        static const InputRecording& getRecording()
+        {
+            return m_recording;
+        }
+
         /**
          * @brief Creates a Binding of a Key /Axis to the emission of an event in the event bus.
          *
@@ -326,6 +358,8 @@ namespace legion::application
         void onUpdate(time::time_span<fast_time> deltaTime)
         {
             OPTICK_EVENT();
+            processRecords();
+            pollRawInput();
             onJoystick(deltaTime);
 
             {
@@ -355,8 +389,25 @@ namespace legion::application
             raiseCommandQueues(deltaTime);
 
             onMouseReset();
+
+            m_updateCount++;
         }
 
+        /**@brief Applies the recorded input of this update while replaying.
+         */
+        void processRecords();
+
+        /**@brief Takes all raw input out of the InputBuffer, raises the raw input events for it and applies it to the bindings.
+         *        Mouse movement and scrolling are coalesced, they raise at most one event per update no matter the polling rate of the mouse.
+         */
+        void pollRawInput();
+
+        /**@brief Applies live input and records it if a recording is active, live input gets dropped while replaying.
+         */
+        void submitRecord(const input_record& record);
+
+        void applyRecord(const input_record& record);
+
         void matchGLFWAxisWithSignalAxis(const GLFWgamepadstate& state, inputmap::modifier_keys joystick,
             const size_type glfw, inputmap::method m)
         {
@@ -390,52 +441,79 @@ namespace legion::application
         void onJoystick(float dt)
         {
             OPTICK_EVENT();
-            for (int glfw_joystick_id : m_presentGamepads)
+            if (isReplaying())
             {
-                using mods = inputmap::modifier_keys;
-                using method = inputmap::method;
+                for (auto& [glfw_joystick_id, state] : m_recordedGamepads)
+                    applyGamepad(glfw_joystick_id, state, dt);
+                return;
+            }
 
+            const bool recording = isRecording();
+            for (int glfw_joystick_id : m_presentGamepads)
+            {
                 GLFWgamepadstate state;
                 if (!ContextHelper::getGamepadSate(glfw_joystick_id, &state)) continue;
 
-                const auto joystick = mods::JOYSTICK0 + glfw_joystick_id;
-
-                for (auto [_, action] : m_actions[method::GAMEPAD_A])
-                    action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_A], joystick, method::GAMEPAD_A, action.trigger_value, dt);
-                for (auto [_, action] : m_actions[method::GAMEPAD_B])
-                    action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_B], joystick, method::GAMEPAD_B, action.trigger_value, dt);
-                for (auto [_, action] : m_actions[method::GAMEPAD_X])
-                    action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_X], joystick, method::GAMEPAD_X, action.trigger_value, dt);
-                for (auto [_, action] : m_actions[method::GAMEPAD_Y])
-                    action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_Y], joystick, method::GAMEPAD_Y, action.trigger_value, dt);
-                for (auto [_, action] : m_actions[method::GAMEPAD_LEFT_BUMPER])
-                    action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_LEFT_BUMPER], joystick, method::GAMEPAD_LEFT_BUMPER, action.trigger_value, dt);
-                for (auto [_, action] : m_actions[method::GAMEPAD_RIGHT_BUMPER])
-                    action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_RIGHT_BUMPER], joystick, method::GAMEPAD_RIGHT_BUMPER, action.trigger_value, dt);
-                for (auto [_, action] : m_actions[method::GAMEPAD_BACK])
-                    action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_BACK], joystick, method::GAMEPAD_BACK, action.trigger_value, dt);
-                for (auto [_, action] : m_actions[method::GAMEPAD_START])
-                    action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_START], joystick, method::GAMEPAD_START, action.trigger_value, dt);
-                for (auto [_, action] : m_actions[method::GAMEPAD_DPAD_UP])
-                    action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_DPAD_UP], joystick, method::GAMEPAD_DPAD_UP, action.trigger_value, dt);
-                for (auto [_, action] : m_actions[method::GAMEPAD_DPAD_RIGHT])
-                    action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_DPAD_RIGHT], joystick, method::GAMEPAD_DPAD_RIGHT, action.trigger_value, dt);
-                for (auto [_, action] : m_actions[method::GAMEPAD_DPAD_LEFT])
-                    action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_DPAD_LEFT], joystick, method::GAMEPAD_DPAD_LEFT, action.trigger_value, dt);
-                for (auto [_, action] : m_actions[method::GAMEPAD_DPAD_DOWN])
-                    action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_DPAD_DOWN], joystick, method::GAMEPAD_DPAD_DOWN, action.trigger_value, dt);
-                for (auto [_, action] : m_actions[method::GAMEPAD_LEFT_THUMB])
-                    action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_LEFT_THUMB], joystick, method::GAMEPAD_LEFT_THUMB, action.trigger_value, dt);
-                for (auto [_, action] : m_actions[method::GAMEPAD_RIGHT_THUMB])
-                    action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_RIGHT_THUMB], joystick, method::GAMEPAD_RIGHT_THUMB, action.trigger_value, dt);
-
-                matchGLFWAxisWithSignalAxis(state, joystick, GLFW_GAMEPAD_AXIS_LEFT_X, method::GAMEPAD_LEFT_X);
-                matchGLFWAxisWithSignalAxis(state, joystick, GLFW_GAMEPAD_AXIS_LEFT_Y, method::GAMEPAD_LEFT_Y);
-                matchGLFWAxisWithSignalAxis(state, joystick, GLFW_GAMEPAD_AXIS_LEFT_TRIGGER, method::GAMEPAD_LEFT_TRIGGER);
-                matchGLFWAxisWithSignalAxis(state, joystick, GLFW_GAMEPAD_AXIS_RIGHT_X, method::GAMEPAD_RIGHT_X);
-                matchGLFWAxisWithSignalAxis(state, joystick, GLFW_GAMEPAD_AXIS_RIGHT_Y, method::GAMEPAD_RIGHT_Y);
-                matchGLFWAxisWithSignalAxis(state, joystick, GLFW_GAMEPAD_AXIS_RIGHT_TRIGGER, method::GAMEPAD_RIGHT_TRIGGER);
+                if (recording)
+                    recordGamepad(glfw_joystick_id, state);
+
+                applyGamepad(glfw_joystick_id, state, dt);
             }
+
+            if (recording)
+                recordGamepadDisconnects();
+        }
+
+        /**@brief Records the state of a gamepad if it changed since the last recorded state.
+         */
+        static void recordGamepad(int glfw_joystick_id, const GLFWgamepadstate& state);
+
+        /**@brief Records the disconnection of every gamepad that had a recorded state but isn't present anymore.
+         */
+        static void recordGamepadDisconnects();
+
+        void applyGamepad(int glfw_joystick_id, const GLFWgamepadstate& state, float dt)
+        {
+            using mods = inputmap::modifier_keys;
+            using method = inputmap::method;
+
+            const auto joystick = mods::JOYSTICK0 + glfw_joystick_id;
+
+            for (auto [_, action] : m_actions[method::GAMEPAD_A])
+                action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_A], joystick, method::GAMEPAD_A, action.trigger_value, dt);
+            for (auto [_, action] : m_actions[method::GAMEPAD_B])
+                action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_B], joystick, method::GAMEPAD_B, action.trigger_value, dt);
+            for (auto [_, action] : m_actions[method::GAMEPAD_X])
+                action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_X], joystick, method::GAMEPAD_X, action.trigger_value, dt);
+            for (auto [_, action] : m_actions[method::GAMEPAD_Y])
+                action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_Y], joystick, method::GAMEPAD_Y, action.trigger_value, dt);
+            for (auto [_, action] : m_actions[method::GAMEPAD_LEFT_BUMPER])
+                action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_LEFT_BUMPER], joystick, method::GAMEPAD_LEFT_BUMPER, action.trigger_value, dt);
+            for (auto [_, action] : m_actions[method::GAMEPAD_RIGHT_BUMPER])
+                action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_RIGHT_BUMPER], joystick, method::GAMEPAD_RIGHT_BUMPER, action.trigger_value, dt);
+            for (auto [_, action] : m_actions[method::GAMEPAD_BACK])
+                action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_BACK], joystick, method::GAMEPAD_BACK, action.trigger_value, dt);
+            for (auto [_, action] : m_actions[method::GAMEPAD_START])
+                action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_START], joystick, method::GAMEPAD_START, action.trigger_value, dt);
+            for (auto [_, action] : m_actions[method::GAMEPAD_DPAD_UP])
+                action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_DPAD_UP], joystick, method::GAMEPAD_DPAD_UP, action.trigger_value, dt);
+            for (auto [_, action] : m_actions[method::GAMEPAD_DPAD_RIGHT])
+                action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_DPAD_RIGHT], joystick, method::GAMEPAD_DPAD_RIGHT, action.trigger_value, dt);
+            for (auto [_, action] : m_actions[method::GAMEPAD_DPAD_LEFT])
+                action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_DPAD_LEFT], joystick, method::GAMEPAD_DPAD_LEFT, action.trigger_value, dt);
+            for (auto [_, action] : m_actions[method::GAMEPAD_DPAD_DOWN])
+                action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_DPAD_DOWN], joystick, method::GAMEPAD_DPAD_DOWN, action.trigger_value, dt);
+            for (auto [_, action] : m_actions[method::GAMEPAD_LEFT_THUMB])
+                action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_LEFT_THUMB], joystick, method::GAMEPAD_LEFT_THUMB, action.trigger_value, dt);
+            for (auto [_, action] : m_actions[method::GAMEPAD_RIGHT_THUMB])
+                action.callback(this, state.buttons[GLFW_GAMEPAD_BUTTON_RIGHT_THUMB], joystick, method::GAMEPAD_RIGHT_THUMB, action.trigger_value, dt);
+
+            matchGLFWAxisWithSignalAxis(state, joystick, GLFW_GAMEPAD_AXIS_LEFT_X, method::GAMEPAD_LEFT_X);
+            matchGLFWAxisWithSignalAxis(state, joystick, GLFW_GAMEPAD_AXIS_LEFT_Y, method::GAMEPAD_LEFT_Y);
+            matchGLFWAxisWithSignalAxis(state, joystick, GLFW_GAMEPAD_AXIS_LEFT_TRIGGER, method::GAMEPAD_LEFT_TRIGGER);
+            matchGLFWAxisWithSignalAxis(state, joystick, GLFW_GAMEPAD_AXIS_RIGHT_X, method::GAMEPAD_RIGHT_X);
+            matchGLFWAxisWithSignalAxis(state, joystick, GLFW_GAMEPAD_AXIS_RIGHT_Y, method::GAMEPAD_RIGHT_Y);
+            matchGLFWAxisWithSignalAxis(state, joystick, GLFW_GAMEPAD_AXIS_RIGHT_TRIGGER, method::GAMEPAD_RIGHT_TRIGGER);
         }
 
         static inputmap::modifier_keys translateModifierKeys(int glfw_mods)
@@ -455,13 +533,13 @@ namespace legion::application
             return result;
         }
 
-        void onKey(key_input* window_key_event)
+        void applyKey(int key, int keyAction, int keyMods)
         {
-            const auto m = static_cast<inputmap::method>(window_key_event->key);
+            const auto m = static_cast<inputmap::method>(key);
             for (auto [_, action] : m_actions[m])
             {
-                action.last_state = window_key_event->action != GLFW_RELEASE;
-                action.last_mods = translateModifierKeys(window_key_event->mods);
+                action.last_state = keyAction != GLFW_RELEASE;
+                action.last_mods = translateModifierKeys(keyMods);
                 action.last_method = m;
                 if (!action.repeat)
                     action.callback(this, action.last_state, action.last_mods, action.last_method, action.trigger_value, 0.0f);
@@ -469,10 +547,10 @@ namespace legion::application
             }
         }
 
-        void onMouseMove(mouse_moved* window_mouse_event)
+        void applyMouseMove(const math::dvec2& position)
         {
-            m_mouseDelta = window_mouse_event->position - m_mousePos;
-            m_mousePos = window_mouse_event->position;
+            m_mouseDelta = position - m_mousePos;
+            m_mousePos = position;
             if (math::abs(m_mouseDelta.x) < 0.0001)
                 m_mouseDelta.x = 0.0;
 
@@ -493,15 +571,15 @@ namespace legion::application
             }
         }
 
-        void onMouseButton(mouse_button* window_mouse_event)
+        void applyMouseButton(int button, int buttonAction, int buttonMods)
         {
-            switch (window_mouse_event->button)
+            switch (button)
             {
             case GLFW_MOUSE_BUTTON_LEFT: {
                 for (auto [_, action] : m_actions[inputmap::method::MOUSE_LEFT])
                 {
-                    action.last_state = window_mouse_event->action != GLFW_RELEASE;
-                    action.last_mods = translateModifierKeys(window_mouse_event->mods);
+                    action.last_state = buttonAction != GLFW_RELEASE;
+                    action.last_mods = translateModifierKeys(buttonMods);
                     action.last_method = inputmap::method::MOUSE_LEFT;
                     if (!action.repeat)
                         action.callback(this, action.last_state, action.last_mods, action.last_method, action.trigger_value, 0.0f);
@@ -511,8 +589,8 @@ namespace legion::application
             case GLFW_MOUSE_BUTTON_MIDDLE: {
                 for (auto [_, action] : m_actions[inputmap::method::MOUSE_MIDDLE])
                 {
-                    action.last_state = window_mouse_event->action != GLFW_RELEASE;
-                    action.last_mods = translateModifierKeys(window_mouse_event->mods);
+                    action.last_state = buttonAction != GLFW_RELEASE;
+                    action.last_mods = translateModifierKeys(buttonMods);
                     action.last_method = inputmap::method::MOUSE_MIDDLE;
                     if (!action.repeat)
                         action.callback(this, action.last_state, action.last_mods, action.last_method, action.trigger_value, 0.0f);
@@ -522,8 +600,8 @@ namespace legion::application
             case GLFW_MOUSE_BUTTON_RIGHT: {
                 for (auto [_, action] : m_actions[inputmap::method::MOUSE_RIGHT])
                 {
-                    action.last_state = window_mouse_event->action != GLFW_RELEASE;
-                    action.last_mods = translateModifierKeys(window_mouse_event->mods);
+                    action.last_state = buttonAction != GLFW_RELEASE;
+                    action.last_mods = translateModifierKeys(buttonMods);
                     action.last_method = inputmap::method::MOUSE_RIGHT;
                     if (!action.repeat)
                         action.callback(this, action.last_state, action.last_mods, action.last_method, action.trigger_value, 0.0f);
@@ -533,9 +611,8 @@ namespace legion::application
             }
         }
 
-        void onMouseScrolled(mouse_scrolled* window_mouse_event)
+        void applyMouseScroll(const math::dvec2& pos)
         {
-            const auto pos = window_mouse_event->offset;
             for (auto [_, axis] : m_axes[inputmap::method::HSCROLL])
             {
                 axis.last_value += static_cast<float>(pos.x);
@@ -589,5 +666,18 @@ namespace legion::application
 
         static sparse_map<id_type,axis_command_queue> m_axes_command_queues;
 
+        static async::spinlock m_recordingLock;
+        static InputRecording m_recording;
+        static std::atomic_bool m_recordingActive;
+        static std::atomic_bool m_replayActive;
+        static uint64 m_lastMoveCount; // Pointer state counters of the last poll.
+        static uint64 m_lastScrollCount;
+        static math::dvec2 m_lastScrollTotal;
+        static std::map<int, GLFWgamepadstate> m_recordedGamepads; // Last recorded or replayed state of every gamepad.
+        static input_record m_nextRecord; // Next record of the replay that hasn't been applied yet.
+        static bool m_hasNextRecord;
+        static uint64 m_updateCount;
+        static uint64 m_recordingStart; // Update at which the current recording or replay started.
+
     };
 }
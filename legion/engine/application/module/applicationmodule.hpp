@@ -23,5 +23,10 @@ namespace legion::application
             return 100;
         }
 
+        virtual bool headlessCompatible() override
+        {
+            return false;
+        }
+
     };
 }
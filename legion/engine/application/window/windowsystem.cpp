@@ -1,4 +1,5 @@
 #include <application/window/windowsystem.hpp>
+#include <application/input/inputbuffer.hpp>
 #include <rendering/debugrendering.hpp>
 
 namespace legion::application
@@ -123,7 +124,7 @@ namespace legion::application
     void WindowSystem::onKeyInput(GLFWwindow* window, int key, int scancode, int action, int mods)
     {
         if (m_windowComponents.contains(window))
-            m_eventBus->raiseEvent<key_input>(m_windowComponents[window], key, scancode, action, mods);
+            InputBuffer::pushKey(m_windowComponents[window], key, scancode, action, mods);
     }
 
     void WindowSystem::onCharInput(GLFWwindow* window, uint codepoint)
@@ -135,19 +136,19 @@ namespace legion::application
     void WindowSystem::onMouseMoved(GLFWwindow* window, double xpos, double ypos)
     {
         if (m_windowComponents.contains(window))
-            m_eventBus->raiseEvent<mouse_moved>(m_windowComponents[window], math::dvec2(xpos, ypos) / (math::dvec2)ContextHelper::getFramebufferSize(window));
+            InputBuffer::moveMouse(m_windowComponents[window], math::dvec2(xpos, ypos) / (math::dvec2)ContextHelper::getFramebufferSize(window));
     }
 
     void WindowSystem::onMouseButton(GLFWwindow* window, int button, int action, int mods)
     {
         if (m_windowComponents.contains(window))
-            m_eventBus->raiseEvent<mouse_button>(m_windowComponents[window], button, action, mods);
+            InputBuffer::pushMouseButton(m_windowComponents[window], button, action, mods);
     }
 
     void WindowSystem::onMouseScroll(GLFWwindow* window, double xoffset, double yoffset)
     {
         if (m_windowComponents.contains(window))
-            m_eventBus->raiseEvent<mouse_scrolled>(m_windowComponents[window], math::dvec2(xoffset, yoffset));
+            InputBuffer::scrollMouse(m_windowComponents[window], math::dvec2(xoffset, yoffset));
     }
 
     void WindowSystem::onExit(events::exit* event)
@@ -14,6 +14,8 @@ namespace legion::audio
         m_id = m_lastId++;
         m_refs[m_id]++;
         this->m_data = data;
+        if (data)
+            memory::MemoryTracker::track_allocation(memory::memory_tag::audio, samples * sizeof(int16));
     }
 
     audio_segment::audio_segment(const audio_segment& other) :
@@ -51,6 +53,8 @@ namespace legion::audio
                         alDeleteBuffers(1, &audioBufferId);
                         alcMakeContextCurrent(nullptr);
                     }
+                    if (m_data)
+                        memory::MemoryTracker::track_deallocation(memory::memory_tag::audio, samples * sizeof(int16));
                     delete[] m_data;
                     m_data = nullptr;
                     m_refs.erase(m_id);
@@ -86,6 +90,8 @@ namespace legion::audio
                         alDeleteBuffers(1, &audioBufferId);
                         alcMakeContextCurrent(nullptr);
                     }
+                    if (m_data)
+                        memory::MemoryTracker::track_deallocation(memory::memory_tag::audio, samples * sizeof(int16));
                     delete[] m_data;
                     m_data = nullptr;
                     m_refs.erase(m_id);
@@ -120,6 +126,8 @@ namespace legion::audio
                     alDeleteBuffers(1, &audioBufferId);
                     alcMakeContextCurrent(nullptr);
                 }
+                if (m_data)
+                    memory::MemoryTracker::track_deallocation(memory::memory_tag::audio, samples * sizeof(int16));
                 delete[] m_data;
                 m_data = nullptr;
                 m_refs.erase(m_id);
@@ -24,5 +24,10 @@ namespace legion::audio
         {
             return 50;
         }
+
+        virtual bool headlessCompatible() override
+        {
+            return false;
+        }
     };
 }
@@ -5,7 +5,7 @@
 #include <unordered_map>
 #include <core/async/transferable_atomic.hpp>
 
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
 
 /**
  * @file ring_sync_lock.hpp
@@ -1,5 +1,5 @@
 #include <core/async/rw_spinlock.hpp>
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
 #include <sstream>
 
 namespace legion::core::async
@@ -1,5 +1,5 @@
 #include <core/async/spinlock.hpp>
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
 
 namespace legion::core::async
 {
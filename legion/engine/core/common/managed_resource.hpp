@@ -3,7 +3,7 @@
 #include <core/async/rw_spinlock.hpp>
 #include <unordered_map>
 
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
 
 namespace legion::core::common
 {
@@ -8,7 +8,7 @@
 #include <core/types/primitives.hpp>
 #include <cstring>
 
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
 
 /**
  * @file string_extra.hpp
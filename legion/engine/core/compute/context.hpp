@@ -5,7 +5,7 @@
 #include <utility>
 #include <core/data/image.hpp>
 
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
 
 /**
  * @file context.hpp
@@ -13,7 +13,7 @@
 #include <core/detail/internals.hpp>
 #include <core/filesystem/resource.hpp>
 
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
 
 namespace legion::core::compute {
 
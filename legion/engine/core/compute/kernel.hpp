@@ -6,7 +6,7 @@
 #include <variant>
 #include <map>
 
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
 
 namespace legion::core::compute
 {
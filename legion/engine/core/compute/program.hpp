@@ -7,7 +7,7 @@
 #include <functional>
 #include <string>
 
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
 
 /**
  * @file program.hpp
@@ -12,6 +12,9 @@
 #include <core/types/types.hpp>
 #include <core/time/time.hpp>
 #include <core/async/async.hpp>
+#include <core/memory/memory.hpp>
+#include <core/profiling/profiler.hpp>
+#include <core/profiling/statistics.hpp>
 #include <core/containers/containers.hpp>
 #include <core/ecs/ecs.hpp>
 #include <core/scheduling/scheduling.hpp>
@@ -0,0 +1,420 @@
+#include <core/data/animation.hpp>
+#include <core/types/type_util.hpp>
+#include <core/logging/logging.hpp>
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEGION_ANIMATION_SSE
+#include <emmintrin.h>
+#endif
+
+namespace legion::core
+{
+    async::rw_spinlock AnimationCache::m_clipsLock;
+    std::unordered_map<id_type, std::shared_ptr<const animation_clip>> AnimationCache::m_clips;
+
+    namespace
+    {
+        // Offsets of the channels within a block, each channel holds one float for each of the 4 joints.
+        enum block_offset : size_type
+        {
+            tx = 0, ty = 4, tz = 8,
+            rx = 12, ry = 16, rz = 20, rw = 24,
+            sx = 28, sy = 32, sz = 36
+        };
+
+#if defined(LEGION_ANIMATION_SSE)
+        struct float4
+        {
+            __m128 v;
+        };
+
+        inline float4 load(const float* ptr) { return { _mm_loadu_ps(ptr) }; }
+        inline void store(float* ptr, float4 value) { _mm_storeu_ps(ptr, value.v); }
+        inline float4 splat(float value) { return { _mm_set1_ps(value) }; }
+        inline float4 operator+(float4 a, float4 b) { return { _mm_add_ps(a.v, b.v) }; }
+        inline float4 operator-(float4 a, float4 b) { return { _mm_sub_ps(a.v, b.v) }; }
+        inline float4 operator*(float4 a, float4 b) { return { _mm_mul_ps(a.v, b.v) }; }
+        inline float4 max(float4 a, float4 b) { return { _mm_max_ps(a.v, b.v) }; }
+        inline float4 inverse_sqrt(float4 a) { return { _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(a.v)) }; }
+
+        // Negates the lanes of value for which condition is negative.
+        inline float4 negate_if_negative(float4 value, float4 condition)
+        {
+            const __m128 mask = _mm_and_ps(_mm_cmplt_ps(condition.v, _mm_setzero_ps()), _mm_set1_ps(-0.f));
+            return { _mm_xor_ps(value.v, mask) };
+        }
+#else
+        struct float4
+        {
+            float v[4];
+        };
+
+        inline float4 load(const float* ptr) { return { { ptr[0], ptr[1], ptr[2], ptr[3] } }; }
+        inline void store(float* ptr, float4 value) { std::copy(value.v, value.v + 4, ptr); }
+        inline float4 splat(float value) { return { { value, value, value, value } }; }
+        inline float4 operator+(float4 a, float4 b) { return { { a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3] } }; }
+        inline float4 operator-(float4 a, float4 b) { return { { a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3] } }; }
+        inline float4 operator*(float4 a, float4 b) { return { { a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3] } }; }
+        inline float4 max(float4 a, float4 b) { return { { std::max(a.v[0], b.v[0]), std::max(a.v[1], b.v[1]), std::max(a.v[2], b.v[2]), std::max(a.v[3], b.v[3]) } }; }
+        inline float4 inverse_sqrt(float4 a) { return { { 1.f / std::sqrt(a.v[0]), 1.f / std::sqrt(a.v[1]), 1.f / std::sqrt(a.v[2]), 1.f / std::sqrt(a.v[3]) } }; }
+
+        inline float4 negate_if_negative(float4 value, float4 condition)
+        {
+            for (size_type i = 0; i < 4; i++)
+                if (condition.v[i] < 0.f)
+                    value.v[i] = -value.v[i];
+            return value;
+        }
+#endif
+
+        inline float4 lerp(float4 a, float4 b, float4 alpha) { return a + (b - a) * alpha; }
+
+        inline math::quat to_quat(const math::vec4& value) { return math::quat(value.w, value.x, value.y, value.z); }
+
+        math::vec4 evaluate(const animation_track& track, float time)
+        {
+            if (track.times.empty())
+                return math::vec4(0.f);
+
+            auto next = std::upper_bound(track.times.begin(), track.times.end(), time);
+            if (next == track.times.begin())
+                return track.values.front();
+            if (next == track.times.end())
+                return track.values.back();
+
+            const size_type index = static_cast<size_type>(next - track.times.begin());
+            const float start = track.times[index - 1];
+            const float alpha = (time - start) / (*next - start);
+
+            if (track.path == animation_path::rotation)
+            {
+                const math::quat result = math::slerp(to_quat(track.values[index - 1]), to_quat(track.values[index]), alpha);
+                return math::vec4(result.x, result.y, result.z, result.w);
+            }
+
+            return math::mix(track.values[index - 1], track.values[index], alpha);
+        }
+
+        void write_joint(float* block, size_type lane, const joint_pose& pose)
+        {
+            block[tx + lane] = pose.translation.x;
+            block[ty + lane] = pose.translation.y;
+            block[tz + lane] = pose.translation.z;
+            block[rx + lane] = pose.rotation.x;
+            block[ry + lane] = pose.rotation.y;
+            block[rz + lane] = pose.rotation.z;
+            block[rw + lane] = pose.rotation.w;
+            block[sx + lane] = pose.scale.x;
+            block[sy + lane] = pose.scale.y;
+            block[sz + lane] = pose.scale.z;
+        }
+    }
+
+    void animation_track::reduce(float tolerance)
+    {
+        if (times.size() < 3)
+            return;
+
+        std::vector<float> keptTimes{ times.front() };
+        std::vector<math::vec4> keptValues{ values.front() };
+        size_type lastKept = 0;
+
+        for (size_type i = 1; i + 1 < times.size(); i++)
+        {
+            // Key i can only be dropped if every key since the last kept one lies on the line towards the key after it.
+            const float span = times[i + 1] - times[lastKept];
+            bool redundant = span > 0.f;
+            for (size_type j = lastKept + 1; redundant && j <= i; j++)
+            {
+                const math::vec4 predicted = math::mix(values[lastKept], values[i + 1], (times[j] - times[lastKept]) / span);
+                redundant = math::length(predicted - values[j]) <= tolerance;
+            }
+
+            if (redundant)
+                continue;
+
+            keptTimes.push_back(times[i]);
+            keptValues.push_back(values[i]);
+            lastKept = i;
+        }
+
+        keptTimes.push_back(times.back());
+        keptValues.push_back(values.back());
+
+        times = std::move(keptTimes);
+        values = std::move(keptValues);
+    }
+
+    void animation_clip::bake(const skeleton& skeleton, float rate)
+    {
+        OPTICK_EVENT();
+        sampleRate = rate > 0.f ? rate : 30.f;
+        blockCount = static_cast<uint32>(skeleton.block_count());
+        frameCount = static_cast<uint32>(math::ceil(duration * sampleRate)) + 1u;
+
+        const size_type frameSize = static_cast<size_type>(blockCount) * floats_per_block;
+
+        std::vector<float> rest;
+        animation::rest_pose(skeleton, rest);
+
+        frames.resize(frameCount * frameSize);
+        for (uint32 i = 0; i < frameCount; i++)
+            std::copy(rest.begin(), rest.end(), frames.begin() + i * frameSize);
+
+        const size_type jointCount = skeleton.joint_count();
+        for (auto& track : tracks)
+        {
+            if (track.joint >= jointCount || track.times.empty())
+                continue;
+
+            const size_type lane = track.joint % joints_per_block;
+            const size_type blockOffset = (track.joint / joints_per_block) * floats_per_block;
+
+            for (uint32 i = 0; i < frameCount; i++)
+            {
+                float* block = frames.data() + i * frameSize + blockOffset;
+                const math::vec4 value = evaluate(track, math::min(i / sampleRate, duration));
+
+                switch (track.path)
+                {
+                case animation_path::translation:
+                    block[tx + lane] = value.x;
+                    block[ty + lane] = value.y;
+                    block[tz + lane] = value.z;
+                    break;
+                case animation_path::rotation:
+                    block[rx + lane] = value.x;
+                    block[ry + lane] = value.y;
+                    block[rz + lane] = value.z;
+                    block[rw + lane] = value.w;
+                    break;
+                case animation_path::scale:
+                    block[sx + lane] = value.x;
+                    block[sy + lane] = value.y;
+                    block[sz + lane] = value.z;
+                    break;
+                }
+            }
+        }
+    }
+
+    size_type animation_clip::memory_footprint() const noexcept
+    {
+        size_type footprint = sizeof(animation_clip) + frames.capacity() * sizeof(float) + tracks.capacity() * sizeof(animation_track);
+        for (auto& track : tracks)
+            footprint += track.times.capacity() * sizeof(float) + track.values.capacity() * sizeof(math::vec4);
+        return footprint;
+    }
+
+    std::shared_ptr<const animation_clip> animation_handle::get() const
+    {
+        async::readonly_guard guard(AnimationCache::m_clipsLock);
+        auto it = AnimationCache::m_clips.find(id);
+        if (it == AnimationCache::m_clips.end())
+            return nullptr;
+        return it->second;
+    }
+
+    animation_handle AnimationCache::insert_clip(const std::string& name, animation_clip&& clip)
+    {
+        const id_type id = nameHash(name);
+        auto ptr = std::make_shared<const animation_clip>(std::move(clip));
+
+        async::readwrite_guard guard(m_clipsLock);
+        m_clips[id] = std::move(ptr);
+        return { id };
+    }
+
+    animation_handle AnimationCache::get_handle(const std::string& name)
+    {
+        return get_handle(nameHash(name));
+    }
+
+    animation_handle AnimationCache::get_handle(id_type id)
+    {
+        async::readonly_guard guard(m_clipsLock);
+        if (m_clips.count(id))
+            return { id };
+        return invalid_animation_handle;
+    }
+
+    void AnimationCache::destroy_clip(id_type id)
+    {
+        async::readwrite_guard guard(m_clipsLock);
+        if (m_clips.erase(id))
+            log::debug("Destroyed animation clip {}", id);
+    }
+
+    size_type AnimationCache::memory_footprint()
+    {
+        size_type footprint = 0;
+
+        async::readonly_guard guard(m_clipsLock);
+        for (auto& [id, clip] : m_clips)
+            footprint += clip->memory_footprint();
+
+        return footprint;
+    }
+
+    namespace animation
+    {
+        void rest_pose(const skeleton& skeleton, std::vector<float>& pose)
+        {
+            const size_type jointCount = skeleton.joint_count();
+            pose.resize(skeleton.block_count() * floats_per_block);
+
+            // Lanes past the last joint get an identity transform.
+            const joint_pose identity{};
+            for (size_type i = 0; i < skeleton.block_count() * joints_per_block; i++)
+            {
+                const joint_pose& joint = i < jointCount && i < skeleton.restPose.size() ? skeleton.restPose[i] : identity;
+                write_joint(pose.data() + (i / joints_per_block) * floats_per_block, i % joints_per_block, joint);
+            }
+        }
+
+        void sample(const skeleton& skeleton, const layer* layers, size_type layerCount, std::vector<float>& pose)
+        {
+            const size_type blockCount = skeleton.block_count();
+
+            auto usable = [&](const layer& l)
+            {
+                return l.clip && l.weight > 0.f && l.clip->frameCount && l.clip->blockCount == blockCount;
+            };
+
+            float totalWeight = 0.f;
+            for (size_type i = 0; i < layerCount; i++)
+                if (usable(layers[i]))
+                    totalWeight += layers[i].weight;
+
+            if (totalWeight <= 0.f)
+            {
+                rest_pose(skeleton, pose);
+                return;
+            }
+
+            pose.assign(blockCount * floats_per_block, 0.f);
+
+            for (size_type i = 0; i < layerCount; i++)
+            {
+                const layer& current = layers[i];
+                if (!usable(current))
+                    continue;
+
+                const animation_clip& clip = *current.clip;
+                const float frameTime = math::clamp(current.time, 0.f, clip.duration) * clip.sampleRate;
+                const uint32 first = std::min(static_cast<uint32>(frameTime), clip.frameCount - 1);
+                const uint32 second = std::min(first + 1, clip.frameCount - 1);
+
+                const float4 alpha = splat(math::clamp(frameTime - first, 0.f, 1.f));
+                const float4 weight = splat(current.weight / totalWeight);
+
+                const float* frameA = clip.frame(first);
+                const float* frameB = clip.frame(second);
+
+                for (size_type block = 0; block < blockCount; block++)
+                {
+                    float* out = pose.data() + block * floats_per_block;
+                    const float* a = frameA + block * floats_per_block;
+                    const float* b = frameB + block * floats_per_block;
+
+                    for (size_type offset : { tx, ty, tz, sx, sy, sz })
+                        store(out + offset, load(out + offset) + lerp(load(a + offset), load(b + offset), alpha) * weight);
+
+                    // Nlerp along the shortest arc, normalized once all layers have been accumulated.
+                    float4 ax = load(a + rx), ay = load(a + ry), az = load(a + rz), aw = load(a + rw);
+                    float4 bx = load(b + rx), by = load(b + ry), bz = load(b + rz), bw = load(b + rw);
+
+                    const float4 dot = ax * bx + ay * by + az * bz + aw * bw;
+                    bx = negate_if_negative(bx, dot);
+                    by = negate_if_negative(by, dot);
+                    bz = negate_if_negative(bz, dot);
+                    bw = negate_if_negative(bw, dot);
+
+                    float4 qx = lerp(ax, bx, alpha), qy = lerp(ay, by, alpha), qz = lerp(az, bz, alpha), qw = lerp(aw, bw, alpha);
+
+                    // Keep the layers on the same hemisphere as what was accumulated so far.
+                    const float4 px = load(out + rx), py = load(out + ry), pz = load(out + rz), pw = load(out + rw);
+                    const float4 hemisphere = px * qx + py * qy + pz * qz + pw * qw;
+                    qx = negate_if_negative(qx, hemisphere);
+                    qy = negate_if_negative(qy, hemisphere);
+                    qz = negate_if_negative(qz, hemisphere);
+                    qw = negate_if_negative(qw, hemisphere);
+
+                    store(out + rx, px + qx * weight);
+                    store(out + ry, py + qy * weight);
+                    store(out + rz, pz + qz * weight);
+                    store(out + rw, pw + qw * weight);
+                }
+            }
+
+            const float4 epsilon = splat(1e-12f);
+            for (size_type block = 0; block < blockCount; block++)
+            {
+                float* out = pose.data() + block * floats_per_block;
+                const float4 x = load(out + rx), y = load(out + ry), z = load(out + rz), w = load(out + rw);
+                const float4 inverseLength = inverse_sqrt(max(x * x + y * y + z * z + w * w, epsilon));
+                store(out + rx, x * inverseLength);
+                store(out + ry, y * inverseLength);
+                store(out + rz, z * inverseLength);
+                store(out + rw, w * inverseLength);
+            }
+        }
+
+        void compute_palette(const skeleton& skeleton, const std::vector<float>& pose, std::vector<math::mat4>& modelSpace, std::vector<math::mat4>& palette)
+        {
+            const size_type jointCount = skeleton.joint_count();
+            modelSpace.resize(jointCount);
+            palette.resize(jointCount);
+
+            if (pose.size() < skeleton.block_count() * floats_per_block)
+                return;
+
+            const float4 one = splat(1.f);
+            const float4 two = splat(2.f);
+
+            // Rotation and scale columns of 4 local transforms at once: x axis, y axis and z axis.
+            float columns[9][joints_per_block];
+
+            for (size_type block = 0; block < skeleton.block_count(); block++)
+            {
+                const float* in = pose.data() + block * floats_per_block;
+                const float4 x = load(in + rx), y = load(in + ry), z = load(in + rz), w = load(in + rw);
+                const float4 scaleX = load(in + sx), scaleY = load(in + sy), scaleZ = load(in + sz);
+
+                const float4 xx = x * x, yy = y * y, zz = z * z;
+                const float4 xy = x * y, xz = x * z, yz = y * z;
+                const float4 wx = w * x, wy = w * y, wz = w * z;
+
+                store(columns[0], (one - two * (yy + zz)) * scaleX);
+                store(columns[1], two * (xy + wz) * scaleX);
+                store(columns[2], two * (xz - wy) * scaleX);
+                store(columns[3], two * (xy - wz) * scaleY);
+                store(columns[4], (one - two * (xx + zz)) * scaleY);
+                store(columns[5], two * (yz + wx) * scaleY);
+                store(columns[6], two * (xz + wy) * scaleZ);
+                store(columns[7], two * (yz - wx) * scaleZ);
+                store(columns[8], (one - two * (xx + yy)) * scaleZ);
+
+                // Parents come before their children, so the parent's model space transform is always known by now.
+                for (size_type lane = 0; lane < joints_per_block; lane++)
+                {
+                    const size_type joint = block * joints_per_block + lane;
+                    if (joint >= jointCount)
+                        break;
+
+                    const math::mat4 local(
+                        columns[0][lane], columns[1][lane], columns[2][lane], 0.f,
+                        columns[3][lane], columns[4][lane], columns[5][lane], 0.f,
+                        columns[6][lane], columns[7][lane], columns[8][lane], 0.f,
+                        in[tx + lane], in[ty + lane], in[tz + lane], 1.f);
+
+                    const int32 parent = skeleton.parents[joint];
+                    modelSpace[joint] = parent < 0 ? local : modelSpace[parent] * local;
+                    palette[joint] = joint < skeleton.inverseBindMatrices.size() ? modelSpace[joint] * skeleton.inverseBindMatrices[joint] : modelSpace[joint];
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,179 @@
+#pragma once
+#include <core/platform/platform.hpp>
+#include <core/types/primitives.hpp>
+#include <core/math/math.hpp>
+#include <core/async/rw_spinlock.hpp>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file animation.hpp
+ * @brief Skeletons and keyframe animation clips imported with skinned meshes, and the batch pose evaluation turning them into joint palettes.
+ *        Clips keep the sparse keyframe tracks they were imported with and get baked to a fixed sample rate,
+ *        baked frames store the joints in blocks of 4 as a structure of arrays so that sampling and blending
+ *        interpolate 4 joints at once with SIMD quaternion and vector math.
+ */
+
+namespace legion::core
+{
+    /**@brief Amount of joints that get evaluated together, the width of a SIMD register of floats.
+     */
+    constexpr size_type joints_per_block = 4;
+
+    /**@brief Floats in a single block of a baked frame or pose: translation xyz, rotation xyzw and scale xyz of 4 joints.
+     */
+    constexpr size_type floats_per_block = 10 * joints_per_block;
+
+    /**@class joint_pose
+     * @brief Local transform of a joint relative to it's parent.
+     */
+    struct joint_pose
+    {
+        math::vec3 translation{ 0.f, 0.f, 0.f };
+        math::quat rotation{ 1.f, 0.f, 0.f, 0.f };
+        math::vec3 scale{ 1.f, 1.f, 1.f };
+    };
+
+    /**@class skeleton
+     * @brief Joint hierarchy of a skinned mesh.
+     * @note Joints are sorted so that every parent comes before it's children, the skinning joint indices of the mesh match this order.
+     */
+    struct skeleton
+    {
+        std::vector<std::string> jointNames;
+        std::vector<int32> parents; // -1 for root joints.
+        std::vector<math::mat4> inverseBindMatrices;
+        std::vector<joint_pose> restPose;
+
+        L_NODISCARD size_type joint_count() const noexcept { return parents.size(); }
+        L_NODISCARD size_type block_count() const noexcept { return (parents.size() + joints_per_block - 1) / joints_per_block; }
+        L_NODISCARD bool empty() const noexcept { return parents.empty(); }
+    };
+
+    enum struct animation_path : uint8
+    {
+        translation,
+        rotation,
+        scale
+    };
+
+    /**@class animation_track
+     * @brief Keyframes of a single channel of a single joint as imported, keys that the neighbouring keys already interpolate to are removed.
+     */
+    struct animation_track
+    {
+        uint32 joint = 0;
+        animation_path path = animation_path::translation;
+        std::vector<float> times;
+        std::vector<math::vec4> values; // Rotations are stored as x, y, z, w.
+
+        /**@brief Removes keys that linear interpolation of their neighbours reproduces within a tolerance.
+         */
+        void reduce(float tolerance);
+    };
+
+    /**@class animation_clip
+     * @brief Animation of a skeleton, both as sparse tracks and baked to a fixed sample rate.
+     */
+    struct animation_clip
+    {
+        std::string name;
+        float duration = 0.f;
+        float sampleRate = 30.f;
+        uint32 frameCount = 0;
+        uint32 blockCount = 0;
+
+        std::vector<animation_track> tracks;
+        std::vector<float> frames; // frameCount frames of blockCount blocks, see floats_per_block.
+
+        /**@brief Samples the tracks at a fixed rate into the frames, channels without a track keep the rest pose of the skeleton.
+         */
+        void bake(const skeleton& skeleton, float rate = 30.f);
+
+        L_NODISCARD const float* frame(uint32 index) const noexcept { return frames.data() + static_cast<size_type>(index) * blockCount * floats_per_block; }
+
+        L_NODISCARD size_type memory_footprint() const noexcept;
+    };
+
+    /**@class animation_handle
+     * @brief Save to pass around handle to an animation clip in the animation cache.
+     */
+    struct animation_handle
+    {
+        id_type id = invalid_id;
+
+        /**@brief Get the clip, stays valid while held even if the clip gets replaced or destroyed in the meantime.
+         */
+        L_NODISCARD std::shared_ptr<const animation_clip> get() const;
+
+        bool operator==(const animation_handle& other) const { return id == other.id; }
+        operator bool() const { return id != invalid_id; }
+    };
+
+    /**@brief Default invalid animation handle.
+     */
+    constexpr animation_handle invalid_animation_handle{ invalid_id };
+
+    /**@class AnimationCache
+     * @brief Data cache for animation clips, clips imported with a mesh are named "<mesh name>/<clip name>".
+     */
+    class AnimationCache
+    {
+        friend struct animation_handle;
+    private:
+        static async::rw_spinlock m_clipsLock;
+        static std::unordered_map<id_type, std::shared_ptr<const animation_clip>> m_clips;
+
+    public:
+        /**@brief Inserts a clip under a name, replacing any clip with the same name.
+         */
+        static animation_handle insert_clip(const std::string& name, animation_clip&& clip);
+
+        /**@brief Returns a handle to a clip with a certain name. Will return invalid_animation_handle if the requested clip doesn't exist.
+         */
+        L_NODISCARD static animation_handle get_handle(const std::string& name);
+
+        /**@brief Returns a handle to a clip with a certain name. Will return invalid_animation_handle if the requested clip doesn't exist.
+         * @param id Name hash
+         */
+        L_NODISCARD static animation_handle get_handle(id_type id);
+
+        static void destroy_clip(id_type id);
+
+        /**@brief Get the amount of bytes used by all clips in the cache.
+         */
+        L_NODISCARD static size_type memory_footprint();
+    };
+
+    namespace animation
+    {
+        /**@class layer
+         * @brief Clip to sample at a certain time with a certain blend weight.
+         */
+        struct layer
+        {
+            const animation_clip* clip = nullptr;
+            float time = 0.f;
+            float weight = 1.f;
+        };
+
+        /**@brief Samples and blends layers into a local pose of blocks, see floats_per_block.
+         *        Weights get normalized, layers without weight leave the rest pose.
+         * @param pose Output, resized to the block count of the skeleton.
+         */
+        void sample(const skeleton& skeleton, const layer* layers, size_type layerCount, std::vector<float>& pose);
+
+        /**@brief Converts a local pose into the skinning matrices of all joints, model space transform times inverse bind matrix.
+         * @param modelSpace Scratch buffer receiving the model space transforms of the joints.
+         * @param palette Output, resized to the joint count of the skeleton.
+         */
+        void compute_palette(const skeleton& skeleton, const std::vector<float>& pose, std::vector<math::mat4>& modelSpace, std::vector<math::mat4>& palette);
+
+        /**@brief Writes the rest pose of a skeleton as a local pose of blocks.
+         */
+        void rest_pose(const skeleton& skeleton, std::vector<float>& pose);
+    }
+}
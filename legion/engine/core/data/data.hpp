@@ -1,2 +1,3 @@
 #pragma once
 #include<core/data/mesh.hpp>
+#include<core/data/animation.hpp>
@@ -1,17 +1,20 @@
 #include <core/data/image.hpp>
 #include <core/filesystem/assetimporter.hpp>
+#include <core/filesystem/hot_reload.hpp>
+
+#include <unordered_set>
 
 namespace legion::core
 {
     std::unordered_map<id_type, uint> image::m_refs;
     std::mutex image::m_refsLock;
 
-    const std::vector<math::color> ImageCache::m_nullColors;
+    const std::shared_ptr<const std::vector<math::color>> ImageCache::m_nullColors = std::make_shared<const std::vector<math::color>>();
     async::rw_spinlock ImageCache::m_nullLock;
 
     std::unordered_map<id_type, std::unique_ptr<std::pair<async::rw_spinlock, image>>> ImageCache::m_images;
     async::rw_spinlock ImageCache::m_imagesLock;
-    std::unordered_map<id_type, std::unique_ptr<std::vector<math::color>>> ImageCache::m_colors;
+    std::unordered_map<id_type, std::shared_ptr<const std::vector<math::color>>> ImageCache::m_colors;
     async::rw_spinlock ImageCache::m_colorsLock;
 
     void image::apply_raw(bool lazyApply)
@@ -25,7 +28,7 @@ namespace legion::core
             ImageCache::process_raw(m_id);
     }
 
-    const std::vector<math::color>& image::read_colors()
+    std::shared_ptr<const std::vector<math::color>> image::read_colors()
     {
         OPTICK_EVENT();
         return ImageCache::read_colors(m_id);
@@ -45,7 +48,7 @@ namespace legion::core
         return image.size;
     }
 
-    const std::vector<math::color>& image_handle::read_colors()
+    std::shared_ptr<const std::vector<math::color>> image_handle::read_colors()
     {
         OPTICK_EVENT();
         return ImageCache::read_colors(id);
@@ -63,7 +66,7 @@ namespace legion::core
         ImageCache::destroy_image(id);
     }
 
-    const std::vector<math::color>& ImageCache::process_raw(id_type id)
+    std::shared_ptr<const std::vector<math::color>> ImageCache::process_raw(id_type id)
     {
         OPTICK_EVENT();
         {
@@ -74,7 +77,7 @@ namespace legion::core
 
         auto [lock, image] = get_raw_image(id);
 
-        std::vector<math::color>* ptr = new std::vector<math::color>();
+        auto ptr = std::make_shared<std::vector<math::color>>();
         auto& output = *ptr;
 
         {
@@ -257,19 +260,20 @@ namespace legion::core
 
         {
             async::readwrite_guard guard(m_colorsLock);
-            m_colors.emplace(std::make_pair(id, std::unique_ptr<std::vector<math::color>>(ptr)));
+            m_colors.emplace(id, ptr);
         }
 
-        return output;
+        return ptr;
     }
 
-    const std::vector<math::color>& ImageCache::read_colors(id_type id)
+    std::shared_ptr<const std::vector<math::color>> ImageCache::read_colors(id_type id)
     {
         OPTICK_EVENT();
         async::readonly_guard guard(m_colorsLock);
-        if (!m_colors.count(id))
+        auto itr = m_colors.find(id);
+        if (itr == m_colors.end())
             return process_raw(id);
-        return *m_colors[id];
+        return itr->second;
     }
 
     std::pair<async::rw_spinlock&, image&> ImageCache::get_raw_image(id_type id)
@@ -299,18 +303,116 @@ namespace legion::core
         if (result != common::valid)
             return invalid_image_handle;
 
+        return store_image(name, id, result.decay(), file, settings);
+    }
+
+    std::vector<image_handle> ImageCache::create_images(const std::vector<filesystem::view>& files, image_import_settings settings)
+    {
+        OPTICK_EVENT();
+        std::vector<id_type> ids(files.size(), invalid_id);
+
+        std::vector<filesystem::view> toLoad;
+        std::vector<std::string> names;
+        std::unordered_set<id_type> queued;
+
+        for (size_type i = 0; i < files.size(); i++)
+        {
+            auto& file = files[i];
+            if (!file.is_valid() || !file.file_info().is_file)
+                continue;
+
+            std::string name = file.get_filename();
+            ids[i] = nameHash(name);
+
+            // Images that already exist or are already part of this batch don't need to be loaded again.
+            if (get_handle(ids[i]).id != invalid_id || !queued.insert(ids[i]).second)
+                continue;
+
+            toLoad.push_back(file);
+            names.push_back(std::move(name));
+        }
+
+        auto results = filesystem::AssetImporter::tryLoadBatch<image>(toLoad, settings);
+
+        for (size_type i = 0; i < results.size(); i++)
+        {
+            if (results[i] == common::valid)
+                store_image(names[i], nameHash(names[i]), results[i].decay(), toLoad[i], settings);
+        }
+
+        std::vector<image_handle> handles(files.size(), invalid_image_handle);
+        for (size_type i = 0; i < files.size(); i++)
+        {
+            if (ids[i] != invalid_id)
+                handles[i] = get_handle(ids[i]);
+        }
+        return handles;
+    }
+
+    image_handle ImageCache::store_image(const std::string& name, id_type id, image&& img, const filesystem::view& file, image_import_settings settings)
+    {
         {
             async::readwrite_guard guard(m_imagesLock);
             auto* pair_ptr = new std::pair<async::rw_spinlock, image>();
-            pair_ptr->second = result.decay();
+            pair_ptr->second = img;
             pair_ptr->second.name = name;
             pair_ptr->second.m_id = id;
             m_images.emplace(std::make_pair(id, std::unique_ptr<std::pair<async::rw_spinlock, image>>(pair_ptr)));
         }
 
+        if (filesystem::hot_reload::enabled())
+        {
+            const std::string node = filesystem::hot_reload::entry_node("image", id);
+            filesystem::hot_reload::add_dependency(node, file.get_virtual_path());
+            filesystem::hot_reload::on_reload(node, [id, file, settings]() { reload_image(id, file, settings); });
+        }
+
         return { id };
     }
 
+    void ImageCache::reload_image(id_type id, const filesystem::view& file, image_import_settings settings)
+    {
+        OPTICK_EVENT();
+        auto result = filesystem::AssetImporter::tryLoad<image>(file, settings);
+
+        if (result != common::valid)
+        {
+            log::error("Failed to reload image {}, the previous version stays in use.", file.get_virtual_path());
+            return;
+        }
+
+        auto replacement = std::make_shared<image>(result.decay());
+
+        filesystem::hot_reload::commit([id, replacement]()
+            {
+                {
+                    async::readonly_guard guard(m_imagesLock);
+                    auto it = m_images.find(id);
+                    if (it == m_images.end())
+                        return;
+
+                    async::readwrite_guard entryGuard(it->second->first);
+                    image& target = it->second->second;
+                    byte* previous = target.data;
+
+                    target.size = replacement->size;
+                    target.format = replacement->format;
+                    target.components = replacement->components;
+                    target.dataSize = replacement->dataSize;
+                    target.data = replacement->data;
+                    replacement->data = nullptr;
+
+                    // Copies of the image keep referring to the old pixels and free them once the last copy is gone.
+                    std::lock_guard refsGuard(image::m_refsLock);
+                    if (!image::m_refs.count(id))
+                        delete[] previous;
+                }
+
+                async::readwrite_guard guard(m_colorsLock);
+                m_colors.erase(id);
+            });
+    }
+
     image_handle ImageCache::create_image(const filesystem::view& file, image_import_settings settings)
     {
         return create_image(file.get_filename(), file, settings);
@@ -364,6 +466,8 @@ namespace legion::core
             if (m_colors.count(id))
                 m_colors.erase(id);
         }
+
+        filesystem::hot_reload::remove(filesystem::hot_reload::entry_node("image", id));
     }
 
     void ImageCache::destroy_image(id_type id)
@@ -382,6 +486,49 @@ namespace legion::core
             if (m_colors.count(id))
                 m_colors.erase(id);
         }
+
+        filesystem::hot_reload::remove(filesystem::hot_reload::entry_node("image", id));
+    }
+
+    size_type ImageCache::memory_footprint()
+    {
+        OPTICK_EVENT();
+        size_type footprint = 0;
+
+        {
+            async::readonly_guard guard(m_imagesLock);
+            for (auto& [id, pair] : m_images)
+                footprint += sizeof(std::pair<async::rw_spinlock, image>) + pair->second.dataSize;
+        }
+
+        {
+            async::readonly_guard guard(m_colorsLock);
+            for (auto& [id, colors] : m_colors)
+                footprint += sizeof(std::vector<math::color>) + colors->capacity() * sizeof(math::color);
+        }
+
+        return footprint;
     }
 
+    size_type ImageCache::evict_colors(size_type bytes)
+    {
+        OPTICK_EVENT();
+        size_type freed = 0;
+
+        async::readwrite_guard guard(m_colorsLock);
+        for (auto it = m_colors.begin(); it != m_colors.end() && freed < bytes;)
+        {
+            // Colors that are still held somewhere wouldn't actually be freed, so keep them cached.
+            if (it->second.use_count() > 1)
+            {
+                ++it;
+                continue;
+            }
+
+            freed += sizeof(std::vector<math::color>) + it->second->capacity() * sizeof(math::color);
+            it = m_colors.erase(it);
+        }
+
+        return freed;
+    }
 }
@@ -62,9 +62,9 @@ namespace legion::core
         void apply_raw(bool lazyApply = true);
 
         /**@brief Convert the binary image representation to a more usable representation if it hasn't been converted before and return the new representation.
-         * @return const std::vector<math::color>& List with all the colors in the image.
+         * @return std::shared_ptr<const std::vector<math::color>> List with all the colors in the image, stays valid even if the cache evicts or reprocesses the colors.
          */
-        const std::vector<math::color>& read_colors();
+        std::shared_ptr<const std::vector<math::color>> read_colors();
 
         /**@brief Get the data size of the binary data.
          */
@@ -233,9 +233,9 @@ namespace legion::core
         math::ivec2 size();
 
         /**@brief Convert the binary image representation to a more usable representation if it hasn't been converted before and return the new representation.
-         * @return const std::vector<math::color>& List with all the colors in the image.
+         * @return std::shared_ptr<const std::vector<math::color>> List with all the colors in the image, stays valid even if the cache evicts or reprocesses the colors.
          */
-        const std::vector<math::color>& read_colors();
+        std::shared_ptr<const std::vector<math::color>> read_colors();
 
         /**@brief Get the image and the attached lock. Will return invalid_image if the handle was invalid.
          */
@@ -274,19 +274,27 @@ namespace legion::core
         friend struct image;
         friend struct image_handle;
     private:
-        static const std::vector<math::color> m_nullColors;
+        static const std::shared_ptr<const std::vector<math::color>> m_nullColors;
         static async::rw_spinlock m_nullLock;
 
         static std::unordered_map<id_type, std::unique_ptr<std::pair<async::rw_spinlock, image>>> m_images;
         static async::rw_spinlock m_imagesLock;
-        static std::unordered_map<id_type, std::unique_ptr<std::vector<math::color>>> m_colors;
+        static std::unordered_map<id_type, std::shared_ptr<const std::vector<math::color>>> m_colors;
         static async::rw_spinlock m_colorsLock;
 
-        static const std::vector<math::color>& process_raw(id_type id);
+        static std::shared_ptr<const std::vector<math::color>> process_raw(id_type id);
 
-        static const std::vector<math::color>& read_colors(id_type id);
+        static std::shared_ptr<const std::vector<math::color>> read_colors(id_type id);
         static std::pair<async::rw_spinlock&, image&> get_raw_image(id_type id);
 
+        /**@brief Re-imports an image on the hot-reload thread and swaps the pixels in at the next sync point.
+         */
+        static void reload_image(id_type id, const filesystem::view& file, image_import_settings settings);
+
+        /**@brief Stores a freshly imported image and registers it for hot-reloading.
+         */
+        static image_handle store_image(const std::string& name, id_type id, image&& img, const filesystem::view& file, image_import_settings settings);
+
     public:
         /**@brief Create a new image and load it from a file if a image with the same name doesn't exist yet.
          * @param name Identifying name for the image.
@@ -296,6 +304,14 @@ namespace legion::core
          */
         static image_handle create_image(const std::string& name, const filesystem::view& file, image_import_settings settings = default_image_settings);
         static image_handle create_image(const filesystem::view& file, image_import_settings settings = default_image_settings);
+
+        /**@brief Create new images from multiple files at once, named after their files. Files get read and decoded in parallel,
+         *        images with the same name as an existing image aren't loaded again.
+         * @param files Files to load from.
+         * @param settings Settings to pass on to the import pipeline for all of the files.
+         * @return std::vector<image_handle> Handles in the same order as the files, invalid_image_handle for files that failed to load.
+         */
+        static std::vector<image_handle> create_images(const std::vector<filesystem::view>& files, image_import_settings settings = default_image_settings);
         static image_handle insert_image(image&& img);
 
         /**@brief Returns a handle to a image with a certain name. Will return invalid_image_handle if the requested image doesn't exist.
@@ -310,5 +326,17 @@ namespace legion::core
         static void destroy_image(const std::string& name);
 
         static void destroy_image(id_type id);
+
+        /**@brief Get the amount of bytes used by all images and their processed colors.
+         * @note Registered as the sampler of memory::memory_tag::images by the CoreModule.
+         */
+        static size_type memory_footprint();
+
+        /**@brief Frees processed colors that aren't held by anyone outside of the cache, they will be processed again on the next read_colors().
+         * @note Registered as the eviction handler of memory::memory_tag::images by the CoreModule.
+         * @param bytes Amount of bytes to try to free.
+         * @returns size_type Amount of bytes freed.
+         */
+        static size_type evict_colors(size_type bytes);
     };
 }
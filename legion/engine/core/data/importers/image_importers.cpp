@@ -19,8 +19,8 @@ namespace legion::core
         // Prefetch data from the resource.
         const byte_vec& data = resource.get();
 
-        // Setup stb_image settings.
-        stbi_set_flip_vertically_on_load(settings.flipVertical);
+        // Setup stb_image settings, only for this thread since images can get decoded in parallel.
+        stbi_set_flip_vertically_on_load_thread(settings.flipVertical);
 
         // Create image object.
         image image{};
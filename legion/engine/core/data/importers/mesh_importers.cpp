@@ -12,6 +12,7 @@
 #include <core/common/string_extra.hpp>
 #include <core/filesystem/basic_resolver.hpp>
 #include <unordered_map>
+#include <unordered_set>
 #include <algorithm>
 
 namespace legion::core::detail
@@ -42,23 +43,89 @@ namespace legion::core::detail
         }
     };
 
-    image_handle loadGLTFImage(const tinygltf::Image& img)
+    // Encoded image of a glTF file, images only get decoded once the whole file is parsed.
+    struct gltf_encoded_image
     {
-        auto handle = ImageCache::get_handle(img.name);
-        if (handle)
-            return handle;
-
-        image image{};
-        image.name = img.name;
-        image.size.x = img.width;
-        image.size.y = img.height;
-        image.format = img.pixel_type == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE ? channel_format::eight_bit : img.pixel_type == TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT ? channel_format::sixteen_bit : channel_format::float_hdr;
-        image.components = img.component == 1 ? image_components::grey : img.component == 2 ? image_components::grey_alpha : img.component == 3 ? image_components::rgb : image_components::rgba;
-        image.dataSize = img.image.size();
-        image.data = new byte[image.dataSize];
-
-        memcpy(image.data, img.image.data(), img.image.size());
-        return ImageCache::insert_image(std::move(image));
+        int index;
+        int requiredWidth;
+        int requiredHeight;
+    };
+
+    // Image loader callback for tinygltf that keeps the encoded data, so that the images can be decoded in parallel later on.
+    bool deferGLTFImage(tinygltf::Image* img, const int index, std::string*, std::string*, int requiredWidth, int requiredHeight, const unsigned char* bytes, int size, void* userData)
+    {
+        img->image.assign(bytes, bytes + size);
+        static_cast<std::vector<gltf_encoded_image>*>(userData)->push_back({ index, requiredWidth, requiredHeight });
+        return true;
+    }
+
+    // Decodes the images of a glTF file in parallel and moves them into the ImageCache, returns a handle per image of the model.
+    std::vector<image_handle> loadGLTFImages(const tinygltf::Model& model, const std::vector<gltf_encoded_image>& encoded)
+    {
+        OPTICK_EVENT();
+        std::vector<const gltf_encoded_image*> toDecode;
+        std::unordered_set<id_type> queued;
+        for (auto& enc : encoded)
+        {
+            // Images that already exist or share their name with an earlier image of the file are only decoded once.
+            const id_type id = nameHash(model.images[enc.index].name);
+            if (ImageCache::get_handle(id).id != invalid_id || !queued.insert(id).second)
+                continue;
+            toDecode.push_back(&enc);
+        }
+
+        std::vector<image> decoded(toDecode.size());
+        filesystem::AssetImporter::dispatch(toDecode.size(), [&](size_type i)
+            {
+                const gltf_encoded_image& enc = *toDecode[i];
+                const tinygltf::Image& src = model.images[enc.index];
+                const byte* bytes = src.image.data();
+                const int size = static_cast<int>(src.image.size());
+
+                // Texture coordinates in glTF start at the top left, just like the images.
+                stbi_set_flip_vertically_on_load_thread(false);
+
+                image& result = decoded[i];
+                result.format = channel_format::eight_bit;
+
+                int width = 0, height = 0, components = 0;
+                void* pixels = nullptr;
+                if (stbi_is_16_bit_from_memory(bytes, size))
+                {
+                    pixels = stbi_load_16_from_memory(bytes, size, &width, &height, &components, 4);
+                    if (pixels)
+                        result.format = channel_format::sixteen_bit;
+                }
+
+                if (!pixels)
+                    pixels = stbi_load_from_memory(bytes, size, &width, &height, &components, 4);
+
+                if (!pixels || width < 1 || height < 1 || (enc.requiredWidth > 0 && enc.requiredWidth != width) || (enc.requiredHeight > 0 && enc.requiredHeight != height))
+                {
+                    log::error("Failed to decode glTF image {}", src.name);
+                    stbi_image_free(pixels);
+                    return;
+                }
+
+                result.name = src.name;
+                result.size.x = width;
+                result.size.y = height;
+                result.components = image_components::rgba;
+                result.dataSize = static_cast<size_type>(width) * height * 4 * (result.format == channel_format::sixteen_bit ? sizeof(uint16) : sizeof(byte));
+                result.data = new byte[result.dataSize];
+
+                memcpy(result.data, pixels, result.dataSize);
+                stbi_image_free(pixels);
+            });
+
+        for (auto& img : decoded)
+            if (img.data)
+                ImageCache::insert_image(std::move(img));
+
+        std::vector<image_handle> handles(model.images.size(), invalid_image_handle);
+        for (auto& enc : encoded)
+            handles[enc.index] = ImageCache::get_handle(model.images[enc.index].name);
+        return handles;
     }
 
     /**
@@ -186,6 +253,325 @@ namespace legion::core::detail
             data->at(i + size) = origin[i] + offset;
         }
     }
+
+    /**
+     * @brief Function to read any tinygltf accessor as floats, respecting the byte stride and normalizing integer components
+     *
+     * @param model - tinygltf::Model the accessor belongs to
+     * @param accessor - tinygltf::Accessor to read
+     * @return std::vector<float> with all components of all elements, sparse accessors are not supported and read as zero
+     */
+    std::vector<float> readGltfFloats(const tinygltf::Model& model, const tinygltf::Accessor& accessor)
+    {
+        const size_type componentCount = static_cast<size_type>(tinygltf::GetNumComponentsInType(static_cast<uint32>(accessor.type)));
+        std::vector<float> result(accessor.count * componentCount, 0.f);
+        if (accessor.bufferView < 0)
+            return result;
+
+        const tinygltf::BufferView& view = model.bufferViews.at(accessor.bufferView);
+        const tinygltf::Buffer& buffer = model.buffers.at(view.buffer);
+        const int stride = accessor.ByteStride(view);
+        const int componentSize = tinygltf::GetComponentSizeInBytes(static_cast<uint32>(accessor.componentType));
+        if (stride <= 0 || componentSize <= 0 || view.byteOffset + accessor.byteOffset + (accessor.count ? (accessor.count - 1) * stride + componentCount * componentSize : 0) > buffer.data.size())
+        {
+            log::warn("glTF accessor {} points outside of it's buffer, skipping", accessor.name);
+            return result;
+        }
+
+        const unsigned char* base = buffer.data.data() + view.byteOffset + accessor.byteOffset;
+        for (size_type i = 0; i < accessor.count; i++)
+            for (size_type c = 0; c < componentCount; c++)
+            {
+                const unsigned char* ptr = base + i * stride + c * componentSize;
+                float& value = result[i * componentCount + c];
+                switch (accessor.componentType)
+                {
+                case TINYGLTF_COMPONENT_TYPE_FLOAT:
+                    memcpy(&value, ptr, sizeof(float));
+                    break;
+                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
+                    value = accessor.normalized ? *ptr / 255.f : *ptr;
+                    break;
+                case TINYGLTF_COMPONENT_TYPE_BYTE:
+                    value = accessor.normalized ? math::max(*reinterpret_cast<const int8*>(ptr) / 127.f, -1.f) : *reinterpret_cast<const int8*>(ptr);
+                    break;
+                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+                {
+                    uint16 raw;
+                    memcpy(&raw, ptr, sizeof(raw));
+                    value = accessor.normalized ? raw / 65535.f : raw;
+                    break;
+                }
+                case TINYGLTF_COMPONENT_TYPE_SHORT:
+                {
+                    int16 raw;
+                    memcpy(&raw, ptr, sizeof(raw));
+                    value = accessor.normalized ? math::max(raw / 32767.f, -1.f) : raw;
+                    break;
+                }
+                case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+                {
+                    uint32 raw;
+                    memcpy(&raw, ptr, sizeof(raw));
+                    value = static_cast<float>(raw);
+                    break;
+                }
+                }
+            }
+
+        return result;
+    }
+
+    // Mirrors glTF's right handed joint transforms along the x axis, the same conversion the vertices go through.
+    math::vec3 mirrorGltfVector(const math::vec3& value) { return math::vec3(-value.x, value.y, value.z); }
+    math::quat mirrorGltfRotation(const math::quat& value) { return math::quat(value.w, value.x, -value.y, -value.z); }
+    math::mat4 mirrorGltfMatrix(const math::mat4& value)
+    {
+        const math::mat4 mirror = math::scale(math::mat4(1.f), math::vec3(-1.f, 1.f, 1.f));
+        return mirror * value * mirror;
+    }
+
+    joint_pose getGltfNodePose(const tinygltf::Node& node)
+    {
+        joint_pose pose;
+        if (node.matrix.size() == 16)
+        {
+            math::mat4 matrix;
+            for (int i = 0; i < 16; i++)
+                matrix[i / 4][i % 4] = static_cast<float>(node.matrix[i]);
+
+            pose.translation = math::vec3(matrix[3]);
+            pose.scale = math::vec3(math::length(math::vec3(matrix[0])), math::length(math::vec3(matrix[1])), math::length(math::vec3(matrix[2])));
+            pose.rotation = math::quat_cast(math::mat3(math::vec3(matrix[0]) / pose.scale.x, math::vec3(matrix[1]) / pose.scale.y, math::vec3(matrix[2]) / pose.scale.z));
+        }
+        else
+        {
+            if (node.translation.size() == 3)
+                pose.translation = math::vec3(node.translation[0], node.translation[1], node.translation[2]);
+            if (node.rotation.size() == 4)
+                pose.rotation = math::quat(static_cast<float>(node.rotation[3]), static_cast<float>(node.rotation[0]), static_cast<float>(node.rotation[1]), static_cast<float>(node.rotation[2]));
+            if (node.scale.size() == 3)
+                pose.scale = math::vec3(node.scale[0], node.scale[1], node.scale[2]);
+        }
+
+        pose.translation = mirrorGltfVector(pose.translation);
+        pose.rotation = mirrorGltfRotation(pose.rotation);
+        return pose;
+    }
+
+    /**
+     * @brief Function to load the first skin of a tinygltf model as a skeleton
+     *
+     * @param model - tinygltf::Model containing the skin
+     * @param skinToJoint - Output, maps the joint indices used by the vertices to skeleton joints
+     * @param nodeToJoint - Output, maps node indices to skeleton joints, used to find the joints targeted by animations
+     * @return The skeleton with it's joints sorted parents first, nullptr if the model has no skin
+     */
+    std::shared_ptr<skeleton> loadGltfSkeleton(const tinygltf::Model& model, std::vector<uint32>& skinToJoint, std::unordered_map<int, uint32>& nodeToJoint)
+    {
+        if (model.skins.empty())
+            return nullptr;
+
+        if (model.skins.size() > 1)
+            log::warn("glTF contains {} skins, only the first one is imported", model.skins.size());
+
+        const tinygltf::Skin& skin = model.skins.front();
+        const size_type jointCount = skin.joints.size();
+
+        std::vector<int> nodeParents(model.nodes.size(), -1);
+        for (size_type i = 0; i < model.nodes.size(); i++)
+            for (int child : model.nodes[i].children)
+                nodeParents.at(child) = static_cast<int>(i);
+
+        std::unordered_map<int, size_type> nodeToSkinIndex;
+        for (size_type i = 0; i < jointCount; i++)
+            nodeToSkinIndex[skin.joints[i]] = i;
+
+        // Parent of a joint is it's closest ancestor that's part of the skin.
+        std::vector<int> skinParents(jointCount, -1);
+        std::vector<size_type> depths(jointCount, 0);
+        for (size_type i = 0; i < jointCount; i++)
+            for (int node = nodeParents.at(skin.joints[i]); node >= 0; node = nodeParents[node])
+                if (auto it = nodeToSkinIndex.find(node); it != nodeToSkinIndex.end())
+                {
+                    if (skinParents[i] < 0)
+                        skinParents[i] = static_cast<int>(it->second);
+                    depths[i]++;
+                }
+
+        // Sorting by depth puts every parent before it's children.
+        std::vector<uint32> order(jointCount);
+        for (size_type i = 0; i < jointCount; i++)
+            order[i] = static_cast<uint32>(i);
+        std::stable_sort(order.begin(), order.end(), [&](uint32 a, uint32 b) { return depths[a] < depths[b]; });
+
+        skinToJoint.assign(jointCount, 0);
+        for (size_type i = 0; i < jointCount; i++)
+            skinToJoint[order[i]] = static_cast<uint32>(i);
+
+        std::vector<float> inverseBinds;
+        if (skin.inverseBindMatrices >= 0)
+            inverseBinds = readGltfFloats(model, model.accessors.at(skin.inverseBindMatrices));
+
+        auto result = std::make_shared<skeleton>();
+        result->jointNames.resize(jointCount);
+        result->parents.resize(jointCount);
+        result->inverseBindMatrices.resize(jointCount, math::mat4(1.f));
+        result->restPose.resize(jointCount);
+
+        for (size_type i = 0; i < jointCount; i++)
+        {
+            const uint32 source = order[i];
+            const tinygltf::Node& node = model.nodes.at(skin.joints[source]);
+
+            nodeToJoint[skin.joints[source]] = static_cast<uint32>(i);
+            result->jointNames[i] = node.name;
+            result->parents[i] = skinParents[source] < 0 ? -1 : static_cast<int32>(skinToJoint[skinParents[source]]);
+            result->restPose[i] = getGltfNodePose(node);
+
+            if (inverseBinds.size() >= (source + 1) * 16)
+            {
+                math::mat4 inverseBind;
+                for (int j = 0; j < 16; j++)
+                    inverseBind[j / 4][j % 4] = inverseBinds[source * 16 + j];
+                result->inverseBindMatrices[i] = mirrorGltfMatrix(inverseBind);
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Function to copy the joint indices and weights of a tinygltf primitive into the mesh data
+     *
+     * @param model - tinygltf::Model containing the primitive
+     * @param primitive - tinygltf::Primitive of which the vertices were just appended to the mesh data
+     * @param skinToJoint - Map from skin joint index to skeleton joint index
+     * @param data - The mesh data, joints and weights get resized to the vertex count, vertices without skinning data are bound to joint 0
+     */
+    void handleGltfSkinning(const tinygltf::Model& model, const tinygltf::Primitive& primitive, const std::vector<uint32>& skinToJoint, mesh& data)
+    {
+        const size_type start = data.joints.size();
+        const size_type end = data.vertices.size();
+        data.joints.resize(end, math::uvec4(0));
+        data.weights.resize(end, math::vec4(1.f, 0.f, 0.f, 0.f));
+
+        auto jointsAttrib = primitive.attributes.find("JOINTS_0");
+        auto weightsAttrib = primitive.attributes.find("WEIGHTS_0");
+        if (jointsAttrib == primitive.attributes.end() || weightsAttrib == primitive.attributes.end())
+            return;
+
+        // Joint indices are unsigned integers, readGltfFloats keeps them as they are since they're never normalized.
+        const std::vector<float> joints = readGltfFloats(model, model.accessors.at(jointsAttrib->second));
+        const std::vector<float> weights = readGltfFloats(model, model.accessors.at(weightsAttrib->second));
+
+        for (size_type i = start; i < end; i++)
+        {
+            const size_type src = (i - start) * 4;
+            if (src + 3 >= joints.size() || src + 3 >= weights.size())
+                break;
+
+            math::vec4 weight(weights[src], weights[src + 1], weights[src + 2], weights[src + 3]);
+            const float total = weight.x + weight.y + weight.z + weight.w;
+            weight = total > 0.f ? weight / total : math::vec4(1.f, 0.f, 0.f, 0.f);
+
+            math::uvec4 joint;
+            for (size_type j = 0; j < 4; j++)
+            {
+                const size_type index = static_cast<size_type>(joints[src + j]);
+                joint[j] = index < skinToJoint.size() ? skinToJoint[index] : 0;
+            }
+
+            data.joints[i] = joint;
+            data.weights[i] = weight;
+        }
+    }
+
+    /**
+     * @brief Function to load the animations of a tinygltf model that target the joints of the skeleton
+     *
+     * @param model - tinygltf::Model containing the animations
+     * @param skeleton - Skeleton the animations are baked against
+     * @param nodeToJoint - Map from node index to skeleton joint index
+     * @param clips - Output, receives one baked clip per animation
+     */
+    void loadGltfAnimations(const tinygltf::Model& model, const skeleton& skeleton, const std::unordered_map<int, uint32>& nodeToJoint, std::vector<animation_clip>& clips)
+    {
+        constexpr float keyTolerance = 1e-4f;
+
+        for (size_type i = 0; i < model.animations.size(); i++)
+        {
+            const tinygltf::Animation& anim = model.animations[i];
+
+            animation_clip clip;
+            clip.name = anim.name.empty() ? "animation" + std::to_string(i) : anim.name;
+
+            for (auto& channel : anim.channels)
+            {
+                auto joint = nodeToJoint.find(channel.target_node);
+                if (joint == nodeToJoint.end())
+                    continue;
+
+                animation_track track;
+                track.joint = joint->second;
+                if (channel.target_path == "translation")
+                    track.path = animation_path::translation;
+                else if (channel.target_path == "rotation")
+                    track.path = animation_path::rotation;
+                else if (channel.target_path == "scale")
+                    track.path = animation_path::scale;
+                else
+                    continue; // Morph target weights aren't supported.
+
+                const tinygltf::AnimationSampler& sampler = anim.samplers.at(channel.sampler);
+                const std::vector<float> times = readGltfFloats(model, model.accessors.at(sampler.input));
+                const std::vector<float> values = readGltfFloats(model, model.accessors.at(sampler.output));
+
+                const size_type width = track.path == animation_path::rotation ? 4 : 3;
+                const bool cubic = sampler.interpolation == "CUBICSPLINE";
+                const bool step = sampler.interpolation == "STEP";
+
+                for (size_type key = 0; key < times.size(); key++)
+                {
+                    // Cubic spline keys store an in-tangent, the value and an out-tangent, only the value is used.
+                    const size_type src = (cubic ? key * 3 + 1 : key) * width;
+                    if (src + width > values.size())
+                        break;
+
+                    math::vec4 value(values[src], values[src + 1], values[src + 2], width == 4 ? values[src + 3] : 0.f);
+                    if (track.path == animation_path::translation)
+                        value.x = -value.x;
+                    else if (track.path == animation_path::rotation)
+                    {
+                        value.y = -value.y;
+                        value.z = -value.z;
+                        // Keep consecutive rotations on the same hemisphere so they interpolate along the shortest arc.
+                        if (!track.values.empty() && math::dot(track.values.back(), value) < 0.f)
+                            value = -value;
+                    }
+
+                    if (step && !track.times.empty())
+                    {
+                        track.times.push_back(math::max(times[key] - 1e-5f, track.times.back()));
+                        track.values.push_back(track.values.back());
+                    }
+
+                    track.times.push_back(times[key]);
+                    track.values.push_back(value);
+                    clip.duration = math::max(clip.duration, times[key]);
+                }
+
+                if (track.times.empty())
+                    continue;
+
+                track.reduce(keyTolerance);
+                clip.tracks.push_back(std::move(track));
+            }
+
+            clip.bake(skeleton);
+            clips.push_back(std::move(clip));
+        }
+    }
 }
 
 #if !defined(DOXY_EXCLUDE)
@@ -277,31 +663,39 @@ namespace legion::core
                 material.doubleSided = false;
 
                 material.albedoValue = math::color(srcMat.diffuse[0], srcMat.diffuse[1], srcMat.diffuse[2]);
-                if (!srcMat.diffuse_texname.empty())
-                    material.albedoMap = ImageCache::create_image(filesystem::view(srcMat.diffuse_texname));
-
                 material.metallicValue = srcMat.metallic;
-                if (!srcMat.metallic_texname.empty())
-                    material.metallicMap = ImageCache::create_image(filesystem::view(srcMat.metallic_texname));
-
                 material.roughnessValue = srcMat.roughness;
-                if (!srcMat.roughness_texname.empty())
-                    material.roughnessMap = ImageCache::create_image(filesystem::view(srcMat.roughness_texname));
-
                 material.metallicRoughnessMap = invalid_image_handle;
-
                 material.emissiveValue = math::color(srcMat.emission[0], srcMat.emission[1], srcMat.emission[2]);
-                if (!srcMat.emissive_texname.empty())
-                    material.emissiveMap = ImageCache::create_image(filesystem::view(srcMat.emissive_texname));
-
-                if (!srcMat.normal_texname.empty())
-                    material.normalMap = ImageCache::create_image(filesystem::view(srcMat.normal_texname));
-
                 material.aoMap = invalid_image_handle;
+            }
 
-                if (!srcMat.bump_texname.empty())
-                    material.heightMap = ImageCache::create_image(filesystem::view(srcMat.bump_texname));
+            // Gather the textures of all materials first, so that they can be loaded as a single batch.
+            std::vector<filesystem::view> textureFiles;
+            std::vector<image_handle*> textureTargets;
+            const auto addTexture = [&](const std::string& texname, image_handle& target)
+            {
+                if (texname.empty())
+                    return;
+                textureFiles.emplace_back(texname);
+                textureTargets.push_back(&target);
+            };
+
+            auto materialIt = settings.materials->end() - srcMaterials.size();
+            for (auto& srcMat : srcMaterials)
+            {
+                addTexture(srcMat.diffuse_texname, materialIt->albedoMap);
+                addTexture(srcMat.metallic_texname, materialIt->metallicMap);
+                addTexture(srcMat.roughness_texname, materialIt->roughnessMap);
+                addTexture(srcMat.emissive_texname, materialIt->emissiveMap);
+                addTexture(srcMat.normal_texname, materialIt->normalMap);
+                addTexture(srcMat.bump_texname, materialIt->heightMap);
+                ++materialIt;
             }
+
+            auto textures = ImageCache::create_images(textureFiles);
+            for (size_type i = 0; i < textures.size(); i++)
+                *textureTargets[i] = textures[i];
         }
 
         // Get all the vertex and composition data.
@@ -378,6 +772,7 @@ namespace legion::core
 
         // Calculate the tangents.
         mesh::calculate_tangents(&data);
+        mesh::calculate_bounds(&data);
 
         // Construct and return the result.
         return decay(Ok(data));
@@ -398,6 +793,10 @@ namespace legion::core
         std::string err;
         std::string warn;
 
+        // Images only get decoded when materials are requested, and then all of them in parallel.
+        std::vector<detail::gltf_encoded_image> encodedImages;
+        loader.SetImageLoader(&detail::deferGLTFImage, &encodedImages);
+
         // Load gltf mesh data into model
         bool ret = loader.LoadBinaryFromMemory(&model, &err, &warn, resource.data(), resource.size());
 
@@ -419,6 +818,8 @@ namespace legion::core
 
         if (settings.materials)
         {
+            const std::vector<image_handle> images = detail::loadGLTFImages(model, encodedImages);
+
             for (auto& srcMat : model.materials)
             {
                 auto& material = settings.materials->emplace_back();
@@ -431,28 +832,33 @@ namespace legion::core
 
                 material.albedoValue = math::color(pbrData.baseColorFactor[0], pbrData.baseColorFactor[1], pbrData.baseColorFactor[2], pbrData.baseColorFactor[3]);
                 if (pbrData.baseColorTexture.index >= 0)
-                    material.albedoMap = detail::loadGLTFImage(model.images[model.textures[pbrData.baseColorTexture.index].source]);
+                    material.albedoMap = images[model.textures[pbrData.baseColorTexture.index].source];
 
                 material.metallicValue = static_cast<float>(pbrData.metallicFactor);
                 material.roughnessValue = static_cast<float>(pbrData.roughnessFactor);
 
                 if (pbrData.metallicRoughnessTexture.index >= 0)
-                    material.metallicRoughnessMap = detail::loadGLTFImage(model.images[model.textures[pbrData.metallicRoughnessTexture.index].source]);
+                    material.metallicRoughnessMap = images[model.textures[pbrData.metallicRoughnessTexture.index].source];
 
                 material.emissiveValue = math::color(srcMat.emissiveFactor[0], srcMat.emissiveFactor[1], srcMat.emissiveFactor[2]);
                 if (srcMat.emissiveTexture.index >= 0)
-                    material.emissiveMap = detail::loadGLTFImage(model.images[model.textures[srcMat.emissiveTexture.index].source]);
+                    material.emissiveMap = images[model.textures[srcMat.emissiveTexture.index].source];
 
                 if (srcMat.normalTexture.index >= 0)
-                    material.normalMap = detail::loadGLTFImage(model.images[model.textures[srcMat.normalTexture.index].source]);
+                    material.normalMap = images[model.textures[srcMat.normalTexture.index].source];
 
                 if (srcMat.occlusionTexture.index >= 0)
-                    material.aoMap = detail::loadGLTFImage(model.images[model.textures[srcMat.occlusionTexture.index].source]);
+                    material.aoMap = images[model.textures[srcMat.occlusionTexture.index].source];
 
                 material.heightMap = invalid_image_handle;
             }
         }
 
+        // Only the first skin is imported, the joints of the vertices get remapped to the order of the skeleton.
+        std::vector<uint32> skinToJoint;
+        std::unordered_map<int, uint32> nodeToJoint;
+        std::shared_ptr<skeleton> skin = detail::loadGltfSkeleton(model, skinToJoint, nodeToJoint);
+
         size_t offset = 0;
         core::mesh meshData;
         for (auto& mesh : model.meshes)
@@ -500,11 +906,18 @@ namespace legion::core
                         // Vertex color data
                         detail::handleGltfVertexColor(buff, view, accessor.type, accessor.componentType, &(meshData.colors));
                     }
+                    else if (attrib.first.compare("JOINTS_0") == 0 || attrib.first.compare("WEIGHTS_0") == 0)
+                    {
+                        // Skinning data, read below once all vertices of the primitive are in.
+                    }
                     else
                     {
                         log::warn("More data to be found in .gbl. Data can be accesed through: {}", attrib.first);
                     }
                 }
+
+                if (skin)
+                    detail::handleGltfSkinning(model, primitive, skinToJoint, meshData);
             }
 
             // Calculate size of submesh and offset of submesh to sure in meshData
@@ -533,7 +946,14 @@ namespace legion::core
             meshData.indices[i + 2] = i1;
         }
 
+        if (skin)
+        {
+            detail::loadGltfAnimations(model, *skin, nodeToJoint, meshData.animations);
+            meshData.skin = std::move(skin);
+        }
+
         mesh::calculate_tangents(&meshData);
+        mesh::calculate_bounds(&meshData);
 
         return decay(Ok(meshData));
     }
@@ -579,6 +999,10 @@ namespace legion::core
             log::warn("Invalid gltf context path");
         }
 
+        // Images only get decoded when materials are requested, and then all of them in parallel.
+        std::vector<detail::gltf_encoded_image> encodedImages;
+        loader.SetImageLoader(&detail::deferGLTFImage, &encodedImages);
+
         // Load gltf mesh data into model
         bool ret = loader.LoadASCIIFromString(&model, &err, &warn, ascii.c_str(), ascii.length(), resolver->get_absolute_path());
 
@@ -600,6 +1024,8 @@ namespace legion::core
 
         if (settings.materials)
         {
+            const std::vector<image_handle> images = detail::loadGLTFImages(model, encodedImages);
+
             for (auto& srcMat : model.materials)
             {
                 auto& material = settings.materials->emplace_back();
@@ -612,28 +1038,33 @@ namespace legion::core
 
                 material.albedoValue = math::color(pbrData.baseColorFactor[0], pbrData.baseColorFactor[1], pbrData.baseColorFactor[2], pbrData.baseColorFactor[3]);
                 if (pbrData.baseColorTexture.index >= 0)
-                    material.albedoMap = detail::loadGLTFImage(model.images[model.textures[pbrData.baseColorTexture.index].source]);
+                    material.albedoMap = images[model.textures[pbrData.baseColorTexture.index].source];
 
                 material.metallicValue = static_cast<float>(pbrData.metallicFactor);
                 material.roughnessValue = static_cast<float>(pbrData.roughnessFactor);
 
                 if (pbrData.metallicRoughnessTexture.index >= 0)
-                    material.metallicRoughnessMap = detail::loadGLTFImage(model.images[model.textures[pbrData.metallicRoughnessTexture.index].source]);
+                    material.metallicRoughnessMap = images[model.textures[pbrData.metallicRoughnessTexture.index].source];
 
                 material.emissiveValue = math::color(srcMat.emissiveFactor[0], srcMat.emissiveFactor[1], srcMat.emissiveFactor[2]);
                 if (srcMat.emissiveTexture.index >= 0)
-                    material.emissiveMap = detail::loadGLTFImage(model.images[model.textures[srcMat.emissiveTexture.index].source]);
+                    material.emissiveMap = images[model.textures[srcMat.emissiveTexture.index].source];
 
                 if (srcMat.normalTexture.index >= 0)
-                    material.normalMap = detail::loadGLTFImage(model.images[model.textures[srcMat.normalTexture.index].source]);
+                    material.normalMap = images[model.textures[srcMat.normalTexture.index].source];
 
                 if (srcMat.occlusionTexture.index >= 0)
-                    material.aoMap = detail::loadGLTFImage(model.images[model.textures[srcMat.occlusionTexture.index].source]);
+                    material.aoMap = images[model.textures[srcMat.occlusionTexture.index].source];
 
                 material.heightMap = invalid_image_handle;
             }
         }
 
+        // Only the first skin is imported, the joints of the vertices get remapped to the order of the skeleton.
+        std::vector<uint32> skinToJoint;
+        std::unordered_map<int, uint32> nodeToJoint;
+        std::shared_ptr<skeleton> skin = detail::loadGltfSkeleton(model, skinToJoint, nodeToJoint);
+
         size_t offset = 0;
         core::mesh meshData;
         for (auto& mesh : model.meshes)
@@ -680,11 +1111,18 @@ namespace legion::core
                         // Vertex color data
                         detail::handleGltfVertexColor(buff, view, accessor.type, accessor.componentType, &(meshData.colors));
                     }
+                    else if (attrib.first.compare("JOINTS_0") == 0 || attrib.first.compare("WEIGHTS_0") == 0)
+                    {
+                        // Skinning data, read below once all vertices of the primitive are in.
+                    }
                     else
                     {
                         log::warn("More data to be found in .gbl. Data can be accesed through: {}", attrib.first);
                     }
                 }
+
+                if (skin)
+                    detail::handleGltfSkinning(model, primitive, skinToJoint, meshData);
             }
 
             // Calculate size of submesh and offset of submesh to sure in meshData
@@ -713,7 +1151,14 @@ namespace legion::core
             meshData.indices[i + 2] = i1;
         }
 
+        if (skin)
+        {
+            detail::loadGltfAnimations(model, *skin, nodeToJoint, meshData.animations);
+            meshData.skin = std::move(skin);
+        }
+
         mesh::calculate_tangents(&meshData);
+        mesh::calculate_bounds(&meshData);
 
         return decay(Ok(meshData));
     }
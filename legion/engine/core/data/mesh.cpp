@@ -1,5 +1,6 @@
 ﻿#include <core/data/mesh.hpp>
 #include <core/data/importers/mesh_importers.hpp>
+#include <core/filesystem/hot_reload.hpp>
 
 namespace legion::core
 {
@@ -33,6 +34,22 @@ namespace legion::core
             appendBinaryData(&submesh.indexCount, data);
             appendBinaryData(&submesh.indexOffset, data);
         }
+
+        // Append the skin, animation clips are stored in the AnimationCache instead.
+        appendBinaryData(&value.joints, data);
+        appendBinaryData(&value.weights, data);
+
+        uint64 jointCount = value.skin ? value.skin->joint_count() : 0;
+        appendBinaryData(&jointCount, data);
+
+        if (jointCount)
+        {
+            for (auto& name : value.skin->jointNames)
+                appendBinaryData(&name, data);
+            appendBinaryData(&value.skin->parents, data);
+            appendBinaryData(&value.skin->inverseBindMatrices, data);
+            appendBinaryData(&value.skin->restPose, data);
+        }
     }
 
     void mesh::from_resource(mesh* value, const filesystem::basic_resource& resource)
@@ -65,6 +82,27 @@ namespace legion::core
             retrieveBinaryData(submesh.indexOffset, start);
             value->submeshes.push_back(submesh);
         }
+
+        // Read the skin.
+        retrieveBinaryData(value->joints, start);
+        retrieveBinaryData(value->weights, start);
+
+        uint64 jointCount;
+        retrieveBinaryData(jointCount, start);
+
+        if (jointCount)
+        {
+            auto skin = std::make_shared<skeleton>();
+            skin->jointNames.resize(jointCount);
+            for (auto& name : skin->jointNames)
+                retrieveBinaryData(name, start);
+            retrieveBinaryData(skin->parents, start);
+            retrieveBinaryData(skin->inverseBindMatrices, start);
+            retrieveBinaryData(skin->restPose, start);
+            value->skin = std::move(skin);
+        }
+
+        calculate_bounds(value);
     }
 
     void mesh::calculate_tangents(mesh* data)
@@ -134,6 +172,12 @@ namespace legion::core
                 data->tangents[i] = math::normalize(data->tangents[i]);
     }
 
+    void mesh::calculate_bounds(mesh* data)
+    {
+        OPTICK_EVENT();
+        data->bounds = math::bounding_volume::from_points(data->vertices.data(), data->vertices.size());
+    }
+
     std::pair<async::rw_spinlock&, mesh&> mesh_handle::get()
     {
         OPTICK_EVENT();
@@ -168,6 +212,7 @@ namespace legion::core
 
         mesh data = result;
         data.filePath = file.get_virtual_path(); // Set the filename.
+        insert_animations(name, data);
 
         { // Insert the mesh into the mesh list.
             async::readwrite_guard guard(m_meshesLock);
@@ -176,9 +221,58 @@ namespace legion::core
             m_meshes.emplace(id, std::unique_ptr<std::pair<async::rw_spinlock, mesh>>(pair_ptr));
         }
 
+        if (filesystem::hot_reload::enabled())
+        {
+            // Embedded materials were already created by the first import and the list they were written to won't be alive anymore.
+            settings.materials = nullptr;
+
+            const std::string node = filesystem::hot_reload::entry_node("mesh", id);
+            filesystem::hot_reload::add_dependency(node, file.get_virtual_path());
+            filesystem::hot_reload::on_reload(node, [id, name, file, settings]() { reload_mesh(id, name, file, settings); });
+        }
+
         return { id };
     }
 
+    void MeshCache::reload_mesh(id_type id, const std::string& name, const filesystem::view& file, mesh_import_settings settings)
+    {
+        OPTICK_EVENT();
+        auto result = filesystem::AssetImporter::tryLoad<mesh>(file, settings);
+
+        if (result != common::valid)
+        {
+            log::error("Error while reloading file: {} {}", file.get_virtual_path(), result.get_error());
+            return;
+        }
+
+        auto data = std::make_shared<mesh>(result.decay());
+        data->filePath = file.get_virtual_path();
+
+        // Clips are handed out as shared pointers, animators still sampling the old ones keep them alive until they're done.
+        insert_animations(name, *data);
+
+        filesystem::hot_reload::commit([id, data]()
+            {
+                async::readonly_guard guard(m_meshesLock);
+                auto it = m_meshes.find(id);
+                if (it == m_meshes.end())
+                    return;
+
+                async::readwrite_guard entryGuard(it->second->first);
+                it->second->second = std::move(*data);
+            });
+    }
+
+    void MeshCache::insert_animations(const std::string& name, mesh& data)
+    {
+        for (auto& clip : data.animations)
+        {
+            std::string clipName = name + '/' + clip.name;
+            AnimationCache::insert_clip(clipName, std::move(clip));
+        }
+        data.animations.clear();
+    }
+
     mesh_handle MeshCache::create_mesh(const std::string& name, const mesh& meshData)
     {
         id_type newId = nameHash(name); // Get the new id.
@@ -186,6 +280,7 @@ namespace legion::core
         async::readwrite_guard guard(m_meshesLock);
         auto* pair_ptr = new std::pair<async::rw_spinlock, mesh>();
         pair_ptr->second = std::move(meshData);
+        mesh::calculate_bounds(&pair_ptr->second);
         m_meshes.emplace(newId, std::unique_ptr<std::pair<async::rw_spinlock, mesh>>(pair_ptr));
 
         return { newId };
@@ -274,7 +369,35 @@ namespace legion::core
             erased = m_meshes.erase(id);
         }
 
+        filesystem::hot_reload::remove(filesystem::hot_reload::entry_node("mesh", id));
+
         if (erased)
             log::debug("Destroyed mesh {}", id);
     }
+
+    size_type MeshCache::memory_footprint()
+    {
+        OPTICK_EVENT();
+        size_type footprint = 0;
+
+        async::readonly_guard guard(m_meshesLock);
+        for (auto& [id, pair] : m_meshes)
+        {
+            auto& [lock, data] = *pair;
+            async::readonly_guard meshGuard(lock);
+
+            footprint += sizeof(std::pair<async::rw_spinlock, mesh>) +
+                data.vertices.capacity() * sizeof(math::vec3) +
+                data.colors.capacity() * sizeof(math::color) +
+                data.normals.capacity() * sizeof(math::vec3) +
+                data.uvs.capacity() * sizeof(math::vec2) +
+                data.tangents.capacity() * sizeof(math::vec3) +
+                data.indices.capacity() * sizeof(uint) +
+                data.submeshes.capacity() * sizeof(sub_mesh) +
+                data.joints.capacity() * sizeof(math::uvec4) +
+                data.weights.capacity() * sizeof(math::vec4);
+        }
+
+        return footprint;
+    }
 }
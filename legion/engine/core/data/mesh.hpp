@@ -5,6 +5,7 @@
 #include <core/filesystem/view.hpp>
 #include <core/async/rw_spinlock.hpp>
 #include <core/data/image.hpp>
+#include <core/data/animation.hpp>
 
 #include <utility>
 #include <vector>
@@ -43,6 +44,19 @@ namespace legion::core
 
         std::vector<sub_mesh> submeshes;
 
+        /**@brief Local space bounds of all vertices, calculated when the mesh is loaded or created.
+         */
+        math::bounding_volume bounds;
+
+        // Skinning data, empty for meshes without a skin. Every vertex is influenced by up to 4 joints of the skeleton.
+        std::vector<math::uvec4> joints;
+        std::vector<math::vec4> weights;
+        std::shared_ptr<const skeleton> skin;
+
+        /**@brief Clips imported together with the mesh, moved into the AnimationCache by the MeshCache.
+         */
+        std::vector<animation_clip> animations;
+
         /**@brief Standard to resource conversion.
          */
         static void to_resource(filesystem::basic_resource* resource, const mesh& value);
@@ -54,6 +68,10 @@ namespace legion::core
         /**@brief Calculate the tangents from the triangles, vertices and normals of a certain mesh.
          */
         static void calculate_tangents(mesh* data);
+
+        /**@brief Calculate the local space AABB and bounding sphere of the vertices of a certain mesh.
+         */
+        static void calculate_bounds(mesh* data);
     };
 
     /**@class mesh_handle
@@ -125,6 +143,14 @@ namespace legion::core
         static std::unordered_map<id_type, std::unique_ptr<std::pair<async::rw_spinlock, mesh>>> m_meshes;
         static std::unordered_map<id_type, filesystem::view> m_materialsToDigest;
         static async::rw_spinlock m_meshesLock;
+
+        /**@brief Re-imports a mesh on the hot-reload thread and swaps it in at the next sync point.
+         */
+        static void reload_mesh(id_type id, const std::string& name, const filesystem::view& file, mesh_import_settings settings);
+
+        /**@brief Moves the clips imported with a mesh into the AnimationCache as "<mesh name>/<clip name>".
+         */
+        static void insert_animations(const std::string& name, mesh& data);
     public:
         static id_type debugId;
 
@@ -162,5 +188,10 @@ namespace legion::core
         static mesh_handle get_handle(id_type id);
 
         static void destroy_mesh(id_type id);
+
+        /**@brief Get the amount of bytes used by all meshes in the cache.
+         * @note Registered as the sampler of memory::memory_tag::meshes by the CoreModule.
+         */
+        static size_type memory_footprint();
     };
 }
@@ -0,0 +1,114 @@
+#include <core/defaults/animationsystem.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <unordered_map>
+
+namespace legion::core
+{
+    void AnimationSystem::setup()
+    {
+        createProcess<&AnimationSystem::update>("Update");
+        m_query = createQuery<animator, joint_palette>();
+    }
+
+    void AnimationSystem::evaluate(scheduling::Scheduler* scheduler, size_type count, const skeleton* const* skeletons,
+        const animation::layer* layers, const size_type* layerCounts, joint_palette* palettes)
+    {
+        OPTICK_EVENT();
+        if (!count)
+            return;
+
+        const size_type jobCount = (count + skeletons_per_job - 1) / skeletons_per_job;
+        scheduler->queueJobs(jobCount, [&]()
+            {
+                // Scratch buffers get reused by every job on the same worker thread.
+                thread_local std::vector<float> pose;
+                thread_local std::vector<math::mat4> modelSpace;
+
+                const size_type first = async::this_job::get_id() * skeletons_per_job;
+                const size_type last = std::min(first + skeletons_per_job, count);
+                for (size_type i = first; i < last; i++)
+                {
+                    if (!skeletons[i] || skeletons[i]->empty())
+                    {
+                        palettes[i].matrices.clear();
+                        continue;
+                    }
+
+                    animation::sample(*skeletons[i], layers + i * animator::max_layers, layerCounts[i], pose);
+                    animation::compute_palette(*skeletons[i], pose, modelSpace, palettes[i].matrices);
+                }
+            }).wait();
+    }
+
+    void AnimationSystem::update(time::span deltaTime)
+    {
+        OPTICK_EVENT();
+        m_query.queryEntities();
+        const size_type count = m_query.size();
+        if (!count)
+            return;
+
+        auto& animators = m_query.get<animator>();
+        auto& palettes = m_query.get<joint_palette>();
+
+        // Skeletons and clips are resolved once on this thread, the shared pointers keep them alive in case they get hot-reloaded.
+        std::unordered_map<id_type, std::shared_ptr<const skeleton>> skins;
+        std::unordered_map<id_type, std::shared_ptr<const animation_clip>> clips;
+
+        std::vector<const skeleton*> skeletons(count, nullptr);
+        std::vector<animation::layer> layers(count * animator::max_layers);
+        std::vector<size_type> layerCounts(count, 0);
+
+        const float dt = deltaTime.seconds();
+
+        for (size_type i = 0; i < count; i++)
+        {
+            animator& anim = animators[i];
+
+            auto [skin, newSkin] = skins.try_emplace(anim.skinnedMesh.id);
+            if (newSkin && MeshCache::get_handle(anim.skinnedMesh.id).id != invalid_id)
+            {
+                auto [lock, data] = anim.skinnedMesh.get();
+                async::readonly_guard guard(lock);
+                skin->second = data.skin;
+            }
+            skeletons[i] = skin->second.get();
+
+            for (size_type l = 0; l < std::min(anim.layerCount, animator::max_layers); l++)
+            {
+                animation_layer_state& state = anim.layers[l];
+
+                auto [clipEntry, newClip] = clips.try_emplace(state.clip.id);
+                if (newClip)
+                    clipEntry->second = state.clip.get();
+
+                const animation_clip* clip = clipEntry->second.get();
+                if (!clip)
+                    continue;
+
+                if (!anim.paused)
+                {
+                    state.time += dt * state.speed;
+                    if (state.loop && clip->duration > 0.f)
+                    {
+                        state.time = std::fmod(state.time, clip->duration);
+                        if (state.time < 0.f)
+                            state.time += clip->duration;
+                    }
+                    else
+                        state.time = math::clamp(state.time, 0.f, clip->duration);
+                }
+
+                layers[i * animator::max_layers + layerCounts[i]++] = animation::layer{ clip, state.time, state.weight };
+            }
+        }
+
+        evaluate(m_scheduler, count, skeletons.data(), layers.data(), layerCounts.data(), palettes.data());
+
+        m_query.submit<animator>();
+        m_query.submit<joint_palette>();
+    }
+}
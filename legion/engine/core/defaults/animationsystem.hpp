@@ -0,0 +1,95 @@
+#pragma once
+#include <core/engine/system.hpp>
+#include <core/defaults/defaultcomponents.hpp>
+#include <core/data/animation.hpp>
+
+#include <array>
+#include <vector>
+
+/**
+ * @file animationsystem.hpp
+ * @brief Plays animation clips on skinned meshes.
+ *        Every update the clocks of all animators get advanced, after which the poses of all skeletons are sampled,
+ *        blended and converted to joint palettes in parallel on the job pool. Renderers upload the joint palettes as skinning matrices.
+ */
+
+namespace legion::core
+{
+    /**@class animation_layer_state
+     * @brief Playback state of a single clip on an animator.
+     */
+    struct animation_layer_state
+    {
+        animation_handle clip = invalid_animation_handle;
+        float time = 0.f;
+        float speed = 1.f;
+        float weight = 1.f;
+        bool loop = true;
+    };
+
+    /**@class animator
+     * @brief Animates the skeleton of a skinned mesh by blending up to max_layers clips.
+     */
+    struct animator
+    {
+        static constexpr size_type max_layers = 4;
+
+        mesh_handle skinnedMesh = invalid_mesh_handle;
+        std::array<animation_layer_state, max_layers> layers;
+        size_type layerCount = 0;
+        bool paused = false;
+
+        /**@brief Adds a clip to blend in, returns false if all layers are in use.
+         */
+        bool play(animation_handle clip, float weight = 1.f, bool loop = true)
+        {
+            if (layerCount >= max_layers)
+                return false;
+
+            animation_layer_state& layer = layers[layerCount++];
+            layer = animation_layer_state{};
+            layer.clip = clip;
+            layer.weight = weight;
+            layer.loop = loop;
+            return true;
+        }
+
+        void stop()
+        {
+            layerCount = 0;
+        }
+    };
+
+    /**@class joint_palette
+     * @brief Skinning matrices of a skinned mesh: the model space transform of every joint times it's inverse bind matrix.
+     */
+    struct joint_palette
+    {
+        std::vector<math::mat4> matrices;
+    };
+
+    /**@class AnimationSystem
+     * @brief Evaluates all animators into their joint palettes.
+     */
+    class AnimationSystem final : public System<AnimationSystem>
+    {
+    public:
+        /**@brief Amount of skeletons evaluated by a single job, amortizes the cost of queueing jobs over a few characters.
+         */
+        static constexpr size_type skeletons_per_job = 8;
+
+        /**@brief Evaluates a batch of skeletons on the job pool, used by update() and usable without the ECS.
+         * @param layers layerCounts[i] layers for skeleton i, stored at layers[i * animator::max_layers].
+         * @param palettes Output, one palette per skeleton.
+         */
+        static void evaluate(scheduling::Scheduler* scheduler, size_type count, const skeleton* const* skeletons,
+            const animation::layer* layers, const size_type* layerCounts, joint_palette* palettes);
+
+        virtual void setup();
+
+        void update(time::span deltaTime);
+
+    private:
+        ecs::EntityQuery m_query;
+    };
+}
@@ -1,26 +1,66 @@
 #pragma once
 #include <core/engine/module.hpp>
 #include <core/defaults/defaultcomponents.hpp>
+#include <core/defaults/transforminterpolation.hpp>
 #include <core/data/importers/mesh_importers.hpp>
 #include <core/data/importers/image_importers.hpp>
 #include <core/filesystem/provider_registry.hpp>
 #include <core/filesystem/basic_resolver.hpp>
+#include <core/filesystem/pack_resolver.hpp>
 #include <core/defaults/hierarchysystem.hpp>
+#include <core/defaults/animationsystem.hpp>
 #include <core/compute/context.hpp>
 #include <core/scenemanagement/components/scene.hpp>
+#include <core/scenemanagement/components/stream_observer.hpp>
+#include <core/scenemanagement/worldstreamer.hpp>
 #include <core/serialization/serializationUtil.hpp>
 #include <core/serialization/use_embedded_material.hpp>
+#include <core/filesystem/artifact_cache.hpp>
+#include <core/filesystem/hot_reload.hpp>
+#include <core/memory/memory.hpp>
+
+#include <vector>
 
 namespace legion::core
 {
     class CoreModule : public Module
     {
+    private:
+        std::vector<id_type> m_samplers;
+        std::vector<id_type> m_evictionHandlers;
+
+        void registerMemoryTracking()
+        {
+            using memory::MemoryTracker;
+            using memory::memory_tag;
+
+            m_samplers.push_back(MemoryTracker::add_sampler(memory_tag::meshes, []() { return MeshCache::memory_footprint(); }));
+            m_samplers.push_back(MemoryTracker::add_sampler(memory_tag::images, []() { return ImageCache::memory_footprint(); }));
+            m_samplers.push_back(MemoryTracker::add_sampler(memory_tag::animations, []() { return AnimationCache::memory_footprint(); }));
+            m_samplers.push_back(MemoryTracker::add_sampler(memory_tag::artifacts, []() { return filesystem::artifact_cache::get_driver().memory_footprint(); }));
+            m_samplers.push_back(MemoryTracker::add_sampler(memory_tag::components, [registry = m_ecs]() { return registry->memoryFootprint(); }));
+
+            m_evictionHandlers.push_back(MemoryTracker::add_eviction_handler(memory_tag::images, [](size_type bytes) { return ImageCache::evict_colors(bytes); }));
+            m_evictionHandlers.push_back(MemoryTracker::add_eviction_handler(memory_tag::artifacts, [](size_type bytes) { return filesystem::artifact_cache::get_driver().evict(bytes); }));
+        }
+
     public:
+        ~CoreModule()
+        {
+            for (id_type id : m_samplers)
+                memory::MemoryTracker::remove_sampler(id);
+            for (id_type id : m_evictionHandlers)
+                memory::MemoryTracker::remove_eviction_handler(id);
+        }
+
         virtual void setup() override
         {
             OPTICK_EVENT();
             filesystem::provider_registry::domain_create_resolver<filesystem::basic_resolver>("assets://", "./assets");
             filesystem::provider_registry::domain_create_resolver<filesystem::basic_resolver>("engine://", "./engine");
+            filesystem::provider_registry::domain_create_resolver<filesystem::pack_resolver>(".lpk");
+            filesystem::hot_reload::watch_domain("assets://");
+            filesystem::hot_reload::watch_domain("engine://");
 
             filesystem::AssetImporter::reportConverter<obj_mesh_loader>(".obj");
             filesystem::AssetImporter::reportConverter<gltf_binary_mesh_loader>(".glb");
@@ -29,19 +69,34 @@ namespace legion::core
             for (cstring extension : stb_image_loader::extensions)
                 filesystem::AssetImporter::reportConverter<stb_image_loader>(extension);
 
-            log::info("Creating OpenCL");
-            compute::Context::init();
-            log::info("Done creating OpenCL");
+            if (isHeadless())
+            {
+                log::info("Running headless, skipping OpenCL creation");
+            }
+            else
+            {
+                log::info("Creating OpenCL");
+                compute::Context::init();
+                log::info("Done creating OpenCL");
+            }
 
             reportComponentType<position>();
             reportComponentType<rotation>();
             reportComponentType<scale>();
             reportComponentType<velocity>();
+            reportComponentType<previous_transform>();
             reportComponentType<mesh_filter>();
             reportComponentType<use_embedded_material>();
+            reportComponentType<animator>();
+            reportComponentType<joint_palette>();
             reportComponentType<scenemanagement::scene>();
+            reportComponentType<scenemanagement::stream_observer>();
             reportSystem<HierarchySystem>();
+            reportSystem<AnimationSystem>();
             reportSystem<scenemanagement::SceneManager>();
+            reportSystem<scenemanagement::WorldStreamer>();
+
+            registerMemoryTracking();
         }
 
         virtual priority_type priority() override
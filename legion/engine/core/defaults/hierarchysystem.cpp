@@ -62,10 +62,10 @@ void legion::core::HierarchySystem::onPositionBulkModified(events::bulk_componen
     ecs::component_container<position> diffs;
     diffs.resize(count);
 
-    std::vector<byte> hasChildren;
+    memory::frame_vector<byte> hasChildren;
     hasChildren.resize(count);
 
-    std::vector<ecs::entity_set> children;
+    memory::frame_vector<ecs::entity_set> children;
     children.resize(count);
 
     m_scheduler->queueJobs(count, [&]()
@@ -111,10 +111,10 @@ void legion::core::HierarchySystem::onRotationBulkModified(events::bulk_componen
     ecs::component_container<rotation> diffs;
     diffs.resize(count);
 
-    std::vector<byte> hasChildren;
+    memory::frame_vector<byte> hasChildren;
     hasChildren.resize(count);
 
-    std::vector<ecs::entity_set> children;
+    memory::frame_vector<ecs::entity_set> children;
     children.resize(count);
 
     m_scheduler->queueJobs(count, [&]()
@@ -163,10 +163,10 @@ void legion::core::HierarchySystem::onScaleBulkModified(events::bulk_component_m
     ecs::component_container<scale> diffs;
     diffs.resize(count);
 
-    std::vector<byte> hasChildren;
+    memory::frame_vector<byte> hasChildren;
     hasChildren.resize(count);
 
-    std::vector<ecs::entity_set> children;
+    memory::frame_vector<ecs::entity_set> children;
     children.resize(count);
 
     m_scheduler->queueJobs(count, [&]()
@@ -0,0 +1,39 @@
+#include <core/defaults/transforminterpolation.hpp>
+#include <core/profiling/profiler.hpp>
+
+namespace legion::core
+{
+    async::rw_spinlock TransformInterpolation::m_lock;
+    uint64 TransformInterpolation::m_step = 0;
+    uint64 TransformInterpolation::m_stepTime = 0;
+    float TransformInterpolation::m_stepDuration = 0.f;
+
+    uint64 TransformInterpolation::beginStep()
+    {
+        async::readonly_guard guard(m_lock);
+        return m_step + 1;
+    }
+
+    void TransformInterpolation::publishStep(uint64 step, float duration)
+    {
+        async::readwrite_guard guard(m_lock);
+        m_step = step;
+        m_stepTime = profiling::Profiler::now();
+        m_stepDuration = duration;
+    }
+
+    TransformInterpolation::sample TransformInterpolation::now()
+    {
+        async::readonly_guard guard(m_lock);
+        sample result;
+        result.step = m_step;
+
+        if (m_stepDuration > 0.f)
+        {
+            const float elapsed = static_cast<float>(profiling::Profiler::now() - m_stepTime) / 1000000000.f;
+            result.alpha = math::clamp(elapsed / m_stepDuration, 0.f, 1.f);
+        }
+
+        return result;
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <core/platform/platform.hpp>
+#include <core/types/primitives.hpp>
+#include <core/math/math.hpp>
+#include <core/async/rw_spinlock.hpp>
+#include <core/defaults/defaultcomponents.hpp>
+
+/**
+ * @file transforminterpolation.hpp
+ * @brief Lets fixed step simulations run at a low rate while rendering presents smooth motion.
+ *        A simulation keeps the transform of it's previous step in a previous_transform component and publishes every completed step,
+ *        renderers then blend between the previous and current transform by how far the wall clock is into the next step.
+ */
+
+namespace legion::core
+{
+    /**@class previous_transform
+     * @brief Position and rotation of an entity before the last step of the fixed step simulation that moves it.
+     */
+    struct previous_transform
+    {
+        math::vec3 position;
+        math::quat rotation;
+        uint64 step = 0; // Step that moved the entity from this transform to it's current position and rotation.
+    };
+
+    /**@class TransformInterpolation
+     * @brief Static clock of the fixed step simulation used to interpolate transforms for rendering.
+     */
+    class TransformInterpolation
+    {
+    public:
+        /**@class sample
+         * @brief State of the simulation clock at a single moment, sampled once per rendered frame.
+         */
+        struct sample
+        {
+            uint64 step = 0;
+            float alpha = 1.f;
+        };
+
+    private:
+        static async::rw_spinlock m_lock;
+        static uint64 m_step;
+        static uint64 m_stepTime;
+        static float m_stepDuration;
+
+    public:
+        /**@brief Starts a new simulation step, entities moved by it should store their previous transform with the returned step.
+         */
+        static uint64 beginStep();
+
+        /**@brief Marks the step returned by the last beginStep() as completed, renderers start blending towards it's result.
+         * @param duration Simulated time of the step in seconds.
+         */
+        static void publishStep(uint64 step, float duration);
+
+        /**@brief Samples the interpolation alpha, the fraction of the current step that has passed on the wall clock.
+         */
+        L_NODISCARD static sample now();
+
+        /**@brief Computes the transform to render an entity with.
+         *        Entities already moved by a step that isn't published yet are shown at the start of that step,
+         *        entities that weren't moved by the last published step are shown at their current transform.
+         */
+        static void interpolate(const sample& clock, const previous_transform& previous, math::vec3& position, math::quat& rotation)
+        {
+            if (previous.step > clock.step)
+            {
+                position = previous.position;
+                rotation = previous.rotation;
+            }
+            else if (previous.step == clock.step)
+            {
+                position = math::mix(previous.position, position, clock.alpha);
+                rotation = math::slerp(previous.rotation, rotation, clock.alpha);
+            }
+        }
+    };
+}
@@ -6,7 +6,7 @@
 #include <core/ecs/entity_handle.hpp>
 #include <core/platform/platform.hpp>
 
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
 
 /**
  * @file component_handle.hpp
@@ -95,7 +95,7 @@ namespace legion::core::ecs
         L_NODISCARD component_type read() const
         {
             OPTICK_EVENT();
-            component_pool<component_type>* family = m_registry->getFamily<component_type>();
+            const component_pool<component_type>* family = m_registry->getFamily<component_type>(); // Const so that reads don't mark the pool as dirty.
 
             async::readonly_guard rguard(family->get_lock());
 
@@ -17,8 +17,13 @@
 #include <core/serialization/serializationmeta.hpp>
 
 #include <functional>
+#include <unordered_map>
+#include <sstream>
+#include <cstring>
+#include <atomic>
+#include <memory>
 
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
 
 /**
  * @file component_pool.hpp
@@ -30,12 +35,86 @@ namespace legion::core::ecs
 
     using entity_container = std::vector<entity_handle>;
 
+    /**@brief Describes how a component family is stored in a column of a binary scene.
+     * @ref legion::core::ecs::component_pool_base::write_column
+     */
+    enum struct column_layout : uint8
+    {
+        empty = 0,    // Component has no serializable data, only the composition is stored.
+        packed = 1,   // Trivially copyable component stored as a tightly packed array.
+        archived = 2  // Component stored through it's cereal serialize or save/load functions.
+    };
+
+    /**@class entity_remap
+     * @brief Maps the entity ids that were stored in a binary scene to the entities that were created for one instance of it.
+     *        Components that store entity ids can implement `void remap_entities(const entity_remap& remap)` to patch them after loading.
+     * @ref legion::core::ecs::component_pool_base::read_column
+     */
+    struct entity_remap
+    {
+        const std::unordered_map<id_type, uint32>* indices = nullptr; // Stored id to index into the entity table of the scene.
+        const entity_container* entities = nullptr; // Created entities, entity i of instance k lives at k * entityCount + i.
+        size_type entityCount = 0;
+        size_type instance = 0;
+
+        /**@brief Returns the created entity for an id stored in the scene, ids of entities outside of the scene are returned unchanged.
+         */
+        L_NODISCARD id_type operator()(id_type storedId) const
+        {
+            if (!indices || !entities)
+                return storedId;
+
+            auto itr = indices->find(storedId);
+            if (itr == indices->end())
+                return storedId;
+
+            return (*entities)[instance * entityCount + itr->second];
+        }
+
+        L_NODISCARD entity_remap for_instance(size_type index) const
+        {
+            entity_remap remap = *this;
+            remap.instance = index;
+            return remap;
+        }
+    };
+
+    /**@class pool_snapshot
+     * @brief Immutable copy of the contents of a single component pool.
+     * @ref legion::core::ecs::component_pool_base::take_snapshot
+     */
+    struct pool_snapshot
+    {
+        uint64 version = 0;
+        std::vector<id_type> entities;
+        byte_vec data; // Memcopied components for trivially copyable types, archived components for archivable types.
+        std::shared_ptr<void> values; // Copies of the components for types that are neither.
+    };
+
     /**@class component_pool_base
      * @brief Base class of legion::core::ecs::component_pool
      */
     class component_pool_base
     {
+    protected:
+        std::atomic_bool m_dirty{ true };
+        std::atomic<uint64> m_version{ 0 };
+
     public:
+        /**@brief Generates a new unique content version for snapshots.
+         */
+        static uint64 next_snapshot_version() noexcept
+        {
+            static std::atomic<uint64> nextVersion{ 1 };
+            return nextVersion.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        /**@brief Marks the contents of this pool as changed since the last snapshot.
+         * @note Needs to be called while holding the pool lock, snapshots lock the pool exclusively.
+         */
+        void mark_dirty() noexcept { m_dirty.store(true, std::memory_order_relaxed); }
+
+
         virtual component_container_base* get_components(const entity_container& entities) const LEGION_PURE;
         virtual void get_components(const entity_container& entities, component_container_base& comps) const LEGION_PURE;
         virtual void set_components(const entity_container& entities, const component_container_base& comps) LEGION_PURE;
@@ -53,6 +132,56 @@ namespace legion::core::ecs
         virtual void serialize(cereal::JSONInputArchive& oarchive, id_type entityId) LEGION_PURE;
         virtual void serialize(cereal::BinaryInputArchive& oarchive, id_type entityId) LEGION_PURE;
 
+        /**@brief Returns how this component family gets stored in a binary column.
+         */
+        L_NODISCARD virtual column_layout get_column_layout() const LEGION_PURE;
+
+        /**@brief Returns the size of a single component in a packed column.
+         */
+        L_NODISCARD virtual size_type get_component_size() const LEGION_PURE;
+
+        /**@brief Appends the components of all given entities to a binary column.
+         * @param entities Entities to write the components of, all of them need to have the component.
+         * @param data Buffer to append the column data to.
+         */
+        virtual void write_column(const entity_container& entities, byte_vec& data) LEGION_PURE;
+
+        /**@brief Creates the components of all given entities from a binary column under a single lock.
+         * @note Does NOT call component_type::init and does NOT raise any events, use raise_creation_events afterwards.
+         * @param entities Entities to create the components for, in the same order as they were written and repeated for every instance.
+         * @param data Start of the column data.
+         * @param size Size of the column data in bytes.
+         * @param instances Amount of times the column gets instantiated, the column is only decoded once.
+         * @param remap Mapping of stored entity ids to the created entities, passed to component_type::remap_entities if the component has it.
+         * @returns bool True if the column could be read, false if the data didn't match the component layout.
+         */
+        virtual bool read_column(const entity_container& entities, const byte* data, size_type size, size_type instances, const entity_remap& remap = {}) LEGION_PURE;
+
+        /**@brief Copies the entire pool, memcopies trivially copyable components and archives other serializable components.
+         * @param base Previous snapshot of this pool, gets returned instead of a new copy if the pool didn't change since.
+         * @returns std::shared_ptr<const pool_snapshot> Snapshot of the current contents of the pool.
+         */
+        virtual std::shared_ptr<const pool_snapshot> take_snapshot(const std::shared_ptr<const pool_snapshot>& base) LEGION_PURE;
+
+        /**@brief Replaces the contents of the pool with the contents of a snapshot.
+         * @note Does NOT raise any events and skips the copy entirely if the pool didn't change since the snapshot was taken.
+         * @returns bool False if the snapshot data didn't match the component layout, the pool will be empty in that case.
+         */
+        virtual bool restore_snapshot(const pool_snapshot& snapshot) LEGION_PURE;
+
+        /**@brief Removes all components from the pool without raising any events.
+         */
+        virtual void clear_components() LEGION_PURE;
+
+        /**@brief Raises a single bulk creation event for a set of bulk created components.
+         * @note Also raises the per entity creation events if any callbacks are bound to them.
+         */
+        virtual void raise_creation_events(const entity_container& entities) LEGION_PURE;
+
+        /**@brief Returns the amount of bytes reserved by the pool.
+         */
+        L_NODISCARD virtual size_type memory_footprint() const LEGION_PURE;
+
         virtual ~component_pool_base() = default;
     };
 
@@ -70,6 +199,11 @@ namespace legion::core::ecs
         events::EventBus* m_eventBus;
         EcsRegistry* m_registry;
         component_type m_nullComp;
+
+        static constexpr bool m_archivable = serialization::has_serialize<component_type, void(cereal::BinaryOutputArchive&)>::value ||
+                                             serialization::has_save<component_type, void(cereal::BinaryOutputArchive&)>::value;
+        static constexpr bool m_packable = !m_archivable && std::is_trivially_copyable_v<component_type>;
+        static constexpr bool m_remappable = serialization::has_remap_entities<component_type, void(const entity_remap&)>::value;
     public:
         component_pool() = default;
         component_pool(EcsRegistry* registry, events::EventBus* eventBus) : m_eventBus(eventBus), m_registry(registry) {}
@@ -141,12 +275,14 @@ namespace legion::core::ecs
                 async::readonly_guard guard(m_lock);
                 iarchive(cereal::make_nvp("Component Name", componentType));
                 m_components[entityId].serialize(iarchive);
+                mark_dirty();
             }
             else if constexpr (serialization::has_load<component_type, void(cereal::JSONInputArchive&)>::value)
             {
                 async::readonly_guard guard(m_lock);
                 iarchive(cereal::make_nvp("Component Name", componentType));
                 m_components[entityId].load(iarchive);
+                mark_dirty();
             }
             else
             {
@@ -168,12 +304,14 @@ namespace legion::core::ecs
                 async::readonly_guard guard(m_lock);
                 iarchive(cereal::make_nvp("Component Name", componentType));
                 m_components[entityId].serialize(iarchive);
+                mark_dirty();
             }
             else if constexpr (serialization::has_load<component_type, void(cereal::BinaryInputArchive&)>::value)
             {
                 async::readonly_guard guard(m_lock);
                 iarchive(cereal::make_nvp("Component Name", componentType));
                 m_components[entityId].load(iarchive);
+                mark_dirty();
             }
             else
             {
@@ -181,6 +319,282 @@ namespace legion::core::ecs
             }
         }
 
+        L_NODISCARD column_layout get_column_layout() const override
+        {
+            if constexpr (m_archivable)
+                return column_layout::archived;
+            else if constexpr (m_packable)
+                return column_layout::packed;
+            else
+                return column_layout::empty;
+        }
+
+        L_NODISCARD size_type get_component_size() const override
+        {
+            return sizeof(component_type);
+        }
+
+        void write_column(const entity_container& entities, byte_vec& data) override
+        {
+            OPTICK_EVENT();
+            async::readonly_guard guard(m_lock);
+
+            if constexpr (m_archivable)
+            {
+                std::ostringstream stream(std::ios::binary);
+                {
+                    cereal::BinaryOutputArchive oarchive(stream);
+                    for (auto& entity : entities)
+                    {
+                        if constexpr (serialization::has_serialize<component_type, void(cereal::BinaryOutputArchive&)>::value)
+                            m_components.at(entity).serialize(oarchive);
+                        else
+                            m_components.at(entity).save(oarchive);
+                    }
+                }
+
+                std::string buffer = stream.str();
+                data.insert(data.end(), buffer.begin(), buffer.end());
+            }
+            else if constexpr (m_packable)
+            {
+                size_type offset = data.size();
+                data.resize(offset + entities.size() * sizeof(component_type));
+                for (auto& entity : entities)
+                {
+                    std::memcpy(data.data() + offset, &m_components.at(entity), sizeof(component_type));
+                    offset += sizeof(component_type);
+                }
+            }
+        }
+
+        bool read_column(const entity_container& entities, const byte* data, size_type size, size_type instances, const entity_remap& remap = {}) override
+        {
+            OPTICK_EVENT();
+            if (!instances || entities.size() % instances)
+                return false;
+
+            const size_type count = entities.size() / instances;
+
+            if constexpr (m_archivable)
+            {
+                std::istringstream stream(std::string(reinterpret_cast<const char*>(data), size), std::ios::binary);
+                cereal::BinaryInputArchive iarchive(stream);
+
+                // Decode a single instance outside of the lock, the other instances are copies.
+                component_container<component_type> decoded(count);
+                try
+                {
+                    for (auto& comp : decoded)
+                    {
+                        if constexpr (serialization::has_serialize<component_type, void(cereal::BinaryInputArchive&)>::value)
+                            comp.serialize(iarchive);
+                        else
+                            comp.load(iarchive);
+                    }
+                }
+                catch (const cereal::Exception&)
+                {
+                    return false;
+                }
+
+                async::readwrite_guard guard(m_lock);
+                m_components.reserve(m_components.size() + entities.size());
+                for (size_type i = 0; i < entities.size(); i++)
+                {
+                    component_type& comp = m_components[entities[i]];
+                    comp = decoded[i % count];
+                    if constexpr (m_remappable)
+                        comp.remap_entities(remap.for_instance(i / count));
+                }
+                mark_dirty();
+                return true;
+            }
+            else if constexpr (m_packable)
+            {
+                if (size != count * sizeof(component_type))
+                    return false;
+
+                async::readwrite_guard guard(m_lock);
+                m_components.reserve(m_components.size() + entities.size());
+                for (size_type i = 0; i < entities.size(); i++)
+                {
+                    component_type comp;
+                    std::memcpy(&comp, data + (i % count) * sizeof(component_type), sizeof(component_type));
+                    if constexpr (m_remappable)
+                        comp.remap_entities(remap.for_instance(i / count));
+                    m_components.insert(entities[i], comp);
+                }
+                mark_dirty();
+                return true;
+            }
+            else
+            {
+                async::readwrite_guard guard(m_lock);
+                m_components.reserve(m_components.size() + entities.size());
+                for (auto& entity : entities)
+                    m_components.emplace(entity);
+                mark_dirty();
+                return true;
+            }
+        }
+
+        /**@brief Creates the components of all given entities with the given values under a single lock.
+         * @note Does NOT call component_type::init and does NOT raise any events, use raise_creation_events afterwards.
+         * @param entities Entities to create the components for.
+         * @param values Starting values of the components, needs to be the same size as entities.
+         */
+        void insert_components(const entity_container& entities, const component_container<component_type>& values)
+        {
+            OPTICK_EVENT();
+            async::readwrite_guard guard(m_lock);
+            mark_dirty();
+            m_components.reserve(m_components.size() + entities.size());
+            for (size_type i = 0; i < entities.size(); i++)
+                m_components[entities[i]] = values[i];
+        }
+
+        std::shared_ptr<const pool_snapshot> take_snapshot(const std::shared_ptr<const pool_snapshot>& base) override
+        {
+            OPTICK_EVENT();
+            // Writers only take the lock read-only and mark the pool dirty before writing, take the snapshot
+            // exclusively so writes in flight land before the dirty flag gets cleared.
+            async::readwrite_guard guard(m_lock);
+
+            if (m_dirty.exchange(false, std::memory_order_acq_rel) || !m_version.load(std::memory_order_relaxed))
+                m_version.store(next_snapshot_version(), std::memory_order_relaxed);
+
+            const uint64 version = m_version.load(std::memory_order_relaxed);
+            if (base && base->version == version)
+                return base; // Nothing changed since the base snapshot, share it.
+
+            auto snapshot = std::make_shared<pool_snapshot>();
+            snapshot->version = version;
+
+            const size_type count = m_components.size();
+            auto& keys = m_components.keys();
+            auto& values = m_components.values();
+            snapshot->entities.assign(keys.begin(), keys.begin() + count);
+
+            if constexpr (std::is_trivially_copyable_v<component_type>)
+            {
+                snapshot->data.resize(count * sizeof(component_type));
+                if (count)
+                    std::memcpy(snapshot->data.data(), values.data(), count * sizeof(component_type));
+            }
+            else if constexpr (m_archivable)
+            {
+                std::ostringstream stream(std::ios::binary);
+                {
+                    cereal::BinaryOutputArchive oarchive(stream);
+                    for (size_type i = 0; i < count; i++)
+                    {
+                        if constexpr (serialization::has_serialize<component_type, void(cereal::BinaryOutputArchive&)>::value)
+                            values[i].serialize(oarchive);
+                        else
+                            values[i].save(oarchive);
+                    }
+                }
+
+                std::string buffer = stream.str();
+                snapshot->data.assign(buffer.begin(), buffer.end());
+            }
+            else
+            {
+                snapshot->values = std::make_shared<component_container<component_type>>(values.begin(), values.begin() + count);
+            }
+
+            return snapshot;
+        }
+
+        bool restore_snapshot(const pool_snapshot& snapshot) override
+        {
+            OPTICK_EVENT();
+            async::readwrite_guard guard(m_lock);
+
+            if (!m_dirty.load(std::memory_order_acquire) && m_version.load(std::memory_order_relaxed) == snapshot.version)
+                return true; // Pool hasn't changed since the snapshot was taken.
+
+            const size_type count = snapshot.entities.size();
+            m_components.clear();
+            m_components.reserve(count);
+
+            bool valid = true;
+            if constexpr (std::is_trivially_copyable_v<component_type>)
+            {
+                valid = snapshot.data.size() == count * sizeof(component_type);
+                for (size_type i = 0; valid && i < count; i++)
+                {
+                    component_type comp;
+                    std::memcpy(&comp, snapshot.data.data() + i * sizeof(component_type), sizeof(component_type));
+                    m_components.insert(snapshot.entities[i], comp);
+                }
+            }
+            else if constexpr (m_archivable)
+            {
+                std::istringstream stream(std::string(reinterpret_cast<const char*>(snapshot.data.data()), snapshot.data.size()), std::ios::binary);
+                cereal::BinaryInputArchive iarchive(stream);
+                try
+                {
+                    for (size_type i = 0; i < count; i++)
+                    {
+                        component_type& comp = m_components[snapshot.entities[i]];
+                        comp = component_type();
+                        if constexpr (serialization::has_serialize<component_type, void(cereal::BinaryInputArchive&)>::value)
+                            comp.serialize(iarchive);
+                        else
+                            comp.load(iarchive);
+                    }
+                }
+                catch (const cereal::Exception&)
+                {
+                    m_components.clear();
+                    valid = false;
+                }
+            }
+            else
+            {
+                valid = static_cast<bool>(snapshot.values);
+                if (valid)
+                {
+                    auto& values = *static_cast<const component_container<component_type>*>(snapshot.values.get());
+                    for (size_type i = 0; i < count; i++)
+                        m_components.insert(snapshot.entities[i], values[i]);
+                }
+            }
+
+            if (valid)
+            {
+                m_version.store(snapshot.version, std::memory_order_relaxed);
+                m_dirty.store(false, std::memory_order_release);
+            }
+            else
+                m_dirty.store(true, std::memory_order_release);
+
+            return valid;
+        }
+
+        void clear_components() override
+        {
+            OPTICK_EVENT();
+            async::readwrite_guard guard(m_lock);
+            m_components.clear();
+            m_dirty.store(true, std::memory_order_release);
+        }
+
+        void raise_creation_events(const entity_container& entities) override
+        {
+            OPTICK_EVENT();
+            if (entities.empty())
+                return;
+
+            m_eventBus->raiseEvent<events::bulk_component_creation<component_type>>(entities);
+
+            if (m_eventBus->hasCallbacks<events::component_creation<component_type>>())
+                for (auto& entity : entities)
+                    m_eventBus->raiseEvent<events::component_creation<component_type>>(entity);
+        }
+
         /**@brief Get the rw_spinlock of this container.
          */
         async::rw_spinlock& get_lock() const noexcept
@@ -259,6 +673,7 @@ namespace legion::core::ecs
                         ref = container[i];
                     }
                 }
+                mark_dirty();
             }
 
             m_eventBus->raiseEvent<events::bulk_component_modification<component_type>>(entities, modifications, container);
@@ -282,6 +697,7 @@ namespace legion::core::ecs
         L_NODISCARD component_type& get_component(id_type entityId)
         {
             OPTICK_EVENT();
+            mark_dirty();
             if (m_components.contains(entityId))
                 return m_components.at(entityId);
             return m_nullComp;
@@ -311,6 +727,7 @@ namespace legion::core::ecs
             {
                 async::readwrite_guard guard(m_lock);
                 m_components.emplace(entityId);
+                mark_dirty();
             }
 
             if constexpr (detail::has_init<component_type, void(component_type&, entity_handle)>::value)
@@ -339,6 +756,7 @@ namespace legion::core::ecs
             {
                 async::readwrite_guard guard(m_lock);
                 m_components[entityId] = *reinterpret_cast<component_type*>(value);
+                mark_dirty();
             }
 
             if constexpr (detail::has_init<component_type, void(component_type&, entity_handle)>::value)
@@ -374,6 +792,16 @@ namespace legion::core::ecs
 
             async::readwrite_guard wguard(m_lock);
             m_components.erase(entityId);
+            mark_dirty();
+        }
+
+        L_NODISCARD size_type memory_footprint() const override
+        {
+            async::readonly_guard guard(m_lock);
+            return sizeof(*this) +
+                m_components.values().capacity() * sizeof(component_type) +
+                m_components.keys().capacity() * sizeof(id_type) +
+                m_components.size() * (sizeof(id_type) + sizeof(size_type) + 2 * sizeof(void*)); // Approximate sparse map node size.
         }
 
         /**
@@ -388,6 +816,7 @@ namespace legion::core::ecs
             {
                 async::readwrite_guard guard(m_lock);
                 m_components[dst] = m_components[src];
+                mark_dirty();
             }
 
             m_eventBus->raiseEvent<events::component_creation<component_type>>(entity_handle(dst));
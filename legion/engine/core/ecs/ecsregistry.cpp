@@ -4,6 +4,7 @@
 #include <core/ecs/component_handle.hpp>
 #include <core/defaults/defaultcomponents.hpp>
 #include <core/events/eventbus.hpp>
+#include <core/logging/logging.hpp>
 
 namespace legion::core::ecs
 {
@@ -61,6 +62,18 @@ namespace legion::core::ecs
         world.add_component<hierarchy>();
     }
 
+    size_type EcsRegistry::memoryFootprint() const
+    {
+        OPTICK_EVENT();
+        size_type footprint = 0;
+
+        async::readonly_guard guard(m_familyLock);
+        for (auto& [id, family] : m_families)
+            footprint += family->memory_footprint();
+
+        return footprint;
+    }
+
     component_pool_base* EcsRegistry::getFamily(id_type componentTypeId)
     {
         OPTICK_EVENT();
@@ -76,6 +89,13 @@ namespace legion::core::ecs
         return m_families.at(componentTypeId).get();
     }
 
+    bool EcsRegistry::hasFamily(id_type componentTypeId) const
+    {
+        OPTICK_EVENT();
+        async::readonly_guard guard(m_familyLock);
+        return m_families.count(componentTypeId);
+    }
+
     bool EcsRegistry::hasComponent(id_type entityId, id_type componentTypeId)
     {
         OPTICK_EVENT();
@@ -92,6 +112,7 @@ namespace legion::core::ecs
     component_handle_base EcsRegistry::createComponent(id_type entityId, id_type componentTypeId)
     {
         OPTICK_EVENT();
+        m_structureDirty.store(true, std::memory_order_relaxed);
 #ifdef LGN_SAFE_MODE
         if (!validateEntity(entityId))
             return component_handle_base();
@@ -114,6 +135,7 @@ namespace legion::core::ecs
     component_handle_base EcsRegistry::copyComponent(id_type destinationEntity, id_type sourceEntity, id_type componentTypeId)
     {
         OPTICK_EVENT();
+        m_structureDirty.store(true, std::memory_order_relaxed);
 #ifdef LGN_SAFE_MODE
         if (!validateEntity(sourceEntity) || !validateEntity(destinationEntity))
             return component_handle_base();
@@ -134,6 +156,7 @@ namespace legion::core::ecs
     component_handle_base EcsRegistry::createComponent(id_type entityId, id_type componentTypeId, void* value)
     {
         OPTICK_EVENT();
+        m_structureDirty.store(true, std::memory_order_relaxed);
 #ifdef LGN_SAFE_MODE
         if (!validateEntity(entityId))
             return component_handle_base();
@@ -154,6 +177,7 @@ namespace legion::core::ecs
     void EcsRegistry::destroyComponent(id_type entityId, id_type componentTypeId)
     {
         OPTICK_EVENT();
+        m_structureDirty.store(true, std::memory_order_relaxed);
 #ifdef LGN_SAFE_MODE
         if (!validateEntity(entityId))
             return;
@@ -180,6 +204,7 @@ namespace legion::core::ecs
     entity_handle EcsRegistry::createEntity(bool worldChild, id_type entityId)
     {
         OPTICK_EVENT();
+        m_structureDirty.store(true, std::memory_order_relaxed);
         id_type id;
         if (!entityId)
             id = m_nextEntityId++;
@@ -219,11 +244,64 @@ namespace legion::core::ecs
         return createEntity(worldChild,entityId);
     }
 
+    entity_container EcsRegistry::createEntities(size_type count, bool worldChild)
+    {
+        OPTICK_EVENT();
+        m_structureDirty.store(true, std::memory_order_relaxed);
+        entity_container entities;
+        entities.reserve(count);
+
+        {
+            async::readwrite_multiguard guard(m_entityLock, m_entityDataLock);
+            m_entityData.reserve(m_entityData.size() + count);
+            m_entities.reserve(m_entities.size() + count);
+
+            for (size_type i = 0; i < count; i++)
+            {
+                id_type id = m_nextEntityId++;
+                while (m_entities.contains(id)) // Skip any ids that were claimed manually.
+                    id = m_nextEntityId++;
+
+                m_entityData.emplace(id, entity_data());
+                m_entities.emplace(id);
+                entities.emplace_back(id);
+            }
+        }
+
+        if (worldChild)
+        {
+            component_pool<hierarchy>* family = getFamily<hierarchy>();
+            async::readonly_guard rguard(family->get_lock());
+            auto& worldChildren = family->get_component(world_entity_id).children;
+            worldChildren.reserve(worldChildren.size() + count);
+            for (auto& entity : entities)
+                worldChildren.insert(entity);
+        }
+
+        return entities;
+    }
+
+    void EcsRegistry::registerComponents(id_type componentTypeId, const entity_container& entities)
+    {
+        OPTICK_EVENT();
+        m_structureDirty.store(true, std::memory_order_relaxed);
+        async::readonly_guard guard(m_entityDataLock);
+        for (auto& entity : entities)
+            m_entityData[entity].components.insert(componentTypeId); // Is fine because the lock only locks order changes in the container, not the values themselves.
+    }
+
+    void EcsRegistry::updateQueries(const entity_container& entities)
+    {
+        OPTICK_EVENT();
+        m_queryRegistry.evaluateEntities(entities);
+    }
+
 
 
     void EcsRegistry::destroyEntity(id_type entityId, bool recurse)
     {
         OPTICK_EVENT();
+        m_structureDirty.store(true, std::memory_order_relaxed);
 #ifdef LGN_SAFE_MODE
         if (!validateEntity(entityId))
             return;
@@ -298,6 +376,7 @@ namespace legion::core::ecs
     void EcsRegistry::setEntityData(id_type entityId, const entity_data& data)
     {
         OPTICK_EVENT();
+        m_structureDirty.store(true, std::memory_order_relaxed);
 #ifdef LGN_SAFE_MODE
         if (!validateEntity(entityId))
             return;
@@ -307,6 +386,85 @@ namespace legion::core::ecs
         m_entityData[entityId] = data;
     }
 
+    world_snapshot EcsRegistry::takeSnapshot(const world_snapshot* base)
+    {
+        OPTICK_EVENT();
+        world_snapshot snapshot;
+
+        {
+            async::readonly_guard guard(m_familyLock);
+            snapshot.pools.reserve(m_families.size());
+            for (auto& [typeId, family] : m_families)
+            {
+                std::shared_ptr<const pool_snapshot> basePool;
+                if (base)
+                    if (auto itr = base->pools.find(typeId); itr != base->pools.end())
+                        basePool = itr->second;
+
+                snapshot.pools.emplace(typeId, family->take_snapshot(basePool));
+            }
+        }
+
+        async::readonly_multiguard guard(m_entityLock, m_entityDataLock);
+        if (m_structureDirty.exchange(false, std::memory_order_acq_rel) || !m_structureVersion.load(std::memory_order_relaxed))
+            m_structureVersion.store(component_pool_base::next_snapshot_version(), std::memory_order_relaxed);
+
+        const uint64 version = m_structureVersion.load(std::memory_order_relaxed);
+        if (base && base->registry && base->registry->version == version)
+        {
+            snapshot.registry = base->registry; // No entities or compositions changed since the base snapshot.
+            return snapshot;
+        }
+
+        auto registry = std::make_shared<registry_snapshot>();
+        registry->version = version;
+        registry->nextEntityId = m_nextEntityId;
+        registry->entities = m_entities;
+        registry->entityData = m_entityData;
+        registry->entityNames = m_entityNames;
+        registry->queryLists = m_queryRegistry.captureEntityLists();
+        snapshot.registry = std::move(registry);
+        return snapshot;
+    }
+
+    void EcsRegistry::restoreSnapshot(const world_snapshot& snapshot)
+    {
+        OPTICK_EVENT();
+
+        {
+            async::readonly_guard guard(m_familyLock);
+            for (auto& [typeId, family] : m_families)
+            {
+                auto itr = snapshot.pools.find(typeId);
+                if (itr == snapshot.pools.end())
+                    family->clear_components(); // Component type was reported after the snapshot was taken.
+                else if (!family->restore_snapshot(*itr->second))
+                    log::error("Failed to restore component type {} from snapshot.", m_componentNames[typeId]);
+            }
+        }
+
+        if (!snapshot.registry)
+            return;
+
+        const registry_snapshot& registry = *snapshot.registry;
+        if (!m_structureDirty.load(std::memory_order_acquire) && m_structureVersion.load(std::memory_order_relaxed) == registry.version)
+            return; // No entities or compositions changed since the snapshot was taken.
+
+        entity_container entities;
+        {
+            async::readwrite_multiguard guard(m_entityLock, m_entityDataLock);
+            m_nextEntityId = registry.nextEntityId;
+            m_entities = registry.entities;
+            m_entityData = registry.entityData;
+            m_entityNames = registry.entityNames;
+            m_structureVersion.store(registry.version, std::memory_order_relaxed);
+            m_structureDirty.store(false, std::memory_order_release);
+            entities.assign(m_entities.begin(), m_entities.end());
+        }
+
+        m_queryRegistry.restoreEntityLists(registry.queryLists, entities);
+    }
+
     L_NODISCARD entity_handle EcsRegistry::getEntityParent(id_type entityId)
     {
         OPTICK_EVENT();
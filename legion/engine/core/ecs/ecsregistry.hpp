@@ -35,6 +35,30 @@ namespace legion::core::ecs
         hashed_sparse_set<id_type> components;
     };
 
+    /**@class registry_snapshot
+     * @brief Immutable copy of the entity bookkeeping of the registry and the tracking lists of all queries.
+     */
+    struct registry_snapshot
+    {
+        uint64 version = 0;
+        id_type nextEntityId = 0;
+        entity_set entities;
+        std::unordered_map<id_type, entity_data> entityData;
+        sparse_map<id_type, std::string> entityNames;
+        std::unordered_map<id_type, entity_set> queryLists;
+    };
+
+    /**@class world_snapshot
+     * @brief Snapshot of the entire ECS state.
+     *        Snapshots are copy-on-write, parts that didn't change since the base snapshot are shared instead of copied.
+     * @ref legion::core::ecs::EcsRegistry::takeSnapshot
+     */
+    struct world_snapshot
+    {
+        std::shared_ptr<const registry_snapshot> registry;
+        std::unordered_map<id_type, std::shared_ptr<const pool_snapshot>> pools;
+    };
+
     /**@class EcsRegistry
      * @brief Manager and owner of all ECS related objects.
      */
@@ -56,6 +80,9 @@ namespace legion::core::ecs
         sparse_map<id_type, std::string> m_entityNames;
 
         QueryRegistry m_queryRegistry;
+
+        std::atomic_bool m_structureDirty{ true };
+        std::atomic<uint64> m_structureVersion{ 0 };
         events::EventBus* m_eventBus;
 
         /**@brief Internal function for recursively destroying all children and children of children etc.
@@ -127,6 +154,16 @@ namespace legion::core::ecs
          */
         L_NODISCARD component_pool_base* getFamily(id_type componentTypeId);
 
+        /**@brief Check if a component type has been reported to the registry.
+         * @param componentTypeId Type id of the component to check for.
+         */
+        L_NODISCARD bool hasFamily(id_type componentTypeId) const;
+
+        /**@brief Get the amount of bytes reserved by all component pools.
+         * @note Registered as the sampler of memory::memory_tag::components by the CoreModule.
+         */
+        L_NODISCARD size_type memoryFootprint() const;
+
         /**@brief Check if an entity has a certain component.
          * @param entityId Id of the entity.
          * @param componentTypeId Type id of component to check for.
@@ -330,6 +367,27 @@ namespace legion::core::ecs
 
         L_NODISCARD entity_handle createEntity(id_type entityId, bool worldChild = true);
 
+        /**@brief Create a batch of new entities under a single lock.
+         * @param count Amount of entities to create.
+         * @param worldChild Whether the new entities should be added as children of the world.
+         * @returns entity_container Handles to all the newly created entities.
+         * @note Entities won't have a hierarchy component, use insertComponents on the hierarchy family in order to add it in bulk.
+         */
+        L_NODISCARD entity_container createEntities(size_type count, bool worldChild = true);
+
+        /**@brief Registers the components of a bulk insertion with the entities and queries.
+         * @param componentTypeId Type id of the component that was inserted.
+         * @param entities Entities that received the component.
+         * @note Needs to be called after component_pool_base::read_column or component_pool::insert_components.
+         * @note Doesn't update any queries, call updateQueries after all component types have been registered.
+         */
+        void registerComponents(id_type componentTypeId, const entity_container& entities);
+
+        /**@brief Re-evaluates all queries for a batch of entities in one go.
+         * @param entities Entities that had their component composition changed.
+         */
+        void updateQueries(const entity_container& entities);
+
         /**@brief Destroys entity and all of its components.
          * @param entityId Id of entity you wish to destroy.
          * @param recurse Do you wish to destroy all children and children of children etc as well? True by default.
@@ -343,6 +401,20 @@ namespace legion::core::ecs
          */
         L_NODISCARD entity_handle getEntity(id_type entityId);
 
+        /**@brief Captures the entire ECS state: all component pools, the entity data and the query tracking lists.
+         * @param base Previous snapshot to build on, pools and entity data that didn't change since are shared instead of copied.
+         * @returns world_snapshot Snapshot that can be restored using restoreSnapshot.
+         * @note Trivially copyable components are memcopied, other components are archived or copied.
+         */
+        L_NODISCARD world_snapshot takeSnapshot(const world_snapshot* base = nullptr);
+
+        /**@brief Restores the entire ECS state in place.
+         * @param snapshot Snapshot to restore.
+         * @note Does NOT raise any creation or destruction events, pools that didn't change since the snapshot was taken aren't touched.
+         * @note Component types that were reported after the snapshot was taken get emptied.
+         */
+        void restoreSnapshot(const world_snapshot& snapshot);
+
         /**@brief Get entity data for a certain entity id.
          * @param entityId Id of entity you want the data from.
          * @returns entity_data& Hierarchy and composition data of the entity requested.
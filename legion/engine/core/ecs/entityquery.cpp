@@ -4,7 +4,7 @@
 #include <core/ecs/entity_handle.hpp>
 #include <core/containers/hashed_sparse_set.hpp>
 
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
 
 namespace legion::core::ecs
 {
@@ -128,6 +128,35 @@ namespace legion::core::ecs
         }
     }
 
+    void QueryRegistry::evaluateEntities(const entity_container& entities)
+    {
+        OPTICK_EVENT();
+        async::mixed_multiguard mmguard(m_entityLock, async::lock_state_write, m_componentLock, async::lock_state_read);
+
+        for (int i = 0; i < m_entityLists.size(); i++)
+        {
+            id_type queryId = m_entityLists.keys()[i];
+            auto& componentTypes = m_componentTypes[queryId];
+            auto& [lastModified, entityList] = m_entityLists.at(queryId);
+
+            bool modified = false;
+            for (auto& entity : entities)
+            {
+                if (entityList.contains(entity))
+                    continue;
+
+                if (m_registry.getEntityData(entity).components.contains(componentTypes))
+                {
+                    entityList.insert(entity);
+                    modified = true;
+                }
+            }
+
+            if (modified)
+                lastModified = m_clock.elapsedTime();
+        }
+    }
+
     void QueryRegistry::markEntityDestruction(id_type entityId)
     {
         OPTICK_EVENT();
@@ -146,6 +175,47 @@ namespace legion::core::ecs
         }
     }
 
+    std::unordered_map<id_type, entity_set> QueryRegistry::captureEntityLists() const
+    {
+        OPTICK_EVENT();
+        async::readonly_guard guard(m_entityLock);
+
+        std::unordered_map<id_type, entity_set> lists;
+        for (int i = 0; i < m_entityLists.size(); i++)
+        {
+            id_type queryId = m_entityLists.keys()[i];
+            lists.emplace(queryId, m_entityLists.at(queryId).second);
+        }
+        return lists;
+    }
+
+    void QueryRegistry::restoreEntityLists(const std::unordered_map<id_type, entity_set>& lists, const entity_container& entities)
+    {
+        OPTICK_EVENT();
+        async::mixed_multiguard mmguard(m_entityLock, async::lock_state_write, m_componentLock, async::lock_state_read);
+
+        float now = m_clock.elapsedTime();
+        for (int i = 0; i < m_entityLists.size(); i++)
+        {
+            id_type queryId = m_entityLists.keys()[i];
+            auto& [lastModified, entityList] = m_entityLists.at(queryId);
+            lastModified = now; // Force all queries to refetch their entities.
+
+            if (auto itr = lists.find(queryId); itr != lists.end())
+            {
+                entityList = itr->second;
+                continue;
+            }
+
+            // Query was created after the lists were captured.
+            auto& componentTypes = m_componentTypes[queryId];
+            entityList.clear();
+            for (auto& entity : entities)
+                if (m_registry.getEntityData(entity).components.contains(componentTypes))
+                    entityList.insert(entity);
+        }
+    }
+
     id_type QueryRegistry::getQueryId(const hashed_sparse_set<id_type>& componentTypes)
     {
         OPTICK_EVENT();
@@ -90,11 +90,27 @@ namespace legion::core::ecs
          */
         void evaluateEntityChange(id_type entityId, id_type componentTypeId, bool removal);
 
+        /**@brief Re-evaluate a batch of entities against all queries while only locking once.
+         * @param entities Entities that had their component composition changed.
+         * @note Only adds entities to queries, use evaluateEntityChange for removals.
+         */
+        void evaluateEntities(const entity_container& entities);
+
         /**@brief Mark an entity destruction. (removes entity from all queries.
          * @param entityId Id of the entity in question.
          */
         void markEntityDestruction(id_type entityId);
 
+        /**@brief Copies the tracking lists of all queries.
+         */
+        L_NODISCARD std::unordered_map<id_type, entity_set> captureEntityLists() const;
+
+        /**@brief Replaces the tracking lists of all queries.
+         * @param lists Tracking lists to restore, captured with captureEntityLists.
+         * @param entities All entities, queries that don't have a tracking list in lists get re-evaluated against these.
+         */
+        void restoreEntityLists(const std::unordered_map<id_type, entity_set>& lists, const entity_container& entities);
+
         /**@brief Get query id of a query that requests a certain component combination.
          * @param componentTypes Sparse map containing all component type ids that would need to be queried.
          * @return id_type Id of the matching query or invalid_id if none was found.
@@ -10,10 +10,17 @@
 #include <core/logging/logging.hpp>
 #include <core/ecs/component_handle.hpp>
 #include <core/scenemanagement/scenemanager.hpp>
+#include <core/scenemanagement/prefab.hpp>
+#include <core/profiling/profiler.hpp>
+#include <core/filesystem/hot_reload.hpp>
+#include <core/filesystem/assetimporter.hpp>
 
 #include <map>
 #include <vector>
 #include <memory>
+#include <optional>
+#include <string_view>
+#include <cstdlib>
 
 /**
  * @file engine.hpp
@@ -34,6 +41,7 @@ namespace legion::core
     {
     private:
         std::vector<char*> m_cliargs;
+        bool m_headless;
         std::map<priority_type, std::vector<std::unique_ptr<Module>>, std::greater<>> m_modules;
 
         events::EventBus m_eventbus;
@@ -44,14 +52,47 @@ namespace legion::core
 
         inline static events::EventBus* eventbus;
 
-        Engine(int argc, char** argv) : m_modules(), m_eventbus(), m_ecs(&m_eventbus), m_cliargs(argv, argv + argc),
+        /**@brief Creates the engine and parses the engine command line options.
+         *        --headless        Run without a window, graphics context or audio device. Implied by LEGION_HEADLESS.
+         *        --tickrate=<hz>   Run all process-chains at a fixed tick rate.
+         *        --ticks=<n>       Exit after the main loop ran n ticks.
+         *        --threads=<n>     Limit the amount of threads the scheduler creates.
+         *        --deterministic   Drive all fixed interval processes from a shared simulation tick on the main thread, see Scheduler::setDeterministic().
+         *        --hot-reload      Watch the asset directories and reload changed assets while running, see filesystem::hot_reload.
+         */
+        Engine(int argc, char** argv) : m_cliargs(argv, argv + argc),
+#if defined(LEGION_HEADLESS)
+            m_headless(true),
+#else
+            m_headless(hasCliFlag("--headless")),
+#endif
+            m_modules(), m_eventbus(), m_ecs(&m_eventbus),
 #if defined(LEGION_LOW_POWER)
-            m_scheduler(&m_eventbus, true, LEGION_MIN_THREADS)
+            m_scheduler(&m_eventbus, true, LEGION_MIN_THREADS, getCliNumber<uint>("--threads"))
 #else
-            m_scheduler(&m_eventbus, false, LEGION_MIN_THREADS)
+            m_scheduler(&m_eventbus, false, LEGION_MIN_THREADS, getCliNumber<uint>("--threads"))
 #endif
         {
             log::setup();
+            Module::m_headless = m_headless;
+            m_scheduler.setTickRate(getCliNumber<float>("--tickrate"));
+            m_scheduler.setTickLimit(getCliNumber<size_type>("--ticks"));
+            m_scheduler.setDeterministic(hasCliFlag("--deterministic"));
+
+            if (hasCliFlag("--hot-reload"))
+                filesystem::hot_reload::enable(&m_scheduler);
+
+            profiling::Statistics::set_log_interval(getCliNumber<float>("--stats-interval"));
+
+            if (auto mode = getCliOption("--profiler"))
+            {
+                if (*mode == "off")
+                    profiling::Profiler::set_mode(profiling::profiler_mode::disabled);
+                else if (*mode == "capture")
+                    profiling::Profiler::set_mode(profiling::profiler_mode::capture);
+                else
+                    profiling::Profiler::set_mode(profiling::profiler_mode::ring_buffer);
+            }
             eventbus = &m_eventbus;
             Module::m_eventBus = &m_eventbus;
             Module::m_ecs = &m_ecs;
@@ -62,13 +103,18 @@ namespace legion::core
             ecs::component_handle_base::m_registry = &m_ecs;
             ecs::component_handle_base::m_eventBus = &m_eventbus;
             scenemanagement::SceneManager::m_ecs = &m_ecs;
+            scenemanagement::PrefabCache::m_ecs = &m_ecs;
+            scenemanagement::PrefabCache::m_scheduler = &m_scheduler;
+            filesystem::AssetImporter::m_scheduler = &m_scheduler;
 
             reportModule<CoreModule>();
         }
 
         ~Engine()
         {
+            filesystem::hot_reload::disable();
             m_modules.clear();
+            filesystem::AssetImporter::m_scheduler = nullptr;
         }
 
         /**@brief reports an engine module
@@ -81,6 +127,12 @@ namespace legion::core
         void reportModule(Args&&...args)
         {
             std::unique_ptr<Module> module = std::make_unique<ModuleType>(std::forward<Args>(args)...);
+            if (m_headless && !module->headlessCompatible())
+            {
+                log::info("Running headless, skipping module {}", nameOfType<ModuleType>());
+                return;
+            }
+
             module->m_ecs = &m_ecs;
             module->m_scheduler = &m_scheduler;
             module->m_eventBus = &m_eventbus;
@@ -107,15 +159,74 @@ namespace legion::core
         }
 
         /**@brief Runs engine loop.
+         * @note When "--profile-output=<file>" was passed the recorded profile is written to that file after the loop exits.
+         * @note When "--memory-report=<file>" was passed the memory report is written to that file after the loop exits.
          */
         void run()
         {
             m_scheduler.run();
+
+            if (auto output = getCliOption("--profile-output"))
+                profiling::Profiler::export_chrome_trace(std::string(*output));
+
+            if (auto output = getCliOption("--memory-report"))
+                memory::MemoryTracker::dump(std::string(*output));
         }
 
         std::vector<char*>& getCliArgs() {
             return m_cliargs;
         }
 
+        /**@brief Whether the engine runs without a window, graphics context or audio device.
+         */
+        L_NODISCARD bool isHeadless() const noexcept
+        {
+            return m_headless;
+        }
+
+        /**@brief Checks whether a command line flag was passed, e.g. "--headless".
+         */
+        L_NODISCARD bool hasCliFlag(std::string_view flag) const
+        {
+            for (size_type i = 1; i < m_cliargs.size(); i++)
+                if (flag == m_cliargs[i])
+                    return true;
+            return false;
+        }
+
+        /**@brief Gets the value of a command line option passed as "--name=value" or "--name value".
+         * @returns std::optional<std::string_view> The value if the option was passed, std::nullopt otherwise.
+         */
+        L_NODISCARD std::optional<std::string_view> getCliOption(std::string_view name) const
+        {
+            for (size_type i = 1; i < m_cliargs.size(); i++)
+            {
+                std::string_view arg = m_cliargs[i];
+                if (arg.size() > name.size() && arg.substr(0, name.size()) == name && arg[name.size()] == '=')
+                    return arg.substr(name.size() + 1);
+
+                if (arg == name && i + 1 < m_cliargs.size())
+                    return std::string_view(m_cliargs[i + 1]);
+            }
+            return std::nullopt;
+        }
+
+        /**@brief Gets the numeric value of a command line option.
+         * @returns number_type The parsed value, 0 if the option wasn't passed or isn't a number.
+         */
+        template<typename number_type>
+        L_NODISCARD number_type getCliNumber(std::string_view name) const
+        {
+            auto value = getCliOption(name);
+            if (!value)
+                return number_type(0);
+
+            std::string str(*value);
+            if constexpr (std::is_floating_point_v<number_type>)
+                return static_cast<number_type>(std::strtod(str.c_str(), nullptr));
+            else
+                return static_cast<number_type>(std::strtoull(str.c_str(), nullptr, 10));
+        }
+
     };
 }
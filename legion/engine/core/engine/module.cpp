@@ -5,4 +5,5 @@ namespace legion::core
     ecs::EcsRegistry* Module::m_ecs;
     scheduling::Scheduler* Module::m_scheduler;
     events::EventBus* Module::m_eventBus;
+    bool Module::m_headless = false;
 }
@@ -22,6 +22,8 @@ namespace legion::core
     {
         friend class Engine;
     private:
+        static bool m_headless;
+
         sparse_map<id_type, std::unique_ptr<SystemBase>> m_systems;
 
         void init()
@@ -35,6 +37,10 @@ namespace legion::core
         static scheduling::Scheduler* m_scheduler;
         static events::EventBus* m_eventBus;
 
+        /**@brief Whether the engine runs without a window, graphics context or audio device.
+         */
+        static bool isHeadless() { return m_headless; }
+
         template<size_type charc>
         void addProcessChain(const char(&name)[charc])
         {
@@ -65,6 +71,11 @@ namespace legion::core
          */
         virtual priority_type priority() LEGION_IMPURE_RETURN(default_priority);
 
+        /**@brief Determines whether this module can run without a window, graphics context or audio device.
+         * @note Modules that return false won't be loaded when the engine runs headless.
+         */
+        virtual bool headlessCompatible() LEGION_IMPURE_RETURN(true);
+
         virtual ~Module() = default;
     };
 }
@@ -29,7 +29,7 @@ extern void reportModules(legion::core::Engine* engine);
 
 	int main(int argc, char** argv)
 	{
-	#if (!defined(LEGION_DEBUG) && defined(LEGION_WINDOWS) && !defined(LEGION_KEEP_CONSOLE))
+	#if (!defined(LEGION_DEBUG) && defined(LEGION_WINDOWS) && !defined(LEGION_KEEP_CONSOLE) && !defined(LEGION_HEADLESS))
 		::ShowWindow(::GetConsoleWindow(), SW_HIDE);
 	#endif
 
@@ -2,6 +2,7 @@
 #include <core/events/event.hpp>
 #include <core/ecs/entity_handle.hpp>
 #include <core/ecs/component_container.hpp>
+#include <core/profiling/statistics.hpp>
 
 namespace legion::core::events
 {
@@ -15,6 +16,23 @@ namespace legion::core::events
 
     };
 
+    /**@brief Raised when a process or process chain with a budget took longer than it's budget.
+     * @ref legion::core::profiling::Statistics::set_budget
+     */
+    struct budget_exceeded : public event<budget_exceeded>
+    {
+        std::string name;
+        profiling::statistic_category category;
+        float milliseconds;
+        float budget;
+
+        budget_exceeded(const std::string& name, profiling::statistic_category category, float milliseconds, float budget) : name(name), category(category), milliseconds(milliseconds), budget(budget) {}
+
+        virtual bool persistent() override { return false; }
+        virtual bool unique() override { return false; }
+
+    };
+
     struct parent_change : public event<parent_change>
     {
         ecs::entity_handle oldParent;
@@ -41,6 +59,23 @@ namespace legion::core::events
 
     };
 
+    /**@brief Raised once per component type when a batch of components gets created in bulk, for example by instantiating a prefab or loading a binary scene.
+     * @note Per entity component_creation events are only raised for bulk creations if anything is bound to them.
+     */
+    template<typename component_type>
+    struct bulk_component_creation : public event<bulk_component_creation<component_type>>
+    {
+        const ecs::entity_container& entities;
+
+        bulk_component_creation(bulk_component_creation&&) = default;
+        bulk_component_creation(const bulk_component_creation&) = default;
+        bulk_component_creation(const ecs::entity_container& entities) : entities(entities) {}
+
+        virtual bool persistent() override { return false; }
+        virtual bool unique() override { return false; }
+
+    };
+
     template<typename component_type>
     struct component_modification : public event<component_modification<component_type>>
     {
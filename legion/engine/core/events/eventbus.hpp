@@ -5,7 +5,7 @@
 #include <core/types/types.hpp>
 #include <core/events/event.hpp>
 
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
 
 #include <memory>
 
@@ -94,6 +94,15 @@ namespace legion::core::events
             return m_events.contains(event_type::id) && m_events[event_type::id].size();
         }
 
+        /**@brief Check if any callbacks are bound to an event type.
+         * @tparam event_type Event type to check for.
+         */
+        template<typename event_type, typename = inherits_from<event_type, event<event_type>>>
+        bool hasCallbacks() const
+        {
+            return m_eventCallbacks.contains(event_type::id) && m_eventCallbacks[event_type::id].size();
+        }
+
         /**@brief Get the amount of events/messages that are currently in the bus.
          * @tparam event_type Event type to get the amount of.
          */
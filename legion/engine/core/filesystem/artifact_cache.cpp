@@ -13,15 +13,14 @@ namespace legion::core::filesystem {
             async::readonly_guard guard(driver.m_big_gc_lock);
 
             //query provider
-            auto& [ptr,score] =  driver.get_caches()[identifier];
+            auto& [ptr,score] =  driver.get_caches()[std::string(identifier)];
             if(!ptr)
             {
                 //prepare new provider
                 score = driver.current_mean.load();
-                if(size_hint)
-                    ptr = std::make_shared<byte_vec>(size_hint);
-                else
-                    ptr = std::make_shared<byte_vec>();
+                //the cache has to stay empty until it is built, so the hint only reserves
+                ptr = std::make_shared<byte_vec>();
+                ptr->reserve(size_hint);
             }
             else
             {
@@ -90,4 +89,42 @@ namespace legion::core::filesystem {
                 ptr.reset();
         });
     }
+
+    size_type artifact_cache::memory_footprint()
+    {
+        size_type footprint = 0;
+
+        async::readonly_guard guard(m_big_gc_lock);
+        for (auto& [ptr, score] : values_only(m_caches))
+            if (ptr)
+                footprint += ptr->capacity();
+
+        return footprint;
+    }
+
+    size_type artifact_cache::evict(size_type bytes)
+    {
+        async::readwrite_guard guard(m_big_gc_lock);
+
+        //collect all caches that are not used anywhere else
+        std::vector<std::pair<std::int32_t, std::shared_ptr<byte_vec>*>> candidates;
+        for (auto& [ptr, score] : values_only(m_caches))
+            if (ptr && ptr.use_count() == 1)
+                candidates.emplace_back(score, &ptr);
+
+        //release the least used caches first
+        std::sort(candidates.begin(), candidates.end(), [](auto& lhs, auto& rhs) { return lhs.first < rhs.first; });
+
+        size_type freed = 0;
+        for (auto& [score, ptr] : candidates)
+        {
+            if (freed >= bytes)
+                break;
+
+            freed += (*ptr)->capacity();
+            ptr->reset();
+        }
+
+        return freed;
+    }
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <atomic>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <core/types/primitives.hpp>
 #include <core/async/rw_spinlock.hpp>
@@ -38,6 +39,18 @@ namespace legion::core::filesystem
          */
         void gc();
 
+        /**@brief Get the amount of bytes held by all caches.
+         * @note Registered as the sampler of memory::memory_tag::artifacts by the CoreModule.
+         */
+        size_type memory_footprint();
+
+        /**@brief Releases caches that are not in use anymore, lowest scores first.
+         * @note Registered as the eviction handler of memory::memory_tag::artifacts by the CoreModule.
+         * @param bytes Amount of bytes to try to free.
+         * @returns size_type Amount of bytes freed.
+         */
+        size_type evict(size_type bytes);
+
 	private:
         artifact_cache() = default;
 
@@ -53,7 +66,7 @@ namespace legion::core::filesystem
 
         std::atomic<int32_t> current_mean;
 
-        std::unordered_map<std::string_view,std::pair<std::shared_ptr<byte_vec>,int32_t>> m_caches;
+        std::unordered_map<std::string,std::pair<std::shared_ptr<byte_vec>,int32_t>> m_caches;
         std::atomic<std::size_t> m_gc_countdown = gc_interval;
         mutable async::rw_spinlock m_big_gc_lock;
 	};
@@ -1,6 +1,22 @@
 #include <core/filesystem/assetimporter.hpp>
+#include <core/scheduling/scheduler.hpp>
 
 namespace legion::core::filesystem
 {
     sparse_map<id_type, std::vector<detail::resource_converter_base*>> AssetImporter::m_converters;
+    scheduling::Scheduler* AssetImporter::m_scheduler = nullptr;
+
+    void AssetImporter::dispatch(size_type count, delegate<void(size_type)>&& job)
+    {
+        OPTICK_EVENT();
+        if (count == 1 || !m_scheduler)
+        {
+            for (size_type i = 0; i < count; i++)
+                job(i);
+            return;
+        }
+
+        // Waiting also executes jobs, so batches started from within a job don't starve the pool.
+        m_scheduler->queueJobs(count, [&]() { job(async::this_job::get_id()); }).wait();
+    }
 }
@@ -1,16 +1,29 @@
 #pragma once
 #include <any>
+#include <optional>
+#include <unordered_map>
 #include <core/containers/containers.hpp>
+#include <core/containers/delegate.hpp>
 #include <core/filesystem/resource.hpp>
 #include <core/filesystem/view.hpp>
 #include <core/logging/logging.hpp>
 
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
 
 /**
  * @file assetimporter.hpp
  */
 
+namespace legion::core
+{
+    class Engine;
+}
+
+namespace legion::core::scheduling
+{
+    class Scheduler;
+}
+
 namespace legion::core::filesystem
 {
     namespace detail
@@ -65,8 +78,64 @@ namespace legion::core::filesystem
      */
     class AssetImporter
     {
+        friend class legion::core::Engine;
     private:
         static sparse_map<id_type, std::vector<detail::resource_converter_base*>> m_converters;
+        static scheduling::Scheduler* m_scheduler;
+
+        /**@brief Finds the converter for the extension of a file that converts to T, returns nullptr if there is none.
+         */
+        template<typename T, typename... Settings>
+        static resource_converter<T, Settings...>* getConverter(const view& view)
+        {
+            auto extension = view.get_extension();
+            if (extension != common::valid)
+                return nullptr;
+
+            // Hashed as a cstring, just like the extensions reported with reportConverter.
+            const std::string extensionName = extension;
+            const id_type extensionHash = nameHash(extensionName.c_str());
+            if (!m_converters.contains(extensionHash))
+                return nullptr;
+
+            for (detail::resource_converter_base* base : m_converters[extensionHash])
+            {
+                // Do a safety check if the cast was valid before we call any functions on it.
+                if (typeHash<T>() == base->result_type())
+                    return reinterpret_cast<resource_converter<T, Settings...>*>(base);
+            }
+            return nullptr;
+        }
+
+        /**@brief Reads a file and converts it with a converter found by getConverter.
+         */
+        template<typename T, typename Converter, typename... Settings>
+        static common::result_decay_more<T, fs_error> convert(const view& view, Converter* converter, Settings&&... settings)
+        {
+            OPTICK_EVENT();
+            using common::Err, common::Ok;
+            // Decay overloads the operator of ok_type and operator== for valid_t.
+            using decay = common::result_decay_more<T, fs_error>;
+
+            // Check if the view is valid to load as a file.
+            if (!view.is_valid() || !view.file_info().is_file)
+                return decay(Err(legion_fs_error("requested asset load on view that isn't a valid file.")));
+
+            if (!converter)
+                return decay(Err(legion_fs_error("requested asset load on file that stores a different type of asset.")));
+
+            // Get data from file and check validity.
+            auto result = view.get();
+            if (result != common::valid)
+                return decay(Err(result.get_error()));
+
+            // Attempt the conversion and return the result.
+            auto loadresult = converter->load(result, std::forward<Settings>(settings)...);
+            if (loadresult == common::valid)
+                return decay(Ok(static_cast<T>(loadresult)));
+
+            return decay(Err(loadresult.get_error()));
+        }
 
     public:
         /**@brief Reports a converter type to the importer and allows converting from the given extension to the given object type.
@@ -103,34 +172,78 @@ namespace legion::core::filesystem
             else
                 log::trace("Tried to load asset of type{} with settings of types:{}", nameOfType<T>(), ((std::string(nameOfType<Settings>()) + ", ") + ...));
 
-            // Check if the view is valid to load as a file.
-            if (!view.is_valid() || !view.file_info().is_file)
-                return decay(Err(legion_fs_error("requested asset load on view that isn't a valid file.")));
+            return convert<T>(view, getConverter<T, Settings...>(view), std::forward<Settings>(settings)...);
+        }
 
-            // Get data from file and check validity.
-            auto result = view.get();
-            if (result != common::valid)
-                return decay(Err(result.get_error()));
+        /**@brief Attempt to load a batch of objects from files using the pre-reported converters.
+         *        Files are read and converted in parallel on the job pool, views to the same file only get loaded once.
+         * @param views filesystem::views to the files to load.
+         * @param settings... Settings to pass to the load function of the converter, shared by all files in the batch.
+         * @tparam T Type of the objects to try to load.
+         * @return std::vector<common::result_decay_more<T, fs_error>> Results in the same order as the views.
+         */
+        template<typename T, typename... Settings>
+        static std::vector<common::result_decay_more<T, fs_error>> tryLoadBatch(const std::vector<view>& views, const Settings&... settings)
+        {
+            OPTICK_EVENT();
+            using common::Err, common::Ok;
+            // Decay overloads the operator of ok_type and operator== for valid_t.
+            using decay = common::result_decay_more<T, fs_error>;
 
-            for (detail::resource_converter_base* base : m_converters[nameHash(view.get_extension())])
+            log::trace("Tried to load batch of {} assets of type{}", views.size(), nameOfType<T>());
+
+            // Deduplicate the requests, every file only gets loaded once no matter how many views point to it.
+            std::vector<size_type> requestIndices(views.size());
+            std::vector<const view*> requests;
+            std::vector<size_type> requestUses;
             {
-                // Do a safety check if the cast was valid before we call any functions on it.
-                if (typeHash<T>() == base->result_type())
+                std::unordered_map<std::string, size_type> known;
+                for (size_type i = 0; i < views.size(); i++)
                 {
-                    // Retrieve the correct converter to use.
-                    auto* converter = reinterpret_cast<resource_converter<T, Settings...>*>(base);
-
-                    // Attempt the conversion and return the result.
-                    auto loadresult = converter->load(result, std::forward<Settings>(settings)...);
-                    if (loadresult == common::valid)
-                        return decay(Ok(static_cast<T>(loadresult)));
-
-                    return decay(Err(loadresult.get_error()));
+                    auto [it, inserted] = known.try_emplace(views[i].get_virtual_path(), requests.size());
+                    if (inserted)
+                    {
+                        requests.push_back(&views[i]);
+                        requestUses.push_back(0);
+                    }
+                    requestIndices[i] = it->second;
+                    requestUses[it->second]++;
                 }
             }
 
-            return decay(Err(legion_fs_error("requested asset load on file that stores a different type of asset.")));
+            // Converters are looked up up front, the converter registry can't be accessed from multiple threads.
+            std::vector<resource_converter<T, Settings...>*> converters(requests.size());
+            for (size_type i = 0; i < requests.size(); i++)
+                converters[i] = getConverter<T, Settings...>(*requests[i]);
+
+            // Reading the file happens inside the job as well, so the reads of all files overlap.
+            std::vector<std::optional<decay>> loaded(requests.size());
+            dispatch(requests.size(), [&](size_type index)
+                {
+                    loaded[index].emplace(convert<T>(*requests[index], converters[index], Settings(settings)...));
+                });
+
+            std::vector<decay> results;
+            results.reserve(views.size());
+            for (size_type index : requestIndices)
+            {
+                decay& source = *loaded[index];
+                if (--requestUses[index] == 0)
+                    results.push_back(std::move(source));
+                else if (source == common::valid)
+                    results.push_back(decay(Ok(T(source.decay()))));
+                else
+                    results.push_back(decay(Err(source.get_error())));
+            }
+            return results;
         }
 
+        /**@brief Runs a job count times in parallel on the job pool and waits for all of them to finish.
+         *        Runs the jobs on the calling thread when there is only a single job or when no engine is running.
+         * @param count Amount of times to run the job.
+         * @param job Job to run, receives the index of the run.
+         */
+        static void dispatch(size_type count, delegate<void(size_type)>&& job);
+
     };
 }
@@ -4,6 +4,7 @@
 
 
 #include "filemanip.hpp"
+#include "path_cache.hpp"
 #include "core/common/string_extra.hpp"
 
 #if !defined (LEGION_WINDOWS)
@@ -47,7 +48,7 @@ namespace legion::core::filesystem
 
             return (get_target().back() == '\\' || get_target().back() == '/')
                     && is_valid()
-                    && !std::filesystem::is_regular_file(strpath_manip::subdir(m_root_path,get_target()));
+                    && !path_cache::stat(strpath_manip::subdir(m_root_path,get_target())).is_file;
         }
         L_NODISCARD bool is_valid() const noexcept override
         {
@@ -104,7 +105,7 @@ namespace legion::core::filesystem
                 #endif
             }
 
-            if(std::filesystem::is_directory(full) && std::filesystem::exists(full))
+            if(path_cache::stat(full).is_directory)
             {
                 return false;
             }
@@ -139,7 +140,7 @@ namespace legion::core::filesystem
         }
         L_NODISCARD bool exists() const noexcept override
         {
-            return std::filesystem::exists(strpath_manip::subdir(m_root_path,get_target()));
+            return path_cache::stat(strpath_manip::subdir(m_root_path,get_target())).exists;
         }
 
         L_NODISCARD std::string get_absolute_path() const
@@ -147,12 +148,19 @@ namespace legion::core::filesystem
             return strpath_manip::subdir(m_root_path, get_target());
         }
 
+        /**@brief Absolute path of the directory this resolver maps it's domain onto.
+         */
+        L_NODISCARD const std::string& root_path() const noexcept
+        {
+            return m_root_path;
+        }
+
         L_NODISCARD std::set<std::string> ls() const noexcept override
         {
             std::set<std::string> entries;
-            for (const auto & entry : std::filesystem::directory_iterator(strpath_manip::subdir(m_root_path,get_target())))
+            for (const auto & entry : *path_cache::list(strpath_manip::subdir(m_root_path,get_target())))
             {
-                entries.insert(get_identifier()+entry.path().string());
+                entries.insert(get_identifier()+entry);
                 //.relative_path()
             }
             return entries;
@@ -189,6 +197,7 @@ namespace legion::core::filesystem
                 if(!res.empty()) return Err(legion_fs_error("attempted to create directory with data!"));
                 std::error_code code;
                 std::filesystem::create_directories(full,code);
+                path_cache::invalidate(full);
                 if(code.value() != 0)
                 {
                     return Err(legion_fs_error(("std::filesystem bailed! " + code.message()).c_str()));
@@ -204,6 +213,7 @@ namespace legion::core::filesystem
             }
 
             write_file(full,res.get());
+            path_cache::invalidate(full);
 
             return Ok();
         }
@@ -213,6 +223,7 @@ namespace legion::core::filesystem
             //std::filesystem::remove is too
             std::error_code code;
             std::filesystem::remove(strpath_manip::subdir(m_root_path,get_target()),code);
+            path_cache::invalidate(strpath_manip::subdir(m_root_path,get_target()));
         }
 
     private:
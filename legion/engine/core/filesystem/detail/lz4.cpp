@@ -0,0 +1,181 @@
+#include "lz4.hpp"
+
+#include <array>
+#include <cstring>
+
+namespace legion::core::filesystem
+{
+    namespace
+    {
+        // Limits set by the block format, the last 5 bytes are always literals and the last match has to start at least
+        // 12 bytes before the end of the block.
+        constexpr size_type min_match = 4;
+        constexpr size_type last_literals = 5;
+        constexpr size_type match_find_limit = 12;
+        constexpr size_type max_offset = 65535;
+
+        constexpr uint32 hash_log = 12;
+
+        uint32 read32(const byte* ptr) noexcept
+        {
+            uint32 value;
+            std::memcpy(&value, ptr, sizeof(value));
+            return value;
+        }
+
+        uint32 hash_sequence(uint32 sequence) noexcept
+        {
+            return (sequence * 2654435761u) >> (32 - hash_log);
+        }
+
+        byte* write_length(byte* op, size_type length) noexcept
+        {
+            for (; length >= 255; length -= 255)
+                *op++ = 255;
+            *op++ = static_cast<byte>(length);
+            return op;
+        }
+
+        byte* write_literals(byte* op, byte token, const byte* literals, size_type length) noexcept
+        {
+            *op++ = static_cast<byte>(token | ((length >= 15 ? 15 : length) << 4));
+            if (length >= 15)
+                op = write_length(op, length - 15);
+
+            std::memcpy(op, literals, length);
+            return op + length;
+        }
+
+        bool read_length(const byte*& ip, const byte* iend, size_type& length) noexcept
+        {
+            byte value;
+            do
+            {
+                if (ip >= iend)
+                    return false;
+                value = *ip++;
+                length += value;
+            } while (value == 255);
+            return true;
+        }
+    }
+
+    size_type lz4::compress_bound(size_type size) noexcept
+    {
+        return size + size / 255 + 16;
+    }
+
+    size_type lz4::compress(const byte* src, size_type size, byte* out) noexcept
+    {
+        const byte* ip = src;
+        const byte* anchor = src;
+        const byte* const iend = src + size;
+        byte* op = out;
+
+        if (size > match_find_limit)
+        {
+            // Positions are stored off by one so that 0 can mean empty.
+            std::array<uint32, 1 << hash_log> table{};
+
+            const byte* const matchStartLimit = iend - match_find_limit;
+            const byte* const matchEndLimit = iend - last_literals;
+
+            while (ip <= matchStartLimit)
+            {
+                const uint32 sequence = read32(ip);
+                uint32& slot = table[hash_sequence(sequence)];
+                const byte* ref = slot ? src + (slot - 1) : nullptr;
+                slot = static_cast<uint32>(ip - src) + 1;
+
+                if (!ref || static_cast<size_type>(ip - ref) > max_offset || read32(ref) != sequence)
+                {
+                    ip++;
+                    continue;
+                }
+
+                const byte* matchEnd = ip + min_match;
+                const byte* refEnd = ref + min_match;
+                while (matchEnd < matchEndLimit && *matchEnd == *refEnd)
+                {
+                    matchEnd++;
+                    refEnd++;
+                }
+
+                const size_type matchLength = static_cast<size_type>(matchEnd - ip) - min_match;
+                op = write_literals(op, static_cast<byte>(matchLength >= 15 ? 15 : matchLength), anchor, static_cast<size_type>(ip - anchor));
+
+                const uint16 offset = static_cast<uint16>(ip - ref);
+                *op++ = static_cast<byte>(offset & 0xFF);
+                *op++ = static_cast<byte>(offset >> 8);
+
+                if (matchLength >= 15)
+                    op = write_length(op, matchLength - 15);
+
+                ip = matchEnd;
+                anchor = ip;
+            }
+        }
+
+        op = write_literals(op, 0, anchor, static_cast<size_type>(iend - anchor));
+        return static_cast<size_type>(op - out);
+    }
+
+    bool lz4::decompress(const byte* src, size_type srcSize, byte* out, size_type outSize) noexcept
+    {
+        const byte* ip = src;
+        const byte* const iend = src + srcSize;
+        byte* op = out;
+        byte* const oend = out + outSize;
+
+        while (ip < iend)
+        {
+            const byte token = *ip++;
+
+            size_type literalLength = token >> 4;
+            if (literalLength == 15 && !read_length(ip, iend, literalLength))
+                return false;
+
+            if (literalLength > static_cast<size_type>(iend - ip) || literalLength > static_cast<size_type>(oend - op))
+                return false;
+
+            std::memcpy(op, ip, literalLength);
+            ip += literalLength;
+            op += literalLength;
+
+            // The last sequence only has literals.
+            if (ip == iend)
+                break;
+
+            if (iend - ip < 2)
+                return false;
+
+            const size_type offset = static_cast<size_type>(ip[0]) | (static_cast<size_type>(ip[1]) << 8);
+            ip += 2;
+            if (offset == 0 || offset > static_cast<size_type>(op - out))
+                return false;
+
+            size_type matchLength = token & 15;
+            if (matchLength == 15 && !read_length(ip, iend, matchLength))
+                return false;
+            matchLength += min_match;
+
+            if (matchLength > static_cast<size_type>(oend - op))
+                return false;
+
+            // Matches can overlap the bytes they produce, which repeats the last offset bytes.
+            const byte* match = op - offset;
+            if (offset >= matchLength)
+            {
+                std::memcpy(op, match, matchLength);
+                op += matchLength;
+            }
+            else
+            {
+                for (size_type i = 0; i < matchLength; i++)
+                    *op++ = *match++;
+            }
+        }
+
+        return op == oend;
+    }
+}
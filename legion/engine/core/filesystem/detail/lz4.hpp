@@ -0,0 +1,36 @@
+#pragma once
+#include <core/types/primitives.hpp>
+#include <core/platform/platform.hpp>
+
+/**
+ * @file lz4.hpp
+ * @brief Compressor and decompressor for the LZ4 block format, compatible with blocks written by the reference implementation.
+ */
+
+namespace legion::core::filesystem
+{
+    class lz4
+    {
+    public:
+        /** @brief Largest size compressing size bytes can result in.
+         */
+        L_NODISCARD static size_type compress_bound(size_type size) noexcept;
+
+        /** @brief Compresses a single block.
+         *  @param [in] src The data to compress.
+         *  @param [in] size The amount of bytes to compress.
+         *  @param [out] out Buffer of at least compress_bound(size) bytes.
+         *  @return size_type The size of the compressed block.
+         */
+        static size_type compress(const byte* src, size_type size, byte* out) noexcept;
+
+        /** @brief Decompresses a single block.
+         *  @param [in] src The compressed block.
+         *  @param [in] srcSize The size of the compressed block.
+         *  @param [out] out Buffer for the decompressed data.
+         *  @param [in] outSize The exact size of the decompressed data.
+         *  @return bool False when the block is malformed or doesn't decompress to exactly outSize bytes.
+         */
+        L_NODISCARD static bool decompress(const byte* src, size_type srcSize, byte* out, size_type outSize) noexcept;
+    };
+}
@@ -0,0 +1,217 @@
+#include <core/filesystem/file_watcher.hpp>
+#include <core/async/thread_util.hpp>
+#include <core/logging/logging.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+#if defined(LEGION_LINUX)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace legion::core::filesystem
+{
+    namespace
+    {
+        // Time without new changes before a batch gets reported.
+        constexpr std::chrono::milliseconds debounce_time{ 150 };
+#if !defined(LEGION_LINUX)
+        constexpr std::chrono::milliseconds poll_interval{ 250 };
+#endif
+    }
+
+    file_watcher::file_watcher(change_callback&& callback) : m_callback(std::move(callback))
+    {
+    }
+
+    file_watcher::~file_watcher()
+    {
+        stop();
+    }
+
+    void file_watcher::watch(const std::string& path)
+    {
+        {
+            async::readwrite_guard guard(m_rootsLock);
+            m_roots.push_back(path);
+            m_pendingRoots.push_back(path);
+        }
+
+        if (m_running.load(std::memory_order_acquire))
+            return;
+
+#if defined(LEGION_LINUX)
+        m_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (m_inotify < 0)
+        {
+            log::error("Failed to initialize inotify, assets will not be hot-reloaded.");
+            return;
+        }
+#endif
+
+        m_running.store(true, std::memory_order_release);
+        m_thread = std::thread(&file_watcher::run, this);
+    }
+
+    void file_watcher::stop()
+    {
+        if (!m_running.exchange(false, std::memory_order_acq_rel))
+            return;
+
+        if (m_thread.joinable())
+            m_thread.join();
+
+#if defined(LEGION_LINUX)
+        close(m_inotify);
+        m_inotify = -1;
+        m_watches.clear();
+#endif
+    }
+
+#if defined(LEGION_LINUX)
+    void file_watcher::addWatches(const std::string& directory)
+    {
+        constexpr uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+
+        std::error_code error;
+        if (!std::filesystem::is_directory(directory, error))
+            return;
+
+        int wd = inotify_add_watch(m_inotify, directory.c_str(), mask);
+        if (wd < 0)
+        {
+            log::warn("Could not watch {} for changes.", directory);
+            return;
+        }
+        m_watches[wd] = directory;
+
+        for (auto& entry : std::filesystem::recursive_directory_iterator(directory, std::filesystem::directory_options::skip_permission_denied, error))
+        {
+            if (!entry.is_directory(error))
+                continue;
+
+            const std::string subdirectory = entry.path().string();
+            wd = inotify_add_watch(m_inotify, subdirectory.c_str(), mask);
+            if (wd >= 0)
+                m_watches[wd] = subdirectory;
+        }
+    }
+#else
+    void file_watcher::scan(const std::string& root, std::vector<std::string>& changed, bool report)
+    {
+        std::error_code error;
+        for (auto& entry : std::filesystem::recursive_directory_iterator(root, std::filesystem::directory_options::skip_permission_denied, error))
+        {
+            if (!entry.is_regular_file(error))
+                continue;
+
+            const auto writeTime = entry.last_write_time(error);
+            if (error)
+                continue;
+
+            std::string path = entry.path().string();
+            auto [it, inserted] = m_writeTimes.try_emplace(path, writeTime);
+            if (inserted || it->second != writeTime)
+            {
+                it->second = writeTime;
+                if (report)
+                    changed.push_back(std::move(path));
+            }
+        }
+    }
+#endif
+
+    void file_watcher::run()
+    {
+        async::set_thread_name("File watcher");
+
+        using clock = std::chrono::steady_clock;
+        std::vector<std::string> changed;
+        auto lastChange = clock::now();
+
+        while (m_running.load(std::memory_order_acquire))
+        {
+            std::vector<std::string> newRoots;
+            {
+                async::readwrite_guard guard(m_rootsLock);
+                newRoots.swap(m_pendingRoots);
+            }
+
+            for (auto& root : newRoots)
+            {
+#if defined(LEGION_LINUX)
+                addWatches(root);
+#else
+                scan(root, changed, false);
+#endif
+            }
+
+            const size_type changeCount = changed.size();
+
+#if defined(LEGION_LINUX)
+            pollfd descriptor{ m_inotify, POLLIN, 0 };
+            if (poll(&descriptor, 1, static_cast<int>(debounce_time.count() / 2)) > 0 && (descriptor.revents & POLLIN))
+            {
+                alignas(inotify_event) char buffer[4096];
+                ssize_t length;
+                while ((length = read(m_inotify, buffer, sizeof(buffer))) > 0)
+                {
+                    for (char* ptr = buffer; ptr < buffer + length;)
+                    {
+                        const auto* event = reinterpret_cast<const inotify_event*>(ptr);
+                        ptr += sizeof(inotify_event) + event->len;
+
+                        if (event->mask & IN_Q_OVERFLOW)
+                        {
+                            log::warn("File watcher queue overflowed, some asset changes were missed.");
+                            continue;
+                        }
+
+                        if (event->mask & IN_IGNORED)
+                        {
+                            m_watches.erase(event->wd);
+                            continue;
+                        }
+
+                        auto directory = m_watches.find(event->wd);
+                        if (directory == m_watches.end() || !event->len)
+                            continue;
+
+                        std::string path = directory->second + '/' + event->name;
+                        if (event->mask & IN_ISDIR)
+                            addWatches(path);
+                        else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                            changed.push_back(std::move(path));
+                    }
+                }
+            }
+#else
+            std::this_thread::sleep_for(poll_interval);
+
+            std::vector<std::string> roots;
+            {
+                async::readonly_guard guard(m_rootsLock);
+                roots = m_roots;
+            }
+
+            for (auto& root : roots)
+                scan(root, changed, true);
+#endif
+
+            const auto now = clock::now();
+            if (changed.size() != changeCount)
+                lastChange = now;
+
+            if (changed.empty() || now - lastChange < debounce_time)
+                continue;
+
+            std::sort(changed.begin(), changed.end());
+            changed.erase(std::unique(changed.begin(), changed.end()), changed.end());
+
+            m_callback(changed);
+            changed.clear();
+        }
+    }
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <core/platform/platform.hpp>
+#include <core/types/primitives.hpp>
+#include <core/containers/delegate.hpp>
+#include <core/async/rw_spinlock.hpp>
+
+#include <atomic>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file file_watcher.hpp
+ * @brief Background watcher that reports files written to inside a set of directories.
+ *        On Linux the directories are watched with inotify, other platforms fall back to polling the modification times.
+ */
+
+namespace legion::core::filesystem
+{
+    /**@class file_watcher
+     * @brief Watches directory trees on a thread of it's own and reports changed files in batches.
+     *        Editors tend to write a file in several steps, so changes are only reported once the directories have been quiet for a short while.
+     */
+    class file_watcher
+    {
+    public:
+        /**@brief Callback receiving the absolute paths of all files changed since the last batch, called from the watcher thread.
+         */
+        using change_callback = delegate<void(const std::vector<std::string>&)>;
+
+    private:
+        change_callback m_callback;
+        std::thread m_thread;
+        std::atomic_bool m_running{ false };
+
+        async::rw_spinlock m_rootsLock;
+        std::vector<std::string> m_roots;
+        std::vector<std::string> m_pendingRoots; // Roots added since the watcher thread last picked them up.
+
+#if defined(LEGION_LINUX)
+        int m_inotify = -1;
+        std::unordered_map<int, std::string> m_watches; // Watch descriptor to directory.
+
+        void addWatches(const std::string& directory);
+#else
+        std::unordered_map<std::string, std::filesystem::file_time_type> m_writeTimes;
+
+        void scan(const std::string& root, std::vector<std::string>& changed, bool report);
+#endif
+
+        void run();
+
+    public:
+        explicit file_watcher(change_callback&& callback);
+        ~file_watcher();
+
+        file_watcher(const file_watcher&) = delete;
+        file_watcher& operator=(const file_watcher&) = delete;
+
+        /**@brief Starts watching a directory and all of it's sub-directories, starts the watcher thread if it wasn't running yet.
+         * @param path Absolute path of the directory.
+         */
+        void watch(const std::string& path);
+
+        /**@brief Stops and joins the watcher thread.
+         */
+        void stop();
+
+        L_NODISCARD bool running() const noexcept { return m_running.load(std::memory_order_relaxed); }
+    };
+}
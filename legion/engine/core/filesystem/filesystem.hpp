@@ -6,7 +6,10 @@
 #include <core/filesystem/filesystem_resolver.hpp>
 #include <core/filesystem/mem_filesystem_resolver.hpp>
 #include <core/filesystem/basic_resolver.hpp>
+#include <core/filesystem/pack_resolver.hpp>
 #include <core/filesystem/provider_registry.hpp>
+#include <core/filesystem/path_cache.hpp>
+#include <core/filesystem/hot_reload.hpp>
 
 #include <core/filesystem/view.hpp>
 
@@ -0,0 +1,278 @@
+#include <core/filesystem/hot_reload.hpp>
+#include <core/filesystem/provider_registry.hpp>
+#include <core/filesystem/basic_resolver.hpp>
+#include <core/filesystem/path_cache.hpp>
+#include <core/scheduling/scheduler.hpp>
+#include <core/logging/logging.hpp>
+
+#include <algorithm>
+#include <filesystem>
+
+namespace legion::core::filesystem
+{
+    bool hot_reload::m_enabled = false;
+    scheduling::Scheduler* hot_reload::m_scheduler = nullptr;
+    std::unique_ptr<file_watcher> hot_reload::m_watcher;
+
+    async::rw_spinlock hot_reload::m_rootsLock;
+    std::vector<std::pair<std::string, std::string>> hot_reload::m_roots;
+
+    async::rw_spinlock hot_reload::m_graphLock;
+    std::unordered_map<std::string, std::unordered_set<std::string>> hot_reload::m_dependents;
+    std::unordered_map<std::string, std::unordered_set<std::string>> hot_reload::m_dependencies;
+    std::unordered_map<std::string, std::shared_ptr<hot_reload::reload_func>> hot_reload::m_reloaders;
+
+    async::rw_spinlock hot_reload::m_commitLock;
+    std::unordered_map<id_type, std::vector<hot_reload::commit_func>> hot_reload::m_commits;
+
+    namespace
+    {
+        using graph = std::unordered_map<std::string, std::unordered_set<std::string>>;
+
+        // Depth first post-order over the dependents, reversed this puts every node after all of the nodes it depends on.
+        void visit_dependents(const graph& dependents, const std::string& node, std::unordered_set<std::string>& visited, std::vector<std::string>& order)
+        {
+            if (!visited.insert(node).second)
+                return;
+
+            if (auto it = dependents.find(node); it != dependents.end())
+                for (auto& dependent : it->second)
+                    visit_dependents(dependents, dependent, visited, order);
+
+            order.push_back(node);
+        }
+    }
+
+    void hot_reload::enable(scheduling::Scheduler* scheduler)
+    {
+        m_scheduler = scheduler;
+        m_enabled = true;
+        if (!m_watcher)
+            m_watcher = std::make_unique<file_watcher>(file_watcher::change_callback::create<&hot_reload::on_files_changed>());
+        log::info("Asset hot-reloading enabled.");
+    }
+
+    void hot_reload::disable()
+    {
+        if (!m_enabled)
+            return;
+
+        m_enabled = false;
+        m_watcher.reset();
+
+        async::readwrite_guard guard(m_commitLock);
+        m_commits.clear();
+    }
+
+    void hot_reload::watch_domain(const std::string& domain)
+    {
+        if (!m_enabled)
+            return;
+
+        for (auto* resolver : provider_registry::domain_get_resolvers(domain))
+        {
+            auto* basic = dynamic_cast<basic_resolver*>(resolver);
+            if (!basic)
+                continue;
+
+            const std::string& root = basic->root_path();
+            {
+                async::readwrite_guard guard(m_rootsLock);
+                m_roots.emplace_back(root, domain);
+            }
+
+            m_watcher->watch(root);
+            log::debug("Watching {} for changes to {}", root, domain);
+        }
+    }
+
+    std::string hot_reload::node(std::string_view name)
+    {
+        const auto separator = name.find("://");
+        if (separator == std::string_view::npos)
+            return std::string(name);
+
+        std::string relative(name.substr(separator + 3));
+        std::replace(relative.begin(), relative.end(), '\\', '/');
+        relative = std::filesystem::path(relative).lexically_normal().generic_string();
+
+        return std::string(name.substr(0, separator + 3)) + relative;
+    }
+
+    std::string hot_reload::entry_node(std::string_view cache, id_type id)
+    {
+        return std::string(cache) + ':' + std::to_string(id);
+    }
+
+    std::string hot_reload::to_virtual_path(const std::string& absolutePath)
+    {
+        async::readonly_guard guard(m_rootsLock);
+        for (auto& [root, domain] : m_roots)
+        {
+            if (absolutePath.size() <= root.size() || absolutePath.compare(0, root.size(), root) != 0)
+                continue;
+
+            const char separator = absolutePath[root.size()];
+            if (separator != '/' && separator != '\\')
+                continue;
+
+            return node(domain + absolutePath.substr(root.size() + 1));
+        }
+        return {};
+    }
+
+    void hot_reload::on_reload(std::string_view asset, reload_func&& reload)
+    {
+        if (!m_enabled)
+            return;
+
+        auto func = std::make_shared<reload_func>(std::move(reload));
+        async::readwrite_guard guard(m_graphLock);
+        m_reloaders[node(asset)] = std::move(func);
+    }
+
+    void hot_reload::add_dependency(std::string_view asset, std::string_view dependency)
+    {
+        if (!m_enabled)
+            return;
+
+        std::string assetNode = node(asset);
+        std::string dependencyNode = node(dependency);
+        if (assetNode == dependencyNode)
+            return;
+
+        async::readwrite_guard guard(m_graphLock);
+        m_dependents[dependencyNode].insert(assetNode);
+        m_dependencies[std::move(assetNode)].insert(std::move(dependencyNode));
+    }
+
+    void hot_reload::clear_dependencies(std::string_view asset)
+    {
+        if (!m_enabled)
+            return;
+
+        const std::string assetNode = node(asset);
+
+        async::readwrite_guard guard(m_graphLock);
+        auto it = m_dependencies.find(assetNode);
+        if (it == m_dependencies.end())
+            return;
+
+        for (auto& dependency : it->second)
+            if (auto dependents = m_dependents.find(dependency); dependents != m_dependents.end())
+                dependents->second.erase(assetNode);
+
+        m_dependencies.erase(it);
+    }
+
+    void hot_reload::remove(std::string_view asset)
+    {
+        if (!m_enabled)
+            return;
+
+        clear_dependencies(asset);
+
+        async::readwrite_guard guard(m_graphLock);
+        m_reloaders.erase(node(asset));
+    }
+
+    void hot_reload::invalidate(std::string_view asset)
+    {
+        if (!m_enabled)
+            return;
+
+        reload_nodes({ node(asset) });
+    }
+
+    void hot_reload::on_files_changed(const std::vector<std::string>& paths)
+    {
+        // Stats and listings of changed files are stale, whether anything was loaded from them or not.
+        for (auto& path : paths)
+            path_cache::invalidate(path);
+
+        std::vector<std::string> changed;
+        {
+            async::readonly_guard guard(m_graphLock);
+            for (auto& path : paths)
+            {
+                std::string virtualPath = to_virtual_path(path);
+                if (virtualPath.empty())
+                    continue;
+
+                // Files nothing was loaded from are of no interest.
+                if (m_dependents.count(virtualPath) || m_reloaders.count(virtualPath))
+                    changed.push_back(std::move(virtualPath));
+            }
+        }
+
+        if (!changed.empty())
+            reload_nodes(changed);
+    }
+
+    void hot_reload::reload_nodes(const std::vector<std::string>& nodes)
+    {
+        std::vector<std::pair<std::string, std::shared_ptr<reload_func>>> reloaders;
+        {
+            async::readonly_guard guard(m_graphLock);
+            std::vector<std::string> order;
+            std::unordered_set<std::string> visited;
+            for (auto& changed : nodes)
+                visit_dependents(m_dependents, changed, visited, order);
+
+            for (auto it = order.rbegin(); it != order.rend(); ++it)
+                if (auto reloader = m_reloaders.find(*it); reloader != m_reloaders.end())
+                    reloaders.emplace_back(*it, reloader->second);
+        }
+
+        log::info("{} asset(s) changed, reloading {} dependent cache entries.", nodes.size(), reloaders.size());
+
+        // Reloaders run outside of the lock since they re-discover their dependencies.
+        for (auto& [name, reload] : reloaders)
+        {
+            log::debug("Reloading {}", name);
+            (*reload)();
+        }
+    }
+
+    void hot_reload::commit(commit_func&& operation)
+    {
+        if (m_scheduler)
+            m_scheduler->queueSyncOperation(std::move(operation));
+        else
+            operation();
+    }
+
+    void hot_reload::commit(id_type channel, commit_func&& operation)
+    {
+        async::readwrite_guard guard(m_commitLock);
+        m_commits[channel].push_back(std::move(operation));
+    }
+
+    bool hot_reload::has_commits(id_type channel)
+    {
+        if (!m_enabled)
+            return false;
+
+        async::readonly_guard guard(m_commitLock);
+        auto it = m_commits.find(channel);
+        return it != m_commits.end() && !it->second.empty();
+    }
+
+    void hot_reload::apply_commits(id_type channel)
+    {
+        if (!m_enabled)
+            return;
+
+        std::vector<commit_func> commits;
+        {
+            async::readwrite_guard guard(m_commitLock);
+            auto it = m_commits.find(channel);
+            if (it == m_commits.end() || it->second.empty())
+                return;
+            commits.swap(it->second);
+        }
+
+        for (auto& operation : commits)
+            operation();
+    }
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <core/platform/platform.hpp>
+#include <core/types/primitives.hpp>
+#include <core/containers/delegate.hpp>
+#include <core/async/rw_spinlock.hpp>
+#include <core/filesystem/file_watcher.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @file hot_reload.hpp
+ * @brief Reloads assets while the engine is running when their files change on disk.
+ *        Caches register a reload function per entry together with the files and other entries it was built from,
+ *        a change to a file then only reloads the entries that (transitively) depend on it, in dependency order.
+ *        Reload functions run on the file watcher thread and hand the finished result back through commit(),
+ *        which swaps it in at the next sync point, or on a specific thread for data that belongs to a graphics context.
+ */
+
+namespace legion::core::scheduling
+{
+    class Scheduler;
+}
+
+namespace legion::core::filesystem
+{
+    /**@class hot_reload
+     * @brief Static dependency graph of loaded assets and the watcher feeding it.
+     *        Nodes are identified by strings, files use their virtual path (e.g. "assets://shaders/pbr.shs"),
+     *        cache entries use the name of the cache followed by their id (e.g. "mesh:1234"), see entry_node().
+     * @note Everything is a no-op unless hot-reloading was enabled, which the Engine does when "--hot-reload" is passed.
+     */
+    class hot_reload
+    {
+    public:
+        using reload_func = delegate<void()>;
+        using commit_func = delegate<void()>;
+
+    private:
+        static bool m_enabled;
+        static scheduling::Scheduler* m_scheduler;
+        static std::unique_ptr<file_watcher> m_watcher;
+
+        static async::rw_spinlock m_rootsLock;
+        static std::vector<std::pair<std::string, std::string>> m_roots; // Absolute root path and domain.
+
+        static async::rw_spinlock m_graphLock;
+        static std::unordered_map<std::string, std::unordered_set<std::string>> m_dependents;
+        static std::unordered_map<std::string, std::unordered_set<std::string>> m_dependencies;
+        static std::unordered_map<std::string, std::shared_ptr<reload_func>> m_reloaders;
+
+        static async::rw_spinlock m_commitLock;
+        static std::unordered_map<id_type, std::vector<commit_func>> m_commits;
+
+        static void on_files_changed(const std::vector<std::string>& paths);
+        static void reload_nodes(const std::vector<std::string>& nodes);
+        L_NODISCARD static std::string to_virtual_path(const std::string& absolutePath);
+
+    public:
+        hot_reload() = delete;
+        ~hot_reload() = delete;
+
+        /**@brief Turns hot-reloading on, needs to happen before any domain is watched.
+         * @param scheduler Scheduler to swap reloaded assets in at the sync point of.
+         */
+        static void enable(scheduling::Scheduler* scheduler);
+
+        /**@brief Stops watching and drops all pending commits.
+         */
+        static void disable();
+
+        L_NODISCARD static bool enabled() noexcept { return m_enabled; }
+
+        /**@brief Watches the root directories of all basic_resolvers of a domain.
+         * @param domain Domain including the separator, e.g. "assets://".
+         */
+        static void watch_domain(const std::string& domain);
+
+        /**@brief Normalizes a node name so that different spellings of the same virtual path map to the same node.
+         */
+        L_NODISCARD static std::string node(std::string_view name);
+
+        /**@brief Name of the node of a cache entry, e.g. entry_node("mesh", id) for a mesh in the MeshCache.
+         */
+        L_NODISCARD static std::string entry_node(std::string_view cache, id_type id);
+
+        /**@brief Sets the function that reloads a node, replacing the previous one.
+         */
+        static void on_reload(std::string_view asset, reload_func&& reload);
+
+        /**@brief Marks asset as depending on dependency, a change to the dependency will reload the asset as well.
+         */
+        static void add_dependency(std::string_view asset, std::string_view dependency);
+
+        /**@brief Removes all dependencies of an asset, used before re-discovering them during a reload.
+         */
+        static void clear_dependencies(std::string_view asset);
+
+        /**@brief Removes an asset from the graph entirely.
+         */
+        static void remove(std::string_view asset);
+
+        /**@brief Reloads a node and everything depending on it as if it's file had changed.
+         */
+        static void invalidate(std::string_view asset);
+
+        /**@brief Swaps reloaded data in at the next sync point, when no process-chain is running.
+         */
+        static void commit(commit_func&& operation);
+
+        /**@brief Queues reloaded data for a specific thread, which picks it up by calling apply_commits with the same channel.
+         *        Commits are applied in the order they were queued in, so dependents reloaded later also get applied later.
+         * @param channel Identifier of the receiving thread, by convention the name hash of the process-chain running on it.
+         */
+        static void commit(id_type channel, commit_func&& operation);
+
+        /**@brief Checks whether any commits are queued for a channel, lets the receiving thread skip preparing for them.
+         */
+        L_NODISCARD static bool has_commits(id_type channel);
+
+        /**@brief Applies all commits queued for a channel.
+         */
+        static void apply_commits(id_type channel);
+    };
+}
@@ -36,6 +36,13 @@ namespace legion::core::filesystem
             m_targetData = target_data;
         }
 
+        /** @brief Lets the resolver access the containing file on disk directly, instead of having the whole file read
+         *         and passed to set_disk_data. Useful for archives that only need small parts of the containing file.
+         *  @param [in] path Absolute path to the containing file.
+         *  @return True when the resolver took the file, false to have the file read and passed to set_disk_data instead.
+         */
+        virtual bool set_disk_path(const std::string& path) LEGION_IMPURE_RETURN(false);
+
         L_NODISCARD filesystem_resolver* make() final override
         {
             mem_filesystem_resolver* x = make_higher();
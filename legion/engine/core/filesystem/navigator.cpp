@@ -3,7 +3,7 @@
 #include <core/common/string_extra.hpp>
 #include <core/filesystem/provider_registry.hpp>
 
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
 
 namespace legion::core::filesystem {
     common::result<navigator::solution,fs_error> navigator::find_solution(const std::string& opt_root_domain) const 
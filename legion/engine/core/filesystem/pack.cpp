@@ -0,0 +1,357 @@
+#include "pack.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+#include <core/async/rw_spinlock.hpp>
+#include <core/logging/logging.hpp>
+
+#include "detail/lz4.hpp"
+
+#if !defined(LEGION_WINDOWS)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace legion::core::filesystem
+{
+    namespace
+    {
+        struct open_pack
+        {
+            std::shared_ptr<const pack_archive> archive;
+            std::filesystem::file_time_type writeTime;
+        };
+
+        async::rw_spinlock open_packs_lock;
+        std::unordered_map<std::string, open_pack> open_packs;
+
+        const std::set<std::string> empty_listing;
+
+        size_type align_to(size_type value, size_type alignment) noexcept
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        std::string_view parent_of(std::string_view path) noexcept
+        {
+            const auto idx = path.find_last_of('/');
+            return idx == std::string_view::npos ? std::string_view() : path.substr(0, idx);
+        }
+    }
+
+    uint64 pack_hash(std::string_view path) noexcept
+    {
+        uint64 hash = 0xcbf29ce484222325;
+        for (char c : path)
+        {
+            hash ^= static_cast<byte>(c);
+            hash *= 0x00000100000001b3;
+        }
+        return hash;
+    }
+
+    std::string pack_normalize(std::string_view path)
+    {
+        std::string result(path);
+        std::replace(result.begin(), result.end(), '\\', '/');
+
+        const auto first = result.find_first_not_of('/');
+        if (first == std::string::npos)
+            return {};
+
+        const auto last = result.find_last_not_of('/');
+        return result.substr(first, last - first + 1);
+    }
+
+    pack_archive::~pack_archive()
+    {
+        if (!m_mapping)
+            return;
+
+#if defined(LEGION_WINDOWS)
+        UnmapViewOfFile(m_mapping);
+#else
+        munmap(m_mapping, m_size);
+#endif
+    }
+
+    std::shared_ptr<const pack_archive> pack_archive::open(const std::string& path)
+    {
+        OPTICK_EVENT();
+        std::error_code error;
+        const auto writeTime = std::filesystem::last_write_time(path, error);
+        if (error)
+            return nullptr;
+
+        {
+            async::readonly_guard guard(open_packs_lock);
+            auto it = open_packs.find(path);
+            if (it != open_packs.end() && it->second.writeTime == writeTime)
+                return it->second.archive;
+        }
+
+        std::shared_ptr<pack_archive> archive(new pack_archive());
+
+#if defined(LEGION_WINDOWS)
+        const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return nullptr;
+
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return nullptr;
+        }
+
+        const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (!mapping)
+            return nullptr;
+
+        // The view keeps the mapping alive on it's own.
+        void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+        if (!view)
+            return nullptr;
+
+        archive->m_mapping = view;
+        archive->m_size = static_cast<size_type>(fileSize.QuadPart);
+#else
+        const int file = ::open(path.c_str(), O_RDONLY);
+        if (file < 0)
+            return nullptr;
+
+        struct stat info;
+        if (fstat(file, &info) != 0 || info.st_size == 0)
+        {
+            ::close(file);
+            return nullptr;
+        }
+
+        void* view = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+        ::close(file);
+        if (view == MAP_FAILED)
+            return nullptr;
+
+        archive->m_mapping = view;
+        archive->m_size = static_cast<size_type>(info.st_size);
+#endif
+
+        archive->m_data = static_cast<const byte*>(archive->m_mapping);
+        if (!archive->parse())
+        {
+            log::error("{} is not a valid pack", path);
+            return nullptr;
+        }
+
+        async::readwrite_guard guard(open_packs_lock);
+        open_packs[path] = { archive, writeTime };
+        return archive;
+    }
+
+    std::shared_ptr<const pack_archive> pack_archive::from_memory(const byte* data, size_type size)
+    {
+        std::shared_ptr<pack_archive> archive(new pack_archive());
+        archive->m_data = data;
+        archive->m_size = size;
+
+        if (!archive->parse())
+            return nullptr;
+        return archive;
+    }
+
+    void pack_archive::close(const std::string& path)
+    {
+        async::readwrite_guard guard(open_packs_lock);
+        open_packs.erase(path);
+    }
+
+    bool pack_archive::parse()
+    {
+        OPTICK_EVENT();
+        if (m_size < sizeof(pack_header))
+            return false;
+
+        m_header = reinterpret_cast<const pack_header*>(m_data);
+        if (m_header->magic != pack_header::magic_value || m_header->version != pack_header::current_version)
+            return false;
+
+        // Validate everything up front, so that lookups and reads don't need to check the bounds of the index anymore.
+        const uint64 indexSize = static_cast<uint64>(m_header->entryCount) * sizeof(pack_entry);
+        if (m_header->indexOffset > m_size || indexSize > m_size - m_header->indexOffset || m_header->indexOffset % alignof(pack_entry))
+            return false;
+        if (m_header->namesOffset > m_size || m_header->namesSize > m_size - m_header->namesOffset)
+            return false;
+
+        m_entries = reinterpret_cast<const pack_entry*>(m_data + m_header->indexOffset);
+        m_names = reinterpret_cast<const char*>(m_data + m_header->namesOffset);
+
+        for (size_type i = 0; i < m_header->entryCount; i++)
+        {
+            const pack_entry& entry = m_entries[i];
+            if (entry.offset > m_size || entry.storedSize > m_size - entry.offset)
+                return false;
+            if (static_cast<uint64>(entry.nameOffset) + entry.nameSize > m_header->namesSize)
+                return false;
+            if (i && m_entries[i - 1].hash > entry.hash)
+                return false;
+
+            // Register the entry with all of it's parent directories, the root directory is the empty path.
+            std::string_view path = name_of(entry);
+            while (!path.empty())
+            {
+                const std::string_view parent = parent_of(path);
+                auto& children = m_directories[std::string(parent)];
+                if (!children.emplace(path).second)
+                    break;
+                path = parent;
+            }
+        }
+
+        return true;
+    }
+
+    const pack_entry* pack_archive::find(std::string_view path) const
+    {
+        const std::string normalized = pack_normalize(path);
+        const uint64 hash = pack_hash(normalized);
+
+        const pack_entry* end = m_entries + m_header->entryCount;
+        auto it = std::lower_bound(m_entries, end, hash, [](const pack_entry& entry, uint64 value) { return entry.hash < value; });
+
+        // Different paths can share a hash, so the names of all entries with the hash need to be compared.
+        for (; it != end && it->hash == hash; ++it)
+            if (name_of(*it) == normalized)
+                return it;
+
+        return nullptr;
+    }
+
+    std::string_view pack_archive::name_of(const pack_entry& entry) const noexcept
+    {
+        return std::string_view(m_names + entry.nameOffset, entry.nameSize);
+    }
+
+    bool pack_archive::is_directory(std::string_view path) const
+    {
+        return m_directories.count(pack_normalize(path)) != 0;
+    }
+
+    const std::set<std::string>& pack_archive::list(std::string_view path) const
+    {
+        auto it = m_directories.find(pack_normalize(path));
+        return it == m_directories.end() ? empty_listing : it->second;
+    }
+
+    common::result<basic_resource, fs_error> pack_archive::read(const pack_entry& entry) const
+    {
+        OPTICK_EVENT();
+        using common::Err, common::Ok;
+
+        const byte* stored = m_data + entry.offset;
+
+        switch (entry.codec)
+        {
+        case pack_codec::none:
+            if (entry.storedSize != entry.size)
+                return Err(legion_fs_error("corrupt pack entry, stored size doesn't match size"));
+            return Ok(basic_resource(byte_vec(stored, stored + entry.storedSize)));
+        case pack_codec::lz4:
+        {
+            byte_vec data(entry.size);
+            if (!lz4::decompress(stored, entry.storedSize, data.data(), data.size()))
+                return Err(legion_fs_error("corrupt pack entry, failed to decompress"));
+            return Ok(basic_resource(std::move(data)));
+        }
+        default:
+            return Err(legion_fs_error("unknown pack codec"));
+        }
+    }
+
+    void pack_writer::add(std::string_view path, byte_vec data)
+    {
+        m_files[pack_normalize(path)] = std::move(data);
+    }
+
+    byte_vec pack_writer::build() const
+    {
+        OPTICK_EVENT();
+        struct pending
+        {
+            const std::string* name;
+            const byte_vec* data;
+            uint64 hash;
+        };
+
+        std::vector<pending> files;
+        files.reserve(m_files.size());
+        for (auto& [name, data] : m_files)
+            files.push_back({ &name, &data, pack_hash(name) });
+
+        std::sort(files.begin(), files.end(), [](const pending& a, const pending& b) { return a.hash != b.hash ? a.hash < b.hash : *a.name < *b.name; });
+
+        // Offsets are aligned with a bit-mask, so round the requested alignment up to the next power of 2.
+        size_type alignment = 1;
+        while (alignment < m_alignment)
+            alignment <<= 1;
+
+        byte_vec result(sizeof(pack_header));
+        std::vector<pack_entry> entries(files.size());
+        std::string names;
+        byte_vec compressed;
+
+        for (size_type i = 0; i < files.size(); i++)
+        {
+            const byte_vec& data = *files[i].data;
+            pack_entry& entry = entries[i];
+            entry = {};
+            entry.hash = files[i].hash;
+            entry.size = data.size();
+            entry.nameOffset = static_cast<uint32>(names.size());
+            entry.nameSize = static_cast<uint32>(files[i].name->size());
+            names += *files[i].name;
+
+            const byte* stored = data.data();
+            entry.storedSize = data.size();
+            entry.codec = pack_codec::none;
+
+            if (m_compress && !data.empty())
+            {
+                compressed.resize(lz4::compress_bound(data.size()));
+                const size_type compressedSize = lz4::compress(data.data(), data.size(), compressed.data());
+                if (compressedSize < data.size())
+                {
+                    stored = compressed.data();
+                    entry.storedSize = compressedSize;
+                    entry.codec = pack_codec::lz4;
+                }
+            }
+
+            entry.offset = align_to(result.size(), alignment);
+            result.resize(entry.offset);
+            result.insert(result.end(), stored, stored + entry.storedSize);
+        }
+
+        pack_header header{};
+        header.magic = pack_header::magic_value;
+        header.version = pack_header::current_version;
+        header.entryCount = static_cast<uint32>(entries.size());
+        header.alignment = static_cast<uint32>(alignment);
+
+        header.indexOffset = align_to(result.size(), alignof(pack_entry));
+        result.resize(header.indexOffset);
+        const byte* index = reinterpret_cast<const byte*>(entries.data());
+        result.insert(result.end(), index, index + entries.size() * sizeof(pack_entry));
+
+        header.namesOffset = result.size();
+        header.namesSize = names.size();
+        result.insert(result.end(), names.begin(), names.end());
+
+        std::memcpy(result.data(), &header, sizeof(header));
+        return result;
+    }
+}
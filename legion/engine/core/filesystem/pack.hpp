@@ -0,0 +1,155 @@
+#pragma once
+#include <core/types/primitives.hpp>
+#include <core/platform/platform.hpp>
+#include <core/common/result.hpp>
+#include <core/common/exception.hpp>
+#include <core/filesystem/resource.hpp>
+
+#include <memory>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file pack.hpp
+ * @brief Packed archive format, many files in a single file with an index that can be searched without reading the rest.
+ *        Layout: pack_header, the data of every entry (each aligned and optionally compressed), the index of pack_entry
+ *        sorted by path hash, and finally the names of all entries. Paths inside a pack always use '/' as separator.
+ */
+
+namespace legion::core::filesystem
+{
+    enum struct pack_codec : uint8
+    {
+        none,
+        lz4
+    };
+
+    struct pack_header
+    {
+        static constexpr uint32 magic_value = 0x4B504C4C; // "LLPK"
+        static constexpr uint32 current_version = 1;
+
+        uint32 magic;
+        uint32 version;
+        uint32 entryCount;
+        uint32 alignment;
+        uint64 indexOffset;
+        uint64 namesOffset;
+        uint64 namesSize;
+    };
+
+    struct pack_entry
+    {
+        uint64 hash;
+        uint64 offset;
+        uint64 storedSize;
+        uint64 size;
+        uint32 nameOffset;
+        uint32 nameSize;
+        pack_codec codec;
+        byte padding[7];
+    };
+
+    /**@brief Hash of a path inside a pack, FNV-1a over the normalized path.
+     */
+    L_NODISCARD uint64 pack_hash(std::string_view path) noexcept;
+
+    /**@brief Turns a path into the form used inside packs, '/' separated without leading or trailing separators.
+     */
+    L_NODISCARD std::string pack_normalize(std::string_view path);
+
+    /**@class pack_archive
+     * @brief Read access to a pack, either memory mapped from disk or from a buffer in memory.
+     *        Only the entries that get read are decompressed, the rest of the pack never gets touched.
+     */
+    class pack_archive
+    {
+    public:
+        pack_archive(const pack_archive&) = delete;
+        pack_archive& operator=(const pack_archive&) = delete;
+        ~pack_archive();
+
+        /**@brief Maps a pack on disk. Packs stay mapped and get reused until the file changes on disk.
+         * @param [in] path Absolute path to the pack.
+         * @return Null when the file can't be mapped or isn't a valid pack.
+         */
+        L_NODISCARD static std::shared_ptr<const pack_archive> open(const std::string& path);
+
+        /**@brief Reads a pack from memory without copying it, data needs to stay alive and unchanged as long as the archive.
+         * @return Null when the data isn't a valid pack.
+         */
+        L_NODISCARD static std::shared_ptr<const pack_archive> from_memory(const byte* data, size_type size);
+
+        /**@brief Unmaps a pack opened with open, archives still in use stay valid until they're released.
+         */
+        static void close(const std::string& path);
+
+        L_NODISCARD const pack_header& header() const noexcept { return *m_header; }
+        L_NODISCARD size_type entry_count() const noexcept { return m_header->entryCount; }
+        L_NODISCARD const pack_entry& entry_at(size_type index) const noexcept { return m_entries[index]; }
+
+        /**@brief Finds an entry by it's path, using a binary search over the path hashes.
+         * @return Null if the pack has no file at that path.
+         */
+        L_NODISCARD const pack_entry* find(std::string_view path) const;
+
+        L_NODISCARD std::string_view name_of(const pack_entry& entry) const noexcept;
+
+        L_NODISCARD bool is_directory(std::string_view path) const;
+
+        /**@brief Direct children of a directory, both files and directories.
+         */
+        L_NODISCARD const std::set<std::string>& list(std::string_view path) const;
+
+        /**@brief Reads and if needed decompresses a single entry.
+         */
+        L_NODISCARD common::result<basic_resource, fs_error> read(const pack_entry& entry) const;
+
+    private:
+        pack_archive() = default;
+
+        bool parse();
+
+        const byte* m_data = nullptr;
+        size_type m_size = 0;
+        void* m_mapping = nullptr;
+
+        const pack_header* m_header = nullptr;
+        const pack_entry* m_entries = nullptr;
+        const char* m_names = nullptr;
+
+        std::unordered_map<std::string, std::set<std::string>> m_directories;
+    };
+
+    /**@class pack_writer
+     * @brief Builds packs, used by the packer tool.
+     */
+    class pack_writer
+    {
+    public:
+        static constexpr uint32 default_alignment = 16;
+
+        /**@param alignment Alignment of the data of each entry within the pack, rounded up to the next power of 2.
+         * @param compress Whether entries should be compressed, entries that don't get smaller are always stored uncompressed.
+         */
+        explicit pack_writer(uint32 alignment = default_alignment, bool compress = true) : m_alignment(alignment), m_compress(compress) {}
+
+        /**@brief Adds a file to the pack, replaces earlier files with the same path.
+         */
+        void add(std::string_view path, byte_vec data);
+
+        L_NODISCARD size_type size() const noexcept { return m_files.size(); }
+
+        /**@brief Builds the pack.
+         */
+        L_NODISCARD byte_vec build() const;
+
+    private:
+        uint32 m_alignment;
+        bool m_compress;
+        std::unordered_map<std::string, byte_vec> m_files;
+    };
+}
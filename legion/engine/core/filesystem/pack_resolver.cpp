@@ -0,0 +1,99 @@
+#include "pack_resolver.hpp"
+
+namespace legion::core::filesystem
+{
+    bool pack_resolver::is_file() const noexcept
+    {
+        auto* pack = archive();
+        return pack && pack->find(get_target()) != nullptr;
+    }
+
+    bool pack_resolver::is_directory() const noexcept
+    {
+        auto* pack = archive();
+        return pack && pack->is_directory(get_target());
+    }
+
+    bool pack_resolver::is_valid() const noexcept
+    {
+        return archive() != nullptr;
+    }
+
+    std::set<std::string> pack_resolver::ls() const noexcept
+    {
+        std::set<std::string> entries;
+
+        auto* pack = archive();
+        if (!pack)
+            return entries;
+
+        for (auto& entry : pack->list(get_target()))
+            entries.insert(strpath_manip::subdir(get_identifier(), entry));
+        return entries;
+    }
+
+    common::result<basic_resource, fs_error> pack_resolver::get(interfaces::implement_signal_t) noexcept
+    {
+        using common::Err;
+
+        auto* pack = archive();
+        if (!pack) return Err(legion_fs_error("pack could not be opened"));
+
+        auto* entry = pack->find(get_target());
+        if (!entry) return Err(legion_fs_error("file does not exist in pack, cannot read"));
+
+        return pack->read(*entry);
+    }
+
+    common::result<const basic_resource, fs_error> pack_resolver::get(interfaces::implement_signal_t) const noexcept
+    {
+        using common::Err, common::Ok;
+
+        auto* pack = archive();
+        if (!pack) return Err(legion_fs_error("pack could not be opened"));
+
+        auto* entry = pack->find(get_target());
+        if (!entry) return Err(legion_fs_error("file does not exist in pack, cannot read"));
+
+        auto result = pack->read(*entry);
+        if (result.has_err()) return Err(result.get_error());
+        return Ok<const basic_resource>(result.get());
+    }
+
+    common::result<void, fs_error> pack_resolver::set(interfaces::implement_signal_t, const basic_resource& res)
+    {
+        (void)res;
+        return common::Err(legion_fs_error("packs are read only, rebuild the pack with the packer instead"));
+    }
+
+    bool pack_resolver::set_disk_path(const std::string& path)
+    {
+        m_archive = pack_archive::open(path);
+        return m_archive != nullptr;
+    }
+
+    void pack_resolver::build_memory_representation(std::shared_ptr<const byte_vec> in, std::shared_ptr<byte_vec> out) const
+    {
+        // Packs are already built for random access, the only thing left to do is to keep them in memory.
+        out->assign(in->begin(), in->end());
+    }
+
+    std::size_t pack_resolver::size_hint(std::shared_ptr<const byte_vec> in) const
+    {
+        return in ? in->size() : 0;
+    }
+
+    const pack_archive* pack_resolver::archive() const noexcept
+    {
+        if (!m_archive)
+        {
+            if (!prewarm())
+                return nullptr;
+
+            // The memory representation lives in the artifact cache and is kept alive by this resolver.
+            const byte_vec& data = get_data();
+            m_archive = pack_archive::from_memory(data.data(), data.size());
+        }
+        return m_archive.get();
+    }
+}
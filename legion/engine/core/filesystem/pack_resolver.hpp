@@ -0,0 +1,56 @@
+#pragma once
+#include <core/filesystem/mem_filesystem_resolver.hpp>
+#include <core/filesystem/pack.hpp>
+
+/**
+ * @file pack_resolver.hpp
+ */
+
+namespace legion::core::filesystem
+{
+    /**@class pack_resolver
+     * @brief Read only resolver for packs, register it for the extension of your packs to access files within them.
+     *        Packs on disk get memory mapped and only the requested entry is read, packs nested in other archives are
+     *        read from the memory representation of the containing archive.
+     * @note The CoreModule registers it for ".lpk".
+     */
+    class pack_resolver final : public mem_filesystem_resolver
+    {
+    public:
+        pack_resolver() : mem_filesystem_resolver(nullptr) {}
+
+        L_NODISCARD bool is_file() const noexcept override;
+        L_NODISCARD bool is_directory() const noexcept override;
+        L_NODISCARD bool is_valid() const noexcept override;
+        L_NODISCARD bool writeable() const noexcept override { return false; }
+        L_NODISCARD bool readable() const noexcept override { return is_file(); }
+        L_NODISCARD bool creatable() const noexcept override { return false; }
+        L_NODISCARD bool exists() const noexcept override { return is_file() || is_directory(); }
+
+        L_NODISCARD std::set<std::string> ls() const noexcept override;
+
+        common::result<basic_resource, fs_error> get(interfaces::implement_signal_t) noexcept override;
+        common::result<const basic_resource, fs_error> get(interfaces::implement_signal_t) const noexcept override;
+
+        common::result<void, fs_error> set(interfaces::implement_signal_t, const basic_resource& res) override;
+        void erase(interfaces::implement_signal_t) const noexcept override {}
+
+        bool set_disk_path(const std::string& path) override;
+
+        L_NODISCARD mem_filesystem_resolver* make_higher() override
+        {
+            return new pack_resolver();
+        }
+
+    protected:
+        void build_memory_representation(std::shared_ptr<const byte_vec> in, std::shared_ptr<byte_vec> out) const override;
+        std::size_t size_hint(std::shared_ptr<const byte_vec> in) const override;
+
+    private:
+        /**@brief The mapped pack, or the pack in the memory representation when it was provided through set_disk_data.
+         */
+        const pack_archive* archive() const noexcept;
+
+        mutable std::shared_ptr<const pack_archive> m_archive;
+    };
+}
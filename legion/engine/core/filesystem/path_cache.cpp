@@ -0,0 +1,153 @@
+#include <core/filesystem/path_cache.hpp>
+#include <core/filesystem/detail/strpath_manip.hpp>
+#include <core/profiling/profiler.hpp>
+
+#include <filesystem>
+
+namespace legion::core::filesystem
+{
+    async::rw_spinlock path_cache::m_resolvedLock;
+    std::unordered_map<id_type, path_cache::resolved_ptr> path_cache::m_resolved;
+
+    async::rw_spinlock path_cache::m_diskLock;
+    std::unordered_map<std::string, disk_stat> path_cache::m_stats;
+    std::unordered_map<std::string, path_cache::listing_ptr> path_cache::m_listings;
+
+    std::string path_cache::disk_key(const std::string& absolutePath)
+    {
+        std::string key = strpath_manip::localize(absolutePath);
+
+        // Keep the root of the filesystem intact, "/" and "C:\" need their separator.
+        while (key.size() > 1 && key.back() == strpath_manip::separator() && key[key.size() - 2] != ':')
+            key.pop_back();
+        return key;
+    }
+
+    common::result<path_cache::resolved_ptr, fs_error> path_cache::resolve(const std::string& path, id_type hash)
+    {
+        OPTICK_EVENT();
+        using common::Ok;
+
+        {
+            async::readonly_guard guard(m_resolvedLock);
+            auto it = m_resolved.find(hash);
+            if (it != m_resolved.end() && it->second->path == path)
+                return Ok(it->second);
+        }
+
+        const navigator n(path);
+        auto solution = n.find_solution();
+        if (solution.has_err())
+            return Err_of(solution);
+
+        auto resolved = std::make_shared<resolved_path>();
+        resolved->path = path;
+        resolved->hash = hash;
+        resolved->solution = solution.get();
+
+        async::readwrite_guard guard(m_resolvedLock);
+        // On a hash collision the path that was there first keeps the slot, the other one just doesn't get cached.
+        auto [it, inserted] = m_resolved.emplace(hash, resolved);
+        if (!inserted && it->second->path == path)
+            return Ok(it->second);
+        return Ok(resolved_ptr(std::move(resolved)));
+    }
+
+    disk_stat path_cache::stat(const std::string& absolutePath)
+    {
+        OPTICK_EVENT();
+        std::string key = disk_key(absolutePath);
+
+        {
+            async::readonly_guard guard(m_diskLock);
+            auto it = m_stats.find(key);
+            if (it != m_stats.end())
+                return it->second;
+        }
+
+        // A single status call gives everything the resolvers ask for.
+        std::error_code error;
+        const auto status = std::filesystem::status(key, error);
+
+        disk_stat result;
+        result.exists = !error && std::filesystem::exists(status);
+        result.is_file = result.exists && std::filesystem::is_regular_file(status);
+        result.is_directory = result.exists && std::filesystem::is_directory(status);
+
+        async::readwrite_guard guard(m_diskLock);
+        m_stats.insert_or_assign(std::move(key), result);
+        return result;
+    }
+
+    path_cache::listing_ptr path_cache::list(const std::string& absolutePath)
+    {
+        OPTICK_EVENT();
+        std::string key = disk_key(absolutePath);
+
+        {
+            async::readonly_guard guard(m_diskLock);
+            auto it = m_listings.find(key);
+            if (it != m_listings.end())
+                return it->second;
+        }
+
+        auto entries = std::make_shared<std::vector<std::string>>();
+
+        std::error_code error;
+        for (std::filesystem::directory_iterator iter(key, error), end; !error && iter != end; iter.increment(error))
+            entries->push_back(iter->path().string());
+
+        async::readwrite_guard guard(m_diskLock);
+        auto [it, inserted] = m_listings.insert_or_assign(std::move(key), listing_ptr(std::move(entries)));
+        return it->second;
+    }
+
+    void path_cache::invalidate(const std::string& absolutePath)
+    {
+        OPTICK_EVENT();
+        std::string key = disk_key(absolutePath);
+
+        async::readwrite_guard guard(m_diskLock);
+        m_stats.erase(key);
+        m_listings.erase(key);
+
+        // Walk up until a directory that is known to exist, everything below it might have been created.
+        while (true)
+        {
+            std::string parent = disk_key(strpath_manip::parent(key));
+            if (parent.empty() || parent == key)
+                break;
+
+            m_listings.erase(parent);
+
+            auto it = m_stats.find(parent);
+            if (it != m_stats.end())
+            {
+                if (it->second.exists)
+                    break;
+                m_stats.erase(it);
+            }
+
+            key = std::move(parent);
+        }
+    }
+
+    void path_cache::flush_resolutions()
+    {
+        async::readwrite_guard guard(m_resolvedLock);
+        m_resolved.clear();
+    }
+
+    void path_cache::flush_disk()
+    {
+        async::readwrite_guard guard(m_diskLock);
+        m_stats.clear();
+        m_listings.clear();
+    }
+
+    void path_cache::flush()
+    {
+        flush_resolutions();
+        flush_disk();
+    }
+}
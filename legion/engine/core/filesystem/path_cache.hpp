@@ -0,0 +1,98 @@
+#pragma once
+#include <core/platform/platform.hpp>
+#include <core/types/primitives.hpp>
+#include <core/async/rw_spinlock.hpp>
+#include <core/common/result.hpp>
+#include <core/common/exception.hpp>
+#include <core/filesystem/navigator.hpp>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file path_cache.hpp
+ * @brief Caches the work the virtual filesystem would otherwise repeat for every access to the same path:
+ *        resolving virtual paths with the navigator, and stats and directory listings of files on disk.
+ *        Disk entries get invalidated when they're written through the filesystem or reported by the hot-reload file watcher,
+ *        files changed in any other way need an explicit flush.
+ */
+
+namespace legion::core::filesystem
+{
+    /**@brief Result of a stat of a path on disk.
+     */
+    struct disk_stat
+    {
+        bool exists;
+        bool is_file;
+        bool is_directory;
+    };
+
+    /**@brief Interned virtual path, together with it's hash and the solution the navigator found for it.
+     */
+    struct resolved_path
+    {
+        std::string path;
+        id_type hash;
+        navigator::solution solution;
+    };
+
+    /**@class path_cache
+     * @brief Static cache of resolved virtual paths and of disk stats used by the resolvers.
+     */
+    class path_cache
+    {
+    public:
+        using resolved_ptr = std::shared_ptr<const resolved_path>;
+        using listing_ptr = std::shared_ptr<const std::vector<std::string>>;
+
+    private:
+        static async::rw_spinlock m_resolvedLock;
+        static std::unordered_map<id_type, resolved_ptr> m_resolved;
+
+        static async::rw_spinlock m_diskLock;
+        static std::unordered_map<std::string, disk_stat> m_stats;
+        static std::unordered_map<std::string, listing_ptr> m_listings;
+
+        L_NODISCARD static std::string disk_key(const std::string& absolutePath);
+
+    public:
+        path_cache() = delete;
+        ~path_cache() = delete;
+
+        /**@brief Resolves a virtual path, only the first resolution of a path goes through the navigator.
+         * @param path Localized virtual path.
+         * @param hash nameHash of the path.
+         * @note Failed resolutions aren't cached, the domain might still get registered.
+         */
+        L_NODISCARD static common::result<resolved_ptr, fs_error> resolve(const std::string& path, id_type hash);
+
+        /**@brief Stats a path on disk, only the first stat of a path touches the disk.
+         * @param absolutePath Absolute path, trailing separators are ignored.
+         */
+        L_NODISCARD static disk_stat stat(const std::string& absolutePath);
+
+        /**@brief Absolute paths of all entries in a directory on disk, empty if the path isn't a directory.
+         */
+        L_NODISCARD static listing_ptr list(const std::string& absolutePath);
+
+        /**@brief Drops the cached stat and listing of a path on disk, as well as the listings of the directories containing it.
+         *        Directories above it that were cached as missing get dropped as well, since they might have been created along with it.
+         */
+        static void invalidate(const std::string& absolutePath);
+
+        /**@brief Drops all resolved paths, needs to happen whenever the registered domains change.
+         */
+        static void flush_resolutions();
+
+        /**@brief Drops all stats and listings of paths on disk.
+         */
+        static void flush_disk();
+
+        /**@brief Drops everything.
+         */
+        static void flush();
+    };
+}
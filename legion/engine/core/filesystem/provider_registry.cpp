@@ -4,6 +4,7 @@
 #include <core/platform/platform.hpp>
 #include <core/logging/logging.hpp>
 #include <core/filesystem/basic_resolver.hpp>
+#include <core/filesystem/path_cache.hpp>
 
 namespace legion::core::filesystem
 {
@@ -94,6 +95,9 @@ namespace legion::core::filesystem
 		//insert a resolver
 		auto itr = driver.m_domain_resolver_map->emplace(strpath_manip::localize(d),std::unique_ptr<resolver>(r));
         itr->second->set_identifier(d);
+
+        //paths that previously failed to resolve or resolved to other resolvers might resolve differently now
+        path_cache::flush_resolutions();
 	}
 
 	std::vector<provider_registry::resolver_ptr> provider_registry::domain_get_resolvers(domain d)
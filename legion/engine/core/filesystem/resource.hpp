@@ -4,7 +4,7 @@
 
 #include <string_view>                // std::string_view
 
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
 
 #include "detail/resource_meta.hpp"   //has_to_resource<T,Sig>, has_from_resource<T,Sig>
 
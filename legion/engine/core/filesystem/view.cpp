@@ -3,9 +3,11 @@
 #include <filesystem>
 
 #include "navigator.hpp"
+#include "basic_resolver.hpp"
 #include "provider_registry.hpp"
 #include "detail/strpath_manip.hpp"
 #include <core/logging/logging.hpp>
+#include <core/types/type_util.hpp>
 
 
 namespace legion::core::filesystem
@@ -20,14 +22,16 @@ namespace legion::core::filesystem
         OPTICK_EVENT();
         //check if path is non empty & if 
         if (m_path.empty()) return false;
+
+        //a path that was resolved before passes both checks
+        if (m_resolved) return true;
         if (!provider_registry::has_domain(get_domain())) return false;
 
         //if deep checking also check if the path meets the requirements of the
         //navigator system
         if (deep_check)
         {
-            const navigator n(m_path);
-            if (n.find_solution().has_err()) return false;
+            if (make_solution().has_err()) return false;
         }
 
         return true;
@@ -263,12 +267,12 @@ namespace legion::core::filesystem
         return decay(Err(legion_fs_error("invalid file traits: (not valid) or (does not exist) or (cannot be read)")));
     }
 
-    std::string view::create_identifier(const navigator::solution::iterator& e) const
+    std::string view::create_identifier(const navigator::solution::const_iterator& e) const
     {
         OPTICK_EVENT();
         //iterate through path and create the ident for the provider
         std::string result;
-        for (auto iter = m_foundSolution.begin(); iter != e; ++iter)
+        for (auto iter = m_resolved->solution.begin(); iter != e; ++iter)
         {
             result += iter->second;
         }
@@ -281,16 +285,16 @@ namespace legion::core::filesystem
     {
         OPTICK_EVENT();
         //first check if a solution even exists
-        if (m_foundSolution.size() == 0)
+        if (!m_resolved || m_resolved->solution.empty())
         {
             return nullptr;
         }
 
 
         //second check if we even need to to resolution
-        if (m_foundSolution.size() == 1)
+        if (m_resolved->solution.size() == 1)
         {
-            auto& [r, path] = m_foundSolution.front();
+            auto& [r, path] = m_resolved->solution.front();
 
             auto resolver = std::shared_ptr<filesystem_resolver>(r->make());
             resolver->set_target(path);
@@ -303,27 +307,32 @@ namespace legion::core::filesystem
 
         if (!chain) return nullptr;
 
-        //traverse resolution chain
-        for (; chain->next != nullptr; chain = chain->next)
+        const auto provide = [](create_chain& link)
         {
+            //containers directly on disk can be handed over by path, so that resolvers
+            //which support it only need to read the parts of the container they use
+            if (auto* disk = dynamic_cast<basic_resolver*>(link.provider.get()))
+            {
+                if (link.subject->set_disk_path(disk->get_absolute_path())) return true;
+            }
 
-            auto data = chain->provider->get();
-            if (data.has_err()) return nullptr;
+            auto data = link.provider->get();
+            if (data.has_err()) return false;
 
             //convert result -> resource -> data
             //and set as disk dat for subject
-            chain->subject->set_disk_data(data.get().get());
+            link.subject->set_disk_data(data.get().get());
+            return true;
+        };
 
+        //traverse resolution chain
+        for (; chain->next != nullptr; chain = chain->next)
+        {
+            if (!provide(*chain)) return nullptr;
         }
 
         //do it one last time for the last subject
-
-        auto data = chain->provider->get();
-        if (data.has_err()) return nullptr;
-
-        //convert result -> resource -> data
-        //and set as disk dat for subject
-        chain->subject->set_disk_data(data.get().get());
+        if (!provide(*chain)) return nullptr;
 
         return chain->subject;
 
@@ -334,9 +343,10 @@ namespace legion::core::filesystem
     {
         OPTICK_EVENT();
         //make all higher level fs inherit the traits from the lower level
-        for (std::size_t i = 0; i < m_foundSolution.size() - 1; ++i)
+        const auto& solution = m_resolved->solution;
+        for (std::size_t i = 0; i < solution.size() - 1; ++i)
         {
-            m_foundSolution.at(i + 1).first->inherit(*m_foundSolution.at(i).first);
+            solution.at(i + 1).first->inherit(*solution.at(i).first);
         }
     }
 
@@ -349,7 +359,8 @@ namespace legion::core::filesystem
 
         make_inheritance();
 
-        for (auto iter = m_foundSolution.rbegin(); iter != m_foundSolution.rend(); ++iter)
+        const auto& solution = m_resolved->solution;
+        for (auto iter = solution.rbegin(); iter != solution.rend(); ++iter)
         {
             std::string identifier = create_identifier((iter + 1).base());
             auto& [resolver, resolver_path] = *iter;
@@ -357,7 +368,7 @@ namespace legion::core::filesystem
 
 
             //we expect the first element to be valid no matter what if it isn't we have a deeper problem
-            if (iter != m_foundSolution.rend() - 1)
+            if (iter != solution.rend() - 1)
             {
                 auto* memory_resolver = dynamic_cast<mem_filesystem_resolver*>(resolver);
 
@@ -413,17 +424,15 @@ namespace legion::core::filesystem
         using common::Ok;
 
         //check if a solution already exists
-        if (m_foundSolution.empty())
+        if (!m_resolved)
         {
+            //get the interned solution, the navigator only runs the first time a path is resolved
+            auto resolved = path_cache::resolve(m_path, nameHash(m_path));
 
-            //create solution using navigator
-            const navigator n(m_path);
-            auto solution = n.find_solution();
-
-            if (solution.has_err())
-                return Err_of(solution);
+            if (resolved.has_err())
+                return Err_of(resolved);
 
-            m_foundSolution = solution.get();
+            m_resolved = resolved.get();
         }
         //return empty ok
         return Ok();
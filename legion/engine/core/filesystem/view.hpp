@@ -5,10 +5,11 @@
 
 #include <core/common/exception.hpp>
 
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
 
 #include "mem_filesystem_resolver.hpp"
 #include "navigator.hpp"
+#include "path_cache.hpp"
 #include "detail/traits.hpp"
 
 namespace legion::core::filesystem
@@ -124,7 +125,7 @@ namespace legion::core::filesystem
         view() = default;
         std::string m_path;
 
-        std::string create_identifier(const navigator::solution::iterator&) const;
+        std::string create_identifier(const navigator::solution::const_iterator&) const;
         std::shared_ptr<filesystem_resolver> build() const;
 
         struct create_chain
@@ -141,7 +142,8 @@ namespace legion::core::filesystem
 
         common::result<void,fs_error> make_solution() const;
 
-        mutable navigator::solution m_foundSolution{};
+        //interned solution, shared by all views onto the same path
+        mutable path_cache::resolved_ptr m_resolved;
     };
 
 
@@ -0,0 +1,188 @@
+#include <core/math/batch.hpp>
+
+#include <atomic>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#include <core/math/batch_kernels.inl>
+
+namespace legion::core::math::batch
+{
+    namespace detail
+    {
+#if defined(LEGION_BATCH_AVX2)
+        // Defined in batch_avx2.cpp, which is the only translation unit compiled for AVX2.
+        extern const kernel_table avx2_kernels;
+#endif
+    }
+
+    namespace
+    {
+        constexpr kernel_table scalar_kernels = make_kernel_table<scalar_lanes>();
+#if defined(LEGION_BATCH_SSE)
+        constexpr kernel_table sse_kernels = make_kernel_table<sse_lanes>();
+#endif
+
+        simd_level detect_simd_level()
+        {
+#if defined(LEGION_BATCH_AVX2)
+#if defined(_MSC_VER)
+            int info[4];
+            __cpuid(info, 0);
+            if (info[0] >= 7)
+            {
+                __cpuid(info, 1);
+                const bool osxsave = (info[2] & (1 << 27)) != 0;
+                const bool avx = (info[2] & (1 << 28)) != 0;
+
+                __cpuidex(info, 7, 0);
+                const bool avx2 = (info[1] & (1 << 5)) != 0;
+
+                // The OS needs to save the upper halves of the ymm registers on context switches as well.
+                if (osxsave && avx && avx2 && (_xgetbv(0) & 0x6) == 0x6)
+                    return simd_level::avx2;
+            }
+#else
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2"))
+                return simd_level::avx2;
+#endif
+#endif
+
+#if defined(LEGION_BATCH_SSE)
+            return simd_level::sse;
+#else
+            return simd_level::scalar;
+#endif
+        }
+
+        const kernel_table* table_of(simd_level level)
+        {
+            switch (level)
+            {
+#if defined(LEGION_BATCH_AVX2)
+            case simd_level::avx2:
+                return &detail::avx2_kernels;
+#endif
+#if defined(LEGION_BATCH_SSE)
+            case simd_level::sse:
+                return &sse_kernels;
+#endif
+            default:
+                return &scalar_kernels;
+            }
+        }
+
+        struct dispatch_state
+        {
+            simd_level supported;
+            std::atomic<simd_level> active;
+            std::atomic<const kernel_table*> kernels;
+
+            dispatch_state() : supported(detect_simd_level()), active(supported), kernels(table_of(supported)) {}
+        };
+
+        dispatch_state& state()
+        {
+            static dispatch_state instance;
+            return instance;
+        }
+
+        const kernel_table& kernels()
+        {
+            return *state().kernels.load(std::memory_order_relaxed);
+        }
+    }
+
+    simd_level supported_simd_level()
+    {
+        return state().supported;
+    }
+
+    simd_level active_simd_level()
+    {
+        return state().active.load(std::memory_order_relaxed);
+    }
+
+    void set_simd_level(simd_level level)
+    {
+        auto& dispatch = state();
+        if (static_cast<uint8>(level) > static_cast<uint8>(dispatch.supported))
+            level = dispatch.supported;
+
+        dispatch.active.store(level, std::memory_order_relaxed);
+        dispatch.kernels.store(table_of(level), std::memory_order_relaxed);
+    }
+
+    cstring to_string(simd_level level)
+    {
+        switch (level)
+        {
+        case simd_level::avx2:
+            return "avx2";
+        case simd_level::sse:
+            return "sse";
+        default:
+            return "scalar";
+        }
+    }
+
+    void compose(size_type count, const trs_arrays& transforms, mat4* out)
+    {
+        kernels().compose(count, transforms, out);
+    }
+
+    void transform_points(const mat4& transform, size_type count, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ)
+    {
+        kernels().transform_points(transform, count, x, y, z, outX, outY, outZ);
+    }
+
+    void transformed_bounds(const mat4& transform, size_type count, const vec3* points, vec3& min, vec3& max)
+    {
+        kernels().transformed_bounds(transform, count, points, min, max);
+    }
+
+    void world_aabbs(size_type count, const mat4* transforms, const vec3* localMin, const vec3* localMax, vec3* worldMin, vec3* worldMax)
+    {
+        kernels().world_aabbs(count, transforms, localMin, localMax, worldMin, worldMax);
+    }
+
+    void cull_spheres(const frustum& frustum, size_type count, const float* x, const float* y, const float* z, const float* radius, uint8* visible)
+    {
+        kernels().cull_spheres(frustum, count, x, y, z, radius, visible);
+    }
+
+    void cull_aabbs(const frustum& frustum, size_type count, const vec3* min, const vec3* max, uint8* visible)
+    {
+        kernels().cull_aabbs(frustum, count, min, max, visible);
+    }
+
+    frustum frustum::from_matrix(const mat4& viewProjection)
+    {
+        // Gribb-Hartmann, every plane is the sum or difference of the last row and one of the others.
+        const vec4 rows[4] = {
+            vec4(viewProjection[0][0], viewProjection[1][0], viewProjection[2][0], viewProjection[3][0]),
+            vec4(viewProjection[0][1], viewProjection[1][1], viewProjection[2][1], viewProjection[3][1]),
+            vec4(viewProjection[0][2], viewProjection[1][2], viewProjection[2][2], viewProjection[3][2]),
+            vec4(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3])
+        };
+
+        frustum result;
+        result.planes[0] = rows[3] + rows[0];
+        result.planes[1] = rows[3] - rows[0];
+        result.planes[2] = rows[3] + rows[1];
+        result.planes[3] = rows[3] - rows[1];
+        result.planes[4] = rows[3] + rows[2];
+        result.planes[5] = rows[3] - rows[2];
+
+        for (auto& plane : result.planes)
+            plane /= length(vec3(plane));
+
+        return result;
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <core/platform/platform.hpp>
+#include <core/types/primitives.hpp>
+#include <core/math/glm/glm_include.hpp>
+
+/**
+ * @file batch.hpp
+ * @brief Math routines that process many transforms, points or bounding volumes per call.
+ *        Inputs are structure of arrays wherever the caller can provide them, so that consecutive elements fill the lanes of a
+ *        SIMD register. Every routine has a scalar, an SSE and an AVX2 implementation, the widest one the CPU supports gets
+ *        selected the first time a routine is called. Results of all implementations are equal up to floating point rounding.
+ */
+
+namespace legion::core::math::batch
+{
+    enum struct simd_level : uint8
+    {
+        scalar,
+        sse,
+        avx2
+    };
+
+    /**@brief Widest instruction set both the CPU and the build support.
+     */
+    L_NODISCARD simd_level supported_simd_level();
+
+    /**@brief Instruction set the batch routines currently use.
+     */
+    L_NODISCARD simd_level active_simd_level();
+
+    /**@brief Forces the batch routines to a narrower instruction set, mainly to compare implementations.
+     *        Levels the CPU doesn't support get clamped to the supported level.
+     */
+    void set_simd_level(simd_level level);
+
+    L_NODISCARD cstring to_string(simd_level level);
+
+    /**@class trs_arrays
+     * @brief Structure of arrays of translation, rotation (quaternion) and scale.
+     */
+    struct trs_arrays
+    {
+        const float* px; const float* py; const float* pz;
+        const float* rx; const float* ry; const float* rz; const float* rw;
+        const float* sx; const float* sy; const float* sz;
+    };
+
+    /**@brief Composes count TRS transforms into matrices, equal to math::compose(scale, rotation, position) for every element.
+     */
+    void compose(size_type count, const trs_arrays& transforms, mat4* out);
+
+    /**@brief Transforms count points stored as separate x, y and z arrays.
+     *        The output arrays may be the same as the input arrays.
+     */
+    void transform_points(const mat4& transform, size_type count, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ);
+
+    /**@brief World space bounds of a set of points, e.g. the vertices of a convex hull.
+     * @param min Output, unchanged if count is 0.
+     * @param max Output, unchanged if count is 0.
+     */
+    void transformed_bounds(const mat4& transform, size_type count, const vec3* points, vec3& min, vec3& max);
+
+    /**@brief Smallest world space AABBs containing the transformed local space AABBs.
+     */
+    void world_aabbs(size_type count, const mat4* transforms, const vec3* localMin, const vec3* localMax, vec3* worldMin, vec3* worldMax);
+
+    /**@class frustum
+     * @brief Six inward facing planes, xyz is the normal and w the distance from the origin.
+     */
+    struct frustum
+    {
+        vec4 planes[6];
+
+        /**@brief Extracts the planes of a view-projection matrix, resulting in a world space frustum.
+         */
+        L_NODISCARD static frustum from_matrix(const mat4& viewProjection);
+    };
+
+    /**@brief Tests spheres against a frustum.
+     * @param visible Output, 1 for spheres that (might) intersect the frustum, 0 for spheres that certainly don't.
+     */
+    void cull_spheres(const frustum& frustum, size_type count, const float* x, const float* y, const float* z, const float* radius, uint8* visible);
+
+    /**@brief Tests AABBs against a frustum.
+     * @param visible Output, 1 for boxes that (might) intersect the frustum, 0 for boxes that certainly don't.
+     */
+    void cull_aabbs(const frustum& frustum, size_type count, const vec3* min, const vec3* max, uint8* visible);
+
+    /**@brief Table of implementations of the batch routines for a single instruction set.
+     */
+    struct kernel_table
+    {
+        void(*compose)(size_type, const trs_arrays&, mat4*);
+        void(*transform_points)(const mat4&, size_type, const float*, const float*, const float*, float*, float*, float*);
+        void(*transformed_bounds)(const mat4&, size_type, const vec3*, vec3&, vec3&);
+        void(*world_aabbs)(size_type, const mat4*, const vec3*, const vec3*, vec3*, vec3*);
+        void(*cull_spheres)(const frustum&, size_type, const float*, const float*, const float*, const float*, uint8*);
+        void(*cull_aabbs)(const frustum&, size_type, const vec3*, const vec3*, uint8*);
+    };
+}
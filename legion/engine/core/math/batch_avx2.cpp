@@ -0,0 +1,111 @@
+#include <core/math/batch.hpp>
+
+/**
+ * @file batch_avx2.cpp
+ * @brief AVX2 implementations of the batch math routines.
+ *        Only the code in the target region below gets compiled for AVX2, the rest of the engine keeps running on CPUs without it.
+ *        All headers need to be included before the region, otherwise inline functions from them could end up compiled for AVX2
+ *        and be picked by the linker for the rest of the engine. batch_kernels.inl is the one exception and gets included inside
+ *        the region on purpose: it doesn't include anything itself and its kernels are exactly what needs to be compiled for AVX2.
+ */
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+
+#if defined(__clang__)
+#pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#elif defined(__GNUC__)
+#pragma GCC push_options
+#pragma GCC target("avx2")
+#endif
+
+#include <core/math/batch_kernels.inl>
+
+namespace legion::core::math::batch
+{
+    namespace
+    {
+        struct avx2_lanes
+        {
+            using type = __m256;
+            static constexpr size_type width = 8;
+
+            static type combine(__m128 low, __m128 high) { return _mm256_insertf128_ps(_mm256_castps128_ps256(low), high, 1); }
+            static __m128 low(type value) { return _mm256_castps256_ps128(value); }
+            static __m128 high(type value) { return _mm256_extractf128_ps(value, 1); }
+
+            static type load(const float* ptr) { return _mm256_loadu_ps(ptr); }
+            static void store(float* ptr, type value) { _mm256_storeu_ps(ptr, value); }
+            static type splat(float value) { return _mm256_set1_ps(value); }
+            static type add(type a, type b) { return _mm256_add_ps(a, b); }
+            static type sub(type a, type b) { return _mm256_sub_ps(a, b); }
+            static type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+            static type min(type a, type b) { return _mm256_min_ps(a, b); }
+            static type max(type a, type b) { return _mm256_max_ps(a, b); }
+            static type abs(type a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+
+            static type greater_equal(type a, type b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+            static type mask_and(type a, type b) { return _mm256_and_ps(a, b); }
+            static void store_mask(uint8* out, type mask)
+            {
+                const int bits = _mm256_movemask_ps(mask);
+                for (int i = 0; i < 8; i++)
+                    out[i] = static_cast<uint8>((bits >> i) & 1);
+            }
+
+            static float reduce_min(type value) { return sse::reduce_min(_mm_min_ps(low(value), high(value))); }
+            static float reduce_max(type value) { return sse::reduce_max(_mm_max_ps(low(value), high(value))); }
+
+            // Packed data gets shuffled 4 elements at a time, the halves of the 256 bit registers hold elements 0-3 and 4-7.
+            static void load_vec3(const vec3* ptr, type& x, type& y, type& z)
+            {
+                __m128 x0, y0, z0, x1, y1, z1;
+                sse::load_vec3(ptr, x0, y0, z0);
+                sse::load_vec3(ptr + 4, x1, y1, z1);
+                x = combine(x0, x1);
+                y = combine(y0, y1);
+                z = combine(z0, z1);
+            }
+
+            static void store_vec3(vec3* ptr, type x, type y, type z)
+            {
+                sse::store_vec3(ptr, low(x), low(y), low(z));
+                sse::store_vec3(ptr + 4, high(x), high(y), high(z));
+            }
+
+            static void load_matrices(const mat4* ptr, type(&elements)[16])
+            {
+                __m128 first[16], second[16];
+                sse::load_matrices(ptr, first);
+                sse::load_matrices(ptr + 4, second);
+                for (int i = 0; i < 16; i++)
+                    elements[i] = combine(first[i], second[i]);
+            }
+
+            static void store_matrices(mat4* ptr, const type(&elements)[16])
+            {
+                __m128 first[16], second[16];
+                for (int i = 0; i < 16; i++)
+                {
+                    first[i] = low(elements[i]);
+                    second[i] = high(elements[i]);
+                }
+                sse::store_matrices(ptr, first);
+                sse::store_matrices(ptr + 4, second);
+            }
+        };
+    }
+
+    namespace detail
+    {
+        extern const kernel_table avx2_kernels = make_kernel_table<avx2_lanes>();
+    }
+}
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#elif defined(__GNUC__)
+#pragma GCC pop_options
+#endif
+
+#endif
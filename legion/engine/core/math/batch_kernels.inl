@@ -0,0 +1,442 @@
+/**
+ * @file batch_kernels.inl
+ * @brief Implementations of the batch math routines, written once against a lane type that abstracts the instruction set.
+ *        Included by batch.cpp and batch_avx2.cpp after all headers, so that everything in here can be compiled for a
+ *        specific target. Everything lives in an anonymous namespace so the instantiations of different targets never mix.
+ */
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LEGION_BATCH_SSE
+// Every compiler that can target SSE can compile single functions for AVX2 as well, see batch_avx2.cpp.
+#define LEGION_BATCH_AVX2
+#endif
+
+namespace legion::core::math::batch
+{
+    static_assert(sizeof(vec3) == sizeof(float) * 3, "Batch routines expect tightly packed vec3s.");
+    static_assert(sizeof(mat4) == sizeof(float) * 16, "Batch routines expect tightly packed mat4s.");
+
+    namespace
+    {
+        /**@brief One element at a time, also processes the tails of the wider lane types.
+         */
+        struct scalar_lanes
+        {
+            using type = float;
+            static constexpr size_type width = 1;
+
+            static type load(const float* ptr) { return *ptr; }
+            static void store(float* ptr, type value) { *ptr = value; }
+            static type splat(float value) { return value; }
+            static type add(type a, type b) { return a + b; }
+            static type sub(type a, type b) { return a - b; }
+            static type mul(type a, type b) { return a * b; }
+            static type min(type a, type b) { return a < b ? a : b; }
+            static type max(type a, type b) { return a > b ? a : b; }
+            static type abs(type a) { return a < 0.f ? -a : a; }
+
+            // Masks are 1 or 0.
+            static type greater_equal(type a, type b) { return a >= b ? 1.f : 0.f; }
+            static type mask_and(type a, type b) { return a * b; }
+            static void store_mask(uint8* out, type mask) { *out = mask != 0.f; }
+
+            static float reduce_min(type value) { return value; }
+            static float reduce_max(type value) { return value; }
+
+            static void load_vec3(const vec3* ptr, type& x, type& y, type& z) { x = ptr->x; y = ptr->y; z = ptr->z; }
+            static void store_vec3(vec3* ptr, type x, type y, type z) { *ptr = vec3(x, y, z); }
+
+            // Matrix element [column][row] ends up at elements[column * 4 + row].
+            static void load_matrices(const mat4* ptr, type(&elements)[16])
+            {
+                for (int i = 0; i < 16; i++)
+                    elements[i] = (*ptr)[i / 4][i % 4];
+            }
+
+            static void store_matrices(mat4* ptr, const type(&elements)[16])
+            {
+                for (int i = 0; i < 16; i++)
+                    (*ptr)[i / 4][i % 4] = elements[i];
+            }
+        };
+
+#if defined(LEGION_BATCH_SSE)
+        namespace sse
+        {
+            // 4 packed vec3s (x0 y0 z0 x1 | y1 z1 x2 y2 | z2 x3 y3 z3) to 4 lanes of x, y and z.
+            inline void load_vec3(const vec3* ptr, __m128& x, __m128& y, __m128& z)
+            {
+                const float* data = reinterpret_cast<const float*>(ptr);
+                const __m128 a = _mm_loadu_ps(data);
+                const __m128 b = _mm_loadu_ps(data + 4);
+                const __m128 c = _mm_loadu_ps(data + 8);
+
+                x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+                y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0));
+                z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+            }
+
+            inline void store_vec3(vec3* ptr, __m128 x, __m128 y, __m128 z)
+            {
+                const __m128 xyLow = _mm_unpacklo_ps(x, y);  // x0 y0 x1 y1
+                const __m128 xyHigh = _mm_unpackhi_ps(x, y); // x2 y2 x3 y3
+
+                float* data = reinterpret_cast<float*>(ptr);
+                _mm_storeu_ps(data, _mm_shuffle_ps(xyLow, _mm_shuffle_ps(z, xyLow, _MM_SHUFFLE(2, 2, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0)));
+                _mm_storeu_ps(data + 4, _mm_shuffle_ps(_mm_shuffle_ps(xyLow, z, _MM_SHUFFLE(1, 1, 3, 3)), xyHigh, _MM_SHUFFLE(1, 0, 2, 0)));
+                _mm_storeu_ps(data + 8, _mm_shuffle_ps(_mm_shuffle_ps(z, xyHigh, _MM_SHUFFLE(2, 2, 2, 2)), _mm_shuffle_ps(xyHigh, z, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(2, 0, 2, 0)));
+            }
+
+            inline void load_matrices(const mat4* ptr, __m128(&elements)[16])
+            {
+                for (int column = 0; column < 4; column++)
+                {
+                    __m128 m0 = _mm_loadu_ps(&ptr[0][column][0]);
+                    __m128 m1 = _mm_loadu_ps(&ptr[1][column][0]);
+                    __m128 m2 = _mm_loadu_ps(&ptr[2][column][0]);
+                    __m128 m3 = _mm_loadu_ps(&ptr[3][column][0]);
+                    _MM_TRANSPOSE4_PS(m0, m1, m2, m3);
+                    elements[column * 4 + 0] = m0;
+                    elements[column * 4 + 1] = m1;
+                    elements[column * 4 + 2] = m2;
+                    elements[column * 4 + 3] = m3;
+                }
+            }
+
+            inline void store_matrices(mat4* ptr, const __m128(&elements)[16])
+            {
+                for (int column = 0; column < 4; column++)
+                {
+                    __m128 r0 = elements[column * 4 + 0];
+                    __m128 r1 = elements[column * 4 + 1];
+                    __m128 r2 = elements[column * 4 + 2];
+                    __m128 r3 = elements[column * 4 + 3];
+                    _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+                    _mm_storeu_ps(&ptr[0][column][0], r0);
+                    _mm_storeu_ps(&ptr[1][column][0], r1);
+                    _mm_storeu_ps(&ptr[2][column][0], r2);
+                    _mm_storeu_ps(&ptr[3][column][0], r3);
+                }
+            }
+
+            inline float reduce_min(__m128 value)
+            {
+                value = _mm_min_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 0, 3, 2)));
+                value = _mm_min_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1)));
+                return _mm_cvtss_f32(value);
+            }
+
+            inline float reduce_max(__m128 value)
+            {
+                value = _mm_max_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 0, 3, 2)));
+                value = _mm_max_ps(value, _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1)));
+                return _mm_cvtss_f32(value);
+            }
+        }
+
+        struct sse_lanes
+        {
+            using type = __m128;
+            static constexpr size_type width = 4;
+
+            static type load(const float* ptr) { return _mm_loadu_ps(ptr); }
+            static void store(float* ptr, type value) { _mm_storeu_ps(ptr, value); }
+            static type splat(float value) { return _mm_set1_ps(value); }
+            static type add(type a, type b) { return _mm_add_ps(a, b); }
+            static type sub(type a, type b) { return _mm_sub_ps(a, b); }
+            static type mul(type a, type b) { return _mm_mul_ps(a, b); }
+            static type min(type a, type b) { return _mm_min_ps(a, b); }
+            static type max(type a, type b) { return _mm_max_ps(a, b); }
+            static type abs(type a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+
+            static type greater_equal(type a, type b) { return _mm_cmpge_ps(a, b); }
+            static type mask_and(type a, type b) { return _mm_and_ps(a, b); }
+            static void store_mask(uint8* out, type mask)
+            {
+                const int bits = _mm_movemask_ps(mask);
+                for (int i = 0; i < 4; i++)
+                    out[i] = static_cast<uint8>((bits >> i) & 1);
+            }
+
+            static float reduce_min(type value) { return sse::reduce_min(value); }
+            static float reduce_max(type value) { return sse::reduce_max(value); }
+
+            static void load_vec3(const vec3* ptr, type& x, type& y, type& z) { sse::load_vec3(ptr, x, y, z); }
+            static void store_vec3(vec3* ptr, type x, type y, type z) { sse::store_vec3(ptr, x, y, z); }
+            static void load_matrices(const mat4* ptr, type(&elements)[16]) { sse::load_matrices(ptr, elements); }
+            static void store_matrices(mat4* ptr, const type(&elements)[16]) { sse::store_matrices(ptr, elements); }
+        };
+#endif
+
+        template<typename lanes>
+        void compose_range(size_type begin, size_type end, const trs_arrays& in, mat4* out)
+        {
+            using type = typename lanes::type;
+            const type one = lanes::splat(1.f);
+            const type two = lanes::splat(2.f);
+            const type zero = lanes::splat(0.f);
+
+            for (size_type i = begin; i < end; i += lanes::width)
+            {
+                const type x = lanes::load(in.rx + i);
+                const type y = lanes::load(in.ry + i);
+                const type z = lanes::load(in.rz + i);
+                const type w = lanes::load(in.rw + i);
+                const type sx = lanes::load(in.sx + i);
+                const type sy = lanes::load(in.sy + i);
+                const type sz = lanes::load(in.sz + i);
+
+                const type xx = lanes::mul(x, x);
+                const type yy = lanes::mul(y, y);
+                const type zz = lanes::mul(z, z);
+                const type xy = lanes::mul(x, y);
+                const type xz = lanes::mul(x, z);
+                const type yz = lanes::mul(y, z);
+                const type wx = lanes::mul(w, x);
+                const type wy = lanes::mul(w, y);
+                const type wz = lanes::mul(w, z);
+
+                // Same rotation matrix as math::toMat3, columns scaled by the scale.
+                type m[16];
+                m[0] = lanes::mul(lanes::sub(one, lanes::mul(two, lanes::add(yy, zz))), sx);
+                m[1] = lanes::mul(lanes::mul(two, lanes::add(xy, wz)), sx);
+                m[2] = lanes::mul(lanes::mul(two, lanes::sub(xz, wy)), sx);
+                m[3] = zero;
+
+                m[4] = lanes::mul(lanes::mul(two, lanes::sub(xy, wz)), sy);
+                m[5] = lanes::mul(lanes::sub(one, lanes::mul(two, lanes::add(xx, zz))), sy);
+                m[6] = lanes::mul(lanes::mul(two, lanes::add(yz, wx)), sy);
+                m[7] = zero;
+
+                m[8] = lanes::mul(lanes::mul(two, lanes::add(xz, wy)), sz);
+                m[9] = lanes::mul(lanes::mul(two, lanes::sub(yz, wx)), sz);
+                m[10] = lanes::mul(lanes::sub(one, lanes::mul(two, lanes::add(xx, yy))), sz);
+                m[11] = zero;
+
+                m[12] = lanes::load(in.px + i);
+                m[13] = lanes::load(in.py + i);
+                m[14] = lanes::load(in.pz + i);
+                m[15] = one;
+
+                lanes::store_matrices(out + i, m);
+            }
+        }
+
+        template<typename lanes>
+        void transform_points_range(const mat4& transform, size_type begin, size_type end, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ)
+        {
+            using type = typename lanes::type;
+            type m[12];
+            for (int column = 0; column < 4; column++)
+                for (int row = 0; row < 3; row++)
+                    m[column * 3 + row] = lanes::splat(transform[column][row]);
+
+            for (size_type i = begin; i < end; i += lanes::width)
+            {
+                const type px = lanes::load(x + i);
+                const type py = lanes::load(y + i);
+                const type pz = lanes::load(z + i);
+
+                type result[3];
+                for (int row = 0; row < 3; row++)
+                    result[row] = lanes::add(lanes::add(lanes::mul(m[row], px), lanes::mul(m[3 + row], py)), lanes::add(lanes::mul(m[6 + row], pz), m[9 + row]));
+
+                lanes::store(outX + i, result[0]);
+                lanes::store(outY + i, result[1]);
+                lanes::store(outZ + i, result[2]);
+            }
+        }
+
+        template<typename lanes>
+        void transformed_bounds_range(const mat4& transform, size_type begin, size_type end, const vec3* points, vec3& min, vec3& max)
+        {
+            using type = typename lanes::type;
+            type m[12];
+            for (int column = 0; column < 4; column++)
+                for (int row = 0; row < 3; row++)
+                    m[column * 3 + row] = lanes::splat(transform[column][row]);
+
+            type lower[3] = { lanes::splat(min.x), lanes::splat(min.y), lanes::splat(min.z) };
+            type upper[3] = { lanes::splat(max.x), lanes::splat(max.y), lanes::splat(max.z) };
+
+            for (size_type i = begin; i < end; i += lanes::width)
+            {
+                type px, py, pz;
+                lanes::load_vec3(points + i, px, py, pz);
+
+                for (int row = 0; row < 3; row++)
+                {
+                    const type value = lanes::add(lanes::add(lanes::mul(m[row], px), lanes::mul(m[3 + row], py)), lanes::add(lanes::mul(m[6 + row], pz), m[9 + row]));
+                    lower[row] = lanes::min(lower[row], value);
+                    upper[row] = lanes::max(upper[row], value);
+                }
+            }
+
+            min = vec3(lanes::reduce_min(lower[0]), lanes::reduce_min(lower[1]), lanes::reduce_min(lower[2]));
+            max = vec3(lanes::reduce_max(upper[0]), lanes::reduce_max(upper[1]), lanes::reduce_max(upper[2]));
+        }
+
+        template<typename lanes>
+        void world_aabbs_range(size_type begin, size_type end, const mat4* transforms, const vec3* localMin, const vec3* localMax, vec3* worldMin, vec3* worldMax)
+        {
+            using type = typename lanes::type;
+            const type half = lanes::splat(0.5f);
+
+            for (size_type i = begin; i < end; i += lanes::width)
+            {
+                type lower[3], upper[3];
+                lanes::load_vec3(localMin + i, lower[0], lower[1], lower[2]);
+                lanes::load_vec3(localMax + i, upper[0], upper[1], upper[2]);
+
+                type m[16];
+                lanes::load_matrices(transforms + i, m);
+
+                type center[3], extent[3];
+                for (int axis = 0; axis < 3; axis++)
+                {
+                    center[axis] = lanes::mul(lanes::add(lower[axis], upper[axis]), half);
+                    extent[axis] = lanes::mul(lanes::sub(upper[axis], lower[axis]), half);
+                }
+
+                // Transformed center plus the extents projected onto every world axis.
+                type worldCenter[3], worldExtent[3];
+                for (int row = 0; row < 3; row++)
+                {
+                    worldCenter[row] = lanes::add(lanes::add(lanes::mul(m[row], center[0]), lanes::mul(m[4 + row], center[1])), lanes::add(lanes::mul(m[8 + row], center[2]), m[12 + row]));
+                    worldExtent[row] = lanes::add(lanes::add(lanes::mul(lanes::abs(m[row]), extent[0]), lanes::mul(lanes::abs(m[4 + row]), extent[1])), lanes::mul(lanes::abs(m[8 + row]), extent[2]));
+                }
+
+                lanes::store_vec3(worldMin + i, lanes::sub(worldCenter[0], worldExtent[0]), lanes::sub(worldCenter[1], worldExtent[1]), lanes::sub(worldCenter[2], worldExtent[2]));
+                lanes::store_vec3(worldMax + i, lanes::add(worldCenter[0], worldExtent[0]), lanes::add(worldCenter[1], worldExtent[1]), lanes::add(worldCenter[2], worldExtent[2]));
+            }
+        }
+
+        template<typename lanes>
+        void cull_spheres_range(const frustum& frustum, size_type begin, size_type end, const float* x, const float* y, const float* z, const float* radius, uint8* visible)
+        {
+            using type = typename lanes::type;
+            const type zero = lanes::splat(0.f);
+
+            for (size_type i = begin; i < end; i += lanes::width)
+            {
+                const type px = lanes::load(x + i);
+                const type py = lanes::load(y + i);
+                const type pz = lanes::load(z + i);
+                const type r = lanes::load(radius + i);
+
+                type inside = lanes::greater_equal(zero, zero);
+                for (auto& plane : frustum.planes)
+                {
+                    const type distance = lanes::add(lanes::add(lanes::mul(lanes::splat(plane.x), px), lanes::mul(lanes::splat(plane.y), py)),
+                        lanes::add(lanes::mul(lanes::splat(plane.z), pz), lanes::splat(plane.w)));
+                    inside = lanes::mask_and(inside, lanes::greater_equal(lanes::add(distance, r), zero));
+                }
+
+                lanes::store_mask(visible + i, inside);
+            }
+        }
+
+        template<typename lanes>
+        void cull_aabbs_range(const frustum& frustum, size_type begin, size_type end, const vec3* min, const vec3* max, uint8* visible)
+        {
+            using type = typename lanes::type;
+            const type zero = lanes::splat(0.f);
+
+            for (size_type i = begin; i < end; i += lanes::width)
+            {
+                type lower[3], upper[3];
+                lanes::load_vec3(min + i, lower[0], lower[1], lower[2]);
+                lanes::load_vec3(max + i, upper[0], upper[1], upper[2]);
+
+                type inside = lanes::greater_equal(zero, zero);
+                for (auto& plane : frustum.planes)
+                {
+                    // Only the corner furthest along the normal needs to be tested.
+                    const type cx = plane.x >= 0.f ? upper[0] : lower[0];
+                    const type cy = plane.y >= 0.f ? upper[1] : lower[1];
+                    const type cz = plane.z >= 0.f ? upper[2] : lower[2];
+
+                    const type distance = lanes::add(lanes::add(lanes::mul(lanes::splat(plane.x), cx), lanes::mul(lanes::splat(plane.y), cy)),
+                        lanes::add(lanes::mul(lanes::splat(plane.z), cz), lanes::splat(plane.w)));
+                    inside = lanes::mask_and(inside, lanes::greater_equal(distance, zero));
+                }
+
+                lanes::store_mask(visible + i, inside);
+            }
+        }
+
+        // Entry points: full blocks with the given lanes, the remainder one element at a time.
+
+        template<typename lanes>
+        size_type full_blocks(size_type count) { return count - count % lanes::width; }
+
+        template<typename lanes>
+        void compose_kernel(size_type count, const trs_arrays& in, mat4* out)
+        {
+            const size_type blocks = full_blocks<lanes>(count);
+            compose_range<lanes>(0, blocks, in, out);
+            compose_range<scalar_lanes>(blocks, count, in, out);
+        }
+
+        template<typename lanes>
+        void transform_points_kernel(const mat4& transform, size_type count, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ)
+        {
+            const size_type blocks = full_blocks<lanes>(count);
+            transform_points_range<lanes>(transform, 0, blocks, x, y, z, outX, outY, outZ);
+            transform_points_range<scalar_lanes>(transform, blocks, count, x, y, z, outX, outY, outZ);
+        }
+
+        template<typename lanes>
+        void transformed_bounds_kernel(const mat4& transform, size_type count, const vec3* points, vec3& min, vec3& max)
+        {
+            if (!count)
+                return;
+
+            // Start from the first point so the accumulators don't need infinities.
+            const vec3 first = transform * vec4(points[0], 1.f);
+            min = first;
+            max = first;
+
+            const size_type blocks = full_blocks<lanes>(count);
+            transformed_bounds_range<lanes>(transform, 0, blocks, points, min, max);
+            transformed_bounds_range<scalar_lanes>(transform, blocks, count, points, min, max);
+        }
+
+        template<typename lanes>
+        void world_aabbs_kernel(size_type count, const mat4* transforms, const vec3* localMin, const vec3* localMax, vec3* worldMin, vec3* worldMax)
+        {
+            const size_type blocks = full_blocks<lanes>(count);
+            world_aabbs_range<lanes>(0, blocks, transforms, localMin, localMax, worldMin, worldMax);
+            world_aabbs_range<scalar_lanes>(blocks, count, transforms, localMin, localMax, worldMin, worldMax);
+        }
+
+        template<typename lanes>
+        void cull_spheres_kernel(const frustum& frustum, size_type count, const float* x, const float* y, const float* z, const float* radius, uint8* visible)
+        {
+            const size_type blocks = full_blocks<lanes>(count);
+            cull_spheres_range<lanes>(frustum, 0, blocks, x, y, z, radius, visible);
+            cull_spheres_range<scalar_lanes>(frustum, blocks, count, x, y, z, radius, visible);
+        }
+
+        template<typename lanes>
+        void cull_aabbs_kernel(const frustum& frustum, size_type count, const vec3* min, const vec3* max, uint8* visible)
+        {
+            const size_type blocks = full_blocks<lanes>(count);
+            cull_aabbs_range<lanes>(frustum, 0, blocks, min, max, visible);
+            cull_aabbs_range<scalar_lanes>(frustum, blocks, count, min, max, visible);
+        }
+
+        template<typename lanes>
+        constexpr kernel_table make_kernel_table()
+        {
+            return kernel_table{
+                &compose_kernel<lanes>,
+                &transform_points_kernel<lanes>,
+                &transformed_bounds_kernel<lanes>,
+                &world_aabbs_kernel<lanes>,
+                &cull_spheres_kernel<lanes>,
+                &cull_aabbs_kernel<lanes>
+            };
+        }
+    }
+}
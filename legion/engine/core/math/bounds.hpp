@@ -0,0 +1,93 @@
+#pragma once
+#include <core/platform/platform.hpp>
+#include <core/types/primitives.hpp>
+#include <core/math/glm/glm_include.hpp>
+
+#include <limits>
+
+/**
+ * @file bounds.hpp
+ * @brief Local space bounding volumes that get calculated once when the geometry is created.
+ *        World space bounds are derived from them per transform in constant time, independent of the vertex count.
+ */
+
+namespace legion::core::math
+{
+    /**@class bounding_volume
+     * @brief Local space AABB together with a bounding sphere around the center of the AABB.
+     *        A default constructed bounding volume is an empty point at the origin.
+     */
+    struct bounding_volume
+    {
+        vec3 min = vec3(0.f);
+        vec3 max = vec3(0.f);
+        vec3 center = vec3(0.f);
+        float radius = 0.f;
+
+        /**@brief Calculates the bounds of a set of points.
+         */
+        L_NODISCARD static bounding_volume from_points(const vec3* points, size_type count) noexcept
+        {
+            bounding_volume result;
+            if (!count)
+                return result;
+
+            result.min = vec3(std::numeric_limits<float>::max());
+            result.max = vec3(std::numeric_limits<float>::lowest());
+
+            for (size_type i = 0; i < count; i++)
+            {
+                result.min = math::min(result.min, points[i]);
+                result.max = math::max(result.max, points[i]);
+            }
+
+            // The sphere shares it's center with the box, which is a lot cheaper than a minimal sphere and tight enough for culling.
+            result.center = (result.min + result.max) * 0.5f;
+
+            float radiusSqr = 0.f;
+            for (size_type i = 0; i < count; i++)
+            {
+                const vec3 offset = points[i] - result.center;
+                radiusSqr = math::max(radiusSqr, dot(offset, offset));
+            }
+            result.radius = sqrt(radiusSqr);
+
+            return result;
+        }
+
+        L_NODISCARD vec3 extents() const noexcept
+        {
+            return (max - min) * 0.5f;
+        }
+
+        /**@brief Smallest AABB containing the transformed box, equal to the bounds of the 8 transformed corners.
+         *        Uses the center/extent form (Arvo), every world axis gets the absolute projection of the local extents.
+         */
+        void transformed_aabb(const mat4& transform, vec3& worldMin, vec3& worldMax) const noexcept
+        {
+            const vec3 localCenter = (min + max) * 0.5f;
+            const vec3 localExtents = extents();
+
+            const vec3 worldCenter = vec3(transform * vec4(localCenter, 1.f));
+            vec3 worldExtents;
+            for (int i = 0; i < 3; i++)
+                worldExtents[i] = abs(transform[0][i]) * localExtents.x + abs(transform[1][i]) * localExtents.y + abs(transform[2][i]) * localExtents.z;
+
+            worldMin = worldCenter - worldExtents;
+            worldMax = worldCenter + worldExtents;
+        }
+
+        /**@brief Transformed bounding sphere, the radius scales with the largest axis scale so non uniform scales stay conservative.
+         */
+        void transformed_sphere(const mat4& transform, vec3& worldCenter, float& worldRadius) const noexcept
+        {
+            worldCenter = vec3(transform * vec4(center, 1.f));
+
+            const vec3 x = vec3(transform[0]);
+            const vec3 y = vec3(transform[1]);
+            const vec3 z = vec3(transform[2]);
+            const float maxScaleSqr = math::max(math::max(dot(x, x), dot(y, y)), dot(z, z));
+            worldRadius = radius * sqrt(maxScaleSqr);
+        }
+    };
+}
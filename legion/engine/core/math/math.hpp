@@ -6,3 +6,5 @@
 #include <core/math/color.hpp>
 #include <core/math/close_enough.hpp>
 #include <core/math/geometry.hpp>
+#include <core/math/bounds.hpp>
+#include <core/math/batch.hpp>
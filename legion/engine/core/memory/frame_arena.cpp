@@ -0,0 +1,102 @@
+#include <core/memory/frame_arena.hpp>
+#include <core/memory/memory_tracker.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+
+namespace legion::core::memory
+{
+    FrameArena::FrameArena(size_type initialSize) : m_minimumSize(initialSize)
+    {
+        add_block(initialSize);
+    }
+
+    FrameArena::~FrameArena()
+    {
+        for (auto& blk : m_blocks)
+            free_block(blk);
+    }
+
+    FrameArena& FrameArena::local()
+    {
+        thread_local FrameArena arena;
+        return arena;
+    }
+
+    void FrameArena::add_block(size_type minimumSize)
+    {
+        size_type size = m_blocks.empty() ? minimumSize : std::max(minimumSize, m_blocks.back().size * 2);
+        m_blocks.push_back({ static_cast<byte*>(::operator new(size)), size });
+        m_offset = 0;
+        MemoryTracker::track_allocation(memory_tag::frame, size);
+    }
+
+    void FrameArena::free_block(block& blk)
+    {
+        MemoryTracker::track_deallocation(memory_tag::frame, blk.size);
+        ::operator delete(blk.data);
+        blk.data = nullptr;
+    }
+
+    void* FrameArena::allocate(size_type size, size_type alignment)
+    {
+        std::lock_guard guard(m_lock);
+
+        size_type padding = (alignment - (reinterpret_cast<uintptr_t>(m_blocks.back().data + m_offset) & (alignment - 1))) & (alignment - 1);
+        if (m_offset + padding + size > m_blocks.back().size)
+        {
+            // Operator new aligns to at least alignof(std::max_align_t), over aligned types need extra space.
+            add_block(size + alignment);
+            padding = (alignment - (reinterpret_cast<uintptr_t>(m_blocks.back().data) & (alignment - 1))) & (alignment - 1);
+        }
+
+        void* result = m_blocks.back().data + m_offset + padding;
+        m_offset += padding + size;
+        m_used += padding + size;
+        return result;
+    }
+
+    void FrameArena::reset()
+    {
+        std::lock_guard guard(m_lock);
+
+        if (m_used > m_peak)
+            m_peak = m_used;
+        if (m_used > m_windowPeak)
+            m_windowPeak = m_used;
+
+        const size_type total = capacity();
+        size_type target = m_blocks.size() > 1 ? total : 0; // Merge all blocks into a single block that fits everything that was allocated this frame.
+
+        if (++m_windowFrames >= shrink_window)
+        {
+            // A single spike shouldn't pin it's memory for the rest of the thread's life, shrink back if the recent frames needed far less.
+            const size_type shrunk = std::max(m_minimumSize, m_windowPeak * 2);
+            if (total > shrunk * 2)
+                target = shrunk;
+
+            m_windowFrames = 0;
+            m_windowPeak = 0;
+        }
+
+        if (target)
+        {
+            for (auto& blk : m_blocks)
+                free_block(blk);
+            m_blocks.clear();
+            add_block(target);
+        }
+
+        m_offset = 0;
+        m_used = 0;
+    }
+
+    size_type FrameArena::capacity() const noexcept
+    {
+        size_type total = 0;
+        for (auto& blk : m_blocks)
+            total += blk.size;
+        return total;
+    }
+}
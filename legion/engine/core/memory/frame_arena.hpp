@@ -0,0 +1,126 @@
+#pragma once
+#include <core/platform/platform.hpp>
+#include <core/types/primitives.hpp>
+#include <core/async/spinlock.hpp>
+
+#include <functional>
+#include <memory>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file frame_arena.hpp
+ * @brief Per thread linear allocators for temporary data that only lives for a single frame.
+ *        Every thread owns a FrameArena, allocating from it is a pointer bump and freeing is a no-op.
+ *        Process chains reset the arena of their thread at the end of each frame, worker threads reset theirs after each batch of jobs.
+ * @warning Memory from a frame arena may never outlive the frame or job it was allocated in.
+ */
+
+namespace legion::core::memory
+{
+    /**@class FrameArena
+     * @brief Linear allocator that frees all of it's allocations at once.
+     *        The arena grows by adding blocks and merges them into a single block on reset, so a steady workload ends up using a single block.
+     *        Once every shrink_window resets the arena shrinks back if the frames of that window used far less than it reserves.
+     */
+    class FrameArena
+    {
+    public:
+        static constexpr size_type default_block_size = 256 * 1024;
+        static constexpr size_type shrink_window = 120;
+
+    private:
+        struct block
+        {
+            byte* data;
+            size_type size;
+        };
+
+        std::vector<block> m_blocks;
+        size_type m_offset = 0;
+        size_type m_used = 0;
+        size_type m_peak = 0;
+        size_type m_windowPeak = 0;
+        size_type m_windowFrames = 0;
+        size_type m_minimumSize;
+        async::spinlock m_lock; // Containers bound to this arena might grow on another thread, e.g. inside a job.
+
+        void add_block(size_type minimumSize);
+        static void free_block(block& blk);
+
+    public:
+        FrameArena(size_type initialSize = default_block_size);
+        ~FrameArena();
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        /**@brief Get the frame arena of the calling thread.
+         */
+        L_NODISCARD static FrameArena& local();
+
+        L_NODISCARD void* allocate(size_type size, size_type alignment);
+
+        /**@brief Frees all allocations, merging all blocks into one block big enough to fit the largest recent frame.
+         * @warning All memory allocated from this arena becomes invalid.
+         */
+        void reset();
+
+        /**@brief Amount of bytes allocated since the last reset.
+         */
+        L_NODISCARD size_type used() const noexcept { return m_used; }
+
+        /**@brief Highest amount of bytes used during a single frame.
+         */
+        L_NODISCARD size_type peak() const noexcept { return m_peak; }
+
+        /**@brief Total amount of bytes reserved by the arena.
+         */
+        L_NODISCARD size_type capacity() const noexcept;
+    };
+
+    /**@class frame_allocator
+     * @brief STL compatible allocator that allocates from a FrameArena, the arena of the constructing thread by default.
+     */
+    template<typename T>
+    struct frame_allocator
+    {
+        template<typename Other>
+        friend struct frame_allocator;
+
+        using value_type = T;
+
+    private:
+        FrameArena* m_arena;
+
+    public:
+        frame_allocator() noexcept : m_arena(&FrameArena::local()) {}
+        explicit frame_allocator(FrameArena& arena) noexcept : m_arena(&arena) {}
+
+        template<typename Other>
+        frame_allocator(const frame_allocator<Other>& other) noexcept : m_arena(other.m_arena) {}
+
+        L_NODISCARD T* allocate(size_type count)
+        {
+            return static_cast<T*>(m_arena->allocate(count * sizeof(T), alignof(T)));
+        }
+
+        void deallocate(T*, size_type) noexcept {}
+
+        template<typename Other>
+        bool operator==(const frame_allocator<Other>& other) const noexcept { return m_arena == other.m_arena; }
+
+        template<typename Other>
+        bool operator!=(const frame_allocator<Other>& other) const noexcept { return m_arena != other.m_arena; }
+    };
+
+    template<typename T>
+    using frame_vector = std::vector<T, frame_allocator<T>>;
+
+    template<typename T, typename Compare = std::less<T>>
+    using frame_set = std::set<T, Compare, frame_allocator<T>>;
+
+    template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+    using frame_unordered_map = std::unordered_map<Key, Value, Hash, KeyEqual, frame_allocator<std::pair<const Key, Value>>>;
+}
@@ -0,0 +1,4 @@
+#pragma once
+#include <core/memory/memory_tracker.hpp>
+#include <core/memory/tagged_allocator.hpp>
+#include <core/memory/frame_arena.hpp>
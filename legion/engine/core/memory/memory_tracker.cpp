@@ -0,0 +1,269 @@
+#include <core/memory/memory_tracker.hpp>
+#include <core/async/rw_spinlock.hpp>
+#include <core/logging/logging.hpp>
+
+#include <chrono>
+#include <fstream>
+
+namespace legion::core::memory
+{
+    namespace
+    {
+        template<typename delegate_type>
+        struct registered_callback
+        {
+            id_type id;
+            memory_tag tag;
+            delegate_type callback;
+        };
+
+        async::rw_spinlock callbacksLock;
+        std::vector<registered_callback<MemoryTracker::sampler_type>> samplers;
+        std::vector<registered_callback<MemoryTracker::eviction_handler_type>> evictionHandlers;
+        id_type lastCallbackId = 0;
+
+        std::chrono::steady_clock::time_point lastReport = std::chrono::steady_clock::now();
+
+        template<typename delegate_type>
+        void remove_callback(std::vector<registered_callback<delegate_type>>& callbacks, id_type id)
+        {
+            for (auto it = callbacks.begin(); it != callbacks.end(); ++it)
+                if (it->id == id)
+                {
+                    callbacks.erase(it);
+                    return;
+                }
+        }
+
+        cstring format_bytes(size_type bytes, double& value)
+        {
+            constexpr cstring units[] = { "B", "KiB", "MiB", "GiB" };
+            value = static_cast<double>(bytes);
+            size_type unit = 0;
+            while (value >= 1024.0 && unit < 3)
+            {
+                value /= 1024.0;
+                unit++;
+            }
+            return units[unit];
+        }
+    }
+
+    std::array<MemoryTracker::tag_counters, memory_tag_count> MemoryTracker::m_counters;
+    std::atomic_bool MemoryTracker::m_evictionRequested{ false };
+
+    cstring tag_name(memory_tag tag) noexcept
+    {
+        switch (tag)
+        {
+        case memory_tag::general: return "general";
+        case memory_tag::meshes: return "meshes";
+        case memory_tag::images: return "images";
+        case memory_tag::audio: return "audio";
+        case memory_tag::artifacts: return "artifacts";
+        case memory_tag::components: return "components";
+        case memory_tag::physics: return "physics";
+        case memory_tag::frame: return "frame";
+        case memory_tag::animations: return "animations";
+        default: return "unknown";
+        }
+    }
+
+    id_type MemoryTracker::add_sampler(memory_tag tag, sampler_type&& sampler)
+    {
+        async::readwrite_guard guard(callbacksLock);
+        id_type id = ++lastCallbackId;
+        samplers.push_back({ id, tag, std::move(sampler) });
+        return id;
+    }
+
+    void MemoryTracker::remove_sampler(id_type id)
+    {
+        async::readwrite_guard guard(callbacksLock);
+        remove_callback(samplers, id);
+    }
+
+    id_type MemoryTracker::add_eviction_handler(memory_tag tag, eviction_handler_type&& handler)
+    {
+        async::readwrite_guard guard(callbacksLock);
+        id_type id = ++lastCallbackId;
+        evictionHandlers.push_back({ id, tag, std::move(handler) });
+        return id;
+    }
+
+    void MemoryTracker::remove_eviction_handler(id_type id)
+    {
+        async::readwrite_guard guard(callbacksLock);
+        remove_callback(evictionHandlers, id);
+    }
+
+    void MemoryTracker::set_budget(memory_tag tag, size_type bytes) noexcept
+    {
+        auto& counters = m_counters[static_cast<size_type>(tag)];
+        counters.budget.store(bytes, std::memory_order_relaxed);
+        check_budget(counters, get_usage(tag));
+    }
+
+    size_type MemoryTracker::get_budget(memory_tag tag) noexcept
+    {
+        return m_counters[static_cast<size_type>(tag)].budget.load(std::memory_order_relaxed);
+    }
+
+    size_type MemoryTracker::get_usage(memory_tag tag) noexcept
+    {
+        auto& counters = m_counters[static_cast<size_type>(tag)];
+        return counters.current.load(std::memory_order_relaxed) + counters.sampled.load(std::memory_order_relaxed);
+    }
+
+    bool MemoryTracker::update()
+    {
+        std::array<size_type, memory_tag_count> sampled{};
+
+        {
+            async::readonly_guard guard(callbacksLock);
+            for (auto& sampler : samplers)
+                sampled[static_cast<size_type>(sampler.tag)] += sampler.callback();
+        }
+
+        for (size_type i = 0; i < memory_tag_count; i++)
+        {
+            auto& counters = m_counters[i];
+            counters.sampled.store(sampled[i], std::memory_order_relaxed);
+
+            size_type usage = counters.current.load(std::memory_order_relaxed) + sampled[i];
+            update_peak(counters, usage);
+            check_budget(counters, usage);
+        }
+
+        return eviction_requested();
+    }
+
+    size_type MemoryTracker::evict()
+    {
+        m_evictionRequested.store(false, std::memory_order_relaxed);
+        update();
+
+        size_type totalFreed = 0;
+
+        async::readonly_guard guard(callbacksLock);
+        for (size_type i = 0; i < memory_tag_count; i++)
+        {
+            memory_tag tag = static_cast<memory_tag>(i);
+            size_type budget = get_budget(tag);
+            size_type usage = get_usage(tag);
+            if (!budget || usage <= budget)
+                continue;
+
+            const size_type overBudget = usage - budget;
+            size_type freed = 0;
+            for (auto& handler : evictionHandlers)
+            {
+                if (handler.tag != tag)
+                    continue;
+
+                freed += handler.callback(overBudget - freed);
+                if (freed >= overBudget)
+                    break;
+            }
+
+            if (freed < overBudget)
+                log::warn("Memory tag {} is {} bytes over budget, eviction only freed {} bytes.", tag_name(tag), overBudget, freed);
+            else
+                log::debug("Evicted {} bytes of memory tag {}.", freed, tag_name(tag));
+
+            totalFreed += freed;
+        }
+
+        m_evictionRequested.store(false, std::memory_order_relaxed);
+        return totalFreed;
+    }
+
+    memory_tag_stats MemoryTracker::get_stats(memory_tag tag)
+    {
+        auto& counters = m_counters[static_cast<size_type>(tag)];
+
+        memory_tag_stats stats;
+        stats.tag = tag;
+        stats.name = tag_name(tag);
+        stats.current = get_usage(tag);
+        stats.peak = counters.peak.load(std::memory_order_relaxed);
+        stats.budget = counters.budget.load(std::memory_order_relaxed);
+        stats.allocations = counters.allocations.load(std::memory_order_relaxed);
+        stats.deallocations = counters.deallocations.load(std::memory_order_relaxed);
+        stats.allocationRate = 0.0;
+        return stats;
+    }
+
+    std::vector<memory_tag_stats> MemoryTracker::report()
+    {
+        update();
+
+        static async::rw_spinlock reportLock;
+        async::readwrite_guard guard(reportLock);
+
+        auto now = std::chrono::steady_clock::now();
+        double elapsed = std::chrono::duration<double>(now - lastReport).count();
+        lastReport = now;
+
+        std::vector<memory_tag_stats> result;
+        result.reserve(memory_tag_count);
+        for (size_type i = 0; i < memory_tag_count; i++)
+        {
+            auto& stats = result.emplace_back(get_stats(static_cast<memory_tag>(i)));
+            auto& counters = m_counters[i];
+
+            if (elapsed > 0.0)
+                stats.allocationRate = (stats.allocations - counters.reportedAllocations) / elapsed;
+            counters.reportedAllocations = stats.allocations;
+        }
+
+        return result;
+    }
+
+    void MemoryTracker::log_report()
+    {
+        for (auto& stats : report())
+        {
+            double current, peak, budget;
+            cstring currentUnit = format_bytes(stats.current, current);
+            cstring peakUnit = format_bytes(stats.peak, peak);
+            cstring budgetUnit = format_bytes(stats.budget, budget);
+
+            if (stats.budget)
+                log::info("[memory] {}: {:.2f}{} (peak {:.2f}{}, budget {:.2f}{}) {:.1f} allocations/s",
+                    stats.name, current, currentUnit, peak, peakUnit, budget, budgetUnit, stats.allocationRate);
+            else
+                log::info("[memory] {}: {:.2f}{} (peak {:.2f}{}) {:.1f} allocations/s",
+                    stats.name, current, currentUnit, peak, peakUnit, stats.allocationRate);
+        }
+    }
+
+    bool MemoryTracker::dump(const std::string& path)
+    {
+        std::ofstream file(path);
+        if (!file.is_open())
+        {
+            log::error("Failed to open {} for writing the memory report.", path);
+            return false;
+        }
+
+        file << "{\n    \"tags\": [";
+        bool first = true;
+        for (auto& stats : report())
+        {
+            file << (first ? "\n" : ",\n");
+            first = false;
+
+            file << "        { \"name\": \"" << stats.name << "\""
+                << ", \"current\": " << stats.current
+                << ", \"peak\": " << stats.peak
+                << ", \"budget\": " << stats.budget
+                << ", \"allocations\": " << stats.allocations
+                << ", \"deallocations\": " << stats.deallocations
+                << ", \"allocationRate\": " << stats.allocationRate << " }";
+        }
+        file << "\n    ]\n}\n";
+
+        return true;
+    }
+}
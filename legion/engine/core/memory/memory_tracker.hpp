@@ -0,0 +1,165 @@
+#pragma once
+#include <core/platform/platform.hpp>
+#include <core/types/primitives.hpp>
+#include <core/containers/delegate.hpp>
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+
+/**
+ * @file memory_tracker.hpp
+ * @brief Per subsystem memory accounting.
+ *        Subsystems either report their allocations directly to the tracker, or register a sampler that reports their current footprint on request.
+ *        Every tag can be given a soft budget, once a tag goes over budget the tracker requests an eviction and the scheduler
+ *        runs the eviction handlers of that tag at the next synchronization point.
+ */
+
+namespace legion::core::memory
+{
+    enum struct memory_tag : uint8
+    {
+        general,
+        meshes,
+        images,
+        audio,
+        artifacts,
+        components,
+        physics,
+        frame,
+        animations,
+        count
+    };
+
+    constexpr size_type memory_tag_count = static_cast<size_type>(memory_tag::count);
+
+    L_NODISCARD cstring tag_name(memory_tag tag) noexcept;
+
+    /**@class memory_tag_stats
+     * @brief Snapshot of the counters of a single tag.
+     */
+    struct memory_tag_stats
+    {
+        memory_tag tag;
+        cstring name;
+        size_type current;
+        size_type peak;
+        size_type budget;
+        uint64 allocations;
+        uint64 deallocations;
+        double allocationRate; // Allocations per second since the previous report.
+    };
+
+    /**@class MemoryTracker
+     * @brief Keeps track of the memory use of all tags.
+     */
+    class MemoryTracker
+    {
+    public:
+        using sampler_type = delegate<size_type()>;
+        using eviction_handler_type = delegate<size_type(size_type)>;
+
+    private:
+        struct tag_counters
+        {
+            std::atomic<size_type> current{ 0 };
+            std::atomic<size_type> peak{ 0 };
+            std::atomic<size_type> sampled{ 0 };
+            std::atomic<size_type> budget{ 0 };
+            std::atomic<uint64> allocations{ 0 };
+            std::atomic<uint64> deallocations{ 0 };
+            uint64 reportedAllocations = 0;
+        };
+
+        static std::array<tag_counters, memory_tag_count> m_counters;
+        static std::atomic_bool m_evictionRequested;
+
+        static void update_peak(tag_counters& counters, size_type current) noexcept
+        {
+            size_type peak = counters.peak.load(std::memory_order_relaxed);
+            while (current > peak && !counters.peak.compare_exchange_weak(peak, current, std::memory_order_relaxed));
+        }
+
+        static void check_budget(const tag_counters& counters, size_type current) noexcept
+        {
+            size_type budget = counters.budget.load(std::memory_order_relaxed);
+            if (budget && current > budget)
+                m_evictionRequested.store(true, std::memory_order_relaxed);
+        }
+
+    public:
+        /**@brief Reports an allocation of a tag.
+         */
+        static void track_allocation(memory_tag tag, size_type bytes) noexcept
+        {
+            auto& counters = m_counters[static_cast<size_type>(tag)];
+            counters.allocations.fetch_add(1, std::memory_order_relaxed);
+            size_type current = counters.current.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+            update_peak(counters, current + counters.sampled.load(std::memory_order_relaxed));
+            check_budget(counters, current + counters.sampled.load(std::memory_order_relaxed));
+        }
+
+        /**@brief Reports a deallocation of a tag, the amount of bytes needs to match the reported allocation.
+         */
+        static void track_deallocation(memory_tag tag, size_type bytes) noexcept
+        {
+            auto& counters = m_counters[static_cast<size_type>(tag)];
+            counters.deallocations.fetch_add(1, std::memory_order_relaxed);
+            counters.current.fetch_sub(bytes, std::memory_order_relaxed);
+        }
+
+        /**@brief Registers a function that reports the current footprint of a subsystem. Sampled memory gets added to the tracked memory of the tag.
+         * @returns id_type Id to remove the sampler with.
+         */
+        static id_type add_sampler(memory_tag tag, sampler_type&& sampler);
+        static void remove_sampler(id_type id);
+
+        /**@brief Registers a function that frees memory of a tag. The handler receives the amount of bytes the tag is over budget
+         *        and returns the amount of bytes it freed. Handlers are only called during a synchronization point.
+         * @returns id_type Id to remove the handler with.
+         */
+        static id_type add_eviction_handler(memory_tag tag, eviction_handler_type&& handler);
+        static void remove_eviction_handler(id_type id);
+
+        /**@brief Sets the soft budget of a tag.
+         * @param bytes Budget in bytes, 0 to remove the budget.
+         */
+        static void set_budget(memory_tag tag, size_type bytes) noexcept;
+        L_NODISCARD static size_type get_budget(memory_tag tag) noexcept;
+
+        /**@brief Memory currently in use by a tag, including sampled memory.
+         */
+        L_NODISCARD static size_type get_usage(memory_tag tag) noexcept;
+
+        /**@brief Polls all samplers and checks the budgets.
+         * @returns bool True if any tag is over budget and eviction should be run.
+         */
+        static bool update();
+
+        /**@brief Whether a tag went over budget since the last eviction.
+         */
+        L_NODISCARD static bool eviction_requested() noexcept { return m_evictionRequested.load(std::memory_order_relaxed); }
+
+        /**@brief Runs the eviction handlers of all tags that are over budget.
+         * @note Should only be called when no other thread can use the evicted data, e.g. from Scheduler::queueSyncOperation.
+         * @returns size_type Total amount of bytes freed.
+         */
+        static size_type evict();
+
+        L_NODISCARD static memory_tag_stats get_stats(memory_tag tag);
+
+        /**@brief Polls all samplers and gets the stats of all tags.
+         */
+        L_NODISCARD static std::vector<memory_tag_stats> report();
+
+        /**@brief Writes the report of all tags to the log.
+         */
+        static void log_report();
+
+        /**@brief Writes the report of all tags to a JSON file.
+         * @returns bool True if the file was written.
+         */
+        static bool dump(const std::string& path);
+    };
+}
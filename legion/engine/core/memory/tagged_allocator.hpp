@@ -0,0 +1,59 @@
+#pragma once
+#include <core/memory/memory_tracker.hpp>
+
+#include <memory>
+
+/**
+ * @file tagged_allocator.hpp
+ */
+
+namespace legion::core::memory
+{
+    /**@class tagged_allocator
+     * @brief STL compatible allocator that reports all it's allocations to the MemoryTracker under a certain tag.
+     * @tparam T Type to allocate.
+     * @tparam tag Tag to report the allocations under.
+     */
+    template<typename T, memory_tag tag>
+    struct tagged_allocator
+    {
+        using value_type = T;
+
+        template<typename Other>
+        struct rebind
+        {
+            using other = tagged_allocator<Other, tag>;
+        };
+
+        tagged_allocator() noexcept = default;
+
+        template<typename Other>
+        tagged_allocator(const tagged_allocator<Other, tag>&) noexcept {}
+
+        L_NODISCARD T* allocate(size_type count)
+        {
+            MemoryTracker::track_allocation(tag, count * sizeof(T));
+            return std::allocator<T>().allocate(count);
+        }
+
+        void deallocate(T* ptr, size_type count) noexcept
+        {
+            MemoryTracker::track_deallocation(tag, count * sizeof(T));
+            std::allocator<T>().deallocate(ptr, count);
+        }
+
+        template<typename Other>
+        bool operator==(const tagged_allocator<Other, tag>&) const noexcept { return true; }
+
+        template<typename Other>
+        bool operator!=(const tagged_allocator<Other, tag>&) const noexcept { return false; }
+    };
+
+    /**@brief Creates a shared object of which the allocation is reported under a certain tag.
+     */
+    template<typename T, memory_tag tag, typename... Args>
+    L_NODISCARD std::shared_ptr<T> make_tagged_shared(Args&&... args)
+    {
+        return std::allocate_shared<T>(tagged_allocator<T, tag>(), std::forward<Args>(args)...);
+    }
+}
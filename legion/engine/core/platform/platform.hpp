@@ -50,6 +50,11 @@
 #endif
 
 
+/**@def LEGION_HEADLESS
+ * @brief Define before including the entry point to always run without a window, graphics context or audio device.
+ *        Same as passing --headless on the command line, modules that aren't headless compatible won't be loaded.
+ */
+
 #if defined(_WIN64)
     /**@def LEGION_WINDOWS
      * @brief Defined when compiling for Windows.
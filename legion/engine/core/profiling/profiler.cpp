@@ -0,0 +1,275 @@
+#include <core/profiling/profiler.hpp>
+#include <core/logging/logging.hpp>
+
+#include <algorithm>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+
+namespace legion::core::profiling
+{
+    namespace
+    {
+        std::mutex buffersLock;
+        std::vector<std::shared_ptr<thread_buffer>> buffers;
+
+        struct local_buffer_ref
+        {
+            std::shared_ptr<thread_buffer> buffer;
+            uint64 generation = 0;
+        };
+
+        thread_local local_buffer_ref localBuffer;
+
+        std::mutex internLock;
+        std::deque<std::string> internedNames;
+        std::deque<zone_description> internedDescriptions;
+
+        void write_escaped(std::ostream& stream, cstring str)
+        {
+            for (; *str; str++)
+            {
+                switch (*str)
+                {
+                case '"': stream << "\\\""; break;
+                case '\\': stream << "\\\\"; break;
+                case '\n': stream << "\\n"; break;
+                case '\t': stream << "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(*str) >= 0x20)
+                        stream << *str;
+                    break;
+                }
+            }
+        }
+    }
+
+    std::atomic<profiler_mode> Profiler::m_mode{ profiler_mode::ring_buffer };
+    std::atomic<size_type> Profiler::m_bufferSize{ 1 << 15 };
+    std::atomic<uint64> Profiler::m_generation{ 1 };
+
+    thread_buffer& Profiler::local_buffer()
+    {
+        uint64 generation = m_generation.load(std::memory_order_acquire);
+        if (localBuffer.generation != generation || !localBuffer.buffer)
+        {
+            auto buffer = std::make_shared<thread_buffer>();
+            buffer->threadId = std::this_thread::get_id();
+            buffer->events.resize(m_bufferSize.load(std::memory_order_relaxed));
+
+            {
+                std::lock_guard guard(buffersLock);
+                if (localBuffer.buffer)
+                    buffer->name = localBuffer.buffer->name;
+                else if (auto it = log::impl::thread_names.find(buffer->threadId); it != log::impl::thread_names.end())
+                    buffer->name = it->second;
+                buffers.push_back(buffer);
+            }
+
+            localBuffer.buffer = std::move(buffer);
+            localBuffer.generation = generation;
+        }
+
+        return *localBuffer.buffer;
+    }
+
+    std::vector<profile_event> Profiler::read_buffer(thread_buffer& buffer)
+    {
+        const uint64 capacity = buffer.events.size();
+        if (!capacity)
+            return {};
+
+        const uint64 end = buffer.writeIndex.load(std::memory_order_acquire);
+        const uint64 begin = end > capacity ? end - capacity : 0;
+
+        std::vector<profile_event> events;
+        events.reserve(static_cast<size_type>(end - begin));
+        for (uint64 i = begin; i < end; i++)
+            events.push_back(buffer.events[static_cast<size_type>(i % capacity)]);
+
+        // Events that got overwritten whilst copying might be torn, discard them.
+        // The slot of the event currently being written is not covered by the write index yet, so one extra event is discarded.
+        const uint64 newEnd = buffer.writeIndex.load(std::memory_order_acquire) + 1;
+        const uint64 validBegin = newEnd > capacity ? newEnd - capacity : 0;
+        if (validBegin > begin)
+            events.erase(events.begin(), events.begin() + static_cast<size_type>(std::min(validBegin - begin, end - begin)));
+
+        return events;
+    }
+
+    void Profiler::set_mode(profiler_mode mode)
+    {
+        clear();
+        m_mode.store(mode, std::memory_order_release);
+    }
+
+    void Profiler::set_buffer_size(size_type events)
+    {
+        m_bufferSize.store(events, std::memory_order_relaxed);
+    }
+
+    void Profiler::clear()
+    {
+        std::lock_guard guard(buffersLock);
+        buffers.clear();
+        m_generation.fetch_add(1, std::memory_order_acq_rel); // Every thread will create a new buffer on it's next event.
+    }
+
+    void Profiler::set_thread_name(const std::string& name)
+    {
+        auto& buffer = local_buffer();
+        std::lock_guard guard(buffersLock);
+        buffer.name = name;
+    }
+
+    const zone_description* Profiler::intern_description(const std::string& name, cstring file, uint32 line)
+    {
+        std::lock_guard guard(internLock);
+        for (auto& description : internedDescriptions)
+            if (description.line == line && description.file == file && name == description.name)
+                return &description;
+
+        auto& internedName = internedNames.emplace_back(name);
+        return &internedDescriptions.emplace_back(zone_description{ internedName.c_str(), file, line });
+    }
+
+    void Profiler::record(const profile_event& event)
+    {
+        const profiler_mode mode = m_mode.load(std::memory_order_relaxed);
+        if (mode == profiler_mode::disabled)
+            return;
+
+        thread_buffer& buffer = local_buffer();
+        const uint64 capacity = buffer.events.size();
+        const uint64 index = buffer.writeIndex.load(std::memory_order_relaxed);
+
+        if (mode == profiler_mode::capture && index >= capacity)
+        {
+            buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        buffer.events[static_cast<size_type>(index % capacity)] = event;
+        buffer.writeIndex.store(index + 1, std::memory_order_release);
+    }
+
+    std::string Profiler::to_chrome_trace(uint64 since)
+    {
+        std::vector<std::shared_ptr<thread_buffer>> snapshot;
+        {
+            std::lock_guard guard(buffersLock);
+            snapshot = buffers;
+        }
+
+        std::ostringstream stream;
+        stream.precision(3);
+        stream << std::fixed << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+        bool first = true;
+        auto separator = [&]()
+        {
+            if (!first)
+                stream << ",\n";
+            first = false;
+        };
+
+        for (size_type tid = 0; tid < snapshot.size(); tid++)
+        {
+            thread_buffer& buffer = *snapshot[tid];
+
+            std::string name;
+            {
+                std::lock_guard guard(buffersLock);
+                name = buffer.name;
+            }
+
+            separator();
+            stream << "{\"ph\":\"M\",\"pid\":0,\"tid\":" << tid << ",\"name\":\"thread_name\",\"args\":{\"name\":\"";
+            write_escaped(stream, name.empty() ? "Thread" : name.c_str());
+            stream << "\"}}";
+
+            for (auto& event : read_buffer(buffer))
+            {
+                if (!event.description)
+                    continue;
+
+                switch (event.type)
+                {
+                case profile_event_type::zone:
+                case profile_event_type::frame:
+                    if (event.end < since)
+                        continue;
+
+                    separator();
+                    stream << "{\"ph\":\"X\",\"pid\":0,\"tid\":" << tid
+                        << ",\"ts\":" << event.start / 1000.0
+                        << ",\"dur\":" << (event.end - event.start) / 1000.0
+                        << ",\"cat\":\"" << (event.type == profile_event_type::frame ? "frame" : "zone") << "\",\"name\":\"";
+                    write_escaped(stream, event.description->name);
+                    stream << "\",\"args\":{\"file\":\"";
+                    write_escaped(stream, event.description->file);
+                    stream << "\",\"line\":" << event.description->line << "}}";
+                    break;
+                case profile_event_type::counter:
+                    if (event.start < since)
+                        continue;
+
+                    separator();
+                    stream << "{\"ph\":\"C\",\"pid\":0,\"tid\":" << tid << ",\"ts\":" << event.start / 1000.0 << ",\"name\":\"";
+                    write_escaped(stream, event.description->name);
+                    stream << "\",\"args\":{\"value\":" << event.value << "}}";
+                    break;
+                }
+            }
+
+            if (uint64 dropped = buffer.dropped.load(std::memory_order_relaxed))
+                log::warn("Profiler dropped {} events of thread {}, increase the buffer size.", dropped, name);
+        }
+
+        stream << "]}";
+        return stream.str();
+    }
+
+    bool Profiler::export_chrome_trace(const std::string& path, uint64 since)
+    {
+        std::ofstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            log::error("Failed to open {} for writing the profiler trace.", path);
+            return false;
+        }
+
+        file << to_chrome_trace(since);
+        log::info("Wrote profiler trace to {}", path);
+        return true;
+    }
+
+    bool Profiler::export_last_frames(const std::string& path, size_type frames)
+    {
+        std::vector<std::shared_ptr<thread_buffer>> snapshot;
+        {
+            std::lock_guard guard(buffersLock);
+            snapshot = buffers;
+        }
+
+        uint64 since = 0;
+        uint64 latestFrame = 0;
+
+        for (auto& buffer : snapshot)
+        {
+            std::vector<uint64> frameStarts;
+            for (auto& event : read_buffer(*buffer))
+                if (event.type == profile_event_type::frame)
+                    frameStarts.push_back(event.start);
+
+            if (frameStarts.empty() || frameStarts.back() < latestFrame)
+                continue;
+
+            latestFrame = frameStarts.back();
+            since = frameStarts.size() > frames ? frameStarts[frameStarts.size() - frames] : frameStarts.front();
+        }
+
+        return export_chrome_trace(path, since);
+    }
+}
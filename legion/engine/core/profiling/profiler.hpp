@@ -0,0 +1,266 @@
+#pragma once
+#include <core/platform/platform.hpp>
+#include <core/types/primitives.hpp>
+
+#include <Optick/optick.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @file profiler.hpp
+ * @brief Lightweight cross platform profiler.
+ *        Every thread records into it's own fixed size event buffer that only it writes to, so recording never takes a lock.
+ *        The buffers can be exported as Chrome trace JSON which can be opened in chrome://tracing or Perfetto.
+ *        When Optick is disabled (USE_OPTICK 0) the existing OPTICK_EVENT and OPTICK_CATEGORY call sites record zones
+ *        into this profiler instead. Define LEGION_DISABLE_PROFILER to compile all instrumentation out.
+ */
+
+namespace legion::core::profiling
+{
+    enum struct profiler_mode : uint8
+    {
+        disabled,
+        ring_buffer, // Always on, overwrites the oldest events once a thread's buffer is full.
+        capture      // Records until a thread's buffer is full, drops new events after that.
+    };
+
+    enum struct profile_event_type : uint8
+    {
+        zone,
+        frame,
+        counter
+    };
+
+    /**@class zone_description
+     * @brief Static description of an instrumented call site.
+     */
+    struct zone_description
+    {
+        cstring name;
+        cstring file;
+        uint32 line;
+    };
+
+    struct profile_event
+    {
+        const zone_description* description;
+        uint64 start;
+        union
+        {
+            uint64 end;
+            double value;
+        };
+        profile_event_type type;
+    };
+
+    /**@class thread_buffer
+     * @brief Single producer event buffer of one thread.
+     */
+    struct thread_buffer
+    {
+        std::thread::id threadId;
+        std::string name;
+        std::vector<profile_event> events;
+        std::atomic<uint64> writeIndex{ 0 };
+        std::atomic<uint64> dropped{ 0 };
+    };
+
+    /**@class Profiler
+     * @brief Records zones, frames and counters of all threads.
+     */
+    class Profiler
+    {
+    private:
+        static std::atomic<profiler_mode> m_mode;
+        static std::atomic<size_type> m_bufferSize;
+        static std::atomic<uint64> m_generation;
+
+        static thread_buffer& local_buffer();
+
+        /**@brief Copies the valid events out of a buffer while it might still be written to.
+         */
+        static std::vector<profile_event> read_buffer(thread_buffer& buffer);
+
+    public:
+        /**@brief Get the profiler clock in nanoseconds.
+         */
+        L_NODISCARD static uint64 now() noexcept
+        {
+            return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+        }
+
+        L_NODISCARD static bool enabled() noexcept
+        {
+            return m_mode.load(std::memory_order_relaxed) != profiler_mode::disabled;
+        }
+
+        /**@brief Changes the recording mode, switching modes clears all recorded events.
+         */
+        static void set_mode(profiler_mode mode);
+
+        L_NODISCARD static profiler_mode get_mode() noexcept { return m_mode.load(std::memory_order_relaxed); }
+
+        /**@brief Sets the amount of events every thread can buffer. Only affects buffers created after the next mode change.
+         */
+        static void set_buffer_size(size_type events);
+
+        /**@brief Discards all recorded events.
+         */
+        static void clear();
+
+        /**@brief Names the calling thread in exported traces.
+         */
+        static void set_thread_name(const std::string& name);
+
+        /**@brief Creates a description for a name that is only known at runtime, like the name of a process chain.
+         *        Descriptions are interned and stay valid for the rest of the program.
+         */
+        L_NODISCARD static const zone_description* intern_description(const std::string& name, cstring file, uint32 line);
+
+        static void record(const profile_event& event);
+
+        static void record_zone(const zone_description* description, uint64 start, uint64 end)
+        {
+            profile_event event;
+            event.description = description;
+            event.start = start;
+            event.end = end;
+            event.type = profile_event_type::zone;
+            record(event);
+        }
+
+        /**@brief Records a frame of the calling thread, frames show up as a separate track and are used to select the last frames.
+         */
+        static void record_frame(const zone_description* description, uint64 start, uint64 end)
+        {
+            profile_event event;
+            event.description = description;
+            event.start = start;
+            event.end = end;
+            event.type = profile_event_type::frame;
+            record(event);
+        }
+
+        static void record_counter(const zone_description* description, double value)
+        {
+            profile_event event;
+            event.description = description;
+            event.start = now();
+            event.value = value;
+            event.type = profile_event_type::counter;
+            record(event);
+        }
+
+        /**@brief Writes all recorded events as Chrome trace JSON.
+         * @param path File to write to.
+         * @param since Only export events that ended at or after this timestamp.
+         * @returns bool True if the file was written.
+         */
+        static bool export_chrome_trace(const std::string& path, uint64 since = 0);
+
+        /**@brief Writes the events of the last frames as Chrome trace JSON, useful to capture a hitch from ring buffer mode.
+         * @param path File to write to.
+         * @param frames Amount of frames to export, measured on the thread with the most recent frames.
+         * @returns bool True if the file was written.
+         */
+        static bool export_last_frames(const std::string& path, size_type frames);
+
+        /**@brief Serializes the recorded events as Chrome trace JSON.
+         */
+        L_NODISCARD static std::string to_chrome_trace(uint64 since = 0);
+    };
+
+    /**@class scoped_zone
+     * @brief Records a zone from construction until destruction.
+     */
+    struct scoped_zone
+    {
+        const zone_description* description;
+        uint64 start;
+
+        explicit scoped_zone(const zone_description* desc) noexcept : description(desc), start(Profiler::enabled() ? Profiler::now() : 0) {}
+
+        ~scoped_zone()
+        {
+            if (start)
+                Profiler::record_zone(description, start, Profiler::now());
+        }
+
+        scoped_zone(const scoped_zone&) = delete;
+        scoped_zone& operator=(const scoped_zone&) = delete;
+    };
+
+    /**@class scoped_frame
+     * @brief Records a frame from construction until destruction.
+     */
+    struct scoped_frame
+    {
+        const zone_description* description;
+        uint64 start;
+
+        explicit scoped_frame(const zone_description* desc) noexcept : description(desc), start(Profiler::enabled() ? Profiler::now() : 0) {}
+
+        ~scoped_frame()
+        {
+            if (start)
+                Profiler::record_frame(description, start, Profiler::now());
+        }
+
+        scoped_frame(const scoped_frame&) = delete;
+        scoped_frame& operator=(const scoped_frame&) = delete;
+    };
+
+    /**@brief Selects the explicit zone name if one was given, the function name otherwise.
+     */
+    constexpr cstring zone_name(cstring function, cstring name) noexcept
+    {
+        return name[0] ? name : function;
+    }
+}
+
+#define LEGION_PROFILER_CONCAT_IMPL(a, b) a##b
+#define LEGION_PROFILER_CONCAT(a, b) LEGION_PROFILER_CONCAT_IMPL(a, b)
+
+#if !defined(LEGION_DISABLE_PROFILER)
+    /**@def LEGION_PROFILE_ZONE
+     * @brief Records a zone until the end of the current scope, the name is optional and defaults to the function name.
+     */
+    #define LEGION_PROFILE_ZONE(...)                                                                                                                \
+        static const ::legion::core::profiling::zone_description LEGION_PROFILER_CONCAT(legion_zone_desc_, __LINE__){                              \
+            ::legion::core::profiling::zone_name(__func__, "" __VA_ARGS__), __FILE__, __LINE__ };                                                  \
+        ::legion::core::profiling::scoped_zone LEGION_PROFILER_CONCAT(legion_zone_, __LINE__)(&LEGION_PROFILER_CONCAT(legion_zone_desc_, __LINE__))
+
+    /**@def LEGION_PROFILE_FRAME
+     * @brief Records a frame of the calling thread until the end of the current scope.
+     */
+    #define LEGION_PROFILE_FRAME(NAME)                                                                                                              \
+        static const ::legion::core::profiling::zone_description LEGION_PROFILER_CONCAT(legion_frame_desc_, __LINE__){ NAME, __FILE__, __LINE__ }; \
+        ::legion::core::profiling::scoped_frame LEGION_PROFILER_CONCAT(legion_frame_, __LINE__)(&LEGION_PROFILER_CONCAT(legion_frame_desc_, __LINE__))
+
+    /**@def LEGION_PROFILE_COUNTER
+     * @brief Records the value of a counter at the current time.
+     */
+    #define LEGION_PROFILE_COUNTER(NAME, VALUE)                                                                                                     \
+        do {                                                                                                                                        \
+            static const ::legion::core::profiling::zone_description LEGION_PROFILER_CONCAT(legion_counter_desc_, __LINE__){ NAME, __FILE__, __LINE__ }; \
+            if (::legion::core::profiling::Profiler::enabled())                                                                                     \
+                ::legion::core::profiling::Profiler::record_counter(&LEGION_PROFILER_CONCAT(legion_counter_desc_, __LINE__), static_cast<double>(VALUE)); \
+        } while (false)
+#else
+    #define LEGION_PROFILE_ZONE(...)
+    #define LEGION_PROFILE_FRAME(NAME)
+    #define LEGION_PROFILE_COUNTER(NAME, VALUE)
+#endif
+
+#if !USE_OPTICK
+    // Route the existing Optick call sites to the internal profiler.
+    #undef OPTICK_EVENT
+    #undef OPTICK_CATEGORY
+    #define OPTICK_EVENT(...) LEGION_PROFILE_ZONE(__VA_ARGS__)
+    #define OPTICK_CATEGORY(NAME, CATEGORY) LEGION_PROFILE_ZONE(NAME)
+#endif
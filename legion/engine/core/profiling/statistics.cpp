@@ -0,0 +1,223 @@
+#include <core/profiling/statistics.hpp>
+#include <core/events/eventbus.hpp>
+#include <core/events/defaultevents.hpp>
+#include <core/async/rw_spinlock.hpp>
+#include <core/logging/logging.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <unordered_map>
+
+namespace legion::core::profiling
+{
+    namespace
+    {
+        constexpr size_type category_count = 3;
+
+        async::rw_spinlock entriesLock;
+        std::unordered_map<std::string, std::unique_ptr<statistic_entry>> entries[category_count];
+
+        cstring category_name(statistic_category category)
+        {
+            switch (category)
+            {
+            case statistic_category::process: return "process";
+            case statistic_category::chain: return "chain";
+            case statistic_category::job_pool: return "job pool";
+            default: return "unknown";
+            }
+        }
+    }
+
+    events::EventBus* Statistics::m_eventBus = nullptr;
+    std::atomic<float> Statistics::m_logInterval{ 0.f };
+
+    size_type histogram::bucket_of(uint64 value) noexcept
+    {
+        constexpr uint64 maxValue = (1ull << max_value_bits) - 1;
+        if (value > maxValue)
+            value = maxValue;
+
+        if (value < (sub_bucket_count << 1))
+            return static_cast<size_type>(value);
+
+        size_type msb = 0;
+        for (uint64 v = value; v >>= 1;)
+            msb++;
+
+        const size_type shift = msb - sub_bucket_bits;
+        return shift * sub_bucket_count + static_cast<size_type>(value >> shift);
+    }
+
+    uint64 histogram::value_of(size_type bucket) noexcept
+    {
+        if (bucket < sub_bucket_count)
+            return bucket;
+
+        const size_type shift = bucket / sub_bucket_count - 1;
+        const uint64 mantissa = bucket % sub_bucket_count + sub_bucket_count;
+        return (mantissa << shift) + ((1ull << shift) >> 1); // Middle of the bucket's range.
+    }
+
+    void histogram::record(uint64 value) noexcept
+    {
+        m_buckets[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+        m_count.fetch_add(1, std::memory_order_relaxed);
+        m_sum.fetch_add(value, std::memory_order_relaxed);
+
+        uint64 current = m_min.load(std::memory_order_relaxed);
+        while (value < current && !m_min.compare_exchange_weak(current, value, std::memory_order_relaxed));
+
+        current = m_max.load(std::memory_order_relaxed);
+        while (value > current && !m_max.compare_exchange_weak(current, value, std::memory_order_relaxed));
+    }
+
+    void histogram::reset() noexcept
+    {
+        for (auto& bucket : m_buckets)
+            bucket.store(0, std::memory_order_relaxed);
+        m_count.store(0, std::memory_order_relaxed);
+        m_sum.store(0, std::memory_order_relaxed);
+        m_min.store(static_cast<uint64>(-1), std::memory_order_relaxed);
+        m_max.store(0, std::memory_order_relaxed);
+    }
+
+    uint64 histogram::min() const noexcept
+    {
+        return count() ? m_min.load(std::memory_order_relaxed) : 0;
+    }
+
+    double histogram::mean() const noexcept
+    {
+        uint64 c = count();
+        return c ? static_cast<double>(m_sum.load(std::memory_order_relaxed)) / c : 0.0;
+    }
+
+    uint64 histogram::percentile(double fraction) const noexcept
+    {
+        uint64 total = count();
+        if (!total)
+            return 0;
+
+        fraction = std::clamp(fraction, 0.0, 1.0);
+        uint64 target = std::max<uint64>(1, static_cast<uint64>(std::ceil(fraction * total)));
+
+        uint64 accumulated = 0;
+        for (size_type i = 0; i < bucket_count; i++)
+        {
+            accumulated += m_buckets[i].load(std::memory_order_relaxed);
+            if (accumulated >= target)
+                return std::clamp(value_of(i), min(), max());
+        }
+
+        return max();
+    }
+
+    statistic_entry& Statistics::get_entry(statistic_category category, const std::string& name)
+    {
+        auto& map = entries[static_cast<size_type>(category)];
+
+        {
+            async::readonly_guard guard(entriesLock);
+            auto it = map.find(name);
+            if (it != map.end())
+                return *it->second;
+        }
+
+        async::readwrite_guard guard(entriesLock);
+        auto& entry = map[name];
+        if (!entry)
+            entry = std::make_unique<statistic_entry>(name, category);
+        return *entry;
+    }
+
+    statistic_entry* Statistics::find_entry(statistic_category category, const std::string& name)
+    {
+        auto& map = entries[static_cast<size_type>(category)];
+
+        async::readonly_guard guard(entriesLock);
+        auto it = map.find(name);
+        return it != map.end() ? it->second.get() : nullptr;
+    }
+
+    void Statistics::raise_budget_exceeded(statistic_entry& entry, uint64 value)
+    {
+        entry.exceeded.fetch_add(1, std::memory_order_relaxed);
+
+        if (!m_eventBus)
+            return;
+
+        m_eventBus->raiseEvent<events::budget_exceeded>(entry.name, entry.category,
+            static_cast<float>(to_unit(entry.category, static_cast<double>(value))),
+            static_cast<float>(to_unit(entry.category, static_cast<double>(entry.budget.load(std::memory_order_relaxed)))));
+    }
+
+    void Statistics::set_budget(statistic_category category, const std::string& name, float milliseconds)
+    {
+        get_entry(category, name).budget.store(static_cast<uint64>(std::max(milliseconds, 0.f) * 1000000.0), std::memory_order_relaxed);
+    }
+
+    double Statistics::percentile(statistic_category category, const std::string& name, double fraction)
+    {
+        if (auto* entry = find_entry(category, name))
+            return to_unit(category, static_cast<double>(entry->values.percentile(fraction)));
+        return 0.0;
+    }
+
+    statistic_summary Statistics::summarize(const statistic_entry& entry)
+    {
+        const histogram& values = entry.values;
+
+        statistic_summary summary;
+        summary.name = entry.name;
+        summary.category = entry.category;
+        summary.count = values.count();
+        summary.exceeded = entry.exceeded.load(std::memory_order_relaxed);
+        summary.mean = to_unit(entry.category, values.mean());
+        summary.min = to_unit(entry.category, static_cast<double>(values.min()));
+        summary.p50 = to_unit(entry.category, static_cast<double>(values.percentile(0.5)));
+        summary.p90 = to_unit(entry.category, static_cast<double>(values.percentile(0.9)));
+        summary.p99 = to_unit(entry.category, static_cast<double>(values.percentile(0.99)));
+        summary.max = to_unit(entry.category, static_cast<double>(values.max()));
+        return summary;
+    }
+
+    std::vector<statistic_summary> Statistics::report()
+    {
+        std::vector<statistic_summary> result;
+
+        async::readonly_guard guard(entriesLock);
+        for (auto& map : entries)
+            for (auto& [name, entry] : map)
+                result.push_back(summarize(*entry));
+
+        return result;
+    }
+
+    void Statistics::reset()
+    {
+        async::readonly_guard guard(entriesLock);
+        for (auto& map : entries)
+            for (auto& [name, entry] : map)
+            {
+                entry->values.reset();
+                entry->exceeded.store(0, std::memory_order_relaxed);
+            }
+    }
+
+    void Statistics::log_report()
+    {
+        for (auto& summary : report())
+        {
+            if (!summary.count)
+                continue;
+
+            cstring unit = summary.category == statistic_category::job_pool ? "%" : "ms";
+            log::info("[{}] {}: p50 {:.3f}{} p90 {:.3f}{} p99 {:.3f}{} max {:.3f}{} ({} samples, {} over budget)",
+                category_name(summary.category), summary.name,
+                summary.p50, unit, summary.p90, unit, summary.p99, unit, summary.max, unit,
+                summary.count, summary.exceeded);
+        }
+    }
+}
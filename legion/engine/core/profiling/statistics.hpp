@@ -0,0 +1,178 @@
+#pragma once
+#include <core/platform/platform.hpp>
+#include <core/types/primitives.hpp>
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <vector>
+
+/**
+ * @file statistics.hpp
+ * @brief Runtime frame statistics.
+ *        The scheduler records the execution time of every process, the frame time of every process chain and the utilization of the job pool
+ *        into fixed size histograms. Percentiles can be requested at runtime to find regressions or to drive adaptive quality decisions.
+ */
+
+namespace legion::core::events
+{
+    class EventBus;
+}
+
+namespace legion::core::scheduling
+{
+    class Scheduler;
+}
+
+namespace legion::core::profiling
+{
+    /**@class histogram
+     * @brief Fixed size log-linear histogram in the style of an HDR histogram.
+     *        Values are stored with a relative error of at most 1/16th, recording is lock free and never allocates.
+     */
+    class histogram
+    {
+    public:
+        static constexpr size_type sub_bucket_bits = 4;
+        static constexpr size_type sub_bucket_count = 1ull << sub_bucket_bits;
+        static constexpr size_type max_value_bits = 40; // ~18 minutes in nanoseconds.
+        static constexpr size_type bucket_count = (max_value_bits - sub_bucket_bits + 1) * sub_bucket_count;
+
+    private:
+        std::array<std::atomic<uint32>, bucket_count> m_buckets;
+        std::atomic<uint64> m_count{ 0 };
+        std::atomic<uint64> m_sum{ 0 };
+        std::atomic<uint64> m_min{ static_cast<uint64>(-1) };
+        std::atomic<uint64> m_max{ 0 };
+
+        static size_type bucket_of(uint64 value) noexcept;
+        static uint64 value_of(size_type bucket) noexcept;
+
+    public:
+        histogram() noexcept { reset(); }
+
+        void record(uint64 value) noexcept;
+        void reset() noexcept;
+
+        L_NODISCARD uint64 count() const noexcept { return m_count.load(std::memory_order_relaxed); }
+        L_NODISCARD uint64 min() const noexcept;
+        L_NODISCARD uint64 max() const noexcept { return m_max.load(std::memory_order_relaxed); }
+        L_NODISCARD double mean() const noexcept;
+
+        /**@brief Get the value below which the given fraction of the recorded values lie.
+         * @param fraction Percentile in the range [0, 1], e.g. 0.99 for p99.
+         */
+        L_NODISCARD uint64 percentile(double fraction) const noexcept;
+    };
+
+    enum struct statistic_category : uint8
+    {
+        process,  // Execution time of a single process, in nanoseconds.
+        chain,    // Frame time of a process chain, in nanoseconds.
+        job_pool  // Utilization of the job pool per main thread frame, in hundredths of a percent.
+    };
+
+    /**@class statistic_entry
+     * @brief Histogram of a single process, chain or the job pool with an optional budget.
+     */
+    struct statistic_entry
+    {
+        const std::string name;
+        const statistic_category category;
+        histogram values;
+        std::atomic<uint64> budget{ 0 };
+        std::atomic<uint64> exceeded{ 0 };
+
+        statistic_entry(const std::string& name, statistic_category category) : name(name), category(category) {}
+    };
+
+    /**@class statistic_summary
+     * @brief Snapshot of a statistic_entry. Timings are in milliseconds, utilization is in percent.
+     */
+    struct statistic_summary
+    {
+        std::string name;
+        statistic_category category;
+        uint64 count;
+        uint64 exceeded;
+        double mean;
+        double min;
+        double p50;
+        double p90;
+        double p99;
+        double max;
+    };
+
+    /**@class Statistics
+     * @brief Registry of all frame statistics.
+     */
+    class Statistics
+    {
+        friend class legion::core::scheduling::Scheduler;
+    private:
+        static events::EventBus* m_eventBus;
+        static std::atomic<float> m_logInterval;
+
+        static void raise_budget_exceeded(statistic_entry& entry, uint64 value);
+
+    public:
+        /**@brief Converts a recorded value into the unit of the category, milliseconds for timings and percent for utilization.
+         */
+        L_NODISCARD static double to_unit(statistic_category category, double value) noexcept
+        {
+            return category == statistic_category::job_pool ? value * 0.01 : value * 0.000001;
+        }
+
+        /**@brief Get or create the entry of a process, chain or job pool statistic.
+         * @note Entries are never destroyed, the returned reference can be cached.
+         */
+        L_NODISCARD static statistic_entry& get_entry(statistic_category category, const std::string& name);
+
+        /**@brief Get an existing entry.
+         * @returns statistic_entry* Pointer to the entry, nullptr if nothing was recorded under that name yet.
+         */
+        L_NODISCARD static statistic_entry* find_entry(statistic_category category, const std::string& name);
+
+        /**@brief Records a value and raises events::budget_exceeded if the entry has a budget and the value exceeds it.
+         */
+        static void record(statistic_entry& entry, uint64 value) noexcept
+        {
+            entry.values.record(value);
+
+            uint64 budget = entry.budget.load(std::memory_order_relaxed);
+            if (budget && value > budget)
+                raise_budget_exceeded(entry, value);
+        }
+
+        /**@brief Sets the budget of a process or chain.
+         * @param milliseconds Maximum allowed time, 0 to remove the budget.
+         */
+        static void set_budget(statistic_category category, const std::string& name, float milliseconds);
+
+        /**@brief Get a percentile of a statistic in the unit of it's category.
+         * @param fraction Percentile in the range [0, 1], e.g. 0.99 for p99.
+         * @returns double The percentile or 0 if nothing was recorded.
+         */
+        L_NODISCARD static double percentile(statistic_category category, const std::string& name, double fraction);
+
+        L_NODISCARD static double p50(statistic_category category, const std::string& name) { return percentile(category, name, 0.5); }
+        L_NODISCARD static double p99(statistic_category category, const std::string& name) { return percentile(category, name, 0.99); }
+
+        L_NODISCARD static statistic_summary summarize(const statistic_entry& entry);
+
+        /**@brief Get a summary of all statistics.
+         */
+        L_NODISCARD static std::vector<statistic_summary> report();
+
+        /**@brief Clears all recorded values, budgets are kept.
+         */
+        static void reset();
+
+        /**@brief Sets the interval at which the scheduler logs the report, 0 disables periodic logging.
+         */
+        static void set_log_interval(float seconds) noexcept { m_logInterval.store(seconds, std::memory_order_relaxed); }
+        L_NODISCARD static float get_log_interval() noexcept { return m_logInterval.load(std::memory_order_relaxed); }
+
+        static void log_report();
+    };
+}
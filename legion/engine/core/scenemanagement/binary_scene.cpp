@@ -0,0 +1,452 @@
+#include <core/scenemanagement/binary_scene.hpp>
+#include <core/defaults/defaultcomponents.hpp>
+#include <core/logging/logging.hpp>
+
+#include <unordered_map>
+#include <cstring>
+
+namespace legion::core::scenemanagement
+{
+    namespace detail
+    {
+        constexpr size_type column_alignment = 16;
+
+        struct byte_writer
+        {
+            byte_vec& buffer;
+
+            template<typename T>
+            void write(const T& value)
+            {
+                write(&value, sizeof(T));
+            }
+
+            void write(const void* data, size_type size)
+            {
+                size_type offset = buffer.size();
+                buffer.resize(offset + size);
+                if (size)
+                    std::memcpy(buffer.data() + offset, data, size);
+            }
+
+            void align(size_type alignment)
+            {
+                buffer.resize((buffer.size() + alignment - 1) / alignment * alignment, 0);
+            }
+        };
+
+        struct byte_reader
+        {
+            const byte_vec& buffer;
+
+            /**@brief Returns a pointer to a range within the buffer, nullptr if the range is out of bounds.
+             */
+            const byte* at(uint64 offset, uint64 size) const
+            {
+                if (offset > buffer.size() || size > buffer.size() - offset)
+                    return nullptr;
+                return buffer.data() + offset;
+            }
+
+            template<typename T>
+            bool read(uint64 offset, T& value) const
+            {
+                const byte* ptr = at(offset, sizeof(T));
+                if (!ptr)
+                    return false;
+                std::memcpy(&value, ptr, sizeof(T));
+                return true;
+            }
+        };
+
+        template<typename component_type>
+        void apply_instance_transforms(ecs::EcsRegistry* registry, const ecs::entity_container& roots, size_type instances, const std::vector<component_type>& values)
+        {
+            if (values.empty())
+                return;
+
+            if (values.size() != instances)
+            {
+                log::warn("Expected {} {} overrides for instantiation, got {}.", instances, nameOfType<component_type>(), values.size());
+                return;
+            }
+
+            // Every instance has the same amount of roots, root i belongs to instance i / rootsPerInstance.
+            const size_type rootsPerInstance = roots.size() / instances;
+            if (!rootsPerInstance)
+                return;
+
+            auto* family = registry->getFamily<component_type>();
+            async::readwrite_guard guard(family->get_lock());
+            for (size_type i = 0; i < roots.size(); i++)
+                if (roots[i].has_component<component_type>())
+                    family->get_component(roots[i]) = values[i / rootsPerInstance];
+        }
+    }
+
+    byte_vec BinaryScene::write(ecs::EcsRegistry* registry, scheduling::Scheduler* scheduler, const ecs::entity_container& roots)
+    {
+        OPTICK_EVENT();
+        const id_type hierarchyId = typeHash<hierarchy>();
+
+        // Gather the entire tree breadth first so that parents are always stored before their children.
+        ecs::entity_container entities = roots;
+        std::unordered_map<id_type, uint32> indices;
+        for (uint32 i = 0; i < roots.size(); i++)
+            indices.emplace(roots[i].get_id(), i);
+
+        for (size_type i = 0; i < entities.size(); i++)
+            for (auto& child : entities[i].children())
+            {
+                indices.emplace(child.get_id(), static_cast<uint32>(entities.size()));
+                entities.push_back(child);
+            }
+
+        std::vector<std::string> strings;
+        std::unordered_map<std::string, uint32> stringIndices;
+        auto internString = [&](const std::string& str)
+        {
+            auto [itr, inserted] = stringIndices.emplace(str, static_cast<uint32>(strings.size()));
+            if (inserted)
+                strings.push_back(str);
+            return itr->second;
+        };
+
+        std::vector<uint32> parents(entities.size());
+        std::vector<uint32> names(entities.size());
+        std::vector<id_type> ids(entities.size());
+
+        std::vector<id_type> typeIds;
+        std::unordered_map<id_type, size_type> sectionIndices;
+        std::vector<ecs::entity_container> columns;
+        std::vector<std::vector<uint32>> columnIndices;
+
+        for (uint32 i = 0; i < entities.size(); i++)
+        {
+            auto hry = entities[i].read_component<hierarchy>();
+            names[i] = internString(hry.name);
+            ids[i] = entities[i].get_id();
+            parents[i] = (i < roots.size() || !indices.count(hry.parent.get_id())) ? binary_scene_no_parent : indices.at(hry.parent.get_id());
+
+            for (id_type typeId : registry->getEntityData(entities[i]).components)
+            {
+                if (typeId == hierarchyId)
+                    continue;
+
+                auto [itr, inserted] = sectionIndices.emplace(typeId, typeIds.size());
+                if (inserted)
+                {
+                    typeIds.push_back(typeId);
+                    columns.emplace_back();
+                    columnIndices.emplace_back();
+                }
+
+                columns[itr->second].push_back(entities[i]);
+                columnIndices[itr->second].push_back(i);
+            }
+        }
+
+        // Every column gets serialized by it's own job, pools only lock themselves so this is safe to do in parallel.
+        std::vector<byte_vec> columnData(typeIds.size());
+        scheduler->queueJobs(typeIds.size(), [&]()
+            {
+                id_type index = async::this_job::get_id();
+                registry->getFamily(typeIds[index])->write_column(columns[index], columnData[index]);
+            }).wait();
+
+        std::vector<binary_scene_section> sections(typeIds.size());
+        for (size_type i = 0; i < typeIds.size(); i++)
+        {
+            auto* family = registry->getFamily(typeIds[i]);
+            auto& section = sections[i];
+            section.typeId = typeIds[i];
+            section.nameIndex = internString(registry->getFamilyName(typeIds[i]));
+            section.layout = family->get_column_layout();
+            section.elementSize = static_cast<uint32>(family->get_component_size());
+            section.entityCount = static_cast<uint32>(columns[i].size());
+            section.dataSize = columnData[i].size();
+        }
+
+        byte_vec buffer;
+        detail::byte_writer writer{ buffer };
+
+        binary_scene_header header;
+        header.entityCount = static_cast<uint32>(entities.size());
+        header.sectionCount = static_cast<uint32>(sections.size());
+        writer.write(header);
+
+        header.entityTableOffset = buffer.size();
+        writer.write(parents.data(), parents.size() * sizeof(uint32));
+        writer.write(names.data(), names.size() * sizeof(uint32));
+        writer.write(ids.data(), ids.size() * sizeof(id_type));
+
+        header.stringTableOffset = buffer.size();
+        writer.write(static_cast<uint32>(strings.size()));
+        for (auto& str : strings)
+        {
+            writer.write(static_cast<uint32>(str.size()));
+            writer.write(str.data(), str.size());
+        }
+
+        writer.align(alignof(binary_scene_section));
+        header.sectionIndexOffset = buffer.size();
+        size_type sectionIndexSize = sections.size() * sizeof(binary_scene_section);
+        buffer.resize(buffer.size() + sectionIndexSize); // Patched once the column offsets are known.
+
+        for (size_type i = 0; i < sections.size(); i++)
+        {
+            writer.align(detail::column_alignment);
+            sections[i].idsOffset = buffer.size();
+            writer.write(columnIndices[i].data(), columnIndices[i].size() * sizeof(uint32));
+
+            writer.align(detail::column_alignment);
+            sections[i].dataOffset = buffer.size();
+            writer.write(columnData[i].data(), columnData[i].size());
+        }
+
+        if (sectionIndexSize)
+            std::memcpy(buffer.data() + header.sectionIndexOffset, sections.data(), sectionIndexSize);
+        std::memcpy(buffer.data(), &header, sizeof(header));
+
+        return buffer;
+    }
+
+    bool BinaryScene::parse(byte_vec&& buffer, binary_scene_data& scene)
+    {
+        OPTICK_EVENT();
+        scene.buffer = std::move(buffer);
+        detail::byte_reader reader{ scene.buffer };
+
+        binary_scene_header& header = scene.header;
+        if (!reader.read(0, header) || header.magic != binary_scene_magic)
+        {
+            log::error("Data is not a binary scene.");
+            return false;
+        }
+
+        if (header.version != binary_scene_version)
+        {
+            log::error("Binary scene version {} is not supported, expected version {}.", header.version, binary_scene_version);
+            return false;
+        }
+
+        const uint32* parents = reinterpret_cast<const uint32*>(reader.at(header.entityTableOffset, header.entityCount * sizeof(uint32) * 2ull));
+        if (!parents)
+        {
+            log::error("Binary scene entity table is corrupted.");
+            return false;
+        }
+        scene.parentIndices.assign(parents, parents + header.entityCount);
+        scene.nameIndices.assign(parents + header.entityCount, parents + header.entityCount * 2ull);
+
+        const byte* ids = reader.at(header.entityTableOffset + header.entityCount * sizeof(uint32) * 2ull, header.entityCount * static_cast<uint64>(sizeof(id_type)));
+        if (!ids)
+        {
+            log::error("Binary scene entity table is corrupted.");
+            return false;
+        }
+
+        scene.entityIndices.clear();
+        scene.entityIndices.reserve(header.entityCount);
+        for (uint32 i = 0; i < header.entityCount; i++)
+        {
+            id_type id;
+            std::memcpy(&id, ids + i * sizeof(id_type), sizeof(id_type));
+            scene.entityIndices.emplace(id, i);
+        }
+
+        scene.strings.clear();
+        {
+            uint64 offset = header.stringTableOffset;
+            uint32 stringCount = 0;
+            if (!reader.read(offset, stringCount))
+            {
+                log::error("Binary scene string table is corrupted.");
+                return false;
+            }
+            offset += sizeof(uint32);
+
+            scene.strings.reserve(stringCount);
+            for (uint32 i = 0; i < stringCount; i++)
+            {
+                uint32 length = 0;
+                const byte* str = reader.read(offset, length) ? reader.at(offset + sizeof(uint32), length) : nullptr;
+                if (!str)
+                {
+                    log::error("Binary scene string table is corrupted.");
+                    return false;
+                }
+                scene.strings.emplace_back(reinterpret_cast<const char*>(str), length);
+                offset += sizeof(uint32) + length;
+            }
+        }
+
+        scene.sections.resize(header.sectionCount);
+        if (header.sectionCount)
+        {
+            const byte* sectionIndex = reader.at(header.sectionIndexOffset, header.sectionCount * sizeof(binary_scene_section));
+            if (!sectionIndex)
+            {
+                log::error("Binary scene section index is corrupted.");
+                return false;
+            }
+            std::memcpy(scene.sections.data(), sectionIndex, header.sectionCount * sizeof(binary_scene_section));
+        }
+
+        return true;
+    }
+
+    ecs::entity_container BinaryScene::instantiate(ecs::EcsRegistry* registry, scheduling::Scheduler* scheduler, const binary_scene_data& scene,
+        ecs::entity_handle parent, size_type instances, const instance_transforms& transforms)
+    {
+        OPTICK_EVENT();
+        const auto& header = scene.header;
+        const auto& parentIndices = scene.parentIndices;
+        const auto& nameIndices = scene.nameIndices;
+        const auto& strings = scene.strings;
+        const auto& sections = scene.sections;
+        detail::byte_reader reader{ scene.buffer };
+
+        if (!header.entityCount || !instances)
+            return {};
+
+        if (!registry->validateEntity(parent) || !parent.has_component<hierarchy>())
+            parent = ecs::entity_handle(world_entity_id);
+
+        // Create the entities of all instances and their hierarchy in bulk,
+        // entity i of instance k lives at index k * entityCount + i and hierarchy links are patched by index.
+        const size_type entityCount = header.entityCount;
+        ecs::entity_container entities = registry->createEntities(entityCount * instances, false);
+        ecs::entity_container roots;
+
+        ecs::component_container<hierarchy> hierarchies(entities.size());
+        for (size_type k = 0; k < instances; k++)
+        {
+            const size_type offset = k * entityCount;
+            for (size_type i = 0; i < entityCount; i++)
+            {
+                auto& hry = hierarchies[offset + i];
+                if (nameIndices[i] < strings.size())
+                    hry.name = strings[nameIndices[i]];
+
+                uint32 parentIndex = parentIndices[i];
+                if (parentIndex < i) // Parents are always stored before their children.
+                {
+                    hry.parent = entities[offset + parentIndex];
+                    hierarchies[offset + parentIndex].children.insert(entities[offset + i]);
+                }
+                else
+                {
+                    hry.parent = parent;
+                    roots.push_back(entities[offset + i]);
+                }
+            }
+        }
+
+        auto* hierarchyFamily = registry->getFamily<hierarchy>();
+        hierarchyFamily->insert_components(entities, hierarchies);
+        registry->registerComponents(typeHash<hierarchy>(), entities);
+
+        {
+            async::readwrite_guard guard(hierarchyFamily->get_lock());
+            auto& children = hierarchyFamily->get_component(parent.get_id()).children;
+            for (auto& root : roots)
+                children.insert(root);
+        }
+
+        // Resolve the columns before going parallel so that the jobs only need to touch their own component pool.
+        std::vector<ecs::component_pool_base*> families(sections.size(), nullptr);
+        std::vector<ecs::entity_container> columns(sections.size());
+        std::vector<const byte*> columnData(sections.size(), nullptr);
+
+        for (size_type i = 0; i < sections.size(); i++)
+        {
+            auto& section = sections[i];
+            std::string typeName = section.nameIndex < strings.size() ? strings[section.nameIndex] : std::to_string(section.typeId);
+
+            if (!registry->hasFamily(section.typeId))
+            {
+                log::warn("Binary scene contains unknown component type {}, did you forget to report it?", typeName);
+                continue;
+            }
+
+            auto* family = registry->getFamily(section.typeId);
+            if (family->get_column_layout() != section.layout || (section.layout == ecs::column_layout::packed && family->get_component_size() != section.elementSize))
+            {
+                log::warn("Layout of component type {} has changed since the binary scene was saved, skipping it.", typeName);
+                continue;
+            }
+
+            const uint32* ids = reinterpret_cast<const uint32*>(reader.at(section.idsOffset, section.entityCount * static_cast<uint64>(sizeof(uint32))));
+            const byte* componentData = reader.at(section.dataOffset, section.dataSize);
+            if (!ids || !componentData)
+            {
+                log::error("Column of component type {} is corrupted.", typeName);
+                continue;
+            }
+
+            auto& column = columns[i];
+            column.reserve(section.entityCount * instances);
+            bool valid = true;
+            for (size_type k = 0; k < instances && valid; k++)
+                for (uint32 j = 0; j < section.entityCount; j++)
+                {
+                    if (ids[j] >= entityCount)
+                    {
+                        valid = false;
+                        break;
+                    }
+                    column.push_back(entities[k * entityCount + ids[j]]);
+                }
+
+            if (!valid)
+            {
+                log::error("Column of component type {} references unknown entities.", typeName);
+                column.clear();
+                continue;
+            }
+
+            families[i] = family;
+            columnData[i] = componentData;
+        }
+
+        ecs::entity_remap remap{ &scene.entityIndices, &entities, entityCount, 0 };
+
+        std::vector<uint8> succeeded(sections.size(), false);
+        scheduler->queueJobs(sections.size(), [&]()
+            {
+                id_type index = async::this_job::get_id();
+                if (families[index])
+                    succeeded[index] = families[index]->read_column(columns[index], columnData[index], sections[index].dataSize, instances, remap);
+            }).wait();
+
+        for (size_type i = 0; i < sections.size(); i++)
+            if (succeeded[i])
+                registry->registerComponents(sections[i].typeId, columns[i]);
+            else if (families[i])
+                log::error("Failed to read column of component type {}.", registry->getFamilyName(sections[i].typeId));
+
+        detail::apply_instance_transforms(registry, roots, instances, transforms.positions);
+        detail::apply_instance_transforms(registry, roots, instances, transforms.rotations);
+        detail::apply_instance_transforms(registry, roots, instances, transforms.scales);
+
+        registry->updateQueries(entities);
+
+        hierarchyFamily->raise_creation_events(entities);
+        for (size_type i = 0; i < sections.size(); i++)
+            if (succeeded[i])
+                families[i]->raise_creation_events(columns[i]);
+
+        return roots;
+    }
+
+    ecs::entity_handle BinaryScene::read(ecs::EcsRegistry* registry, scheduling::Scheduler* scheduler, byte_vec data)
+    {
+        binary_scene_data scene;
+        if (!parse(std::move(data), scene))
+            return ecs::entity_handle(invalid_id);
+
+        ecs::entity_container roots = instantiate(registry, scheduler, scene);
+        return roots.empty() ? ecs::entity_handle(invalid_id) : roots[0];
+    }
+}
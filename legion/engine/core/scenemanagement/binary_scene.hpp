@@ -0,0 +1,133 @@
+#pragma once
+#include <core/types/types.hpp>
+#include <core/ecs/ecsregistry.hpp>
+#include <core/scheduling/scheduler.hpp>
+#include <core/defaults/defaultcomponents.hpp>
+
+#include <unordered_map>
+
+/**
+ * @file binary_scene.hpp
+ * @brief Columnar binary scene format.
+ *        A binary scene stores one column per component type instead of one object per entity:
+ *        [header][entity table][string table][section index][columns...]
+ *        The entity table stores the parent, name and original id of every entity by index, each section in the section index
+ *        references a column of entity indices and a packed or archived array of component data.
+ */
+
+namespace legion::core::scenemanagement
+{
+    constexpr uint32 binary_scene_magic = 0x534E474C; // "LGNS"
+    constexpr uint32 binary_scene_version = 2;
+    constexpr uint32 binary_scene_no_parent = 0xFFFFFFFF;
+
+    struct binary_scene_header
+    {
+        uint32 magic = binary_scene_magic;
+        uint32 version = binary_scene_version;
+        uint32 entityCount = 0;
+        uint32 sectionCount = 0;
+        uint64 entityTableOffset = 0;
+        uint64 stringTableOffset = 0;
+        uint64 sectionIndexOffset = 0;
+    };
+
+    struct binary_scene_section
+    {
+        id_type typeId = invalid_id;
+        uint32 nameIndex = 0;
+        ecs::column_layout layout = ecs::column_layout::empty;
+        uint8 padding[3] = { 0, 0, 0 };
+        uint32 elementSize = 0;
+        uint32 entityCount = 0;
+        uint64 idsOffset = 0;
+        uint64 dataOffset = 0;
+        uint64 dataSize = 0;
+    };
+
+    /**@class binary_scene_data
+     * @brief Parsed binary scene that is ready to be instantiated.
+     * @note Parsing doesn't touch the ECS and can thus happen on any thread.
+     */
+    struct binary_scene_data
+    {
+        byte_vec buffer;
+        binary_scene_header header;
+        std::vector<uint32> parentIndices;
+        std::vector<uint32> nameIndices;
+        std::unordered_map<id_type, uint32> entityIndices; // Id the entity had when it was saved to index into the entity table.
+        std::vector<std::string> strings;
+        std::vector<binary_scene_section> sections;
+    };
+
+    /**@class instance_transforms
+     * @brief Overrides for the transforms of the root entities of an instantiated scene.
+     *        Each non-empty vector needs to contain one value per instance, the value gets applied to all roots of that instance.
+     * @note Roots that don't have the component are left untouched, empty vectors keep the stored values.
+     */
+    struct instance_transforms
+    {
+        std::vector<position> positions;
+        std::vector<rotation> rotations;
+        std::vector<scale> scales;
+    };
+
+    /**@class BinaryScene
+     * @brief Reader and writer of the columnar binary scene format.
+     */
+    class BinaryScene
+    {
+    public:
+        /**@brief Serializes a set of entities and all of their children into the binary scene format.
+         * @param registry Registry that owns the entities.
+         * @param scheduler Scheduler used to write the component columns in parallel.
+         * @param roots Root entities of the scene.
+         * @returns byte_vec Buffer containing the entire file.
+         */
+        static byte_vec write(ecs::EcsRegistry* registry, scheduling::Scheduler* scheduler, const ecs::entity_container& roots);
+
+        /**@brief Serializes an entity and all of it's children into the binary scene format.
+         * @param registry Registry that owns the entities.
+         * @param scheduler Scheduler used to write the component columns in parallel.
+         * @param root Root entity of the scene.
+         * @returns byte_vec Buffer containing the entire file.
+         */
+        static byte_vec write(ecs::EcsRegistry* registry, scheduling::Scheduler* scheduler, ecs::entity_handle root)
+        {
+            return write(registry, scheduler, ecs::entity_container{ root });
+        }
+
+        /**@brief Validates a binary scene and parses it's tables.
+         * @param buffer Buffer containing the entire file, gets moved into the scene data.
+         * @param scene Scene data to fill.
+         * @returns bool True if the buffer contained a valid binary scene.
+         * @note Thread-safe, doesn't touch the ECS.
+         */
+        static bool parse(byte_vec&& buffer, binary_scene_data& scene);
+
+        /**@brief Creates all entities and components of a parsed binary scene.
+         *        All instances get created in bulk, every component column only gets decoded once and
+         *        a single bulk creation event gets raised per component type.
+         * @param registry Registry to create the entities in.
+         * @param scheduler Scheduler used to read the component columns in parallel.
+         * @param scene Parsed scene data.
+         * @param parent Entity to parent the root entities of the scene to, invalid entities or entities without a hierarchy fall back to the world.
+         * @param instances Amount of copies of the scene to create.
+         * @param transforms Transforms to apply to the root entities of each instance.
+         * @returns entity_container Root entities of all instances, in instance order.
+         * @note Entities get new ids, components that store entity ids get them remapped through component_type::remap_entities.
+         *       Ids of entities outside of the scene are left as they are.
+         */
+        static ecs::entity_container instantiate(ecs::EcsRegistry* registry, scheduling::Scheduler* scheduler, const binary_scene_data& scene,
+            ecs::entity_handle parent = ecs::entity_handle(world_entity_id), size_type instances = 1, const instance_transforms& transforms = {});
+
+        /**@brief Creates all entities and components stored in a binary scene.
+         * @param registry Registry to create the entities in.
+         * @param scheduler Scheduler used to read the component columns in parallel.
+         * @param data Buffer containing the entire file.
+         * @returns entity_handle First root entity of the scene, invalid if the data wasn't a valid binary scene.
+         * @note Entities get new ids, the root entities get parented to the world.
+         */
+        static ecs::entity_handle read(ecs::EcsRegistry* registry, scheduling::Scheduler* scheduler, byte_vec data);
+    };
+}
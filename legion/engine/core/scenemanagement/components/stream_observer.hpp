@@ -0,0 +1,15 @@
+#pragma once
+#include <core/types/types.hpp>
+
+namespace legion::core::scenemanagement
+{
+    /**@class stream_observer
+     * @brief Marks an entity as an observer of the world streamer. Cells of an open world that lie within the radius
+     *        of any observer get streamed in, cells that are too far from all observers get streamed out.
+     * @note Requires a position component on the same entity.
+     */
+    struct stream_observer
+    {
+        float radius = 100.f;
+    };
+}
@@ -0,0 +1,115 @@
+#include <core/scenemanagement/prefab.hpp>
+#include <core/logging/logging.hpp>
+
+namespace legion::core::scenemanagement
+{
+    std::unordered_map<id_type, std::shared_ptr<const prefab>> PrefabCache::m_prefabs;
+    async::rw_spinlock PrefabCache::m_prefabsLock;
+    ecs::EcsRegistry* PrefabCache::m_ecs = nullptr;
+    scheduling::Scheduler* PrefabCache::m_scheduler = nullptr;
+
+    std::shared_ptr<const prefab> prefab_handle::get() const
+    {
+        async::readonly_guard guard(PrefabCache::m_prefabsLock);
+        return PrefabCache::m_prefabs.at(id);
+    }
+
+    ecs::entity_container prefab_handle::instantiate(size_type count, const instance_transforms& transforms, ecs::entity_handle parent) const
+    {
+        return PrefabCache::instantiate(*this, count, transforms, parent);
+    }
+
+    prefab_handle PrefabCache::insert_prefab(const std::string& name, byte_vec&& data)
+    {
+        OPTICK_EVENT();
+        auto ptr = std::make_shared<prefab>();
+        ptr->name = name;
+        if (!BinaryScene::parse(std::move(data), ptr->data))
+        {
+            log::error("Failed to create prefab {}", name);
+            return invalid_prefab_handle;
+        }
+
+        id_type id = nameHash(name);
+        async::readwrite_guard guard(m_prefabsLock);
+        m_prefabs[id] = std::move(ptr);
+        return { id };
+    }
+
+    prefab_handle PrefabCache::create_prefab(const std::string& name, ecs::entity_handle source)
+    {
+        OPTICK_EVENT();
+        if (!source)
+        {
+            log::error("Cannot create prefab {} from an invalid entity.", name);
+            return invalid_prefab_handle;
+        }
+
+        return insert_prefab(name, BinaryScene::write(m_ecs, m_scheduler, source));
+    }
+
+    prefab_handle PrefabCache::create_prefab(const std::string& name, const filesystem::view& file)
+    {
+        OPTICK_EVENT();
+        id_type id = nameHash(name);
+
+        { // Check if the prefab already exists, and return that instead if it does.
+            async::readonly_guard guard(m_prefabsLock);
+            if (m_prefabs.count(id))
+                return { id };
+        }
+
+        if (!file.is_valid() || !file.file_info().is_file)
+            return invalid_prefab_handle;
+
+        auto result = file.get();
+        if (result != common::valid)
+        {
+            log::error("Error while loading file: {} {}", static_cast<std::string>(file.get_filename()), result.get_error());
+            return invalid_prefab_handle;
+        }
+
+        byte_vec data = result.decay().get();
+        return insert_prefab(name, std::move(data));
+    }
+
+    prefab_handle PrefabCache::get_handle(const std::string& name)
+    {
+        return get_handle(nameHash(name));
+    }
+
+    prefab_handle PrefabCache::get_handle(id_type id)
+    {
+        OPTICK_EVENT();
+        async::readonly_guard guard(m_prefabsLock);
+        if (m_prefabs.count(id))
+            return { id };
+        return invalid_prefab_handle;
+    }
+
+    ecs::entity_container PrefabCache::instantiate(prefab_handle handle, size_type count, const instance_transforms& transforms, ecs::entity_handle parent)
+    {
+        OPTICK_EVENT();
+        std::shared_ptr<const prefab> source;
+
+        { // Instantiating raises creation events, the listeners of which might modify the cache, so don't hold on to the lock.
+            async::readonly_guard guard(m_prefabsLock);
+            auto itr = m_prefabs.find(handle.id);
+            if (itr == m_prefabs.end())
+            {
+                log::error("Tried to instantiate a prefab that doesn't exist.");
+                return {};
+            }
+            source = itr->second;
+        }
+
+        return BinaryScene::instantiate(m_ecs, m_scheduler, source->data, parent, count, transforms);
+    }
+
+    void PrefabCache::destroy_prefab(id_type id)
+    {
+        OPTICK_EVENT();
+        async::readwrite_guard guard(m_prefabsLock);
+        m_prefabs.erase(id);
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <core/scenemanagement/binary_scene.hpp>
+#include <core/filesystem/view.hpp>
+
+#include <memory>
+#include <unordered_map>
+
+/**
+ * @file prefab.hpp
+ * @brief Prefab templates that store a flattened entity subtree in the binary scene format and can be
+ *        instantiated in bulk without going through per entity serialization.
+ */
+
+namespace legion::core::scenemanagement
+{
+    /**@class prefab
+     * @brief Flattened entity subtree, the hierarchy is stored by index and the components as binary columns.
+     */
+    struct prefab
+    {
+        std::string name;
+        binary_scene_data data;
+    };
+
+    /**@class prefab_handle
+     * @brief Save to pass around handle to a prefab in the prefab cache.
+     */
+    struct prefab_handle
+    {
+        id_type id = invalid_id;
+
+        /**@brief Get the prefab data, prefabs are immutable after creation.
+         *        The returned pointer keeps the data alive even if the prefab gets replaced or destroyed.
+         */
+        L_NODISCARD std::shared_ptr<const prefab> get() const;
+
+        /**@brief Creates copies of the prefab.
+         * @ref legion::core::scenemanagement::PrefabCache::instantiate
+         */
+        ecs::entity_container instantiate(size_type count = 1, const instance_transforms& transforms = {}, ecs::entity_handle parent = ecs::entity_handle(world_entity_id)) const;
+
+        bool operator==(const prefab_handle& other) const { return id == other.id; }
+        operator id_type() const { return id; }
+    };
+
+    /**@brief Default invalid prefab handle.
+     */
+    constexpr prefab_handle invalid_prefab_handle{ invalid_id };
+
+    /**@class PrefabCache
+     * @brief Data cache for creating, loading and instantiating prefabs.
+     */
+    class PrefabCache
+    {
+        friend class legion::core::Engine;
+        friend struct prefab_handle;
+    private:
+        static std::unordered_map<id_type, std::shared_ptr<const prefab>> m_prefabs;
+        static async::rw_spinlock m_prefabsLock;
+        static ecs::EcsRegistry* m_ecs;
+        static scheduling::Scheduler* m_scheduler;
+
+        static prefab_handle insert_prefab(const std::string& name, byte_vec&& data);
+
+    public:
+        /**@brief Create a new prefab from an entity and all of it's children, will overwrite an existing prefab with the same name.
+         * @param name Identifying name for the prefab.
+         * @param source Root entity of the subtree to store.
+         * @return prefab_handle A valid handle to the newly created prefab if it succeeds, invalid_prefab_handle if it fails.
+         */
+        static prefab_handle create_prefab(const std::string& name, ecs::entity_handle source);
+
+        /**@brief Create a new prefab and load it from a binary scene file if a prefab with the same name doesn't exist yet.
+         * @param name Identifying name for the prefab.
+         * @param file Binary scene file to load from.
+         * @return prefab_handle A valid handle to the newly created prefab if it succeeds, invalid_prefab_handle if it fails.
+         */
+        static prefab_handle create_prefab(const std::string& name, const filesystem::view& file);
+
+        /**@brief Returns a handle to a prefab with a certain name. Will return invalid_prefab_handle if the requested prefab doesn't exist.
+         */
+        static prefab_handle get_handle(const std::string& name);
+
+        /**@brief Returns a handle to a prefab with a certain name. Will return invalid_prefab_handle if the requested prefab doesn't exist.
+         * @param id Name hash
+         */
+        static prefab_handle get_handle(id_type id);
+
+        /**@brief Creates copies of a prefab. All entities and components get allocated in bulk and
+         *        a single bulk creation event gets raised per component type.
+         * @param handle Prefab to instantiate.
+         * @param count Amount of copies to create.
+         * @param transforms Transforms of the root entities, one value per copy, empty vectors keep the values stored in the prefab.
+         * @param parent Entity to parent the copies to.
+         * @return entity_container Root entities of all copies, in order.
+         */
+        static ecs::entity_container instantiate(prefab_handle handle, size_type count = 1, const instance_transforms& transforms = {}, ecs::entity_handle parent = ecs::entity_handle(world_entity_id));
+
+        static void destroy_prefab(id_type id);
+    };
+}
@@ -3,6 +3,7 @@
 #include <core/logging/logging.hpp>
 #include <core/common/string_extra.hpp>
 #include <core/defaults/defaultcomponents.hpp>
+#include <core/scenemanagement/binary_scene.hpp>
 //#include <rendering/components/camera.hpp>
 
 
@@ -92,13 +93,8 @@ namespace legion::core::scenemanagement
         }
     }
 
-    ecs::component_handle<scene> SceneManager::load_scene(const std::string& name)
+    void SceneManager::clear_world()
     {
-        std::string filename = name;
-        if (!common::ends_with(filename, ".cornflake")) filename += ".cornflake";
-
-        std::ifstream inFile("assets/scenes/" + filename);
-
         auto hry = world.read_component<hierarchy>();
         log::debug("Child Count Before: {}", hry.children.size());
         for (auto child : hry.children)
@@ -109,10 +105,10 @@ namespace legion::core::scenemanagement
         hry.children.clear();
         world.write_component(hry);
         log::debug("Child Count After: {}", world.child_count());
+    }
 
-        auto sceneEntity = serialization::SerializationUtil::JSONDeserialize<ecs::entity_handle>(inFile);
-        currentScene = sceneEntity.get_component_handle<scene>();
-
+    void SceneManager::on_scene_loaded()
+    {
         for (auto& [id, fn] : m_additionalLoaders)
         {
             hashed_sparse_set<id_type> types;
@@ -136,12 +132,67 @@ namespace legion::core::scenemanagement
 
             sceneList[s.id] = sceneHandle;
         }
+    }
+
+    ecs::component_handle<scene> SceneManager::load_scene(const std::string& name)
+    {
+        std::string filename = name;
+        if (!common::ends_with(filename, ".cornflake")) filename += ".cornflake";
+
+        std::ifstream inFile("assets/scenes/" + filename);
+
+        clear_world();
+
+        auto sceneEntity = serialization::SerializationUtil::JSONDeserialize<ecs::entity_handle>(inFile);
+        currentScene = sceneEntity.get_component_handle<scene>();
+
+        on_scene_loaded();
 
         //SceneManager::saveScene(name, sceneEntity);
         //log::debug("........Done saving scene");
         return sceneEntity.get_component_handle<scene>();
     }
 
+    ecs::component_handle<scene> SceneManager::load_scene_binary(const std::string& name)
+    {
+        OPTICK_EVENT();
+        std::string filename = name;
+        if (!common::ends_with(filename, binary_scene_extension)) filename += binary_scene_extension;
+
+        std::ifstream inFile("assets/scenes/" + filename, std::ios::binary);
+        if (!inFile.is_open())
+        {
+            log::error("Could not open binary scene {}", filename);
+            return ecs::component_handle<scene>();
+        }
+
+        byte_vec data((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+        inFile.close();
+
+        clear_world();
+
+        auto sceneEntity = BinaryScene::read(m_ecs, m_scheduler, std::move(data));
+        if (!sceneEntity)
+            return ecs::component_handle<scene>();
+
+        currentScene = sceneEntity.get_component_handle<scene>();
+
+        on_scene_loaded();
+
+        return currentScene;
+    }
+
+    ecs::component_handle<scene> SceneManager::save_scene_binary(const std::string& name, ecs::entity_handle& ent)
+    {
+        OPTICK_EVENT();
+        byte_vec data = BinaryScene::write(m_ecs, m_scheduler, ent);
+
+        std::ofstream outFile("assets/scenes/" + name + binary_scene_extension, std::ios::binary);
+        outFile.write(reinterpret_cast<const char*>(data.data()), data.size());
+        outFile.close();
+        return ent.get_component_handle<scene>();
+    }
+
     ecs::component_handle<scene> SceneManager::save_scene(const std::string& name, ecs::entity_handle& ent)
     {
         std::ofstream outFile("assets/scenes/" + name + ".cornflake");
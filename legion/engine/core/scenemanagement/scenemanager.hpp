@@ -12,6 +12,8 @@ namespace legion::core::scenemanagement
 {
     struct scene;
 
+    constexpr cstring binary_scene_extension = ".cfb";
+
     class SceneManager final : public core::System<SceneManager>
     {
         friend class legion::core::Engine;
@@ -21,6 +23,14 @@ namespace legion::core::scenemanagement
         static std::unordered_map<id_type, additional_loader_fn> m_additionalLoaders;
         static ecs::EcsRegistry* m_ecs;
 
+        /**@brief Destroys all children of the world in preparation of a scene load.
+         */
+        static void clear_world();
+
+        /**@brief Runs the additional loaders and updates the scene list after a scene load.
+         */
+        static void on_scene_loaded();
+
     public:
 
         static int sceneCount;
@@ -44,7 +54,8 @@ namespace legion::core::scenemanagement
                 {
                     if (file.get_extension() == common::valid)
                     {
-                        if (file.get_extension().decay() == ".cornflake")
+                        auto extension = file.get_extension().decay();
+                        if (extension == ".cornflake" || extension == binary_scene_extension)
                         {
                             auto fileName = file.get_filename().decay();
                             fileName = fileName.substr(0, fileName.find_last_of('.'));
@@ -86,6 +97,21 @@ namespace legion::core::scenemanagement
          */
         static ecs::component_handle<scene> save_scene(const std::string& name, ecs::entity_handle& ent);
 
+        /**@brief Deserializes a scene stored in the columnar binary format from the disk.
+         * @param name The name of the file to deserialize.
+         * @returns component_handle<scene> Handle to the scene component of the loaded scene, invalid if loading failed.
+         * @note Entities and components get created in bulk and component columns are read in parallel.
+         * @ref legion::core::scenemanagement::BinaryScene
+         */
+        static ecs::component_handle<scene> load_scene_binary(const std::string& name);
+
+        /**@brief Serializes a scene to disk using the columnar binary format.
+          * @param name string of the name of the scene you wish to save.
+          * @param ent a specific entity to serialize.
+          * @returns component_handle<scene> Handle to the scene component of the saved scene.
+         */
+        static ecs::component_handle<scene> save_scene_binary(const std::string& name, ecs::entity_handle& ent);
+
         /**@brief Gets a scene from the scene list.
           * @param name The name of the scene that you wish to save.
           * @returns component_handle<scene> The component handle for the scene component stored in the sceneList.
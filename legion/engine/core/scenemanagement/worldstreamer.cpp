@@ -0,0 +1,383 @@
+#include <core/scenemanagement/worldstreamer.hpp>
+#include <core/scenemanagement/scenemanager.hpp>
+#include <core/logging/logging.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+namespace legion::core::scenemanagement
+{
+    async::rw_spinlock WorldStreamer::m_cellsLock;
+    std::unordered_map<id_type, std::shared_ptr<stream_cell>> WorldStreamer::m_cells;
+    std::string WorldStreamer::m_worldName;
+    float WorldStreamer::m_cellSize = 0.f;
+    size_type WorldStreamer::m_residentBytes = 0;
+    size_type WorldStreamer::m_memoryBudget = 256ull * 1024ull * 1024ull;
+    size_type WorldStreamer::m_maxConcurrentLoads = 4;
+
+    id_type WorldStreamer::cell_key(const math::ivec3& coord) noexcept
+    {
+        constexpr id_type mask = (1ull << 21) - 1;
+        return (static_cast<id_type>(coord.x) & mask) | ((static_cast<id_type>(coord.y) & mask) << 21) | ((static_cast<id_type>(coord.z) & mask) << 42);
+    }
+
+    std::string WorldStreamer::cell_path(const std::string& worldName, const math::ivec3& coord)
+    {
+        return "assets/scenes/" + worldName + "/" + std::to_string(coord.x) + "_" + std::to_string(coord.y) + "_" + std::to_string(coord.z) + binary_scene_extension;
+    }
+
+    void WorldStreamer::setup()
+    {
+        createProcess<&WorldStreamer::update>("Update");
+        m_observerQuery = createQuery<stream_observer, position>();
+    }
+
+    void WorldStreamer::update(time::span deltaTime)
+    {
+        OPTICK_EVENT();
+        async::readwrite_guard guard(m_cellsLock);
+        if (m_cells.empty())
+            return;
+
+        m_observerQuery.queryEntities();
+        auto& observers = m_observerQuery.get<stream_observer>();
+        auto& positions = m_observerQuery.get<position>();
+
+        // Relevance of a cell is the distance from the closest observer's radius to the cell bounds,
+        // cells with a relevance of 0 or less are inside the radius of at least one observer.
+        std::unordered_map<id_type, float> relevance;
+        const math::vec3 cellExtents(m_cellSize);
+        for (size_type i = 0; i < m_observerQuery.size(); i++)
+        {
+            const math::vec3 pos = positions[i];
+            const float radius = observers[i].radius;
+            const math::ivec3 min = math::ivec3(math::floor((pos - math::vec3(radius + m_cellSize)) / m_cellSize));
+            const math::ivec3 max = math::ivec3(math::floor((pos + math::vec3(radius + m_cellSize)) / m_cellSize));
+
+            for (int32 x = min.x; x <= max.x; x++)
+                for (int32 y = min.y; y <= max.y; y++)
+                    for (int32 z = min.z; z <= max.z; z++)
+                    {
+                        math::ivec3 coord(x, y, z);
+                        id_type key = cell_key(coord);
+                        if (!m_cells.count(key))
+                            continue;
+
+                        math::vec3 cellMin = math::vec3(coord) * m_cellSize;
+                        float distance = math::length(math::clamp(pos, cellMin, cellMin + cellExtents) - pos) - radius;
+
+                        auto [itr, inserted] = relevance.emplace(key, distance);
+                        if (!inserted)
+                            itr->second = std::min(itr->second, distance);
+                    }
+        }
+
+        std::vector<std::shared_ptr<stream_cell>> toCommit;
+        std::vector<std::shared_ptr<stream_cell>> toUnload;
+        std::vector<std::pair<float, std::shared_ptr<stream_cell>>> candidates;
+        std::vector<std::pair<float, std::shared_ptr<stream_cell>>> evictable;
+        size_type inFlight = 0;
+
+        for (auto& [key, cell] : m_cells)
+        {
+            auto itr = relevance.find(key);
+            float cellRelevance = itr == relevance.end() ? std::numeric_limits<float>::max() : itr->second;
+            bool outOfRange = cellRelevance > m_cellSize; // One cell of hysteresis to avoid thrashing on cell borders.
+
+            switch (cell->state.load(std::memory_order_acquire))
+            {
+            case stream_cell_state::unloaded:
+                if (cellRelevance <= 0.f)
+                    candidates.emplace_back(cellRelevance, cell);
+                break;
+            case stream_cell_state::loading:
+                inFlight++;
+                break;
+            case stream_cell_state::parsed:
+                if (outOfRange)
+                {
+                    cell->data = binary_scene_data();
+                    cell->state.store(stream_cell_state::unloaded, std::memory_order_release);
+                    cell->resident = false;
+                    m_residentBytes -= cell->byteSize;
+                }
+                else
+                {
+                    cell->state.store(stream_cell_state::committing, std::memory_order_release);
+                    toCommit.push_back(cell);
+                }
+                break;
+            case stream_cell_state::loaded:
+                if (outOfRange)
+                {
+                    cell->state.store(stream_cell_state::unloading, std::memory_order_release);
+                    toUnload.push_back(cell);
+                }
+                else
+                    evictable.emplace_back(cellRelevance, cell);
+                break;
+            case stream_cell_state::failed:
+                if (cell->resident)
+                {
+                    cell->resident = false;
+                    m_residentBytes -= cell->byteSize;
+                }
+                break;
+            default:
+                break;
+            }
+        }
+
+        // Closest cells first for loading, farthest cells first for eviction.
+        std::sort(candidates.begin(), candidates.end(), [](auto& lhs, auto& rhs) { return lhs.first < rhs.first; });
+        std::sort(evictable.begin(), evictable.end(), [](auto& lhs, auto& rhs) { return lhs.first > rhs.first; });
+
+        size_type pendingEviction = 0;
+        for (auto& cell : toUnload)
+            pendingEviction += cell->byteSize;
+
+        auto evictItr = evictable.begin();
+        for (auto& [cellRelevance, cell] : candidates)
+        {
+            if (inFlight >= m_maxConcurrentLoads)
+                break;
+
+            while (m_residentBytes - pendingEviction + cell->byteSize > m_memoryBudget && evictItr != evictable.end() && evictItr->first > cellRelevance)
+            {
+                evictItr->second->state.store(stream_cell_state::unloading, std::memory_order_release);
+                toUnload.push_back(evictItr->second);
+                pendingEviction += evictItr->second->byteSize;
+                evictItr++;
+            }
+
+            if (m_residentBytes - pendingEviction + cell->byteSize > m_memoryBudget)
+                break;
+
+            start_load(cell);
+            inFlight++;
+        }
+
+        if (!toCommit.empty() || !toUnload.empty())
+            m_scheduler->queueSyncOperation([toCommit, toUnload]() { commit(toCommit, toUnload); });
+    }
+
+    void WorldStreamer::start_load(const std::shared_ptr<stream_cell>& cell)
+    {
+        OPTICK_EVENT();
+        cell->state.store(stream_cell_state::loading, std::memory_order_release);
+        cell->resident = true;
+        m_residentBytes += cell->byteSize;
+
+        std::string path = cell_path(m_worldName, cell->coord);
+        m_scheduler->queueJobs(1, [cell, path]()
+            {
+                std::ifstream inFile(path, std::ios::binary);
+                if (!inFile.is_open())
+                {
+                    log::error("Could not open world cell {}", path);
+                    cell->state.store(stream_cell_state::failed, std::memory_order_release);
+                    return;
+                }
+
+                byte_vec data((std::istreambuf_iterator<char>(inFile)), std::istreambuf_iterator<char>());
+                inFile.close();
+
+                bool parsed = BinaryScene::parse(std::move(data), cell->data);
+                cell->state.store(parsed ? stream_cell_state::parsed : stream_cell_state::failed, std::memory_order_release);
+            });
+    }
+
+    void WorldStreamer::commit(const std::vector<std::shared_ptr<stream_cell>>& toCommit, const std::vector<std::shared_ptr<stream_cell>>& toUnload)
+    {
+        OPTICK_EVENT();
+        async::readwrite_guard guard(m_cellsLock);
+
+        for (auto& cell : toUnload)
+        {
+            for (auto& root : cell->roots)
+                if (root.valid())
+                    root.destroy(true);
+
+            cell->roots.clear();
+            cell->state.store(stream_cell_state::unloaded, std::memory_order_release);
+            if (cell->resident)
+            {
+                cell->resident = false;
+                m_residentBytes -= cell->byteSize;
+            }
+        }
+
+        for (auto& cell : toCommit)
+        {
+            if (cell->state.load(std::memory_order_acquire) != stream_cell_state::committing) // World was closed in the meantime.
+                continue;
+
+            cell->roots = BinaryScene::instantiate(m_ecs, m_scheduler, cell->data);
+            cell->data = binary_scene_data();
+            cell->state.store(stream_cell_state::loaded, std::memory_order_release);
+        }
+    }
+
+    bool WorldStreamer::partition_scene(const std::string& name, ecs::entity_handle root, float cellSize)
+    {
+        OPTICK_EVENT();
+        if (cellSize <= 0.f)
+        {
+            log::error("Cannot partition world {} with a cell size of {}.", name, cellSize);
+            return false;
+        }
+
+        std::unordered_map<id_type, std::pair<math::ivec3, ecs::entity_container>> cells;
+        for (auto& child : root.children())
+        {
+            math::vec3 pos = child.has_component<position>() ? math::vec3(child.read_component<position>()) : math::vec3(0.f);
+            math::ivec3 coord = math::ivec3(math::floor(pos / cellSize));
+            auto& [cellCoord, entities] = cells[cell_key(coord)];
+            cellCoord = coord;
+            entities.push_back(child);
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories("assets/scenes/" + name, error);
+        if (error)
+        {
+            log::error("Could not create directory for world {}: {}", name, error.message());
+            return false;
+        }
+
+        world_partition_header header;
+        header.cellSize = cellSize;
+        header.cellCount = static_cast<uint32>(cells.size());
+
+        std::vector<world_partition_cell> entries;
+        entries.reserve(cells.size());
+
+        for (auto& [key, cell] : cells)
+        {
+            auto& [coord, entities] = cell;
+            byte_vec data = BinaryScene::write(m_ecs, m_scheduler, entities);
+
+            std::ofstream outFile(cell_path(name, coord), std::ios::binary);
+            if (!outFile.is_open())
+            {
+                log::error("Could not write cell ({}, {}, {}) of world {}", coord.x, coord.y, coord.z, name);
+                return false;
+            }
+            outFile.write(reinterpret_cast<const char*>(data.data()), data.size());
+            outFile.close();
+
+            world_partition_cell& entry = entries.emplace_back();
+            entry.x = coord.x;
+            entry.y = coord.y;
+            entry.z = coord.z;
+            entry.entityCount = static_cast<uint32>(entities.size());
+            entry.byteSize = data.size();
+        }
+
+        std::ofstream outFile("assets/scenes/" + name + world_partition_extension, std::ios::binary);
+        if (!outFile.is_open())
+        {
+            log::error("Could not write partition index of world {}", name);
+            return false;
+        }
+        outFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        outFile.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(world_partition_cell));
+        outFile.close();
+        return true;
+    }
+
+    bool WorldStreamer::open_world(const std::string& name)
+    {
+        OPTICK_EVENT();
+        std::ifstream inFile("assets/scenes/" + name + world_partition_extension, std::ios::binary);
+        if (!inFile.is_open())
+        {
+            log::error("Could not open partition index of world {}", name);
+            return false;
+        }
+
+        world_partition_header header;
+        if (!inFile.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != world_partition_magic || header.version != world_partition_version || header.cellSize <= 0.f)
+        {
+            log::error("Partition index of world {} is corrupted or of an unsupported version.", name);
+            return false;
+        }
+
+        std::vector<world_partition_cell> entries(header.cellCount);
+        if (!inFile.read(reinterpret_cast<char*>(entries.data()), entries.size() * sizeof(world_partition_cell)))
+        {
+            log::error("Partition index of world {} is corrupted.", name);
+            return false;
+        }
+        inFile.close();
+
+        close_world();
+
+        async::readwrite_guard guard(m_cellsLock);
+        m_worldName = name;
+        m_cellSize = header.cellSize;
+        for (auto& entry : entries)
+        {
+            auto cell = std::make_shared<stream_cell>();
+            cell->coord = math::ivec3(entry.x, entry.y, entry.z);
+            cell->byteSize = entry.byteSize;
+            m_cells.emplace(cell_key(cell->coord), std::move(cell));
+        }
+
+        return true;
+    }
+
+    void WorldStreamer::close_world()
+    {
+        OPTICK_EVENT();
+        std::vector<std::shared_ptr<stream_cell>> toUnload;
+        {
+            async::readwrite_guard guard(m_cellsLock);
+            for (auto& [key, cell] : m_cells)
+            {
+                // Parsed or loading cells get dropped together with the cell, loaded ones need to be destroyed at a sync point.
+                auto state = cell->state.exchange(stream_cell_state::unloading, std::memory_order_acq_rel);
+                cell->resident = false;
+                if (state == stream_cell_state::loaded)
+                    toUnload.push_back(cell);
+            }
+
+            m_cells.clear();
+            m_worldName.clear();
+            m_residentBytes = 0;
+        }
+
+        if (!toUnload.empty())
+            m_scheduler->queueSyncOperation([toUnload]() { commit({}, toUnload); });
+    }
+
+    void WorldStreamer::set_memory_budget(size_type bytes)
+    {
+        async::readwrite_guard guard(m_cellsLock);
+        m_memoryBudget = bytes;
+    }
+
+    void WorldStreamer::set_max_concurrent_loads(size_type count)
+    {
+        async::readwrite_guard guard(m_cellsLock);
+        m_maxConcurrentLoads = count;
+    }
+
+    size_type WorldStreamer::resident_bytes()
+    {
+        async::readonly_guard guard(m_cellsLock);
+        return m_residentBytes;
+    }
+
+    size_type WorldStreamer::loaded_cell_count()
+    {
+        async::readonly_guard guard(m_cellsLock);
+        size_type count = 0;
+        for (auto& [key, cell] : m_cells)
+            if (cell->state.load(std::memory_order_acquire) == stream_cell_state::loaded)
+                count++;
+        return count;
+    }
+}
@@ -0,0 +1,132 @@
+#pragma once
+#include <core/engine/system.hpp>
+#include <core/defaults/defaultcomponents.hpp>
+#include <core/scenemanagement/binary_scene.hpp>
+#include <core/scenemanagement/components/stream_observer.hpp>
+
+#include <atomic>
+#include <memory>
+#include <unordered_map>
+
+/**
+ * @file worldstreamer.hpp
+ * @brief Streaming world partition.
+ *        A partitioned world consists of an index file "assets/scenes/<name>.cfp" and one binary scene per grid cell
+ *        stored in "assets/scenes/<name>/<x>_<y>_<z>.cfb". Cells get read and parsed on the job pool and instantiated
+ *        or destroyed during a scheduler synchronization moment.
+ */
+
+namespace legion::core::scenemanagement
+{
+    constexpr cstring world_partition_extension = ".cfp";
+    constexpr uint32 world_partition_magic = 0x504E474C; // "LGNP"
+    constexpr uint32 world_partition_version = 1;
+
+    struct world_partition_header
+    {
+        uint32 magic = world_partition_magic;
+        uint32 version = world_partition_version;
+        float cellSize = 0.f;
+        uint32 cellCount = 0;
+    };
+
+    struct world_partition_cell
+    {
+        int32 x = 0;
+        int32 y = 0;
+        int32 z = 0;
+        uint32 entityCount = 0;
+        uint64 byteSize = 0;
+    };
+
+    enum struct stream_cell_state : uint8
+    {
+        unloaded,
+        loading,
+        parsed,
+        committing,
+        loaded,
+        unloading,
+        failed
+    };
+
+    /**@class stream_cell
+     * @brief Runtime state of a single cell of an open world.
+     */
+    struct stream_cell
+    {
+        math::ivec3 coord;
+        uint64 byteSize = 0;
+        std::atomic<stream_cell_state> state{ stream_cell_state::unloaded };
+        bool resident = false;
+        binary_scene_data data;
+        ecs::entity_container roots;
+    };
+
+    /**@class WorldStreamer
+     * @brief Loads and unloads the cells of a partitioned world around all stream observers.
+     */
+    class WorldStreamer final : public System<WorldStreamer>
+    {
+    private:
+        static async::rw_spinlock m_cellsLock;
+        static std::unordered_map<id_type, std::shared_ptr<stream_cell>> m_cells;
+        static std::string m_worldName;
+        static float m_cellSize;
+        static size_type m_residentBytes;
+        static size_type m_memoryBudget;
+        static size_type m_maxConcurrentLoads;
+
+        ecs::EntityQuery m_observerQuery;
+
+        /**@brief Packs cell coordinates into a single key, supports 21 bits per axis.
+         */
+        L_NODISCARD static id_type cell_key(const math::ivec3& coord) noexcept;
+
+        L_NODISCARD static std::string cell_path(const std::string& worldName, const math::ivec3& coord);
+
+        /**@brief Starts reading and parsing a cell on the job pool.
+         */
+        static void start_load(const std::shared_ptr<stream_cell>& cell);
+
+        /**@brief Instantiates and destroys cells, needs to be called during a synchronization moment.
+         */
+        static void commit(const std::vector<std::shared_ptr<stream_cell>>& toCommit, const std::vector<std::shared_ptr<stream_cell>>& toUnload);
+
+    public:
+        virtual void setup();
+
+        void update(time::span deltaTime);
+
+        /**@brief Splits the children of an entity into grid cells based on their position and writes them as a partitioned world.
+         * @param name Name of the world.
+         * @param root Entity whose children will be partitioned, children without a position end up in cell (0, 0, 0).
+         * @param cellSize Size of a cell along each axis.
+         * @returns bool True if the index and all cells were written successfully.
+         */
+        static bool partition_scene(const std::string& name, ecs::entity_handle root, float cellSize);
+
+        /**@brief Opens a partitioned world for streaming, closes the previously opened world.
+         * @param name Name of the world.
+         * @returns bool True if the partition index was read successfully.
+         */
+        static bool open_world(const std::string& name);
+
+        /**@brief Closes the open world and destroys all of it's loaded cells at the next synchronization moment.
+         */
+        static void close_world();
+
+        /**@brief Sets the maximum amount of bytes that cells may occupy, measured as the size of the cell files.
+         * @note When the budget is exceeded the cells farthest from any observer get unloaded first.
+         */
+        static void set_memory_budget(size_type bytes);
+
+        /**@brief Sets the maximum amount of cells that get read and parsed at the same time.
+         */
+        static void set_max_concurrent_loads(size_type count);
+
+        L_NODISCARD static size_type resident_bytes();
+
+        L_NODISCARD static size_type loaded_cell_count();
+    };
+}
@@ -4,7 +4,11 @@
 #include <core/containers/containers.hpp>
 #include <core/time/time.hpp>
 
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
+#include <core/profiling/statistics.hpp>
+
+#include <algorithm>
+#include <cmath>
 
 /**@file process.hpp
  */
@@ -28,6 +32,19 @@ namespace legion::core::scheduling
         time::clock<fast_time> m_clock;
         bool m_fixedTimeStep;
         bool firstStep = true;
+        uint64 m_nextTick = 0; // Simulation tick at which the process is due in lockstep mode.
+        profiling::statistic_entry* m_statistics = nullptr;
+
+        void invoke(time::time_span<fast_time> deltaTime)
+        {
+            if (!m_statistics)
+                m_statistics = &profiling::Statistics::get_entry(profiling::statistic_category::process, m_name);
+
+            uint64 start = profiling::Profiler::now();
+            m_operation.invoke(deltaTime);
+            profiling::Statistics::record(*m_statistics, profiling::Profiler::now() - start);
+        }
+
     public:
 
         template<size_type charc>
@@ -44,8 +61,14 @@ namespace legion::core::scheduling
          */
         id_type id() const { return m_nameHash; }
 
+        const std::string& name() const { return m_name; }
+
         bool inUse() const { return m_hooks.size(); }
 
+        /**@brief Whether the process runs at a fixed interval instead of every iteration of it's chain.
+         */
+        bool fixedTimeStep() const { return m_fixedTimeStep; }
+
         /**@brief Set the operation for the process to execute at the set interval.
          */
         void setOperation(delegate<void(time::time_span<fast_time>)>&& operation)
@@ -85,7 +108,7 @@ namespace legion::core::scheduling
             {
                 OPTICK_EVENT("Execute process");
                 OPTICK_TAG("Process", m_name.c_str());
-                m_operation.invoke(deltaTime);
+                invoke(deltaTime);
                 return true;
             }
 
@@ -96,10 +119,30 @@ namespace legion::core::scheduling
                 OPTICK_EVENT("Execute process");
                 OPTICK_TAG("Process", m_name.c_str());
                 m_timeBuffer -= m_interval;
-                m_operation.invoke(m_interval);
+                invoke(m_interval);
             }
 
             return true;
         }
+
+        /**@brief Execute the operation if it's due at the given simulation tick, used by the scheduler in deterministic mode.
+         *        The interval gets rounded to a whole amount of simulation steps so that every run executes the process at the exact same ticks.
+         * @param tick Current simulation tick.
+         * @param step Duration of a single simulation tick in seconds.
+         * @return bool True if the operation was executed.
+         */
+        bool executeLockstep(uint64 tick, float step)
+        {
+            if (tick < m_nextTick)
+                return false;
+
+            const uint64 steps = std::max<uint64>(static_cast<uint64>(std::llround(m_interval.seconds() / step)), 1);
+            m_nextTick = tick + steps;
+
+            OPTICK_EVENT("Execute process");
+            OPTICK_TAG("Process", m_name.c_str());
+            invoke(step * steps);
+            return true;
+        }
     };
 }
@@ -15,12 +15,15 @@ namespace legion::core::scheduling
     void ProcessChain::threadedRun(ProcessChain* chain)
     {
         log::info("Chain started.");
+        profiling::Profiler::set_thread_name(chain->m_name);
         chain->m_scheduler->subscribeToSync();
 
 #if USE_OPTICK
         Optick::Event* frameEvent = nullptr;
 #endif
 
+        auto nextTick = std::chrono::steady_clock::now();
+
         while (!chain->m_exit->load(std::memory_order_acquire)) // Check for exit flag.
         {
 #if USE_OPTICK
@@ -50,8 +53,23 @@ namespace legion::core::scheduling
             chain->runInCurrentThread(); // Execute all processes.
 
             if (chain->m_scheduler->syncRequested()) // Sync if requested.
+            {
+                uint64 syncStart = profiling::Profiler::now();
                 chain->m_scheduler->waitForProcessSync();
 
+                if (profiling::Profiler::enabled())
+                {
+                    if (!chain->m_syncWaitDescription)
+                        chain->m_syncWaitDescription = profiling::Profiler::intern_description(chain->m_name + " sync wait (ms)", __FILE__, __LINE__);
+                    profiling::Profiler::record_counter(chain->m_syncWaitDescription, (profiling::Profiler::now() - syncStart) / 1000000.0);
+                }
+            }
+
+            if (chain->m_scheduler->getTickRate() > 0.f)
+            {
+                chain->m_scheduler->waitForNextTick(nextTick);
+            }
+            else
             {
                 OPTICK_CATEGORY("Relieve LSU contention", Optick::Category::Wait);
                 L_PAUSE_INSTRUCTION();
@@ -94,6 +112,14 @@ namespace legion::core::scheduling
         OPTICK_EVENT("Run process chain");
         OPTICK_TAG("Process chain", m_name.c_str());
 
+        if (!m_frameDescription)
+            m_frameDescription = profiling::Profiler::intern_description(m_name, __FILE__, __LINE__);
+        profiling::scoped_frame frame(m_frameDescription);
+
+        if (!m_statistics)
+            m_statistics = &profiling::Statistics::get_entry(profiling::statistic_category::chain, m_name);
+        uint64 frameStart = profiling::Profiler::now();
+
         {
             async::readonly_guard guard(m_callbackLock);
             m_onFrameStart();
@@ -101,19 +127,52 @@ namespace legion::core::scheduling
 
         hashed_sparse_set<id_type> finishedProcesses;
         async::readonly_guard guard(m_processesLock); // Hooking more processes whilst executing isn't allowed.
+        const bool deterministic = m_scheduler->isDeterministic();
+        size_type processesRun = 0;
         do
         {
             for (auto [id, process] : m_processes)
                 if (!finishedProcesses.contains(id))
+                {
+                    if (deterministic && process->fixedTimeStep()) // Fixed step processes are driven by the simulation tick in deterministic mode.
+                    {
+                        finishedProcesses.insert(id);
+                        continue;
+                    }
+
+                    processesRun++;
                     if (process->execute(m_scheduler->getTimeScale())) // If the process wasn't finished then execute it and check if it's finished now.
                         finishedProcesses.insert(id);
+                }
 
         } while (finishedProcesses.size() != m_processes.size() && !m_exit->load(std::memory_order_acquire));
 
+        if (profiling::Profiler::enabled())
+        {
+            if (!m_processCounterDescription)
+                m_processCounterDescription = profiling::Profiler::intern_description(m_name + " processes run", __FILE__, __LINE__);
+            profiling::Profiler::record_counter(m_processCounterDescription, static_cast<double>(processesRun));
+        }
+
         {
             async::readonly_guard guard(m_callbackLock);
             m_onFrameEnd();
         }
+
+        profiling::Statistics::record(*m_statistics, profiling::Profiler::now() - frameStart);
+
+        memory::FrameArena::local().reset(); // Release all per frame temporaries of this chain.
+    }
+
+    void ProcessChain::runLockstep(uint64 tick, float step)
+    {
+        OPTICK_EVENT("Run process chain lockstep");
+        OPTICK_TAG("Process chain", m_name.c_str());
+
+        async::readonly_guard guard(m_processesLock);
+        for (auto [id, process] : m_processes)
+            if (process->fixedTimeStep())
+                process->executeLockstep(tick, step);
     }
 
     void ProcessChain::addProcess(Process* process)
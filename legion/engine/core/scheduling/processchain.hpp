@@ -4,6 +4,8 @@
 #include <core/types/type_util.hpp>
 #include <core/containers/containers.hpp>
 #include <core/async/transferable_atomic.hpp>
+#include <core/profiling/profiler.hpp>
+#include <core/profiling/statistics.hpp>
 
 #include <thread>
 
@@ -30,6 +32,10 @@ namespace legion::core::scheduling
 		sparse_map<id_type, Process*> m_processes;
 		async::transferable_atomic<bool> m_exit;
         bool m_low_power;
+        const profiling::zone_description* m_frameDescription = nullptr;
+        const profiling::zone_description* m_processCounterDescription = nullptr;
+        const profiling::zone_description* m_syncWaitDescription = nullptr;
+        profiling::statistic_entry* m_statistics = nullptr;
 
         static async::rw_spinlock m_callbackLock;
         static multicast_delegate<void()> m_onFrameStart;
@@ -108,6 +114,12 @@ namespace legion::core::scheduling
 		 */
 		void runInCurrentThread();
 
+		/**@brief Runs all fixed interval processes of this chain that are due at the given simulation tick.
+		 * @note Only used in deterministic mode, the scheduler calls this for every chain from the main thread in a fixed order.
+		 * @ref Scheduler::setDeterministic()
+		 */
+		void runLockstep(uint64 tick, float step);
+
 		/**@brief Hook a process for execution with this chain.
 		 */
 		void addProcess(Process* process);
@@ -17,6 +17,8 @@ namespace legion::core::scheduling
     std::queue<std::shared_ptr<async::job_pool_base>> Scheduler::m_jobs;
     std::unordered_map<std::thread::id, async::rw_spinlock> Scheduler::m_commandLocks;
     std::unordered_map<std::thread::id, std::queue<std::unique_ptr<runnable_base>>> Scheduler::m_commands;
+    std::atomic<uint64> Scheduler::m_jobBusyTime{ 0 };
+    std::atomic<uint64> Scheduler::m_jobsQueued{ 0 };
 
     void Scheduler::threadMain(bool* exit, bool* start, bool lowPower)
     {
@@ -68,6 +70,7 @@ namespace legion::core::scheduling
 
             if (instruction)
             {
+                uint64 jobStart = profiling::Profiler::now();
                 async::readonly_guard guard(m_jobQueueLock);
                 auto pool = m_jobs.front();
                 while (instruction && !pool->is_done())
@@ -87,6 +90,9 @@ namespace legion::core::scheduling
                         }
                     }
                 }
+
+                m_jobBusyTime.fetch_add(profiling::Profiler::now() - jobStart, std::memory_order_relaxed);
+                memory::FrameArena::local().reset(); // The jobs of this pool are done, so none of their temporaries are still in use.
             }
             else
             {
@@ -114,7 +120,7 @@ namespace legion::core::scheduling
         }
     }
 
-    Scheduler::Scheduler(events::EventBus* eventBus, bool lowPower, uint minThreads) : m_eventBus(eventBus), m_lowPower(lowPower)
+    Scheduler::Scheduler(events::EventBus* eventBus, bool lowPower, uint minThreads, uint maxThreads) : m_eventBus(eventBus), m_lowPower(lowPower)
     {
         legion::core::log::impl::thread_names[std::this_thread::get_id()] = "Initialization";
         async::set_thread_name("Initialization");
@@ -125,6 +131,9 @@ namespace legion::core::scheduling
         if (m_availableThreads < minThreads)
             m_availableThreads = minThreads;
 
+        if (maxThreads && m_availableThreads > maxThreads)
+            m_availableThreads = maxThreads;
+
         async::rw_spinlock::force_release(false);
         async::spinlock::force_release(false);
 
@@ -138,6 +147,8 @@ namespace legion::core::scheduling
         m_threadsShouldStart = true;
 
         addProcessChain("Update");
+
+        profiling::Statistics::m_eventBus = eventBus;
     }
 
     Scheduler::~Scheduler()
@@ -151,8 +162,58 @@ namespace legion::core::scheduling
             thread->join();
     }
 
+    void Scheduler::updateStatistics(uint64& lastUpdate, uint64& busyTime, uint64& lastLog, size_type workerCount)
+    {
+        static profiling::statistic_entry& utilization = profiling::Statistics::get_entry(profiling::statistic_category::job_pool, "Job pool");
+
+        uint64 now = profiling::Profiler::now();
+        uint64 totalBusyTime = m_jobBusyTime.load(std::memory_order_relaxed);
+        uint64 frameTime = (now - lastUpdate) * workerCount;
+        lastUpdate = now;
+
+        if (frameTime)
+        {
+            const uint64 permyriad = std::min<uint64>(((totalBusyTime - busyTime) * 10000) / frameTime, 10000);
+            profiling::Statistics::record(utilization, permyriad);
+            LEGION_PROFILE_COUNTER("Job pool utilization (%)", permyriad / 100.0);
+        }
+        busyTime = totalBusyTime;
+
+        LEGION_PROFILE_COUNTER("Jobs queued", m_jobsQueued.exchange(0, std::memory_order_relaxed));
+
+        float logInterval = profiling::Statistics::get_log_interval();
+        if (logInterval > 0.f && now - lastLog >= static_cast<uint64>(logInterval * 1000000000.0))
+        {
+            profiling::Statistics::log_report();
+            lastLog = now;
+        }
+    }
+
+    void Scheduler::updateMemory(uint64& lastUpdate)
+    {
+        constexpr uint64 sampleInterval = 250000000ull; // 250ms
+
+        uint64 now = profiling::Profiler::now();
+        bool overBudget = memory::MemoryTracker::eviction_requested();
+        if (now - lastUpdate >= sampleInterval)
+        {
+            lastUpdate = now;
+            overBudget = memory::MemoryTracker::update();
+        }
+
+        if (overBudget && !m_evictionQueued.exchange(true, std::memory_order_relaxed))
+        {
+            queueSyncOperation([this]()
+                {
+                    memory::MemoryTracker::evict();
+                    m_evictionQueued.store(false, std::memory_order_relaxed);
+                });
+        }
+    }
+
     void Scheduler::run()
     {
+        size_type workerCount = m_unreservedThreads.size();
         {
             auto unreserved = m_unreservedThreads;
             uint i = 0;
@@ -194,6 +255,15 @@ namespace legion::core::scheduling
 }
 #endif
 
+        size_type ticks = 0;
+        auto nextTick = std::chrono::steady_clock::now();
+
+        uint64 jobBusyTime = m_jobBusyTime.load(std::memory_order_relaxed);
+        uint64 lastStatisticsUpdate = profiling::Profiler::now();
+        uint64 lastStatisticsLog = lastStatisticsUpdate;
+        uint64 lastMemoryUpdate = lastStatisticsUpdate;
+        uint64 frameStart = lastStatisticsUpdate;
+
         while (!m_eventBus->checkEvent<events::exit>()) // Check for engine exit flag.
         {
             OPTICK_EVENT("Mainthread frame");
@@ -249,8 +319,34 @@ namespace legion::core::scheduling
             if (m_localChain.id()) // If the local chain is valid run an iteration.
                 m_localChain.runInCurrentThread();
 
+            {
+                uint64 now = profiling::Profiler::now();
+                if (m_deterministic.load(std::memory_order_relaxed))
+                {
+                    runSimulationTicks(static_cast<fast_time>(now - frameStart) / 1000000000.f);
+                    memory::FrameArena::local().reset(); // Fixed step processes run outside of the local chain, so release their temporaries here.
+                }
+                frameStart = now;
+            }
+
             if (syncRequested()) // If a major engine sync was requested halt thread until all threads have reached a sync point and let them all continue.
+            {
+                uint64 syncStart = profiling::Profiler::now();
                 waitForProcessSync();
+                LEGION_PROFILE_COUNTER("Update sync wait (ms)", (profiling::Profiler::now() - syncStart) / 1000000.0);
+            }
+
+            size_type tickLimit = m_tickLimit.load(std::memory_order_relaxed);
+            if (tickLimit && ++ticks >= tickLimit)
+            {
+                log::info("Reached tick limit of {} ticks.", tickLimit);
+                m_eventBus->raiseEvent<events::exit>();
+            }
+
+            updateStatistics(lastStatisticsUpdate, jobBusyTime, lastStatisticsLog, workerCount);
+            updateMemory(lastMemoryUpdate);
+
+            waitForNextTick(nextTick);
         }
 
         for (auto [_, processChain] : m_processChains)
@@ -306,6 +402,59 @@ namespace legion::core::scheduling
         m_exits.clear();
                 }
 
+    void Scheduler::runSimulationTicks(fast_time frameTime)
+    {
+        OPTICK_EVENT();
+        // Without a fixed tick rate the simulation has to follow the wall clock, so only the order and step size are deterministic, not the amount of ticks per frame.
+        float tickRate = m_tickRate.load(std::memory_order_relaxed);
+        if (tickRate > 0.f)
+            frameTime = 1.f / tickRate;
+
+        const float step = m_simulationStep.load(std::memory_order_relaxed);
+        m_simulationBuffer += frameTime * m_timeScale.load(std::memory_order_relaxed);
+
+        constexpr size_type maxTicksPerFrame = 10;
+        size_type ticks = 0;
+        while (m_simulationBuffer >= step)
+        {
+            m_simulationBuffer -= step;
+            if (ticks++ == maxTicksPerFrame)
+            {
+                m_simulationBuffer = 0; // Fell too far behind, drop the backlog instead of spiraling.
+                break;
+            }
+
+            uint64 tick = m_simulationTick.load(std::memory_order_relaxed);
+
+            if (m_localChain.id())
+                m_localChain.runLockstep(tick, step);
+
+            {
+                async::readonly_guard guard(m_processChainsLock);
+                for (auto [_, chain] : m_processChains)
+                    chain.runLockstep(tick, step);
+            }
+
+            m_simulationTick.store(tick + 1, std::memory_order_release);
+        }
+    }
+
+    void Scheduler::waitForNextTick(std::chrono::steady_clock::time_point& nextTick)
+    {
+        float tickRate = m_tickRate.load(std::memory_order_relaxed);
+        if (tickRate <= 0.f)
+            return;
+
+        OPTICK_CATEGORY("Waiting for next tick", Optick::Category::Wait);
+        nextTick += std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<float>(1.f / tickRate));
+
+        auto now = std::chrono::steady_clock::now();
+        if (nextTick <= now)
+            nextTick = now; // Fell behind, skip the missed ticks instead of spiraling.
+        else
+            std::this_thread::sleep_until(nextTick);
+    }
+
     void Scheduler::destroyThread(std::thread::id id)
     {
         OPTICK_EVENT();
@@ -400,11 +549,30 @@ namespace legion::core::scheduling
                     std::this_thread::yield();
             }
 
+            std::vector<delegate<void()>> operations;
+            {
+                async::readwrite_guard guard(m_syncOperationsLock);
+                std::swap(operations, m_syncOperations);
+            }
+
+            for (auto& operation : operations) // Run all queued operations while the other threads are halted.
+                operation();
+
             m_requestSync.store(false, std::memory_order_release);
             m_syncLock.sync(); // Release sync lock.
         }
     }
 
+    void Scheduler::queueSyncOperation(delegate<void()>&& operation)
+    {
+        OPTICK_EVENT();
+        {
+            async::readwrite_guard guard(m_syncOperationsLock);
+            m_syncOperations.push_back(std::move(operation));
+        }
+        m_requestSync.store(true, std::memory_order_release);
+    }
+
     bool Scheduler::hookProcess(cstring chainName, Process* process)
     {
         OPTICK_EVENT();
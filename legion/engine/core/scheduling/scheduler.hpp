@@ -11,7 +11,10 @@
 #include <core/async/async_runnable.hpp>
 #include <core/async/thread_util.hpp>
 
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
+#include <core/profiling/statistics.hpp>
+#include <core/memory/memory_tracker.hpp>
+#include <core/memory/frame_arena.hpp>
 
 #include <memory>
 #include <thread>
@@ -19,6 +22,7 @@
 #include <sstream>
 #include <limits>
 #include <queue>
+#include <chrono>
 
 /**@file scheduler.hpp
  */
@@ -61,10 +65,22 @@ namespace legion::core::scheduling
         std::atomic_bool m_requestSync;
         async::ring_sync_lock m_syncLock;
 
+        async::rw_spinlock m_syncOperationsLock;
+        std::vector<delegate<void()>> m_syncOperations;
+
         std::atomic<float> m_timeScale { 1.f };
+        std::atomic<float> m_tickRate { 0.f };
+        std::atomic<size_type> m_tickLimit { 0 };
+
+        std::atomic_bool m_deterministic { false };
+        std::atomic<float> m_simulationStep { 0.01f };
+        std::atomic<uint64> m_simulationTick { 0 };
+        fast_time m_simulationBuffer = 0;
 
         events::EventBus* m_eventBus;
 
+        std::atomic_bool m_evictionQueued{ false };
+
         bool m_threadsShouldTerminate = false;
         bool m_threadsShouldStart = false;
         bool m_lowPower;
@@ -80,14 +96,35 @@ namespace legion::core::scheduling
         static std::queue<std::shared_ptr<async::job_pool_base>> m_jobs;
         static std::unordered_map<std::thread::id, async::rw_spinlock> m_commandLocks;
         static std::unordered_map<std::thread::id, std::queue<std::unique_ptr<runnable_base>>> m_commands;
+        static std::atomic<uint64> m_jobBusyTime; // Nanoseconds the worker threads spent executing jobs.
+        static std::atomic<uint64> m_jobsQueued; // Jobs queued since the last statistics update.
 
         static void threadMain(bool* exit, bool* start, bool lowPower);
 
         static void tryCompleteJobPool();
 
+        /**@brief Records the job pool utilization and the amount of queued jobs since the last update and logs the statistics report if it's due.
+         */
+        void updateStatistics(uint64& lastUpdate, uint64& busyTime, uint64& lastLog, size_type workerCount);
+
+        /**@brief Samples the memory tracker periodically and queues an eviction at the next sync point if any memory tag went over budget.
+         */
+        void updateMemory(uint64& lastUpdate);
+
+        /**@brief Advances the simulation tick counter in deterministic mode and runs all fixed interval processes of every chain for each tick that passed.
+         * @param frameTime Time the main loop iteration took in seconds, only used if no fixed tick rate is set.
+         */
+        void runSimulationTicks(fast_time frameTime);
+
     public:
 
-        Scheduler(events::EventBus* eventBus, bool lowPower, uint minThreads);
+        /**@brief Creates the scheduler and all of it's worker threads.
+         * @param eventBus Event bus to check for the exit event.
+         * @param lowPower Makes idle threads sleep instead of yield.
+         * @param minThreads Minimum amount of threads to create.
+         * @param maxThreads Maximum amount of threads to create, 0 for no limit. Overrides minThreads.
+         */
+        Scheduler(events::EventBus* eventBus, bool lowPower, uint minThreads, uint maxThreads = 0);
 
         ~Scheduler();
 
@@ -105,6 +142,82 @@ namespace legion::core::scheduling
             return m_timeScale.load(std::memory_order_relaxed);
         }
 
+        /**@brief Set a fixed tick rate for all process-chains.
+         *        Every process-chain will sleep out the remainder of a tick after running it's processes.
+         * @param ticksPerSecond Amount of ticks per second, 0 disables the fixed tick rate and lets all chains run as fast as possible.
+         */
+        void setTickRate(float ticksPerSecond)
+        {
+            m_tickRate.store(ticksPerSecond, std::memory_order_relaxed);
+        }
+
+        /**@brief Get the fixed tick rate, 0 if no tick rate is set.
+         */
+        float getTickRate()
+        {
+            return m_tickRate.load(std::memory_order_relaxed);
+        }
+
+        /**@brief Set the amount of main loop ticks after which the engine exits, 0 to run indefinitely.
+         */
+        void setTickLimit(size_type ticks)
+        {
+            m_tickLimit.store(ticks, std::memory_order_relaxed);
+        }
+
+        /**@brief Get the amount of main loop ticks after which the engine exits, 0 if unlimited.
+         */
+        size_type getTickLimit()
+        {
+            return m_tickLimit.load(std::memory_order_relaxed);
+        }
+
+        /**@brief Enable or disable deterministic mode.
+         *        In deterministic mode processes with a fixed interval no longer run on their own chain with wall-clock driven timing,
+         *        instead the main thread advances a shared simulation tick counter and runs every due fixed interval process of every chain in a fixed order.
+         *        Combined with a fixed tick rate every run executes the exact same sequence of simulation ticks.
+         */
+        void setDeterministic(bool deterministic)
+        {
+            m_deterministic.store(deterministic, std::memory_order_relaxed);
+        }
+
+        /**@brief Whether the scheduler runs in deterministic mode.
+         */
+        bool isDeterministic()
+        {
+            return m_deterministic.load(std::memory_order_relaxed);
+        }
+
+        /**@brief Set the duration of a single simulation tick in deterministic mode.
+         *        Intervals of fixed interval processes get rounded to a whole amount of simulation ticks.
+         * @param seconds Duration of a single tick, defaults to 0.01 (100Hz).
+         */
+        void setSimulationStep(float seconds)
+        {
+            m_simulationStep.store(seconds, std::memory_order_relaxed);
+        }
+
+        /**@brief Get the duration of a single simulation tick in deterministic mode.
+         */
+        float getSimulationStep()
+        {
+            return m_simulationStep.load(std::memory_order_relaxed);
+        }
+
+        /**@brief Get the amount of simulation ticks that have passed in deterministic mode.
+         */
+        uint64 getSimulationTick()
+        {
+            return m_simulationTick.load(std::memory_order_acquire);
+        }
+
+        /**@brief Sleeps the calling thread until the start of the next tick if a fixed tick rate is set.
+         * @param nextTick Start of the next tick of the calling loop, gets advanced by one tick interval.
+         * @note If the loop fell behind the tick is started immediately instead of trying to catch up.
+         */
+        void waitForNextTick(std::chrono::steady_clock::time_point& nextTick);
+
         /**@brief Run main program loop, also starts all process-chains in their own threads.
          */
         void run();
@@ -165,6 +278,7 @@ namespace legion::core::scheduling
 
             OPTICK_EVENT("legion::core::scheduling::Scheduler::queueJobs<T>");
             std::shared_ptr<async::job_pool_base> jobPool = std::shared_ptr<async::job_pool_base>(new async::job_pool<Func>(count, func));
+            m_jobsQueued.fetch_add(count, std::memory_order_relaxed);
             async::readwrite_guard guard(m_jobQueueLock);
             m_jobs.push(jobPool);
             return async::job_operation<decltype(repeater), decltype(onComplete)>(jobPool->get_progress(), jobPool, repeater, onComplete);
@@ -209,6 +323,12 @@ namespace legion::core::scheduling
          */
         void waitForProcessSync();
 
+        /**@brief Queue an operation to run on the main thread during the next synchronization moment.
+         * @note All other process-chains are halted while the operation runs, which makes it safe to do structural changes to the world.
+         * @note Requests a synchronization.
+         */
+        void queueSyncOperation(delegate<void()>&& operation);
+
         /**@brief Check if a synchronization has been requested.
          */
         bool syncRequested() { return m_requestSync.load(std::memory_order_acquire); }
@@ -79,4 +79,30 @@ namespace legion::core::serialization
         static constexpr bool value = type::value;
     };
 
+
+    template<typename, typename T>
+    struct has_remap_entities
+    {
+        static_assert(
+            std::integral_constant<T, false>::value,
+            "Second template param needs to be of function type.");
+    };
+
+    template <typename C, typename Ret, typename... Args>
+    struct has_remap_entities<C, Ret(Args...)>
+    {
+    private:
+        template<typename T>
+        static constexpr auto check(T*)
+            -> typename std::is_same<decltype(std::declval<T>().remap_entities(std::declval<Args>()...)), Ret>::type;
+
+        template <typename>
+        static constexpr auto check(...)
+            ->std::false_type;
+
+        typedef decltype(check<C>(nullptr)) type;
+    public:
+        static constexpr bool value = type::value;
+    };
+
 }
@@ -8,7 +8,7 @@
 #include <string_view>
 #include <cstring>
 
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
 
 /**
  * @file type_util.hpp
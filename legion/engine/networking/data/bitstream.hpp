@@ -0,0 +1,248 @@
+#pragma once
+#include <core/core.hpp>
+
+#include <cstring>
+
+/**
+ * @file bitstream.hpp
+ * @brief Bit packing used for all network packets. Values are written least significant bit first,
+ *        so a stream written on one platform reads the same on every other platform.
+ */
+
+namespace legion::networking
+{
+    namespace detail
+    {
+        constexpr uint32 bit_mask(uint32 bits) noexcept
+        {
+            return bits >= 32 ? 0xFFFFFFFFu : (1u << bits) - 1u;
+        }
+    }
+
+    /**@class bit_writer
+     * @brief Appends tightly packed values to a byte buffer.
+     * @note Call flush before sending the buffer, otherwise the last partial byte is missing.
+     */
+    class bit_writer
+    {
+    private:
+        byte_vec& m_buffer;
+        size_type m_start;
+        uint64 m_scratch = 0;
+        uint32 m_scratchBits = 0;
+
+    public:
+        explicit bit_writer(byte_vec& buffer) : m_buffer(buffer), m_start(buffer.size()) {}
+
+        /**@brief Writes the lowest bits of a value.
+         * @param bits Amount of bits to write, at most 32.
+         */
+        void write_bits(uint32 value, uint32 bits)
+        {
+            m_scratch |= static_cast<uint64>(value & detail::bit_mask(bits)) << m_scratchBits;
+            m_scratchBits += bits;
+            while (m_scratchBits >= 8)
+            {
+                m_buffer.push_back(static_cast<byte>(m_scratch & 0xFF));
+                m_scratch >>= 8;
+                m_scratchBits -= 8;
+            }
+        }
+
+        void write_bool(bool value)
+        {
+            write_bits(value ? 1u : 0u, 1);
+        }
+
+        void write_uint64(uint64 value)
+        {
+            write_bits(static_cast<uint32>(value), 32);
+            write_bits(static_cast<uint32>(value >> 32), 32);
+        }
+
+        /**@brief Writes an unsigned value in groups of 7 bits, small values take less space.
+         */
+        void write_varint(uint64 value)
+        {
+            while (value >= 0x80)
+            {
+                write_bits(static_cast<uint32>(value & 0x7F) | 0x80, 8);
+                value >>= 7;
+            }
+            write_bits(static_cast<uint32>(value), 8);
+        }
+
+        /**@brief Writes a signed value zigzag encoded, values close to 0 take less space.
+         */
+        void write_signed(int64 value)
+        {
+            write_varint((static_cast<uint64>(value) << 1) ^ static_cast<uint64>(value >> 63));
+        }
+
+        void write_float(float value)
+        {
+            uint32 bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            write_bits(bits, 32);
+        }
+
+        /**@brief Aligns the stream to a whole byte and appends raw bytes.
+         */
+        void write_bytes(const byte* data, size_type size)
+        {
+            align();
+            m_buffer.insert(m_buffer.end(), data, data + size);
+        }
+
+        /**@brief Pads the stream with zeroes up to the next whole byte.
+         */
+        void align()
+        {
+            if (m_scratchBits)
+                write_bits(0, 8 - m_scratchBits);
+        }
+
+        void flush()
+        {
+            align();
+        }
+
+        L_NODISCARD size_type bits_written() const noexcept
+        {
+            return (m_buffer.size() - m_start) * 8 + m_scratchBits;
+        }
+
+        L_NODISCARD size_type bytes_written() const noexcept
+        {
+            return (bits_written() + 7) / 8;
+        }
+    };
+
+    /**@class bit_reader
+     * @brief Reads values written by a bit_writer.
+     * @note Reading past the end of the data doesn't throw, it returns zeroes and sets the overflow flag instead.
+     *       Check overflowed after reading a packet to find out if it was truncated or malformed.
+     */
+    class bit_reader
+    {
+    private:
+        const byte* m_data;
+        size_type m_size;
+        size_type m_position = 0;
+        uint64 m_scratch = 0;
+        uint32 m_scratchBits = 0;
+        bool m_overflow = false;
+
+    public:
+        bit_reader(const byte* data, size_type size) : m_data(data), m_size(size) {}
+
+        /**@brief Reads a value of a certain amount of bits.
+         * @param bits Amount of bits to read, at most 32.
+         */
+        L_NODISCARD uint32 read_bits(uint32 bits)
+        {
+            while (m_scratchBits < bits)
+            {
+                if (m_position >= m_size)
+                {
+                    m_overflow = true;
+                    return 0;
+                }
+
+                m_scratch |= static_cast<uint64>(m_data[m_position++]) << m_scratchBits;
+                m_scratchBits += 8;
+            }
+
+            uint32 value = static_cast<uint32>(m_scratch) & detail::bit_mask(bits);
+            m_scratch >>= bits;
+            m_scratchBits -= bits;
+            return value;
+        }
+
+        L_NODISCARD bool read_bool()
+        {
+            return read_bits(1) != 0;
+        }
+
+        L_NODISCARD uint64 read_uint64()
+        {
+            uint64 low = read_bits(32);
+            uint64 high = read_bits(32);
+            return low | (high << 32);
+        }
+
+        L_NODISCARD uint64 read_varint()
+        {
+            uint64 value = 0;
+            for (uint32 shift = 0; shift < 64; shift += 7)
+            {
+                uint32 group = read_bits(8);
+                value |= static_cast<uint64>(group & 0x7F) << shift;
+                if (!(group & 0x80) || m_overflow)
+                    return value;
+            }
+
+            m_overflow = true; // More than 10 groups can only be a malformed stream.
+            return 0;
+        }
+
+        L_NODISCARD int64 read_signed()
+        {
+            uint64 value = read_varint();
+            return static_cast<int64>(value >> 1) ^ -static_cast<int64>(value & 1);
+        }
+
+        L_NODISCARD float read_float()
+        {
+            uint32 bits = read_bits(32);
+            float value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        /**@brief Aligns the stream to a whole byte and reads raw bytes.
+         * @returns bool False if there weren't enough bytes left.
+         */
+        bool read_bytes(byte* data, size_type size)
+        {
+            align();
+
+            // Whole bytes that were already loaded into the scratch come first.
+            while (size && m_scratchBits)
+            {
+                *data++ = static_cast<byte>(read_bits(8));
+                size--;
+            }
+
+            if (m_position + size > m_size)
+            {
+                m_overflow = true;
+                return false;
+            }
+
+            if (size)
+                std::memcpy(data, m_data + m_position, size);
+            m_position += size;
+            return true;
+        }
+
+        /**@brief Skips the padding up to the next whole byte.
+         */
+        void align()
+        {
+            uint32 padding = m_scratchBits % 8;
+            m_scratch >>= padding;
+            m_scratchBits -= padding;
+        }
+
+        L_NODISCARD bool overflowed() const noexcept
+        {
+            return m_overflow;
+        }
+
+        L_NODISCARD size_type bits_remaining() const noexcept
+        {
+            return (m_size - m_position) * 8 + m_scratchBits;
+        }
+    };
+}
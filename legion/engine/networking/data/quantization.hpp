@@ -0,0 +1,116 @@
+#pragma once
+#include <core/core.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file quantization.hpp
+ * @brief Lossy compression of floating point state before it gets sent over the network.
+ *        Quantized values are plain integers so that the server can compare them bitwise to find out what changed.
+ */
+
+namespace legion::networking
+{
+    /**@brief Quantizes a float to a fixed point value with a certain precision.
+     * @param precision Smallest step that can be represented, e.g. 1/512 for 2mm steps.
+     */
+    L_NODISCARD inline int32 quantize_float(float value, float precision) noexcept
+    {
+        constexpr float limit = 2147483520.f; // Largest float below int32 max.
+        return static_cast<int32>(std::clamp(std::round(value / precision), -limit, limit));
+    }
+
+    L_NODISCARD inline float dequantize_float(int32 value, float precision) noexcept
+    {
+        return static_cast<float>(value) * precision;
+    }
+
+    /**@class quantized_vec3
+     * @brief Fixed point vector.
+     */
+    struct quantized_vec3
+    {
+        int32 x = 0;
+        int32 y = 0;
+        int32 z = 0;
+
+        bool operator==(const quantized_vec3& other) const noexcept { return x == other.x && y == other.y && z == other.z; }
+        bool operator!=(const quantized_vec3& other) const noexcept { return !(*this == other); }
+    };
+
+    L_NODISCARD inline quantized_vec3 quantize_vec3(const math::vec3& value, float precision) noexcept
+    {
+        return { quantize_float(value.x, precision), quantize_float(value.y, precision), quantize_float(value.z, precision) };
+    }
+
+    L_NODISCARD inline math::vec3 dequantize_vec3(const quantized_vec3& value, float precision) noexcept
+    {
+        return math::vec3(dequantize_float(value.x, precision), dequantize_float(value.y, precision), dequantize_float(value.z, precision));
+    }
+
+    /**@brief Amount of bits used for each of the three smallest components of a quantized rotation.
+     */
+    constexpr uint32 rotation_component_bits = 10;
+
+    /**@brief Quantizes a rotation into 32 bits using the smallest three encoding.
+     *        The largest component is left out and reconstructed from the other three, which all lie within [-1/sqrt(2), 1/sqrt(2)].
+     * @returns uint32 2 bits for the index of the largest component followed by three components of rotation_component_bits each.
+     */
+    L_NODISCARD inline uint32 quantize_rotation(const math::quat& rotation) noexcept
+    {
+        math::quat q = math::normalize(rotation);
+        float components[4] = { q.x, q.y, q.z, q.w };
+
+        uint32 largest = 0;
+        for (uint32 i = 1; i < 4; i++)
+            if (std::abs(components[i]) > std::abs(components[largest]))
+                largest = i;
+
+        // q and -q are the same rotation, flip the sign so the largest component is always positive.
+        const float sign = components[largest] < 0.f ? -1.f : 1.f;
+
+        constexpr float range = 0.70710678f;
+        constexpr float scale = static_cast<float>((1u << rotation_component_bits) - 1);
+
+        uint32 result = largest;
+        uint32 shift = 2;
+        for (uint32 i = 0; i < 4; i++)
+        {
+            if (i == largest)
+                continue;
+
+            float normalized = (std::clamp(components[i] * sign, -range, range) + range) / (2.f * range);
+            result |= static_cast<uint32>(std::round(normalized * scale)) << shift;
+            shift += rotation_component_bits;
+        }
+
+        return result;
+    }
+
+    L_NODISCARD inline math::quat dequantize_rotation(uint32 value) noexcept
+    {
+        constexpr float range = 0.70710678f;
+        constexpr float scale = static_cast<float>((1u << rotation_component_bits) - 1);
+        constexpr uint32 mask = (1u << rotation_component_bits) - 1;
+
+        const uint32 largest = value & 3;
+        float components[4];
+        float sumSquares = 0.f;
+
+        uint32 shift = 2;
+        for (uint32 i = 0; i < 4; i++)
+        {
+            if (i == largest)
+                continue;
+
+            float normalized = static_cast<float>((value >> shift) & mask) / scale;
+            components[i] = normalized * 2.f * range - range;
+            sumSquares += components[i] * components[i];
+            shift += rotation_component_bits;
+        }
+
+        components[largest] = std::sqrt(std::max(0.f, 1.f - sumSquares));
+        return math::normalize(math::quat(components[3], components[0], components[1], components[2]));
+    }
+}
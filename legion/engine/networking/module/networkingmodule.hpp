@@ -0,0 +1,39 @@
+#pragma once
+#include <core/core.hpp>
+#include <networking/replication/codecs.hpp>
+#include <networking/replication/replication_registry.hpp>
+#include <networking/systems/replicationsystem.hpp>
+
+namespace legion::networking
+{
+    /**@class NetworkingModule
+     * @brief Replicates positions, rotations and scales from a server to it's clients.
+     *        Report additional replicated types with ReplicationRegistry::reportType before the engine initializes.
+     */
+    class NetworkingModule : public Module
+    {
+    private:
+        replication_config m_config;
+
+    public:
+        explicit NetworkingModule(const replication_config& config = {}) : m_config(config) {}
+
+        virtual void setup() override
+        {
+            ReplicationRegistry::reportType<position_codec>();
+            ReplicationRegistry::reportType<rotation_codec>();
+            ReplicationRegistry::reportType<scale_codec>();
+            reportSystem<ReplicationSystem>(m_config);
+        }
+
+        virtual priority_type priority() override
+        {
+            return 10;
+        }
+
+        virtual bool headlessCompatible() override
+        {
+            return true;
+        }
+    };
+}
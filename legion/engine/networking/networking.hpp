@@ -0,0 +1,16 @@
+#pragma once
+#include <networking/module/networkingmodule.hpp>
+#include <networking/data/bitstream.hpp>
+#include <networking/data/quantization.hpp>
+#include <networking/transport/transport.hpp>
+#include <networking/transport/udp_transport.hpp>
+#include <networking/transport/loopback_transport.hpp>
+#include <networking/transport/sequence_buffer.hpp>
+#include <networking/transport/connection.hpp>
+#include <networking/replication/replication_settings.hpp>
+#include <networking/replication/replication_registry.hpp>
+#include <networking/replication/codecs.hpp>
+#include <networking/replication/relevancy_grid.hpp>
+#include <networking/replication/replication_server.hpp>
+#include <networking/replication/replication_client.hpp>
+#include <networking/systems/replicationsystem.hpp>
@@ -0,0 +1,120 @@
+#pragma once
+#include <core/core.hpp>
+#include <networking/data/bitstream.hpp>
+#include <networking/data/quantization.hpp>
+
+/**
+ * @file codecs.hpp
+ * @brief Codecs of the default replicated components, see replication_registry.hpp for the codec interface.
+ */
+
+namespace legion::networking
+{
+    namespace detail
+    {
+        /**@brief Writes every axis that differs from the baseline as a zigzag encoded difference, unchanged axes take a single bit.
+         */
+        inline void write_vec3_delta(bit_writer& writer, const quantized_vec3& value, const quantized_vec3* baseline)
+        {
+            const quantized_vec3 base = baseline ? *baseline : quantized_vec3{};
+            const int32 values[3] = { value.x, value.y, value.z };
+            const int32 bases[3] = { base.x, base.y, base.z };
+
+            for (int i = 0; i < 3; i++)
+            {
+                const bool changed = values[i] != bases[i];
+                writer.write_bool(changed);
+                if (changed)
+                    writer.write_signed(static_cast<int64>(values[i]) - bases[i]);
+            }
+        }
+
+        inline void read_vec3_delta(bit_reader& reader, quantized_vec3& value, const quantized_vec3* baseline)
+        {
+            const quantized_vec3 base = baseline ? *baseline : quantized_vec3{};
+            const int32 bases[3] = { base.x, base.y, base.z };
+            int32 values[3];
+
+            for (int i = 0; i < 3; i++)
+                values[i] = reader.read_bool() ? static_cast<int32>(bases[i] + reader.read_signed()) : bases[i];
+
+            value = { values[0], values[1], values[2] };
+        }
+    }
+
+    /**@class position_codec
+     * @brief Positions are quantized to 2mm steps and sent as differences to the baseline.
+     */
+    struct position_codec
+    {
+        using component_type = position;
+        using quantized_type = quantized_vec3;
+
+        static constexpr float precision = 1.f / 512.f;
+
+        static void quantize(const position& value, quantized_vec3& out) { out = quantize_vec3(value, precision); }
+        static void dequantize(const quantized_vec3& value, position& out) { out = dequantize_vec3(value, precision); }
+
+        static void write(bit_writer& writer, const quantized_vec3& value, const quantized_vec3* baseline) { detail::write_vec3_delta(writer, value, baseline); }
+        static void read(bit_reader& reader, quantized_vec3& value, const quantized_vec3* baseline) { detail::read_vec3_delta(reader, value, baseline); }
+    };
+
+    /**@class rotation_codec
+     * @brief Rotations are quantized to 32 bits using the smallest three encoding.
+     */
+    struct rotation_codec
+    {
+        using component_type = rotation;
+        using quantized_type = uint32;
+
+        static void quantize(const rotation& value, uint32& out) { out = quantize_rotation(value); }
+        static void dequantize(const uint32& value, rotation& out) { out = dequantize_rotation(value); }
+
+        static void write(bit_writer& writer, const uint32& value, const uint32*) { writer.write_bits(value, 32); }
+        static void read(bit_reader& reader, uint32& value, const uint32*) { value = reader.read_bits(32); }
+    };
+
+    /**@class scale_codec
+     * @brief Scales are quantized to steps of 1/1024 and sent as differences to the baseline.
+     */
+    struct scale_codec
+    {
+        using component_type = scale;
+        using quantized_type = quantized_vec3;
+
+        static constexpr float precision = 1.f / 1024.f;
+
+        static void quantize(const scale& value, quantized_vec3& out) { out = quantize_vec3(value, precision); }
+        static void dequantize(const quantized_vec3& value, scale& out) { out = dequantize_vec3(value, precision); }
+
+        static void write(bit_writer& writer, const quantized_vec3& value, const quantized_vec3* baseline) { detail::write_vec3_delta(writer, value, baseline); }
+        static void read(bit_reader& reader, quantized_vec3& value, const quantized_vec3* baseline) { detail::read_vec3_delta(reader, value, baseline); }
+    };
+
+    /**@class raw_codec
+     * @brief Sends a trivially copyable component as is, for components without a dedicated codec.
+     */
+    template<typename component>
+    struct raw_codec
+    {
+        using component_type = component;
+        using quantized_type = component;
+
+        static void quantize(const component_type& value, quantized_type& out) { out = value; }
+        static void dequantize(const quantized_type& value, component_type& out) { out = value; }
+
+        static void write(bit_writer& writer, const quantized_type& value, const quantized_type*)
+        {
+            const byte* data = reinterpret_cast<const byte*>(&value);
+            for (size_type i = 0; i < sizeof(quantized_type); i++)
+                writer.write_bits(data[i], 8);
+        }
+
+        static void read(bit_reader& reader, quantized_type& value, const quantized_type*)
+        {
+            byte* data = reinterpret_cast<byte*>(&value);
+            for (size_type i = 0; i < sizeof(quantized_type); i++)
+                data[i] = static_cast<byte>(reader.read_bits(8));
+        }
+    };
+}
@@ -0,0 +1,242 @@
+#include <networking/replication/relevancy_grid.hpp>
+
+#include <algorithm>
+
+namespace legion::networking
+{
+    math::ivec3 RelevancyGrid::cell_of(const math::vec3& point) const
+    {
+        return math::ivec3(math::floor(point / m_cellSize));
+    }
+
+    bool RelevancyGrid::sees(const observer& target, const math::ivec3& cell) noexcept
+    {
+        return target.active &&
+            cell.x >= target.min.x && cell.x <= target.max.x &&
+            cell.y >= target.min.y && cell.y <= target.max.y &&
+            cell.z >= target.min.z && cell.z <= target.max.z;
+    }
+
+    template<typename Func>
+    void RelevancyGrid::for_each_cell(const math::ivec3& min, const math::ivec3& max, Func&& func)
+    {
+        const math::ivec3 extents = max - min + math::ivec3(1);
+        const uint64 volume = static_cast<uint64>(extents.x) * static_cast<uint64>(extents.y) * static_cast<uint64>(extents.z);
+
+        if (volume > m_cells.size())
+        {
+            for (auto& [cell, entities] : m_cells)
+                if (cell.x >= min.x && cell.x <= max.x && cell.y >= min.y && cell.y <= max.y && cell.z >= min.z && cell.z <= max.z)
+                    func(cell, entities);
+            return;
+        }
+
+        for (int32 x = min.x; x <= max.x; x++)
+            for (int32 y = min.y; y <= max.y; y++)
+                for (int32 z = min.z; z <= max.z; z++)
+                {
+                    const math::ivec3 cell(x, y, z);
+                    auto it = m_cells.find(cell);
+                    if (it != m_cells.end())
+                        func(cell, it->second);
+                }
+    }
+
+    void RelevancyGrid::reset(float cellSize, size_type observerCount)
+    {
+        m_cellSize = cellSize;
+        m_entities.clear();
+        m_cells.clear();
+        m_sortedEntities.clear();
+        m_sortedPositions.clear();
+        m_observers.clear();
+        m_observers.resize(observerCount);
+    }
+
+    void RelevancyGrid::update(const std::vector<id_type>& entities, const std::vector<math::vec3>& positions)
+    {
+        OPTICK_EVENT();
+
+        // Both lists are sorted, so added, removed and moved entities can be found by walking them side by side.
+        size_type previous = 0;
+        size_type current = 0;
+        while (previous < m_sortedEntities.size() || current < entities.size())
+        {
+            if (current == entities.size() || (previous < m_sortedEntities.size() && m_sortedEntities[previous] < entities[current]))
+            {
+                erase(m_sortedEntities[previous++]);
+            }
+            else if (previous == m_sortedEntities.size() || entities[current] < m_sortedEntities[previous])
+            {
+                insert(entities[current], positions[current]);
+                current++;
+            }
+            else
+            {
+                if (m_sortedPositions[previous] != positions[current])
+                    move(entities[current], positions[current]);
+                previous++;
+                current++;
+            }
+        }
+
+        m_sortedEntities = entities;
+        m_sortedPositions = positions;
+
+        for (auto& target : m_observers)
+        {
+            if (target.followed == invalid_id)
+                continue;
+
+            auto it = m_entities.find(target.followed);
+            if (it != m_entities.end() && (!target.active || it->second.position != target.position))
+                place(target, it->second.position, target.radius);
+        }
+    }
+
+    void RelevancyGrid::set_observer(size_type index, const math::vec3& position, float radius)
+    {
+        observer& target = m_observers[index];
+        target.followed = invalid_id;
+        place(target, position, radius);
+    }
+
+    void RelevancyGrid::follow_entity(size_type index, id_type entity, float radius)
+    {
+        observer& target = m_observers[index];
+        target.followed = entity;
+
+        auto it = m_entities.find(entity);
+        if (it != m_entities.end())
+            place(target, it->second.position, radius);
+        else
+            target.radius = radius; // Gets placed once the entity shows up.
+    }
+
+    void RelevancyGrid::remove_observer(size_type index)
+    {
+        observer& target = m_observers[index];
+        const uint64 version = target.version + 1;
+        target = observer();
+        target.version = version;
+    }
+
+    void RelevancyGrid::accumulate(size_type index, const relevancy_settings& settings)
+    {
+        OPTICK_EVENT();
+        observer& target = m_observers[index];
+        const float minimumRate = 1.f / settings.maxInterval;
+
+        for (auto& [entity, state] : target.relevant)
+        {
+            const float distance = math::distance(m_entities.at(entity).position, target.position);
+            const float rate = distance <= settings.fullRateDistance ? 1.f : math::max(settings.fullRateDistance / distance, minimumRate);
+            state.priority = math::min(state.priority + rate, settings.maxInterval);
+        }
+    }
+
+    void RelevancyGrid::insert(id_type entity, const math::vec3& position)
+    {
+        const math::ivec3 cell = cell_of(position);
+        m_entities.emplace(entity, entity_entry{ position, cell });
+        m_cells[cell].push_back(entity);
+
+        for (auto& target : m_observers)
+            if (sees(target, cell) && target.relevant.emplace(entity, relevance{}).second)
+                target.version++;
+    }
+
+    void RelevancyGrid::erase(id_type entity)
+    {
+        auto it = m_entities.find(entity);
+        if (it == m_entities.end())
+            return;
+
+        const math::ivec3 cell = it->second.cell;
+        m_entities.erase(it);
+
+        auto& occupants = m_cells.at(cell);
+        occupants.erase(std::find(occupants.begin(), occupants.end(), entity));
+        if (occupants.empty())
+            m_cells.erase(cell);
+
+        for (auto& target : m_observers)
+            if (sees(target, cell) && target.relevant.erase(entity))
+                target.version++;
+    }
+
+    void RelevancyGrid::move(id_type entity, const math::vec3& position)
+    {
+        entity_entry& entry = m_entities.at(entity);
+        entry.position = position;
+
+        const math::ivec3 from = entry.cell;
+        const math::ivec3 to = cell_of(position);
+        if (from == to)
+            return; // Moving within a cell doesn't change what is relevant to whom.
+
+        entry.cell = to;
+
+        auto& occupants = m_cells.at(from);
+        occupants.erase(std::find(occupants.begin(), occupants.end(), entity));
+        if (occupants.empty())
+            m_cells.erase(from);
+        m_cells[to].push_back(entity);
+
+        for (auto& target : m_observers)
+        {
+            const bool wasVisible = sees(target, from);
+            const bool isVisible = sees(target, to);
+            if (wasVisible == isVisible)
+                continue;
+
+            if (isVisible)
+                target.relevant.emplace(entity, relevance{});
+            else
+                target.relevant.erase(entity);
+            target.version++;
+        }
+    }
+
+    void RelevancyGrid::place(observer& target, const math::vec3& position, float radius)
+    {
+        const math::ivec3 min = cell_of(position - math::vec3(radius));
+        const math::ivec3 max = cell_of(position + math::vec3(radius));
+
+        target.position = position;
+        target.radius = radius;
+
+        if (target.active && min == target.min && max == target.max)
+            return; // Still sees the same cells.
+
+        observer previous;
+        previous.active = target.active;
+        previous.min = target.min;
+        previous.max = target.max;
+        target.min = min;
+        target.max = max;
+        target.active = true;
+
+        // Only the cells that went in or out of view need to be touched.
+        if (previous.active)
+            for_each_cell(previous.min, previous.max, [&](const math::ivec3& cell, const std::vector<id_type>& occupants)
+                {
+                    if (sees(target, cell))
+                        return;
+
+                    for (id_type entity : occupants)
+                        target.relevant.erase(entity);
+                    target.version++;
+                });
+
+        for_each_cell(min, max, [&](const math::ivec3& cell, const std::vector<id_type>& occupants)
+            {
+                if (sees(previous, cell))
+                    return;
+
+                for (id_type entity : occupants)
+                    target.relevant.emplace(entity, relevance{});
+                target.version++;
+            });
+    }
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <core/core.hpp>
+#include <networking/replication/replication_settings.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file relevancy_grid.hpp
+ * @brief Interest management for the replication server. Replicated entities are kept in a spatial hash and every client has
+ *        an observer that sees a box of cells around it. The set of relevant entities of every observer is kept up to date
+ *        incrementally: only entities that cross a cell border and observers that move into other cells cause any work.
+ *        Within the relevant set entities further away from the observer are updated less often, see relevancy_settings.
+ */
+
+namespace legion::networking
+{
+    /**@class relevance
+     * @brief State of a single entity that is relevant to a single observer.
+     */
+    struct relevance
+    {
+        float priority = 1.f; // Accumulated update priority, the entity is due for an update once this reaches 1.
+    };
+
+    using relevant_set = std::unordered_map<id_type, relevance>;
+
+    /**@class RelevancyGrid
+     * @brief Spatial hash of entity positions with a relevant set for every observer.
+     */
+    class RelevancyGrid
+    {
+    private:
+        struct entity_entry
+        {
+            math::vec3 position;
+            math::ivec3 cell;
+        };
+
+        struct observer
+        {
+            bool active = false;
+            id_type followed = invalid_id;
+            math::vec3 position;
+            float radius = 0.f;
+            math::ivec3 min; // Inclusive range of cells the observer sees.
+            math::ivec3 max;
+            uint64 version = 0; // Changes every time an entity enters or leaves the relevant set.
+            relevant_set relevant;
+        };
+
+        float m_cellSize = 32.f;
+        std::unordered_map<id_type, entity_entry> m_entities;
+        std::unordered_map<math::ivec3, std::vector<id_type>> m_cells;
+        std::vector<observer> m_observers;
+
+        // Entities and positions of the last update, sorted by id so the next update can find the differences in a single pass.
+        std::vector<id_type> m_sortedEntities;
+        std::vector<math::vec3> m_sortedPositions;
+
+        L_NODISCARD math::ivec3 cell_of(const math::vec3& point) const;
+        L_NODISCARD static bool sees(const observer& target, const math::ivec3& cell) noexcept;
+
+        void insert(id_type entity, const math::vec3& position);
+        void erase(id_type entity);
+        void move(id_type entity, const math::vec3& position);
+
+        void place(observer& target, const math::vec3& position, float radius);
+
+        /**@brief Calls func with the entities of every occupied cell in an inclusive range,
+         *        iterates the occupied cells instead if there are fewer of those than cells in the range.
+         */
+        template<typename Func>
+        void for_each_cell(const math::ivec3& min, const math::ivec3& max, Func&& func);
+
+    public:
+        explicit RelevancyGrid(float cellSize = 32.f) : m_cellSize(cellSize) {}
+
+        /**@brief Removes all entities and observers and changes the cell size.
+         */
+        void reset(float cellSize, size_type observerCount);
+
+        /**@brief Brings the grid up to date with the current positions of all entities.
+         * @param entities All entities that have a position, sorted by id.
+         * @param positions Positions of the entities in the same order.
+         */
+        void update(const std::vector<id_type>& entities, const std::vector<math::vec3>& positions);
+
+        /**@brief Places an observer at a fixed position.
+         * @param radius Radius around the position in which entities are relevant.
+         */
+        void set_observer(size_type index, const math::vec3& position, float radius);
+
+        /**@brief Makes an observer follow an entity in the grid, the observer stays where it is while the entity doesn't exist.
+         */
+        void follow_entity(size_type index, id_type entity, float radius);
+
+        /**@brief Removes an observer, nothing is relevant to it anymore.
+         */
+        void remove_observer(size_type index);
+
+        /**@brief Adds the update rate of every relevant entity of an observer to it's priority, the rate drops with the distance to the observer.
+         */
+        void accumulate(size_type index, const relevancy_settings& settings);
+
+        L_NODISCARD relevant_set& relevant(size_type index) { return m_observers[index].relevant; }
+        L_NODISCARD const relevant_set& relevant(size_type index) const { return m_observers[index].relevant; }
+        L_NODISCARD uint64 version(size_type index) const { return m_observers[index].version; }
+        L_NODISCARD bool has_observer(size_type index) const { return index < m_observers.size() && m_observers[index].active; }
+
+        /**@brief All entities in the grid, sorted by id.
+         */
+        L_NODISCARD const std::vector<id_type>& entities() const noexcept { return m_sortedEntities; }
+
+        L_NODISCARD size_type cell_count() const noexcept { return m_cells.size(); }
+        L_NODISCARD float cell_size() const noexcept { return m_cellSize; }
+    };
+}
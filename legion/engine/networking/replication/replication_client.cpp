@@ -0,0 +1,492 @@
+#include <networking/replication/replication_client.hpp>
+#include <networking/transport/udp_transport.hpp>
+
+#include <cstring>
+
+namespace legion::networking
+{
+    ReplicationClient::ReplicationClient(std::shared_ptr<transport> transport, ecs::EcsRegistry* registry, const replication_settings& settings)
+        : m_transport(transport ? std::move(transport) : std::make_shared<udp_transport>()), m_registry(registry), m_settings(settings)
+    {
+    }
+
+    ReplicationClient::~ReplicationClient()
+    {
+        disconnect();
+    }
+
+    bool ReplicationClient::connect(const net_address& server, double now)
+    {
+        disconnect();
+
+        if (!m_transport->open(0))
+        {
+            log::error("Replication client failed to open a socket.");
+            return false;
+        }
+
+        m_server = server;
+        m_state = client_state::connecting;
+        m_connectStart = now;
+        m_lastRequest = now - connect_retry_interval;
+        log::info("Connecting to {}.", server.to_string());
+        return true;
+    }
+
+    void ReplicationClient::disconnect()
+    {
+        if (m_state == client_state::disconnected)
+            return;
+
+        if (m_state == client_state::connected)
+            send_packet(packet_type::disconnect, 0.0);
+
+        reset();
+        m_transport->close();
+    }
+
+    void ReplicationClient::reset()
+    {
+        if (m_registry)
+            for (auto& [id, remote] : m_entities)
+                if (m_registry->validateEntity(remote.local))
+                    m_registry->destroyEntity(remote.local);
+
+        m_entities.clear();
+        m_types.clear();
+        m_staged.clear();
+        m_connection.reset();
+        m_state = client_state::disconnected;
+    }
+
+    void ReplicationClient::update(double now)
+    {
+        OPTICK_EVENT();
+        if (m_state == client_state::disconnected)
+            return;
+
+        net_address source;
+        while (m_state != client_state::disconnected && m_transport->receive(source, m_receiveBuffer))
+        {
+            if (source != m_server)
+                continue;
+
+            m_stats.packetsReceived++;
+            m_stats.bytesReceived += m_receiveBuffer.size();
+
+            bit_reader reader(m_receiveBuffer.data(), m_receiveBuffer.size());
+            packet_type type;
+            if (!read_packet_prefix(reader, type))
+                continue;
+
+            switch (type)
+            {
+            case packet_type::connect_accept:
+                if (m_state == client_state::connecting)
+                {
+                    m_clientIndex = static_cast<size_type>(reader.read_varint());
+                    m_connection = std::make_unique<connection>(m_server, now);
+                    m_types.resize(ReplicationRegistry::types().size());
+                    m_staged.resize(m_types.size());
+                    m_state = client_state::connected;
+                    log::info("Connected to {} as client {}.", m_server.to_string(), m_clientIndex);
+                }
+                break;
+            case packet_type::connect_reject:
+                if (m_state == client_state::connecting)
+                {
+                    if (reader.read_varint() == 0)
+                        log::error("Connection to {} was rejected, the server replicates a different set of component types.", m_server.to_string());
+                    else
+                        log::error("Connection to {} was rejected, the server is full.", m_server.to_string());
+                    disconnect();
+                }
+                break;
+            case packet_type::disconnect:
+                if (m_state == client_state::connected)
+                {
+                    log::info("Server {} closed the connection.", m_server.to_string());
+                    reset();
+                    m_transport->close();
+                }
+                break;
+            case packet_type::payload:
+                if (m_state == client_state::connected)
+                    handle_payload(reader, now);
+                break;
+            default:
+                break;
+            }
+        }
+
+        if (m_state == client_state::connecting)
+        {
+            if (now - m_connectStart > m_settings.timeout)
+            {
+                log::error("Failed to connect to {}, the server didn't respond.", m_server.to_string());
+                disconnect();
+            }
+            else if (now - m_lastRequest >= connect_retry_interval)
+            {
+                send_packet(packet_type::connect_request, now);
+                m_lastRequest = now;
+            }
+        }
+        else if (m_state == client_state::connected)
+        {
+            if (m_connection->timed_out(now, m_settings.timeout))
+            {
+                log::error("Connection to {} timed out.", m_server.to_string());
+                reset();
+                m_transport->close();
+            }
+            else
+                send_packet(packet_type::payload, now); // Acknowledges the received state and carries reliable messages.
+        }
+    }
+
+    bool ReplicationClient::send_message(const byte* data, size_type size)
+    {
+        if (m_state != client_state::connected)
+        {
+            log::warn("Can't send a message, not connected to a server.");
+            return false;
+        }
+
+        return m_connection->send_reliable(data, size);
+    }
+
+    bool ReplicationClient::receive_message(byte_vec& message)
+    {
+        if (m_messages.empty())
+            return false;
+
+        message = std::move(m_messages.front());
+        m_messages.pop_front();
+        return true;
+    }
+
+    void ReplicationClient::send_packet(packet_type type, double now)
+    {
+        m_packet.clear();
+        bit_writer writer(m_packet);
+        write_packet_prefix(writer, type);
+
+        if (type == packet_type::connect_request)
+            writer.write_uint64(ReplicationRegistry::layoutHash());
+        else if (type == packet_type::payload)
+            m_connection->write_header(writer, now);
+
+        writer.flush();
+        if (m_transport->send(m_server, m_packet.data(), m_packet.size()))
+        {
+            m_stats.packetsSent++;
+            m_stats.bytesSent += m_packet.size();
+        }
+    }
+
+    const byte* ReplicationClient::find_baseline(size_type typeIndex, id_type entity, uint16 sequence) const
+    {
+        auto& state = m_types[typeIndex];
+        auto it = state.entities.find(entity);
+        if (it == state.entities.end() || it->second.removed)
+            return nullptr;
+
+        const entity_history& history = it->second;
+        const size_type quantizedSize = ReplicationRegistry::types()[typeIndex].quantizedSize;
+        for (size_type i = 0; i < history.count; i++)
+            if (history.sequences[i] == sequence)
+                return state.values.data() + (history.slot * baseline_window + i) * quantizedSize;
+
+        return nullptr;
+    }
+
+    void ReplicationClient::handle_payload(bit_reader& reader, double now)
+    {
+        OPTICK_EVENT();
+        uint16 sequence;
+        if (!m_connection->read_header(reader, now, sequence))
+            return;
+
+        byte_vec message;
+        while (m_connection->receive_reliable(message))
+            m_messages.push_back(std::move(message));
+
+        const uint32 tick = reader.read_bits(32);
+
+        for (auto& staged : m_staged)
+        {
+            staged.removals.clear();
+            staged.updates.clear();
+            staged.values.clear();
+        }
+
+        auto& types = ReplicationRegistry::types();
+        while (!reader.overflowed())
+        {
+            const uint64 index = reader.read_varint();
+            if (index == 0)
+                break;
+
+            const size_type typeIndex = static_cast<size_type>(index - 1);
+            if (typeIndex >= types.size())
+            {
+                log::warn("Received state of unknown replicated type {}.", typeIndex);
+                return;
+            }
+
+            auto& type = types[typeIndex];
+            auto& staged = m_staged[typeIndex];
+
+            id_type entity = 0;
+            while (reader.read_bool() && !reader.overflowed())
+            {
+                entity = static_cast<id_type>(static_cast<int64>(entity) + reader.read_signed());
+                staged.removals.push_back(entity);
+            }
+
+            entity = 0;
+            while (reader.read_bool() && !reader.overflowed())
+            {
+                entity = static_cast<id_type>(static_cast<int64>(entity) + reader.read_signed());
+
+                const byte* baseline = nullptr;
+                if (reader.read_bool())
+                {
+                    const uint16 baselineSequence = static_cast<uint16>(sequence - reader.read_varint());
+                    baseline = find_baseline(typeIndex, entity, baselineSequence);
+                    if (!baseline)
+                    {
+                        log::warn("Received {} of entity {} relative to a value that was never received.", type.name, entity);
+                        return;
+                    }
+                }
+
+                const size_type offset = staged.values.size();
+                staged.values.resize(offset + type.quantizedSize);
+                type.read(reader, staged.values.data() + offset, baseline);
+                staged.updates.push_back(entity);
+            }
+        }
+
+        if (reader.overflowed())
+            return; // Truncated or malformed, not acknowledging it makes the server send the state again.
+
+        m_connection->acknowledge(sequence);
+        if (static_cast<int32>(tick - m_serverTick) > 0)
+            m_serverTick = tick;
+
+        commit(sequence);
+        apply();
+    }
+
+    void ReplicationClient::commit(uint16 sequence)
+    {
+        auto& types = ReplicationRegistry::types();
+        for (size_type t = 0; t < m_types.size(); t++)
+        {
+            auto& state = m_types[t];
+            auto& staged = m_staged[t];
+            const size_type quantizedSize = types[t].quantizedSize;
+            staged.applied.clear();
+            staged.appliedRemovals.clear();
+
+            for (uint32 i = 0; i < staged.updates.size(); i++)
+            {
+                auto [it, inserted] = state.entities.try_emplace(staged.updates[i]);
+                entity_history& history = it->second;
+
+                bool apply = true;
+                if (inserted || history.removed)
+                {
+                    if (!inserted && !sequence_greater_than(sequence, history.removedSequence))
+                        continue; // Value from before the component was removed.
+
+                    if (!state.freeSlots.empty())
+                    {
+                        history.slot = state.freeSlots.back();
+                        state.freeSlots.pop_back();
+                    }
+                    else
+                    {
+                        history.slot = state.slotCount++;
+                        state.values.resize(state.slotCount * baseline_window * quantizedSize);
+                    }
+
+                    history.removed = false;
+                    history.count = 0;
+                    history.newest = sequence;
+                }
+                else if (sequence_greater_than(sequence, history.newest))
+                    history.newest = sequence;
+                else
+                    apply = false; // Arrived out of order, keep it as a baseline but don't apply it.
+
+                // Replace the oldest value once the history is full.
+                size_type index = history.count;
+                if (history.count < baseline_window)
+                    history.count++;
+                else
+                {
+                    index = 0;
+                    for (size_type j = 1; j < baseline_window; j++)
+                        if (sequence_less_than(history.sequences[j], history.sequences[index]))
+                            index = j;
+                }
+
+                history.sequences[index] = sequence;
+                std::memcpy(state.values.data() + (history.slot * baseline_window + index) * quantizedSize,
+                    staged.values.data() + i * quantizedSize, quantizedSize);
+
+                if (apply)
+                    staged.applied.push_back(i);
+            }
+
+            for (id_type entity : staged.removals)
+            {
+                auto it = state.entities.find(entity);
+                if (it == state.entities.end() || it->second.removed || !sequence_greater_than(sequence, it->second.newest))
+                    continue;
+
+                entity_history& history = it->second;
+                history.removed = true;
+                history.removedSequence = sequence;
+                history.count = 0;
+                state.freeSlots.push_back(history.slot);
+                state.removed.emplace_back(entity, sequence);
+                staged.appliedRemovals.push_back(entity);
+            }
+
+            // Packets older than the acknowledgement window get rejected, so the removal markers aren't needed anymore after that.
+            const uint16 pruneEdge = static_cast<uint16>(sequence - connection::ack_window * 2);
+            while (!state.removed.empty() && sequence_less_than(state.removed.front().second, pruneEdge))
+            {
+                auto [entity, removedSequence] = state.removed.front();
+                state.removed.pop_front();
+
+                auto it = state.entities.find(entity);
+                if (it != state.entities.end() && it->second.removed && it->second.removedSequence == removedSequence)
+                    state.entities.erase(it);
+            }
+        }
+    }
+
+    void ReplicationClient::apply()
+    {
+        OPTICK_EVENT();
+        auto& types = ReplicationRegistry::types();
+
+        // Entities the server created since the last packet.
+        std::vector<id_type> newRemotes;
+        for (auto& staged : m_staged)
+            for (uint32 i : staged.applied)
+                if (m_entities.try_emplace(staged.updates[i], remote_entity{ invalid_id, 0 }).second)
+                    newRemotes.push_back(staged.updates[i]);
+
+        ecs::entity_container newEntities;
+        if (m_registry && !newRemotes.empty())
+        {
+            newEntities = m_registry->createEntities(newRemotes.size(), false);
+
+            ecs::component_container<hierarchy> hierarchies(newEntities.size());
+            for (size_type i = 0; i < newEntities.size(); i++)
+            {
+                hierarchies[i].parent = ecs::EcsRegistry::world;
+                m_entities[newRemotes[i]].local = newEntities[i].get_id();
+            }
+
+            auto* hierarchyFamily = m_registry->getFamily<hierarchy>();
+            hierarchyFamily->insert_components(newEntities, hierarchies);
+            m_registry->registerComponents(typeHash<hierarchy>(), newEntities);
+
+            // Link the new entities into the world like entity_handle::set_parent does, so hierarchy traversal and scene serialization find them.
+            {
+                async::readwrite_guard guard(hierarchyFamily->get_lock());
+                auto& worldChildren = hierarchyFamily->get_component(world_entity_id).children;
+                worldChildren.reserve(worldChildren.size() + newEntities.size());
+                for (auto& entity : newEntities)
+                    worldChildren.insert(entity);
+            }
+        }
+
+        std::vector<ecs::entity_container> created(m_staged.size());
+        ecs::entity_container changed = newEntities;
+        ecs::entity_container modified;
+        byte_vec modifiedValues;
+        byte_vec createdValues;
+
+        for (size_type t = 0; t < m_staged.size(); t++)
+        {
+            auto& staged = m_staged[t];
+            const uint32 bit = 1u << t;
+            const size_type quantizedSize = types[t].quantizedSize;
+
+            modified.clear();
+            modifiedValues.clear();
+            createdValues.clear();
+
+            for (uint32 i : staged.applied)
+            {
+                remote_entity& remote = m_entities[staged.updates[i]];
+                const byte* value = staged.values.data() + i * quantizedSize;
+
+                if (remote.typeMask & bit)
+                {
+                    modified.emplace_back(remote.local);
+                    modifiedValues.insert(modifiedValues.end(), value, value + quantizedSize);
+                }
+                else
+                {
+                    remote.typeMask |= bit;
+                    created[t].emplace_back(remote.local);
+                    createdValues.insert(createdValues.end(), value, value + quantizedSize);
+                }
+            }
+
+            if (!m_registry)
+                continue;
+
+            if (!modified.empty() || !created[t].empty())
+                types[t].apply(*m_registry, modified, modifiedValues.data(), created[t], createdValues.data());
+
+            changed.insert(changed.end(), created[t].begin(), created[t].end());
+        }
+
+        if (m_registry && !changed.empty())
+        {
+            m_registry->updateQueries(changed);
+
+            if (!newEntities.empty())
+                m_registry->getFamily<hierarchy>()->raise_creation_events(newEntities);
+
+            for (size_type t = 0; t < created.size(); t++)
+                if (!created[t].empty())
+                    m_registry->getFamily(types[t].typeId)->raise_creation_events(created[t]);
+        }
+
+        for (size_type t = 0; t < m_staged.size(); t++)
+        {
+            const uint32 bit = 1u << t;
+            for (id_type entity : m_staged[t].appliedRemovals)
+            {
+                auto it = m_entities.find(entity);
+                if (it == m_entities.end() || !(it->second.typeMask & bit))
+                    continue;
+
+                remote_entity& remote = it->second;
+                remote.typeMask &= ~bit;
+
+                if (m_registry)
+                {
+                    if (remote.typeMask == 0)
+                        m_registry->destroyEntity(remote.local);
+                    else
+                        m_registry->destroyComponent(remote.local, types[t].typeId);
+                }
+
+                if (remote.typeMask == 0)
+                    m_entities.erase(it);
+            }
+        }
+    }
+}
@@ -0,0 +1,131 @@
+#pragma once
+#include <networking/transport/connection.hpp>
+#include <networking/replication/replication_registry.hpp>
+#include <networking/replication/replication_settings.hpp>
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file replication_client.hpp
+ * @brief Client side of the state replication. Received values are applied to the local registry in bulk, entities created
+ *        by the server get a local counterpart that is destroyed again once none of it's replicated components exist on the server anymore.
+ */
+
+namespace legion::networking
+{
+    /**@class ReplicationClient
+     * @brief Receiving end of the replication, mirrors the replicated components of a ReplicationServer.
+     */
+    class ReplicationClient
+    {
+    private:
+        enum struct client_state
+        {
+            disconnected, connecting, connected
+        };
+
+        /**@brief Last few values received for a single component, the server delta codes against any of these.
+         */
+        struct entity_history
+        {
+            uint32 slot = 0;
+            uint16 newest = 0;          // Most recent sequence a value was received in.
+            uint16 removedSequence = 0;
+            bool removed = false;       // Kept around for a while so late packets can't bring the component back.
+            uint8 count = 0;
+            std::array<uint16, baseline_window> sequences;
+        };
+
+        struct client_type_state
+        {
+            std::unordered_map<id_type, entity_history> entities;
+            byte_vec values; // baseline_window values for every slot.
+            std::vector<uint32> freeSlots;
+            uint32 slotCount = 0;
+            std::deque<std::pair<id_type, uint16>> removed;
+        };
+
+        /**@brief Contents of a packet of a single type, only committed once the entire packet decoded successfully.
+         */
+        struct staged_type
+        {
+            std::vector<id_type> removals;
+            std::vector<id_type> updates;
+            byte_vec values;
+            std::vector<uint32> applied;        // Indices of the updates that are newer than what the registry has.
+            std::vector<id_type> appliedRemovals;
+        };
+
+        struct remote_entity
+        {
+            id_type local;
+            uint32 typeMask; // Bit for every replicated type the entity has locally.
+        };
+
+        std::shared_ptr<transport> m_transport;
+        ecs::EcsRegistry* m_registry;
+        replication_settings m_settings;
+
+        client_state m_state = client_state::disconnected;
+        std::unique_ptr<connection> m_connection;
+        net_address m_server;
+        double m_connectStart = 0.0;
+        double m_lastRequest = 0.0;
+        size_type m_clientIndex = 0;
+        uint32 m_serverTick = 0;
+
+        std::vector<client_type_state> m_types;
+        std::vector<staged_type> m_staged;
+        std::unordered_map<id_type, remote_entity> m_entities;
+
+        byte_vec m_packet;
+        byte_vec m_receiveBuffer;
+        std::deque<byte_vec> m_messages;
+        replication_stats m_stats;
+
+        void send_packet(packet_type type, double now);
+        void handle_payload(bit_reader& reader, double now);
+        const byte* find_baseline(size_type typeIndex, id_type entity, uint16 sequence) const;
+        void commit(uint16 sequence);
+        void apply();
+        void reset();
+
+    public:
+        /**@brief Creates a disconnected client.
+         * @param transport Transport to connect over, nullptr to use UDP.
+         * @param registry Registry to apply the replicated state to, nullptr to only receive and acknowledge the state.
+         */
+        explicit ReplicationClient(std::shared_ptr<transport> transport = nullptr, ecs::EcsRegistry* registry = nullptr, const replication_settings& settings = {});
+        ~ReplicationClient();
+
+        ReplicationClient(const ReplicationClient&) = delete;
+        ReplicationClient& operator=(const ReplicationClient&) = delete;
+
+        /**@brief Starts connecting to a server, the connection is established during later calls to update.
+         * @param now Time in seconds, only used relative to later calls.
+         */
+        bool connect(const net_address& server, double now);
+
+        /**@brief Disconnects from the server and destroys all replicated entities.
+         */
+        void disconnect();
+
+        /**@brief Receives the state from the server, applies it to the registry and acknowledges it.
+         */
+        void update(double now);
+
+        bool send_message(const byte* data, size_type size);
+        bool receive_message(byte_vec& message);
+
+        L_NODISCARD bool connected() const noexcept { return m_state == client_state::connected; }
+        L_NODISCARD bool connecting() const noexcept { return m_state == client_state::connecting; }
+        L_NODISCARD size_type client_index() const noexcept { return m_clientIndex; }
+        L_NODISCARD uint32 server_tick() const noexcept { return m_serverTick; }
+        L_NODISCARD size_type entity_count() const noexcept { return m_entities.size(); }
+        L_NODISCARD const replication_stats& stats() const noexcept { return m_stats; }
+    };
+}
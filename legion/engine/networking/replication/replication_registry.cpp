@@ -0,0 +1,47 @@
+#include <networking/replication/replication_registry.hpp>
+
+#include <algorithm>
+
+namespace legion::networking
+{
+    std::vector<replicated_type> ReplicationRegistry::m_types;
+
+    void ReplicationRegistry::insert(replicated_type&& type)
+    {
+        auto it = std::lower_bound(m_types.begin(), m_types.end(), type.typeId,
+            [](const replicated_type& lhs, id_type rhs) { return lhs.typeId < rhs; });
+
+        if (it != m_types.end() && it->typeId == type.typeId)
+        {
+            *it = std::move(type); // Re-reporting replaces the codec.
+            return;
+        }
+
+        if (m_types.size() >= max_replicated_types)
+        {
+            log::error("Can't replicate {}, at most {} component types can be replicated.", type.name, max_replicated_types);
+            return;
+        }
+
+        m_types.insert(it, std::move(type));
+    }
+
+    size_type ReplicationRegistry::indexOf(id_type typeId) noexcept
+    {
+        for (size_type i = 0; i < m_types.size(); i++)
+            if (m_types[i].typeId == typeId)
+                return i;
+        return max_replicated_types;
+    }
+
+    uint64 ReplicationRegistry::layoutHash() noexcept
+    {
+        uint64 hash = 0xcbf29ce484222325;
+        for (auto& type : m_types)
+        {
+            hash ^= static_cast<uint64>(type.typeId) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+            hash ^= static_cast<uint64>(type.quantizedSize) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2);
+        }
+        return hash;
+    }
+}
@@ -0,0 +1,200 @@
+#pragma once
+#include <core/core.hpp>
+#include <networking/data/bitstream.hpp>
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @file replication_registry.hpp
+ * @brief Registry of the component types that get replicated from the server to the clients.
+ *        Every replicated type is described by a codec:
+ * @code
+ * struct my_codec
+ * {
+ *     using component_type = my_component;
+ *     using quantized_type = ...; // Trivially copyable, compared bitwise to detect changes.
+ *     static void quantize(const component_type& value, quantized_type& out);
+ *     static void dequantize(const quantized_type& value, component_type& out);
+ *     static void write(bit_writer& writer, const quantized_type& value, const quantized_type* baseline);
+ *     static void read(bit_reader& reader, quantized_type& value, const quantized_type* baseline);
+ * };
+ * @endcode
+ *        The baseline is the last value the client acknowledged, or nullptr if the client doesn't have the component yet.
+ */
+
+namespace legion::networking
+{
+    /**@brief Maximum amount of replicated component types.
+     */
+    constexpr size_type max_replicated_types = 32;
+
+    /**@class replicated_type
+     * @brief Type erased operations of a replicated component type, generated from it's codec.
+     */
+    struct replicated_type
+    {
+        id_type typeId;
+        std::string name;
+        size_type componentSize;
+        size_type quantizedSize;
+
+        /**@brief Takes a snapshot of the component pool, see legion::core::ecs::component_pool_base::take_snapshot.
+         */
+        std::shared_ptr<const ecs::pool_snapshot>(*snapshot)(ecs::EcsRegistry& registry, const std::shared_ptr<const ecs::pool_snapshot>& base);
+
+        /**@brief Quantizes a tightly packed array of components into a tightly packed array of quantized values.
+         */
+        void(*quantize)(const byte* components, size_type count, byte* quantized);
+
+        void(*write)(bit_writer& writer, const byte* quantized, const byte* baseline);
+        void(*read)(bit_reader& reader, byte* quantized, const byte* baseline);
+
+        /**@brief Applies received values to the local components, modifies existing components in bulk and inserts new ones in bulk.
+         * @note Inserted components are registered with the entities but queries aren't updated and no creation events are raised,
+         *       see legion::core::ecs::EcsRegistry::registerComponents.
+         */
+        void(*apply)(ecs::EcsRegistry& registry, const ecs::entity_container& modified, const byte* modifiedValues,
+            const ecs::entity_container& created, const byte* createdValues);
+    };
+
+    namespace detail
+    {
+        template<typename codec_type>
+        struct replicated_operations
+        {
+            using component_type = typename codec_type::component_type;
+            using quantized_type = typename codec_type::quantized_type;
+
+            static_assert(std::is_trivially_copyable_v<component_type>, "Replicated components need to be trivially copyable.");
+            static_assert(std::is_trivially_copyable_v<quantized_type>, "Quantized values need to be trivially copyable.");
+
+            static std::shared_ptr<const ecs::pool_snapshot> snapshot(ecs::EcsRegistry& registry, const std::shared_ptr<const ecs::pool_snapshot>& base)
+            {
+                return registry.getFamily<component_type>()->take_snapshot(base);
+            }
+
+            static void quantize(const byte* components, size_type count, byte* quantized)
+            {
+                for (size_type i = 0; i < count; i++)
+                {
+                    component_type component;
+                    std::memcpy(&component, components + i * sizeof(component_type), sizeof(component_type));
+
+                    quantized_type value{};
+                    codec_type::quantize(component, value);
+                    std::memcpy(quantized + i * sizeof(quantized_type), &value, sizeof(quantized_type));
+                }
+            }
+
+            static void write(bit_writer& writer, const byte* quantized, const byte* baseline)
+            {
+                quantized_type value;
+                std::memcpy(&value, quantized, sizeof(quantized_type));
+
+                if (baseline)
+                {
+                    quantized_type base;
+                    std::memcpy(&base, baseline, sizeof(quantized_type));
+                    codec_type::write(writer, value, &base);
+                }
+                else
+                    codec_type::write(writer, value, nullptr);
+            }
+
+            static void read(bit_reader& reader, byte* quantized, const byte* baseline)
+            {
+                quantized_type value{};
+                if (baseline)
+                {
+                    quantized_type base;
+                    std::memcpy(&base, baseline, sizeof(quantized_type));
+                    codec_type::read(reader, value, &base);
+                }
+                else
+                    codec_type::read(reader, value, nullptr);
+
+                std::memcpy(quantized, &value, sizeof(quantized_type));
+            }
+
+            static void dequantize_all(const byte* quantized, size_type count, ecs::component_container<component_type>& components)
+            {
+                components.resize(count);
+                for (size_type i = 0; i < count; i++)
+                {
+                    quantized_type value;
+                    std::memcpy(&value, quantized + i * sizeof(quantized_type), sizeof(quantized_type));
+                    codec_type::dequantize(value, components[i]);
+                }
+            }
+
+            static void apply(ecs::EcsRegistry& registry, const ecs::entity_container& modified, const byte* modifiedValues,
+                const ecs::entity_container& created, const byte* createdValues)
+            {
+                auto* family = registry.getFamily<component_type>();
+                ecs::component_container<component_type> components;
+
+                if (!modified.empty())
+                {
+                    dequantize_all(modifiedValues, modified.size(), components);
+                    family->set_components(modified, components);
+                }
+
+                if (!created.empty())
+                {
+                    dequantize_all(createdValues, created.size(), components);
+                    family->insert_components(created, components);
+                    registry.registerComponents(typeHash<component_type>(), created);
+                }
+            }
+        };
+    }
+
+    /**@class ReplicationRegistry
+     * @brief Keeps track of all replicated component types. Server and client need to report the same set of types.
+     *        Types are ordered by type id, so the index of a type is the same on both ends regardless of the order they got reported in.
+     */
+    class ReplicationRegistry
+    {
+    private:
+        static std::vector<replicated_type> m_types;
+
+        static void insert(replicated_type&& type);
+
+    public:
+        /**@brief Reports a component type for replication.
+         * @tparam codec_type Codec describing how the component gets quantized and encoded, see replication_registry.hpp.
+         */
+        template<typename codec_type>
+        static void reportType()
+        {
+            using operations = detail::replicated_operations<codec_type>;
+            using component_type = typename codec_type::component_type;
+
+            replicated_type type;
+            type.typeId = typeHash<component_type>();
+            type.name = std::string(nameOfType<component_type>());
+            type.componentSize = sizeof(component_type);
+            type.quantizedSize = sizeof(typename codec_type::quantized_type);
+            type.snapshot = &operations::snapshot;
+            type.quantize = &operations::quantize;
+            type.write = &operations::write;
+            type.read = &operations::read;
+            type.apply = &operations::apply;
+            insert(std::move(type));
+        }
+
+        L_NODISCARD static const std::vector<replicated_type>& types() noexcept { return m_types; }
+
+        /**@brief Index of a type in the wire format.
+         * @returns size_type The index, max_replicated_types if the type isn't replicated.
+         */
+        L_NODISCARD static size_type indexOf(id_type typeId) noexcept;
+
+        /**@brief Hash of the set of replicated types, clients with a different set can't connect.
+         */
+        L_NODISCARD static uint64 layoutHash() noexcept;
+    };
+}
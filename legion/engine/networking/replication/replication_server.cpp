@@ -0,0 +1,692 @@
+#include <networking/replication/replication_server.hpp>
+#include <networking/transport/udp_transport.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+namespace legion::networking
+{
+    namespace
+    {
+        // Upper bound of the size of a single entry, used to guarantee an entry still fits in the packet before writing it.
+        // Entity id difference, flags and baseline offset, plus codecs never need more than twice the quantized size.
+        constexpr size_type entry_overhead = 16;
+    }
+
+    ReplicationServer::ReplicationServer(std::shared_ptr<transport> transport, const replication_settings& settings)
+        : m_transport(transport ? std::move(transport) : std::make_shared<udp_transport>()), m_settings(settings)
+    {
+        m_settings.packetBudget = std::min(m_settings.packetBudget, max_packet_size);
+    }
+
+    ReplicationServer::~ReplicationServer()
+    {
+        stop();
+    }
+
+    bool ReplicationServer::start(uint16 port)
+    {
+        if (m_running)
+            return true;
+
+        if (!m_transport->open(port))
+        {
+            log::error("Replication server failed to listen on port {}.", port);
+            return false;
+        }
+
+        m_clients.clear();
+        m_clients.resize(m_settings.maxClients);
+        m_clientIndices.clear();
+        m_frames.clear();
+
+        m_positionType = max_replicated_types;
+        if (m_settings.relevancy.enabled)
+        {
+            m_positionType = ReplicationRegistry::indexOf(typeHash<position>());
+            if (m_positionType == max_replicated_types)
+                log::warn("Relevancy is disabled, positions aren't replicated.");
+        }
+        m_relevancy.reset(m_settings.relevancy.cellSize, m_settings.maxClients);
+
+        m_running = true;
+        log::info("Replication server listening on {}.", m_transport->local_address().to_string());
+        return true;
+    }
+
+    void ReplicationServer::stop()
+    {
+        if (!m_running)
+            return;
+
+        for (size_type i = 0; i < m_clients.size(); i++)
+            if (m_clients[i])
+                drop_client(i, true);
+
+        m_transport->close();
+        m_running = false;
+    }
+
+    void ReplicationServer::update(ecs::EcsRegistry& registry, double now)
+    {
+        OPTICK_EVENT();
+        if (!m_running)
+            return;
+
+        receive_packets(now);
+
+        for (size_type i = 0; i < m_clients.size(); i++)
+            if (m_clients[i] && m_clients[i]->conn->timed_out(now, m_settings.timeout))
+            {
+                log::info("Client {} timed out.", m_clients[i]->conn->address().to_string());
+                drop_client(i, false);
+            }
+
+        m_tick++;
+        m_stats.ticks++;
+
+        if (m_clientIndices.empty())
+            return;
+
+        build_frames(registry);
+
+        for (auto& target : m_clients)
+            if (target)
+            {
+                process_acks(*target);
+                send_state(*target, now);
+            }
+    }
+
+    bool ReplicationServer::send_message(size_type clientIndex, const byte* data, size_type size)
+    {
+        if (clientIndex >= m_clients.size() || !m_clients[clientIndex])
+        {
+            log::warn("Can't send a message to client {}, it isn't connected.", clientIndex);
+            return false;
+        }
+
+        return m_clients[clientIndex]->conn->send_reliable(data, size);
+    }
+
+    bool ReplicationServer::receive_message(size_type& clientIndex, byte_vec& message)
+    {
+        if (m_messages.empty())
+            return false;
+
+        clientIndex = m_messages.front().first;
+        message = std::move(m_messages.front().second);
+        m_messages.pop_front();
+        return true;
+    }
+
+    void ReplicationServer::set_observer(size_type clientIndex, const math::vec3& position, float radius)
+    {
+        if (clientIndex >= m_clients.size() || !m_clients[clientIndex])
+        {
+            log::warn("Can't place the observer of client {}, it isn't connected.", clientIndex);
+            return;
+        }
+
+        m_relevancy.set_observer(clientIndex, position, radius > 0.f ? radius : m_settings.relevancy.radius);
+    }
+
+    void ReplicationServer::follow_entity(size_type clientIndex, id_type entity, float radius)
+    {
+        if (clientIndex >= m_clients.size() || !m_clients[clientIndex])
+        {
+            log::warn("Can't place the observer of client {}, it isn't connected.", clientIndex);
+            return;
+        }
+
+        m_relevancy.follow_entity(clientIndex, entity, radius > 0.f ? radius : m_settings.relevancy.radius);
+    }
+
+    void ReplicationServer::receive_packets(double now)
+    {
+        net_address source;
+        while (m_transport->receive(source, m_receiveBuffer))
+        {
+            m_stats.packetsReceived++;
+            m_stats.bytesReceived += m_receiveBuffer.size();
+
+            bit_reader reader(m_receiveBuffer.data(), m_receiveBuffer.size());
+            packet_type type;
+            if (!read_packet_prefix(reader, type))
+                continue;
+
+            if (type == packet_type::connect_request)
+            {
+                handle_connect(source, reader, now);
+                continue;
+            }
+
+            auto it = m_clientIndices.find(source);
+            if (it == m_clientIndices.end())
+                continue;
+
+            const size_type index = it->second;
+            if (type == packet_type::disconnect)
+            {
+                log::info("Client {} disconnected.", source.to_string());
+                drop_client(index, false);
+                continue;
+            }
+
+            if (type != packet_type::payload)
+                continue;
+
+            connection& conn = *m_clients[index]->conn;
+            uint16 sequence;
+            if (!conn.read_header(reader, now, sequence))
+                continue;
+
+            conn.acknowledge(sequence);
+
+            byte_vec message;
+            while (conn.receive_reliable(message))
+                m_messages.emplace_back(index, std::move(message));
+        }
+    }
+
+    void ReplicationServer::handle_connect(const net_address& source, bit_reader& reader, double now)
+    {
+        const uint64 layout = reader.read_uint64();
+        if (reader.overflowed())
+            return;
+
+        if (layout != ReplicationRegistry::layoutHash())
+        {
+            log::warn("Rejected client {}, it replicates a different set of component types.", source.to_string());
+            send_control(source, packet_type::connect_reject, 0);
+            return;
+        }
+
+        if (auto it = m_clientIndices.find(source); it != m_clientIndices.end())
+        {
+            send_control(source, packet_type::connect_accept, static_cast<uint32>(it->second)); // The accept got lost.
+            return;
+        }
+
+        auto freeSlot = std::find(m_clients.begin(), m_clients.end(), nullptr);
+        if (freeSlot == m_clients.end())
+        {
+            log::warn("Rejected client {}, the server is full.", source.to_string());
+            send_control(source, packet_type::connect_reject, 1);
+            return;
+        }
+
+        const size_type index = static_cast<size_type>(freeSlot - m_clients.begin());
+        auto newClient = std::make_unique<client>();
+        newClient->index = index;
+        newClient->conn = std::make_unique<connection>(source, now);
+        newClient->types.resize(ReplicationRegistry::types().size());
+        *freeSlot = std::move(newClient);
+        m_clientIndices.emplace(source, index);
+
+        log::info("Client {} connected from {}.", index, source.to_string());
+        send_control(source, packet_type::connect_accept, static_cast<uint32>(index));
+    }
+
+    void ReplicationServer::send_control(const net_address& destination, packet_type type, uint32 value)
+    {
+        m_packet.clear();
+        bit_writer writer(m_packet);
+        write_packet_prefix(writer, type);
+        writer.write_varint(value);
+        writer.flush();
+
+        m_transport->send(destination, m_packet.data(), m_packet.size());
+        m_stats.packetsSent++;
+        m_stats.bytesSent += m_packet.size();
+    }
+
+    void ReplicationServer::drop_client(size_type index, bool notify)
+    {
+        auto& target = m_clients[index];
+        if (!target)
+            return;
+
+        if (notify)
+            send_control(target->conn->address(), packet_type::disconnect, 0);
+
+        m_clientIndices.erase(target->conn->address());
+        m_relevancy.remove_observer(index);
+        target.reset();
+    }
+
+    void ReplicationServer::build_frames(ecs::EcsRegistry& registry)
+    {
+        OPTICK_EVENT();
+        auto& types = ReplicationRegistry::types();
+        m_frames.resize(types.size());
+
+        uint32 changed = 0;
+        for (size_type t = 0; t < types.size(); t++)
+        {
+            auto& type = types[t];
+            auto& frame = m_frames[t];
+
+            auto snapshot = type.snapshot(registry, frame.snapshot);
+            if (snapshot == frame.snapshot)
+                continue; // Pool didn't change since last tick.
+
+            changed |= 1u << t;
+
+            frame.snapshot = snapshot;
+            frame.version = snapshot->version;
+
+            const size_type count = snapshot->entities.size();
+            const size_type quantizedSize = type.quantizedSize;
+            m_quantized.resize(count * quantizedSize);
+            if (count)
+                type.quantize(snapshot->data.data(), count, m_quantized.data());
+
+            // Sorted order lets the entity ids be sent as small differences.
+            m_order.resize(count);
+            std::iota(m_order.begin(), m_order.end(), 0u);
+            std::sort(m_order.begin(), m_order.end(), [&](uint32 lhs, uint32 rhs) { return snapshot->entities[lhs] < snapshot->entities[rhs]; });
+
+            frame.entities.resize(count);
+            frame.values.resize(count * quantizedSize);
+            for (size_type i = 0; i < count; i++)
+            {
+                frame.entities[i] = snapshot->entities[m_order[i]];
+                std::memcpy(frame.values.data() + i * quantizedSize, m_quantized.data() + m_order[i] * quantizedSize, quantizedSize);
+            }
+
+            if (t == m_positionType)
+            {
+                m_positions.resize(count);
+                for (size_type i = 0; i < count; i++)
+                {
+                    position value;
+                    std::memcpy(&value, snapshot->data.data() + m_order[i] * type.componentSize, sizeof(position));
+                    m_positions[i] = value;
+                }
+
+                m_relevancy.update(frame.entities, m_positions);
+            }
+        }
+
+        if (m_positionType == max_replicated_types || !changed)
+            return;
+
+        // Which entities have a position only changes when either the position pool or the type's own pool changed.
+        const bool positionsChanged = changed & (1u << m_positionType);
+        for (size_type t = 0; t < types.size(); t++)
+            if (t != m_positionType && (positionsChanged || (changed & (1u << t))))
+                find_globals(m_frames[t]);
+    }
+
+    void ReplicationServer::find_globals(type_frame& frame)
+    {
+        auto& filtered = m_relevancy.entities();
+        frame.globals.clear();
+
+        // Both lists are sorted by id.
+        size_type j = 0;
+        for (size_type i = 0; i < frame.entities.size(); i++)
+        {
+            while (j < filtered.size() && filtered[j] < frame.entities[i])
+                j++;
+
+            if (j == filtered.size() || filtered[j] != frame.entities[i])
+                frame.globals.push_back(static_cast<uint32>(i));
+        }
+    }
+
+    void ReplicationServer::process_acks(client& target)
+    {
+        target.conn->take_acked_packets(target.acked);
+        for (uint16 sequence : target.acked)
+            forget_packet(target, sequence, true);
+
+        target.conn->take_lost_packets(target.lost);
+        for (uint16 sequence : target.lost)
+            forget_packet(target, sequence, false);
+    }
+
+    void ReplicationServer::forget_packet(client& target, uint16 sequence, bool acked)
+    {
+        sent_packet* packet = target.sentPackets.find(sequence);
+        if (!packet)
+            return;
+
+        auto& types = ReplicationRegistry::types();
+        for (auto& entry : packet->entries)
+        {
+            auto& state = target.types[entry.typeIndex];
+            auto it = state.slots.find(entry.entity);
+            if (it == state.slots.end())
+                continue;
+
+            const uint32 slot = it->second;
+            entity_state& entity = state.states[slot];
+            if (sequence_less_than(sequence, entity.since))
+                continue; // Sent before the component was removed and created again.
+
+            if (entry.removal)
+            {
+                if (!entity.removing || entity.removalSequence != sequence)
+                    continue;
+
+                if (acked)
+                    free_slot(state, slot);
+                else
+                    entity.removalInFlight = false;
+                continue;
+            }
+
+            if (entity.pending)
+                entity.pending--;
+
+            if (entity.sentSequence == sequence)
+                entity.inFlight = false;
+
+            if (acked && (!entity.acked || sequence_greater_than(sequence, entity.ackedSequence)))
+            {
+                const size_type quantizedSize = types[entry.typeIndex].quantizedSize;
+                std::memcpy(state.ackedValues.data() + slot * quantizedSize, packet->values.data() + entry.valueOffset, quantizedSize);
+                entity.ackedSequence = sequence;
+                entity.acked = true;
+            }
+        }
+
+        target.sentPackets.remove(sequence);
+    }
+
+    uint32 ReplicationServer::claim_slot(client_type_state& state, id_type entity, uint16 sequence, size_type quantizedSize)
+    {
+        uint32 slot;
+        if (!state.freeSlots.empty())
+        {
+            slot = state.freeSlots.back();
+            state.freeSlots.pop_back();
+        }
+        else
+        {
+            slot = static_cast<uint32>(state.states.size());
+            state.states.emplace_back();
+            state.ackedValues.resize(state.states.size() * quantizedSize);
+            state.sentValues.resize(state.states.size() * quantizedSize);
+        }
+
+        entity_state& entityState = state.states[slot];
+        entityState = entity_state();
+        entityState.entity = entity;
+        entityState.lastSeen = m_tick;
+        entityState.since = sequence;
+        state.slots.emplace(entity, slot);
+        return slot;
+    }
+
+    void ReplicationServer::free_slot(client_type_state& state, uint32 slot)
+    {
+        state.slots.erase(state.states[slot].entity);
+        state.states[slot].entity = invalid_id;
+        state.freeSlots.push_back(slot);
+    }
+
+    void ReplicationServer::send_state(client& target, double now)
+    {
+        OPTICK_EVENT();
+        auto& types = ReplicationRegistry::types();
+        connection& conn = *target.conn;
+
+        m_packet.clear();
+        bit_writer writer(m_packet);
+        write_packet_prefix(writer, packet_type::payload);
+        const uint16 sequence = conn.write_header(writer, now);
+        writer.write_bits(m_tick, 32);
+
+        // The record of the packet sent a full window ago gets overwritten, it will never be acknowledged anymore.
+        const uint16 evicted = static_cast<uint16>(sequence - connection::packet_window);
+        if (target.sentPackets.contains(evicted))
+            forget_packet(target, evicted, false);
+
+        sent_packet& record = target.sentPackets.insert(sequence);
+        const size_type budget = m_settings.packetBudget - 1; // Keep room for the section terminator.
+        bool full = false;
+
+        const bool filtered = m_positionType != max_replicated_types;
+        relevant_set* relevant = nullptr;
+        if (filtered)
+        {
+            relevant = &m_relevancy.relevant(target.index);
+            if (target.relevancyVersion != m_relevancy.version(target.index))
+            {
+                // Entities entered or left, every type needs to be looked at again even if the frame didn't change.
+                target.relevancyVersion = m_relevancy.version(target.index);
+                for (auto& state : target.types)
+                    state.syncedVersion = 0;
+            }
+
+            m_relevancy.accumulate(target.index, m_settings.relevancy);
+            m_written.clear();
+        }
+
+        const size_type typeCount = types.size();
+        for (size_type k = 0; k < typeCount; k++)
+        {
+            // Rotate which type goes first so a single busy type can't starve the others.
+            const size_type t = (m_tick + k) % typeCount;
+            auto& type = types[t];
+            auto& frame = m_frames[t];
+            auto& state = target.types[t];
+            const size_type quantizedSize = type.quantizedSize;
+
+            if (state.syncedVersion == frame.version)
+                continue;
+
+            // Find everything that differs from what the client acknowledged.
+            m_candidates.clear();
+            size_type differences = 0;
+            size_type updateCount = 0;
+            auto consider = [&](uint32 i, relevance* entityRelevance)
+            {
+                // Entities that aren't due yet still count as a difference, so the type isn't considered synced.
+                const bool due = !entityRelevance || entityRelevance->priority >= 1.f;
+                const byte* value = frame.values.data() + i * quantizedSize;
+                auto it = state.slots.find(frame.entities[i]);
+                if (it == state.slots.end())
+                {
+                    differences++;
+                    if (due)
+                        m_candidates.push_back({ i, false, entityRelevance });
+                    return;
+                }
+
+                const uint32 slot = it->second;
+                entity_state& entity = state.states[slot];
+                entity.lastSeen = m_tick;
+
+                if (entity.removing) // Removed and created again, the client may or may not have removed it by now.
+                    entity = entity_state{ entity.entity, m_tick, sequence };
+
+                if (entity.acked && std::memcmp(state.ackedValues.data() + slot * quantizedSize, value, quantizedSize) == 0)
+                    return;
+
+                differences++;
+                if (entity.inFlight && std::memcmp(state.sentValues.data() + slot * quantizedSize, value, quantizedSize) == 0)
+                    return; // Same value is still on it's way.
+
+                if (due)
+                    m_candidates.push_back({ i, false, entityRelevance });
+                else
+                    m_stats.updatesThrottled++;
+            };
+
+            if (filtered)
+            {
+                // Only the relevant entities are looked at, entities that aren't relevant anymore get removed below.
+                for (auto& [entityId, entityRelevance] : *relevant)
+                {
+                    auto it = std::lower_bound(frame.entities.begin(), frame.entities.end(), entityId);
+                    if (it != frame.entities.end() && *it == entityId)
+                        consider(static_cast<uint32>(it - frame.entities.begin()), &entityRelevance);
+                }
+
+                for (uint32 i : frame.globals)
+                    consider(i, nullptr);
+
+                // Most overdue first, entities without relevancy are always due.
+                std::sort(m_candidates.begin(), m_candidates.end(), [](const candidate& lhs, const candidate& rhs)
+                    {
+                        const float lhsPriority = lhs.relevant ? lhs.relevant->priority : std::numeric_limits<float>::max();
+                        const float rhsPriority = rhs.relevant ? rhs.relevant->priority : std::numeric_limits<float>::max();
+                        return lhsPriority > rhsPriority;
+                    });
+            }
+            else
+            {
+                for (size_type i = 0; i < frame.entities.size(); i++)
+                    consider(static_cast<uint32>(i), nullptr);
+            }
+            updateCount = m_candidates.size();
+
+            for (size_type slot = 0; slot < state.states.size(); slot++)
+            {
+                entity_state& entity = state.states[slot];
+                if (entity.entity == invalid_id)
+                    continue;
+
+                if (entity.lastSeen != m_tick && !entity.removing)
+                {
+                    entity.removing = true;
+                    entity.removalInFlight = false;
+                }
+
+                if (!entity.removing)
+                    continue;
+
+                differences++;
+                if (!entity.removalInFlight)
+                    m_candidates.push_back({ static_cast<uint32>(slot), true, nullptr });
+            }
+
+            if (differences == 0)
+            {
+                state.syncedVersion = frame.version;
+                continue;
+            }
+
+            if (m_candidates.empty())
+                continue;
+
+            const size_type entrySize = entry_overhead + quantizedSize * 2;
+            if (full || writer.bytes_written() + entrySize + 2 > budget)
+            {
+                full = true;
+                m_stats.updatesDeferred += m_candidates.size();
+                continue;
+            }
+
+            writer.write_varint(t + 1);
+
+            // Removals.
+            id_type previous = 0;
+            size_type written = 0;
+            for (size_type i = updateCount; i < m_candidates.size(); i++)
+            {
+                if (writer.bytes_written() + entry_overhead + 2 > budget)
+                {
+                    full = true;
+                    break;
+                }
+
+                entity_state& entity = state.states[m_candidates[i].frameIndex];
+                writer.write_bool(true);
+                writer.write_signed(static_cast<int64>(entity.entity) - static_cast<int64>(previous));
+                previous = entity.entity;
+
+                entity.removalInFlight = true;
+                entity.removalSequence = sequence;
+                record.entries.push_back({ entity.entity, 0, static_cast<uint8>(t), true });
+                written++;
+            }
+            writer.write_bool(false);
+
+            // Updates, continuing where the last packet ran out of room. With relevancy the candidates are in priority order instead.
+            size_type startIndex = 0;
+            if (!filtered)
+            {
+                auto start = std::lower_bound(m_candidates.begin(), m_candidates.begin() + updateCount, state.cursor,
+                    [&](const candidate& lhs, id_type rhs) { return frame.entities[lhs.frameIndex] < rhs; });
+                startIndex = static_cast<size_type>(start - m_candidates.begin());
+            }
+
+            previous = 0;
+            size_type updatesWritten = 0;
+            for (; updatesWritten < updateCount; updatesWritten++)
+            {
+                const candidate& next = m_candidates[(startIndex + updatesWritten) % updateCount];
+                const id_type entityId = frame.entities[next.frameIndex];
+
+                if (full || writer.bytes_written() + entrySize + 1 > budget)
+                {
+                    full = true;
+                    state.cursor = entityId;
+                    break;
+                }
+
+                auto it = state.slots.find(entityId);
+                const uint32 slot = it != state.slots.end() ? it->second : claim_slot(state, entityId, sequence, quantizedSize);
+                entity_state& entity = state.states[slot];
+                const byte* value = frame.values.data() + next.frameIndex * quantizedSize;
+
+                writer.write_bool(true);
+                writer.write_signed(static_cast<int64>(entityId) - static_cast<int64>(previous));
+                previous = entityId;
+
+                // Only delta code if the client is guaranteed to still have the acknowledged value.
+                if (entity.acked && entity.pending < baseline_window)
+                {
+                    writer.write_bool(true);
+                    writer.write_varint(static_cast<uint16>(sequence - entity.ackedSequence));
+                    type.write(writer, value, state.ackedValues.data() + slot * quantizedSize);
+                }
+                else
+                {
+                    writer.write_bool(false);
+                    type.write(writer, value, nullptr);
+                }
+
+                record.entries.push_back({ entityId, static_cast<uint32>(record.values.size()), static_cast<uint8>(t), false });
+                record.values.insert(record.values.end(), value, value + quantizedSize);
+
+                std::memcpy(state.sentValues.data() + slot * quantizedSize, value, quantizedSize);
+                entity.sentSequence = sequence;
+                entity.inFlight = true;
+                if (entity.pending < 255)
+                    entity.pending++;
+
+                if (next.relevant)
+                    m_written.push_back(next.relevant);
+            }
+            writer.write_bool(false);
+
+            if (updatesWritten == updateCount)
+                state.cursor = 0;
+
+            written += updatesWritten;
+            m_stats.updatesWritten += written;
+            m_stats.updatesDeferred += m_candidates.size() - written;
+        }
+
+        writer.write_varint(0);
+        writer.flush();
+
+        // Priorities are only reset after all types are written, so every type of an entity that is due gets sent in the same packet.
+        for (relevance* written : m_written)
+            written->priority = 0.f;
+
+        if (m_transport->send(conn.address(), m_packet.data(), m_packet.size()))
+        {
+            m_stats.packetsSent++;
+            m_stats.bytesSent += m_packet.size();
+        }
+    }
+}
@@ -0,0 +1,192 @@
+#pragma once
+#include <networking/transport/connection.hpp>
+#include <networking/replication/replication_registry.hpp>
+#include <networking/replication/replication_settings.hpp>
+#include <networking/replication/relevancy_grid.hpp>
+
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file replication_server.hpp
+ * @brief Server side of the state replication.
+ *        Every tick the server takes a snapshot of each replicated component pool and quantizes it once for all clients.
+ *        For every client it then compares the quantized values against the last value that client acknowledged and writes
+ *        the differences into a single packet, delta coded against the acknowledged value where the client is known to still have it.
+ *        Packets are unreliable, anything that gets lost simply stays different from the acknowledged value and gets sent again.
+ *        With relevancy enabled clients only get the entities around their observer, closest and most overdue entities first.
+ */
+
+namespace legion::networking
+{
+    /**@class ReplicationServer
+     * @brief Authoritative end of the replication, sends the state of all types in the ReplicationRegistry to it's clients.
+     */
+    class ReplicationServer
+    {
+    private:
+        /**@brief Quantized state of a single replicated type this tick, shared by all clients.
+         */
+        struct type_frame
+        {
+            std::shared_ptr<const ecs::pool_snapshot> snapshot;
+            uint64 version = 0;
+            std::vector<id_type> entities; // Sorted by id.
+            byte_vec values;               // Quantized values in the same order as entities.
+            std::vector<uint32> globals;   // Indices of the entities without a replicated position, these are relevant to every client.
+        };
+
+        /**@brief What a client is known to have of a single component.
+         */
+        struct entity_state
+        {
+            id_type entity = invalid_id; // invalid_id if the slot is free.
+            uint32 lastSeen = 0;         // Tick the component was last found in the frame.
+            uint16 since = 0;            // Packets older than this were sent before the component was (re)created.
+            uint16 ackedSequence = 0;
+            uint16 sentSequence = 0;
+            uint16 removalSequence = 0;
+            uint8 pending = 0;           // Updates sent after the acknowledged one that were neither acknowledged nor lost yet.
+            bool acked = false;          // Whether the client has received any value.
+            bool inFlight = false;       // Whether the last sent value might still arrive.
+            bool removing = false;
+            bool removalInFlight = false;
+        };
+
+        struct client_type_state
+        {
+            std::unordered_map<id_type, uint32> slots;
+            std::vector<entity_state> states;
+            byte_vec ackedValues;
+            byte_vec sentValues;
+            std::vector<uint32> freeSlots;
+            uint64 syncedVersion = 0; // Frame version the client is known to fully have.
+            id_type cursor = 0;       // Entity to continue from when the last packet ran out of budget.
+        };
+
+        struct sent_entry
+        {
+            id_type entity;
+            uint32 valueOffset;
+            uint8 typeIndex;
+            bool removal;
+        };
+
+        struct sent_packet
+        {
+            std::vector<sent_entry> entries;
+            byte_vec values;
+        };
+
+        struct client
+        {
+            size_type index;
+            std::unique_ptr<connection> conn;
+            std::vector<client_type_state> types;
+            sequence_buffer<sent_packet, connection::packet_window> sentPackets;
+            std::vector<uint16> acked;
+            std::vector<uint16> lost;
+            uint64 relevancyVersion = 0;
+        };
+
+        struct candidate
+        {
+            uint32 frameIndex; // Index into the frame, or the slot for removals.
+            bool removal;
+            relevance* relevant; // nullptr if the entity isn't filtered by relevancy.
+        };
+
+        std::shared_ptr<transport> m_transport;
+        replication_settings m_settings;
+
+        std::vector<std::unique_ptr<client>> m_clients;
+        std::unordered_map<net_address, size_type> m_clientIndices;
+
+        std::vector<type_frame> m_frames;
+        std::vector<uint32> m_order;
+        byte_vec m_quantized;
+        std::vector<candidate> m_candidates;
+        std::vector<relevance*> m_written;
+        byte_vec m_packet;
+        byte_vec m_receiveBuffer;
+
+        std::deque<std::pair<size_type, byte_vec>> m_messages;
+
+        RelevancyGrid m_relevancy;
+        size_type m_positionType = max_replicated_types; // Index of the position type if relevancy is enabled.
+        std::vector<math::vec3> m_positions;
+
+        uint32 m_tick = 0;
+        bool m_running = false;
+        replication_stats m_stats;
+
+        void receive_packets(double now);
+        void handle_connect(const net_address& source, bit_reader& reader, double now);
+        void send_control(const net_address& destination, packet_type type, uint32 value);
+        void drop_client(size_type index, bool notify);
+
+        void build_frames(ecs::EcsRegistry& registry);
+        void find_globals(type_frame& frame);
+        void process_acks(client& target);
+        void forget_packet(client& target, uint16 sequence, bool acked);
+        void send_state(client& target, double now);
+
+        uint32 claim_slot(client_type_state& state, id_type entity, uint16 sequence, size_type quantizedSize);
+        void free_slot(client_type_state& state, uint32 slot);
+
+    public:
+        /**@brief Creates a server that isn't listening yet.
+         * @param transport Transport to listen on, nullptr to use UDP.
+         */
+        explicit ReplicationServer(std::shared_ptr<transport> transport = nullptr, const replication_settings& settings = {});
+        ~ReplicationServer();
+
+        ReplicationServer(const ReplicationServer&) = delete;
+        ReplicationServer& operator=(const ReplicationServer&) = delete;
+
+        /**@brief Starts listening for clients.
+         * @param port Port to listen on, 0 to let the transport pick one.
+         */
+        bool start(uint16 port);
+
+        /**@brief Disconnects all clients and stops listening.
+         */
+        void stop();
+
+        /**@brief Receives incoming packets and sends the current state of the registry to all clients.
+         * @param now Time in seconds, only used relative to earlier calls.
+         */
+        void update(ecs::EcsRegistry& registry, double now);
+
+        /**@brief Queues a message that is guaranteed to arrive in order.
+         * @param clientIndex Index of the client as passed to receive_message.
+         */
+        bool send_message(size_type clientIndex, const byte* data, size_type size);
+
+        /**@brief Pops the next reliable message any client sent.
+         * @param clientIndex [out] Index of the client that sent the message.
+         */
+        bool receive_message(size_type& clientIndex, byte_vec& message);
+
+        /**@brief Places the observer of a client, only entities around the observer get replicated to it when relevancy is enabled.
+         *        Until a client has an observer it only receives entities without a replicated position.
+         * @param radius Radius around the position in which entities are relevant, 0 to use the radius of the relevancy settings.
+         */
+        void set_observer(size_type clientIndex, const math::vec3& position, float radius = 0.f);
+
+        /**@brief Makes the observer of a client follow an entity with a replicated position, for example the entity the client controls.
+         * @param radius Radius around the entity in which entities are relevant, 0 to use the radius of the relevancy settings.
+         */
+        void follow_entity(size_type clientIndex, id_type entity, float radius = 0.f);
+
+        L_NODISCARD bool running() const noexcept { return m_running; }
+        L_NODISCARD size_type client_count() const noexcept { return m_clientIndices.size(); }
+        L_NODISCARD net_address local_address() const { return m_transport->local_address(); }
+        L_NODISCARD uint32 tick() const noexcept { return m_tick; }
+        L_NODISCARD const replication_stats& stats() const noexcept { return m_stats; }
+        L_NODISCARD bool relevancy_enabled() const noexcept { return m_positionType != max_replicated_types; }
+        L_NODISCARD const RelevancyGrid& relevancy() const noexcept { return m_relevancy; }
+    };
+}
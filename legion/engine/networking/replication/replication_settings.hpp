@@ -0,0 +1,56 @@
+#pragma once
+#include <core/core.hpp>
+#include <networking/transport/transport.hpp>
+
+/**
+ * @file replication_settings.hpp
+ */
+
+namespace legion::networking
+{
+    /**@brief Amount of received values the client keeps per replicated component, the server only sends a value as a
+     *        difference to the acknowledged baseline while fewer than this amount of newer values are still in flight.
+     */
+    constexpr size_type baseline_window = 8;
+
+    /**@brief Time in seconds between connection requests of a connecting client.
+     */
+    constexpr double connect_retry_interval = 0.1;
+
+    /**@class relevancy_settings
+     * @brief Interest management of the server, see relevancy_grid.hpp.
+     *        Only entities with a replicated position get filtered, entities without one are relevant to every client.
+     */
+    struct relevancy_settings
+    {
+        bool enabled = false;
+        float cellSize = 32.f;         // Size of the cells of the spatial hash.
+        float radius = 128.f;          // Default radius around an observer in which entities are relevant.
+        float fullRateDistance = 32.f; // Entities closer to the observer than this get updated every tick.
+        float maxInterval = 8.f;       // Most ticks between updates of a changing relevant entity, reached at maxInterval * fullRateDistance.
+    };
+
+    /**@class replication_settings
+     */
+    struct replication_settings
+    {
+        size_type maxClients = 32;
+        size_type packetBudget = max_packet_size; // Bytes per packet, every client gets at most one packet per tick.
+        double timeout = 5.0;                     // Seconds without packets before a connection is dropped.
+        relevancy_settings relevancy;
+    };
+
+    /**@class replication_stats
+     */
+    struct replication_stats
+    {
+        uint64 ticks = 0;
+        uint64 packetsSent = 0;
+        uint64 bytesSent = 0;
+        uint64 packetsReceived = 0;
+        uint64 bytesReceived = 0;
+        uint64 updatesWritten = 0;   // Component values written to packets.
+        uint64 updatesDeferred = 0;  // Changed component values that didn't fit in the packet budget.
+        uint64 updatesThrottled = 0; // Changed component values held back because the entity wasn't due for an update yet.
+    };
+}
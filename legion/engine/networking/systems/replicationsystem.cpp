@@ -0,0 +1,43 @@
+#include <networking/systems/replicationsystem.hpp>
+
+namespace legion::networking
+{
+    ReplicationSystem::~ReplicationSystem()
+    {
+        if (m_server)
+            m_server->stop();
+        if (m_client)
+            m_client->disconnect();
+    }
+
+    void ReplicationSystem::setup()
+    {
+        const double now = m_clock.elapsedTime().seconds();
+
+        if (m_config.role == replication_role::server)
+        {
+            m_server = std::make_unique<ReplicationServer>(m_config.transport, m_config.settings);
+            if (!m_server->start(m_config.address.port))
+                return;
+        }
+        else
+        {
+            m_client = std::make_unique<ReplicationClient>(m_config.transport, m_ecs, m_config.settings);
+            if (!m_client->connect(m_config.address, now))
+                return;
+        }
+
+        createProcess<&ReplicationSystem::tick>("Update", m_config.tickInterval);
+    }
+
+    void ReplicationSystem::tick(time::span deltaTime)
+    {
+        OPTICK_EVENT();
+        const double now = m_clock.elapsedTime().seconds();
+
+        if (m_server)
+            m_server->update(*m_ecs, now);
+        else if (m_client)
+            m_client->update(now);
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+#include <core/core.hpp>
+#include <networking/replication/replication_server.hpp>
+#include <networking/replication/replication_client.hpp>
+
+#include <memory>
+
+namespace legion::networking
+{
+    enum struct replication_role
+    {
+        server, client
+    };
+
+    /**@class replication_config
+     * @brief Describes which end of the replication this instance is and where to listen or connect to.
+     */
+    struct replication_config
+    {
+        replication_role role = replication_role::server;
+        net_address address = net_address(localhost, 27015); // Server: port to listen on, client: server to connect to.
+        std::shared_ptr<transport> transport = nullptr;       // nullptr to use UDP.
+        replication_settings settings;
+        time::span tickInterval = 1.f / 30.f;
+    };
+
+    /**@class ReplicationSystem
+     * @brief Runs either a ReplicationServer or a ReplicationClient on the ecs registry at a fixed tick rate.
+     */
+    class ReplicationSystem final : public System<ReplicationSystem>
+    {
+    private:
+        replication_config m_config;
+        std::unique_ptr<ReplicationServer> m_server;
+        std::unique_ptr<ReplicationClient> m_client;
+        time::timer m_clock;
+
+    public:
+        explicit ReplicationSystem(const replication_config& config) : m_config(config) {}
+        ~ReplicationSystem();
+
+        void setup();
+
+        void tick(time::span deltaTime);
+
+        /**@brief Server end of the replication, nullptr if this instance is a client.
+         */
+        L_NODISCARD ReplicationServer* server() noexcept { return m_server.get(); }
+
+        /**@brief Client end of the replication, nullptr if this instance is a server.
+         */
+        L_NODISCARD ReplicationClient* client() noexcept { return m_client.get(); }
+    };
+}
@@ -0,0 +1,211 @@
+#include <networking/transport/connection.hpp>
+
+#include <algorithm>
+
+namespace legion::networking
+{
+    uint32 connection::ack_bits() const
+    {
+        uint32 bits = 0;
+        for (uint16 i = 1; i <= ack_window; i++)
+            if (m_receivedPackets.contains(static_cast<uint16>(m_remoteSequence - i)))
+                bits |= 1u << (i - 1);
+        return bits;
+    }
+
+    uint16 connection::write_header(bit_writer& writer, double now)
+    {
+        const uint16 sequence = m_sequence++;
+        sent_packet& packet = m_sentPackets.insert(sequence);
+        packet.time = now;
+
+        writer.write_bits(sequence, 16);
+        writer.write_bits(m_remoteSequence, 16);
+        writer.write_bits(ack_bits(), 32);
+
+        // Gather the reliable messages that were never sent or weren't acknowledged in time.
+        const double resendDelay = std::max(0.033, m_rtt * 1.25);
+        size_type budget = message_budget;
+        for (uint16 id = m_oldestMessageId; id != m_nextMessageId && packet.messageCount < max_messages_per_packet; id++)
+        {
+            outgoing_message* message = m_outgoingMessages.find(id);
+            if (!message || (message->lastSent >= 0.0 && now - message->lastSent < resendDelay))
+                continue;
+
+            const size_type size = message->data.size() + 4;
+            if (size > budget)
+                continue;
+
+            if (message->lastSent >= 0.0)
+                m_stats.messagesResent++;
+
+            budget -= size;
+            message->lastSent = now;
+            packet.messageIds[packet.messageCount++] = id;
+        }
+
+        writer.write_bits(packet.messageCount, 5);
+        for (size_type i = 0; i < packet.messageCount; i++)
+        {
+            const outgoing_message& message = *m_outgoingMessages.find(packet.messageIds[i]);
+            writer.write_bits(packet.messageIds[i], 16);
+            writer.write_varint(message.data.size());
+            writer.write_bytes(message.data.data(), message.data.size());
+        }
+
+        m_lastSendTime = now;
+        m_stats.packetsSent++;
+        return sequence;
+    }
+
+    bool connection::read_header(bit_reader& reader, double now, uint16& sequence)
+    {
+        sequence = static_cast<uint16>(reader.read_bits(16));
+        const uint16 ack = static_cast<uint16>(reader.read_bits(16));
+        const uint32 bits = reader.read_bits(32);
+
+        const uint32 messageCount = reader.read_bits(5);
+        std::array<uint16, max_messages_per_packet> messageIds;
+        std::array<byte_vec, max_messages_per_packet> messages;
+        for (uint32 i = 0; i < messageCount; i++)
+        {
+            messageIds[i] = static_cast<uint16>(reader.read_bits(16));
+            const uint64 size = reader.read_varint();
+            if (size > max_message_size)
+                return false;
+
+            messages[i].resize(static_cast<size_type>(size));
+            if (!reader.read_bytes(messages[i].data(), messages[i].size()))
+                return false;
+        }
+
+        if (reader.overflowed())
+            return false;
+
+        if (m_receivedPackets.contains(sequence))
+            return false; // Duplicate.
+
+        // Packets that can't be acknowledged anymore are considered lost by the other side, accepting them would make
+        // both sides disagree about what was received.
+        if (m_hasReceived && sequence_less_than(sequence, static_cast<uint16>(m_remoteSequence - ack_window)))
+            return false;
+
+        m_lastReceiveTime = now;
+        m_stats.packetsReceived++;
+
+        process_acks(ack, bits, now);
+
+        for (uint32 i = 0; i < messageCount; i++)
+        {
+            const uint16 id = messageIds[i];
+            if (sequence_less_than(id, m_nextReceiveId) || static_cast<uint16>(id - m_nextReceiveId) >= message_window)
+                continue; // Already received or outside of the receive window.
+
+            if (!m_incomingMessages.contains(id))
+                m_incomingMessages.insert(id) = std::move(messages[i]);
+        }
+
+        return true;
+    }
+
+    void connection::process_acks(uint16 ack, uint32 ackBits, double now)
+    {
+        for (uint16 i = 0; i <= ack_window; i++)
+        {
+            if (i > 0 && !(ackBits & (1u << (i - 1))))
+                continue;
+
+            const uint16 sequence = static_cast<uint16>(ack - i);
+            sent_packet* packet = m_sentPackets.find(sequence);
+            if (!packet || packet->acked)
+                continue;
+
+            packet->acked = true;
+            m_ackedPackets.push_back(sequence);
+            m_stats.packetsAcked++;
+
+            const double sample = now - packet->time;
+            m_rtt += (sample - m_rtt) * 0.1;
+
+            for (size_type j = 0; j < packet->messageCount; j++)
+                m_outgoingMessages.remove(packet->messageIds[j]);
+        }
+
+        while (m_oldestMessageId != m_nextMessageId && !m_outgoingMessages.contains(m_oldestMessageId))
+            m_oldestMessageId++;
+
+        if (!m_hasAck || sequence_greater_than(ack, m_newestAck))
+        {
+            m_newestAck = ack;
+            m_hasAck = true;
+        }
+
+        // Packets that fell out of the acknowledgement window without being acknowledged are lost.
+        const uint16 lossEdge = static_cast<uint16>(m_newestAck - ack_window);
+        while (sequence_less_than(m_lossCursor, lossEdge) && m_lossCursor != m_sequence)
+        {
+            if (sent_packet* packet = m_sentPackets.find(m_lossCursor); packet && !packet->acked)
+            {
+                m_lostPackets.push_back(m_lossCursor);
+                m_stats.packetsLost++;
+            }
+            m_lossCursor++;
+        }
+    }
+
+    void connection::acknowledge(uint16 sequence)
+    {
+        m_receivedPackets.insert(sequence) = 1;
+        if (!m_hasReceived || sequence_greater_than(sequence, m_remoteSequence))
+            m_remoteSequence = sequence;
+        m_hasReceived = true;
+    }
+
+    bool connection::send_reliable(const byte* data, size_type size)
+    {
+        if (size > max_message_size)
+        {
+            log::error("Reliable message of {} bytes exceeds the maximum of {} bytes.", size, max_message_size);
+            return false;
+        }
+
+        if (static_cast<uint16>(m_nextMessageId - m_oldestMessageId) >= message_window / 2)
+        {
+            log::warn("Too many unacknowledged reliable messages to {}.", m_address.to_string());
+            return false;
+        }
+
+        outgoing_message& message = m_outgoingMessages.insert(m_nextMessageId++);
+        message.data.assign(data, data + size);
+        return true;
+    }
+
+    bool connection::receive_reliable(byte_vec& message)
+    {
+        byte_vec* next = m_incomingMessages.find(m_nextReceiveId);
+        if (!next)
+            return false;
+
+        message = std::move(*next);
+        m_incomingMessages.remove(m_nextReceiveId++);
+        return true;
+    }
+
+    void connection::take_acked_packets(std::vector<uint16>& packets)
+    {
+        packets.clear();
+        std::swap(packets, m_ackedPackets);
+    }
+
+    void connection::take_lost_packets(std::vector<uint16>& packets)
+    {
+        packets.clear();
+        std::swap(packets, m_lostPackets);
+    }
+
+    bool connection::is_acked(uint16 sequence) const
+    {
+        const sent_packet* packet = m_sentPackets.find(sequence);
+        return packet && packet->acked;
+    }
+}
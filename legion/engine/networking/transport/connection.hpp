@@ -0,0 +1,180 @@
+#pragma once
+#include <networking/data/bitstream.hpp>
+#include <networking/transport/transport.hpp>
+#include <networking/transport/sequence_buffer.hpp>
+
+#include <array>
+#include <vector>
+
+/**
+ * @file connection.hpp
+ * @brief Connection state on top of an unreliable transport. Every payload packet carries a sequence number and acknowledges
+ *        the last 33 packets received from the other side, which is used to track round trip time, packet loss and which
+ *        state the other side is known to have. Reliable messages are piggybacked onto payload packets and resent until acknowledged.
+ */
+
+namespace legion::networking
+{
+    /**@brief Magic number in front of every packet, packets with a different protocol id are dropped.
+     */
+    constexpr uint32 protocol_id = 0x4C474E01;
+
+    enum struct packet_type : uint8
+    {
+        connect_request = 0,
+        connect_accept = 1,
+        connect_reject = 2,
+        payload = 3,
+        disconnect = 4
+    };
+
+    inline void write_packet_prefix(bit_writer& writer, packet_type type)
+    {
+        writer.write_bits(protocol_id, 32);
+        writer.write_bits(static_cast<uint32>(type), 3);
+    }
+
+    /**@brief Reads the protocol id and packet type.
+     * @returns bool False if the packet doesn't belong to this protocol.
+     */
+    L_NODISCARD inline bool read_packet_prefix(bit_reader& reader, packet_type& type)
+    {
+        if (reader.read_bits(32) != protocol_id)
+            return false;
+
+        uint32 value = reader.read_bits(3);
+        if (reader.overflowed() || value > static_cast<uint32>(packet_type::disconnect))
+            return false;
+
+        type = static_cast<packet_type>(value);
+        return true;
+    }
+
+    /**@class connection_stats
+     * @brief Counters of a single connection.
+     */
+    struct connection_stats
+    {
+        uint64 packetsSent = 0;
+        uint64 packetsReceived = 0;
+        uint64 packetsAcked = 0;
+        uint64 packetsLost = 0;
+        uint64 messagesResent = 0;
+    };
+
+    /**@class connection
+     * @brief Sequencing, acknowledgement and reliable messaging state for one remote end point.
+     */
+    class connection
+    {
+    public:
+        static constexpr size_type packet_window = 256;
+        static constexpr uint16 ack_window = 32; // Packets acknowledged besides the most recent one.
+        static constexpr size_type message_window = 256;
+        static constexpr size_type max_messages_per_packet = 31;
+        static constexpr size_type message_budget = 512; // Bytes of reliable messages in a single packet.
+        static constexpr size_type max_message_size = message_budget - 4;
+
+    private:
+        struct sent_packet
+        {
+            double time = 0.0;
+            bool acked = false;
+            uint8 messageCount = 0;
+            std::array<uint16, max_messages_per_packet> messageIds;
+        };
+
+        struct outgoing_message
+        {
+            byte_vec data;
+            double lastSent = -1.0;
+        };
+
+        net_address m_address;
+
+        uint16 m_sequence = 0;
+        uint16 m_remoteSequence = 0;
+        uint16 m_newestAck = 0;
+        uint16 m_lossCursor = 0;
+        bool m_hasReceived = false;
+        bool m_hasAck = false;
+
+        sequence_buffer<sent_packet, packet_window> m_sentPackets;
+        sequence_buffer<byte, packet_window> m_receivedPackets;
+        std::vector<uint16> m_ackedPackets;
+        std::vector<uint16> m_lostPackets;
+
+        uint16 m_nextMessageId = 0;
+        uint16 m_oldestMessageId = 0;
+        uint16 m_nextReceiveId = 0;
+        sequence_buffer<outgoing_message, message_window> m_outgoingMessages;
+        sequence_buffer<byte_vec, message_window> m_incomingMessages;
+
+        double m_rtt = 0.1;
+        double m_lastReceiveTime;
+        double m_lastSendTime;
+
+        connection_stats m_stats;
+
+        L_NODISCARD uint32 ack_bits() const;
+        void process_acks(uint16 ack, uint32 ackBits, double now);
+
+    public:
+        connection(const net_address& address, double now) : m_address(address), m_lastReceiveTime(now), m_lastSendTime(now) {}
+
+        L_NODISCARD const net_address& address() const noexcept { return m_address; }
+
+        /**@brief Writes the header of a payload packet, including any reliable messages that are due to be (re)sent.
+         * @note Write the packet prefix before calling this, the payload can be written after.
+         * @returns uint16 Sequence number of the packet.
+         */
+        uint16 write_header(bit_writer& writer, double now);
+
+        /**@brief Reads the header of a payload packet, processes it's acknowledgements and stores it's reliable messages.
+         * @param sequence [out] Sequence number of the packet.
+         * @returns bool False if the packet was malformed, a duplicate or too old, the payload should be ignored in that case.
+         * @note Call acknowledge once the payload was processed to include the packet in the acknowledgements.
+         */
+        bool read_header(bit_reader& reader, double now, uint16& sequence);
+
+        /**@brief Marks a received packet as processed so it gets acknowledged to the other side.
+         */
+        void acknowledge(uint16 sequence);
+
+        /**@brief Queues a message that will be resent until the other side received it, messages are received in order.
+         * @returns bool False if the message is too big or too many messages are still waiting for acknowledgement.
+         */
+        bool send_reliable(const byte* data, size_type size);
+
+        /**@brief Pops the next reliable message in order.
+         * @returns bool True if a message was received.
+         */
+        bool receive_reliable(byte_vec& message);
+
+        /**@brief Moves the sequence numbers of all sent packets that were acknowledged since the last call into packets.
+         */
+        void take_acked_packets(std::vector<uint16>& packets);
+
+        /**@brief Moves the sequence numbers of all sent packets that are considered lost since the last call into packets.
+         */
+        void take_lost_packets(std::vector<uint16>& packets);
+
+        /**@brief Whether the packet with a certain sequence number has been acknowledged by the other side.
+         */
+        L_NODISCARD bool is_acked(uint16 sequence) const;
+
+        /**@brief Sequence number the next packet will get.
+         */
+        L_NODISCARD uint16 next_sequence() const noexcept { return m_sequence; }
+
+        /**@brief Smoothed round trip time in seconds.
+         */
+        L_NODISCARD double rtt() const noexcept { return m_rtt; }
+
+        L_NODISCARD bool timed_out(double now, double timeout) const noexcept { return now - m_lastReceiveTime > timeout; }
+
+        L_NODISCARD double last_send_time() const noexcept { return m_lastSendTime; }
+
+        L_NODISCARD const connection_stats& stats() const noexcept { return m_stats; }
+    };
+}
@@ -0,0 +1,135 @@
+#include <networking/transport/loopback_transport.hpp>
+
+#include <mutex>
+
+namespace legion::networking
+{
+    bool loopback_network::bind(uint16& port)
+    {
+        std::lock_guard guard(m_lock);
+
+        if (!port)
+        {
+            while (m_queues.count(m_nextPort))
+                m_nextPort = m_nextPort == 0xFFFF ? 49152 : m_nextPort + 1;
+            port = m_nextPort++;
+        }
+        else if (m_queues.count(port))
+        {
+            return false;
+        }
+
+        m_queues[port];
+        return true;
+    }
+
+    void loopback_network::unbind(uint16 port)
+    {
+        std::lock_guard guard(m_lock);
+        m_queues.erase(port);
+    }
+
+    bool loopback_network::deliver(const net_address& source, const net_address& destination, const byte* data, size_type size)
+    {
+        std::lock_guard guard(m_lock);
+
+        m_bytesSent += size;
+        m_datagramsSent++;
+
+        auto it = m_queues.find(destination.port);
+        if (destination.host != localhost || it == m_queues.end())
+            return true; // Like UDP, sending to nobody isn't an error.
+
+        std::uniform_real_distribution<float> chance(0.f, 1.f);
+        if (m_conditions.lossChance > 0.f && chance(m_random) < m_conditions.lossChance)
+            return true;
+
+        auto& queue = it->second;
+        size_type copies = (m_conditions.duplicateChance > 0.f && chance(m_random) < m_conditions.duplicateChance) ? 2 : 1;
+        for (size_type i = 0; i < copies; i++)
+        {
+            queue.push_back({ source, byte_vec(data, data + size) });
+            if (queue.size() > 1 && m_conditions.reorderChance > 0.f && chance(m_random) < m_conditions.reorderChance)
+                std::swap(queue[queue.size() - 1], queue[queue.size() - 2]);
+        }
+
+        return true;
+    }
+
+    bool loopback_network::pop(uint16 port, net_address& source, byte_vec& buffer)
+    {
+        std::lock_guard guard(m_lock);
+
+        auto it = m_queues.find(port);
+        if (it == m_queues.end() || it->second.empty())
+            return false;
+
+        auto& front = it->second.front();
+        source = front.source;
+        buffer = std::move(front.data);
+        it->second.pop_front();
+        return true;
+    }
+
+    void loopback_network::set_conditions(const loopback_conditions& conditions)
+    {
+        std::lock_guard guard(m_lock);
+        m_conditions = conditions;
+    }
+
+    uint64 loopback_network::bytes_sent() const
+    {
+        std::lock_guard guard(m_lock);
+        return m_bytesSent;
+    }
+
+    uint64 loopback_network::datagrams_sent() const
+    {
+        std::lock_guard guard(m_lock);
+        return m_datagramsSent;
+    }
+
+    loopback_transport::~loopback_transport()
+    {
+        close();
+    }
+
+    bool loopback_transport::open(uint16 port)
+    {
+        close();
+
+        if (!m_network->bind(port))
+        {
+            log::error("Loopback port {} is already in use.", port);
+            return false;
+        }
+
+        m_port = port;
+        return true;
+    }
+
+    void loopback_transport::close()
+    {
+        if (!m_port)
+            return;
+
+        m_network->unbind(m_port);
+        m_port = 0;
+    }
+
+    bool loopback_transport::send(const net_address& destination, const byte* data, size_type size)
+    {
+        if (!m_port || size > max_packet_size)
+            return false;
+
+        return m_network->deliver(local_address(), destination, data, size);
+    }
+
+    bool loopback_transport::receive(net_address& source, byte_vec& buffer)
+    {
+        if (!m_port)
+            return false;
+
+        return m_network->pop(m_port, source, buffer);
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+#include <networking/transport/transport.hpp>
+
+#include <deque>
+#include <memory>
+#include <random>
+#include <unordered_map>
+
+/**
+ * @file loopback_transport.hpp
+ * @brief In process transport for tests, benchmarks and listen servers. Every loopback_transport connected to the same
+ *        loopback_network can reach the others through 127.0.0.1 and the port it opened.
+ */
+
+namespace legion::networking
+{
+    /**@class loopback_conditions
+     * @brief Simulated network conditions, all chances are between 0 and 1.
+     */
+    struct loopback_conditions
+    {
+        float lossChance = 0.f;
+        float duplicateChance = 0.f;
+        float reorderChance = 0.f;
+    };
+
+    /**@class loopback_network
+     * @brief Shared set of datagram queues, one for every open port.
+     */
+    class loopback_network
+    {
+        friend class loopback_transport;
+    private:
+        struct datagram
+        {
+            net_address source;
+            byte_vec data;
+        };
+
+        mutable async::spinlock m_lock;
+        std::unordered_map<uint16, std::deque<datagram>> m_queues;
+        loopback_conditions m_conditions;
+        std::mt19937 m_random;
+        uint16 m_nextPort = 49152;
+        uint64 m_bytesSent = 0;
+        uint64 m_datagramsSent = 0;
+
+        bool bind(uint16& port);
+        void unbind(uint16 port);
+        bool deliver(const net_address& source, const net_address& destination, const byte* data, size_type size);
+        bool pop(uint16 port, net_address& source, byte_vec& buffer);
+
+    public:
+        explicit loopback_network(uint32 seed = 1337) : m_random(seed) {}
+
+        void set_conditions(const loopback_conditions& conditions);
+
+        /**@brief Total amount of payload bytes handed to the network since creation.
+         */
+        L_NODISCARD uint64 bytes_sent() const;
+        L_NODISCARD uint64 datagrams_sent() const;
+    };
+
+    /**@class loopback_transport
+     * @brief Transport that delivers datagrams through a loopback_network instead of the OS.
+     */
+    class loopback_transport final : public transport
+    {
+    private:
+        std::shared_ptr<loopback_network> m_network;
+        uint16 m_port = 0;
+
+    public:
+        explicit loopback_transport(std::shared_ptr<loopback_network> network) : m_network(std::move(network)) {}
+        ~loopback_transport() override;
+
+        bool open(uint16 port) override;
+        void close() override;
+
+        bool send(const net_address& destination, const byte* data, size_type size) override;
+        bool receive(net_address& source, byte_vec& buffer) override;
+
+        L_NODISCARD net_address local_address() const override { return net_address(localhost, m_port); }
+    };
+}
@@ -0,0 +1,90 @@
+#pragma once
+#include <core/core.hpp>
+
+#include <array>
+
+/**
+ * @file sequence_buffer.hpp
+ */
+
+namespace legion::networking
+{
+    /**@brief Whether sequence a is more recent than sequence b, taking wrap around into account.
+     */
+    L_NODISCARD constexpr bool sequence_greater_than(uint16 a, uint16 b) noexcept
+    {
+        return ((a > b) && (a - b <= 32768)) || ((a < b) && (b - a > 32768));
+    }
+
+    L_NODISCARD constexpr bool sequence_less_than(uint16 a, uint16 b) noexcept
+    {
+        return sequence_greater_than(b, a);
+    }
+
+    /**@class sequence_buffer
+     * @brief Fixed size ring of entries indexed by a 16 bit wrapping sequence number.
+     *        Inserting a sequence overwrites whatever entry was stored size sequences earlier.
+     * @tparam T Type of entry.
+     * @tparam size Amount of entries, needs to be a divisor of 65536 so that wrap around lines up.
+     */
+    template<typename T, size_type size>
+    class sequence_buffer
+    {
+        static_assert(65536 % size == 0, "sequence_buffer size needs to be a divisor of 65536.");
+
+    private:
+        static constexpr uint32 empty_sequence = 0xFFFFFFFF;
+
+        std::array<uint32, size> m_sequences;
+        std::array<T, size> m_entries;
+
+    public:
+        sequence_buffer()
+        {
+            m_sequences.fill(empty_sequence);
+        }
+
+        /**@brief Claims the entry of a sequence, resetting it to a default value.
+         */
+        T& insert(uint16 sequence)
+        {
+            const size_type index = sequence % size;
+            m_sequences[index] = sequence;
+            m_entries[index] = T();
+            return m_entries[index];
+        }
+
+        void remove(uint16 sequence)
+        {
+            const size_type index = sequence % size;
+            if (m_sequences[index] == sequence)
+                m_sequences[index] = empty_sequence;
+        }
+
+        L_NODISCARD bool contains(uint16 sequence) const noexcept
+        {
+            return m_sequences[sequence % size] == sequence;
+        }
+
+        /**@brief Entry of a sequence, nullptr if it isn't stored (anymore).
+         */
+        L_NODISCARD T* find(uint16 sequence) noexcept
+        {
+            const size_type index = sequence % size;
+            return m_sequences[index] == sequence ? &m_entries[index] : nullptr;
+        }
+
+        L_NODISCARD const T* find(uint16 sequence) const noexcept
+        {
+            const size_type index = sequence % size;
+            return m_sequences[index] == sequence ? &m_entries[index] : nullptr;
+        }
+
+        void clear()
+        {
+            m_sequences.fill(empty_sequence);
+        }
+
+        static constexpr size_type capacity() noexcept { return size; }
+    };
+}
@@ -0,0 +1,59 @@
+#include <networking/transport/transport.hpp>
+
+#include <charconv>
+
+namespace legion::networking
+{
+    std::optional<net_address> net_address::parse(std::string_view str)
+    {
+        size_type separator = str.rfind(':');
+        if (separator == std::string_view::npos)
+            return std::nullopt;
+
+        std::string_view hostStr = str.substr(0, separator);
+        std::string_view portStr = str.substr(separator + 1);
+
+        uint32 port = 0;
+        auto [portEnd, portError] = std::from_chars(portStr.data(), portStr.data() + portStr.size(), port);
+        if (portError != std::errc() || portEnd != portStr.data() + portStr.size() || port == 0 || port > 0xFFFF)
+            return std::nullopt;
+
+        if (hostStr.empty())
+            return net_address(0, static_cast<uint16>(port));
+
+        if (hostStr == "localhost")
+            return net_address(localhost, static_cast<uint16>(port));
+
+        uint32 host = 0;
+        const char* cursor = hostStr.data();
+        const char* end = hostStr.data() + hostStr.size();
+        for (int i = 0; i < 4; i++)
+        {
+            uint32 octet = 0;
+            auto [octetEnd, octetError] = std::from_chars(cursor, end, octet);
+            if (octetError != std::errc() || octet > 255)
+                return std::nullopt;
+
+            host = (host << 8) | octet;
+            cursor = octetEnd;
+
+            if (i < 3)
+            {
+                if (cursor == end || *cursor != '.')
+                    return std::nullopt;
+                cursor++;
+            }
+        }
+
+        if (cursor != end)
+            return std::nullopt;
+
+        return net_address(host, static_cast<uint16>(port));
+    }
+
+    std::string net_address::to_string() const
+    {
+        return std::to_string((host >> 24) & 0xFF) + '.' + std::to_string((host >> 16) & 0xFF) + '.' +
+            std::to_string((host >> 8) & 0xFF) + '.' + std::to_string(host & 0xFF) + ':' + std::to_string(port);
+    }
+}
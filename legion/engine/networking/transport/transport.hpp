@@ -0,0 +1,89 @@
+#pragma once
+#include <core/core.hpp>
+
+#include <optional>
+#include <string>
+#include <string_view>
+
+/**
+ * @file transport.hpp
+ * @brief Unreliable datagram transports, reliability and connection state are handled on top of these by legion::networking::connection.
+ */
+
+namespace legion::networking
+{
+    /**@brief Largest datagram any transport will send, stays below common MTU sizes to avoid IP fragmentation.
+     */
+    constexpr size_type max_packet_size = 1200;
+
+    /**@class net_address
+     * @brief IPv4 address and port, both in host byte order.
+     */
+    struct net_address
+    {
+        uint32 host = 0;
+        uint16 port = 0;
+
+        net_address() = default;
+        net_address(uint32 host, uint16 port) : host(host), port(port) {}
+
+        /**@brief Parses "a.b.c.d:port", "localhost:port" or ":port".
+         * @returns std::optional<net_address> The address, std::nullopt if the string isn't a valid address.
+         */
+        L_NODISCARD static std::optional<net_address> parse(std::string_view str);
+
+        L_NODISCARD std::string to_string() const;
+
+        L_NODISCARD bool valid() const noexcept { return port != 0; }
+
+        bool operator==(const net_address& other) const noexcept { return host == other.host && port == other.port; }
+        bool operator!=(const net_address& other) const noexcept { return !(*this == other); }
+    };
+
+    constexpr uint32 localhost = 0x7F000001;
+
+    /**@class transport
+     * @brief Interface for sending and receiving datagrams. Datagrams may get lost, duplicated or arrive out of order.
+     */
+    class transport
+    {
+    public:
+        /**@brief Binds the transport to a local port.
+         * @param port Port to bind to, 0 to let the transport pick one.
+         * @returns bool True if the transport is ready to send and receive.
+         */
+        virtual bool open(uint16 port) LEGION_PURE;
+
+        virtual void close() LEGION_PURE;
+
+        /**@brief Sends a single datagram, never blocks.
+         * @returns bool False if the datagram couldn't be handed to the network.
+         */
+        virtual bool send(const net_address& destination, const byte* data, size_type size) LEGION_PURE;
+
+        /**@brief Receives a single pending datagram, never blocks.
+         * @param source [out] Sender of the datagram.
+         * @param buffer [out] Contents of the datagram.
+         * @returns bool True if a datagram was received, false if none are pending.
+         */
+        virtual bool receive(net_address& source, byte_vec& buffer) LEGION_PURE;
+
+        /**@brief Address the transport is bound to.
+         */
+        L_NODISCARD virtual net_address local_address() const LEGION_PURE;
+
+        virtual ~transport() = default;
+    };
+}
+
+namespace std
+{
+    template<>
+    struct hash<legion::networking::net_address>
+    {
+        size_t operator()(const legion::networking::net_address& address) const noexcept
+        {
+            return std::hash<legion::core::uint64>()((static_cast<legion::core::uint64>(address.host) << 16) | address.port);
+        }
+    };
+}
@@ -0,0 +1,193 @@
+#include <core/platform/platform.hpp>
+
+// The platform header includes Windows.h with WIN32_LEAN_AND_MEAN, so winsock2 can safely be included after it.
+#if defined(LEGION_WINDOWS)
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#pragma comment(lib, "ws2_32")
+#else
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <networking/transport/udp_transport.hpp>
+
+#include <atomic>
+
+namespace legion::networking
+{
+    namespace
+    {
+#if defined(LEGION_WINDOWS)
+        using native_socket = SOCKET;
+        constexpr native_socket invalid_socket = INVALID_SOCKET;
+
+        std::atomic<int> socketUsers{ 0 };
+
+        bool acquire_sockets()
+        {
+            if (socketUsers.fetch_add(1, std::memory_order_acq_rel) == 0)
+            {
+                WSADATA data;
+                if (WSAStartup(MAKEWORD(2, 2), &data) != 0)
+                {
+                    socketUsers.fetch_sub(1, std::memory_order_acq_rel);
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void release_sockets()
+        {
+            if (socketUsers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                WSACleanup();
+        }
+
+        void close_socket(native_socket socket) { closesocket(socket); }
+
+        bool set_non_blocking(native_socket socket)
+        {
+            u_long nonBlocking = 1;
+            return ioctlsocket(socket, FIONBIO, &nonBlocking) == 0;
+        }
+
+        bool would_block() { return WSAGetLastError() == WSAEWOULDBLOCK; }
+        bool connection_reset() { return WSAGetLastError() == WSAECONNRESET; }
+        int last_error() { return WSAGetLastError(); }
+#else
+        using native_socket = int;
+        constexpr native_socket invalid_socket = -1;
+
+        bool acquire_sockets() { return true; }
+        void release_sockets() {}
+
+        void close_socket(native_socket socket) { ::close(socket); }
+
+        bool set_non_blocking(native_socket socket)
+        {
+            int flags = fcntl(socket, F_GETFL, 0);
+            return flags != -1 && fcntl(socket, F_SETFL, flags | O_NONBLOCK) != -1;
+        }
+
+        bool would_block() { return errno == EAGAIN || errno == EWOULDBLOCK; }
+        bool connection_reset() { return errno == ECONNREFUSED; }
+        int last_error() { return errno; }
+#endif
+
+        native_socket to_native(std::intptr_t socket) { return static_cast<native_socket>(socket); }
+    }
+
+    udp_transport::~udp_transport()
+    {
+        close();
+    }
+
+    bool udp_transport::open(uint16 port)
+    {
+        close();
+
+        if (!acquire_sockets())
+        {
+            log::error("Failed to initialize the socket library.");
+            return false;
+        }
+
+        native_socket socket = ::socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (socket == invalid_socket)
+        {
+            log::error("Failed to create UDP socket, error {}.", last_error());
+            release_sockets();
+            return false;
+        }
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_ANY);
+        address.sin_port = htons(port);
+
+        if (::bind(socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            log::error("Failed to bind UDP socket to port {}, error {}.", port, last_error());
+            close_socket(socket);
+            release_sockets();
+            return false;
+        }
+
+        if (!set_non_blocking(socket))
+        {
+            log::error("Failed to make UDP socket non blocking, error {}.", last_error());
+            close_socket(socket);
+            release_sockets();
+            return false;
+        }
+
+        socklen_t length = sizeof(address);
+        getsockname(socket, reinterpret_cast<sockaddr*>(&address), &length);
+        m_localAddress = net_address(ntohl(address.sin_addr.s_addr), ntohs(address.sin_port));
+
+        m_socket = static_cast<std::intptr_t>(socket);
+        return true;
+    }
+
+    void udp_transport::close()
+    {
+        if (m_socket == -1)
+            return;
+
+        close_socket(to_native(m_socket));
+        release_sockets();
+        m_socket = -1;
+        m_localAddress = net_address();
+    }
+
+    bool udp_transport::send(const net_address& destination, const byte* data, size_type size)
+    {
+        if (m_socket == -1 || size > max_packet_size)
+            return false;
+
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(destination.host);
+        address.sin_port = htons(destination.port);
+
+        auto sent = ::sendto(to_native(m_socket), reinterpret_cast<const char*>(data), static_cast<int>(size), 0,
+            reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+        return sent == static_cast<decltype(sent)>(size);
+    }
+
+    bool udp_transport::receive(net_address& source, byte_vec& buffer)
+    {
+        if (m_socket == -1)
+            return false;
+
+        buffer.resize(max_packet_size);
+        while (true)
+        {
+            sockaddr_in address{};
+            socklen_t length = sizeof(address);
+            auto received = ::recvfrom(to_native(m_socket), reinterpret_cast<char*>(buffer.data()), static_cast<int>(buffer.size()), 0,
+                reinterpret_cast<sockaddr*>(&address), &length);
+
+            if (received < 0)
+            {
+                if (connection_reset())
+                    continue; // ICMP port unreachable from an earlier send, not an error for a connectionless socket.
+
+                if (!would_block())
+                    log::warn("Failed to receive UDP datagram, error {}.", last_error());
+
+                buffer.clear();
+                return false;
+            }
+
+            buffer.resize(static_cast<size_type>(received));
+            source = net_address(ntohl(address.sin_addr.s_addr), ntohs(address.sin_port));
+            return true;
+        }
+    }
+}
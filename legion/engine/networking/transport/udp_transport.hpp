@@ -0,0 +1,36 @@
+#pragma once
+#include <networking/transport/transport.hpp>
+
+#include <cstdint>
+
+/**
+ * @file udp_transport.hpp
+ */
+
+namespace legion::networking
+{
+    /**@class udp_transport
+     * @brief Non blocking IPv4 UDP socket.
+     */
+    class udp_transport final : public transport
+    {
+    private:
+        std::intptr_t m_socket = -1;
+        net_address m_localAddress;
+
+    public:
+        udp_transport() = default;
+        ~udp_transport() override;
+
+        udp_transport(const udp_transport&) = delete;
+        udp_transport& operator=(const udp_transport&) = delete;
+
+        bool open(uint16 port) override;
+        void close() override;
+
+        bool send(const net_address& destination, const byte* data, size_type size) override;
+        bool receive(net_address& source, byte_vec& buffer) override;
+
+        L_NODISCARD net_address local_address() const override { return m_localAddress; }
+    };
+}
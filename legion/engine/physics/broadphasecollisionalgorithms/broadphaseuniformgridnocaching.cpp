@@ -5,14 +5,16 @@ namespace legion::physics
     const std::vector<std::vector<physics_manifold_precursor>>& legion::physics::BroadphaseUniformGridNoCaching::collectPairs
     (std::vector<physics_manifold_precursor>&& manifoldPrecursors)
     {
-      
-        manifoldPrecursorGrouping.clear();
+        // Clear the groups without releasing them so their capacity gets reused next frame.
+        for (auto& group : manifoldPrecursorGrouping)
+            group.clear();
+        size_type groupCount = 0;
 
-        // TODO: insert return statement here
-        std::unordered_map<math::ivec3, int> cellIndices;
+        memory::frame_unordered_map<math::ivec3, int> cellIndices;
+        cellIndices.reserve(manifoldPrecursors.size());
         for (auto& precursor : manifoldPrecursors)
         {
-            std::vector<legion::physics::PhysicsColliderPtr> colliders = precursor.physicsComp->colliders;
+            const std::vector<legion::physics::PhysicsColliderPtr>& colliders = precursor.physicsComp->colliders;
             if (colliders.size() == 0) continue;
 
             // Get the biggest AABB collider of this physics component
@@ -32,21 +34,21 @@ namespace legion::physics
                     for (int z = startCellIndex.z; z <= endCellIndex.z; ++z)
                     {
                         math::ivec3 currentCellIndex = math::ivec3(x, y, z);
-                        if (cellIndices.find(currentCellIndex) != cellIndices.end())
+                        auto [iterator, inserted] = cellIndices.emplace(currentCellIndex, static_cast<int>(groupCount));
+                        if (inserted)
                         {
-                            manifoldPrecursorGrouping.at(cellIndices.at(currentCellIndex)).push_back(precursor);
-                        }
-                        else
-                        {
-                            cellIndices.emplace(currentCellIndex, manifoldPrecursorGrouping.size());
-                            manifoldPrecursorGrouping.push_back(std::vector<physics_manifold_precursor>());
-                            manifoldPrecursorGrouping.at(manifoldPrecursorGrouping.size() - 1).push_back(precursor);
+                            if (groupCount == manifoldPrecursorGrouping.size())
+                                manifoldPrecursorGrouping.emplace_back();
+                            groupCount++;
                         }
+
+                        manifoldPrecursorGrouping[iterator->second].push_back(precursor);
                     }
                 }
             }
         }
 
+        manifoldPrecursorGrouping.resize(groupCount);
         return manifoldPrecursorGrouping;
 
     }
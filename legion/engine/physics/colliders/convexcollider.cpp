@@ -221,13 +221,20 @@ namespace legion::physics
 
     void ConvexCollider::UpdateTightAABB(const math::mat4& transform)
     {
-        minMaxWorldAABB = PhysicsStatics::ConstructAABBFromTransformedVertices
-        (vertices, transform);
+        // Resting and static colliders keep their transform, so their world AABB is still valid.
+        if (!boundsDirty && transform == boundsTransform)
+            return;
+
+        boundsTransform = transform;
+        boundsDirty = false;
+        localBounds.transformed_aabb(transform, minMaxWorldAABB.first, minMaxWorldAABB.second);
     }
 
     void ConvexCollider::UpdateLocalAABB()
     {
-        minMaxLocalAABB = PhysicsStatics::ConstructAABBFromVertices(vertices);
+        localBounds = math::bounding_volume::from_points(vertices.data(), vertices.size());
+        minMaxLocalAABB = std::make_pair(localBounds.min, localBounds.max);
+        boundsDirty = true;
     }
 
     void ConvexCollider::DrawColliderRepresentation(const math::mat4& transform,math::color usedColor, float width, float time,bool ignoreDepth)
@@ -276,6 +283,7 @@ namespace legion::physics
         if (mesh.vertices.size() < 4)
         {
             log::warn("Hull generation skipped, because mesh had less than 4 verticess");
+            UpdateLocalAABB(); // Degenerate hulls still need bounds that match their (partial) vertices.
             return;
         }
         
@@ -291,6 +299,7 @@ namespace legion::physics
         if (index2 == mesh.vertices.size())
         {
             log::error("Initial hull, index 2 cannot be found!");
+            UpdateLocalAABB();
             return;
         }
 
@@ -325,6 +334,7 @@ namespace legion::physics
         if (index3 == mesh.vertices.size())
         {
             log::error("Initial hull, index 3 cannot be found!");
+            UpdateLocalAABB();
             return;
         }
 
@@ -683,6 +693,7 @@ namespace legion::physics
         //}
         ////convexHullMergeFaces(halfEdgeFaces,true);
         AssertEdgeValidity();
+        UpdateLocalAABB();
         //log::debug("-> Finish ConstructConvexHullWithMesh ----------------------------------");
     }
     
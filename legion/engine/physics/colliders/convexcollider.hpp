@@ -58,12 +58,14 @@ namespace legion::physics
             UpdateTightAABB(transform);
         }
 
-        /**@brief Given the current transform of the entity, creates a tight AABB of the collider;
+        /**@brief Given the current transform of the entity, creates the world AABB of the collider from it's local AABB.
+        * Constant time regardless of the vertex count, and skipped entirely if the transform didn't change since the last call.
         */
         void UpdateTightAABB(const math::mat4& transform);
        
 
-        /**@brief Using the vertices of the convexCollider,creates a ;
+        /**@brief Using the vertices of the convexCollider, calculates the local AABB and bounding sphere.
+        * @note Called after the hull or box is created, needs to be called again if the vertices change in any other way.
        */
         void UpdateLocalAABB() override;
        
@@ -334,6 +336,7 @@ namespace legion::physics
             //check if halfEdge data structure was initialized correctly. this will be commented when I know it always works
             AssertEdgeValidity();
             CalculateLocalColliderCentroid();
+            UpdateLocalAABB();
         }
 
         std::vector<HalfEdgeFace*>& GetHalfEdgeFaces() override
@@ -107,11 +107,23 @@ namespace legion::physics
             return minMaxWorldAABB;
         }
 
+        /**@brief Local space AABB and bounding sphere, calculated once when the shape of the collider is created.
+         */
+        const math::bounding_volume& GetLocalBounds() const noexcept
+        {
+            return localBounds;
+        }
+
     protected:
 
         math::vec3 localColliderCentroid = math::vec3(0, 0, 0);
         std::pair<math::vec3, math::vec3> minMaxLocalAABB;
         std::pair<math::vec3, math::vec3> minMaxWorldAABB;
+
+        math::bounding_volume localBounds;
+        // Transform the world AABB was last derived with, the world AABB only changes when the transform or the local bounds do.
+        math::mat4 boundsTransform = math::mat4(1.f);
+        bool boundsDirty = true;
     private:
 
         int id = -1;
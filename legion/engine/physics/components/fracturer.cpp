@@ -207,7 +207,7 @@ namespace legion::physics
                 //debug::user_projectDrawLine(vertPos, vertPos + math::vec3(0,0.5,0), debugColor,10.0f,FLT_MAX);
             }
 
-            auto newCollider = std::make_shared<ConvexCollider>();
+            auto newCollider = memory::make_tagged_shared<ConvexCollider, memory::memory_tag::physics>();
 
             debugVectorcolliders.push_back(newCollider);
             voronoiColliders.push_back(newCollider);
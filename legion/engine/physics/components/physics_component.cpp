@@ -18,7 +18,7 @@ namespace legion::physics
 
     std::shared_ptr<ConvexCollider> physicsComponent::ConstructConvexHull(legion::core::mesh_handle meshHandle, bool shouldDebug )
     {
-        auto collider = std::make_shared<ConvexCollider>();
+        auto collider = memory::make_tagged_shared<ConvexCollider, memory::memory_tag::physics>();
 
         collider->ConstructConvexHullWithMesh(meshHandle,shouldDebug);
         //collider->doStep(meshHandle);
@@ -44,7 +44,7 @@ namespace legion::physics
 
     void physicsComponent::AddBox(const cube_collider_params& cubeParams)
     {
-        auto cuboidCollider = std::make_shared<ConvexCollider>();
+        auto cuboidCollider = memory::make_tagged_shared<ConvexCollider, memory::memory_tag::physics>();
 
         cuboidCollider->CreateBox(cubeParams);
 
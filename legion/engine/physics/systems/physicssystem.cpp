@@ -1,9 +1,12 @@
 #include <physics/systems/physicssystem.hpp>
 #include <physics/broadphasecollisionalgorithms/broadphaseuniformgridnocaching.hpp>
 
+#include <algorithm>
+
 namespace legion::physics
 {
     std::unique_ptr<BroadPhaseCollisionAlgorithm> PhysicsSystem::m_broadPhase = nullptr;
+    std::atomic<size_type> PhysicsSystem::m_substeps{ 1 };
 
     bool PhysicsSystem::IsPaused = false;
     bool PhysicsSystem::oneTimeRunActive = false;
@@ -24,7 +27,7 @@ namespace legion::physics
     }
 
     void PhysicsSystem::runPhysicsPipeline(
-        std::vector<byte>& hasRigidBodies,
+        memory::frame_vector<byte>& hasRigidBodies,
         ecs::component_container<rigidbody>& rigidbodies,
         ecs::component_container<physicsComponent>& physComps,
         ecs::component_container<position>& positions,
@@ -40,17 +43,17 @@ namespace legion::physics
         std::vector<physics_manifold_precursor> manifoldPrecursors;
         bulkRetrievePreManifoldData(physComps, positions, rotations, scales, manifoldPrecursors);
 
-        std::vector<std::vector<physics_manifold_precursor>> manifoldPrecursorGrouping;
         //m_optimizeBroadPhase(manifoldPrecursors, manifoldPrecursorGrouping);
-        manifoldPrecursorGrouping = m_broadPhase->collectPairs(std::move(manifoldPrecursors));
+        // The groupings stay owned by the broadphase until the next call to collectPairs, no need to copy them.
+        const auto& manifoldPrecursorGrouping = m_broadPhase->collectPairs(std::move(manifoldPrecursors));
 
         //------------------------------------------------------ Narrowphase -----------------------------------------------------//
-        std::vector<physics_manifold> manifoldsToSolve;
+        memory::frame_vector<physics_manifold> manifoldsToSolve;
 
         {
             OPTICK_EVENT("Narrowphase");
 
-            std::set<std::pair<id_type, id_type>> idPairings;
+            memory::frame_set<std::pair<id_type, id_type>> idPairings;
 
             size_type totalChecks = 0;
             for (auto& manifoldPrecursor : manifoldPrecursorGrouping)
@@ -63,8 +66,8 @@ namespace legion::physics
                         totalChecks++;
                         assert(j != manifoldPrecursor.size());
 
-                        physics_manifold_precursor& precursorA = manifoldPrecursor.at(i);
-                        physics_manifold_precursor& precursorB = manifoldPrecursor.at(j);
+                        const physics_manifold_precursor& precursorA = manifoldPrecursor.at(i);
+                        const physics_manifold_precursor& precursorB = manifoldPrecursor.at(j);
 
                         //check if we have found this pairing before
                         std::pair<id_type, id_type> precursorPairing = std::make_pair(precursorA.id, precursorB.id);
@@ -115,6 +118,24 @@ namespace legion::physics
             //log::debug("total checks {}", totalChecks);
         }
 
+        if (m_scheduler->isDeterministic())
+        {
+            OPTICK_EVENT("Sort manifolds");
+            // The sequential solver is order dependent and the broadphase groupings come out in whatever order their cells are stored in.
+            // Sorting by the ids of the pair makes the solve order only depend on which pairs collide.
+            std::stable_sort(manifoldsToSolve.begin(), manifoldsToSolve.end(), [](const physics_manifold& lhs, const physics_manifold& rhs)
+                {
+                    const id_type lhsA = lhs.entityA, lhsB = lhs.entityB, rhsA = rhs.entityA, rhsB = rhs.entityB;
+                    if (lhsA != rhsA)
+                        return lhsA < rhsA;
+                    if (lhsB != rhsB)
+                        return lhsB < rhsB;
+                    if (lhs.colliderA->GetColliderID() != rhs.colliderA->GetColliderID())
+                        return lhs.colliderA->GetColliderID() < rhs.colliderA->GetColliderID();
+                    return lhs.colliderB->GetColliderID() < rhs.colliderB->GetColliderID();
+                });
+        }
+
         //------------------------------------------------ Pre Collision Solve Events --------------------------------------------//
 
 
@@ -125,7 +146,7 @@ namespace legion::physics
         for (auto ent : countdownQuery)
         {
             auto fractureCountdown = ent.read_component<FractureCountdown>();
-            fractureCountdown.fractureTime -= 0.02f;
+            fractureCountdown.fractureTime -= deltaTime;
             //log::debug(" fractureCountdown.fractureTime {}", fractureCountdown.fractureTime);
 
             if (fractureCountdown.explodeNow || fractureCountdown.fractureTime < 0.0f)
@@ -150,7 +171,7 @@ namespace legion::physics
 
         // all manifolds are initially valid
 
-        std::vector<byte> manifoldValidity(manifoldsToSolve.size(), true);
+        memory::frame_vector<byte> manifoldValidity(manifoldsToSolve.size(), true);
 
         //TODO we are currently hard coding fracture, this should be an event at some point
         {
@@ -252,8 +273,8 @@ namespace legion::physics
 
     }
 
-    void PhysicsSystem::constructManifoldsWithPrecursors(ecs::component_container<rigidbody>& rigidbodies, std::vector<byte>& hasRigidBodies, physics_manifold_precursor& precursorA, physics_manifold_precursor& precursorB,
-        std::vector<physics_manifold>& manifoldsToSolve, bool isRigidbodyInvolved, bool isTriggerInvolved)
+    void PhysicsSystem::constructManifoldsWithPrecursors(ecs::component_container<rigidbody>& rigidbodies, memory::frame_vector<byte>& hasRigidBodies, const physics_manifold_precursor& precursorA, const physics_manifold_precursor& precursorB,
+        memory::frame_vector<physics_manifold>& manifoldsToSolve, bool isRigidbodyInvolved, bool isTriggerInvolved)
     {
         OPTICK_EVENT();
         if (!precursorA.physicsComp || !precursorB.physicsComp) return;
@@ -262,9 +283,9 @@ namespace legion::physics
 
         //if (physicsComponentA.colliders.empty() || physicsComponentB.colliders.empty()) return;
 
-        for (auto colliderA : physicsComponentA.colliders)
+        for (auto& colliderA : physicsComponentA.colliders)
         {
-            for (auto colliderB : physicsComponentB.colliders)
+            for (auto& colliderB : physicsComponentB.colliders)
             {
                 physics::physics_manifold m;
                 constructManifoldWithCollider(rigidbodies, hasRigidBodies, colliderA.get(), colliderB.get(), precursorA, precursorB, m);
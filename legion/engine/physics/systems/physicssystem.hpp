@@ -47,7 +47,7 @@ namespace legion::physics
             //log::debug("frametime: {}ms", pt.restart().milliseconds());
 
             ecs::component_container<rigidbody> rigidbodies;
-            std::vector<byte> hasRigidBodies;
+            memory::frame_vector<byte> hasRigidBodies;
 
             {
                 OPTICK_EVENT("Fetching data");
@@ -74,11 +74,21 @@ namespace legion::physics
             auto& rotations = manifoldPrecursorQuery.get<rotation>();
             auto& scales = manifoldPrecursorQuery.get<scale>();
 
+            // Keep the transforms from before this step so rendering can interpolate towards the result.
+            const uint64 step = TransformInterpolation::beginStep();
+            memory::frame_vector<math::vec3> previousPositions(positions.begin(), positions.end());
+            memory::frame_vector<math::quat> previousRotations(rotations.begin(), rotations.end());
+
             if (!IsPaused)
             {
-                integrateRigidbodies(hasRigidBodies, rigidbodies, deltaTime);
-                runPhysicsPipeline(hasRigidBodies, rigidbodies, physComps, positions, rotations, scales, deltaTime);
-                integrateRigidbodyQueryPositionAndRotation(hasRigidBodies, positions, rotations, rigidbodies, deltaTime);
+                const size_type substeps = getSubsteps();
+                const float substepTime = deltaTime / static_cast<float>(substeps);
+                for (size_type substep = 0; substep < substeps; substep++)
+                {
+                    integrateRigidbodies(hasRigidBodies, rigidbodies, substepTime);
+                    runPhysicsPipeline(hasRigidBodies, rigidbodies, physComps, positions, rotations, scales, substepTime);
+                    integrateRigidbodyQueryPositionAndRotation(hasRigidBodies, positions, rotations, rigidbodies, substepTime);
+                }
             }
 
             if (oneTimeRunActive)
@@ -92,20 +102,34 @@ namespace legion::physics
 
             {
                 OPTICK_EVENT("Writing data");
+                memory::frame_vector<byte> missingHistory(manifoldPrecursorQuery.size(), false);
+
                 m_scheduler->queueJobs(manifoldPrecursorQuery.size(), [&]() {
                     id_type index = async::this_job::get_id();
                     if (hasRigidBodies[index])
                     {
                         auto entity = manifoldPrecursorQuery[index];
                         entity.write_component(rigidbodies[index]);
+
+                        if (entity.has_component<previous_transform>())
+                            entity.write_component(previous_transform{ previousPositions[index], previousRotations[index], step });
+                        else
+                            missingHistory[index] = true;
                     }
                     }).wait();
 
+                    // Adding components changes the component families, so this can't happen from the jobs.
+                    for (size_type index = 0; index < missingHistory.size(); index++)
+                        if (missingHistory[index])
+                            manifoldPrecursorQuery[index].add_component(previous_transform{ previousPositions[index], previousRotations[index], step });
+
                     manifoldPrecursorQuery.submit<physicsComponent>();
                     manifoldPrecursorQuery.submit<position>();
                     manifoldPrecursorQuery.submit<rotation>();
             }
 
+            TransformInterpolation::publishStep(step, deltaTime);
+
            /* auto splitterDrawQuery = createQuery<MeshSplitter>();
             splitterDrawQuery.queryEntities();
 
@@ -137,12 +161,28 @@ namespace legion::physics
             std::vector<physics_manifold_precursor>& manifoldPrecursors)
         {
             OPTICK_EVENT();
-            manifoldPrecursors.resize(physComps.size());
+            const size_type count = physComps.size();
+            manifoldPrecursors.resize(count);
+
+            // All transforms get composed in one batch before the colliders are updated in parallel.
+            m_transformArrays.resize(count * 10);
+            float* arrays[10];
+            for (size_type i = 0; i < 10; i++)
+                arrays[i] = m_transformArrays.data() + i * count;
 
-            m_scheduler->queueJobs(physComps.size(), [&]() {
+            for (size_type i = 0; i < count; i++)
+            {
+                arrays[0][i] = positions[i].x; arrays[1][i] = positions[i].y; arrays[2][i] = positions[i].z;
+                arrays[3][i] = rotations[i].x; arrays[4][i] = rotations[i].y; arrays[5][i] = rotations[i].z; arrays[6][i] = rotations[i].w;
+                arrays[7][i] = scales[i].x; arrays[8][i] = scales[i].y; arrays[9][i] = scales[i].z;
+            }
+
+            m_transforms.resize(count);
+            math::batch::compose(count, { arrays[0], arrays[1], arrays[2], arrays[3], arrays[4], arrays[5], arrays[6], arrays[7], arrays[8], arrays[9] }, m_transforms.data());
+
+            m_scheduler->queueJobs(count, [&]() {
                 id_type index = async::this_job::get_id();
-                math::mat4 transf;
-                math::compose(transf, scales[index], rotations[index], positions[index]);
+                const math::mat4& transf = m_transforms[index];
 
                 for (auto& collider : physComps[index].colliders)
                     collider->UpdateTransformedTightBoundingVolume(transf);
@@ -166,11 +206,28 @@ namespace legion::physics
             m_broadPhase->debugDraw();
         }
 
+        /**@brief Sets the amount of substeps every fixed step is split into.
+         *        More substeps make stiff scenes (stacks, fast bodies, heavy joints) stable without raising the rate at which physics publishes results.
+         */
+        static void setSubsteps(size_type substeps)
+        {
+            m_substeps.store(substeps ? substeps : 1, std::memory_order_relaxed);
+        }
+
+        L_NODISCARD static size_type getSubsteps()
+        {
+            return m_substeps.load(std::memory_order_relaxed);
+        }
+
     private:
 
         static std::unique_ptr<BroadPhaseCollisionAlgorithm> m_broadPhase;
+        static std::atomic<size_type> m_substeps;
         const float m_timeStep = 0.02f;
 
+        std::vector<float> m_transformArrays; // Positions, rotations and scales of all physics entities as math::batch::trs_arrays.
+        std::vector<math::mat4> m_transforms;
+
 
         math::ivec3 uniformGridCellSize = math::ivec3(1, 1, 1);
 
@@ -178,7 +235,7 @@ namespace legion::physics
          * Broadphase Collision Detection, Narrowphase Collision Detection, and the Collision Resolution)
         */
         void runPhysicsPipeline(
-            std::vector<byte>& hasRigidBodies,
+            memory::frame_vector<byte>& hasRigidBodies,
             ecs::component_container<rigidbody>& rigidbodies,
             ecs::component_container<physicsComponent>& physComps,
             ecs::component_container<position>& positions,
@@ -188,18 +245,18 @@ namespace legion::physics
        
         /**@brief given 2 physics_manifold_precursors precursorA and precursorB, create a manifold for each collider in precursorA
         * with every other collider in precursorB. The manifolds that involve rigidbodies are then pushed into the given manifold list
-        * @param manifoldsToSolve [out] a std::vector of physics_manifold that will store the manifolds created
+        * @param manifoldsToSolve [out] a frame_vector of physics_manifold that will store the manifolds created
         * @param isRigidbodyInvolved A bool that indicates whether a rigidbody is involved in this manifold
         * @param isTriggerInvolved A bool that indicates whether a physicsComponent with a physicsComponent::isTrigger set to true is involved in this manifold
         */
-        void constructManifoldsWithPrecursors(ecs::component_container<rigidbody>& rigidbodies, std::vector<byte>& hasRigidBodies, physics_manifold_precursor& precursorA, physics_manifold_precursor& precursorB,
-            std::vector<physics_manifold>& manifoldsToSolve, bool isRigidbodyInvolved, bool isTriggerInvolved);
+        void constructManifoldsWithPrecursors(ecs::component_container<rigidbody>& rigidbodies, memory::frame_vector<byte>& hasRigidBodies, const physics_manifold_precursor& precursorA, const physics_manifold_precursor& precursorB,
+            memory::frame_vector<physics_manifold>& manifoldsToSolve, bool isRigidbodyInvolved, bool isTriggerInvolved);
        
 
         void constructManifoldWithCollider(
-            ecs::component_container<rigidbody>& rigidbodies, std::vector<byte>& hasRigidBodies,
+            ecs::component_container<rigidbody>& rigidbodies, memory::frame_vector<byte>& hasRigidBodies,
             PhysicsCollider* colliderA, PhysicsCollider* colliderB
-            , physics_manifold_precursor& precursorA, physics_manifold_precursor& precursorB, physics_manifold& manifold)
+            , const physics_manifold_precursor& precursorA, const physics_manifold_precursor& precursorB, physics_manifold& manifold)
         {
             OPTICK_EVENT();
             manifold.colliderA = colliderA;
@@ -232,7 +289,7 @@ namespace legion::physics
 
         /** @brief gets all the entities with a rigidbody component and calls the integrate function on them
         */
-        void integrateRigidbodies(std::vector<byte>& hasRigidBodies, ecs::component_container<rigidbody>& rigidbodies, float deltaTime)
+        void integrateRigidbodies(memory::frame_vector<byte>& hasRigidBodies, ecs::component_container<rigidbody>& rigidbodies, float deltaTime)
         {
             OPTICK_EVENT();
             m_scheduler->queueJobs(manifoldPrecursorQuery.size(), [&]() {
@@ -254,7 +311,7 @@ namespace legion::physics
         }
 
         void integrateRigidbodyQueryPositionAndRotation(
-            std::vector<byte>& hasRigidBodies,
+            memory::frame_vector<byte>& hasRigidBodies,
             ecs::component_container<position>& positions,
             ecs::component_container<rotation>& rotations,
             ecs::component_container<rigidbody>& rigidbodies,
@@ -293,7 +350,7 @@ namespace legion::physics
                 }).wait();
         }
 
-        void initializeManifolds(std::vector<physics_manifold>& manifoldsToSolve, std::vector<byte>& manifoldValidity)
+        void initializeManifolds(memory::frame_vector<physics_manifold>& manifoldsToSolve, memory::frame_vector<byte>& manifoldValidity)
         {
             OPTICK_EVENT();
             for (int i = 0; i < manifoldsToSolve.size(); i++)
@@ -312,7 +369,7 @@ namespace legion::physics
             }
         }
 
-        void resolveContactConstraint(std::vector<physics_manifold>& manifoldsToSolve, std::vector<byte>& manifoldValidity, float dt, int contactIter)
+        void resolveContactConstraint(memory::frame_vector<physics_manifold>& manifoldsToSolve, memory::frame_vector<byte>& manifoldValidity, float dt, int contactIter)
         {
             OPTICK_EVENT();
 
@@ -331,7 +388,7 @@ namespace legion::physics
             }
         }
 
-        void resolveFrictionConstraint(std::vector<physics_manifold>& manifoldsToSolve, std::vector<byte>& manifoldValidity)
+        void resolveFrictionConstraint(memory::frame_vector<physics_manifold>& manifoldsToSolve, memory::frame_vector<byte>& manifoldValidity)
         {
             OPTICK_EVENT();
 
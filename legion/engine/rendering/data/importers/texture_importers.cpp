@@ -17,7 +17,7 @@ namespace legion::rendering
         const byte_vec& data = resource.get();
 
         // Setup stb_image settings.
-        stbi_set_flip_vertically_on_load(settings.flipVertical);
+        stbi_set_flip_vertically_on_load_thread(settings.flipVertical);
 
         // Create texture object and store the representation values.
         texture texture{};
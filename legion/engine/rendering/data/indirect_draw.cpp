@@ -0,0 +1,65 @@
+#include <rendering/data/indirect_draw.hpp>
+
+#include <algorithm>
+
+namespace legion::rendering
+{
+    void indirect_draw_list::build(const std::vector<indirect_draw_input>& inputs, const std::vector<const std::vector<sub_mesh>*>& models)
+    {
+        OPTICK_EVENT();
+        clear();
+
+        m_order.clear();
+        m_order.reserve(inputs.size());
+
+        size_type instanceCount = 0;
+        size_type commandCount = 0;
+        for (size_type i = 0; i < inputs.size(); i++)
+        {
+            auto& input = inputs[i];
+            if (!input.instances || input.instances->empty() || !models[input.model] || models[input.model]->empty())
+                continue;
+
+            m_order.push_back(i);
+            instanceCount += input.instances->size();
+            commandCount += models[input.model]->size();
+        }
+
+        // Stable so that the material order within a draw follows the order of the inputs.
+        std::stable_sort(m_order.begin(), m_order.end(), [&](size_type a, size_type b)
+            {
+                return inputs[a].group != inputs[b].group ? inputs[a].group < inputs[b].group : inputs[a].model < inputs[b].model;
+            });
+
+        commands.reserve(commandCount);
+        matrices.reserve(instanceCount);
+        instanceMaterials.reserve(instanceCount);
+
+        for (size_type idx : m_order)
+        {
+            auto& input = inputs[idx];
+
+            if (draws.empty() || draws.back().group != input.group || draws.back().model != input.model)
+                draws.push_back({ input.group, input.model, commands.size(), 0 });
+
+            const uint32 baseInstance = static_cast<uint32>(matrices.size());
+            const uint32 count = static_cast<uint32>(input.instances->size());
+
+            matrices.insert(matrices.end(), input.instances->begin(), input.instances->end());
+            instanceMaterials.insert(instanceMaterials.end(), count, input.material);
+
+            for (auto& submesh : *models[input.model])
+                commands.push_back({ static_cast<uint32>(submesh.indexCount), count, static_cast<uint32>(submesh.indexOffset), 0, baseInstance });
+
+            draws.back().commandCount += models[input.model]->size();
+        }
+    }
+
+    void indirect_draw_list::clear()
+    {
+        commands.clear();
+        matrices.clear();
+        instanceMaterials.clear();
+        draws.clear();
+    }
+}
@@ -0,0 +1,82 @@
+#pragma once
+#include <core/core.hpp>
+
+#include <vector>
+
+/**
+ * @file indirect_draw.hpp
+ * @brief CPU side building of indirect draw commands, the result can be drawn with one glMultiDrawElementsIndirect per draw.
+ *        Doesn't touch the rendering context so it can be run and benchmarked without one.
+ */
+
+namespace legion::rendering
+{
+    /**@brief Layout of a single command in a GL_DRAW_INDIRECT_BUFFER for glMultiDrawElementsIndirect.
+     */
+    struct draw_elements_indirect_command
+    {
+        uint32 count;
+        uint32 instanceCount;
+        uint32 firstIndex;
+        int32 baseVertex;
+        uint32 baseInstance;
+    };
+
+    /**@brief Instances of one model that get drawn with one material.
+     */
+    struct indirect_draw_input
+    {
+        /**@brief Draw group, all inputs of a group get drawn with the same bound material.
+         */
+        size_type group;
+        /**@brief Index of the material within the material table of the group, ends up in instanceMaterials.
+         */
+        uint32 material;
+        /**@brief Index into the list of sub-meshes passed to build.
+         */
+        size_type model;
+        const std::vector<math::mat4>* instances;
+    };
+
+    /**@class indirect_draw_list
+     * @brief Flattens a set of draw inputs into indirect commands, one per sub-mesh per input.
+     *        Inputs of the same group and model get merged into a single draw.
+     */
+    class indirect_draw_list
+    {
+    public:
+        /**@brief Range of commands that can be drawn with a single glMultiDrawElementsIndirect.
+         */
+        struct draw
+        {
+            size_type group;
+            size_type model;
+            size_type firstCommand;
+            size_type commandCount;
+        };
+
+        /**@brief Commands of all draws, baseInstance points to the first matrix of the input the command belongs to.
+         */
+        std::vector<draw_elements_indirect_command> commands;
+        /**@brief Model matrices of all instances, in the order the commands refer to them.
+         */
+        std::vector<math::mat4> matrices;
+        /**@brief Material index of every instance, shaders can fetch it with gl_BaseInstance + gl_InstanceID.
+         */
+        std::vector<uint32> instanceMaterials;
+        /**@brief Draws sorted by group and then by model.
+         */
+        std::vector<draw> draws;
+
+        /**@brief Rebuild the list, reuses the allocations of the previous build.
+         * @param inputs Inputs to draw, inputs without instances are skipped.
+         * @param models Sub-meshes of every model referenced by the inputs.
+         */
+        void build(const std::vector<indirect_draw_input>& inputs, const std::vector<const std::vector<sub_mesh>*>& models);
+
+        void clear();
+
+    private:
+        std::vector<size_type> m_order;
+    };
+}
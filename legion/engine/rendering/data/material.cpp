@@ -1,4 +1,5 @@
 #include <rendering/data/material.hpp>
+#include <core/filesystem/hot_reload.hpp>
 
 namespace legion::rendering
 {
@@ -7,6 +8,7 @@ namespace legion::rendering
         switch (type)
         {
         case GL_SAMPLER_2D:
+        case GL_SAMPLER_2D_ARRAY:
             return new material_parameter<texture_handle>(name, location);
         case GL_FLOAT:
             return new material_parameter<float>(name, location);
@@ -93,6 +95,7 @@ namespace legion::rendering
         }
 
         m_materials[id].m_name = name;
+        watch_material(id, shader.id);
 
         log::debug("Created material {} with shader: {}", name, shader.get_name());
 
@@ -121,12 +124,41 @@ namespace legion::rendering
 
         m_materials[id].init(shader);
         m_materials[id].m_name = name;
+        watch_material(id, shader.id);
 
         log::debug("Created material {} with shader: {}", name, shader.get_name());
 
         return { id };
     }
 
+    void MaterialCache::watch_material(id_type id, id_type shaderId)
+    {
+        if (!fs::hot_reload::enabled())
+            return;
+
+        const std::string node = fs::hot_reload::entry_node("material", id);
+        fs::hot_reload::add_dependency(node, fs::hot_reload::entry_node("shader", shaderId));
+        fs::hot_reload::on_reload(node, [id]() { reload_material(id); });
+    }
+
+    void MaterialCache::track_texture(id_type id, const texture_handle& texture)
+    {
+        if (fs::hot_reload::enabled() && texture.id != invalid_id)
+            fs::hot_reload::add_dependency(fs::hot_reload::entry_node("material", id), fs::hot_reload::entry_node("texture", texture.id));
+    }
+
+    void MaterialCache::reload_material(id_type id)
+    {
+        // Queued after the commit of the shader or texture that changed, so the refresh sees the new uniforms.
+        fs::hot_reload::commit(nameHash("Rendering"), [id]()
+            {
+                async::readwrite_guard guard(m_materialLock);
+                auto it = m_materials.find(id);
+                if (it != m_materials.end())
+                    it->second.refresh();
+            });
+    }
+
     std::pair<async::rw_spinlock&, std::unordered_map<id_type, material>&> MaterialCache::get_all_materials()
     {
         return std::make_pair(std::ref(m_materialLock), std::ref(m_materials));
@@ -210,6 +242,24 @@ namespace legion::rendering
         return MaterialCache::m_materials[id].get_params();
     }
 
+    size_type material_handle::table_entry_size()
+    {
+        async::readonly_guard guard(MaterialCache::m_materialLock);
+        return MaterialCache::m_materials[id].table_entry_size();
+    }
+
+    void material_handle::write_table_entry(byte* entry)
+    {
+        async::readonly_guard guard(MaterialCache::m_materialLock);
+        MaterialCache::m_materials[id].write_table_entry(entry);
+    }
+
+    std::vector<material_array_texture> material_handle::get_array_textures()
+    {
+        async::readonly_guard guard(MaterialCache::m_materialLock);
+        return MaterialCache::m_materials[id].get_array_textures();
+    }
+
     attribute material_handle::get_attribute(const std::string& name)
     {
         async::readonly_guard guard(MaterialCache::m_materialLock);
@@ -250,11 +300,216 @@ namespace legion::rendering
             m_currentVariant = 0;
     }
 
+    void material::refresh()
+    {
+        auto previous = std::move(m_variants);
+        m_variants.clear();
+        m_generation++;
+
+        for (auto& [variantId, variantInfo] : m_shader.get_uniform_info())
+        {
+            const shader_variant& shaderVariant = m_shader.get_variant(variantId);
+            const material_block_info& blockInfo = shaderVariant.materialBlock;
+
+            variant_submaterial& variant = m_variants[variantId];
+            variant.name = shaderVariant.name;
+            variant.block = std::make_unique<material_parameter_block>();
+            variant.block->data.resize(static_cast<size_type>(blockInfo.size), 0);
+
+            auto& previousParams = previous[variantId].parameters;
+
+            // Reuses the previous parameter if it still has the same type, so it keeps it's value.
+            auto addParam = [&](const std::string& name, GLint location, GLenum type) -> material_parameter_base*
+            {
+                id_type hash = nameHash(name);
+                std::unique_ptr<material_parameter_base> param(material_parameter_base::create_param(name, location, type));
+                if (!param)
+                    return nullptr;
+
+                // Already added from another source, for example a texture array that also has a layer member in the material table.
+                auto existing = variant.parameters.find(hash);
+                if (existing != variant.parameters.end())
+                    return existing->second->type() == param->type() ? existing->second.get() : nullptr;
+
+                auto it = previousParams.find(hash);
+                if (it != previousParams.end() && it->second && it->second->type() == param->type())
+                {
+                    param = std::move(it->second);
+                    param->m_location = location;
+                    param->m_offset = -1;
+                    param->m_tableOffset = -1;
+                }
+
+                param->m_block = variant.block.get();
+                return variant.parameters.insert_or_assign(hash, std::move(param)).first->second.get();
+            };
+
+            for (auto& [name, location, type] : variantInfo)
+            {
+                material_parameter_base* param = addParam(name, location, type);
+                if (!param)
+                    continue;
+
+                variant.idOfLocation[location] = param->m_id;
+
+                if (type == GL_SAMPLER_2D_ARRAY)
+                    variant.arrayTextures.push_back(param);
+                else if (param->type() == typeHash<texture_handle>())
+                    variant.textures.push_back(param);
+                else
+                    variant.uniforms.push_back(param);
+            }
+
+            for (auto& member : blockInfo.members)
+            {
+                material_parameter_base* param = addParam(member.name, -1, member.type);
+                if (!param)
+                    continue;
+
+                param->m_offset = member.offset;
+                param->m_matrixStride = member.matrixStride;
+                param->m_rowMajor = member.rowMajor;
+                param->write_block();
+            }
+
+            const material_block_info& tableInfo = shaderVariant.materialTable;
+            variant.tableEntrySize = static_cast<size_type>(tableInfo.size);
+
+            for (auto& member : tableInfo.members)
+            {
+                // Members named after a texture array hold the layer of the texture of this material.
+                auto existing = variant.parameters.find(nameHash(member.name));
+                material_parameter_base* param = nullptr;
+                if (existing != variant.parameters.end() && existing->second->type() == typeHash<texture_handle>())
+                    param = existing->second.get();
+                else
+                    param = addParam(member.name, -1, member.type);
+
+                if (!param)
+                    continue;
+
+                param->m_tableOffset = member.offset;
+                param->m_tableMatrixStride = member.matrixStride;
+                param->m_tableRowMajor = member.rowMajor;
+                variant.tableParameters.push_back(param);
+            }
+        }
+
+        if (!m_shader.has_variant(m_currentVariant))
+            m_currentVariant = 0;
+    }
+
+    variant_submaterial* material::current_submaterial()
+    {
+        if (m_currentVariant == 0)
+            m_currentVariant = nameHash("default");
+
+        auto it = m_variants.find(m_currentVariant);
+        return it == m_variants.end() ? nullptr : &it->second;
+    }
+
+    size_type material::table_entry_size()
+    {
+        auto* submaterial = current_submaterial();
+        return submaterial ? submaterial->tableEntrySize : 0;
+    }
+
+    void material::write_table_entry(byte* entry)
+    {
+        auto* submaterial = current_submaterial();
+        if (!submaterial)
+            return;
+
+        detail::table_entry_writer writer{ entry, submaterial->tableEntrySize };
+        for (auto* param : submaterial->tableParameters)
+            param->write_table(writer);
+    }
+
+    std::vector<material_array_texture> material::get_array_textures()
+    {
+        std::vector<material_array_texture> textures;
+
+        auto* submaterial = current_submaterial();
+        if (!submaterial)
+            return textures;
+
+        textures.reserve(submaterial->arrayTextures.size());
+        for (auto* param : submaterial->arrayTextures)
+            textures.push_back({ param->m_id, static_cast<material_parameter<texture_handle>*>(param)->get_value(), param->m_tableOffset });
+        return textures;
+    }
+
     void material::bind()
     {
+        auto* current = current_submaterial();
+
         m_shader.configure_variant(m_currentVariant);
         m_shader.bind();
-        for (auto& [_, param] : m_variants[m_currentVariant].parameters)
+
+        if (!current)
+            return;
+
+        variant_submaterial& submaterial = *current;
+        material_parameter_block& block = *submaterial.block;
+
+        // The program keeps the values of plain uniforms, so they only need to be sent again if they changed
+        // or if another material used the program in the meantime.
+        shader_variant& shaderVariant = m_shader.get_variant(m_currentVariant);
+        if (block.uniformsDirty || shaderVariant.boundParameters != &block)
+        {
+            for (auto* param : submaterial.uniforms)
+                param->apply(m_shader);
+
+            block.uniformsDirty = false;
+            shaderVariant.boundParameters = &block;
+        }
+
+        // Texture units are shared between all programs.
+        for (auto* param : submaterial.textures)
             param->apply(m_shader);
+
+        block.upload();
+    }
+
+    void material_parameter_block::write(size_type offset, const void* src, size_type size)
+    {
+        if (offset + size > data.size())
+            return;
+
+        byte* dst = data.data() + offset;
+        if (std::memcmp(dst, src, size) == 0)
+            return;
+
+        std::memcpy(dst, src, size);
+
+        if (dirtyBegin == dirtyEnd)
+        {
+            dirtyBegin = offset;
+            dirtyEnd = offset + size;
+        }
+        else
+        {
+            dirtyBegin = std::min(dirtyBegin, offset);
+            dirtyEnd = std::max(dirtyEnd, offset + size);
+        }
+    }
+
+    void material_parameter_block::upload()
+    {
+        if (data.empty())
+            return;
+
+        if (!uniformBuffer.id())
+        {
+            uniformBuffer = buffer(GL_UNIFORM_BUFFER, data.size(), data.data(), GL_DYNAMIC_DRAW);
+            dirtyBegin = dirtyEnd = 0;
+        }
+        else if (dirtyBegin != dirtyEnd)
+        {
+            uniformBuffer.bufferData(dirtyBegin, dirtyEnd - dirtyBegin, data.data() + dirtyBegin);
+            dirtyBegin = dirtyEnd = 0;
+        }
+
+        uniformBuffer.bindBufferBase(SV_MATERIALPARAMS);
     }
 }
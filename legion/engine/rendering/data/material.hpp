@@ -1,6 +1,8 @@
 #pragma once
 #include <rendering/data/shader.hpp>
+#include <rendering/data/buffer.hpp>
 #include <memory>
+#include <cstring>
 #include <core/filesystem/filesystem.hpp>
 #include <rendering/util/matini.hpp>
 
@@ -12,6 +14,78 @@ namespace legion::rendering
 {
     struct material;
 
+    /**@class material_parameter_block
+     * @brief Parameter storage of a material for one shader variant.
+     *        Keeps a std140 copy of the material uniform block together with the range that changed since the last upload,
+     *        and whether any of the parameters that are plain uniforms changed since they were last sent to the program.
+     */
+    struct material_parameter_block
+    {
+        byte_vec data;
+        size_type dirtyBegin = 0;
+        size_type dirtyEnd = 0;
+        bool uniformsDirty = true;
+        buffer uniformBuffer;
+
+        /**@brief Write into the std140 copy, only bytes that actually change mark the block as dirty.
+         */
+        void write(size_type offset, const void* src, size_type size);
+
+        /**@brief Upload the dirty range of the block, if there is any, and bind the block to SV_MATERIALPARAMS.
+         * @note Needs to be called with a current rendering context.
+         */
+        void upload();
+    };
+
+    namespace detail
+    {
+        /**@brief Writes into a single entry of a material table.
+         */
+        struct table_entry_writer
+        {
+            byte* entry;
+            size_type size;
+
+            void write(size_type offset, const void* src, size_type count)
+            {
+                if (offset + count <= size)
+                    std::memcpy(entry + offset, src, count);
+            }
+        };
+
+        /**@brief Writes a value with the std140 layout of it's type, which is the same as std430 for everything but arrays.
+         * @param target Either a material_parameter_block or a table_entry_writer.
+         */
+        template<typename T, typename Target>
+        void write_std140(Target& block, GLint offset, GLint matrixStride, bool rowMajor, const T& value)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                // Booleans take up 4 bytes in std140.
+                const uint32 data = value ? 1u : 0u;
+                block.write(offset, &data, sizeof(data));
+            }
+            else if constexpr (std::is_same_v<T, math::bvec2> || std::is_same_v<T, math::bvec3> || std::is_same_v<T, math::bvec4>)
+            {
+                uint32 data[T::length()];
+                for (int i = 0; i < T::length(); i++)
+                    data[i] = value[i] ? 1u : 0u;
+                block.write(offset, data, sizeof(data));
+            }
+            else if constexpr (std::is_same_v<T, math::mat2> || std::is_same_v<T, math::mat3> || std::is_same_v<T, math::mat4>)
+            {
+                // Every column (or row if the block is row major) starts at a multiple of the matrix stride.
+                const T matrix = rowMajor ? math::transpose(value) : value;
+                for (int i = 0; i < T::length(); i++)
+                    block.write(offset + i * matrixStride, &matrix[i], sizeof(matrix[i]));
+            }
+            else
+            {
+                block.write(offset, &value, sizeof(T));
+            }
+        }
+    }
+
     /**@class material_parameter_base
      * @brief material parameter common base
      */
@@ -26,8 +100,25 @@ namespace legion::rendering
         id_type m_typeId;
         GLint m_location;
 
+        material_parameter_block* m_block = nullptr;
+        GLint m_offset = -1;
+        GLint m_matrixStride = 0;
+        bool m_rowMajor = false;
+
+        GLint m_tableOffset = -1;
+        GLint m_tableMatrixStride = 0;
+        bool m_tableRowMajor = false;
+
         material_parameter_base(const std::string& name, GLint location, id_type typeId) : m_name(name), m_id(nameHash(name)), m_typeId(typeId), m_location(location) {}
 
+        /**@brief Write the current value into the material uniform block, if the parameter lives in it.
+         */
+        virtual void write_block() LEGION_PURE;
+
+        /**@brief Write the current value into an entry of the material table, if the parameter is part of it.
+         */
+        virtual void write_table(detail::table_entry_writer& entry) const LEGION_PURE;
+
     public:
         /**@brief Get the type hash of the variable type of this parameter.
          */
@@ -37,6 +128,10 @@ namespace legion::rendering
          */
         L_NODISCARD std::string get_name() const { return m_name; }
 
+        /**@brief Whether the parameter lives in the material uniform block instead of being a plain uniform.
+         */
+        L_NODISCARD bool in_block() const { return m_offset >= 0; }
+
         /**@internal
          */
         virtual void apply(shader_handle& shader) LEGION_PURE;
@@ -53,16 +148,41 @@ namespace legion::rendering
     {
         friend struct material;
     private:
-        T m_value;
+        T m_value{};
 
         virtual void apply(shader_handle& shader) override
         {
             shader.get_uniform<T>(m_id).set_value(m_value);
         }
+
+        virtual void write_block() override
+        {
+            if (m_block && in_block())
+                detail::write_std140(*m_block, m_offset, m_matrixStride, m_rowMajor, m_value);
+        }
+
+        virtual void write_table(detail::table_entry_writer& entry) const override
+        {
+            // Textures in the table are layers of texture arrays, those get written by the material table itself.
+            if constexpr (!std::is_same_v<T, texture_handle>)
+                if (m_tableOffset >= 0)
+                    detail::write_std140(entry, m_tableOffset, m_tableMatrixStride, m_tableRowMajor, m_value);
+        }
     public:
         material_parameter(const std::string& name, GLint location) : material_parameter_base(name, location, typeHash<T>()) {}
 
-        void set_value(const T& value) { m_value = value; }
+        void set_value(const T& value)
+        {
+            if constexpr (!std::is_same_v<T, texture_handle>)
+            {
+                if (m_block && !in_block() && !(m_value == value))
+                    m_block->uniformsDirty = true;
+            }
+
+            m_value = value;
+            write_block();
+        }
+
         T get_value() const { return m_value; }
     };
 
@@ -71,6 +191,58 @@ namespace legion::rendering
         std::string name;
         std::unordered_map<id_type, std::unique_ptr<material_parameter_base>> parameters;
         std::unordered_map<GLint, id_type> idOfLocation;
+
+        std::unique_ptr<material_parameter_block> block;
+        std::vector<material_parameter_base*> uniforms;
+        std::vector<material_parameter_base*> textures;
+
+        size_type tableEntrySize = 0;
+        std::vector<material_parameter_base*> tableParameters;
+        std::vector<material_parameter_base*> arrayTextures;
+    };
+
+    /**@brief Texture of a material that gets sampled from a texture array when drawing with a material table.
+     */
+    struct material_array_texture
+    {
+        id_type id;
+        texture_handle texture;
+        /**@brief Offset of the layer index within a table entry, -1 if the table has no member for it.
+         */
+        GLint tableOffset;
+    };
+
+    /**@class material_parameter_handle
+     * @brief Handle to a single parameter of a material, the parameter gets looked up once instead of hashing it's name on every access.
+     *        Gets looked up again when the material was refreshed after it's shader got reloaded.
+     * @tparam T Variable type of the parameter.
+     */
+    template<typename T>
+    struct material_parameter_handle
+    {
+        id_type materialId = invalid_id;
+        id_type variantId = 0;
+        id_type parameterId = invalid_id;
+
+        material_parameter_handle() = default;
+        material_parameter_handle(id_type material, id_type variant, id_type parameter) : materialId(material), variantId(variant), parameterId(parameter) {}
+
+        /**@brief Check whether the material has the parameter with the type of this handle.
+         */
+        L_NODISCARD bool is_valid() const;
+
+        void set_value(const T& value);
+        L_NODISCARD T get_value() const;
+
+    private:
+        mutable material* m_material = nullptr;
+        mutable material_parameter<T>* m_parameter = nullptr;
+        mutable size_type m_generation = 0;
+
+        /**@brief Looks the parameter up again if the material changed since the last time.
+         * @note Expects the material lock to be held.
+         */
+        material_parameter<T>* resolve() const;
     };
 
     /**@class material
@@ -81,27 +253,31 @@ namespace legion::rendering
     {
         friend class MaterialCache;
         friend struct material_handle;
+        template<typename T>
+        friend struct material_parameter_handle;
     private:
         shader_handle m_shader;
         bool m_canLoadOrSave = true;
 
-
         void init(const shader_handle& shader)
         {
             m_shader = shader;
-            for (auto& [variantId, variantInfo] : m_shader.get_uniform_info())
-                for (auto& [name, location, type] : variantInfo)
-                {
-                    id_type hash = nameHash(name);
-                    m_variants[variantId].name = m_shader.get_variant(variantId).name;
-                    m_variants[variantId].parameters.emplace(hash, material_parameter_base::create_param(name, location, type));
-                    m_variants[variantId].idOfLocation[location] = hash;
-                }
+            refresh();
         }
 
+        /**@brief Rebuilds the parameters after the shader got reloaded, values of parameters that still exist with the same type are kept.
+         */
+        void refresh();
+
         std::string m_name;
         id_type m_currentVariant = 0;
         std::unordered_map<id_type, variant_submaterial> m_variants;
+
+        /**@brief Incremented every time the parameters get rebuilt, invalidates the parameter handles.
+         */
+        size_type m_generation = 0;
+
+        variant_submaterial* current_submaterial();
     public:
 
         id_type current_variant() const;
@@ -122,6 +298,18 @@ namespace legion::rendering
             shader_handle::release();
         }
 
+        /**@brief Size of an entry in the material table of the current variant, 0 if the variant doesn't read from a material table.
+         */
+        L_NODISCARD size_type table_entry_size();
+
+        /**@brief Write the parameters of the current variant into an entry of the material table.
+         */
+        void write_table_entry(byte* entry);
+
+        /**@brief Textures of the current variant that get sampled from texture arrays.
+         */
+        L_NODISCARD std::vector<material_array_texture> get_array_textures();
+
         /**@brief Set the value of a parameter by name.
          */
         template<typename T>
@@ -235,6 +423,24 @@ namespace legion::rendering
         template<typename T>
         L_NODISCARD T get_param(GLint location);
 
+        /**@brief Size of an entry in the material table of the current variant, 0 if the variant doesn't read from a material table.
+         */
+        L_NODISCARD size_type table_entry_size();
+
+        /**@brief Write the parameters of the current variant into an entry of the material table.
+         */
+        void write_table_entry(byte* entry);
+
+        /**@brief Textures of the current variant that get sampled from texture arrays.
+         */
+        L_NODISCARD std::vector<material_array_texture> get_array_textures();
+
+        /**@brief Get a handle to a parameter of the current variant by name.
+         *        Prefer it over set_param and get_param for parameters that get accessed often.
+         */
+        template<typename T>
+        L_NODISCARD material_parameter_handle<T> get_param_handle(const std::string& name) const;
+
         L_NODISCARD const std::string& get_name() const;
 
         L_NODISCARD const std::unordered_map<id_type, std::unique_ptr<material_parameter_base>>& get_params();
@@ -267,12 +473,21 @@ namespace legion::rendering
     class MaterialCache
     {
         friend struct material_handle;
+        template<typename T>
+        friend struct material_parameter_handle;
     private:
         static async::rw_spinlock m_materialLock;
         static std::unordered_map<id_type, material> m_materials;
 
         static material_handle m_invalid_material;
 
+        static void watch_material(id_type id, id_type shaderId);
+        static void track_texture(id_type id, const texture_handle& texture);
+
+        /**@brief Refreshes the parameters of a material on the rendering thread after it's shader or one of it's textures got reloaded.
+         */
+        static void reload_material(id_type id);
+
     public:
         /**@brief Create a new material with a certain name and shader.
          *        If a material already exists with that name it'll return a handle to the already existing material.
@@ -303,8 +518,13 @@ namespace legion::rendering
         OPTICK_EVENT();
         OPTICK_TAG("Name", name.c_str());
 
-        async::readonly_guard guard(MaterialCache::m_materialLock);
-        MaterialCache::m_materials[id].set_param<T>(name, value);
+        {
+            async::readonly_guard guard(MaterialCache::m_materialLock);
+            MaterialCache::m_materials[id].set_param<T>(name, value);
+        }
+
+        if constexpr (std::is_same_v<T, texture_handle>)
+            MaterialCache::track_texture(id, value);
     }
 
     template<typename T>
@@ -313,8 +533,13 @@ namespace legion::rendering
         OPTICK_EVENT();
         OPTICK_TAG("Location", location);
 
-        async::readonly_guard guard(MaterialCache::m_materialLock);
-        MaterialCache::m_materials[id].set_param<T>(location, value);
+        {
+            async::readonly_guard guard(MaterialCache::m_materialLock);
+            MaterialCache::m_materials[id].set_param<T>(location, value);
+        }
+
+        if constexpr (std::is_same_v<T, texture_handle>)
+            MaterialCache::track_texture(id, value);
     }
 
     template<typename T>
@@ -345,6 +570,77 @@ namespace legion::rendering
         return MaterialCache::m_materials[id].get_param<T>(location);
     }
 
+    template<typename T>
+    L_NODISCARD material_parameter_handle<T> material_handle::get_param_handle(const std::string& name) const
+    {
+        id_type variantId = current_variant();
+        if (variantId == 0)
+            variantId = nameHash("default");
+
+        return material_parameter_handle<T>(id, variantId, nameHash(name));
+    }
+
+    template<typename T>
+    material_parameter<T>* material_parameter_handle<T>::resolve() const
+    {
+        if (m_parameter && m_material->m_generation == m_generation)
+            return m_parameter;
+
+        m_parameter = nullptr;
+
+        auto materialIt = MaterialCache::m_materials.find(materialId);
+        if (materialIt == MaterialCache::m_materials.end())
+            return nullptr;
+
+        m_material = &materialIt->second;
+        m_generation = m_material->m_generation;
+
+        auto variantIt = m_material->m_variants.find(variantId);
+        if (variantIt == m_material->m_variants.end())
+            return nullptr;
+
+        auto paramIt = variantIt->second.parameters.find(parameterId);
+        if (paramIt == variantIt->second.parameters.end() || !paramIt->second || paramIt->second->type() != typeHash<T>())
+            return nullptr;
+
+        m_parameter = static_cast<material_parameter<T>*>(paramIt->second.get());
+        return m_parameter;
+    }
+
+    template<typename T>
+    L_NODISCARD bool material_parameter_handle<T>::is_valid() const
+    {
+        async::readonly_guard guard(MaterialCache::m_materialLock);
+        return resolve() != nullptr;
+    }
+
+    template<typename T>
+    void material_parameter_handle<T>::set_value(const T& value)
+    {
+        OPTICK_EVENT();
+        {
+            async::readonly_guard guard(MaterialCache::m_materialLock);
+            if (auto* param = resolve())
+                param->set_value(value);
+            else
+                log::warn("material parameter {} of type {} does not exist", parameterId, nameOfType<T>());
+        }
+
+        if constexpr (std::is_same_v<T, texture_handle>)
+            MaterialCache::track_texture(materialId, value);
+    }
+
+    template<typename T>
+    L_NODISCARD T material_parameter_handle<T>::get_value() const
+    {
+        async::readonly_guard guard(MaterialCache::m_materialLock);
+        if (auto* param = resolve())
+            return param->get_value();
+
+        log::warn("material parameter {} of type {} does not exist", parameterId, nameOfType<T>());
+        return T();
+    }
+
     template<>
     inline void material::set_param<math::color>(const std::string& name, const math::color& value)
     {
@@ -0,0 +1,175 @@
+#include <rendering/data/material_table.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace legion::rendering
+{
+    material_table::~material_table()
+    {
+        if (!app::ContextHelper::initialized())
+            return;
+
+        for (auto& [_, array] : m_arrays)
+            glDeleteTextures(1, &array.id);
+    }
+
+    id_type material_table::group_key(material_handle material)
+    {
+        OPTICK_EVENT();
+        if (material.table_entry_size() == 0)
+            return invalid_id;
+
+        size_t seed = 0;
+        math::detail::hash_combine(seed, static_cast<size_t>(material.get_shader().id));
+        math::detail::hash_combine(seed, static_cast<size_t>(material.current_variant()));
+
+        for (auto& arrayTexture : material.get_array_textures())
+        {
+            const texture_info info = get_info(arrayTexture.texture.get_texture().textureId);
+            math::detail::hash_combine(seed, static_cast<size_t>(arrayTexture.id));
+            math::detail::hash_combine(seed, static_cast<size_t>(info.size.x));
+            math::detail::hash_combine(seed, static_cast<size_t>(info.size.y));
+            math::detail::hash_combine(seed, static_cast<size_t>(info.internalFormat));
+        }
+
+        const id_type key = static_cast<id_type>(seed);
+        return key == invalid_id ? key + 1 : key;
+    }
+
+    void material_table::bind(std::vector<material_handle>& materials)
+    {
+        OPTICK_EVENT();
+        if (materials.empty())
+            return;
+
+        const size_type entrySize = materials.front().table_entry_size();
+        if (entrySize == 0)
+            return;
+
+        m_data.assign(entrySize * materials.size(), 0);
+
+        const std::vector<material_array_texture> arrayTextures = materials.front().get_array_textures();
+        m_layers.resize(arrayTextures.size());
+        for (auto& layers : m_layers)
+            layers.clear();
+
+        for (size_type i = 0; i < materials.size(); i++)
+        {
+            byte* entry = m_data.data() + i * entrySize;
+            materials[i].write_table_entry(entry);
+
+            for (auto& arrayTexture : materials[i].get_array_textures())
+            {
+                auto slot = std::find_if(arrayTextures.begin(), arrayTextures.end(), [&](const material_array_texture& t) { return t.id == arrayTexture.id; });
+                if (slot == arrayTextures.end())
+                    continue;
+
+                // Materials that share a texture share it's layer as well.
+                auto& layers = m_layers[static_cast<size_type>(slot - arrayTextures.begin())];
+                const app::gl_id textureId = arrayTexture.texture.get_texture().textureId;
+
+                auto layerIt = std::find(layers.begin(), layers.end(), textureId);
+                const int32 layer = static_cast<int32>(layerIt - layers.begin());
+                if (layerIt == layers.end())
+                    layers.push_back(textureId);
+
+                if (arrayTexture.tableOffset >= 0 && arrayTexture.tableOffset + sizeof(int32) <= entrySize)
+                    std::memcpy(entry + arrayTexture.tableOffset, &layer, sizeof(layer));
+            }
+        }
+
+        if (!m_buffer.id())
+            m_buffer = buffer(GL_SHADER_STORAGE_BUFFER, m_data.size(), m_data.data(), GL_DYNAMIC_DRAW);
+        else
+            m_buffer.bufferData(m_data.size(), m_data.data());
+        m_buffer.bindBufferBase(SV_MATERIALS);
+
+        shader_handle shader = materials.front().get_shader();
+        for (size_type i = 0; i < arrayTextures.size(); i++)
+        {
+            if (m_layers[i].empty())
+                continue;
+
+            shader.get_uniform<texture_handle>(arrayTextures[i].id).bind_texture(GL_TEXTURE_2D_ARRAY, get_array(m_layers[i]));
+        }
+    }
+
+    void material_table::collect_garbage()
+    {
+        OPTICK_EVENT();
+        for (auto it = m_arrays.begin(); it != m_arrays.end();)
+        {
+            if (it->second.used)
+            {
+                it->second.used = false;
+                ++it;
+                continue;
+            }
+
+            glDeleteTextures(1, &it->second.id);
+            it = m_arrays.erase(it);
+        }
+
+        // Textures can get resized in place, so the sizes are only trusted for a single frame.
+        m_textureInfo.clear();
+    }
+
+    material_table::texture_info material_table::get_info(app::gl_id textureId)
+    {
+        auto it = m_textureInfo.find(textureId);
+        if (it != m_textureInfo.end())
+            return it->second;
+
+        texture_info info;
+        glGetTextureLevelParameteriv(textureId, 0, GL_TEXTURE_WIDTH, &info.size.x);
+        glGetTextureLevelParameteriv(textureId, 0, GL_TEXTURE_HEIGHT, &info.size.y);
+        glGetTextureLevelParameteriv(textureId, 0, GL_TEXTURE_INTERNAL_FORMAT, &info.internalFormat);
+
+        m_textureInfo.emplace(textureId, info);
+        return info;
+    }
+
+    app::gl_id material_table::get_array(const std::vector<app::gl_id>& layers)
+    {
+        const texture_info info = get_info(layers.front());
+
+        size_t seed = 0;
+        for (app::gl_id layer : layers)
+            math::detail::hash_combine(seed, static_cast<size_t>(layer));
+        math::detail::hash_combine(seed, static_cast<size_t>(info.size.x));
+        math::detail::hash_combine(seed, static_cast<size_t>(info.size.y));
+        math::detail::hash_combine(seed, static_cast<size_t>(info.internalFormat));
+        const id_type key = static_cast<id_type>(seed);
+
+        auto it = m_arrays.find(key);
+        if (it != m_arrays.end())
+        {
+            it->second.used = true;
+            return it->second.id;
+        }
+
+        OPTICK_EVENT("Build texture array");
+        GLsizei levels = 1;
+        while ((std::max(info.size.x, info.size.y) >> levels) > 0)
+            levels++;
+
+        app::gl_id arrayId;
+        glGenTextures(1, &arrayId);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, arrayId);
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, levels, info.internalFormat, info.size.x, info.size.y, static_cast<GLsizei>(layers.size()));
+
+        for (size_type i = 0; i < layers.size(); i++)
+            glCopyImageSubData(layers[i], GL_TEXTURE_2D, 0, 0, 0, 0, arrayId, GL_TEXTURE_2D_ARRAY, 0, 0, 0, static_cast<GLint>(i), info.size.x, info.size.y, 1);
+
+        glGenerateMipmap(GL_TEXTURE_2D_ARRAY);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+        m_arrays.emplace(key, texture_array{ arrayId, true });
+        return arrayId;
+    }
+}
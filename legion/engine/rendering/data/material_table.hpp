@@ -0,0 +1,75 @@
+#pragma once
+#include <rendering/data/material.hpp>
+#include <rendering/data/buffer.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file material_table.hpp
+ * @brief Shaders that declare a storage buffer bound to SV_MATERIALS read their material parameters from a table instead of uniforms,
+ *        which allows instances of different materials with the same shader to be drawn together. The instance at gl_BaseInstance + gl_InstanceID
+ *        finds the index of it's material in the storage buffer bound to SV_INSTANCEMATERIALS:
+ *
+ *        struct MaterialEntry { int albedo; float roughness; };
+ *        layout(std430, binding = SV_MATERIALS) readonly buffer MaterialTable { MaterialEntry materials[]; };
+ *        layout(std430, binding = SV_INSTANCEMATERIALS) readonly buffer InstanceMaterials { uint instanceMaterials[]; };
+ *        uniform sampler2DArray albedo;
+ *
+ *        Textures are sampled from texture arrays that get built from the textures of all materials in a group,
+ *        an int member with the same name as a sampler2DArray uniform receives the layer of the texture of the material.
+ */
+
+namespace legion::rendering
+{
+    /**@class material_table
+     * @brief Builds, uploads and binds the material table and texture arrays for groups of materials that get drawn together.
+     * @note Everything except group_key needs a current rendering context.
+     */
+    class material_table
+    {
+    public:
+        material_table() = default;
+        material_table(const material_table&) = delete;
+        material_table& operator=(const material_table&) = delete;
+        ~material_table();
+
+        /**@brief Key that's equal for materials that can be drawn together: same shader variant and the same size and format of all their array textures.
+         * @return Key of the group or invalid_id if the material doesn't read from a material table.
+         */
+        L_NODISCARD id_type group_key(material_handle material);
+
+        /**@brief Fill the table with the parameters of a group of materials and bind it, together with the texture arrays of the group.
+         *        Entry i of the table belongs to materials[i], the first material needs to be bound already.
+         */
+        void bind(std::vector<material_handle>& materials);
+
+        /**@brief Release texture arrays that weren't used since the previous call, call once per frame.
+         */
+        void collect_garbage();
+
+    private:
+        struct texture_info
+        {
+            math::ivec2 size;
+            GLint internalFormat;
+        };
+
+        struct texture_array
+        {
+            app::gl_id id;
+            bool used;
+        };
+
+        texture_info get_info(app::gl_id textureId);
+        app::gl_id get_array(const std::vector<app::gl_id>& layers);
+
+        std::unordered_map<app::gl_id, texture_info> m_textureInfo;
+        std::unordered_map<id_type, texture_array> m_arrays;
+
+        byte_vec m_data;
+        buffer m_buffer;
+
+        std::vector<std::vector<app::gl_id>> m_layers;
+    };
+}
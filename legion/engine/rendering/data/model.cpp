@@ -1,5 +1,6 @@
 #include <rendering/data/model.hpp>
 #include <rendering/data/material.hpp>
+#include <core/filesystem/hot_reload.hpp>
 #include <map>
 #include <string>
 #include <fstream>
@@ -111,6 +112,38 @@ namespace legion::rendering
         model.buffered = true;
     }
 
+    void ModelCache::watch_model(id_type id, id_type meshId)
+    {
+        if (!fs::hot_reload::enabled())
+            return;
+
+        const std::string node = fs::hot_reload::entry_node("model", id);
+        fs::hot_reload::add_dependency(node, fs::hot_reload::entry_node("mesh", meshId));
+        fs::hot_reload::on_reload(node, [id, meshId]() { reload_model(id, meshId); });
+    }
+
+    void ModelCache::reload_model(id_type id, id_type meshId)
+    {
+        // Queued after the mesh got swapped in, the renderer rebuilds the buffers of unbuffered models on it's own.
+        fs::hot_reload::commit([id, meshId]()
+            {
+                auto handle = MeshCache::get_handle(meshId);
+                if (!handle)
+                    return;
+
+                auto [lock, data] = handle.get();
+                async::readonly_guard meshGuard(lock);
+                async::readwrite_guard guard(m_modelLock);
+                if (!m_models.contains(id))
+                    return;
+
+                model& model = m_models[id];
+                model.submeshes = data.submeshes;
+                model.bounds = data.bounds;
+                model.buffered = false;
+            });
+    }
+
     model_handle ModelCache::create_model(const std::string& name, const fs::view& file, mesh_import_settings settings)
     {
         id_type id = nameHash(name);
@@ -148,6 +181,7 @@ namespace legion::rendering
 
         for (auto& submeshData : data.submeshes)
             model.submeshes.push_back(submeshData);
+        model.bounds = data.bounds;
 
         // The model still needs to be buffered on the rendering thread.
         model.buffered = false;
@@ -157,6 +191,8 @@ namespace legion::rendering
             m_models.insert(id, model);
         }
 
+        watch_model(id, handle.id);
+
         {
             async::readwrite_guard guard(m_modelNameLock);
             m_modelNames[id] = name;
@@ -318,6 +354,7 @@ namespace legion::rendering
 
             for (auto& submeshData : data.submeshes)
                 model.submeshes.push_back(submeshData);
+            model.bounds = data.bounds;
         }
 
         // The model still needs to be buffered on the rendering thread.
@@ -328,6 +365,8 @@ namespace legion::rendering
             m_models.insert(id, model);
         }
 
+        watch_model(id, handle.id);
+
         {
             async::readwrite_guard guard(m_modelNameLock);
             m_modelNames[id] = name;
@@ -366,6 +405,7 @@ namespace legion::rendering
 
             for (auto& submeshData : data.submeshes)
                 model.submeshes.push_back(submeshData);
+            model.bounds = data.bounds;
         }
 
         // The model still needs to be buffered on the rendering thread.
@@ -376,6 +416,8 @@ namespace legion::rendering
             m_models.insert(id, model);
         }
 
+        watch_model(id, id);
+
         {
             async::readwrite_guard guard(m_modelNameLock);
             m_modelNames[id] = name;
@@ -414,6 +456,7 @@ namespace legion::rendering
 
             for (auto& submeshData : data.submeshes)
                 model.submeshes.push_back(submeshData);
+            model.bounds = data.bounds;
         }
 
         // The model still needs to be buffered on the rendering thread.
@@ -424,6 +467,8 @@ namespace legion::rendering
             m_models.insert(id, model);
         }
 
+        watch_model(id, meshId);
+
         {
             async::readwrite_guard guard(m_modelNameLock);
             m_modelNames[id] = name;
@@ -460,6 +505,7 @@ namespace legion::rendering
 
             for (auto& submeshData : data.submeshes)
                 model.submeshes.push_back(submeshData);
+            model.bounds = data.bounds;
         }
 
         // The model still needs to be buffered on the rendering thread.
@@ -470,6 +516,8 @@ namespace legion::rendering
             m_models.insert(id, model);
         }
 
+        watch_model(id, id);
+
         {
             async::readwrite_guard guard(m_modelNameLock);
             m_modelNames[id] = std::to_string(id);
@@ -507,6 +555,7 @@ namespace legion::rendering
 
             for (auto& submeshData : data.submeshes)
                 model.submeshes.push_back(submeshData);
+            model.bounds = data.bounds;
         }
 
         // The model still needs to be buffered on the rendering thread.
@@ -517,6 +566,8 @@ namespace legion::rendering
             m_models.insert(id, model);
         }
 
+        watch_model(id, mesh.id);
+
         {
             async::readwrite_guard guard(m_modelNameLock);
             m_modelNames[id] = name;
@@ -554,6 +605,7 @@ namespace legion::rendering
 
             for (auto& submeshData : data.submeshes)
                 model.submeshes.push_back(submeshData);
+            model.bounds = data.bounds;
         }
 
         // The model still needs to be buffered on the rendering thread.
@@ -564,6 +616,8 @@ namespace legion::rendering
             m_models.insert(id, model);
         }
 
+        watch_model(id, mesh.id);
+
         {
             auto [lock, rawmesh] = mesh.get();
             async::mixed_multiguard guard(m_modelNameLock, async::lock_state_read, lock, async::lock_state_write);
@@ -611,6 +665,8 @@ namespace legion::rendering
             erased = m_models.erase(id);
         }
 
+        fs::hot_reload::remove(fs::hot_reload::entry_node("model", id));
+
         if (erased)
             log::debug("Destroyed model {}", name);
     }
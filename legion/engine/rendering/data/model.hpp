@@ -30,6 +30,10 @@ namespace legion::rendering
         buffer indexBuffer;
 
         std::vector<sub_mesh> submeshes;
+
+        /**@brief Local space bounds copied from the mesh, world bounds can be derived from them with the transform of an instance.
+         */
+        math::bounding_volume bounds;
     };
 
     /**@class model_handle
@@ -63,6 +67,12 @@ namespace legion::rendering
 
         static const model& get_model(id_type id);
 
+        static void watch_model(id_type id, id_type meshId);
+
+        /**@brief Copies the sub-meshes of a reloaded mesh at the next sync point and marks the model for re-buffering.
+         */
+        static void reload_model(id_type id, id_type meshId);
+
     public:
         static std::string get_model_name(id_type id);
 
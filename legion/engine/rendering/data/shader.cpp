@@ -1,7 +1,10 @@
 ﻿#include <rendering/data/shader.hpp>
 #include <rendering/util/bindings.hpp>
 #include <algorithm>
+#include <limits>
 #include <rendering/shadercompiler/shadercompiler.hpp>
+#include <core/filesystem/hot_reload.hpp>
+#include <sstream>
 
 namespace legion::rendering
 {
@@ -22,6 +25,94 @@ namespace legion::rendering
             // Clear all values.
             variant.uniforms.clear();
             variant.attributes.clear();
+            variant.idOfLocation.clear();
+            variant.materialBlock = material_block_info();
+            variant.materialTable = material_block_info();
+            variant.boundParameters = nullptr;
+
+#pragma region uniform blocks
+            // Find the block with the material parameters, materials upload that block as a whole instead of setting each uniform.
+            GLint numActiveBlocks = 0;
+            glGetProgramiv(variant.programId, GL_ACTIVE_UNIFORM_BLOCKS, &numActiveBlocks);
+
+            for (GLint blockIndex = 0; blockIndex < numActiveBlocks; blockIndex++)
+            {
+                GLint binding = -1;
+                glGetActiveUniformBlockiv(variant.programId, blockIndex, GL_UNIFORM_BLOCK_BINDING, &binding);
+                if (binding != SV_MATERIALPARAMS)
+                    continue;
+
+                variant.materialBlock.index = blockIndex;
+                glGetActiveUniformBlockiv(variant.programId, blockIndex, GL_UNIFORM_BLOCK_DATA_SIZE, &variant.materialBlock.size);
+                break;
+            }
+#pragma endregion
+#pragma region material table
+            // Find the storage buffer with the material table, used to draw instances of multiple materials at once.
+            GLint numStorageBlocks = 0;
+            glGetProgramInterfaceiv(variant.programId, GL_SHADER_STORAGE_BLOCK, GL_ACTIVE_RESOURCES, &numStorageBlocks);
+
+            for (GLint blockIndex = 0; blockIndex < numStorageBlocks; blockIndex++)
+            {
+                const GLenum bindingProp = GL_BUFFER_BINDING;
+                GLint binding = -1;
+                glGetProgramResourceiv(variant.programId, GL_SHADER_STORAGE_BLOCK, blockIndex, 1, &bindingProp, 1, nullptr, &binding);
+                if (binding == SV_MATERIALS)
+                {
+                    variant.materialTable.index = blockIndex;
+                    break;
+                }
+            }
+
+            if (variant.materialTable.index != -1)
+            {
+                GLint numVariables = 0;
+                glGetProgramInterfaceiv(variant.programId, GL_BUFFER_VARIABLE, GL_ACTIVE_RESOURCES, &numVariables);
+
+                GLint maxVariableNameLength = 0;
+                glGetProgramInterfaceiv(variant.programId, GL_BUFFER_VARIABLE, GL_MAX_NAME_LENGTH, &maxVariableNameLength);
+                std::string variableName(static_cast<size_type>(maxVariableNameLength), '\0');
+
+                const GLenum props[] = { GL_BLOCK_INDEX, GL_TYPE, GL_OFFSET, GL_MATRIX_STRIDE, GL_IS_ROW_MAJOR, GL_TOP_LEVEL_ARRAY_STRIDE };
+                constexpr GLsizei propCount = sizeof(props) / sizeof(GLenum);
+
+                GLint entryStart = std::numeric_limits<GLint>::max();
+                for (GLint variableIndex = 0; variableIndex < numVariables; variableIndex++)
+                {
+                    GLint values[propCount];
+                    glGetProgramResourceiv(variant.programId, GL_BUFFER_VARIABLE, variableIndex, propCount, props, propCount, nullptr, values);
+                    if (values[0] != variant.materialTable.index)
+                        continue;
+
+                    GLsizei nameLength = 0;
+                    glGetProgramResourceName(variant.programId, GL_BUFFER_VARIABLE, variableIndex, maxVariableNameLength, &nameLength, variableName.data());
+
+                    // Only members of the entries are of interest, their names are reported as "materials[0].member".
+                    std::string_view name(variableName.data(), nameLength);
+                    auto memberStart = name.find("].");
+                    if (memberStart == std::string_view::npos || name.find('[', memberStart) != std::string_view::npos)
+                        continue;
+
+                    uniform_block_member member;
+                    member.name = std::string(name.substr(memberStart + 2));
+                    member.type = static_cast<GLenum>(values[1]);
+                    member.offset = values[2];
+                    member.matrixStride = values[3];
+                    member.rowMajor = values[4] != 0;
+
+                    variant.materialTable.size = values[5];
+                    entryStart = std::min(entryStart, member.offset);
+                    variant.materialTable.members.push_back(member);
+                }
+
+                // The first member of an entry sits at the start of the entry.
+                for (auto& member : variant.materialTable.members)
+                    member.offset -= entryStart;
+
+                if (variant.materialTable.members.empty() || variant.materialTable.size <= 0)
+                    variant.materialTable = material_block_info();
+            }
+#pragma endregion
 
 #pragma region uniforms
             // Find the number of active uniforms.
@@ -47,12 +138,36 @@ namespace legion::rendering
                 if (name.find('[') != std::string_view::npos) // We don't support uniform arrays yet.
                     continue;
 
+                GLuint uniformIndex = static_cast<GLuint>(uniformId);
+                GLint blockIndex = -1;
+                glGetActiveUniformsiv(variant.programId, 1, &uniformIndex, GL_UNIFORM_BLOCK_INDEX, &blockIndex);
+
+                if (blockIndex != -1) // Uniforms in blocks don't have a location, only the ones in the material block are of interest.
+                {
+                    if (blockIndex == variant.materialBlock.index)
+                    {
+                        uniform_block_member member;
+                        member.name = std::string(name);
+                        member.type = type;
+                        glGetActiveUniformsiv(variant.programId, 1, &uniformIndex, GL_UNIFORM_OFFSET, &member.offset);
+                        glGetActiveUniformsiv(variant.programId, 1, &uniformIndex, GL_UNIFORM_MATRIX_STRIDE, &member.matrixStride);
+
+                        GLint rowMajor = 0;
+                        glGetActiveUniformsiv(variant.programId, 1, &uniformIndex, GL_UNIFORM_IS_ROW_MAJOR, &rowMajor);
+                        member.rowMajor = rowMajor != 0;
+
+                        variant.materialBlock.members.push_back(member);
+                    }
+                    continue;
+                }
+
                 // Get location and create uniform object.
                 app::gl_location location = glGetUniformLocation(variant.programId, uniformNameBuffer);
                 shader_parameter_base* uniform = nullptr;
                 switch (type)
                 {
                 case GL_SAMPLER_2D:
+                case GL_SAMPLER_2D_ARRAY:
                     uniform = new rendering::uniform<texture_handle>(id, name, type, location, textureUnit);
                     textureUnit++;
                     break;
@@ -616,84 +731,8 @@ namespace legion::rendering
         return { invalid_id };
     }
 
-    shader_handle ShaderCache::create_shader(const std::string& name, const fs::view& file, shader_import_settings settings)
+    void ShaderCache::link_variants(shader& shader, const shader_ilo& shaders, const std::unordered_map<std::string, shader_state>& state)
     {
-        // Get the id of the new shader.
-        id_type id = nameHash(name);
-
-        { // Check if the shader already exists.
-            async::readonly_guard guard(m_shaderLock);
-
-            if (!m_shaders.contains(invalid_id) || (!m_shaders[invalid_id].has_variant(0)))
-            {
-                create_invalid_shader(fs::view("engine://shaders/invalid.shs"));
-            }
-
-            if (m_shaders.contains(id))
-            {
-                log::debug("Shader {} already exists, existing shader will be returned instead.", name);
-                return { id };
-            }
-        }
-
-        std::unordered_map<std::string, shader_state> state;
-        shader_ilo shaders;
-
-        auto result = file.get_extension();
-        if (result != common::valid)
-            return invalid_shader_handle;
-
-        bool compiledFromScratch = false;
-
-        if (result.decay().empty() || result.decay() == ".shil")
-        {
-            if (!load_precompiled(file, shaders, state))
-                return invalid_shader_handle;
-        }
-        else
-        {
-            switch (settings.usePrecompiledIfAvailable)
-            {
-            case true:
-            {
-                auto precompiled = file / ".." / (file.get_filestem().decay() + ".shil");
-
-                if (precompiled.is_valid(true))
-                {
-                    auto traits = precompiled.file_info();
-                    if (traits.is_file && traits.can_be_read)
-                    {
-                        if (load_precompiled(precompiled, shaders, state))
-                            break;
-                    }
-                }
-            }
-            L_FALLTHROUGH;
-            default:
-            {
-                byte compilerSettings = 0;
-                compilerSettings |= settings.api;
-                if (settings.debug)
-                    compilerSettings |= shader_compiler_options::debug;
-                if (settings.low_power)
-                    compilerSettings |= shader_compiler_options::low_power;
-
-                if (!ShaderCompiler::process(file, compilerSettings, shaders, state, detail::get_default_defines()))
-                    return invalid_shader_handle;
-
-                compiledFromScratch = true;
-            }
-            break;
-            }
-        }
-
-        if (shaders.empty())
-            return invalid_shader_handle;
-
-        shader shader;
-        shader.name = name;
-        shader.path = file.get_virtual_path();
-
         for (auto& [variant, variantState] : state)
         {
             shader.m_variants[nameHash(variant)].state = variantState;
@@ -788,7 +827,7 @@ namespace legion::rendering
                         output += std::to_string(i + 1) + "\t| " + v[i] + "\n";
                     }
 
-                    log::error("Error occurred in shader: {}\n{}", name, output);
+                    log::error("Error occurred in shader: {}\n{}", shader.name, output);
 
                     for (auto id : shaderIds)
                     {
@@ -818,7 +857,7 @@ namespace legion::rendering
                 char* errorMessage = new char[infoLogLength + 1];
                 glGetProgramInfoLog(variant.programId, infoLogLength, nullptr, errorMessage);
 
-                log::error("Error linking {} shader:\n\t{}", name, errorMessage);
+                log::error("Error linking {} shader:\n\t{}", shader.name, errorMessage);
                 delete[] errorMessage;
 
                 for (auto& [shaderType, shaderIL] : variantSource)
@@ -877,7 +916,7 @@ namespace legion::rendering
                 char* errorMessage = new char[infoLogLength + 1];
                 glGetProgramInfoLog(variant.programId, infoLogLength, nullptr, errorMessage);
 
-                log::error("Error validating {} shader:\n\t{}", name, errorMessage);
+                log::error("Error validating {} shader:\n\t{}", shader.name, errorMessage);
                 delete[] errorMessage;
 
                 for (auto& shaderId : shaderIds)
@@ -892,6 +931,88 @@ namespace legion::rendering
             }
         }
 
+    }
+
+    shader_handle ShaderCache::create_shader(const std::string& name, const fs::view& file, shader_import_settings settings)
+    {
+        // Get the id of the new shader.
+        id_type id = nameHash(name);
+
+        { // Check if the shader already exists.
+            async::readonly_guard guard(m_shaderLock);
+
+            if (!m_shaders.contains(invalid_id) || (!m_shaders[invalid_id].has_variant(0)))
+            {
+                create_invalid_shader(fs::view("engine://shaders/invalid.shs"));
+            }
+
+            if (m_shaders.contains(id))
+            {
+                log::debug("Shader {} already exists, existing shader will be returned instead.", name);
+                return { id };
+            }
+        }
+
+        std::unordered_map<std::string, shader_state> state;
+        shader_ilo shaders;
+
+        auto result = file.get_extension();
+        if (result != common::valid)
+            return invalid_shader_handle;
+
+        bool compiledFromScratch = false;
+
+        if (result.decay().empty() || result.decay() == ".shil")
+        {
+            if (!load_precompiled(file, shaders, state))
+                return invalid_shader_handle;
+        }
+        else
+        {
+            switch (settings.usePrecompiledIfAvailable)
+            {
+            case true:
+            {
+                auto precompiled = file / ".." / (file.get_filestem().decay() + ".shil");
+
+                if (precompiled.is_valid(true))
+                {
+                    auto traits = precompiled.file_info();
+                    if (traits.is_file && traits.can_be_read)
+                    {
+                        if (load_precompiled(precompiled, shaders, state))
+                            break;
+                    }
+                }
+            }
+            L_FALLTHROUGH;
+            default:
+            {
+                byte compilerSettings = 0;
+                compilerSettings |= settings.api;
+                if (settings.debug)
+                    compilerSettings |= shader_compiler_options::debug;
+                if (settings.low_power)
+                    compilerSettings |= shader_compiler_options::low_power;
+
+                if (!ShaderCompiler::process(file, compilerSettings, shaders, state, detail::get_default_defines()))
+                    return invalid_shader_handle;
+
+                compiledFromScratch = true;
+            }
+            break;
+            }
+        }
+
+        if (shaders.empty())
+            return invalid_shader_handle;
+
+        shader shader;
+        shader.name = name;
+        shader.path = file.get_virtual_path();
+
+        link_variants(shader, shaders, state);
+
         process_io(shader, id);
 
         if (!shader.m_variants.size())
@@ -906,9 +1027,137 @@ namespace legion::rendering
         if (compiledFromScratch && settings.storePrecompiled)
             store_precompiled(file, shaders, state);
 
+        if (fs::hot_reload::enabled())
+            watch_shader(id, file, settings);
+
         return { id };
     }
 
+    void ShaderCache::track_includes(const std::string& node, const fs::view& file, const fs::view& folder, std::unordered_set<std::string>& visited)
+    {
+        auto source = file.get();
+        if (source != common::valid)
+            return;
+
+        std::istringstream stream(source.decay().to_string());
+        std::string line;
+        while (std::getline(stream, line))
+        {
+            const auto start = line.find_first_not_of(" \t");
+            if (start == std::string::npos || line.compare(start, 8, "#include") != 0)
+                continue;
+
+            const auto open = line.find_first_of("<\"", start + 8);
+            if (open == std::string::npos)
+                continue;
+
+            const auto close = line.find_first_of(">\"", open + 1);
+            if (close == std::string::npos)
+                continue;
+
+            const std::string include = line.substr(open + 1, close - open - 1);
+
+            // Resolve the same way the shader processor does, first next to the shader and then in the shader library.
+            fs::view includeFile = folder / include;
+            if (!includeFile.file_info().is_file)
+                includeFile = fs::view("engine://shaderlib") / include;
+            if (!includeFile.file_info().is_file)
+                continue;
+
+            fs::hot_reload::add_dependency(node, includeFile.get_virtual_path());
+            if (visited.insert(fs::hot_reload::node(includeFile.get_virtual_path())).second)
+                track_includes(node, includeFile, folder, visited);
+        }
+    }
+
+    void ShaderCache::watch_shader(id_type id, const fs::view& file, shader_import_settings settings)
+    {
+        const std::string node = fs::hot_reload::entry_node("shader", id);
+        fs::hot_reload::clear_dependencies(node);
+        fs::hot_reload::add_dependency(node, file.get_virtual_path());
+
+        std::unordered_set<std::string> visited;
+        track_includes(node, file, file / "..", visited);
+
+        fs::hot_reload::on_reload(node, [id, file, settings]() { reload_shader(id, file, settings); });
+    }
+
+    void ShaderCache::reload_shader(id_type id, const fs::view& file, shader_import_settings settings)
+    {
+        OPTICK_EVENT();
+        // Includes might have been added or removed.
+        watch_shader(id, file, settings);
+
+        auto shaders = std::make_shared<shader_ilo>();
+        auto state = std::make_shared<std::unordered_map<std::string, shader_state>>();
+
+        auto extension = file.get_extension();
+        if (extension != common::valid)
+            return;
+
+        bool compiledFromScratch = false;
+        if (extension.decay().empty() || extension.decay() == ".shil")
+        {
+            if (!load_precompiled(file, *shaders, *state))
+                return;
+        }
+        else
+        {
+            byte compilerSettings = 0;
+            compilerSettings |= settings.api;
+            if (settings.debug)
+                compilerSettings |= shader_compiler_options::debug;
+            if (settings.low_power)
+                compilerSettings |= shader_compiler_options::low_power;
+
+            // Compilation runs on the hot-reload thread, only linking needs the graphics context.
+            if (!ShaderCompiler::process(file, compilerSettings, *shaders, *state, detail::get_default_defines()))
+            {
+                log::error("Failed to recompile shader {}, the previous version stays in use.", file.get_virtual_path());
+                return;
+            }
+            compiledFromScratch = true;
+        }
+
+        if (shaders->empty())
+            return;
+
+        fs::hot_reload::commit(nameHash("Rendering"), [id, file, settings, shaders, state, compiledFromScratch]()
+            {
+                shader replacement;
+                {
+                    async::readonly_guard guard(m_shaderLock);
+                    if (!m_shaders.contains(id))
+                        return;
+                    replacement.name = m_shaders[id].name;
+                }
+                replacement.path = file.get_virtual_path();
+
+                link_variants(replacement, *shaders, *state);
+                process_io(replacement, id);
+
+                if (!replacement.m_variants.size())
+                {
+                    log::error("Failed to link reloaded shader {}, the previous version stays in use.", replacement.name);
+                    return;
+                }
+
+                {
+                    async::readwrite_guard guard(m_shaderLock);
+                    std::swap(m_shaders[id], replacement);
+                    m_shaders[id].configure_variant(0);
+                }
+
+                for (auto& [variantId, variant] : replacement.m_variants)
+                    glDeleteProgram(variant.programId);
+
+                if (compiledFromScratch && settings.storePrecompiled)
+                    store_precompiled(file, *shaders, *state);
+
+                log::info("Reloaded shader {}", replacement.name);
+            });
+    }
+
     shader_handle ShaderCache::create_shader(const fs::view& file, shader_import_settings settings)
     {
         return create_shader(file.get_filename(), file, settings);
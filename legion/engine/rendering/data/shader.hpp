@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <string>
+#include <unordered_set>
 #include <rendering/data/texture.hpp>
 #include <rendering/util/bindings.hpp>
 #include <rendering/util/settings.hpp>
@@ -100,8 +101,15 @@ namespace legion::rendering
             else
                 tex = invalid_texture_handle.get_texture();
 
+            bind_texture(GL_TEXTURE_2D, tex.textureId);
+        }
+
+        /**@brief Bind a texture object directly to the texture unit of the uniform, used for textures that aren't in the texture cache.
+         */
+        void bind_texture(GLenum target, app::gl_id textureId)
+        {
             glActiveTexture(GL_TEXTURE0 + m_textureUnit);
-            glBindTexture(GL_TEXTURE_2D, tex.textureId);
+            glBindTexture(target, textureId);
             glUniform1i(m_location, m_textureUnit);
             glActiveTexture(GL_TEXTURE0);
         }
@@ -263,16 +271,48 @@ namespace legion::rendering
 
 #pragma endregion
 
+    /**@brief Reflected layout of a single uniform within the material parameter block.
+     */
+    struct uniform_block_member
+    {
+        std::string name;
+        GLenum type;
+        GLint offset;
+        GLint matrixStride;
+        bool rowMajor;
+    };
+
+    /**@brief Reflected layout of the uniform block of a shader variant that's bound to SV_MATERIALPARAMS.
+     *        Declare it in a shader with: layout(std140, binding = SV_MATERIALPARAMS) uniform MaterialParameters { ... };
+     */
+    struct material_block_info
+    {
+        GLint index = -1;
+        GLint size = 0;
+        std::vector<uniform_block_member> members;
+    };
+
     struct shader_variant
     {
         GLint programId;
         std::unordered_map<id_type, std::unique_ptr<shader_parameter_base>> uniforms;
         std::unordered_map<id_type, std::unique_ptr<attribute>> attributes;
         std::unordered_map<GLint, id_type> idOfLocation;
+        material_block_info materialBlock;
+
+        /**@brief Reflected layout of a single entry of the material table, the storage buffer bound to SV_MATERIALS.
+         *        The size is the stride between entries, offsets are relative to the start of an entry.
+         */
+        material_block_info materialTable;
+
         std::string name;
         std::string path;
         id_type nameHash;
 
+        /**@brief Parameters of the material that last sent it's uniforms to this program, the program keeps those values until another material overwrites them.
+         */
+        const void* boundParameters = nullptr;
+
         /**@brief Data-structure to hold mapping of context functions and parameters.
          */
         shader_state state;
@@ -500,6 +540,17 @@ namespace legion::rendering
 
         static shader_handle create_invalid_shader(const fs::view& file, shader_import_settings settings = default_shader_settings);
 
+        /**@brief Compiles and links all variants of a shader, variants that fail are left out.
+         */
+        static void link_variants(shader& shader, const shader_ilo& shaders, const std::unordered_map<std::string, shader_state>& state);
+
+        static void track_includes(const std::string& node, const fs::view& file, const fs::view& folder, std::unordered_set<std::string>& visited);
+        static void watch_shader(id_type id, const fs::view& file, shader_import_settings settings);
+
+        /**@brief Recompiles a shader on the hot-reload thread and links it on the rendering thread.
+         */
+        static void reload_shader(id_type id, const fs::view& file, shader_import_settings settings);
+
     public:
         static shader_handle create_shader(const std::string& name, const fs::view& file, shader_import_settings settings = default_shader_settings);
         static shader_handle create_shader(const fs::view& file, shader_import_settings settings = default_shader_settings);
@@ -1,4 +1,5 @@
 #include <rendering/data/texture.hpp>
+#include <core/filesystem/hot_reload.hpp>
 
 namespace legion::rendering
 {
@@ -136,9 +137,52 @@ namespace legion::rendering
         }
         log::debug("Created texture {} with file: {}", name, file.get_filename().decay());
 
+        if (fs::hot_reload::enabled())
+        {
+            const std::string node = fs::hot_reload::entry_node("texture", id);
+            fs::hot_reload::add_dependency(node, file.get_virtual_path());
+            fs::hot_reload::on_reload(node, [id, file, settings]() { reload_texture(id, file, settings); });
+        }
+
         return { id };
     }
 
+    void TextureCache::reload_texture(id_type id, const fs::view& file, texture_import_settings settings)
+    {
+        // The texture importer uploads straight to the GPU, so the whole import has to run on the rendering thread.
+        fs::hot_reload::commit(nameHash("Rendering"), [id, file, settings]()
+            {
+                OPTICK_EVENT();
+                auto result = fs::AssetImporter::tryLoad<texture>(file, settings);
+                if (result != common::valid)
+                {
+                    log::error("Failed to reload texture {}, the previous version stays in use.", file.get_virtual_path());
+                    return;
+                }
+
+                texture replacement = result.decay();
+                app::gl_id previous = invalid_id;
+                {
+                    async::readwrite_guard guard(m_textureLock);
+                    if (m_textures.contains(id))
+                    {
+                        texture& target = m_textures.at(id);
+                        previous = target.textureId;
+                        replacement.name = target.name;
+                        replacement.path = target.path;
+                        target = replacement;
+                    }
+                    else
+                    {
+                        previous = replacement.textureId;
+                    }
+                }
+
+                glDeleteTextures(1, &previous);
+                log::debug("Reloaded texture {}", replacement.name);
+            });
+    }
+
     texture_handle TextureCache::create_texture(const fs::view& file, texture_import_settings settings)
     {
         OPTICK_EVENT();
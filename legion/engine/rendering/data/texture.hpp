@@ -159,6 +159,10 @@ namespace legion::rendering
         static const texture& get_texture(id_type id);
         static texture_data get_data(id_type id);
         static texture_handle m_invalidTexture;
+
+        /**@brief Re-imports a texture on the rendering thread and replaces the texture object the handle refers to.
+         */
+        static void reload_texture(id_type id, const fs::view& file, texture_import_settings settings);
     public:
         /**@brief Create a new texture and load it from a file if a texture with the same name doesn't exist yet.
          * @param name Identifying name for the texture.
@@ -43,5 +43,10 @@ namespace legion::rendering
             return 99;
         }
 
+        virtual bool headlessCompatible() override
+        {
+            return false;
+        }
+
     };
 }
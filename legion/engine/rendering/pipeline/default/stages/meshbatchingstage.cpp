@@ -28,6 +28,11 @@ namespace  legion::rendering
         auto& filters = renderablesQuery.get<mesh_filter>();
         auto& renderers = renderablesQuery.get<mesh_renderer>();
 
+        // Previous transforms are fetched in bulk instead of looking them up per renderable.
+        static auto interpolatedQuery = createQuery<previous_transform, mesh_filter, mesh_renderer>();
+        interpolatedQuery.queryEntities();
+        auto& previousTransforms = interpolatedQuery.get<previous_transform>();
+
         {
             OPTICK_EVENT("Clear instances");
             for (auto [_, models] : *batches)
@@ -37,11 +42,54 @@ namespace  legion::rendering
 
         {
             OPTICK_EVENT("Calculate instances");
-            for (int i = 0; i < renderablesQuery.size(); i++)
+            const size_type count = renderablesQuery.size();
+
+            // Transforms are gathered into arrays first so all of them can be composed in a single batch.
+            m_transforms.resize(count * 10);
+            float* arrays[10];
+            for (size_type i = 0; i < 10; i++)
+                arrays[i] = m_transforms.data() + i * count;
+
+            for (size_type i = 0; i < count; i++)
             {
-                OPTICK_EVENT("instance");
-                (*batches)[renderers[i].material][model_handle{ filters[i].id }].push_back(math::compose(scales[i], rotations[i], positions[i]));
+                const math::vec3& pos = positions[i];
+                const math::quat& rot = rotations[i];
+                const math::vec3& scl = scales[i];
+                arrays[0][i] = pos.x; arrays[1][i] = pos.y; arrays[2][i] = pos.z;
+                arrays[3][i] = rot.x; arrays[4][i] = rot.y; arrays[5][i] = rot.z; arrays[6][i] = rot.w;
+                arrays[7][i] = scl.x; arrays[8][i] = scl.y; arrays[9][i] = scl.z;
             }
+
+            // Entities moved by a fixed step simulation get rendered between their last two steps.
+            const size_type interpolatedCount = interpolatedQuery.size();
+            if (interpolatedCount)
+            {
+                m_previousIndices.clear();
+                m_previousIndices.reserve(interpolatedCount);
+                for (size_type i = 0; i < interpolatedCount; i++)
+                    m_previousIndices.emplace(interpolatedQuery[i].get_id(), i);
+
+                const auto clock = TransformInterpolation::now();
+                for (size_type i = 0; i < count; i++)
+                {
+                    auto itr = m_previousIndices.find(renderablesQuery[i].get_id());
+                    if (itr == m_previousIndices.end())
+                        continue;
+
+                    math::vec3 pos(arrays[0][i], arrays[1][i], arrays[2][i]);
+                    math::quat rot = rotations[i];
+                    TransformInterpolation::interpolate(clock, previousTransforms[itr->second], pos, rot);
+
+                    arrays[0][i] = pos.x; arrays[1][i] = pos.y; arrays[2][i] = pos.z;
+                    arrays[3][i] = rot.x; arrays[4][i] = rot.y; arrays[5][i] = rot.z; arrays[6][i] = rot.w;
+                }
+            }
+
+            m_instances.resize(count);
+            math::batch::compose(count, { arrays[0], arrays[1], arrays[2], arrays[3], arrays[4], arrays[5], arrays[6], arrays[7], arrays[8], arrays[9] }, m_instances.data());
+
+            for (size_type i = 0; i < count; i++)
+                (*batches)[renderers[i].material][model_handle{ filters[i].id }].push_back(m_instances[i]);
         }
     }
 
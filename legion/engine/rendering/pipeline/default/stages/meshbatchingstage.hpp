@@ -11,5 +11,10 @@ namespace legion::rendering
         virtual void setup(app::window& context) override;
         virtual void render(app::window& context, camera& cam, const camera::camera_input& camInput, time::span deltaTime) override;
         virtual priority_type priority() override;
+
+    private:
+        std::vector<float> m_transforms; // Arrays of every position, rotation and scale element of all renderables, see math::batch::trs_arrays.
+        std::vector<math::mat4> m_instances;
+        std::unordered_map<id_type, size_type> m_previousIndices; // Index into the previous transforms of every interpolated renderable.
     };
 }
@@ -49,6 +49,87 @@ namespace legion::rendering
             return;
         }
 
+        app::context_guard guard(context);
+        if (!guard.contextIsValid())
+        {
+            abort();
+            return;
+        }
+
+        {
+            OPTICK_EVENT("Gathering draw inputs");
+            m_groups.clear();
+            m_tableGroups.clear();
+            m_models.clear();
+            m_modelIndices.clear();
+            m_inputs.clear();
+
+            for (auto [material, instancesPerMaterial] : *batches)
+            {
+                size_type group;
+                const id_type tableKey = m_materialTable.group_key(material);
+                auto tableGroup = tableKey == invalid_id ? m_tableGroups.end() : m_tableGroups.find(tableKey);
+                if (tableGroup != m_tableGroups.end())
+                {
+                    group = tableGroup->second;
+                }
+                else
+                {
+                    // Materials without a material table can only be drawn by themselves.
+                    group = m_groups.size();
+                    m_groups.push_back({ tableKey != invalid_id, {} });
+                    if (tableKey != invalid_id)
+                        m_tableGroups.emplace(tableKey, group);
+                }
+
+                const uint32 materialIndex = static_cast<uint32>(m_groups[group].materials.size());
+                m_groups[group].materials.push_back(material);
+
+                for (auto [modelHandle, instances] : instancesPerMaterial)
+                {
+                    if (modelHandle.id == invalid_id || instances.empty())
+                        continue;
+
+                    auto modelIdx = m_modelIndices.find(modelHandle.id);
+                    if (modelIdx == m_modelIndices.end())
+                    {
+                        ModelCache::create_model(modelHandle.id);
+
+                        if (!modelHandle.is_buffered())
+                            modelHandle.buffer_data(*modelMatrixBuffer);
+
+                        modelIdx = m_modelIndices.emplace(modelHandle.id, m_models.size()).first;
+                        m_models.push_back(modelHandle);
+                    }
+
+                    m_inputs.push_back({ group, materialIndex, modelIdx->second, &instances });
+                }
+            }
+
+            // Models are only fetched after creating all of them, creating a model might move the others.
+            m_submeshes.resize(m_models.size());
+            for (size_type i = 0; i < m_models.size(); i++)
+            {
+                const model& mesh = m_models[i].get_model();
+                if (mesh.submeshes.empty())
+                    log::warn("Empty mesh found. Model name: {},  Model ID {}", ModelCache::get_model_name(m_models[i].id), m_models[i].get_mesh().id);
+
+                m_submeshes[i] = &mesh.submeshes;
+            }
+        }
+
+        // Flattening the batches into indirect commands doesn't need the context, so it runs as a job while the frame buffer gets prepared.
+        auto buildJob = m_scheduler->queueJobs(1, [&]() { m_drawList.build(m_inputs, m_submeshes); });
+
+        auto [valid, message] = fbo->verify();
+        if (!valid)
+        {
+            buildJob.wait();
+            log::error("Main frame buffer isn't complete: {}", message);
+            abort();
+            return;
+        }
+
         texture_handle sceneColor;
         auto colorAttachment = fbo->getAttachment(FRAGMENT_ATTACHMENT);
         if (std::holds_alternative<texture_handle>(colorAttachment))
@@ -76,101 +157,94 @@ namespace legion::rendering
         if (std::holds_alternative<texture_handle>(depthAttachment))
             sceneDepth = std::get<texture_handle>(depthAttachment);
 
-        app::context_guard guard(context);
-        if (!guard.contextIsValid())
-        {
-            abort();
-            return;
-        }
+        fbo->bind();
 
-        auto [valid, message] = fbo->verify();
-        if (!valid)
         {
-            log::error("Main frame buffer isn't complete: {}", message);
-            abort();
-            return;
+            OPTICK_EVENT("Waiting for draw list");
+            buildJob.wait();
         }
 
-        fbo->bind();
-
-        for (auto [material, instancesPerMaterial] : *batches)
+        if (!m_drawList.draws.empty())
         {
-            OPTICK_EVENT("Rendering material");
-            auto materialName = material.get_name();
-            OPTICK_TAG("Material", materialName.c_str());
-
-            camInput.bind(material);
-            if (material.has_param<uint>(SV_LIGHTCOUNT))
-                material.set_param<uint>(SV_LIGHTCOUNT, *lightCount);
+            {
+                OPTICK_EVENT("Uploading draw list");
+                modelMatrixBuffer->bufferData(m_drawList.matrices);
+
+                if (!m_indirectBuffer.id())
+                    m_indirectBuffer = buffer(GL_DRAW_INDIRECT_BUFFER, m_drawList.commands, GL_DYNAMIC_DRAW);
+                else
+                    m_indirectBuffer.bufferData(m_drawList.commands);
+
+                if (!m_instanceMaterialBuffer.id())
+                    m_instanceMaterialBuffer = buffer(GL_SHADER_STORAGE_BUFFER, m_drawList.instanceMaterials, GL_DYNAMIC_DRAW);
+                else
+                    m_instanceMaterialBuffer.bufferData(m_drawList.instanceMaterials);
+                m_instanceMaterialBuffer.bindBufferBase(SV_INSTANCEMATERIALS);
+            }
 
-            if (sceneColor && material.has_param<texture_handle>(SV_SCENECOLOR))
-                material.set_param<texture_handle>(SV_SCENECOLOR, sceneColor);
+            m_indirectBuffer.bind();
+            lightsBuffer->bind();
 
-            if (sceneNormal && material.has_param<texture_handle>(SV_SCENENORMAL))
-                material.set_param<texture_handle>(SV_SCENENORMAL, sceneNormal);
+            size_type currentGroup = m_groups.size();
+            material_handle material = invalid_material_handle;
 
-            if (scenePosition && material.has_param<texture_handle>(SV_SCENEPOSITION))
-                material.set_param<texture_handle>(SV_SCENEPOSITION, scenePosition);
+            for (auto& draw : m_drawList.draws)
+            {
+                if (draw.group != currentGroup)
+                {
+                    if (currentGroup != m_groups.size())
+                        material.release();
 
-            if (hdrOverdraw && material.has_param<texture_handle>(SV_HDROVERDRAW))
-                material.set_param<texture_handle>(SV_HDROVERDRAW, hdrOverdraw);
+                    currentGroup = draw.group;
+                    auto& group = m_groups[currentGroup];
+                    material = group.materials.front();
 
-            if (sceneDepth && material.has_param<texture_handle>(SV_SCENEDEPTH))
-                material.set_param<texture_handle>(SV_SCENEDEPTH, sceneDepth);
+                    OPTICK_EVENT("Rendering material");
+                    auto materialName = material.get_name();
+                    OPTICK_TAG("Material", materialName.c_str());
 
-            material.bind();
+                    camInput.bind(material);
+                    if (material.has_param<uint>(SV_LIGHTCOUNT))
+                        material.set_param<uint>(SV_LIGHTCOUNT, *lightCount);
 
-            for (auto [modelHandle, instances] : instancesPerMaterial)
-            {
-                if (modelHandle.id == invalid_id)
-                    return;
+                    if (sceneColor && material.has_param<texture_handle>(SV_SCENECOLOR))
+                        material.set_param<texture_handle>(SV_SCENECOLOR, sceneColor);
 
-                ModelCache::create_model(modelHandle.id);
-                auto modelName = ModelCache::get_model_name(modelHandle.id);
-                OPTICK_EVENT("Rendering instances");
-                OPTICK_TAG("Model", modelName.c_str());
+                    if (sceneNormal && material.has_param<texture_handle>(SV_SCENENORMAL))
+                        material.set_param<texture_handle>(SV_SCENENORMAL, sceneNormal);
 
-                const model& mesh = modelHandle.get_model();
+                    if (scenePosition && material.has_param<texture_handle>(SV_SCENEPOSITION))
+                        material.set_param<texture_handle>(SV_SCENEPOSITION, scenePosition);
 
-                if (!mesh.buffered)
-                    modelHandle.buffer_data(*modelMatrixBuffer);
+                    if (hdrOverdraw && material.has_param<texture_handle>(SV_HDROVERDRAW))
+                        material.set_param<texture_handle>(SV_HDROVERDRAW, hdrOverdraw);
 
-                if (mesh.submeshes.empty())
-                {
-                    log::warn("Empty mesh found. Model name: {},  Model ID {}", modelName, modelHandle.get_mesh().id);
-                    continue;
-                }
+                    if (sceneDepth && material.has_param<texture_handle>(SV_SCENEDEPTH))
+                        material.set_param<texture_handle>(SV_SCENEDEPTH, sceneDepth);
 
-                {
-                    OPTICK_EVENT("Calculating matrices");
-                    /*m_matrices.resize(instances.size());
-                    int i = 0;
-                    for (auto& ent : instances)
-                    {
-                        m_matrices[i] = transform(ent.get_component_handles<transform>()).get_local_to_world_matrix();
-                        i++;
-                    }*/
+                    material.bind();
 
-                    modelMatrixBuffer->bufferData(instances);
+                    if (group.useTable)
+                        m_materialTable.bind(group.materials);
                 }
 
-                {
-                    OPTICK_EVENT("Draw call");
-                    mesh.vertexArray.bind();
-                    mesh.indexBuffer.bind();
-                    lightsBuffer->bind();
-                    for (auto submesh : mesh.submeshes)
-                        glDrawElementsInstanced(GL_TRIANGLES, (GLuint)submesh.indexCount, GL_UNSIGNED_INT, (GLvoid*)(submesh.indexOffset * sizeof(uint)), (GLsizei)instances.size());
-
-                    lightsBuffer->release();
-                    mesh.indexBuffer.release();
-                    mesh.vertexArray.release();
-                }
+                OPTICK_EVENT("Draw call");
+                const model& mesh = m_models[draw.model].get_model();
+                mesh.vertexArray.bind();
+                mesh.indexBuffer.bind();
+                glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, reinterpret_cast<const void*>(draw.firstCommand * sizeof(draw_elements_indirect_command)),
+                    static_cast<GLsizei>(draw.commandCount), 0);
+                mesh.indexBuffer.release();
+                mesh.vertexArray.release();
             }
 
             material.release();
+            lightsBuffer->release();
+            m_indirectBuffer.release();
         }
 
+        m_materialTable.collect_garbage();
+
         fbo->release();
     }
 
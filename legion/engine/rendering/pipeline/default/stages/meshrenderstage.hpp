@@ -1,12 +1,31 @@
 #pragma once
 #include <rendering/pipeline/base/renderstage.hpp>
 #include <rendering/pipeline/base/pipeline.hpp>
+#include <rendering/data/model.hpp>
+#include <rendering/data/indirect_draw.hpp>
+#include <rendering/data/material_table.hpp>
 
 namespace legion::rendering
 {
     class MeshRenderStage : public RenderStage<MeshRenderStage>
     {
-        std::vector<math::mat4> m_matrices;
+        struct draw_group
+        {
+            bool useTable;
+            std::vector<material_handle> materials;
+        };
+
+        std::vector<draw_group> m_groups;
+        std::unordered_map<id_type, size_type> m_tableGroups;
+        std::vector<model_handle> m_models;
+        std::unordered_map<id_type, size_type> m_modelIndices;
+        std::vector<const std::vector<sub_mesh>*> m_submeshes;
+        std::vector<indirect_draw_input> m_inputs;
+
+        indirect_draw_list m_drawList;
+        material_table m_materialTable;
+        buffer m_indirectBuffer;
+        buffer m_instanceMaterialBuffer;
 
     public:
         virtual void setup(app::window& context) override;
@@ -10,6 +10,8 @@
 #include <rendering/data/renderbuffer.hpp>
 #include <rendering/data/vertexarray.hpp>
 #include <rendering/data/material.hpp>
+#include <rendering/data/material_table.hpp>
+#include <rendering/data/indirect_draw.hpp>
 #include <rendering/data/postprocessingeffect.hpp>
 #include <rendering/data/particle_system_base.hpp>
 #include <rendering/data/particle_system_cache.hpp>
@@ -1,6 +1,7 @@
 #include <rendering/systems/renderer.hpp>
 #include <rendering/debugrendering.hpp>
-#include <Optick/optick.h>
+#include <core/profiling/profiler.hpp>
+#include <core/filesystem/hot_reload.hpp>
 
 namespace legion::rendering
 {
@@ -358,6 +359,16 @@ namespace legion::rendering
     {
         OPTICK_EVENT();
 
+        static const id_type renderingChannel = nameHash("Rendering");
+        if (fs::hot_reload::has_commits(renderingChannel))
+        {
+            // Reloaded shaders and textures need a context, which is shared between all windows.
+            app::window window = m_ecs->world.get_component_handle<app::window>().read();
+            app::context_guard guard(window);
+            if (guard.contextIsValid())
+                fs::hot_reload::apply_commits(renderingChannel);
+        }
+
         if (m_pipelineProvider.isNull())
             return;
 
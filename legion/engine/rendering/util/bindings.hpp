@@ -26,6 +26,9 @@
 
 /* uniform 14 */  #define SV_LIGHTCOUNT     SV_VIEWPORT + 1
 /* buffer  0  */  #define SV_LIGHTS         SV_START
+/* buffer  1  */  #define SV_MATERIALPARAMS SV_LIGHTS + 1
+/* buffer  2  */  #define SV_MATERIALS      SV_MATERIALPARAMS + 1
+/* buffer  3  */  #define SV_INSTANCEMATERIALS SV_MATERIALS + 1
 
 /* uniform 15 */  #define SV_SCENECOLOR     SV_LIGHTCOUNT + 1
 /* uniform 16 */  #define SV_SCENEDEPTH     SV_SCENECOLOR + 1
@@ -74,6 +77,9 @@ namespace legion::rendering::detail
 
             defines.push_back("SV_LIGHTCOUNT=" +   std::to_string(SV_LIGHTCOUNT));
             defines.push_back("SV_LIGHTS=" +       std::to_string(SV_LIGHTS));
+            defines.push_back("SV_MATERIALPARAMS=" + std::to_string(SV_MATERIALPARAMS));
+            defines.push_back("SV_MATERIALS=" +    std::to_string(SV_MATERIALS));
+            defines.push_back("SV_INSTANCEMATERIALS=" + std::to_string(SV_INSTANCEMATERIALS));
 
             defines.push_back("SV_SCENECOLOR=" +   std::to_string(SV_SCENECOLOR));
             defines.push_back("SV_SCENEDEPTH=" +   std::to_string(SV_SCENEDEPTH));
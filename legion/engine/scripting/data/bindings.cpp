@@ -0,0 +1,53 @@
+#include <scripting/data/bindings.hpp>
+
+namespace legion::scripting
+{
+    async::rw_spinlock ScriptBindings::m_lock;
+    std::unordered_map<std::string, std::unique_ptr<component_binding>> ScriptBindings::m_components;
+    std::vector<std::unique_ptr<native_binding>> ScriptBindings::m_functions;
+
+    int component_binding::find_field(std::string_view fieldName) const
+    {
+        for (size_type i = 0; i < fields.size(); i++)
+            if (fields[i].name == fieldName)
+                return static_cast<int>(i);
+        return -1;
+    }
+
+    void ScriptBindings::bind_function(const std::string& name, size_type arity, native_function&& function)
+    {
+        async::readwrite_guard guard(m_lock);
+        for (auto& binding : m_functions)
+            if (binding->name == name)
+            {
+                // Scripts refer to functions by index, so rebinding replaces the function in place.
+                binding->arity = arity;
+                binding->function = std::move(function);
+                return;
+            }
+
+        m_functions.push_back(std::make_unique<native_binding>(native_binding{ name, arity, std::move(function) }));
+    }
+
+    const component_binding* ScriptBindings::get_component(const std::string& name)
+    {
+        async::readonly_guard guard(m_lock);
+        auto it = m_components.find(name);
+        return it == m_components.end() ? nullptr : it->second.get();
+    }
+
+    int ScriptBindings::find_function(std::string_view name)
+    {
+        async::readonly_guard guard(m_lock);
+        for (size_type i = 0; i < m_functions.size(); i++)
+            if (m_functions[i]->name == name)
+                return static_cast<int>(i);
+        return -1;
+    }
+
+    const native_binding& ScriptBindings::get_function(size_type index)
+    {
+        async::readonly_guard guard(m_lock);
+        return *m_functions[index];
+    }
+}
@@ -0,0 +1,139 @@
+#pragma once
+#include <core/core.hpp>
+
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file bindings.hpp
+ * @brief Native types and functions exposed to scripts.
+ *        Components are exposed as a set of float fields at fixed offsets, scripts access them through strided views into the
+ *        component arrays of a query. Native functions are called once per chunk with contiguous arrays of arguments.
+ */
+
+namespace legion::scripting
+{
+    /**@class strided_view
+     * @brief Typed view of one field in an array of components.
+     */
+    template<typename T>
+    struct strided_view
+    {
+        byte* base = nullptr;
+        size_type stride = sizeof(T);
+        size_type count = 0;
+
+        L_NODISCARD T& operator[](size_type index) const noexcept { return *reinterpret_cast<T*>(base + index * stride); }
+        L_NODISCARD size_type size() const noexcept { return count; }
+    };
+
+    /**@class script_field
+     * @brief Float member of a component that scripts can read and write.
+     */
+    struct script_field
+    {
+        std::string name;
+        size_type offset;
+    };
+
+    /**@class component_binding
+     * @brief Layout of a component type as seen by scripts.
+     */
+    struct component_binding
+    {
+        id_type typeId;
+        std::string name;
+        size_type stride;
+        std::vector<script_field> fields;
+
+        /**@brief Returns the start of the component array of a query result.
+         */
+        delegate<byte* (ecs::component_container_base&)> data;
+
+        /**@brief Index of a field, -1 if the component has no field with that name.
+         */
+        L_NODISCARD int find_field(std::string_view fieldName) const;
+
+        /**@brief View of a field of all components in a query result.
+         */
+        L_NODISCARD strided_view<float> view(ecs::component_container_base& container, size_type field, size_type count) const
+        {
+            return { data(container) + fields[field].offset, stride, count };
+        }
+    };
+
+    /**@brief Batched native function, args holds argc arrays of count floats and the results get written to out.
+     */
+    using native_function = delegate<void(const float* const* args, size_type argc, float* out, size_type count)>;
+
+    /**@class native_binding
+     */
+    struct native_binding
+    {
+        std::string name;
+        size_type arity;
+        native_function function;
+    };
+
+    /**@class ScriptBindings
+     * @brief Static registry of everything scripts can access, bindings need to exist before scripts using them are compiled.
+     */
+    class ScriptBindings
+    {
+    private:
+        static async::rw_spinlock m_lock;
+        static std::unordered_map<std::string, std::unique_ptr<component_binding>> m_components;
+        static std::vector<std::unique_ptr<native_binding>> m_functions;
+
+    public:
+        ScriptBindings() = delete;
+
+        /**@brief Offset of a member within a component, works for members of base classes as well.
+         */
+        template<typename component_type, typename member_owner>
+        L_NODISCARD static size_type offset_of(float member_owner::* member)
+        {
+            static const component_type instance{};
+            return static_cast<size_type>(reinterpret_cast<const byte*>(&(instance.*member)) - reinterpret_cast<const byte*>(&instance));
+        }
+
+        /**@brief Exposes a component type to scripts under a name.
+         * @param fields Names and byte offsets of the float members scripts may access, see offset_of.
+         */
+        template<typename component_type>
+        static void bind_component(const std::string& name, std::initializer_list<script_field> fields)
+        {
+            auto binding = std::make_unique<component_binding>();
+            binding->typeId = typeHash<component_type>();
+            binding->name = name;
+            binding->stride = sizeof(component_type);
+            binding->fields = fields;
+            binding->data = [](ecs::component_container_base& container)
+            {
+                return reinterpret_cast<byte*>(container.template cast<component_type>().data());
+            };
+
+            async::readwrite_guard guard(m_lock);
+            m_components[name] = std::move(binding);
+        }
+
+        /**@brief Exposes a batched native function to scripts.
+         * @param arity Amount of scalar arguments the function takes.
+         */
+        static void bind_function(const std::string& name, size_type arity, native_function&& function);
+
+        /**@brief Returns the binding of a component, nullptr if no component was bound with that name.
+         */
+        L_NODISCARD static const component_binding* get_component(const std::string& name);
+
+        /**@brief Returns the index of a native function, -1 if no function was bound with that name.
+         */
+        L_NODISCARD static int find_function(std::string_view name);
+
+        L_NODISCARD static const native_binding& get_function(size_type index);
+    };
+}
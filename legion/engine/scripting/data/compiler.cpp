@@ -0,0 +1,830 @@
+#include <scripting/data/compiler.hpp>
+#include <scripting/data/bindings.hpp>
+
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <set>
+#include <unordered_map>
+
+namespace legion::scripting
+{
+    namespace
+    {
+        constexpr size_type max_registers = 0xFFFF;
+        constexpr size_type max_native_arity = 16;
+
+        enum struct token_type : uint8
+        {
+            identifier,
+            number,
+            symbol,
+            newline,
+            end
+        };
+
+        struct token
+        {
+            token_type type;
+            std::string_view text;
+            float number = 0.f;
+            size_type line = 1;
+        };
+
+        struct compile_error
+        {
+            std::string message;
+            size_type line;
+        };
+
+        std::vector<token> tokenize(std::string_view source)
+        {
+            std::vector<token> tokens;
+            size_type line = 1;
+            size_type i = 0;
+
+            while (i < source.size())
+            {
+                const char c = source[i];
+                if (c == '#')
+                {
+                    while (i < source.size() && source[i] != '\n')
+                        i++;
+                }
+                else if (c == '\n')
+                {
+                    tokens.push_back({ token_type::newline, source.substr(i, 1), 0.f, line++ });
+                    i++;
+                }
+                else if (std::isspace(static_cast<unsigned char>(c)))
+                {
+                    i++;
+                }
+                else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_')
+                {
+                    const size_type start = i;
+                    while (i < source.size() && (std::isalnum(static_cast<unsigned char>(source[i])) || source[i] == '_'))
+                        i++;
+                    tokens.push_back({ token_type::identifier, source.substr(start, i - start), 0.f, line });
+                }
+                else if (std::isdigit(static_cast<unsigned char>(c)))
+                {
+                    const std::string text(source.substr(i, std::min<size_type>(source.size() - i, 64)));
+                    char* end = nullptr;
+                    const float value = std::strtof(text.c_str(), &end);
+                    const size_type length = static_cast<size_type>(end - text.c_str());
+                    tokens.push_back({ token_type::number, source.substr(i, length), value, line });
+                    i += length;
+                }
+                else
+                {
+                    static constexpr std::string_view twoCharSymbols[] = { "+=", "-=", "*=", "/=", "<=", ">=", "==", "!=" };
+                    size_type length = 0;
+                    for (auto symbol : twoCharSymbols)
+                        if (source.substr(i, 2) == symbol)
+                            length = 2;
+
+                    if (!length)
+                    {
+                        if (std::strchr("+-*/=<>(),.", c) == nullptr)
+                            throw compile_error{ std::string("unexpected character '") + c + '\'', line };
+                        length = 1;
+                    }
+
+                    tokens.push_back({ token_type::symbol, source.substr(i, length), 0.f, line });
+                    i += length;
+                }
+            }
+
+            tokens.push_back({ token_type::end, std::string_view(), 0.f, line });
+            return tokens;
+        }
+
+        // Result of an expression, either a compile time constant scalar or one register per vector lane.
+        struct value
+        {
+            std::vector<uint16> regs;
+            bool constant = false;
+            float constantValue = 0.f;
+
+            L_NODISCARD size_type width() const noexcept { return constant ? 1 : regs.size(); }
+
+            static value of(float constant) { value result; result.constant = true; result.constantValue = constant; return result; }
+        };
+
+        class compiler
+        {
+        private:
+            script_program& m_program;
+            std::vector<token> m_tokens;
+            size_type m_pos = 0;
+
+            std::vector<uint16> m_free;
+            std::vector<uint16> m_statementTemps;
+
+            std::map<std::pair<size_type, size_type>, uint16> m_fieldRegs;
+            std::set<std::pair<size_type, size_type>> m_writtenFields;
+            std::unordered_map<uint32, uint16> m_constRegs;
+            std::unordered_map<size_type, uint16> m_paramRegs;
+            int m_dtReg = -1;
+            int m_timeReg = -1;
+            std::unordered_map<std::string, std::vector<uint16>> m_locals;
+
+            const token& peek() const { return m_tokens[m_pos]; }
+            const token& next() { return m_tokens[m_pos < m_tokens.size() - 1 ? m_pos++ : m_pos]; }
+
+            bool accept(std::string_view symbol)
+            {
+                if (peek().type == token_type::symbol && peek().text == symbol)
+                {
+                    m_pos++;
+                    return true;
+                }
+                return false;
+            }
+
+            void expect(std::string_view symbol)
+            {
+                if (!accept(symbol))
+                    fail("expected '" + std::string(symbol) + "'");
+            }
+
+            std::string expect_identifier()
+            {
+                if (peek().type != token_type::identifier)
+                    fail("expected a name");
+                return std::string(next().text);
+            }
+
+            [[noreturn]] void fail(const std::string& message) const
+            {
+                throw compile_error{ message, peek().line };
+            }
+
+            uint16 allocate(bool temporary)
+            {
+                uint16 reg;
+                if (!m_free.empty())
+                {
+                    reg = m_free.back();
+                    m_free.pop_back();
+                }
+                else
+                {
+                    if (m_program.registerCount >= max_registers)
+                        fail("script needs too many registers");
+                    reg = m_program.registerCount++;
+                }
+
+                if (temporary)
+                    m_statementTemps.push_back(reg);
+                return reg;
+            }
+
+            void emit(script_opcode op, uint16 dst, uint16 a = 0, uint16 b = 0, uint16 c = 0)
+            {
+                m_program.code.push_back(script_instruction{ op, dst, a, b, c });
+            }
+
+            uint16 constant_register(float constant)
+            {
+                uint32 bits;
+                std::memcpy(&bits, &constant, sizeof(bits));
+                if (auto it = m_constRegs.find(bits); it != m_constRegs.end())
+                    return it->second;
+
+                const uint16 reg = allocate(false);
+                emit(script_opcode::load_const, reg, static_cast<uint16>(m_program.constants.size()));
+                m_program.constants.push_back(constant);
+                m_constRegs.emplace(bits, reg);
+                return reg;
+            }
+
+            uint16 lane(const value& v, size_type index)
+            {
+                if (v.constant)
+                    return constant_register(v.constantValue);
+                return v.regs[v.regs.size() == 1 ? 0 : index];
+            }
+
+            size_type combined_width(std::initializer_list<const value*> values)
+            {
+                size_type width = 1;
+                for (auto* v : values)
+                {
+                    if (v->width() == 1)
+                        continue;
+                    if (width != 1 && width != v->width())
+                        fail("vector widths " + std::to_string(width) + " and " + std::to_string(v->width()) + " don't match");
+                    width = v->width();
+                }
+                return width;
+            }
+
+            value elementwise(script_opcode op, std::initializer_list<const value*> operands)
+            {
+                const size_type width = combined_width(operands);
+                std::vector<const value*> ops(operands);
+
+                value result;
+                for (size_type i = 0; i < width; i++)
+                {
+                    uint16 regs[3] = {};
+                    for (size_type j = 0; j < ops.size(); j++)
+                        regs[j] = lane(*ops[j], i);
+
+                    const uint16 dst = allocate(true);
+                    emit(op, dst, regs[0], regs[1], regs[2]);
+                    result.regs.push_back(dst);
+                }
+                return result;
+            }
+
+            static bool fold(script_opcode op, float a, float b, float& result)
+            {
+                switch (op)
+                {
+                case script_opcode::add: result = a + b; return true;
+                case script_opcode::sub: result = a - b; return true;
+                case script_opcode::mul: result = a * b; return true;
+                case script_opcode::div: result = a / b; return true;
+                case script_opcode::min: result = std::min(a, b); return true;
+                case script_opcode::max: result = std::max(a, b); return true;
+                case script_opcode::pow: result = std::pow(a, b); return true;
+                case script_opcode::less: result = a < b ? 1.f : 0.f; return true;
+                case script_opcode::less_equal: result = a <= b ? 1.f : 0.f; return true;
+                case script_opcode::equal: result = a == b ? 1.f : 0.f; return true;
+                case script_opcode::not_equal: result = a != b ? 1.f : 0.f; return true;
+                case script_opcode::neg: result = -a; return true;
+                case script_opcode::abs: result = std::abs(a); return true;
+                case script_opcode::sqrt: result = std::sqrt(a); return true;
+                case script_opcode::sin: result = std::sin(a); return true;
+                case script_opcode::cos: result = std::cos(a); return true;
+                case script_opcode::floor: result = std::floor(a); return true;
+                default: return false;
+                }
+            }
+
+            value unary(script_opcode op, const value& a)
+            {
+                float folded;
+                if (a.constant && fold(op, a.constantValue, 0.f, folded))
+                    return value::of(folded);
+                return elementwise(op, { &a });
+            }
+
+            value binary(script_opcode op, const value& a, const value& b)
+            {
+                float folded;
+                if (a.constant && b.constant && fold(op, a.constantValue, b.constantValue, folded))
+                    return value::of(folded);
+
+                // Identities that show up a lot after parameters got folded into constants.
+                if ((op == script_opcode::mul && b.constant && b.constantValue == 1.f) || ((op == script_opcode::add || op == script_opcode::sub) && b.constant && b.constantValue == 0.f))
+                    return a;
+                if ((op == script_opcode::mul && a.constant && a.constantValue == 1.f) || (op == script_opcode::add && a.constant && a.constantValue == 0.f))
+                    return b;
+
+                return elementwise(op, { &a, &b });
+            }
+
+            value sum_lanes(const value& v)
+            {
+                if (v.constant || v.regs.size() == 1)
+                    return v;
+
+                value total;
+                total.regs.push_back(v.regs[0]);
+                for (size_type i = 1; i < v.regs.size(); i++)
+                {
+                    value laneValue;
+                    laneValue.regs.push_back(v.regs[i]);
+                    total = binary(script_opcode::add, total, laneValue);
+                }
+                return total;
+            }
+
+            value field_value(size_type slot, size_type field, bool load)
+            {
+                const auto key = std::make_pair(slot, field);
+                auto it = m_fieldRegs.find(key);
+                if (it == m_fieldRegs.end())
+                {
+                    const uint16 reg = allocate(false);
+                    if (load)
+                        emit(script_opcode::load_field, reg, static_cast<uint16>(slot), static_cast<uint16>(field));
+                    it = m_fieldRegs.emplace(key, reg).first;
+                }
+
+                value result;
+                result.regs.push_back(it->second);
+                return result;
+            }
+
+            int find_component(const std::string& name) const
+            {
+                for (size_type i = 0; i < m_program.components.size(); i++)
+                    if (m_program.components[i]->name == name)
+                        return static_cast<int>(i);
+                return -1;
+            }
+
+            value swizzle(const value& v, std::string_view pattern)
+            {
+                value result;
+                for (char c : pattern)
+                {
+                    const char* lanes = "xyzw";
+                    const char* found = std::strchr(lanes, c);
+                    if (!found || c == '\0')
+                        fail("invalid swizzle '" + std::string(pattern) + "'");
+
+                    const size_type index = static_cast<size_type>(found - lanes);
+                    if (index >= v.width())
+                        fail("swizzle '" + std::string(pattern) + "' is out of range");
+                    result.regs.push_back(lane(v, index));
+                }
+                return result;
+            }
+
+            value call(const std::string& name, std::vector<value>& args)
+            {
+                auto require = [&](size_type count)
+                {
+                    if (args.size() != count)
+                        fail(name + " takes " + std::to_string(count) + " argument(s)");
+                };
+
+                static const std::unordered_map<std::string, script_opcode> unaryBuiltins = {
+                    { "abs", script_opcode::abs }, { "sqrt", script_opcode::sqrt }, { "sin", script_opcode::sin },
+                    { "cos", script_opcode::cos }, { "floor", script_opcode::floor }
+                };
+                static const std::unordered_map<std::string, script_opcode> binaryBuiltins = {
+                    { "min", script_opcode::min }, { "max", script_opcode::max }, { "pow", script_opcode::pow }
+                };
+
+                if (auto it = unaryBuiltins.find(name); it != unaryBuiltins.end())
+                {
+                    require(1);
+                    return unary(it->second, args[0]);
+                }
+                if (auto it = binaryBuiltins.find(name); it != binaryBuiltins.end())
+                {
+                    require(2);
+                    return binary(it->second, args[0], args[1]);
+                }
+                if (name == "clamp")
+                {
+                    require(3);
+                    return binary(script_opcode::min, binary(script_opcode::max, args[0], args[1]), args[2]);
+                }
+                if (name == "lerp")
+                {
+                    require(3);
+                    const value difference = binary(script_opcode::sub, args[1], args[0]);
+                    if (difference.constant && args[2].constant && args[0].constant)
+                        return value::of(difference.constantValue * args[2].constantValue + args[0].constantValue);
+                    return elementwise(script_opcode::mad, { &difference, &args[2], &args[0] });
+                }
+                if (name == "select")
+                {
+                    require(3);
+                    if (args[0].constant)
+                        return args[0].constantValue != 0.f ? args[1] : args[2];
+                    return elementwise(script_opcode::select, { &args[0], &args[1], &args[2] });
+                }
+                if (name == "dot")
+                {
+                    require(2);
+                    return sum_lanes(binary(script_opcode::mul, args[0], args[1]));
+                }
+                if (name == "length")
+                {
+                    require(1);
+                    return unary(script_opcode::sqrt, sum_lanes(binary(script_opcode::mul, args[0], args[0])));
+                }
+                if (name == "normalize")
+                {
+                    require(1);
+                    const value length = unary(script_opcode::sqrt, sum_lanes(binary(script_opcode::mul, args[0], args[0])));
+                    return binary(script_opcode::mul, args[0], binary(script_opcode::div, value::of(1.f), length));
+                }
+                if (name == "vec2" || name == "vec3" || name == "vec4")
+                {
+                    const size_type width = static_cast<size_type>(name[3] - '0');
+                    value result;
+                    if (args.size() == 1 && args[0].width() == 1)
+                    {
+                        for (size_type i = 0; i < width; i++)
+                            result.regs.push_back(lane(args[0], 0));
+                        return result;
+                    }
+
+                    for (auto& arg : args)
+                        for (size_type i = 0; i < arg.width(); i++)
+                            result.regs.push_back(lane(arg, i));
+
+                    if (result.regs.size() != width)
+                        fail(name + " needs " + std::to_string(width) + " components");
+                    return result;
+                }
+
+                const int function = ScriptBindings::find_function(name);
+                if (function < 0)
+                    fail("unknown function '" + name + "'");
+
+                const native_binding& binding = ScriptBindings::get_function(static_cast<size_type>(function));
+                require(binding.arity);
+                if (binding.arity > max_native_arity)
+                    fail(name + " takes more than " + std::to_string(max_native_arity) + " arguments");
+
+                const uint16 argsOffset = static_cast<uint16>(m_program.nativeArgs.size());
+                for (auto& arg : args)
+                {
+                    if (arg.width() != 1)
+                        fail("arguments of native function '" + name + "' need to be scalars");
+                    m_program.nativeArgs.push_back(lane(arg, 0));
+                }
+
+                value result;
+                result.regs.push_back(allocate(true));
+                emit(script_opcode::call_native, result.regs[0], static_cast<uint16>(function), argsOffset, static_cast<uint16>(args.size()));
+                return result;
+            }
+
+            value primary()
+            {
+                const token& current = peek();
+                if (current.type == token_type::number)
+                {
+                    next();
+                    return value::of(current.number);
+                }
+
+                if (accept("("))
+                {
+                    value result = expression();
+                    expect(")");
+                    return result;
+                }
+
+                if (current.type != token_type::identifier)
+                    fail("expected an expression");
+
+                const std::string name = expect_identifier();
+
+                if (accept("("))
+                {
+                    std::vector<value> args;
+                    if (!accept(")"))
+                    {
+                        do
+                            args.push_back(expression());
+                        while (accept(","));
+                        expect(")");
+                    }
+                    return call(name, args);
+                }
+
+                if (auto it = m_locals.find(name); it != m_locals.end())
+                {
+                    value result;
+                    result.regs = it->second;
+                    return result;
+                }
+
+                if (const int param = m_program.find_param(name); param >= 0)
+                {
+                    auto it = m_paramRegs.find(static_cast<size_type>(param));
+                    if (it == m_paramRegs.end())
+                    {
+                        const uint16 reg = allocate(false);
+                        emit(script_opcode::load_param, reg, static_cast<uint16>(param));
+                        it = m_paramRegs.emplace(static_cast<size_type>(param), reg).first;
+                    }
+                    value result;
+                    result.regs.push_back(it->second);
+                    return result;
+                }
+
+                if (name == "dt" || name == "time")
+                {
+                    int& reg = name == "dt" ? m_dtReg : m_timeReg;
+                    if (reg < 0)
+                    {
+                        reg = allocate(false);
+                        emit(name == "dt" ? script_opcode::load_dt : script_opcode::load_time, static_cast<uint16>(reg));
+                    }
+                    value result;
+                    result.regs.push_back(static_cast<uint16>(reg));
+                    return result;
+                }
+
+                if (const int slot = find_component(name); slot >= 0)
+                {
+                    const component_binding& binding = *m_program.components[slot];
+
+                    // Field access only loads the field that is used, anything else after the dot is a swizzle handled by postfix().
+                    if (peek().type == token_type::symbol && peek().text == "." && m_tokens[m_pos + 1].type == token_type::identifier)
+                    {
+                        const int field = binding.find_field(m_tokens[m_pos + 1].text);
+                        if (field >= 0)
+                        {
+                            m_pos += 2;
+                            return field_value(static_cast<size_type>(slot), static_cast<size_type>(field), true);
+                        }
+                    }
+
+                    value result;
+                    for (size_type field = 0; field < binding.fields.size(); field++)
+                        result.regs.push_back(field_value(static_cast<size_type>(slot), field, true).regs[0]);
+                    return result;
+                }
+
+                fail("unknown name '" + name + "'");
+            }
+
+            value postfix()
+            {
+                value result = primary();
+                while (accept("."))
+                    result = swizzle(result, expect_identifier());
+                return result;
+            }
+
+            value unary_expression()
+            {
+                if (accept("-"))
+                    return unary(script_opcode::neg, unary_expression());
+                return postfix();
+            }
+
+            value term()
+            {
+                value result = unary_expression();
+                while (true)
+                {
+                    if (accept("*"))
+                        result = binary(script_opcode::mul, result, unary_expression());
+                    else if (accept("/"))
+                        result = binary(script_opcode::div, result, unary_expression());
+                    else
+                        return result;
+                }
+            }
+
+            value additive()
+            {
+                value result = term();
+                while (true)
+                {
+                    if (accept("+"))
+                        result = binary(script_opcode::add, result, term());
+                    else if (accept("-"))
+                        result = binary(script_opcode::sub, result, term());
+                    else
+                        return result;
+                }
+            }
+
+            value expression()
+            {
+                value result = additive();
+                while (true)
+                {
+                    // Greater than comparisons are less than comparisons with the operands swapped.
+                    if (accept("<"))
+                        result = binary(script_opcode::less, result, additive());
+                    else if (accept("<="))
+                        result = binary(script_opcode::less_equal, result, additive());
+                    else if (accept(">"))
+                        result = binary(script_opcode::less, additive(), result);
+                    else if (accept(">="))
+                        result = binary(script_opcode::less_equal, additive(), result);
+                    else if (accept("=="))
+                        result = binary(script_opcode::equal, result, additive());
+                    else if (accept("!="))
+                        result = binary(script_opcode::not_equal, result, additive());
+                    else
+                        return result;
+                }
+            }
+
+            void assign(const std::vector<uint16>& target, const value& source)
+            {
+                if (source.width() != 1 && source.width() != target.size())
+                    fail("can't assign a value of width " + std::to_string(source.width()) + " to a target of width " + std::to_string(target.size()));
+
+                std::vector<uint16> sources;
+                for (size_type i = 0; i < target.size(); i++)
+                    sources.push_back(lane(source, i));
+
+                // Swizzled assignments like 'position = position.zyx' read lanes that get overwritten, copy those first.
+                for (size_type i = 0; i < target.size(); i++)
+                    for (size_type j = i + 1; j < target.size(); j++)
+                        if (sources[j] == target[i] && sources[j] != target[j])
+                        {
+                            const uint16 copy = allocate(true);
+                            emit(script_opcode::move, copy, sources[j]);
+                            for (size_type k = j; k < target.size(); k++)
+                                if (sources[k] == target[i])
+                                    sources[k] = copy;
+                        }
+
+                for (size_type i = 0; i < target.size(); i++)
+                    if (sources[i] != target[i])
+                        emit(script_opcode::move, target[i], sources[i]);
+            }
+
+            void query_statement()
+            {
+                if (!m_program.code.empty() || !m_program.components.empty())
+                    fail("query needs to be the first statement and can only appear once");
+
+                while (peek().type == token_type::identifier)
+                {
+                    const std::string name = expect_identifier();
+                    const component_binding* binding = ScriptBindings::get_component(name);
+                    if (!binding)
+                        fail("component '" + name + "' was not bound to scripting");
+                    if (find_component(name) >= 0)
+                        fail("component '" + name + "' is queried twice");
+
+                    m_program.components.push_back(binding);
+                    m_program.written.push_back(false);
+                }
+
+                if (m_program.components.empty())
+                    fail("query needs at least one component");
+            }
+
+            void param_statement()
+            {
+                const std::string name = expect_identifier();
+                if (m_program.find_param(name) >= 0 || m_locals.count(name))
+                    fail("'" + name + "' is already declared");
+
+                expect("=");
+                const bool negative = accept("-");
+                if (peek().type != token_type::number)
+                    fail("parameters need a number as default value");
+
+                m_program.paramNames.push_back(name);
+                m_program.paramDefaults.push_back(negative ? -next().number : next().number);
+            }
+
+            void let_statement()
+            {
+                const std::string name = expect_identifier();
+                if (m_program.find_param(name) >= 0 || m_locals.count(name) || find_component(name) >= 0)
+                    fail("'" + name + "' is already declared");
+
+                expect("=");
+                const value source = expression();
+
+                std::vector<uint16> regs;
+                for (size_type i = 0; i < source.width(); i++)
+                    regs.push_back(allocate(false));
+
+                assign(regs, source);
+                m_locals.emplace(name, std::move(regs));
+            }
+
+            void assignment_statement(const std::string& name)
+            {
+                int slot = -1;
+                std::vector<size_type> fields;
+                if (!m_locals.count(name))
+                {
+                    slot = find_component(name);
+                    if (slot < 0)
+                        fail("can't assign to '" + name + "'");
+
+                    const component_binding& binding = *m_program.components[slot];
+                    if (accept("."))
+                    {
+                        const std::string fieldName = expect_identifier();
+                        const int field = binding.find_field(fieldName);
+                        if (field < 0)
+                            fail("component '" + name + "' has no field '" + fieldName + "'");
+                        fields.push_back(static_cast<size_type>(field));
+                    }
+                    else
+                        for (size_type field = 0; field < binding.fields.size(); field++)
+                            fields.push_back(field);
+                }
+
+                script_opcode op = script_opcode::move;
+                bool compound = true;
+                if (accept("="))
+                    compound = false;
+                else if (accept("+="))
+                    op = script_opcode::add;
+                else if (accept("-="))
+                    op = script_opcode::sub;
+                else if (accept("*="))
+                    op = script_opcode::mul;
+                else if (accept("/="))
+                    op = script_opcode::div;
+                else
+                    fail("expected an assignment");
+
+                // The right hand side gets compiled first so reads of the target see its old value.
+                const value source = expression();
+
+                std::vector<uint16> target;
+                if (slot < 0)
+                    target = m_locals.at(name);
+                else
+                {
+                    m_program.written[slot] = true;
+                    // Fields that are only assigned to in full don't need to be loaded first.
+                    for (size_type field : fields)
+                    {
+                        target.push_back(field_value(static_cast<size_type>(slot), field, compound).regs[0]);
+                        m_writtenFields.emplace(static_cast<size_type>(slot), field);
+                    }
+                }
+
+                if (!compound)
+                {
+                    assign(target, source);
+                    return;
+                }
+
+                value current;
+                current.regs = target;
+                assign(target, binary(op, current, source));
+            }
+
+            void statement()
+            {
+                const std::string keyword = expect_identifier();
+                if (keyword == "query")
+                    query_statement();
+                else if (keyword == "param")
+                    param_statement();
+                else if (keyword == "let")
+                    let_statement();
+                else
+                {
+                    if (m_program.components.empty())
+                        fail("scripts need to start with a query");
+                    assignment_statement(keyword);
+                }
+
+                if (peek().type != token_type::newline && peek().type != token_type::end)
+                    fail("expected the end of the line");
+
+                // Temporaries only live until the end of the statement they were created in.
+                m_free.insert(m_free.end(), m_statementTemps.begin(), m_statementTemps.end());
+                m_statementTemps.clear();
+            }
+
+        public:
+            compiler(script_program& program, std::string_view source) : m_program(program), m_tokens(tokenize(source)) {}
+
+            void compile()
+            {
+                while (peek().type != token_type::end)
+                {
+                    if (peek().type == token_type::newline)
+                    {
+                        next();
+                        continue;
+                    }
+                    statement();
+                }
+
+                if (m_program.components.empty())
+                    fail("scripts need to start with a query");
+
+                for (auto& [slot, field] : m_writtenFields)
+                    emit(script_opcode::store_field, m_fieldRegs.at({ slot, field }), static_cast<uint16>(slot), static_cast<uint16>(field));
+            }
+        };
+    }
+
+    bool script_compiler::compile(const std::string& name, std::string_view source, script_program& program)
+    {
+        OPTICK_EVENT();
+        program = script_program{};
+        program.name = name;
+
+        try
+        {
+            compiler(program, source).compile();
+        }
+        catch (const compile_error& error)
+        {
+            log::error("{}({}): {}", name, error.line, error.message);
+            program = script_program{};
+            return false;
+        }
+
+        log::debug("Compiled script {}: {} instructions, {} registers", name, program.code.size(), program.registerCount);
+        return true;
+    }
+}
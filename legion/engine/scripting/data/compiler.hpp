@@ -0,0 +1,31 @@
+#pragma once
+#include <scripting/data/script.hpp>
+
+#include <string>
+#include <string_view>
+
+/**
+ * @file compiler.hpp
+ * @brief Compiles script source into bytecode, see script.hpp for the syntax.
+ */
+
+namespace legion::scripting
+{
+    /**@class script_compiler
+     * @brief Single pass compiler from script source to a script_program.
+     *        Every component field, constant and parameter a script uses gets loaded into a register once per chunk,
+     *        fields that were assigned to get written back at the end. Expressions on constants are folded at compile time.
+     */
+    class script_compiler
+    {
+    public:
+        script_compiler() = delete;
+
+        /**@brief Compiles a script, logs the first error with the line it occurred on if compilation fails.
+         * @param name Name of the script used in error messages.
+         * @param program Output, only valid if compilation succeeded.
+         * @return bool True if the script compiled.
+         */
+        static bool compile(const std::string& name, std::string_view source, script_program& program);
+    };
+}
@@ -0,0 +1,12 @@
+#include <scripting/data/script.hpp>
+
+namespace legion::scripting
+{
+    int script_program::find_param(std::string_view paramName) const
+    {
+        for (size_type i = 0; i < paramNames.size(); i++)
+            if (paramNames[i] == paramName)
+                return static_cast<int>(i);
+        return -1;
+    }
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <core/core.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file script.hpp
+ * @brief Compiled form of a Legion script.
+ *        Scripts are straight-line programs over the components of an entity query, every instruction operates on a whole
+ *        column of up to script_chunk_size entities at once. Crossing from script to native code therefore happens per chunk
+ *        of entities instead of per entity, both for component access and for calls to bound native functions.
+ *
+ *        Script syntax, one statement per line and '#' starting a comment:
+ *        @code
+ *        query position velocity           # Components the script runs over, entities need all of them.
+ *        param gravity = -9.81             # Value that can be changed from native code per script.
+ *        let fall = vec3(0, gravity, 0)    # Local value, scalar or vector.
+ *        velocity += fall * dt             # Assignment to a component, a component field or a local.
+ *        position += velocity * dt
+ *        position.y = max(position.y, 0)
+ *        @endcode
+ *        Expressions support + - * /, comparisons (< > <= >= == != resulting in 0 or 1), dt, time, vec2/vec3/vec4 constructors,
+ *        the builtins abs sqrt sin cos floor min max pow clamp lerp select dot length normalize, and functions bound through ScriptBindings.
+ *        Scalars broadcast over vectors, component fields are addressed by the names they were bound with.
+ */
+
+namespace legion::scripting
+{
+    /**@brief Amount of entities processed by a single pass over the bytecode.
+     */
+    constexpr size_type script_chunk_size = 256;
+
+    struct component_binding;
+
+    enum struct script_opcode : uint8
+    {
+        load_field,     // dst = component[a].field[b]
+        store_field,    // component[a].field[b] = dst
+        load_const,     // dst = constants[a]
+        load_param,     // dst = params[a]
+        load_dt,        // dst = delta time
+        load_time,      // dst = time since the script started
+        move,           // dst = a
+        add,            // dst = a + b
+        sub,            // dst = a - b
+        mul,            // dst = a * b
+        div,            // dst = a / b
+        min,            // dst = min(a, b)
+        max,            // dst = max(a, b)
+        pow,            // dst = pow(a, b)
+        less,           // dst = a < b
+        less_equal,     // dst = a <= b
+        equal,          // dst = a == b
+        not_equal,      // dst = a != b
+        neg,            // dst = -a
+        abs,            // dst = abs(a)
+        sqrt,           // dst = sqrt(a)
+        sin,            // dst = sin(a)
+        cos,            // dst = cos(a)
+        floor,          // dst = floor(a)
+        select,         // dst = a != 0 ? b : c
+        mad,            // dst = a * b + c
+        call_native     // dst = functions[a](registers nativeArgs[b] up to nativeArgs[b + c])
+    };
+
+    /**@class script_instruction
+     * @brief Single bytecode instruction, operands are register indices unless stated otherwise by the opcode.
+     */
+    struct script_instruction
+    {
+        script_opcode op;
+        uint16 dst = 0;
+        uint16 a = 0;
+        uint16 b = 0;
+        uint16 c = 0;
+    };
+
+    /**@class script_program
+     * @brief Bytecode of a compiled script together with the query it runs over.
+     */
+    struct script_program
+    {
+        std::string name;
+        std::vector<const component_binding*> components;
+        std::vector<bool> written; // Whether the script writes to the component at the same index, written components get submitted.
+
+        std::vector<float> constants;
+        std::vector<std::string> paramNames;
+        std::vector<float> paramDefaults;
+        std::vector<uint16> nativeArgs;
+        std::vector<script_instruction> code;
+        uint16 registerCount = 0;
+
+        /**@brief Index of a parameter, -1 if the script doesn't declare it.
+         */
+        L_NODISCARD int find_param(std::string_view paramName) const;
+    };
+}
@@ -0,0 +1,149 @@
+#include <scripting/data/vm.hpp>
+#include <scripting/data/bindings.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace legion::scripting::vm
+{
+    namespace
+    {
+        template<typename operation>
+        inline void unary(float* dst, const float* a, size_type count, operation&& op)
+        {
+            for (size_type i = 0; i < count; i++)
+                dst[i] = op(a[i]);
+        }
+
+        template<typename operation>
+        inline void binary(float* dst, const float* a, const float* b, size_type count, operation&& op)
+        {
+            for (size_type i = 0; i < count; i++)
+                dst[i] = op(a[i], b[i]);
+        }
+    }
+
+    void execute(const script_program& program, const float* params, float dt, float time, byte* const* components, size_type count, float* registers)
+    {
+        auto reg = [&](uint16 index) { return registers + static_cast<size_type>(index) * script_chunk_size; };
+
+        for (auto& instruction : program.code)
+        {
+            float* dst = reg(instruction.dst);
+
+            switch (instruction.op)
+            {
+            case script_opcode::load_field:
+            {
+                const component_binding& binding = *program.components[instruction.a];
+                const byte* src = components[instruction.a] + binding.fields[instruction.b].offset;
+                for (size_type i = 0; i < count; i++)
+                    dst[i] = *reinterpret_cast<const float*>(src + i * binding.stride);
+                break;
+            }
+            case script_opcode::store_field:
+            {
+                const component_binding& binding = *program.components[instruction.a];
+                byte* target = components[instruction.a] + binding.fields[instruction.b].offset;
+                for (size_type i = 0; i < count; i++)
+                    *reinterpret_cast<float*>(target + i * binding.stride) = dst[i];
+                break;
+            }
+            case script_opcode::load_const:
+                std::fill_n(dst, count, program.constants[instruction.a]);
+                break;
+            case script_opcode::load_param:
+                std::fill_n(dst, count, params[instruction.a]);
+                break;
+            case script_opcode::load_dt:
+                std::fill_n(dst, count, dt);
+                break;
+            case script_opcode::load_time:
+                std::fill_n(dst, count, time);
+                break;
+            case script_opcode::move:
+                std::copy_n(reg(instruction.a), count, dst);
+                break;
+            case script_opcode::add:
+                binary(dst, reg(instruction.a), reg(instruction.b), count, [](float a, float b) { return a + b; });
+                break;
+            case script_opcode::sub:
+                binary(dst, reg(instruction.a), reg(instruction.b), count, [](float a, float b) { return a - b; });
+                break;
+            case script_opcode::mul:
+                binary(dst, reg(instruction.a), reg(instruction.b), count, [](float a, float b) { return a * b; });
+                break;
+            case script_opcode::div:
+                binary(dst, reg(instruction.a), reg(instruction.b), count, [](float a, float b) { return a / b; });
+                break;
+            case script_opcode::min:
+                binary(dst, reg(instruction.a), reg(instruction.b), count, [](float a, float b) { return b < a ? b : a; });
+                break;
+            case script_opcode::max:
+                binary(dst, reg(instruction.a), reg(instruction.b), count, [](float a, float b) { return a < b ? b : a; });
+                break;
+            case script_opcode::pow:
+                binary(dst, reg(instruction.a), reg(instruction.b), count, [](float a, float b) { return std::pow(a, b); });
+                break;
+            case script_opcode::less:
+                binary(dst, reg(instruction.a), reg(instruction.b), count, [](float a, float b) { return a < b ? 1.f : 0.f; });
+                break;
+            case script_opcode::less_equal:
+                binary(dst, reg(instruction.a), reg(instruction.b), count, [](float a, float b) { return a <= b ? 1.f : 0.f; });
+                break;
+            case script_opcode::equal:
+                binary(dst, reg(instruction.a), reg(instruction.b), count, [](float a, float b) { return a == b ? 1.f : 0.f; });
+                break;
+            case script_opcode::not_equal:
+                binary(dst, reg(instruction.a), reg(instruction.b), count, [](float a, float b) { return a != b ? 1.f : 0.f; });
+                break;
+            case script_opcode::neg:
+                unary(dst, reg(instruction.a), count, [](float a) { return -a; });
+                break;
+            case script_opcode::abs:
+                unary(dst, reg(instruction.a), count, [](float a) { return std::abs(a); });
+                break;
+            case script_opcode::sqrt:
+                unary(dst, reg(instruction.a), count, [](float a) { return std::sqrt(a); });
+                break;
+            case script_opcode::sin:
+                unary(dst, reg(instruction.a), count, [](float a) { return std::sin(a); });
+                break;
+            case script_opcode::cos:
+                unary(dst, reg(instruction.a), count, [](float a) { return std::cos(a); });
+                break;
+            case script_opcode::floor:
+                unary(dst, reg(instruction.a), count, [](float a) { return std::floor(a); });
+                break;
+            case script_opcode::select:
+            {
+                const float* condition = reg(instruction.a);
+                const float* onTrue = reg(instruction.b);
+                const float* onFalse = reg(instruction.c);
+                for (size_type i = 0; i < count; i++)
+                    dst[i] = condition[i] != 0.f ? onTrue[i] : onFalse[i];
+                break;
+            }
+            case script_opcode::mad:
+            {
+                const float* a = reg(instruction.a);
+                const float* b = reg(instruction.b);
+                const float* c = reg(instruction.c);
+                for (size_type i = 0; i < count; i++)
+                    dst[i] = a[i] * b[i] + c[i];
+                break;
+            }
+            case script_opcode::call_native:
+            {
+                // The compiler limits native arity to 16.
+                const float* args[16];
+                for (size_type i = 0; i < instruction.c; i++)
+                    args[i] = reg(program.nativeArgs[instruction.b + i]);
+
+                ScriptBindings::get_function(instruction.a).function(args, instruction.c, dst, count);
+                break;
+            }
+            }
+        }
+    }
+}
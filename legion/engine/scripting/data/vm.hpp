@@ -0,0 +1,20 @@
+#pragma once
+#include <scripting/data/script.hpp>
+
+/**
+ * @file vm.hpp
+ * @brief Interpreter for compiled scripts.
+ */
+
+namespace legion::scripting::vm
+{
+    /**@brief Runs a script over a chunk of entities.
+     *        Every instruction processes all entities of the chunk before the next one gets dispatched,
+     *        so the cost of interpreting is paid once per chunk instead of once per entity.
+     * @param params Values of the parameters of the script.
+     * @param components Start of the component arrays of the chunk, in the order of program.components.
+     * @param count Amount of entities in the chunk, at most script_chunk_size.
+     * @param registers Register file of at least program.registerCount * script_chunk_size floats.
+     */
+    void execute(const script_program& program, const float* params, float dt, float time, byte* const* components, size_type count, float* registers);
+}
@@ -0,0 +1,50 @@
+#pragma once
+#include <scripting/data/bindings.hpp>
+#include <scripting/systems/scriptsystem.hpp>
+
+#include <random>
+
+namespace legion::scripting
+{
+    class ScriptingModule : public Module
+    {
+    public:
+        virtual void setup() override
+        {
+            using vec3 = math::vec3;
+            using quat = math::quat;
+
+            ScriptBindings::bind_component<position>("position", {
+                { "x", ScriptBindings::offset_of<position>(&vec3::x) },
+                { "y", ScriptBindings::offset_of<position>(&vec3::y) },
+                { "z", ScriptBindings::offset_of<position>(&vec3::z) } });
+
+            ScriptBindings::bind_component<rotation>("rotation", {
+                { "x", ScriptBindings::offset_of<rotation>(&quat::x) },
+                { "y", ScriptBindings::offset_of<rotation>(&quat::y) },
+                { "z", ScriptBindings::offset_of<rotation>(&quat::z) },
+                { "w", ScriptBindings::offset_of<rotation>(&quat::w) } });
+
+            ScriptBindings::bind_component<scale>("scale", {
+                { "x", ScriptBindings::offset_of<scale>(&vec3::x) },
+                { "y", ScriptBindings::offset_of<scale>(&vec3::y) },
+                { "z", ScriptBindings::offset_of<scale>(&vec3::z) } });
+
+            ScriptBindings::bind_component<velocity>("velocity", {
+                { "x", ScriptBindings::offset_of<velocity>(&vec3::x) },
+                { "y", ScriptBindings::offset_of<velocity>(&vec3::y) },
+                { "z", ScriptBindings::offset_of<velocity>(&vec3::z) } });
+
+            // random(min, max), one value per entity.
+            ScriptBindings::bind_function("random", 2, [](const float* const* args, size_type, float* out, size_type count)
+                {
+                    thread_local std::mt19937 generator(std::random_device{}());
+                    std::uniform_real_distribution<float> distribution(0.f, 1.f);
+                    for (size_type i = 0; i < count; i++)
+                        out[i] = args[0][i] + (args[1][i] - args[0][i]) * distribution(generator);
+                });
+
+            reportSystem<ScriptSystem>();
+        }
+    };
+}
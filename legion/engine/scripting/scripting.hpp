@@ -0,0 +1,7 @@
+#pragma once
+#include <scripting/data/script.hpp>
+#include <scripting/data/bindings.hpp>
+#include <scripting/data/compiler.hpp>
+#include <scripting/data/vm.hpp>
+#include <scripting/systems/scriptsystem.hpp>
+#include <scripting/module/scriptingmodule.hpp>
@@ -0,0 +1,248 @@
+#include <scripting/systems/scriptsystem.hpp>
+#include <scripting/data/bindings.hpp>
+#include <scripting/data/compiler.hpp>
+#include <scripting/data/vm.hpp>
+
+namespace legion::scripting
+{
+    async::rw_spinlock ScriptSystem::m_scriptsLock;
+    std::unordered_map<std::string, std::shared_ptr<ScriptSystem::script_instance>> ScriptSystem::m_scripts;
+
+    void ScriptSystem::run(script_instance& instance, time::span deltaTime)
+    {
+        OPTICK_EVENT();
+        std::shared_ptr<const script_program> program;
+        std::vector<float> params;
+        {
+            async::readonly_guard guard(instance.lock);
+            program = instance.program;
+            params = instance.params;
+        }
+
+        if (!program)
+            return;
+
+        // Queries are bound to the thread they're used on, so they get (re)created here instead of when the script was added.
+        if (program != instance.queriedProgram)
+        {
+            hashed_sparse_set<id_type> componentTypes;
+            for (auto* binding : program->components)
+                componentTypes.insert(binding->typeId);
+
+            instance.query = std::make_unique<ecs::EntityQuery>(m_ecs->createQuery(componentTypes));
+            instance.queriedProgram = program;
+        }
+
+        const float dt = deltaTime.seconds();
+        instance.time += dt;
+
+        ecs::EntityQuery& query = *instance.query;
+        query.queryEntities();
+        const size_type count = query.size();
+        if (!count)
+            return;
+
+        const size_type componentCount = program->components.size();
+        std::vector<byte*> arrays(componentCount);
+        for (size_type i = 0; i < componentCount; i++)
+            arrays[i] = program->components[i]->data(query.get(program->components[i]->typeId));
+
+        const float time = instance.time;
+        auto executeChunk = [&](size_type chunk)
+        {
+            // Register files get reused by every chunk executed on the same thread.
+            thread_local std::vector<float> registers;
+            thread_local std::vector<byte*> chunkArrays;
+
+            const size_type first = chunk * script_chunk_size;
+            const size_type chunkSize = std::min(script_chunk_size, count - first);
+
+            registers.resize(static_cast<size_type>(program->registerCount) * script_chunk_size);
+            chunkArrays.resize(componentCount);
+            for (size_type i = 0; i < componentCount; i++)
+                chunkArrays[i] = arrays[i] + first * program->components[i]->stride;
+
+            vm::execute(*program, params.data(), dt, time, chunkArrays.data(), chunkSize, registers.data());
+        };
+
+        const size_type chunkCount = (count + script_chunk_size - 1) / script_chunk_size;
+        if (chunkCount == 1)
+            executeChunk(0);
+        else
+            m_scheduler->queueJobs(chunkCount, [&]() { executeChunk(async::this_job::get_id()); }).wait();
+
+        for (size_type i = 0; i < componentCount; i++)
+            if (program->written[i])
+                query.submit(program->components[i]->typeId);
+    }
+
+    void ScriptSystem::replace_program(script_instance& instance, std::shared_ptr<const script_program> program)
+    {
+        async::readwrite_guard guard(instance.lock);
+
+        // Parameters that were set keep their value when the script gets replaced, new ones start at their default.
+        std::vector<float> params = program->paramDefaults;
+        if (instance.program)
+            for (size_type i = 0; i < params.size(); i++)
+            {
+                const int previous = instance.program->find_param(program->paramNames[i]);
+                if (previous >= 0)
+                    params[i] = instance.params[previous];
+            }
+
+        instance.program = std::move(program);
+        instance.params = std::move(params);
+    }
+
+    bool ScriptSystem::add_script(const std::string& name, std::string_view source, const std::string& chain, time::span interval)
+    {
+        OPTICK_EVENT();
+        auto program = std::make_shared<script_program>();
+        if (!script_compiler::compile(name, source, *program))
+            return false;
+
+        std::shared_ptr<script_instance> instance;
+        {
+            async::readonly_guard guard(m_scriptsLock);
+            if (auto it = m_scripts.find(name); it != m_scripts.end())
+                instance = it->second;
+        }
+
+        if (instance && instance->chain != chain)
+        {
+            remove_script(name);
+            instance = nullptr;
+        }
+
+        if (instance)
+        {
+            replace_program(*instance, std::move(program));
+            instance->process->setInterval(interval);
+            return true;
+        }
+
+        instance = std::make_shared<script_instance>();
+        instance->name = name;
+        instance->chain = chain;
+        replace_program(*instance, std::move(program));
+
+        const std::string processName = "script:" + name;
+        instance->process = std::make_unique<scheduling::Process>(processName, nameHash(processName), interval);
+        instance->process->setOperation([ptr = instance.get()](time::span deltaTime) { run(*ptr, deltaTime); });
+
+        {
+            async::readwrite_guard guard(m_scriptsLock);
+            m_scripts[name] = instance;
+        }
+
+        if (!m_scheduler->hookProcess(chain.c_str(), instance->process.get()))
+        {
+            log::error("Script {} can't run on process-chain {}, the chain doesn't exist.", name, chain);
+            remove_script(name);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool ScriptSystem::load_script(const fs::view& file, const std::string& chain, time::span interval)
+    {
+        OPTICK_EVENT();
+        auto source = file.get();
+        if (source != common::valid)
+        {
+            log::error("Failed to load script {}", file.get_virtual_path());
+            return false;
+        }
+
+        const std::string name = file.get_virtual_path();
+        if (!add_script(name, source.decay().to_string(), chain, interval))
+            return false;
+
+        if (fs::hot_reload::enabled())
+        {
+            const std::string node = fs::hot_reload::entry_node("script", nameHash(name));
+            fs::hot_reload::clear_dependencies(node);
+            fs::hot_reload::add_dependency(node, name);
+            fs::hot_reload::on_reload(node, [file, name, chain]()
+                {
+                    auto reloaded = file.get();
+                    if (reloaded != common::valid)
+                    {
+                        log::error("Failed to reload script {}, the previous version stays in use.", name);
+                        return;
+                    }
+
+                    // Scripts that don't compile anymore keep running their previous version.
+                    auto program = std::make_shared<script_program>();
+                    if (!script_compiler::compile(name, reloaded.decay().to_string(), *program))
+                        return;
+
+                    std::shared_ptr<script_instance> instance;
+                    {
+                        async::readonly_guard guard(m_scriptsLock);
+                        if (auto it = m_scripts.find(name); it != m_scripts.end())
+                            instance = it->second;
+                    }
+
+                    if (instance)
+                    {
+                        replace_program(*instance, std::move(program));
+                        log::info("Reloaded script {}", name);
+                    }
+                });
+        }
+
+        return true;
+    }
+
+    void ScriptSystem::remove_script(const std::string& name)
+    {
+        OPTICK_EVENT();
+        std::shared_ptr<script_instance> instance;
+        {
+            async::readwrite_guard guard(m_scriptsLock);
+            auto it = m_scripts.find(name);
+            if (it == m_scripts.end())
+                return;
+
+            instance = std::move(it->second);
+            m_scripts.erase(it);
+        }
+
+        m_scheduler->unhookProcess(instance->chain.c_str(), instance->process.get());
+
+        // The process might still be running, so the instance only gets destroyed once all chains are halted.
+        m_scheduler->queueSyncOperation([instance]() {});
+
+        if (fs::hot_reload::enabled())
+            fs::hot_reload::remove(fs::hot_reload::entry_node("script", nameHash(name)));
+    }
+
+    bool ScriptSystem::set_param(const std::string& name, std::string_view param, float value)
+    {
+        std::shared_ptr<script_instance> instance;
+        {
+            async::readonly_guard guard(m_scriptsLock);
+            if (auto it = m_scripts.find(name); it != m_scripts.end())
+                instance = it->second;
+        }
+
+        if (!instance)
+            return false;
+
+        async::readwrite_guard guard(instance->lock);
+        const int index = instance->program->find_param(param);
+        if (index < 0)
+            return false;
+
+        instance->params[index] = value;
+        return true;
+    }
+
+    size_type ScriptSystem::script_count()
+    {
+        async::readonly_guard guard(m_scriptsLock);
+        return m_scripts.size();
+    }
+}
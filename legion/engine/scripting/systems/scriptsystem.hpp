@@ -0,0 +1,73 @@
+#pragma once
+#include <core/core.hpp>
+#include <scripting/data/script.hpp>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @file scriptsystem.hpp
+ */
+
+namespace legion::scripting
+{
+    /**@class ScriptSystem
+     * @brief Runs compiled scripts over their queries, every script gets it's own process so it can be scheduled like a native system.
+     *        Entities get split into chunks of script_chunk_size which are executed on the job pool, components the script wrote to
+     *        get submitted once all chunks are done.
+     */
+    class ScriptSystem final : public System<ScriptSystem>
+    {
+    private:
+        struct script_instance
+        {
+            std::string name;
+            std::string chain;
+
+            async::rw_spinlock lock;
+            std::shared_ptr<const script_program> program;
+            std::vector<float> params;
+
+            std::unique_ptr<scheduling::Process> process;
+
+            // Only touched on the thread of the chain the script runs on.
+            std::shared_ptr<const script_program> queriedProgram;
+            std::unique_ptr<ecs::EntityQuery> query;
+            float time = 0.f;
+        };
+
+        static async::rw_spinlock m_scriptsLock;
+        static std::unordered_map<std::string, std::shared_ptr<script_instance>> m_scripts;
+
+        static void run(script_instance& instance, time::span deltaTime);
+        static void replace_program(script_instance& instance, std::shared_ptr<const script_program> program);
+
+    public:
+        /**@brief Compiles a script and schedules it on a process-chain, replaces the script if one with the same name already exists.
+         * @param chain Name of the process-chain to run the script on.
+         * @param interval Interval of the process of the script, 0 runs it every time the chain runs.
+         * @return bool True if the script compiled, compile errors get logged.
+         */
+        static bool add_script(const std::string& name, std::string_view source, const std::string& chain = "Update", time::span interval = 0);
+
+        /**@brief Loads a script from a file, the virtual path of the file is used as the name of the script.
+         *        The script gets recompiled when the file changes if hot-reloading is enabled, parameter values that were set are kept.
+         */
+        static bool load_script(const fs::view& file, const std::string& chain = "Update", time::span interval = 0);
+
+        /**@brief Stops running a script, the script is unhooked at the next sync point.
+         */
+        static void remove_script(const std::string& name);
+
+        /**@brief Sets the value of a parameter declared by a script.
+         * @return bool False if there is no such script or the script doesn't declare the parameter.
+         */
+        static bool set_param(const std::string& name, std::string_view param, float value);
+
+        L_NODISCARD static size_type script_count();
+
+        virtual void setup() {}
+    };
+}